@@ -23,8 +23,10 @@
 
 #ifdef SHINE_USE_MODULE
 import shine.memory;
+import shine.memory.frame;
 #else
 #include "../../memory/memory.ixx"
+#include "../../memory/frame_allocator.ixx"
 #endif
 
 template<typename T>
@@ -332,53 +334,25 @@ struct ScriptView : public TypeView {
         if (args.size() != method->paramTypes.size())
             return ScriptValue();
 
+        // Argument and return buffers are frame scratch (no FrameScope: the invoked method may
+        // frame-allocate results of its own)
         // Prepare Args
-        std::vector<void *> rawArgs(args.size());
-        struct ArgBuffer {
-            void *ptr;
-            bool  isHeap;
-            ArgBuffer() : ptr(nullptr), isHeap(false) {}
-            ~ArgBuffer() {
-                if (isHeap) {
-                    shine::co::MemoryScope scope(shine::co::MemoryTag::Script);
-                    shine::co::Memory::Free(ptr);
-                }
-            }
-        };
-        std::vector<ArgBuffer> argBuffers(args.size());
-
+        void **rawArgs = shine::co::FrameAllocator::NewArray<void *>(args.size());
         for (size_t i = 0; i < args.size(); ++i) {
             const TypeInfo *pType = GetTypeInfo(method->paramTypes[i]);
             if (!pType)
                 return ScriptValue(); // Param type not found
 
-            if (pType->size <= 8 && pType->alignment <= 8) {
-                // Small optimization for simple types (int/float/bool) - Reuse pointer if possible or alloc small
-                // But to be safe and uniform, we just alloc. For strict perf, use stack for small items.
-                shine::co::MemoryScope scope(shine::co::MemoryTag::Reflection);
-                argBuffers[i].ptr = shine::co::Memory::Alloc(pType->size, pType->alignment);
-            } else {
-                shine::co::MemoryScope scope(shine::co::MemoryTag::Reflection);
-                argBuffers[i].ptr = shine::co::Memory::Alloc(pType->size, pType->alignment);
-            }
-            argBuffers[i].isHeap = true;
-            bridge.FromScript(args[i], argBuffers[i].ptr, method->paramTypes[i]);
-            rawArgs[i] = argBuffers[i].ptr;
+            rawArgs[i] = shine::co::FrameAllocator::Alloc(pType->size, pType->alignment);
+            bridge.FromScript(args[i], rawArgs[i], method->paramTypes[i]);
         }
 
         // Prepare Return
         const TypeInfo *rType  = (method->returnType != GetTypeId<void>()) ? GetTypeInfo(method->returnType) : nullptr;
-        void           *retPtr = nullptr;
-        ArgBuffer       retBuf;
-        if (rType) {
-            shine::co::MemoryScope scope(shine::co::MemoryTag::Reflection);
-            retBuf.ptr    = shine::co::Memory::Alloc(rType->size, rType->alignment);
-            retBuf.isHeap = true;
-            retPtr        = retBuf.ptr;
-        }
+        void           *retPtr = rType ? shine::co::FrameAllocator::Alloc(rType->size, rType->alignment) : nullptr;
 
         // Invoke
-        method->invoke(instance, rawArgs.data(), retPtr);
+        method->invoke(instance, rawArgs, retPtr);
 
         // Return
         if (rType && retPtr)
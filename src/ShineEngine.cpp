@@ -35,6 +35,7 @@ int main(int argc,char** argv)
 
 #include <array>
 #include <filesystem>
+#include <string_view>
 
 
 #include "imgui/imgui.h"
@@ -61,8 +62,10 @@ int main(int argc,char** argv)
 // Include Memory
 #ifdef SHINE_USE_MODULE
 import shine.memory;
+import shine.memory.frame;
 #else
 #include "memory/memory.ixx"
+#include "memory/frame_allocator.ixx"
 #endif
 
 
@@ -85,6 +88,12 @@ int main(int argc, char** argv) {
 	for (int i =0 ;i<argc;i++)
 	{
 		fmt::println("命令行参数[{}]: {}", i, argv[i]);
+		// 按调用点统计分配，退出时打印未释放的分配
+		if (std::string_view(argv[i]) == "--track-alloc")
+			shine::co::MemoryTracker::SetEnabled(true);
+		// 每个 MemoryTag 一块 mimalloc arena，分配不再带头部
+		if (std::string_view(argv[i]) == "--header-free-alloc")
+			shine::co::Memory::EnableHeaderFree();
 	}
 
 #ifdef _WIN32
@@ -143,6 +152,11 @@ int main(int argc, char** argv) {
 	bool done = false;
 	while (!done) {
         // shine::co::MemoryScope frameScope(shine::co::MemoryTag::Core);
+
+		// 记录上一帧的调用点快照和各标签的分配样本，再推进帧号；各线程的帧分配器在本帧首次分配时回收三帧前的缓冲
+		shine::co::MemoryTracker::EndFrame();
+		shine::co::MemoryTimeline::SampleFrame();
+		shine::co::FrameAllocator::BeginFrame();
 		
 		// FPS控制 - 帧开始
         {
@@ -213,6 +227,9 @@ int main(int argc, char** argv) {
 	::DestroyWindow(info.hwnd);
 	//::UnregisterClassW(wc.lpszClassName, wc.hInstance);
 
+	if (shine::co::MemoryTracker::IsEnabled())
+		shine::co::MemoryTracker::DumpLeaks();
+
 	return 0;
 }
 #endif
\ No newline at end of file
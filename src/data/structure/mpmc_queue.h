@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace shine::data
+{
+    // Bounded lock-free multi-producer / multi-consumer ring (Dmitry Vyukov's design).
+    //
+    // Every slot carries a sequence number that says whose turn it is: a producer may fill slot
+    // `pos` when sequence == pos, a consumer may drain it when sequence == pos + 1. Producers and
+    // consumers each claim positions with one CAS on their own counter, so the two sides never
+    // touch the same cache line unless the queue is nearly empty or full. Slots are padded to a
+    // cache line so neighbouring producers don't false-share.
+    //
+    // Never allocates after construction; try_push fails when full, try_pop when empty.
+    template<typename T>
+    class mpmc_queue
+    {
+    public:
+        // Capacity is rounded up to a power of two (at least 2)
+        explicit mpmc_queue(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity) size <<= 1;
+            mask = size - 1;
+            cells = std::make_unique<cell[]>(size);
+            for (size_t i = 0; i < size; ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~mpmc_queue() {
+            const size_t tail = enqueue_pos.load(std::memory_order_relaxed);
+            for (size_t pos = dequeue_pos.load(std::memory_order_relaxed); pos != tail; ++pos) {
+                std::launder(reinterpret_cast<T*>(cells[pos & mask].storage))->~T();
+            }
+        }
+
+        mpmc_queue(const mpmc_queue&) = delete;
+        mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+        bool try_push(const T& item) { return try_emplace(item); }
+        bool try_push(T&& item) { return try_emplace(std::move(item)); }
+
+        template<typename... Args>
+        bool try_emplace(Args&&... args) {
+            size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+            cell* target;
+            for (;;) {
+                target = &cells[pos & mask];
+                const size_t sequence = target->sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;  // full: the slot still holds an item from the previous lap
+                } else {
+                    pos = enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+
+            ::new (static_cast<void*>(target->storage)) T(std::forward<Args>(args)...);
+            target->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_pop(T& item) {
+            size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+            cell* source;
+            for (;;) {
+                source = &cells[pos & mask];
+                const size_t sequence = source->sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+                if (diff == 0) {
+                    if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;  // empty: the producer for this slot hasn't published yet
+                } else {
+                    pos = dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+
+            T* stored = std::launder(reinterpret_cast<T*>(source->storage));
+            item = std::move(*stored);
+            stored->~T();
+            // Hand the slot to the producer one lap ahead
+            source->sequence.store(pos + mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t capacity() const { return mask + 1; }
+
+        // Approximate when called concurrently
+        size_t size_approx() const {
+            const size_t tail = enqueue_pos.load(std::memory_order_relaxed);
+            const size_t head = dequeue_pos.load(std::memory_order_relaxed);
+            return tail > head ? tail - head : 0;
+        }
+
+        bool empty() const { return size_approx() == 0; }
+
+    private:
+        struct alignas(64) cell {
+            std::atomic<size_t> sequence;
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+
+        std::unique_ptr<cell[]> cells;
+        size_t mask = 0;
+
+        alignas(64) std::atomic<size_t> enqueue_pos{0};
+        alignas(64) std::atomic<size_t> dequeue_pos{0};
+    };
+}
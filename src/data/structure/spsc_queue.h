@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace shine::data
+{
+    // Bounded lock-free single-producer / single-consumer ring.
+    //
+    // Head and tail live on separate cache lines, and each side keeps a private copy of the
+    // other side's index, so the shared line is only read when the cached copy says the ring
+    // looks full (producer) or empty (consumer). The bulk calls publish a whole batch with
+    // one release store.
+    //
+    // Exactly one thread may push and exactly one thread may pop. Never allocates after
+    // construction.
+    template<typename T>
+    class spsc_queue
+    {
+    public:
+        // Capacity is rounded up to a power of two (at least 2)
+        explicit spsc_queue(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity) size <<= 1;
+            mask = size - 1;
+            slots = std::make_unique<slot[]>(size);
+        }
+
+        ~spsc_queue() {
+            const size_t t = tail.load(std::memory_order_relaxed);
+            for (size_t h = head.load(std::memory_order_relaxed); h != t; ++h) {
+                at(h)->~T();
+            }
+        }
+
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue& operator=(const spsc_queue&) = delete;
+
+        // Producer only
+        bool try_push(const T& item) { return try_emplace(item); }
+        bool try_push(T&& item) { return try_emplace(std::move(item)); }
+
+        // Producer only
+        template<typename... Args>
+        bool try_emplace(Args&&... args) {
+            const size_t t = tail.load(std::memory_order_relaxed);
+            if (t - cached_head > mask) {
+                cached_head = head.load(std::memory_order_acquire);
+                if (t - cached_head > mask) return false;
+            }
+            ::new (static_cast<void*>(slots[t & mask].storage)) T(std::forward<Args>(args)...);
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Producer only. Copies up to `count` items and returns how many fit.
+        size_t try_push_bulk(const T* items, size_t count) {
+            const size_t t = tail.load(std::memory_order_relaxed);
+            size_t room = mask + 1 - (t - cached_head);
+            if (room < count) {
+                cached_head = head.load(std::memory_order_acquire);
+                room = mask + 1 - (t - cached_head);
+            }
+            const size_t n = std::min(room, count);
+            for (size_t i = 0; i < n; ++i) {
+                ::new (static_cast<void*>(slots[(t + i) & mask].storage)) T(items[i]);
+            }
+            if (n != 0) tail.store(t + n, std::memory_order_release);
+            return n;
+        }
+
+        // Consumer only
+        bool try_pop(T& item) {
+            const size_t h = head.load(std::memory_order_relaxed);
+            if (h == cached_tail) {
+                cached_tail = tail.load(std::memory_order_acquire);
+                if (h == cached_tail) return false;
+            }
+            T* stored = at(h);
+            item = std::move(*stored);
+            stored->~T();
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer only. Moves up to `maxCount` items into `out` and returns how many were taken.
+        size_t try_pop_bulk(T* out, size_t maxCount) {
+            const size_t h = head.load(std::memory_order_relaxed);
+            size_t available = cached_tail - h;
+            if (available < maxCount) {
+                cached_tail = tail.load(std::memory_order_acquire);
+                available = cached_tail - h;
+            }
+            const size_t n = std::min(available, maxCount);
+            for (size_t i = 0; i < n; ++i) {
+                T* stored = at(h + i);
+                out[i] = std::move(*stored);
+                stored->~T();
+            }
+            if (n != 0) head.store(h + n, std::memory_order_release);
+            return n;
+        }
+
+        size_t capacity() const { return mask + 1; }
+
+        // Approximate when called from a third thread
+        size_t size_approx() const {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        bool empty() const { return size_approx() == 0; }
+
+    private:
+        struct slot {
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+
+        T* at(size_t index) { return std::launder(reinterpret_cast<T*>(slots[index & mask].storage)); }
+
+        std::unique_ptr<slot[]> slots;
+        size_t mask = 0;
+
+        // Consumer side
+        alignas(64) std::atomic<size_t> head{0};
+        size_t cached_tail = 0;
+
+        // Producer side
+        alignas(64) std::atomic<size_t> tail{0};
+        size_t cached_head = 0;
+    };
+}
@@ -1,12 +1,27 @@
 #include "ImageViewerView.h"
 #include "imgui/imgui.h"
 #include "image/Texture.h"
+#include "image/png.h"
+#include "util/thread/thread_pool.h"
 #include <algorithm>
+#include <atomic>
+#include <vector>
 
 using namespace shine::image;
 
 namespace shine::editor::views
 {
+    // 任务持有像素副本，编辑器在导出期间可以继续修改或释放纹理
+    struct ImageViewerView::ExportJob
+    {
+        std::vector<uint8_t> pixels;
+        u32 width = 0;
+        u32 height = 0;
+        std::string path;
+        std::string status;         // 任务线程写入，finished 置位后由 UI 线程读取
+        std::atomic<bool> finished{ false };
+    };
+
     ImageViewerView::ImageViewerView()
         : isOpen_(true)
         , zoom_(1.0f)
@@ -138,6 +153,22 @@ namespace shine::editor::views
             fitToWindow_ = false;
             panOffset_.Set(0, 0);
         }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(160);
+        ImGui::InputText("##ExportPath", exportPath_, sizeof(exportPath_));
+        ImGui::SameLine();
+        PollExport();
+        ImGui::BeginDisabled(exportJob_ != nullptr);
+        if (ImGui::Button("导出 PNG"))
+        {
+            ExportPng();
+        }
+        ImGui::EndDisabled();
+        if (!exportStatus_.empty())
+        {
+            ImGui::SameLine();
+            ImGui::TextUnformatted(exportStatus_.c_str());
+        }
         ImGui::Separator();
 
         // 显示图像
@@ -223,6 +254,46 @@ namespace shine::editor::views
         processedTexture_.reset();
     }
 
+    void ImageViewerView::ExportPng()
+    {
+        // 导出当前显示的图像（包含通道预览和颜色调整）
+        const auto& source = processedTexture_ && processedTexture_->isValid() ? processedTexture_ : texture_;
+        if (!source || !source->isValid())
+        {
+            return;
+        }
+
+        auto job = std::make_shared<ExportJob>();
+        const auto& data = source->getData();
+        const auto* bytes = reinterpret_cast<const uint8_t*>(data.data());
+        job->pixels.assign(bytes, bytes + data.size() * RGBA8::size());
+        job->width = source->getWidth();
+        job->height = source->getHeight();
+        job->path = exportPath_;
+
+        // 编码和写文件都放到线程池上，避免大图导出卡住编辑器；快速压缩 + 分块并行
+        util::ThreadPool::Get().Submit([job]
+        {
+            const shine::image::PngEncodeOptions options{ shine::image::PngCompression::Fast, true };
+            auto result = shine::image::png::encodeToFile(job->path, job->pixels, job->width, job->height,
+                shine::image::PngColorType::RGBA, options);
+            job->status = result.has_value() ? "已导出: " + job->path : "导出失败: " + result.error();
+            job->finished.store(true, std::memory_order_release);
+        });
+
+        exportJob_ = std::move(job);
+        exportStatus_ = "正在导出...";
+    }
+
+    void ImageViewerView::PollExport()
+    {
+        if (exportJob_ && exportJob_->finished.load(std::memory_order_acquire))
+        {
+            exportStatus_ = std::move(exportJob_->status);
+            exportJob_.reset();
+        }
+    }
+
     void ImageViewerView::FitToWindow()
     {
         fitToWindow_ = true;
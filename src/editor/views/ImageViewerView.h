@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include "math/vector2.h"
 
 // 前向声明
@@ -70,6 +71,12 @@ namespace shine::editor::views
         float cachedSaturation_;
         shine::math::FVector2f cachedHueShift_;
 
+        // 导出
+        struct ExportJob;                      // 在线程池上执行的导出任务（定义见 .cpp）
+        char exportPath_[260] = "export.png";  // 导出文件路径
+        std::string exportStatus_;             // 上次导出的结果提示
+        std::shared_ptr<ExportJob> exportJob_; // 正在进行的导出，完成后在 Render 中收取结果
+
         // 缩放控制方法
         void FitToWindow();
         void ZoomToActualSize();
@@ -81,6 +88,11 @@ namespace shine::editor::views
         void UpdateProcessedTexture();
         void ApplyColorAdjustments(float& r, float& g, float& b, float& a) const;
         float GetChannelValue(ChannelMode mode, float r, float g, float b, float a) const;
+
+        // 复制当前显示的图像，在线程池上编码为 PNG 写入 exportPath_
+        void ExportPng();
+        // 导出任务完成后更新 exportStatus_
+        void PollExport();
     };
 }
 
@@ -1,5 +1,6 @@
 #include "MemoryProfiler.h"
 #include "imgui/imgui.h"
+#include <algorithm>
 #include <vector>
 #include <string>
 #include "fmt/format.h"
@@ -105,7 +106,262 @@ namespace shine::editor::views
                 }
             }
 
+            ImGui::Separator();
+            RenderTimeline();
+            RenderCallSites();
+
         }
         ImGui::End();
     }
+
+    void MemoryProfiler::RenderTimeline()
+    {
+        using shine::co::FrameMemorySample;
+        using shine::co::FrameTagSample;
+        constexpr size_t kTags = (size_t)shine::co::MemoryTag::Count;
+
+        if (!ImGui::CollapsingHeader("Frame Timeline"))
+            return;
+
+        static const char* kMetrics[] = { "Allocs", "Allocated (KB)", "Live (MB)" };
+        ImGui::SetNextItemWidth(130.0f);
+        ImGui::Combo("Metric", &timelineMetric_, kMetrics, IM_ARRAYSIZE(kMetrics));
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(160.0f);
+        ImGui::SliderInt("Frames", &timelineFrames_, 120, (int)shine::co::MemoryTimeline::kCapacity);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(100.0f);
+        ImGui::SliderFloat("Spike x median", &spikeFactor_, 1.5f, 10.0f, "%.1f");
+        ImGui::SameLine();
+        ImGui::Checkbox("Pause", &timelinePaused_);
+
+        if (!timelinePaused_)
+            shine::co::MemoryTimeline::CopyRecent(history_, (size_t)timelineFrames_);
+        // 第一个样本没有上一帧作参照，跳过
+        const size_t first = history_.size() > 0 && history_.front().frame_ms == 0.0f ? 1 : 0;
+        if (history_.size() < first + 2)
+        {
+            ImGui::TextDisabled("Waiting for frame samples...");
+            return;
+        }
+
+        auto metricOf = [this](const FrameTagSample& s)
+        {
+            switch (timelineMetric_)
+            {
+            case 0: return (float)s.allocs;
+            case 1: return s.bytes_allocated / 1024.0f;
+            default: return std::max<int64_t>(s.bytes_current, 0) / (1024.0f * 1024.0f);
+            }
+        };
+
+        // 尖峰阈值：帧耗时、分配次数各自取中位数的倍数
+        const size_t frames = history_.size() - first;
+        std::vector<float> frameMs(frames);
+        std::vector<float> allocs(frames);
+        for (size_t i = 0; i < frames; ++i)
+        {
+            const FrameMemorySample& sample = history_[first + i];
+            frameMs[i] = sample.frame_ms;
+            for (const FrameTagSample& tag : sample.tags)
+                allocs[i] += (float)tag.allocs;
+        }
+        auto median = [](std::vector<float> values)
+        {
+            std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+            return values[values.size() / 2];
+        };
+        const float msLimit = spikeFactor_ * std::max(median(frameMs), 0.01f);
+        const float allocLimit = spikeFactor_ * std::max(median(allocs), 1.0f);
+
+        // 帧数多于像素时合并相邻帧，每列取总量最大的那一帧，尖峰不会被平均掉
+        const float width = std::max(ImGui::GetContentRegionAvail().x, 100.0f);
+        const size_t columns = std::min(frames, std::max<size_t>((size_t)(width / 2.0f), 1));
+        const float columnWidth = width / (float)columns;
+        std::vector<size_t> pick(columns);
+        std::vector<float> stackTotal(columns);
+        std::vector<bool> msSpike(columns);
+        std::vector<bool> allocSpike(columns);
+        float maxTotal = 0.0f;
+        float maxMs = msLimit;
+        for (size_t c = 0; c < columns; ++c)
+        {
+            const size_t begin = c * frames / columns;
+            const size_t end = std::max((c + 1) * frames / columns, begin + 1);
+            for (size_t i = begin; i < end; ++i)
+            {
+                float total = 0.0f;
+                for (const FrameTagSample& tag : history_[first + i].tags)
+                    total += metricOf(tag);
+                if (i == begin || total > stackTotal[c])
+                {
+                    stackTotal[c] = total;
+                    pick[c] = i;
+                }
+                msSpike[c] = msSpike[c] || frameMs[i] > msLimit;
+                allocSpike[c] = allocSpike[c] || allocs[i] > allocLimit;
+                maxMs = std::max(maxMs, frameMs[i]);
+            }
+            maxTotal = std::max(maxTotal, stackTotal[c]);
+        }
+        maxTotal = std::max(maxTotal, 1e-3f);
+
+        constexpr float kStackHeight = 140.0f;
+        constexpr float kGap = 4.0f;
+        constexpr float kMsHeight = 50.0f;
+        const ImU32 spikeColor = IM_COL32(255, 70, 70, 255);
+        ImU32 tagColors[kTags];
+        for (size_t t = 0; t < kTags; ++t)
+            tagColors[t] = ImColor::HSV((float)t / (float)kTags, 0.6f, 0.9f);
+
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImGui::InvisibleButton("TimelineCanvas", ImVec2(width, kStackHeight + kGap + kMsHeight));
+        const bool hovered = ImGui::IsItemHovered();
+        ImDrawList* draw = ImGui::GetWindowDrawList();
+
+        const float stackBottom = origin.y + kStackHeight;
+        const float msTop = stackBottom + kGap;
+        const float msBottom = msTop + kMsHeight;
+        draw->AddRectFilled(origin, ImVec2(origin.x + width, stackBottom), IM_COL32(30, 30, 34, 255));
+        draw->AddRectFilled(ImVec2(origin.x, msTop), ImVec2(origin.x + width, msBottom), IM_COL32(30, 30, 34, 255));
+
+        for (size_t c = 0; c < columns; ++c)
+        {
+            const float x0 = origin.x + c * columnWidth;
+            const float x1 = x0 + std::max(columnWidth - 1.0f, 1.0f);
+            const FrameMemorySample& sample = history_[first + pick[c]];
+
+            // 标签分层堆叠
+            float y = stackBottom;
+            for (size_t t = 0; t < kTags; ++t)
+            {
+                const float h = metricOf(sample.tags[t]) / maxTotal * kStackHeight;
+                if (h <= 0.0f)
+                    continue;
+                draw->AddRectFilled(ImVec2(x0, y - h), ImVec2(x1, y), tagColors[t]);
+                y -= h;
+            }
+
+            // 帧耗时
+            const float h = frameMs[pick[c]] / maxMs * kMsHeight;
+            draw->AddRectFilled(ImVec2(x0, msBottom - h), ImVec2(x1, msBottom),
+                msSpike[c] ? spikeColor : IM_COL32(150, 150, 150, 255));
+
+            // 尖峰标记：分配突增画在顶部，卡顿和分配突增同时出现时贯穿两条轨道
+            if (allocSpike[c])
+            {
+                const float cx = (x0 + x1) * 0.5f;
+                draw->AddTriangleFilled(ImVec2(cx - 4.0f, origin.y), ImVec2(cx + 4.0f, origin.y), ImVec2(cx, origin.y + 6.0f), spikeColor);
+            }
+            if (allocSpike[c] && msSpike[c])
+                draw->AddRectFilled(ImVec2(x0, origin.y), ImVec2(x1, msBottom), IM_COL32(255, 70, 70, 50));
+        }
+
+        const float limitY = msBottom - msLimit / maxMs * kMsHeight;
+        draw->AddLine(ImVec2(origin.x, limitY), ImVec2(origin.x + width, limitY), IM_COL32(255, 200, 80, 160));
+
+        if (hovered)
+        {
+            const float mouseX = ImGui::GetIO().MousePos.x;
+            const size_t c = std::min((size_t)std::max((mouseX - origin.x) / columnWidth, 0.0f), columns - 1);
+            const float cx = origin.x + (c + 0.5f) * columnWidth;
+            draw->AddLine(ImVec2(cx, origin.y), ImVec2(cx, msBottom), IM_COL32(255, 255, 255, 120));
+
+            const FrameMemorySample& sample = history_[first + pick[c]];
+            ImGui::BeginTooltip();
+            ImGui::Text("Frame %llu  %.2f ms  %.0f allocs", (unsigned long long)sample.frame, sample.frame_ms, allocs[pick[c]]);
+            for (size_t t = 0; t < kTags; ++t)
+            {
+                const FrameTagSample& tag = sample.tags[t];
+                if (tag.allocs == 0 && tag.frees == 0)
+                    continue;
+                ImGui::TextColored(ImColor(tagColors[t]),
+                    "%-10s +%u / -%u  %.1f KB  live %.2f MB  peak %.2f MB", shine::co::g_memoryTagNames[t],
+                    tag.allocs, tag.frees, tag.bytes_allocated / 1024.0f,
+                    tag.bytes_current / (1024.0f * 1024.0f), tag.bytes_peak / (1024.0f * 1024.0f));
+            }
+            ImGui::EndTooltip();
+        }
+
+        // 图例
+        for (size_t t = 0; t < kTags; ++t)
+        {
+            if (t > 0)
+                ImGui::SameLine();
+            ImGui::ColorButton(shine::co::g_memoryTagNames[t], ImColor(tagColors[t]),
+                ImGuiColorEditFlags_NoTooltip, ImVec2(10.0f, 10.0f));
+            ImGui::SameLine(0.0f, 4.0f);
+            ImGui::TextUnformatted(shine::co::g_memoryTagNames[t]);
+        }
+        ImGui::Text("Max %.1f %s / frame, %.2f ms; spike limits %.2f ms, %.0f allocs", maxTotal, kMetrics[timelineMetric_],
+            maxMs, msLimit, allocLimit);
+    }
+
+    void MemoryProfiler::RenderCallSites()
+    {
+        if (!ImGui::CollapsingHeader("Call Sites"))
+            return;
+
+        bool tracking = shine::co::MemoryTracker::IsEnabled();
+        if (ImGui::Checkbox("Track call sites", &tracking))
+            shine::co::MemoryTracker::SetEnabled(tracking);
+        if (!tracking)
+        {
+            ImGui::TextDisabled("Only allocations made while tracking is on are counted.");
+            return;
+        }
+
+        auto drawTable = [](const char* id, const std::vector<shine::co::CallSiteStats>& sites)
+        {
+            if (!ImGui::BeginTable(id, 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable))
+                return;
+            ImGui::TableSetupColumn("Site", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Allocs", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+            ImGui::TableSetupColumn("Alloc (KB)", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+            ImGui::TableSetupColumn("Live", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+            ImGui::TableSetupColumn("Live (KB)", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+            ImGui::TableHeadersRow();
+
+            for (const auto& site : sites)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::Text("%s:%u", site.file, site.line);
+                if (ImGui::IsItemHovered())
+                    ImGui::SetTooltip("%s", site.function);
+
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%llu", (unsigned long long)site.alloc_count);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%.1f", site.alloc_bytes / 1024.0f);
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%lld", (long long)site.live_count);
+                ImGui::TableSetColumnIndex(4);
+                ImGui::Text("%.1f", site.live_bytes / 1024.0f);
+            }
+            ImGui::EndTable();
+        };
+
+        // 上一帧分配最多的调用点
+        ImGui::Text("Top allocators last frame");
+        drawTable("TopThisFrame", shine::co::MemoryTracker::TopThisFrame(10));
+
+        // 与基准快照对比：按仍存活的字节排序，找持续增长的调用点
+        ImGui::Spacing();
+        if (ImGui::Button("Mark"))
+        {
+            mark_ = shine::co::MemoryTracker::Snapshot();
+            hasMark_ = true;
+        }
+        if (!hasMark_)
+            return;
+
+        ImGui::SameLine();
+        auto diff = shine::co::MemoryTracker::Diff(mark_, shine::co::MemoryTracker::Snapshot());
+        std::sort(diff.begin(), diff.end(), [](const auto& a, const auto& b) { return a.live_bytes > b.live_bytes; });
+        if (diff.size() > 20)
+            diff.resize(20);
+        ImGui::Text("Since frame %llu", (unsigned long long)mark_.frame);
+        drawTable("SinceMark", diff);
+    }
 }
@@ -1,5 +1,13 @@
 #pragma once
 
+#include <vector>
+
+#ifdef SHINE_USE_MODULE
+import shine.memory;
+#else
+#include "../../../memory/memory.ixx"
+#endif
+
 namespace shine::editor::views
 {
     /**
@@ -16,6 +24,20 @@ namespace shine::editor::views
         bool& IsOpen() { return isOpen_; }
 
     private:
+        void RenderTimeline();
+        void RenderCallSites();
+
         bool isOpen_ = true;
+
+        // 逐帧时间线：最近若干帧的标签样本
+        std::vector<shine::co::FrameMemorySample> history_;
+        int timelineMetric_ = 0;
+        int timelineFrames_ = 1024;
+        float spikeFactor_ = 3.0f;
+        bool timelinePaused_ = false;
+
+        // 调用点对比的基准快照
+        shine::co::CallSiteSnapshot mark_;
+        bool hasMark_ = false;
     };
 }
@@ -8,6 +8,12 @@
 #include "util/guid.h"
 #include "gameplay/component/component.h"
 
+#ifdef SHINE_USE_MODULE
+import shine.memory.pool;
+#else
+#include "memory/pool_allocator.ixx"
+#endif
+
 
 namespace shine::gameplay
 {
@@ -60,18 +66,19 @@ namespace shine::gameplay
         template <class TComponent, class... TArgs>
         TComponent* addComponent(TArgs&&... args)
         {
-            auto comp = std::make_unique<TComponent>(std::forward<TArgs>(args)...);
+            // 组件是高频创建销毁的小对象，走当前 MemoryScope 标签的池
+            auto comp = co::MakePooled<TComponent>(std::forward<TArgs>(args)...);
             comp->attachTo(this);
             TComponent* raw = comp.get();
             m_Components.emplace_back(std::move(comp));
             return raw;
         }
 
-        const std::vector<std::unique_ptr<component::UComponent>>& getComponents() const noexcept { return m_Components; }
+        const std::vector<co::PoolPtr<component::UComponent>>& getComponents() const noexcept { return m_Components; }
 
     private:
 
-        std::vector<std::unique_ptr<component::UComponent>> m_Components;
+        std::vector<co::PoolPtr<component::UComponent>> m_Components;
 
         std::string _name;
         util::FGuid _guid;
@@ -15,6 +15,12 @@
     #include "util/thread/task_scheduler.h"
 #endif
 
+#ifdef SHINE_USE_MODULE
+import shine.memory.frame;
+#else
+#include "memory/frame_allocator.ixx"
+#endif
+
 namespace shine::gameplay::tick
 {
     enum class EExecutionMode {
@@ -123,9 +129,14 @@ namespace shine::gameplay::tick
 #else
         void ExecutePhaseMultiThreaded(const std::vector<TickFunction*>& order, float dt) {
             auto& pool = util::ThreadPool::Get();
-            
-            std::vector<std::vector<TickFunction*>> parallelGroups;
-            std::vector<u32> indegree(order.size(), 0);
+
+            // Fan-out bookkeeping is frame scratch; no FrameScope because WaitForCounter runs
+            // other jobs on this thread, and their frame allocations must survive
+            co::FrameVector<u32> indegree(order.size(), 0);
+            co::FrameVector<TickFunction*> readyGroup;
+            co::FrameVector<size_t> readyIndices;
+            readyGroup.reserve(order.size());
+            readyIndices.reserve(order.size());
 
             for (size_t i = 0; i < order.size(); ++i) {
                 for (const auto* dep : order[i]->dependencies) {
@@ -136,8 +147,8 @@ namespace shine::gameplay::tick
             }
 
             while (true) {
-                std::vector<TickFunction*> readyGroup;
-                std::vector<size_t> readyIndices;
+                readyGroup.clear();
+                readyIndices.clear();
 
                 for (size_t i = 0; i < order.size(); ++i) {
                     if (indegree[i] == 0 && order[i]->fn && !(order[i]->enable && !order[i]->enable->enabled)) {
@@ -162,15 +173,16 @@ namespace shine::gameplay::tick
                     continue;
                 }
 
+                util::JobCounter counter;
                 for (auto* fn : readyGroup) {
                     pool.Submit(util::job::JobExecuteTick{
                         fn->fn,
                         fn->userdata,
                         dt
-                    });
+                    }, &counter);
                 }
-                
-                pool.WaitAll();
+
+                pool.WaitForCounter(counter);
 
                 for (auto idx : readyIndices) {
                     indegree[idx] = -1;
@@ -11,6 +11,33 @@
 
 namespace shine::image
 {
+    std::optional<bc::BcFormat> toBcFormat(TextureFormat format) noexcept
+    {
+        switch (format)
+        {
+        case TextureFormat::BC1_RGB:
+        case TextureFormat::BC1_RGBA: return bc::BcFormat::BC1;
+        case TextureFormat::BC3_RGBA: return bc::BcFormat::BC3;
+        case TextureFormat::BC4_R: return bc::BcFormat::BC4;
+        case TextureFormat::BC5_RG: return bc::BcFormat::BC5;
+        case TextureFormat::BC7_RGBA: return bc::BcFormat::BC7;
+        default: return std::nullopt;
+        }
+    }
+
+    TextureFormat toTextureFormat(bc::BcFormat format) noexcept
+    {
+        switch (format)
+        {
+        case bc::BcFormat::BC1: return TextureFormat::BC1_RGB;
+        case bc::BcFormat::BC3: return TextureFormat::BC3_RGBA;
+        case bc::BcFormat::BC4: return TextureFormat::BC4_R;
+        case bc::BcFormat::BC5: return TextureFormat::BC5_RG;
+        case bc::BcFormat::BC7: return TextureFormat::BC7_RGBA;
+        }
+        return TextureFormat::RGBA;
+    }
+
     STexture::STexture()
     {
     }
@@ -26,12 +53,18 @@ namespace shine::image
         _width = width;
         _height = height;
         _data = data;
+        _compressedData.clear();
+        _format = TextureFormat::RGBA;
+        _mips = {};
     }
 
     void STexture::InitializeFromMemory(const unsigned char* imageData, u32 width, u32 height)
     {
         _width = width;
         _height = height;
+        _compressedData.clear();
+        _format = TextureFormat::RGBA;
+        _mips = {};
         
         size_t pixelCount = width * height;
         _data.resize(pixelCount);
@@ -72,7 +105,50 @@ namespace shine::image
         size_t pixelCount = _width * _height;
         _data.resize(pixelCount);
         std::memcpy(_data.data(), imageData.data(), imageData.size());
+        _compressedData.clear();
+        _format = TextureFormat::RGBA;
+        _mips = {};
+
+        return true;
+    }
+
+    bool STexture::Compress(TextureFormat format, const bc::CompressOptions& options)
+    {
+        // 只接受编码器产出的格式（BC1_RGBA 的 1 位 Alpha 模式不生成）
+        const auto bcFormat = toBcFormat(format);
+        if (!isValid() || !bcFormat || toTextureFormat(*bcFormat) != format)
+        {
+            return false;
+        }
+
+        std::vector<u8> blocks(bc::compressedSize(*bcFormat, _width, _height));
+        auto result = bc::compress(reinterpret_cast<const u8*>(_data.data()), _width, _height,
+            static_cast<size_t>(_width) * RGBA8::size(), *bcFormat, blocks.data(), options);
+        if (!result.has_value())
+        {
+            return false;
+        }
 
+        _compressedData = std::move(blocks);
+        _format = format;
+        return true;
+    }
+
+    bool STexture::GenerateMips(const mip::MipOptions& options)
+    {
+        if (!isValid())
+        {
+            return false;
+        }
+
+        auto chain = mip::buildMipChain(reinterpret_cast<const u8*>(_data.data()), _width, _height,
+            static_cast<size_t>(_width) * RGBA8::size(), options);
+        if (!chain.has_value())
+        {
+            return false;
+        }
+
+        _mips = std::move(*chain);
         return true;
     }
 
@@ -103,6 +179,20 @@ namespace shine::image
                                       _minFilter == TextureFilter::LINEAR_MIPMAP_NEAREST ||
                                       _minFilter == TextureFilter::NEAREST_MIPMAP_LINEAR ||
                                       _minFilter == TextureFilter::NEAREST_MIPMAP_NEAREST);
+        if (!_compressedData.empty())
+        {
+            // 压缩纹理无法在 GPU 上生成 mipmap
+            createInfo.format = _format;
+            createInfo.data = _compressedData.data();
+            createInfo.dataSize = _compressedData.size();
+            createInfo.generateMipmaps = false;
+        }
+        else if (!_mips.empty())
+        {
+            // 已有 CPU mip 链，逐级上传代替 glGenerateMipmap
+            createInfo.mipChain = &_mips;
+            createInfo.generateMipmaps = false;
+        }
         createInfo.linearFilter = (_magFilter == TextureFilter::LINEAR || 
                                    _minFilter == TextureFilter::LINEAR ||
                                    _minFilter == TextureFilter::LINEAR_MIPMAP_LINEAR ||
@@ -131,6 +221,18 @@ namespace shine::image
     {
         // 更新内部数据
         _data = rgbaData;
+
+        // 压缩块与 mip 链已过期，回到 RGBA；压缩纹理无法按 RGBA 更新，
+        // 带 CPU mip 的纹理只更新第 0 级会与其余各级不一致，两者都需要重建 GPU 资源
+        const bool needsRebuild = !_compressedData.empty() || !_mips.empty();
+        _compressedData.clear();
+        _format = TextureFormat::RGBA;
+        _mips = {};
+        if (needsRebuild && _renderHandle.isValid())
+        {
+            CreateRenderResource();
+            return;
+        }
         
         // 如果数据大小不匹配，更新尺寸
         if (!rgbaData.empty() && _width * _height != rgbaData.size())
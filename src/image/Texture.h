@@ -2,8 +2,11 @@
 
 #include "shine_define.h"
 #include "render/resources/texture_handle.h"
+#include "image/bc_compress.h"
+#include "image/mipmap.h"
 #include <vector>
 #include <memory>
+#include <optional>
 
 // 前向声明（避免循环依赖）
 namespace shine::render
@@ -125,6 +128,17 @@ namespace shine::image
         DEPTH32F_STENCIL8,  // 32位浮点深度 + 8位模板
     };
 
+    /**
+     * @brief 纹理格式对应的 BC 块压缩格式
+     * @return BC1_RGB/BC1_RGBA/BC3_RGBA/BC4_R/BC5_RG/BC7_RGBA 之外的格式返回空
+     */
+    std::optional<bc::BcFormat> toBcFormat(TextureFormat format) noexcept;
+
+    /**
+     * @brief BC 块压缩格式对应的纹理格式（BC1 对应不透明的 BC1_RGB）
+     */
+    TextureFormat toTextureFormat(bc::BcFormat format) noexcept;
+
     // 图像文件格式
     enum class ImageFileFormat
     {
@@ -208,6 +222,23 @@ namespace shine::image
          */
         bool InitializeFromAsset(const manager::AssetHandle& assetHandle);
 
+        /**
+         * @brief 将 RGBA 数据压缩为块压缩格式，之后 CreateRenderResource 直接上传压缩块
+         * 压缩块单独保存，RGBA 数据保留（用于编辑与不支持该格式时的回退）；重新初始化或 updateData 会丢弃压缩块
+         * @param format 目标格式（BC1_RGB、BC3_RGBA、BC4_R、BC5_RG 或 BC7_RGBA）
+         * @param options 压缩选项
+         * @return 成功返回true
+         */
+        bool Compress(TextureFormat format, const bc::CompressOptions& options = {});
+
+        /**
+         * @brief 在 CPU 上生成完整 mip 链并随纹理保存，之后 CreateRenderResource 逐级上传（不再调用 glGenerateMipmap）
+         * 重新初始化或 updateData 会丢弃 mip 链；压缩纹理只上传第 0 级
+         * @param options 滤波器、sRGB、预乘 Alpha 等选项
+         * @return 成功返回true
+         */
+        bool GenerateMips(const mip::MipOptions& options = {});
+
         /**
          * @brief 创建 GPU 纹理资源（通过 TextureManager 单例）
          * @return 纹理句柄，失败返回无效句柄
@@ -239,6 +270,15 @@ namespace shine::image
         TextureType getType() const noexcept { return _type; }
         size_t getDataSize() const noexcept { return _data.size(); }
 
+        // 块压缩数据（未压缩时为空）
+        bool isCompressed() const noexcept { return !_compressedData.empty(); }
+        const std::vector<u8>& getCompressedData() const noexcept { return _compressedData; }
+
+        // CPU mip 链（第 1 级起，未生成时为空）
+        bool hasMips() const noexcept { return !_mips.empty(); }
+        u32 getMipLevelCount() const noexcept { return static_cast<u32>(_mips.levels.size()) + 1; }
+        const mip::MipChain& getMipChain() const noexcept { return _mips; }
+
         // 获取原始数据指针
         const void* getDataPtr() const noexcept { return _data.data(); }
         void* getDataPtr() noexcept { return _data.data(); }
@@ -301,6 +341,8 @@ namespace shine::image
         TextureWrap _wrapR = TextureWrap::REPEAT;
         
         std::vector<RGBA8> _data;
+        std::vector<u8> _compressedData;  // _format 格式的压缩块（为空表示按 RGBA 上传）
+        mip::MipChain _mips;              // 第 1 级起的 RGBA8 mip 链（为空表示由驱动生成或不使用 mipmap）
 
         // GPU 纹理资源句柄（通过 TextureManager 创建）
         shine::render::TextureHandle _renderHandle;
@@ -0,0 +1,1157 @@
+#include "bc_compress.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "util/thread/task_group.h"
+
+#include "bc_dsp.h"
+
+/**
+ * @file bc_compress.cpp
+ * @brief BC 块压缩 / 解压实现
+ *
+ * 编码流程（BC1 与 BC7 各模式相同）：
+ * 1. 求块内像素的均值与协方差，幂迭代得到主成分轴；
+ * 2. 像素投影到主轴上，两端作为初始端点，量化到目标精度；
+ * 3. 由 SIMD 内核为每个像素选取最近的调色板项，得到索引与总误差；
+ * 4. 固定索引，按最小二乘重新求端点，再量化、选索引，误差下降则保留（最多两轮）。
+ *
+ * BC1 调色板按 D3D 规范的整数形式 (2 * c0 + c1) / 3 计算，BC4 调色板按 7 / 5 等分并四舍五入，
+ * 解码器使用同一公式，与硬件解码的差异在规范允许的误差内。
+ */
+
+namespace shine::image::bc
+{
+	namespace
+	{
+		constexpr uint32_t kOpaqueMask = 0x00FFFFFFu;
+		constexpr uint32_t kAllChannels = 0xFFFFFFFFu;
+
+		/// BC7 插值权重（2 / 3 / 4 位索引）
+		constexpr uint8_t kWeights2[4] = { 0, 21, 43, 64 };
+		constexpr uint8_t kWeights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+		constexpr uint8_t kWeights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		/// BC1 四色模式中各索引偏向 c1 的比例
+		constexpr float kBc1Fractions[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+		inline void writeLE16(uint8_t* p, uint16_t v) noexcept
+		{
+			p[0] = static_cast<uint8_t>(v);
+			p[1] = static_cast<uint8_t>(v >> 8);
+		}
+
+		inline uint16_t readLE16(const uint8_t* p) noexcept
+		{
+			return static_cast<uint16_t>(p[0] | (p[1] << 8));
+		}
+
+		// ============================================================================
+		// 主成分分析
+		// ============================================================================
+
+		/**
+		 * @brief 求 16 个像素前 N 个通道的均值与主成分轴（单位向量，所有像素相同时为零向量）
+		 */
+		template <int N>
+		void principalAxis(const uint8_t* pixels, float* mean, float* axis) noexcept
+		{
+			// 整数累加一阶、二阶矩，再换算成协方差
+			int32_t sum[N] = {};
+			int32_t moment[N][N] = {};
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				const uint8_t* p = pixels + i * 4;
+				for (int a = 0; a < N; ++a)
+				{
+					sum[a] += p[a];
+					for (int b = a; b < N; ++b)
+					{
+						moment[a][b] += p[a] * p[b];
+					}
+				}
+			}
+			float covariance[N][N];
+			for (int a = 0; a < N; ++a)
+			{
+				mean[a] = sum[a] * (1.0f / bc_dsp::kBlockPixels);
+				for (int b = a; b < N; ++b)
+				{
+					covariance[a][b] = moment[a][b] - sum[a] * (sum[b] * (1.0f / bc_dsp::kBlockPixels));
+					covariance[b][a] = covariance[a][b];
+				}
+			}
+
+			// 从方差最大的那一行出发做幂迭代，收敛很快
+			int start = 0;
+			for (int c = 1; c < N; ++c)
+			{
+				if (covariance[c][c] > covariance[start][start])
+				{
+					start = c;
+				}
+			}
+			float v[N];
+			for (int c = 0; c < N; ++c)
+			{
+				v[c] = covariance[start][c];
+			}
+			for (int iteration = 0; iteration < 4; ++iteration)
+			{
+				float w[N] = {};
+				float largest = 0.0f;
+				for (int a = 0; a < N; ++a)
+				{
+					for (int b = 0; b < N; ++b)
+					{
+						w[a] += covariance[a][b] * v[b];
+					}
+					largest = std::max(largest, std::abs(w[a]));
+				}
+				if (largest == 0.0f)
+				{
+					break;
+				}
+				for (int c = 0; c < N; ++c)
+				{
+					v[c] = w[c] / largest;
+				}
+			}
+
+			float length = 0.0f;
+			for (int c = 0; c < N; ++c)
+			{
+				length += v[c] * v[c];
+			}
+			length = std::sqrt(length);
+			for (int c = 0; c < N; ++c)
+			{
+				axis[c] = length > 1e-6f ? v[c] / length : 0.0f;
+			}
+		}
+
+		/**
+		 * @brief 固定每个像素的插值比例，按最小二乘求两个端点
+		 * @param fractions 每个像素偏向第二个端点的比例
+		 * @return 方程退化（所有像素比例相同）时返回 false
+		 */
+		template <int N>
+		bool leastSquaresEndpoints(const uint8_t* pixels, const float* fractions, float* e0, float* e1) noexcept
+		{
+			float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+			float ax[N] = {}, bx[N] = {};
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				const float b = fractions[i];
+				const float a = 1.0f - b;
+				aa += a * a;
+				ab += a * b;
+				bb += b * b;
+				for (int c = 0; c < N; ++c)
+				{
+					ax[c] += a * pixels[i * 4 + c];
+					bx[c] += b * pixels[i * 4 + c];
+				}
+			}
+			const float det = aa * bb - ab * ab;
+			if (std::abs(det) < 1e-6f)
+			{
+				return false;
+			}
+			const float inv = 1.0f / det;
+			for (int c = 0; c < N; ++c)
+			{
+				e0[c] = std::clamp((ax[c] * bb - bx[c] * ab) * inv, 0.0f, 255.0f);
+				e1[c] = std::clamp((bx[c] * aa - ax[c] * ab) * inv, 0.0f, 255.0f);
+			}
+			return true;
+		}
+
+		// ============================================================================
+		// BC1 颜色块
+		// ============================================================================
+
+		inline uint16_t packRgb565(const float* rgb) noexcept
+		{
+			const int r = std::clamp(static_cast<int>(rgb[0] * (31.0f / 255.0f) + 0.5f), 0, 31);
+			const int g = std::clamp(static_cast<int>(rgb[1] * (63.0f / 255.0f) + 0.5f), 0, 63);
+			const int b = std::clamp(static_cast<int>(rgb[2] * (31.0f / 255.0f) + 0.5f), 0, 31);
+			return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+		}
+
+		inline void unpackRgb565(uint16_t color, uint8_t* rgba) noexcept
+		{
+			const int r = color >> 11;
+			const int g = (color >> 5) & 63;
+			const int b = color & 31;
+			rgba[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+			rgba[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+			rgba[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+			rgba[3] = 255;
+		}
+
+		/**
+		 * @brief BC1 调色板（c0 > c1 或 fourColor 时为四色模式，否则为三色 + 透明黑）
+		 */
+		void colorPalette(uint16_t c0, uint16_t c1, bool fourColor, uint8_t* palette) noexcept
+		{
+			unpackRgb565(c0, palette);
+			unpackRgb565(c1, palette + 4);
+			for (int c = 0; c < 3; ++c)
+			{
+				const int a = palette[c];
+				const int b = palette[4 + c];
+				if (fourColor)
+				{
+					palette[8 + c] = static_cast<uint8_t>((2 * a + b) / 3);
+					palette[12 + c] = static_cast<uint8_t>((a + 2 * b) / 3);
+				}
+				else
+				{
+					palette[8 + c] = static_cast<uint8_t>((a + b) / 2);
+					palette[12 + c] = 0;
+				}
+			}
+			palette[11] = 255;
+			palette[15] = fourColor ? 255 : 0;
+		}
+
+		struct ColorCandidate
+		{
+			uint16_t c0 = 0;
+			uint16_t c1 = 0;
+			uint8_t indices[bc_dsp::kBlockPixels] = {};
+			uint32_t error = 0;
+		};
+
+		ColorCandidate evaluateColor(const bc_dsp::DspKernels& kernels, const uint8_t* pixels, uint16_t c0, uint16_t c1) noexcept
+		{
+			// 四色模式要求 c0 > c1；两者相等时解码器走三色模式，但所有像素都会选索引 0，结果相同
+			ColorCandidate candidate;
+			candidate.c0 = std::max(c0, c1);
+			candidate.c1 = std::min(c0, c1);
+			uint8_t palette[16];
+			colorPalette(candidate.c0, candidate.c1, true, palette);
+			candidate.error = kernels.fitColorIndices(pixels, palette, 4, kOpaqueMask, candidate.indices);
+			return candidate;
+		}
+
+		void encodeColorBlock(const uint8_t* pixels, uint8_t* out, bool refine) noexcept
+		{
+			const auto& kernels = bc_dsp::kernels();
+
+			float mean[3], axis[3];
+			principalAxis<3>(pixels, mean, axis);
+
+			// 投影到主轴上，取两端的像素作为初始端点
+			int minIndex = 0, maxIndex = 0;
+			float minT = 0.0f, maxT = 0.0f;
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				float t = 0.0f;
+				for (int c = 0; c < 3; ++c)
+				{
+					t += (pixels[i * 4 + c] - mean[c]) * axis[c];
+				}
+				if (t < minT) { minT = t; minIndex = i; }
+				if (t > maxT) { maxT = t; maxIndex = i; }
+			}
+			const float e0[3] = { float(pixels[maxIndex * 4]), float(pixels[maxIndex * 4 + 1]), float(pixels[maxIndex * 4 + 2]) };
+			const float e1[3] = { float(pixels[minIndex * 4]), float(pixels[minIndex * 4 + 1]), float(pixels[minIndex * 4 + 2]) };
+			ColorCandidate best = evaluateColor(kernels, pixels, packRgb565(e0), packRgb565(e1));
+
+			for (int iteration = 0; refine && iteration < 2 && best.error > 0; ++iteration)
+			{
+				float fractions[bc_dsp::kBlockPixels];
+				for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+				{
+					fractions[i] = kBc1Fractions[best.indices[i]];
+				}
+				float r0[3], r1[3];
+				if (!leastSquaresEndpoints<3>(pixels, fractions, r0, r1))
+				{
+					break;
+				}
+				const ColorCandidate candidate = evaluateColor(kernels, pixels, packRgb565(r0), packRgb565(r1));
+				if (candidate.error >= best.error)
+				{
+					break;
+				}
+				best = candidate;
+			}
+
+			uint32_t bits = 0;
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				bits |= static_cast<uint32_t>(best.indices[i]) << (i * 2);
+			}
+			writeLE16(out, best.c0);
+			writeLE16(out + 2, best.c1);
+			for (int i = 0; i < 4; ++i)
+			{
+				out[4 + i] = static_cast<uint8_t>(bits >> (i * 8));
+			}
+		}
+
+		void decodeColorBlock(const uint8_t* block, uint8_t* pixels, bool forceFourColor) noexcept
+		{
+			const uint16_t c0 = readLE16(block);
+			const uint16_t c1 = readLE16(block + 2);
+			uint8_t palette[16];
+			colorPalette(c0, c1, forceFourColor || c0 > c1, palette);
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				const int index = (block[4 + i / 4] >> ((i % 4) * 2)) & 3;
+				std::memcpy(pixels + i * 4, palette + index * 4, 4);
+			}
+		}
+
+		// ============================================================================
+		// BC4 单通道块
+		// ============================================================================
+
+		/**
+		 * @brief BC4 调色板（a0 > a1 为八值模式，否则为六值 + 0 / 255）
+		 */
+		void alphaPalette(uint8_t a0, uint8_t a1, uint8_t* palette) noexcept
+		{
+			palette[0] = a0;
+			palette[1] = a1;
+			if (a0 > a1)
+			{
+				for (int i = 1; i <= 6; ++i)
+				{
+					palette[i + 1] = static_cast<uint8_t>(((7 - i) * a0 + i * a1 + 3) / 7);
+				}
+			}
+			else
+			{
+				for (int i = 1; i <= 4; ++i)
+				{
+					palette[i + 1] = static_cast<uint8_t>(((5 - i) * a0 + i * a1 + 2) / 5);
+				}
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+		}
+
+		/**
+		 * @brief 编码一个 BC4 块
+		 * @param pixels 16 个 RGBA 像素
+		 * @param channel 取哪个通道
+		 */
+		void encodeAlphaBlock(const uint8_t* pixels, int channel, uint8_t* out, bool refine) noexcept
+		{
+			const auto& kernels = bc_dsp::kernels();
+
+			uint8_t values[bc_dsp::kBlockPixels];
+			uint8_t minValue = 255, maxValue = 0;
+			uint8_t innerMin = 255, innerMax = 0;  ///< 不计 0 和 255 的范围
+			bool hasExtremes = false;
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				const uint8_t v = pixels[i * 4 + channel];
+				values[i] = v;
+				minValue = std::min(minValue, v);
+				maxValue = std::max(maxValue, v);
+				if (v == 0 || v == 255)
+				{
+					hasExtremes = true;
+				}
+				else
+				{
+					innerMin = std::min(innerMin, v);
+					innerMax = std::max(innerMax, v);
+				}
+			}
+
+			uint8_t a0 = maxValue, a1 = minValue;
+			uint8_t indices[bc_dsp::kBlockPixels] = {};
+			if (minValue != maxValue)
+			{
+				uint8_t palette[8];
+				alphaPalette(a0, a1, palette);
+				const uint32_t error = kernels.fitAlphaIndices(values, palette, indices);
+
+				// 有 0 / 255 的块（如镂空的 Alpha）改用六值模式，两端由固定的 0 / 255 覆盖
+				if (refine && error > 0 && hasExtremes && innerMin <= innerMax)
+				{
+					uint8_t palette6[8], indices6[bc_dsp::kBlockPixels];
+					alphaPalette(innerMin, innerMax, palette6);
+					if (kernels.fitAlphaIndices(values, palette6, indices6) < error)
+					{
+						a0 = innerMin;
+						a1 = innerMax;
+						std::memcpy(indices, indices6, sizeof(indices));
+					}
+				}
+			}
+
+			uint64_t bits = 0;
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				bits |= static_cast<uint64_t>(indices[i]) << (i * 3);
+			}
+			out[0] = a0;
+			out[1] = a1;
+			for (int i = 0; i < 6; ++i)
+			{
+				out[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+			}
+		}
+
+		void decodeAlphaBlock(const uint8_t* block, uint8_t* pixels, int channel) noexcept
+		{
+			uint8_t palette[8];
+			alphaPalette(block[0], block[1], palette);
+			uint64_t bits = 0;
+			for (int i = 0; i < 6; ++i)
+			{
+				bits |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+			}
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				pixels[i * 4 + channel] = palette[(bits >> (i * 3)) & 7];
+			}
+		}
+
+		// ============================================================================
+		// BC7
+		// ============================================================================
+
+		/**
+		 * @brief 128 位块的按位写入 / 读取（低位在前）
+		 */
+		class BlockBits
+		{
+		public:
+			explicit BlockBits(uint8_t* data) noexcept : _data(data)
+			{
+				for (int i = 0; i < 8; ++i)
+				{
+					_lo |= static_cast<uint64_t>(data[i]) << (i * 8);
+					_hi |= static_cast<uint64_t>(data[8 + i]) << (i * 8);
+				}
+			}
+
+			void write(uint32_t value, int count) noexcept
+			{
+				const uint64_t v = value & ((1ull << count) - 1);
+				if (_pos < 64)
+				{
+					_lo |= v << _pos;
+					if (_pos + count > 64)
+					{
+						_hi |= v >> (64 - _pos);
+					}
+				}
+				else
+				{
+					_hi |= v << (_pos - 64);
+				}
+				_pos += count;
+			}
+
+			uint32_t read(int count) noexcept
+			{
+				uint64_t v;
+				if (_pos < 64)
+				{
+					v = _lo >> _pos;
+					if (_pos + count > 64)
+					{
+						v |= _hi << (64 - _pos);
+					}
+				}
+				else
+				{
+					v = _hi >> (_pos - 64);
+				}
+				_pos += count;
+				return static_cast<uint32_t>(v & ((1ull << count) - 1));
+			}
+
+			/// 写回数据块
+			void flush() noexcept
+			{
+				for (int i = 0; i < 8; ++i)
+				{
+					_data[i] = static_cast<uint8_t>(_lo >> (i * 8));
+					_data[8 + i] = static_cast<uint8_t>(_hi >> (i * 8));
+				}
+			}
+
+		private:
+			uint8_t* _data;
+			uint64_t _lo = 0;
+			uint64_t _hi = 0;
+			int _pos = 0;
+		};
+
+		/**
+		 * @brief 模式 6 端点：每通道 7 位 + 共享的 P 位
+		 */
+		struct Mode6Endpoint
+		{
+			uint8_t q[4] = {};
+			uint8_t p = 0;
+
+			uint8_t expand(int c) const noexcept { return static_cast<uint8_t>((q[c] << 1) | p); }
+		};
+
+		Mode6Endpoint quantizeMode6(const float* v) noexcept
+		{
+			Mode6Endpoint best;
+			float bestError = std::numeric_limits<float>::max();
+			for (uint8_t p = 0; p < 2; ++p)
+			{
+				Mode6Endpoint e;
+				e.p = p;
+				float error = 0.0f;
+				for (int c = 0; c < 4; ++c)
+				{
+					e.q[c] = static_cast<uint8_t>(std::clamp(static_cast<int>(std::lround((v[c] - p) * 0.5f)), 0, 127));
+					const float d = e.expand(c) - v[c];
+					error += d * d;
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					best = e;
+				}
+			}
+			return best;
+		}
+
+		inline uint8_t interpolate(int e0, int e1, int weight) noexcept
+		{
+			return static_cast<uint8_t>(((64 - weight) * e0 + weight * e1 + 32) >> 6);
+		}
+
+		/**
+		 * @brief 主轴上投影范围两端的点（直线上的点，而不是某个像素）
+		 */
+		template <int N>
+		void axisEndpoints(const uint8_t* pixels, float* v0, float* v1) noexcept
+		{
+			float mean[N], axis[N];
+			principalAxis<N>(pixels, mean, axis);
+			float minT = 0.0f, maxT = 0.0f;
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				float t = 0.0f;
+				for (int c = 0; c < N; ++c)
+				{
+					t += (pixels[i * 4 + c] - mean[c]) * axis[c];
+				}
+				minT = std::min(minT, t);
+				maxT = std::max(maxT, t);
+			}
+			for (int c = 0; c < N; ++c)
+			{
+				v0[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+				v1[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+			}
+		}
+
+		struct Mode6Candidate
+		{
+			Mode6Endpoint e0, e1;
+			uint8_t indices[bc_dsp::kBlockPixels] = {};
+			uint32_t error = 0;
+		};
+
+		Mode6Candidate evaluateMode6(const bc_dsp::DspKernels& kernels, const uint8_t* pixels, const float* v0, const float* v1) noexcept
+		{
+			Mode6Candidate candidate;
+			candidate.e0 = quantizeMode6(v0);
+			candidate.e1 = quantizeMode6(v1);
+			uint8_t palette[16 * 4];
+			for (int k = 0; k < 16; ++k)
+			{
+				for (int c = 0; c < 4; ++c)
+				{
+					palette[k * 4 + c] = interpolate(candidate.e0.expand(c), candidate.e1.expand(c), kWeights4[k]);
+				}
+			}
+			candidate.error = kernels.fitColorIndices(pixels, palette, 16, kAllChannels, candidate.indices);
+			return candidate;
+		}
+
+		Mode6Candidate encodeMode6(const bc_dsp::DspKernels& kernels, const uint8_t* pixels, bool refine) noexcept
+		{
+			float v0[4], v1[4];
+			axisEndpoints<4>(pixels, v0, v1);
+			Mode6Candidate best = evaluateMode6(kernels, pixels, v0, v1);
+
+			for (int iteration = 0; refine && iteration < 2 && best.error > 0; ++iteration)
+			{
+				float fractions[bc_dsp::kBlockPixels];
+				for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+				{
+					fractions[i] = kWeights4[best.indices[i]] / 64.0f;
+				}
+				if (!leastSquaresEndpoints<4>(pixels, fractions, v0, v1))
+				{
+					break;
+				}
+				const Mode6Candidate candidate = evaluateMode6(kernels, pixels, v0, v1);
+				if (candidate.error >= best.error)
+				{
+					break;
+				}
+				best = candidate;
+			}
+
+			// 第一个像素的索引最高位隐含为 0，否则交换端点并翻转索引
+			if (best.indices[0] & 8)
+			{
+				std::swap(best.e0, best.e1);
+				for (uint8_t& index : best.indices)
+				{
+					index = static_cast<uint8_t>(15 - index);
+				}
+			}
+			return best;
+		}
+
+		void writeMode6(const Mode6Candidate& block, uint8_t* out) noexcept
+		{
+			std::memset(out, 0, 16);
+			BlockBits bits(out);
+			bits.write(1u << 6, 7);
+			for (int c = 0; c < 4; ++c)
+			{
+				bits.write(block.e0.q[c], 7);
+				bits.write(block.e1.q[c], 7);
+			}
+			bits.write(block.e0.p, 1);
+			bits.write(block.e1.p, 1);
+			bits.write(block.indices[0], 3);
+			for (int i = 1; i < bc_dsp::kBlockPixels; ++i)
+			{
+				bits.write(block.indices[i], 4);
+			}
+			bits.flush();
+		}
+
+		/**
+		 * @brief 模式 5：RGB 7 位端点 + 独立的 8 位 Alpha 端点，颜色与 Alpha 各用 2 位索引
+		 */
+		struct Mode5Candidate
+		{
+			uint8_t color[2][3] = {};
+			uint8_t alpha[2] = {};
+			uint8_t colorIndices[bc_dsp::kBlockPixels] = {};
+			uint8_t alphaIndices[bc_dsp::kBlockPixels] = {};
+			uint32_t colorError = 0;
+			uint32_t alphaError = 0;
+		};
+
+		inline uint8_t expand7(uint8_t q) noexcept
+		{
+			return static_cast<uint8_t>((q << 1) | (q >> 6));
+		}
+
+		void evaluateMode5Color(const bc_dsp::DspKernels& kernels, const uint8_t* pixels,
+			const float* v0, const float* v1, Mode5Candidate& candidate) noexcept
+		{
+			for (int c = 0; c < 3; ++c)
+			{
+				candidate.color[0][c] = static_cast<uint8_t>(std::clamp(static_cast<int>(std::lround(v0[c] * (127.0f / 255.0f))), 0, 127));
+				candidate.color[1][c] = static_cast<uint8_t>(std::clamp(static_cast<int>(std::lround(v1[c] * (127.0f / 255.0f))), 0, 127));
+			}
+			uint8_t palette[4 * 4] = {};
+			for (int k = 0; k < 4; ++k)
+			{
+				for (int c = 0; c < 3; ++c)
+				{
+					palette[k * 4 + c] = interpolate(expand7(candidate.color[0][c]), expand7(candidate.color[1][c]), kWeights2[k]);
+				}
+			}
+			candidate.colorError = kernels.fitColorIndices(pixels, palette, 4, kOpaqueMask, candidate.colorIndices);
+		}
+
+		void evaluateMode5Alpha(const bc_dsp::DspKernels& kernels, const uint8_t* alphaValues,
+			uint8_t a0, uint8_t a1, Mode5Candidate& candidate) noexcept
+		{
+			candidate.alpha[0] = a0;
+			candidate.alpha[1] = a1;
+			// 内核按 8 项调色板比较；后 4 项重复最后一项，平局时总是选中前面的序号
+			uint8_t palette[8];
+			for (int k = 0; k < 8; ++k)
+			{
+				palette[k] = interpolate(a0, a1, kWeights2[std::min(k, 3)]);
+			}
+			candidate.alphaError = kernels.fitAlphaIndices(alphaValues, palette, candidate.alphaIndices);
+		}
+
+		Mode5Candidate encodeMode5(const bc_dsp::DspKernels& kernels, const uint8_t* pixels, bool refine) noexcept
+		{
+			Mode5Candidate best;
+
+			float v0[3], v1[3];
+			axisEndpoints<3>(pixels, v0, v1);
+			evaluateMode5Color(kernels, pixels, v0, v1, best);
+			for (int iteration = 0; refine && iteration < 2 && best.colorError > 0; ++iteration)
+			{
+				float fractions[bc_dsp::kBlockPixels];
+				for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+				{
+					fractions[i] = kWeights2[best.colorIndices[i]] / 64.0f;
+				}
+				if (!leastSquaresEndpoints<3>(pixels, fractions, v0, v1))
+				{
+					break;
+				}
+				Mode5Candidate candidate = best;
+				evaluateMode5Color(kernels, pixels, v0, v1, candidate);
+				if (candidate.colorError >= best.colorError)
+				{
+					break;
+				}
+				best = candidate;
+			}
+
+			uint8_t alphaValues[bc_dsp::kBlockPixels];
+			uint8_t minAlpha = 255, maxAlpha = 0;
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				alphaValues[i] = pixels[i * 4 + 3];
+				minAlpha = std::min(minAlpha, alphaValues[i]);
+				maxAlpha = std::max(maxAlpha, alphaValues[i]);
+			}
+			evaluateMode5Alpha(kernels, alphaValues, minAlpha, maxAlpha, best);
+			for (int iteration = 0; refine && iteration < 2 && best.alphaError > 0; ++iteration)
+			{
+				float fractions[bc_dsp::kBlockPixels];
+				for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+				{
+					fractions[i] = kWeights2[best.alphaIndices[i]] / 64.0f;
+				}
+				float a0, a1;
+				if (!leastSquaresEndpoints<1>(pixels + 3, fractions, &a0, &a1))
+				{
+					break;
+				}
+				Mode5Candidate candidate = best;
+				evaluateMode5Alpha(kernels, alphaValues, static_cast<uint8_t>(std::lround(a0)), static_cast<uint8_t>(std::lround(a1)), candidate);
+				if (candidate.alphaError >= best.alphaError)
+				{
+					break;
+				}
+				best = candidate;
+			}
+
+			// 两组索引的第一个都隐含最高位为 0
+			if (best.colorIndices[0] & 2)
+			{
+				std::swap(best.color[0], best.color[1]);
+				for (uint8_t& index : best.colorIndices)
+				{
+					index = static_cast<uint8_t>(3 - index);
+				}
+			}
+			if (best.alphaIndices[0] & 2)
+			{
+				std::swap(best.alpha[0], best.alpha[1]);
+				for (uint8_t& index : best.alphaIndices)
+				{
+					index = static_cast<uint8_t>(3 - index);
+				}
+			}
+			return best;
+		}
+
+		void writeMode5(const Mode5Candidate& block, uint8_t* out) noexcept
+		{
+			std::memset(out, 0, 16);
+			BlockBits bits(out);
+			bits.write(1u << 5, 6);
+			bits.write(0, 2);  // rotation
+			for (int c = 0; c < 3; ++c)
+			{
+				bits.write(block.color[0][c], 7);
+				bits.write(block.color[1][c], 7);
+			}
+			bits.write(block.alpha[0], 8);
+			bits.write(block.alpha[1], 8);
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				bits.write(block.colorIndices[i], i == 0 ? 1 : 2);
+			}
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				bits.write(block.alphaIndices[i], i == 0 ? 1 : 2);
+			}
+			bits.flush();
+		}
+
+		void encodeBC7Block(const uint8_t* pixels, uint8_t* out, bool refine) noexcept
+		{
+			const auto& kernels = bc_dsp::kernels();
+			const Mode6Candidate mode6 = encodeMode6(kernels, pixels, refine);
+
+			// 不透明块只用模式 6；带 Alpha 的块再试模式 5，Alpha 与颜色不相关时误差小得多
+			bool opaque = true;
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				opaque &= pixels[i * 4 + 3] == 255;
+			}
+			if (!opaque && mode6.error > 0)
+			{
+				const Mode5Candidate mode5 = encodeMode5(kernels, pixels, refine);
+				if (mode5.colorError + mode5.alphaError < mode6.error)
+				{
+					writeMode5(mode5, out);
+					return;
+				}
+			}
+			writeMode6(mode6, out);
+		}
+
+		/**
+		 * @brief 解码 BC7 单子集模式（4 / 5 / 6）
+		 */
+		bool decodeBC7Block(const uint8_t* block, uint8_t* pixels) noexcept
+		{
+			uint8_t data[16];
+			std::memcpy(data, block, sizeof(data));
+			BlockBits bits(data);
+
+			int mode = 0;
+			while (mode < 8 && bits.read(1) == 0)
+			{
+				++mode;
+			}
+
+			if (mode == 6)
+			{
+				uint8_t q[2][4];
+				for (int c = 0; c < 4; ++c)
+				{
+					q[0][c] = static_cast<uint8_t>(bits.read(7));
+					q[1][c] = static_cast<uint8_t>(bits.read(7));
+				}
+				const uint32_t p0 = bits.read(1);
+				const uint32_t p1 = bits.read(1);
+				for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+				{
+					const int index = static_cast<int>(bits.read(i == 0 ? 3 : 4));
+					for (int c = 0; c < 4; ++c)
+					{
+						pixels[i * 4 + c] = interpolate((q[0][c] << 1) | p0, (q[1][c] << 1) | p1, kWeights4[index]);
+					}
+				}
+				return true;
+			}
+
+			if (mode != 4 && mode != 5)
+			{
+				return false;
+			}
+
+			// 模式 4 / 5：颜色与 Alpha 各有一组索引，rotation 指定与 Alpha 交换的通道
+			const uint32_t rotation = bits.read(2);
+			const uint32_t indexMode = mode == 4 ? bits.read(1) : 0;
+			const int colorBits = mode == 4 ? 5 : 7;
+			const int alphaBits = mode == 4 ? 6 : 8;
+
+			uint8_t endpoints[2][4];
+			for (int c = 0; c < 3; ++c)
+			{
+				for (int e = 0; e < 2; ++e)
+				{
+					const uint32_t q = bits.read(colorBits);
+					endpoints[e][c] = static_cast<uint8_t>((q << (8 - colorBits)) | (q >> (2 * colorBits - 8)));
+				}
+			}
+			for (int e = 0; e < 2; ++e)
+			{
+				const uint32_t q = bits.read(alphaBits);
+				endpoints[e][3] = alphaBits == 8 ? static_cast<uint8_t>(q) : static_cast<uint8_t>((q << 2) | (q >> 4));
+			}
+
+			// 先是 2 位索引集合，模式 4 随后还有一组 3 位索引
+			uint8_t primary[bc_dsp::kBlockPixels], secondary[bc_dsp::kBlockPixels];
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				primary[i] = static_cast<uint8_t>(bits.read(i == 0 ? 1 : 2));
+			}
+			const int secondaryBits = mode == 4 ? 3 : 2;
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				secondary[i] = static_cast<uint8_t>(bits.read(i == 0 ? secondaryBits - 1 : secondaryBits));
+			}
+
+			const uint8_t* secondaryWeights = mode == 4 ? kWeights3 : kWeights2;
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				const int colorWeight = indexMode == 0 ? kWeights2[primary[i]] : secondaryWeights[secondary[i]];
+				const int alphaWeight = indexMode == 0 ? secondaryWeights[secondary[i]] : kWeights2[primary[i]];
+				uint8_t* p = pixels + i * 4;
+				for (int c = 0; c < 3; ++c)
+				{
+					p[c] = interpolate(endpoints[0][c], endpoints[1][c], colorWeight);
+				}
+				p[3] = interpolate(endpoints[0][3], endpoints[1][3], alphaWeight);
+				if (rotation != 0)
+				{
+					std::swap(p[3], p[rotation - 1]);
+				}
+			}
+			return true;
+		}
+
+		// ============================================================================
+		// 整图
+		// ============================================================================
+
+		/**
+		 * @brief 取出 (blockX, blockY) 处的 4x4 块，超出图像的部分复制边缘像素
+		 */
+		void loadBlock(const uint8_t* rgba, size_t stride, uint32_t width, uint32_t height,
+			uint32_t blockX, uint32_t blockY, uint8_t* pixels) noexcept
+		{
+			const uint32_t x0 = blockX * kBlockDim;
+			const uint32_t y0 = blockY * kBlockDim;
+			for (uint32_t y = 0; y < kBlockDim; ++y)
+			{
+				const uint8_t* row = rgba + std::min(y0 + y, height - 1) * stride;
+				uint8_t* dst = pixels + y * kBlockDim * 4;
+				if (x0 + kBlockDim <= width)
+				{
+					std::memcpy(dst, row + x0 * 4, kBlockDim * 4);
+					continue;
+				}
+				for (uint32_t x = 0; x < kBlockDim; ++x)
+				{
+					std::memcpy(dst + x * 4, row + std::min(x0 + x, width - 1) * 4, 4);
+				}
+			}
+		}
+
+		struct CompressJob
+		{
+			const uint8_t* rgba;
+			uint32_t width;
+			uint32_t height;
+			size_t stride;
+			BcFormat format;
+			uint8_t* out;
+			bool refine;
+			uint32_t blocksX;
+			uint32_t blocksY;
+			uint32_t rowsPerTask;
+
+			void compressRows(uint32_t firstRow, uint32_t lastRow) const noexcept
+			{
+				const size_t bytes = blockBytes(format);
+				uint8_t pixels[bc_dsp::kBlockPixels * 4];
+				for (uint32_t by = firstRow; by < lastRow; ++by)
+				{
+					uint8_t* dst = out + static_cast<size_t>(by) * blocksX * bytes;
+					for (uint32_t bx = 0; bx < blocksX; ++bx, dst += bytes)
+					{
+						loadBlock(rgba, stride, width, height, bx, by, pixels);
+						compressBlock(format, pixels, dst, refine);
+					}
+				}
+			}
+		};
+
+		bool shouldCompressParallel(const CompressOptions& options, uint32_t width, uint32_t height) noexcept
+		{
+#if !defined(SHINE_PLATFORM_WASM) && !defined(__EMSCRIPTEN__)
+			return options.parallel && height > kBlockDim &&
+				static_cast<size_t>(width) * height >= options.parallelMinPixels &&
+				util::ThreadPool::Get().GetThreadCount() > 0;
+#else
+			(void)options;
+			(void)width;
+			(void)height;
+			return false;
+#endif
+		}
+	} // namespace
+
+	size_t blockBytes(BcFormat format) noexcept
+	{
+		return format == BcFormat::BC1 || format == BcFormat::BC4 ? 8 : 16;
+	}
+
+	size_t compressedSize(BcFormat format, uint32_t width, uint32_t height) noexcept
+	{
+		const size_t blocksX = (static_cast<size_t>(width) + kBlockDim - 1) / kBlockDim;
+		const size_t blocksY = (static_cast<size_t>(height) + kBlockDim - 1) / kBlockDim;
+		return blocksX * blocksY * blockBytes(format);
+	}
+
+	const char* formatName(BcFormat format) noexcept
+	{
+		switch (format)
+		{
+		case BcFormat::BC1: return "BC1";
+		case BcFormat::BC3: return "BC3";
+		case BcFormat::BC4: return "BC4";
+		case BcFormat::BC5: return "BC5";
+		case BcFormat::BC7: return "BC7";
+		}
+		return "Unknown";
+	}
+
+	void compressBlock(BcFormat format, const uint8_t* pixels, uint8_t* out, bool refine) noexcept
+	{
+		switch (format)
+		{
+		case BcFormat::BC1:
+			encodeColorBlock(pixels, out, refine);
+			break;
+		case BcFormat::BC3:
+			encodeAlphaBlock(pixels, 3, out, refine);
+			encodeColorBlock(pixels, out + 8, refine);
+			break;
+		case BcFormat::BC4:
+			encodeAlphaBlock(pixels, 0, out, refine);
+			break;
+		case BcFormat::BC5:
+			encodeAlphaBlock(pixels, 0, out, refine);
+			encodeAlphaBlock(pixels, 1, out + 8, refine);
+			break;
+		case BcFormat::BC7:
+			encodeBC7Block(pixels, out, refine);
+			break;
+		}
+	}
+
+	bool decompressBlock(BcFormat format, const uint8_t* block, uint8_t* pixels) noexcept
+	{
+		switch (format)
+		{
+		case BcFormat::BC1:
+			decodeColorBlock(block, pixels, false);
+			return true;
+		case BcFormat::BC3:
+			decodeColorBlock(block + 8, pixels, true);
+			decodeAlphaBlock(block, pixels, 3);
+			return true;
+		case BcFormat::BC4:
+		case BcFormat::BC5:
+			for (int i = 0; i < bc_dsp::kBlockPixels; ++i)
+			{
+				pixels[i * 4 + 1] = 0;
+				pixels[i * 4 + 2] = 0;
+				pixels[i * 4 + 3] = 255;
+			}
+			decodeAlphaBlock(block, pixels, 0);
+			if (format == BcFormat::BC5)
+			{
+				decodeAlphaBlock(block + 8, pixels, 1);
+			}
+			return true;
+		case BcFormat::BC7:
+			return decodeBC7Block(block, pixels);
+		}
+		return false;
+	}
+
+	std::expected<void, std::string> compress(const uint8_t* rgba, uint32_t width, uint32_t height, size_t rgbaStride,
+		BcFormat format, uint8_t* out, const CompressOptions& options)
+	{
+		if (!rgba || !out)
+		{
+			return std::unexpected("BC compress: null buffer");
+		}
+		if (width == 0 || height == 0)
+		{
+			return std::unexpected("BC compress: empty image");
+		}
+		if (rgbaStride < static_cast<size_t>(width) * 4)
+		{
+			return std::unexpected("BC compress: stride is smaller than a row");
+		}
+
+		CompressJob job{ rgba, width, height, rgbaStride, format, out, options.refine,
+			(width + kBlockDim - 1) / kBlockDim, (height + kBlockDim - 1) / kBlockDim, 0 };
+
+		if (!shouldCompressParallel(options, width, height))
+		{
+			job.compressRows(0, job.blocksY);
+			return {};
+		}
+
+#if !defined(SHINE_PLATFORM_WASM) && !defined(__EMSCRIPTEN__)
+		// 每个任务负责若干个连续的块行；每个线程约 4 个任务，兼顾负载均衡与调度开销。
+		// 各任务写入互不重叠的输出区域，结果与串行压缩相同
+		const uint32_t threadCount = util::ThreadPool::Get().GetThreadCount() + 1;
+		job.rowsPerTask = std::max<uint32_t>(1, (job.blocksY + threadCount * 4 - 1) / (threadCount * 4));
+		const uint32_t taskCount = (job.blocksY + job.rowsPerTask - 1) / job.rowsPerTask;
+
+		util::TaskGroup group(taskCount, [](void* userdata, u32 task)
+		{
+			const auto& j = *static_cast<const CompressJob*>(userdata);
+			const uint32_t firstRow = task * j.rowsPerTask;
+			j.compressRows(firstRow, std::min(j.blocksY, firstRow + j.rowsPerTask));
+		}, &job);
+		for (uint32_t task = 0; task < taskCount; ++task)
+		{
+			group.Submit(task);
+		}
+		group.Wait();
+#endif
+		return {};
+	}
+
+	std::expected<std::vector<uint8_t>, std::string> compress(const uint8_t* rgba, uint32_t width, uint32_t height,
+		BcFormat format, const CompressOptions& options)
+	{
+		std::vector<uint8_t> blocks(compressedSize(format, width, height));
+		auto result = compress(rgba, width, height, static_cast<size_t>(width) * 4, format, blocks.data(), options);
+		if (!result.has_value())
+		{
+			return std::unexpected(std::move(result.error()));
+		}
+		return blocks;
+	}
+
+	std::expected<std::vector<uint8_t>, std::string> decompress(const uint8_t* blocks, size_t size,
+		uint32_t width, uint32_t height, BcFormat format)
+	{
+		if (!blocks || width == 0 || height == 0)
+		{
+			return std::unexpected("BC decompress: empty image");
+		}
+		if (size < compressedSize(format, width, height))
+		{
+			return std::unexpected("BC decompress: not enough block data");
+		}
+
+		const uint32_t blocksX = (width + kBlockDim - 1) / kBlockDim;
+		const uint32_t blocksY = (height + kBlockDim - 1) / kBlockDim;
+		const size_t bytes = blockBytes(format);
+		std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+		uint8_t pixels[bc_dsp::kBlockPixels * 4];
+		for (uint32_t by = 0; by < blocksY; ++by)
+		{
+			for (uint32_t bx = 0; bx < blocksX; ++bx)
+			{
+				if (!decompressBlock(format, blocks + (static_cast<size_t>(by) * blocksX + bx) * bytes, pixels))
+				{
+					return std::unexpected("BC decompress: unsupported BC7 block mode");
+				}
+				const uint32_t w = std::min(kBlockDim, width - bx * kBlockDim);
+				const uint32_t h = std::min(kBlockDim, height - by * kBlockDim);
+				for (uint32_t y = 0; y < h; ++y)
+				{
+					std::memcpy(rgba.data() + ((static_cast<size_t>(by) * kBlockDim + y) * width + bx * kBlockDim) * 4,
+						pixels + y * kBlockDim * 4, w * 4);
+				}
+			}
+		}
+		return rgba;
+	}
+
+} // namespace shine::image::bc
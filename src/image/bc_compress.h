@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <expected>
+
+/**
+ * @file bc_compress.h
+ * @brief BC1 / BC3 / BC4 / BC5 / BC7 纹理块压缩（CPU 端，用于生成可直接上传 GPU 的压缩纹理）
+ *
+ * 所有格式都以 4x4 像素块为单位，BC1 / BC4 每块 8 字节，其余每块 16 字节；
+ * 相对 RGBA8 分别为 8:1 与 4:1（BC4 / BC5 相对单 / 双通道源数据为 2:1）。
+ *
+ * - BC1：主成分轴上取端点，量化为 RGB565 后用最小二乘精化，总是使用四色模式（不透明）。
+ * - BC4：单通道（取红色通道），比较八值模式（最小 / 最大值）与带 0 / 255 的六值模式。
+ * - BC3 = BC4 编码的 Alpha 块 + BC1 颜色块；BC5 = 红、绿两个 BC4 块。
+ * - BC7：快速模式，只用单子集模式。不透明块用模式 6（RGBA 7 位端点 + P 位，4 位索引）；
+ *   带 Alpha 的块再试模式 5（颜色与 Alpha 各自一组端点和索引），取误差较小者。
+ *   端点同样取自主成分轴并经最小二乘精化。
+ *
+ * 每块中"为像素选取最近调色板项"的热循环由 bc_dsp 的 SIMD 内核完成；
+ * 整张图按块行分片到 util::ThreadPool 并行压缩，结果与串行完全相同。
+ *
+ * @see https://learn.microsoft.com/windows/win32/direct3d11/texture-block-compression-in-direct3d-11
+ */
+
+namespace shine::image::bc
+{
+	/**
+	 * @brief 块压缩格式
+	 */
+	enum class BcFormat : uint8_t
+	{
+		BC1,  ///< RGB，8 字节 / 块
+		BC3,  ///< RGBA，16 字节 / 块
+		BC4,  ///< R，8 字节 / 块
+		BC5,  ///< RG，16 字节 / 块
+		BC7   ///< RGBA，16 字节 / 块（快速模式）
+	};
+
+	/// 块边长（像素）
+	constexpr uint32_t kBlockDim = 4;
+
+	/**
+	 * @brief 压缩选项
+	 */
+	struct CompressOptions
+	{
+		bool refine = true;                     ///< 用最小二乘精化端点（约慢一倍，误差更小）
+		bool parallel = true;                   ///< 按块行分片到线程池并行压缩
+		uint32_t parallelMinPixels = 256 * 256; ///< 像素数低于该值时串行压缩
+	};
+
+	/**
+	 * @brief 每个块的字节数
+	 */
+	size_t blockBytes(BcFormat format) noexcept;
+
+	/**
+	 * @brief 压缩后的数据大小（宽高向上取整到 4 的倍数）
+	 */
+	size_t compressedSize(BcFormat format, uint32_t width, uint32_t height) noexcept;
+
+	/**
+	 * @brief 格式名称（用于日志与测试输出）
+	 */
+	const char* formatName(BcFormat format) noexcept;
+
+	/**
+	 * @brief 压缩一个 4x4 块
+	 * @param format 目标格式
+	 * @param pixels 16 个 RGBA 像素（行优先，64 字节）
+	 * @param out 输出块（blockBytes(format) 字节）
+	 * @param refine 是否精化端点
+	 */
+	void compressBlock(BcFormat format, const uint8_t* pixels, uint8_t* out, bool refine = true) noexcept;
+
+	/**
+	 * @brief 解压一个 4x4 块为 RGBA（BC4 输出 (r, 0, 0, 255)，BC5 输出 (r, g, 0, 255)）
+	 * @param format 块格式
+	 * @param block 压缩块
+	 * @param pixels 输出 16 个 RGBA 像素（64 字节）
+	 * @return BC7 块使用了不支持的模式时返回 false（支持单子集模式 4 / 5 / 6）
+	 */
+	bool decompressBlock(BcFormat format, const uint8_t* block, uint8_t* pixels) noexcept;
+
+	/**
+	 * @brief 压缩整张 RGBA 图像
+	 * @param rgba 源图像
+	 * @param width 宽度
+	 * @param height 高度
+	 * @param rgbaStride 源行跨度（字节）
+	 * @param format 目标格式
+	 * @param out 输出缓冲，至少 compressedSize(format, width, height) 字节，块按行优先排列
+	 * @param options 压缩选项
+	 * @return 成功返回 void，失败返回错误信息
+	 */
+	std::expected<void, std::string> compress(const uint8_t* rgba, uint32_t width, uint32_t height, size_t rgbaStride,
+		BcFormat format, uint8_t* out, const CompressOptions& options = {});
+
+	/**
+	 * @brief 压缩整张紧密排列的 RGBA 图像
+	 */
+	std::expected<std::vector<uint8_t>, std::string> compress(const uint8_t* rgba, uint32_t width, uint32_t height,
+		BcFormat format, const CompressOptions& options = {});
+
+	/**
+	 * @brief 解压为紧密排列的 RGBA（用于不支持该压缩格式的渲染后端及测试）
+	 * @param blocks 压缩数据
+	 * @param size 数据大小
+	 * @param width 宽度
+	 * @param height 高度
+	 * @param format 块格式
+	 * @return RGBA 数据，失败返回错误信息
+	 */
+	std::expected<std::vector<uint8_t>, std::string> decompress(const uint8_t* blocks, size_t size,
+		uint32_t width, uint32_t height, BcFormat format);
+
+} // namespace shine::image::bc
@@ -0,0 +1,277 @@
+#include "bc_dsp.h"
+
+#include <cstring>
+#include <limits>
+
+#if !defined(__EMSCRIPTEN__) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define SHINE_BC_DSP_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要按函数开启指令集，MSVC 的 intrinsic 不依赖编译选项
+#if defined(SHINE_BC_DSP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SHINE_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define SHINE_TARGET_SSE2
+#endif
+
+/**
+ * @file bc_dsp.cpp
+ * @brief BC 块压缩内核实现
+ *
+ * SSE2 版本一次比较 4 个像素：像素展开为 16 位后与调色板项相减，madd 得到两两通道的平方和，
+ * 再横向相加成 32 位距离；单通道版本一次比较 16 个值，用饱和减法求绝对差。
+ * 两者都用严格小于更新最优项，与标量实现的平局规则相同。
+ */
+
+namespace shine::image::bc_dsp
+{
+	namespace
+	{
+		inline uint32_t load32(const uint8_t* p) noexcept
+		{
+			uint32_t v;
+			std::memcpy(&v, p, sizeof(v));
+			return v;
+		}
+
+		// ============================================================================
+		// 标量参考实现
+		// ============================================================================
+
+		uint32_t fitColorIndicesScalar(const uint8_t* pixels, const uint8_t* palette, uint32_t paletteSize,
+			uint32_t channelMask, uint8_t* indices)
+		{
+			uint32_t total = 0;
+			for (int i = 0; i < kBlockPixels; ++i)
+			{
+				const uint32_t pixel = load32(pixels + i * 4) & channelMask;
+				uint32_t best = std::numeric_limits<uint32_t>::max();
+				uint8_t bestIndex = 0;
+				for (uint32_t k = 0; k < paletteSize; ++k)
+				{
+					const uint32_t entry = load32(palette + k * 4) & channelMask;
+					uint32_t distance = 0;
+					for (int c = 0; c < 4; ++c)
+					{
+						const int32_t d = static_cast<int32_t>((pixel >> (c * 8)) & 0xff) -
+							static_cast<int32_t>((entry >> (c * 8)) & 0xff);
+						distance += static_cast<uint32_t>(d * d);
+					}
+					if (distance < best)
+					{
+						best = distance;
+						bestIndex = static_cast<uint8_t>(k);
+					}
+				}
+				indices[i] = bestIndex;
+				total += best;
+			}
+			return total;
+		}
+
+		uint32_t fitAlphaIndicesScalar(const uint8_t* values, const uint8_t* palette, uint8_t* indices)
+		{
+			uint32_t total = 0;
+			for (int i = 0; i < kBlockPixels; ++i)
+			{
+				int best = 256;
+				uint8_t bestIndex = 0;
+				for (int k = 0; k < 8; ++k)
+				{
+					const int d = values[i] > palette[k] ? values[i] - palette[k] : palette[k] - values[i];
+					if (d < best)
+					{
+						best = d;
+						bestIndex = static_cast<uint8_t>(k);
+					}
+				}
+				indices[i] = bestIndex;
+				total += static_cast<uint32_t>(best * best);
+			}
+			return total;
+		}
+
+		constexpr DspKernels kScalarKernels = {
+			fitColorIndicesScalar,
+			fitAlphaIndicesScalar,
+		};
+
+#if defined(SHINE_BC_DSP_X86)
+		// ============================================================================
+		// SSE2
+		// ============================================================================
+
+		SHINE_TARGET_SSE2 inline __m128i select(__m128i mask, __m128i a, __m128i b)
+		{
+			return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+		}
+
+		SHINE_TARGET_SSE2 inline uint32_t horizontalSum(__m128i v)
+		{
+			v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+			v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+			return static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+		}
+
+		SHINE_TARGET_SSE2 uint32_t fitColorIndicesSSE2(const uint8_t* pixels, const uint8_t* palette, uint32_t paletteSize,
+			uint32_t channelMask, uint8_t* indices)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i mask = _mm_set1_epi32(static_cast<int32_t>(channelMask));
+
+			// 每组 4 个像素展开为两组 16 位（各 2 个像素）
+			__m128i lo[4], hi[4], best[4], bestIndex[4];
+			for (int j = 0; j < 4; ++j)
+			{
+				const __m128i px = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + j * 16)), mask);
+				lo[j] = _mm_unpacklo_epi8(px, zero);
+				hi[j] = _mm_unpackhi_epi8(px, zero);
+				best[j] = _mm_set1_epi32(std::numeric_limits<int32_t>::max());
+				bestIndex[j] = zero;
+			}
+
+			for (uint32_t k = 0; k < paletteSize; ++k)
+			{
+				const __m128i entry = _mm_unpacklo_epi8(
+					_mm_set1_epi32(static_cast<int32_t>(load32(palette + k * 4) & channelMask)), zero);
+				const __m128i index = _mm_set1_epi32(static_cast<int32_t>(k));
+				for (int j = 0; j < 4; ++j)
+				{
+					const __m128i dl = _mm_sub_epi16(lo[j], entry);
+					const __m128i dh = _mm_sub_epi16(hi[j], entry);
+					// madd 得到每个像素的 (r² + g², b² + a²)，再把两半相加
+					const __m128 ml = _mm_castsi128_ps(_mm_madd_epi16(dl, dl));
+					const __m128 mh = _mm_castsi128_ps(_mm_madd_epi16(dh, dh));
+					const __m128i distance = _mm_add_epi32(
+						_mm_castps_si128(_mm_shuffle_ps(ml, mh, _MM_SHUFFLE(2, 0, 2, 0))),
+						_mm_castps_si128(_mm_shuffle_ps(ml, mh, _MM_SHUFFLE(3, 1, 3, 1))));
+					const __m128i better = _mm_cmplt_epi32(distance, best[j]);
+					best[j] = select(better, distance, best[j]);
+					bestIndex[j] = select(better, index, bestIndex[j]);
+				}
+			}
+
+			alignas(16) int32_t lanes[kBlockPixels];
+			__m128i total = zero;
+			for (int j = 0; j < 4; ++j)
+			{
+				_mm_store_si128(reinterpret_cast<__m128i*>(lanes + j * 4), bestIndex[j]);
+				total = _mm_add_epi32(total, best[j]);
+			}
+			for (int i = 0; i < kBlockPixels; ++i)
+			{
+				indices[i] = static_cast<uint8_t>(lanes[i]);
+			}
+			return horizontalSum(total);
+		}
+
+		SHINE_TARGET_SSE2 uint32_t fitAlphaIndicesSSE2(const uint8_t* values, const uint8_t* palette, uint8_t* indices)
+		{
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+			__m128i best = _mm_set1_epi8(static_cast<char>(0xff));
+			__m128i bestIndex = _mm_setzero_si128();
+			for (int k = 0; k < 8; ++k)
+			{
+				const __m128i entry = _mm_set1_epi8(static_cast<char>(palette[k]));
+				const __m128i distance = _mm_or_si128(_mm_subs_epu8(v, entry), _mm_subs_epu8(entry, v));
+				// 严格小于：min(d, best) == d 且 d != best
+				const __m128i better = _mm_andnot_si128(_mm_cmpeq_epi8(distance, best),
+					_mm_cmpeq_epi8(_mm_min_epu8(distance, best), distance));
+				best = _mm_min_epu8(distance, best);
+				bestIndex = select(better, _mm_set1_epi8(static_cast<char>(k)), bestIndex);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(indices), bestIndex);
+
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i lo = _mm_unpacklo_epi8(best, zero);
+			const __m128i hi = _mm_unpackhi_epi8(best, zero);
+			return horizontalSum(_mm_add_epi32(_mm_madd_epi16(lo, lo), _mm_madd_epi16(hi, hi)));
+		}
+
+		constexpr DspKernels kSSE2Kernels = {
+			fitColorIndicesSSE2,
+			fitAlphaIndicesSSE2,
+		};
+
+		// ============================================================================
+		// 运行时检测
+		// ============================================================================
+
+		bool cpuHasSSE2() noexcept
+		{
+#if defined(__x86_64__) || defined(_M_X64)
+			return true; // x86-64 基线
+#elif defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 1);
+			return (info[3] & (1 << 26)) != 0;
+#else
+			return __builtin_cpu_supports("sse2");
+#endif
+		}
+#endif // SHINE_BC_DSP_X86
+
+		DspBackend detectBackend() noexcept
+		{
+#if defined(SHINE_BC_DSP_X86)
+			if (cpuHasSSE2())
+			{
+				return DspBackend::SSE2;
+			}
+#endif
+			return DspBackend::Scalar;
+		}
+	} // namespace
+
+	DspBackend activeBackend() noexcept
+	{
+		static const DspBackend backend = detectBackend();
+		return backend;
+	}
+
+	bool isBackendSupported(DspBackend backend) noexcept
+	{
+		switch (backend)
+		{
+		case DspBackend::Scalar:
+			return true;
+#if defined(SHINE_BC_DSP_X86)
+		case DspBackend::SSE2:
+			return cpuHasSSE2();
+#endif
+		default:
+			return false;
+		}
+	}
+
+	const char* backendName(DspBackend backend) noexcept
+	{
+		switch (backend)
+		{
+		case DspBackend::Scalar: return "Scalar";
+		case DspBackend::SSE2: return "SSE2";
+		}
+		return "Unknown";
+	}
+
+	const DspKernels& kernels() noexcept
+	{
+		return kernels(activeBackend());
+	}
+
+	const DspKernels& kernels(DspBackend backend) noexcept
+	{
+#if defined(SHINE_BC_DSP_X86)
+		if (backend == DspBackend::SSE2 && isBackendSupported(backend))
+		{
+			return kSSE2Kernels;
+		}
+#endif
+		return kScalarKernels;
+	}
+
+} // namespace shine::image::bc_dsp
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @file bc_dsp.h
+ * @brief BC 块压缩内核：为 4x4 块中的 16 个像素在调色板中选取最近的索引
+ *
+ * 编码器对每个候选端点都要做一次"逐像素找最近调色板项"，这是压缩中最热的循环。
+ * 提供标量参考实现与 SSE2 内核，运行时按 CPU 特性分派；距离相同时取序号较小的项，
+ * 因此各实现选出的索引与误差逐字节一致（见 test/TextureCompressTest）。
+ */
+
+namespace shine::image::bc_dsp
+{
+	/**
+	 * @brief 内核实现
+	 */
+	enum class DspBackend : uint8_t
+	{
+		Scalar = 0,  ///< 标量参考实现
+		SSE2         ///< x86 SSE2
+	};
+
+	/**
+	 * @brief 当前 CPU 上选用的内核实现（首次调用时检测并缓存）
+	 */
+	DspBackend activeBackend() noexcept;
+
+	/**
+	 * @brief 检查指定内核在当前 CPU / 编译配置下是否可用
+	 */
+	bool isBackendSupported(DspBackend backend) noexcept;
+
+	/**
+	 * @brief 获取内核名称（用于日志与测试输出）
+	 */
+	const char* backendName(DspBackend backend) noexcept;
+
+	/// 一个块的像素数
+	constexpr int kBlockPixels = 16;
+
+	/**
+	 * @brief 一组内核函数
+	 */
+	struct DspKernels
+	{
+		/**
+		 * @brief 按 RGBA 平方距离为 16 个像素选取最近的调色板项
+		 * @param pixels 16 个 RGBA 像素（64 字节）
+		 * @param palette paletteSize 个 RGBA 调色板项
+		 * @param paletteSize 调色板大小（BC1 为 4，BC7 为 4 / 8 / 16）
+		 * @param channelMask 参与比较的通道（小端 uint32_t 掩码，如 0x00FFFFFF 表示忽略 Alpha）
+		 * @param indices 输出 16 个索引
+		 * @return 16 个像素的平方误差之和
+		 */
+		uint32_t (*fitColorIndices)(const uint8_t* pixels, const uint8_t* palette, uint32_t paletteSize,
+			uint32_t channelMask, uint8_t* indices);
+
+		/**
+		 * @brief 为 16 个单通道值选取最近的调色板项（BC4 / BC5 / BC3 Alpha）
+		 * @param values 16 个值
+		 * @param palette 8 个调色板值
+		 * @param indices 输出 16 个索引
+		 * @return 16 个值的平方误差之和
+		 */
+		uint32_t (*fitAlphaIndices)(const uint8_t* values, const uint8_t* palette, uint8_t* indices);
+	};
+
+	/**
+	 * @brief 当前 CPU 上最快的内核
+	 */
+	const DspKernels& kernels() noexcept;
+
+	/**
+	 * @brief 指定实现的内核（不可用时回退到标量实现）
+	 */
+	const DspKernels& kernels(DspBackend backend) noexcept;
+
+} // namespace shine::image::bc_dsp
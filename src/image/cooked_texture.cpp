@@ -0,0 +1,388 @@
+#include "cooked_texture.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+/**
+ * @file cooked_texture.cpp
+ * @brief 烘焙纹理容器的写入与解析
+ *
+ * 解析只读取文件头与 mip 表并逐项校验范围，不触碰数据区；
+ * 数据区的页面在上传 GPU 时才被访问，按需由系统从文件载入。
+ */
+
+namespace shine::image::cooked
+{
+	namespace
+	{
+		constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+		constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+		constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+		constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+		constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+		/// 压缩格式编码上限（BcFormat::BC7 + 1）
+		constexpr uint32_t kMaxCompression = static_cast<uint32_t>(bc::BcFormat::BC7) + 1;
+
+		inline uint64_t read64(const uint8_t* p) noexcept
+		{
+			uint64_t v;
+			std::memcpy(&v, p, sizeof(v));
+			return v;
+		}
+
+		inline uint32_t read32(const uint8_t* p) noexcept
+		{
+			uint32_t v;
+			std::memcpy(&v, p, sizeof(v));
+			return v;
+		}
+
+		inline uint64_t hashRound(uint64_t acc, uint64_t input) noexcept
+		{
+			acc += input * kPrime2;
+			acc = std::rotl(acc, 31);
+			return acc * kPrime1;
+		}
+
+		inline uint64_t mergeRound(uint64_t acc, uint64_t value) noexcept
+		{
+			acc ^= hashRound(0, value);
+			return acc * kPrime1 + kPrime4;
+		}
+
+		constexpr size_t alignUp(size_t value, size_t alignment) noexcept
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		size_t levelBytes(std::optional<bc::BcFormat> compression, uint32_t width, uint32_t height) noexcept
+		{
+			return compression ? bc::compressedSize(*compression, width, height)
+				: static_cast<size_t>(width) * height * 4;
+		}
+	} // namespace
+
+	uint64_t hashBytes(const void* data, size_t size, uint64_t seed) noexcept
+	{
+		const uint8_t* p = static_cast<const uint8_t*>(data);
+		const uint8_t* const end = p + size;
+		uint64_t h;
+
+		if (size >= 32)
+		{
+			uint64_t v1 = seed + kPrime1 + kPrime2;
+			uint64_t v2 = seed + kPrime2;
+			uint64_t v3 = seed;
+			uint64_t v4 = seed - kPrime1;
+			const uint8_t* const limit = end - 32;
+			do
+			{
+				v1 = hashRound(v1, read64(p));
+				v2 = hashRound(v2, read64(p + 8));
+				v3 = hashRound(v3, read64(p + 16));
+				v4 = hashRound(v4, read64(p + 24));
+				p += 32;
+			} while (p <= limit);
+
+			h = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+			h = mergeRound(h, v1);
+			h = mergeRound(h, v2);
+			h = mergeRound(h, v3);
+			h = mergeRound(h, v4);
+		}
+		else
+		{
+			h = seed + kPrime5;
+		}
+
+		h += static_cast<uint64_t>(size);
+		for (; p + 8 <= end; p += 8)
+		{
+			h ^= hashRound(0, read64(p));
+			h = std::rotl(h, 27) * kPrime1 + kPrime4;
+		}
+		if (p + 4 <= end)
+		{
+			h ^= static_cast<uint64_t>(read32(p)) * kPrime1;
+			h = std::rotl(h, 23) * kPrime2 + kPrime3;
+			p += 4;
+		}
+		for (; p < end; ++p)
+		{
+			h ^= *p * kPrime5;
+			h = std::rotl(h, 11) * kPrime1;
+		}
+
+		h ^= h >> 33;
+		h *= kPrime2;
+		h ^= h >> 29;
+		h *= kPrime3;
+		h ^= h >> 32;
+		return h;
+	}
+
+	std::expected<std::vector<uint8_t>, std::string> cook(const uint8_t* rgba, uint32_t width, uint32_t height,
+		const CookOptions& options)
+	{
+		if (!rgba)
+		{
+			return std::unexpected("cook texture: null buffer");
+		}
+		if (width == 0 || height == 0)
+		{
+			return std::unexpected("cook texture: empty image");
+		}
+
+		mip::MipChain chain;
+		if (options.generateMips)
+		{
+			auto built = mip::buildMipChain(rgba, width, height, options.mipOptions);
+			if (!built.has_value())
+			{
+				return std::unexpected(std::move(built.error()));
+			}
+			chain = std::move(*built);
+		}
+
+		// 第 0 级在前的各级尺寸与源数据
+		const uint32_t levelCount = static_cast<uint32_t>(chain.levels.size()) + 1;
+		std::vector<CookedLevelEntry> entries(levelCount);
+		std::vector<const uint8_t*> sources(levelCount);
+		entries[0] = { width, height, 0, levelBytes(options.compression, width, height) };
+		sources[0] = rgba;
+		for (uint32_t i = 1; i < levelCount; ++i)
+		{
+			const mip::MipLevel& level = chain.levels[i - 1];
+			entries[i] = { level.width, level.height, 0, levelBytes(options.compression, level.width, level.height) };
+			sources[i] = chain.levelData(i - 1);
+		}
+
+		// 数据区：最小的一级在前
+		const size_t levelTableOffset = sizeof(CookedHeader);
+		const size_t payloadOffset = alignUp(levelTableOffset + sizeof(CookedLevelEntry) * levelCount, kLevelAlignment);
+		size_t cursor = payloadOffset;
+		for (uint32_t i = levelCount; i-- > 0;)
+		{
+			entries[i].offset = cursor;
+			cursor = alignUp(cursor + static_cast<size_t>(entries[i].size), kLevelAlignment);
+		}
+
+		std::vector<uint8_t> file(cursor, 0);
+		for (uint32_t i = 0; i < levelCount; ++i)
+		{
+			uint8_t* dst = file.data() + entries[i].offset;
+			if (options.compression)
+			{
+				auto result = bc::compress(sources[i], entries[i].width, entries[i].height,
+					static_cast<size_t>(entries[i].width) * 4, *options.compression, dst, options.compressOptions);
+				if (!result.has_value())
+				{
+					return std::unexpected(std::move(result.error()));
+				}
+			}
+			else
+			{
+				std::memcpy(dst, sources[i], static_cast<size_t>(entries[i].size));
+			}
+		}
+
+		CookedHeader header{};
+		std::memcpy(header.magic, kMagic, sizeof(kMagic));
+		header.version = kVersion;
+		header.headerSize = sizeof(CookedHeader);
+		header.width = width;
+		header.height = height;
+		header.compression = options.compression ? static_cast<uint32_t>(*options.compression) + 1 : 0;
+		header.levelCount = levelCount;
+		header.flags = (options.mipOptions.srgb ? kFlagSrgb : 0) |
+			(options.generateMips && options.mipOptions.premultiplyAlpha ? kFlagPremultiplied : 0);
+		header.levelTableOffset = static_cast<uint32_t>(levelTableOffset);
+		header.payloadOffset = payloadOffset;
+		header.payloadSize = cursor - payloadOffset;
+		header.contentHash = hashBytes(file.data() + payloadOffset, cursor - payloadOffset);
+		header.sourceHash = options.sourceHash;
+		header.optionsHash = hashOptions(options);
+
+		std::memcpy(file.data(), &header, sizeof(header));
+		std::memcpy(file.data() + levelTableOffset, entries.data(), sizeof(CookedLevelEntry) * levelCount);
+		return file;
+	}
+
+	uint64_t hashOptions(const CookOptions& options) noexcept
+	{
+		// 逐字段写入定长数组，避免结构体填充字节参与哈希
+		const uint8_t fields[] = {
+			static_cast<uint8_t>(options.compression ? static_cast<uint32_t>(*options.compression) + 1 : 0),
+			static_cast<uint8_t>(options.generateMips),
+			static_cast<uint8_t>(options.mipOptions.filter),
+			static_cast<uint8_t>(options.mipOptions.srgb),
+			static_cast<uint8_t>(options.mipOptions.premultiplyAlpha),
+			static_cast<uint8_t>(options.mipOptions.maxLevels),
+			static_cast<uint8_t>(options.mipOptions.maxLevels >> 8),
+			static_cast<uint8_t>(options.mipOptions.maxLevels >> 16),
+			static_cast<uint8_t>(options.mipOptions.maxLevels >> 24),
+			static_cast<uint8_t>(options.compressOptions.refine),
+		};
+		return hashBytes(fields, sizeof(fields), kVersion);
+	}
+
+	CookedTexture::CookedTexture(util::FileMapView&& file) noexcept
+		: _file(std::move(file))
+		, _bytes(reinterpret_cast<const uint8_t*>(_file.view.data()))
+		, _size(_file.view.size())
+	{
+	}
+
+	std::expected<CookedTexture, std::string> CookedTexture::open(std::string_view path, bool verifyHash)
+	{
+#ifndef SHINE_PLATFORM_WASM
+		auto mapping = util::open_file_from_mapping(path);
+		if (!mapping.has_value())
+		{
+			return std::unexpected(std::move(mapping.error()));
+		}
+		auto fileSize = util::get_file_size(*mapping);
+		if (!fileSize.has_value())
+		{
+			return std::unexpected(std::move(fileSize.error()));
+		}
+		if (*fileSize < sizeof(CookedHeader))
+		{
+			return std::unexpected("cooked texture: file is too small");
+		}
+		auto view = util::read_data_from_mapping(*mapping, *fileSize, 0);
+		if (!view.has_value())
+		{
+			return std::unexpected(std::move(view.error()));
+		}
+		CookedTexture texture(util::FileMapView(std::move(*mapping), std::move(*view)));
+#else
+		bool success = false;
+		util::FileMapping mapping = util::open_file_from_mapping(path, &success);
+		if (!success)
+		{
+			return std::unexpected("cooked texture: failed to open file");
+		}
+		const uint64_t fileSize = util::get_file_size(mapping, &success);
+		if (!success || fileSize < sizeof(CookedHeader))
+		{
+			return std::unexpected("cooked texture: file is too small");
+		}
+		util::MappedView view = util::read_data_from_mapping(mapping, fileSize, 0, &success);
+		if (!success)
+		{
+			return std::unexpected("cooked texture: failed to map file");
+		}
+		CookedTexture texture(util::FileMapView(std::move(mapping), std::move(view)));
+#endif
+
+		auto parsed = texture.parse(verifyHash);
+		if (!parsed.has_value())
+		{
+			return std::unexpected(std::move(parsed.error()));
+		}
+		return texture;
+	}
+
+	std::expected<CookedTexture, std::string> CookedTexture::fromBytes(std::vector<uint8_t> bytes, bool verifyHash)
+	{
+		CookedTexture texture;
+		texture._owned = std::move(bytes);
+		texture._bytes = texture._owned.data();
+		texture._size = texture._owned.size();
+
+		auto parsed = texture.parse(verifyHash);
+		if (!parsed.has_value())
+		{
+			return std::unexpected(std::move(parsed.error()));
+		}
+		return texture;
+	}
+
+	std::expected<void, std::string> CookedTexture::parse(bool verifyHash)
+	{
+		if (!_bytes || _size < sizeof(CookedHeader))
+		{
+			return std::unexpected("cooked texture: file is too small");
+		}
+
+		std::memcpy(&_header, _bytes, sizeof(_header));
+		if (std::memcmp(_header.magic, kMagic, sizeof(kMagic)) != 0)
+		{
+			return std::unexpected("cooked texture: bad magic");
+		}
+		if (_header.version != kVersion || _header.headerSize != sizeof(CookedHeader))
+		{
+			return std::unexpected("cooked texture: unsupported version");
+		}
+		if (_header.width == 0 || _header.height == 0 || _header.compression > kMaxCompression ||
+			_header.levelCount == 0 || _header.levelCount > mip::mipLevelCount(_header.width, _header.height))
+		{
+			return std::unexpected("cooked texture: invalid header");
+		}
+		if (_header.levelTableOffset < sizeof(CookedHeader) ||
+			_header.levelTableOffset > _size ||
+			(_size - _header.levelTableOffset) / sizeof(CookedLevelEntry) < _header.levelCount)
+		{
+			return std::unexpected("cooked texture: truncated level table");
+		}
+		if (_header.payloadOffset > _size || _header.payloadSize > _size - _header.payloadOffset)
+		{
+			return std::unexpected("cooked texture: truncated payload");
+		}
+
+		const auto format = compression();
+		_levels.resize(_header.levelCount);
+		std::memcpy(_levels.data(), _bytes + _header.levelTableOffset, sizeof(CookedLevelEntry) * _header.levelCount);
+		for (uint32_t i = 0; i < _header.levelCount; ++i)
+		{
+			const CookedLevelEntry& entry = _levels[i];
+			const uint32_t expectedWidth = std::max(1u, _header.width >> i);
+			const uint32_t expectedHeight = std::max(1u, _header.height >> i);
+			if (entry.width != expectedWidth || entry.height != expectedHeight ||
+				entry.size != levelBytes(format, entry.width, entry.height))
+			{
+				return std::unexpected("cooked texture: invalid level entry");
+			}
+			if (entry.offset < _header.payloadOffset ||
+				entry.offset - _header.payloadOffset > _header.payloadSize ||
+				entry.size > _header.payloadSize - (entry.offset - _header.payloadOffset))
+			{
+				return std::unexpected("cooked texture: level data out of range");
+			}
+		}
+
+		if (verifyHash && !verify())
+		{
+			return std::unexpected("cooked texture: content hash mismatch");
+		}
+		return {};
+	}
+
+	std::optional<bc::BcFormat> CookedTexture::compression() const noexcept
+	{
+		if (_header.compression == 0)
+		{
+			return std::nullopt;
+		}
+		return static_cast<bc::BcFormat>(_header.compression - 1);
+	}
+
+	CookedLevel CookedTexture::level(uint32_t index) const noexcept
+	{
+		if (index >= _levels.size())
+		{
+			return {};
+		}
+		const CookedLevelEntry& entry = _levels[index];
+		return { entry.width, entry.height, _bytes + entry.offset, static_cast<size_t>(entry.size) };
+	}
+
+	bool CookedTexture::verify() const noexcept
+	{
+		return _bytes && hashBytes(_bytes + _header.payloadOffset, static_cast<size_t>(_header.payloadSize)) == _header.contentHash;
+	}
+
+} // namespace shine::image::cooked
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <expected>
+
+#include "image/bc_compress.h"
+#include "image/mipmap.h"
+
+#include "util/file_util.ixx"
+
+/**
+ * @file cooked_texture.h
+ * @brief 引擎原生的烘焙纹理容器（.stex）：导入时解码、生成 mip、可选块压缩，运行时映射文件后直接上传
+ *
+ * 文件布局（小端）：
+ * | 偏移            | 内容                                                        |
+ * |-----------------|-------------------------------------------------------------|
+ * | 0               | CookedHeader（72 字节）                                     |
+ * | 72              | CookedLevelEntry[levelCount]（每项 24 字节，第 0 级在前）   |
+ * | payloadOffset   | 各级像素数据，最小的一级在前，每级按 64 字节对齐            |
+ *
+ * 数据区按"尾部在前"排列，流式加载只读文件前部就能拿到完整的低分辨率 mip 尾部；
+ * 每级数据就是 GPU 上传所需的格式（RGBA8 或 BC 块），加载时不做解码也不做拷贝。
+ * contentHash 是数据区的 XXH64，sourceHash 记录导入时源文件的 XXH64，optionsHash 记录影响输出的烘焙选项，
+ * 两者都一致时才能复用已有的烘焙文件。
+ */
+
+namespace shine::image::cooked
+{
+	/// 文件扩展名（不含点）
+	constexpr std::string_view kFileExtension = "stex";
+
+	/// 文件头标识
+	constexpr char kMagic[4] = { 'S', 'T', 'E', 'X' };
+
+	/// 当前格式版本，结构变化时递增
+	constexpr uint16_t kVersion = 2;
+
+	/// 每级数据的对齐字节数
+	constexpr size_t kLevelAlignment = 64;
+
+	/// 标志位
+	constexpr uint32_t kFlagSrgb = 1u << 0;           ///< 颜色为 sRGB 编码
+	constexpr uint32_t kFlagPremultiplied = 1u << 1;  ///< mip 按预乘 Alpha 滤波
+
+	/**
+	 * @brief 文件头
+	 */
+	struct CookedHeader
+	{
+		char magic[4];
+		uint16_t version;
+		uint16_t headerSize;
+		uint32_t width;
+		uint32_t height;
+		uint32_t compression;     ///< 0 表示 RGBA8，否则为 bc::BcFormat + 1
+		uint32_t levelCount;      ///< 含第 0 级
+		uint32_t flags;
+		uint32_t levelTableOffset;
+		uint64_t payloadOffset;
+		uint64_t payloadSize;
+		uint64_t contentHash;     ///< 数据区的 XXH64
+		uint64_t sourceHash;      ///< 源文件的 XXH64（未知时为 0）
+		uint64_t optionsHash;     ///< hashOptions(烘焙选项)
+	};
+	static_assert(sizeof(CookedHeader) == 72, "CookedHeader 的大小是文件格式的一部分");
+
+	/**
+	 * @brief 一级 mip 的描述
+	 */
+	struct CookedLevelEntry
+	{
+		uint32_t width;
+		uint32_t height;
+		uint64_t offset;  ///< 相对文件开头的字节偏移
+		uint64_t size;    ///< 字节数
+	};
+	static_assert(sizeof(CookedLevelEntry) == 24, "CookedLevelEntry 的大小是文件格式的一部分");
+
+	/**
+	 * @brief 烘焙选项
+	 */
+	struct CookOptions
+	{
+		std::optional<bc::BcFormat> compression;  ///< 为空时保存 RGBA8
+		bool generateMips = true;                 ///< 生成完整 mip 链
+		mip::MipOptions mipOptions;
+		bc::CompressOptions compressOptions;
+		uint64_t sourceHash = 0;                  ///< 源文件的 hashBytes，写入文件头
+	};
+
+	/**
+	 * @brief 一级 mip 的数据视图（指向映射的文件页或内存缓冲）
+	 */
+	struct CookedLevel
+	{
+		uint32_t width = 0;
+		uint32_t height = 0;
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+	};
+
+	/**
+	 * @brief XXH64 哈希
+	 */
+	uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0) noexcept;
+
+	/**
+	 * @brief 烘焙选项的哈希，覆盖所有影响输出内容的字段
+	 *
+	 * 不含 sourceHash，也不含 parallel / parallelMinPixels 这类只影响调度、不影响结果的字段。
+	 */
+	uint64_t hashOptions(const CookOptions& options) noexcept;
+
+	/**
+	 * @brief 把 RGBA8 图像烘焙为 .stex 文件内容
+	 * @param rgba 源图像（直通 Alpha 的 RGBA8，紧密排列）
+	 * @param width 宽度
+	 * @param height 高度
+	 * @param options 烘焙选项
+	 * @return 文件内容，失败返回错误信息
+	 */
+	std::expected<std::vector<uint8_t>, std::string> cook(const uint8_t* rgba, uint32_t width, uint32_t height,
+		const CookOptions& options = {});
+
+	/**
+	 * @brief 已加载的烘焙纹理
+	 *
+	 * 通过 open() 加载时持有文件映射，各级数据直接指向映射的页面；对象可移动构造，移动后指针仍有效。
+	 */
+	class CookedTexture
+	{
+	public:
+		CookedTexture() = default;
+
+		/**
+		 * @brief 通过 util::open_file_from_mapping 映射文件并解析
+		 * @param path 文件路径（UTF-8）
+		 * @param verifyHash 是否校验 contentHash（需要读取全部数据页）
+		 */
+		static std::expected<CookedTexture, std::string> open(std::string_view path, bool verifyHash = false);
+
+		/**
+		 * @brief 从内存中的文件内容解析（接管缓冲）
+		 */
+		static std::expected<CookedTexture, std::string> fromBytes(std::vector<uint8_t> bytes, bool verifyHash = true);
+
+		uint32_t width() const noexcept { return _header.width; }
+		uint32_t height() const noexcept { return _header.height; }
+		uint32_t levelCount() const noexcept { return _header.levelCount; }
+		uint32_t flags() const noexcept { return _header.flags; }
+		bool isSrgb() const noexcept { return (_header.flags & kFlagSrgb) != 0; }
+		uint64_t contentHash() const noexcept { return _header.contentHash; }
+		uint64_t sourceHash() const noexcept { return _header.sourceHash; }
+		uint64_t optionsHash() const noexcept { return _header.optionsHash; }
+
+		/**
+		 * @brief 块压缩格式（RGBA8 时为空）
+		 */
+		std::optional<bc::BcFormat> compression() const noexcept;
+
+		/**
+		 * @brief 获取一级 mip（0 为原图）
+		 */
+		CookedLevel level(uint32_t index) const noexcept;
+
+		/**
+		 * @brief 重新计算数据区哈希并与文件头比较
+		 */
+		bool verify() const noexcept;
+
+		/**
+		 * @brief 完整的文件内容
+		 */
+		const uint8_t* data() const noexcept { return _bytes; }
+		size_t size() const noexcept { return _size; }
+
+	private:
+		explicit CookedTexture(util::FileMapView&& file) noexcept;
+
+		std::expected<void, std::string> parse(bool verifyHash);
+
+		util::FileMapView _file;
+		std::vector<uint8_t> _owned;
+		const uint8_t* _bytes = nullptr;
+		size_t _size = 0;
+		CookedHeader _header{};
+		std::vector<CookedLevelEntry> _levels;
+	};
+
+} // namespace shine::image::cooked
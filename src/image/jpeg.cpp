@@ -5,6 +5,7 @@
 #include <string_view>
 #include <string>
 #include <expected>
+#include <optional>
 #include <bit>
 #include <cmath>
 
@@ -12,10 +13,12 @@
 
 #include "shine_define.h"
 #include "util/timer/function_timer.h"
+#include "util/thread/task_group.h"
 #include "util/file_util.ixx"
 
 #include "util/encoding/byte_convert.ixx"
-#include "util/encoding/bit_reader.ixx"
+
+#include "jpeg_dsp.h"
 
 
 
@@ -32,11 +35,12 @@
  * - EOI：文件结束标记 (FF D9)
  * 
  * @note JPEG 解码流程：
- * 1. 解析段（SOF, DQT, DHT, SOS）
- * 2. Huffman 解码扫描数据
- * 3. 反量化 DCT 系数
- * 4. IDCT（逆离散余弦变换）
- * 5. 颜色空间转换（YCbCr -> RGB）
+ * 1. 解析段（SOF, DQT, DHT, DRI, SOS），记录每个扫描的参数和熵编码数据位置
+ * 2. 逐个扫描 Huffman 解码到系数缓冲（基线一次完成；渐进式按频谱/位平面逐步细化）
+ * 3. 按 MCU 行反量化 + IDCT（逆离散余弦变换）到 8 位条带
+ * 4. 颜色空间转换（YCbCr -> RGB），直接写入 RGBA 输出
+ *
+ * 第 3、4 步使用 jpeg_dsp 中的 SSE2 / AVX2 内核（运行时分派）。
  * 
  * @see ISO/IEC 10918-1 (JPEG Standard)
  */
@@ -85,10 +89,622 @@ namespace shine::image
 	static constexpr uint8_t MARKER_DHT = 0xC4;       ///< Define Huffman Table
 	static constexpr uint8_t MARKER_DQT = 0xDB;      ///< Define Quantization Table
 	static constexpr uint8_t MARKER_SOS = 0xDA;      ///< Start of Scan
+	static constexpr uint8_t MARKER_DRI = 0xDD;      ///< Define Restart Interval
+	static constexpr uint8_t MARKER_RST0 = 0xD0;     ///< Restart Marker 0
+	static constexpr uint8_t MARKER_RST7 = 0xD7;     ///< Restart Marker 7
 	static constexpr uint8_t MARKER_APP0 = 0xE0;     ///< Application Data (JFIF)
 	static constexpr uint8_t MARKER_APP15 = 0xEF;    ///< Application Data
 	static constexpr uint8_t MARKER_COM = 0xFE;       ///< Comment
 
+	namespace
+	{
+		/// Huffman 快速查找表的位数
+		constexpr uint32_t HUFFMAN_FAST_BITS = 9;
+
+		/// Zigzag 序号 -> 自然顺序下标（多出的 16 项用于容错越界的游程）
+		constexpr uint8_t DEZIGZAG[64 + 16] = {
+			 0,  1,  8, 16,  9,  2,  3, 10,
+			17, 24, 32, 25, 18, 11,  4,  5,
+			12, 19, 26, 33, 40, 48, 41, 34,
+			27, 20, 13,  6,  7, 14, 21, 28,
+			35, 42, 49, 56, 57, 50, 43, 36,
+			29, 22, 15, 23, 30, 37, 44, 51,
+			58, 59, 52, 45, 38, 31, 39, 46,
+			53, 60, 61, 54, 47, 55, 62, 63,
+			63, 63, 63, 63, 63, 63, 63, 63,
+			63, 63, 63, 63, 63, 63, 63, 63
+		};
+
+		/**
+		 * @brief JPEG 熵编码数据位读取器
+		 *
+		 * 与 Deflate 不同，JPEG 按 MSB 优先读取，数据中的 0xFF 后跟 0x00 填充字节。
+		 * 遇到标记（RSTn/EOI 等）后停止读取真实数据，之后补 0，
+		 * 并通过 overrun() 判断是否真的消耗了补充位。
+		 */
+		class JpegBitReader
+		{
+		public:
+			JpegBitReader(const uint8_t* data, size_t size) noexcept
+				: data_(data), size_(size)
+			{
+			}
+
+			/**
+			 * @brief 查看高位的 nbits 位（1 ~ 16 位）
+			 */
+			uint32_t peekBits(uint32_t nbits) noexcept
+			{
+				if (bitCount_ < 16) fill();
+				return static_cast<uint32_t>(buffer_ >> (64 - nbits));
+			}
+
+			void consumeBits(uint32_t nbits) noexcept
+			{
+				buffer_ <<= nbits;
+				bitCount_ -= nbits;
+			}
+
+			/**
+			 * @brief 读取 nbits 位（0 ~ 16 位）
+			 */
+			uint32_t readBits(uint32_t nbits) noexcept
+			{
+				if (nbits == 0) return 0;
+				const uint32_t value = peekBits(nbits);
+				consumeBits(nbits);
+				return value;
+			}
+
+			uint32_t readBit() noexcept
+			{
+				return readBits(1);
+			}
+
+			/**
+			 * @brief 读取 nbits 位并按 JPEG 规则扩展符号（F.2.2.1 EXTEND）
+			 */
+			int32_t receiveExtend(uint32_t nbits) noexcept
+			{
+				if (nbits == 0) return 0;
+				const int32_t value = static_cast<int32_t>(readBits(nbits));
+				return value < (1 << (nbits - 1)) ? value - (1 << nbits) + 1 : value;
+			}
+
+			/**
+			 * @brief 在重启间隔结束处跳到下一个 RSTn 标记之后，丢弃缓冲的填充位
+			 * @return true 如果找到了 RSTn 标记
+			 */
+			bool restart() noexcept
+			{
+				buffer_ = 0;
+				bitCount_ = 0;
+				paddingBytes_ = 0;
+				markerHit_ = false;
+				while (pos_ + 1 < size_)
+				{
+					if (data_[pos_] == 0xFF && data_[pos_ + 1] >= MARKER_RST0 && data_[pos_ + 1] <= MARKER_RST7)
+					{
+						pos_ += 2;
+						return true;
+					}
+					++pos_;
+				}
+				return false;
+			}
+
+			/**
+			 * @brief 是否已经消耗了数据末尾（或标记之后）补充的 0 位
+			 */
+			bool overrun() const noexcept
+			{
+				return paddingBytes_ * 8 > bitCount_;
+			}
+
+		private:
+			void fill() noexcept
+			{
+				while (bitCount_ <= 56)
+				{
+					uint64_t byte = 0;
+					if (!markerHit_ && pos_ < size_)
+					{
+						byte = data_[pos_];
+						if (byte == 0xFF)
+						{
+							const uint8_t next = pos_ + 1 < size_ ? data_[pos_ + 1] : 0xFF;
+							if (next == 0x00)
+							{
+								pos_ += 2;
+							}
+							else
+							{
+								markerHit_ = true;
+								byte = 0;
+								++paddingBytes_;
+							}
+						}
+						else
+						{
+							++pos_;
+						}
+					}
+					else
+					{
+						++paddingBytes_;
+					}
+					buffer_ |= byte << (56 - bitCount_);
+					bitCount_ += 8;
+				}
+			}
+
+			const uint8_t* data_;
+			size_t size_;
+			size_t pos_ = 0;
+			uint64_t buffer_ = 0;
+			uint32_t bitCount_ = 0;
+			uint32_t paddingBytes_ = 0;
+			bool markerHit_ = false;
+		};
+
+		/**
+		 * @brief Huffman 解码符号（9 位快速表 + 规范码逐长度比较）
+		 * @return 解码的符号值，失败返回 -1
+		 */
+		int32_t decodeHuffmanSymbol(JpegBitReader& reader, const JpegHuffmanTable& table) noexcept
+		{
+			const uint16_t entry = table.codes[reader.peekBits(HUFFMAN_FAST_BITS)];
+			if (entry != 0xFFFF)
+			{
+				reader.consumeBits(entry & 0xFF);
+				return entry >> 8;
+			}
+
+			const int32_t code16 = static_cast<int32_t>(reader.peekBits(16));
+			for (uint32_t length = HUFFMAN_FAST_BITS + 1; length <= 16; ++length)
+			{
+				const int32_t code = code16 >> (16 - length);
+				if (code <= table.maxCode[length])
+				{
+					reader.consumeBits(length);
+					return table.symbols[code + table.valueOffset[length]];
+				}
+			}
+			return -1;
+		}
+
+		/**
+		 * @brief 基线顺序模式：解码一个完整的 8x8 块（DC 差分 + 全部 AC）
+		 */
+		bool decodeBlockBaseline(JpegBitReader& reader, const JpegHuffmanTable& dcTable,
+			const JpegHuffmanTable& acTable, int32_t& dcPredictor, int16_t* block) noexcept
+		{
+			const int32_t dcSize = decodeHuffmanSymbol(reader, dcTable);
+			if (dcSize < 0 || dcSize > 15) return false;
+			dcPredictor += reader.receiveExtend(static_cast<uint32_t>(dcSize));
+			block[0] = static_cast<int16_t>(dcPredictor);
+
+			for (uint32_t k = 1; k < 64; ++k)
+			{
+				const int32_t rs = decodeHuffmanSymbol(reader, acTable);
+				if (rs < 0) return false;
+				const uint32_t run = static_cast<uint32_t>(rs) >> 4;
+				const uint32_t size = static_cast<uint32_t>(rs) & 0x0F;
+				if (size == 0)
+				{
+					if (run != 15) break;  // EOB
+					k += 15;               // ZRL：16 个 0
+					continue;
+				}
+				k += run;
+				if (k > 63) return false;
+				block[DEZIGZAG[k]] = static_cast<int16_t>(reader.receiveExtend(size));
+			}
+			return true;
+		}
+
+		/**
+		 * @brief 渐进式 DC 首次扫描（G.1.2.1）
+		 */
+		bool decodeBlockDCFirst(JpegBitReader& reader, const JpegHuffmanTable& dcTable,
+			int32_t& dcPredictor, uint32_t approxLow, int16_t* block) noexcept
+		{
+			const int32_t dcSize = decodeHuffmanSymbol(reader, dcTable);
+			if (dcSize < 0 || dcSize > 15) return false;
+			dcPredictor += reader.receiveExtend(static_cast<uint32_t>(dcSize));
+			block[0] = static_cast<int16_t>(dcPredictor * (1 << approxLow));
+			return true;
+		}
+
+		/**
+		 * @brief 渐进式 DC 细化扫描：每块追加 1 位
+		 */
+		void decodeBlockDCRefine(JpegBitReader& reader, uint32_t approxLow, int16_t* block) noexcept
+		{
+			if (reader.readBit())
+			{
+				block[0] = static_cast<int16_t>(block[0] | (1 << approxLow));
+			}
+		}
+
+		/**
+		 * @brief 渐进式 AC 首次扫描（G.1.2.2），EOBRUN 跨块延续
+		 */
+		bool decodeBlockACFirst(JpegBitReader& reader, const JpegHuffmanTable& acTable,
+			uint32_t spectralStart, uint32_t spectralEnd, uint32_t approxLow,
+			uint32_t& eobRun, int16_t* block) noexcept
+		{
+			if (eobRun > 0)
+			{
+				--eobRun;
+				return true;
+			}
+
+			for (uint32_t k = spectralStart; k <= spectralEnd; ++k)
+			{
+				const int32_t rs = decodeHuffmanSymbol(reader, acTable);
+				if (rs < 0) return false;
+				const uint32_t run = static_cast<uint32_t>(rs) >> 4;
+				const uint32_t size = static_cast<uint32_t>(rs) & 0x0F;
+				if (size == 0)
+				{
+					if (run < 15)
+					{
+						// EOBn：本块及之后 2^run + 额外位 - 1 个块在该频段都为 0
+						eobRun = (1u << run) - 1;
+						if (run != 0) eobRun += reader.readBits(run);
+						break;
+					}
+					k += 15;
+					continue;
+				}
+				k += run;
+				if (k > 63) return false;
+				block[DEZIGZAG[k]] = static_cast<int16_t>(reader.receiveExtend(size) * (1 << approxLow));
+			}
+			return true;
+		}
+
+		/**
+		 * @brief 渐进式 AC 细化扫描（G.1.2.3）
+		 *
+		 * 新出现的非零系数只能是 ±1<<Al；已有的非零系数每个追加 1 位修正，
+		 * 游程只统计当前为 0 的系数。
+		 */
+		bool decodeBlockACRefine(JpegBitReader& reader, const JpegHuffmanTable& acTable,
+			uint32_t spectralStart, uint32_t spectralEnd, uint32_t approxLow,
+			uint32_t& eobRun, int16_t* block) noexcept
+		{
+			const int32_t positive = 1 << approxLow;
+			const int32_t negative = -positive;
+
+			auto refine = [&](int16_t& coef)
+			{
+				if (reader.readBit() && (coef & positive) == 0)
+				{
+					coef = static_cast<int16_t>(coef + (coef >= 0 ? positive : negative));
+				}
+			};
+
+			uint32_t k = spectralStart;
+			if (eobRun == 0)
+			{
+				for (; k <= spectralEnd; ++k)
+				{
+					const int32_t rs = decodeHuffmanSymbol(reader, acTable);
+					if (rs < 0) return false;
+					int32_t run = rs >> 4;
+					const uint32_t size = static_cast<uint32_t>(rs) & 0x0F;
+					int32_t value = 0;
+					if (size != 0)
+					{
+						if (size != 1) return false;
+						value = reader.readBit() ? positive : negative;
+					}
+					else if (run != 15)
+					{
+						eobRun = 1u << run;
+						if (run != 0) eobRun += reader.readBits(static_cast<uint32_t>(run));
+						break;
+					}
+
+					// 跳过 run 个为 0 的系数，途中的非零系数逐个细化
+					while (k <= spectralEnd)
+					{
+						int16_t& coef = block[DEZIGZAG[k]];
+						if (coef != 0)
+						{
+							refine(coef);
+						}
+						else
+						{
+							if (run == 0) break;
+							--run;
+						}
+						++k;
+					}
+
+					if (value != 0 && k <= spectralEnd)
+					{
+						block[DEZIGZAG[k]] = static_cast<int16_t>(value);
+					}
+				}
+			}
+
+			if (eobRun > 0)
+			{
+				// 处于 EOB 游程中：只细化已有的非零系数
+				for (; k <= spectralEnd; ++k)
+				{
+					int16_t& coef = block[DEZIGZAG[k]];
+					if (coef != 0) refine(coef);
+				}
+				--eobRun;
+			}
+			return true;
+		}
+
+		/// 扫描类型：基线顺序 / 渐进式 DC 首次、DC 细化、AC 首次、AC 细化
+		enum class ScanKind { Baseline, DCFirst, DCRefine, ACFirst, ACRefine };
+
+		/**
+		 * @brief 检查扫描参数并确定扫描类型
+		 */
+		std::expected<ScanKind, std::string> classifyScan(const JpegScan& scan, bool progressive,
+			const std::vector<JpegComponent>& components)
+		{
+			ScanKind kind = ScanKind::Baseline;
+
+			if (progressive)
+			{
+				if (scan.spectralStart > scan.spectralEnd || scan.spectralEnd > 63 || scan.approxLow > 13)
+				{
+					return std::unexpected("渐进式扫描参数无效");
+				}
+				if (scan.spectralStart == 0)
+				{
+					if (scan.spectralEnd != 0)
+					{
+						return std::unexpected("渐进式 DC 扫描不能包含 AC 系数");
+					}
+					kind = scan.approxHigh == 0 ? ScanKind::DCFirst : ScanKind::DCRefine;
+				}
+				else
+				{
+					if (scan.componentCount != 1)
+					{
+						return std::unexpected("渐进式 AC 扫描只能包含一个分量");
+					}
+					kind = scan.approxHigh == 0 ? ScanKind::ACFirst : ScanKind::ACRefine;
+				}
+			}
+
+			for (uint32_t i = 0; i < scan.componentCount; ++i)
+			{
+				bool needDC = kind == ScanKind::Baseline || kind == ScanKind::DCFirst;
+				bool needAC = kind == ScanKind::Baseline || kind == ScanKind::ACFirst || kind == ScanKind::ACRefine;
+				if ((needDC && !scan.dcTables[i].isValid) || (needAC && !scan.acTables[i].isValid))
+				{
+					return std::unexpected(fmt::format("分量 {} 的 Huffman 表无效", components[scan.componentIndices[i]].id));
+				}
+			}
+
+			return kind;
+		}
+
+		/**
+		 * @brief 解码一段扫描单元所需的只读参数（串行与按重启间隔并行共用）
+		 */
+		struct ScanDecodeContext
+		{
+			const JpegScan* scan;
+			ScanKind kind;
+			const std::vector<JpegComponent>* components;
+			std::vector<std::vector<int16_t>>* coefficients;
+			uint32_t unitsX;            ///< 每行扫描单元数（交错扫描为 MCU，单分量扫描为块）
+			uint32_t unitRowBase = 0;   ///< 系数缓冲第 0 行对应的单元行（逐 MCU 行流式解码时只保留一行）
+		};
+
+		/**
+		 * @brief 熵解码的游标状态，可以跨多次 decodeScanUnits 调用延续
+		 */
+		struct ScanDecodeState
+		{
+			JpegBitReader reader;
+			uint32_t segmentBegin = 0;              ///< reader 数据起点对应的单元（此处不需要跳过 RSTn）
+			std::array<int32_t, 4> dcPredictors{};  ///< DC 预测器（每个扫描分量一个）
+			uint32_t eobRun = 0;                    ///< EOB 游程（仅渐进式 AC 扫描）
+		};
+
+		/**
+		 * @brief 解码扫描单元 [unitBegin, unitEnd)
+		 *
+		 * 从 state 的位置继续解码；state.segmentBegin 必须是扫描开头或重启间隔的开头，
+		 * 之后跨越重启间隔时由 reader.restart() 跳过 RSTn 标记。
+		 * 不同的单元写入互不重叠的系数块，多个范围可以并发解码。
+		 */
+		std::expected<void, std::string> decodeScanUnits(const ScanDecodeContext& ctx, ScanDecodeState& state,
+			uint32_t unitBegin, uint32_t unitEnd)
+		{
+			const JpegScan& scan = *ctx.scan;
+			JpegBitReader& reader = state.reader;
+			std::array<int32_t, 4>& dcPredictors = state.dcPredictors;
+			uint32_t& eobRun = state.eobRun;
+
+			auto decodeBlock = [&](uint32_t scanComp, int16_t* block) -> bool
+			{
+				switch (ctx.kind)
+				{
+				case ScanKind::Baseline:
+					return decodeBlockBaseline(reader, scan.dcTables[scanComp], scan.acTables[scanComp],
+						dcPredictors[scanComp], block);
+				case ScanKind::DCFirst:
+					return decodeBlockDCFirst(reader, scan.dcTables[scanComp], dcPredictors[scanComp],
+						scan.approxLow, block);
+				case ScanKind::DCRefine:
+					decodeBlockDCRefine(reader, scan.approxLow, block);
+					return true;
+				case ScanKind::ACFirst:
+					return decodeBlockACFirst(reader, scan.acTables[scanComp], scan.spectralStart, scan.spectralEnd,
+						scan.approxLow, eobRun, block);
+				case ScanKind::ACRefine:
+					return decodeBlockACRefine(reader, scan.acTables[scanComp], scan.spectralStart, scan.spectralEnd,
+						scan.approxLow, eobRun, block);
+				}
+				return false;
+			};
+
+			for (uint32_t unitIndex = unitBegin; unitIndex < unitEnd; ++unitIndex)
+			{
+				// 每个重启间隔开始时重置预测器（RSTn 标记之后）
+				if (scan.restartInterval != 0 && unitIndex != state.segmentBegin && unitIndex % scan.restartInterval == 0)
+				{
+					if (!reader.restart())
+					{
+						return std::unexpected("缺少 RST 标记");
+					}
+					dcPredictors.fill(0);
+					eobRun = 0;
+				}
+
+				const uint32_t unitX = unitIndex % ctx.unitsX;
+				const uint32_t unitY = unitIndex / ctx.unitsX;
+				for (uint32_t i = 0; i < scan.componentCount; ++i)
+				{
+					const uint32_t compIdx = scan.componentIndices[i];
+					const JpegComponent& comp = (*ctx.components)[compIdx];
+					const uint32_t blocksH = scan.componentCount == 1 ? 1 : comp.sampling.h;
+					const uint32_t blocksV = scan.componentCount == 1 ? 1 : comp.sampling.v;
+
+					for (uint32_t v = 0; v < blocksV; ++v)
+					{
+						for (uint32_t h = 0; h < blocksH; ++h)
+						{
+							uint32_t blockX = unitX * blocksH + h;
+							uint32_t blockY = (unitY - ctx.unitRowBase) * blocksV + v;
+							int16_t* block = (*ctx.coefficients)[compIdx].data() +
+								(static_cast<size_t>(blockY) * comp.blocksPerLine + blockX) * 64;
+							if (!decodeBlock(i, block))
+							{
+								return std::unexpected(fmt::format("分量 {} 的 Huffman 数据无效", comp.id));
+							}
+						}
+					}
+				}
+
+				if (reader.overrun())
+				{
+					return std::unexpected("扫描数据不完整");
+				}
+			}
+
+			return {};
+		}
+
+		/**
+		 * @brief 按 RSTn 标记切分熵编码数据
+		 *
+		 * 第 k 段为第 k 个重启间隔的数据（不含标记本身）。只在标记数恰好等于
+		 * intervalCount - 1 时返回 true，否则交给串行路径处理（含报错）。
+		 */
+		bool findRestartSegments(const uint8_t* data, size_t size, uint32_t intervalCount,
+			std::vector<std::pair<size_t, size_t>>& segments)
+		{
+			segments.clear();
+			segments.reserve(intervalCount);
+
+			size_t segmentBegin = 0;
+			for (size_t pos = 0; pos + 1 < size; ++pos)
+			{
+				if (data[pos] != 0xFF)
+				{
+					continue;
+				}
+				const uint8_t next = data[pos + 1];
+				if (next >= MARKER_RST0 && next <= MARKER_RST7)
+				{
+					if (segments.size() + 1 >= intervalCount)
+					{
+						return false;
+					}
+					segments.emplace_back(segmentBegin, pos);
+					segmentBegin = pos + 2;
+					++pos;
+				}
+				else if (next == 0x00)
+				{
+					++pos;
+				}
+			}
+
+			segments.emplace_back(segmentBegin, size);
+			return segments.size() == intervalCount;
+		}
+
+#if !defined(SHINE_PLATFORM_WASM) && !defined(__EMSCRIPTEN__)
+		/**
+		 * @brief 按重启间隔并行解码一个扫描（各段由 findRestartSegments 切分）
+		 */
+		std::expected<void, std::string> decodeScanParallel(const ScanDecodeContext& scanCtx, const uint8_t* data,
+			const std::vector<std::pair<size_t, size_t>>& segments, uint32_t unitCount)
+		{
+			util::FunctionTimer timer("JPEG 解码: 按重启间隔并行熵解码", util::TimerPrecision::Milliseconds);
+
+			// 每个任务负责若干个连续的重启间隔；每个工作线程约 4 个任务，兼顾负载均衡与调度开销
+			const uint32_t intervalCount = static_cast<uint32_t>(segments.size());
+			const uint32_t threadCount = util::ThreadPool::Get().GetThreadCount() + 1;
+			const uint32_t intervalsPerTask = std::max<uint32_t>(1, (intervalCount + threadCount * 4 - 1) / (threadCount * 4));
+			const uint32_t taskCount = (intervalCount + intervalsPerTask - 1) / intervalsPerTask;
+
+			struct ParallelContext
+			{
+				const ScanDecodeContext* scan;
+				const uint8_t* data;
+				const std::vector<std::pair<size_t, size_t>>* segments;
+				uint32_t unitCount;
+				uint32_t intervalsPerTask;
+				std::vector<std::string> errors;  ///< 每个重启间隔的错误（空表示成功）
+			} ctx{ &scanCtx, data, &segments, unitCount, intervalsPerTask,
+				std::vector<std::string>(intervalCount) };
+
+			util::TaskGroup group(taskCount, [](void* userdata, u32 task)
+			{
+				auto& c = *static_cast<ParallelContext*>(userdata);
+				const uint32_t restartInterval = c.scan->scan->restartInterval;
+				const uint32_t intervalEnd = std::min<uint32_t>(static_cast<uint32_t>(c.segments->size()), (task + 1) * c.intervalsPerTask);
+				for (uint32_t interval = task * c.intervalsPerTask; interval < intervalEnd; ++interval)
+				{
+					const auto [begin, end] = (*c.segments)[interval];
+					const uint32_t unitBegin = interval * restartInterval;
+					ScanDecodeState state{ JpegBitReader(c.data + begin, end - begin), unitBegin };
+					auto result = decodeScanUnits(*c.scan, state, unitBegin, std::min(c.unitCount, unitBegin + restartInterval));
+					if (!result.has_value())
+					{
+						c.errors[interval] = std::move(result.error());
+						return;
+					}
+				}
+			}, &ctx);
+
+			for (uint32_t task = 0; task < taskCount; ++task)
+			{
+				group.Submit(task);
+			}
+			group.Wait();
+
+			// 报告文件中最靠前的错误，与串行解码一致
+			for (const std::string& error : ctx.errors)
+			{
+				if (!error.empty())
+				{
+					return std::unexpected(error);
+				}
+			}
+			return {};
+		}
+#endif
+	} // namespace
+
 	// ============================================================================
 	// IAssetLoader 接口实现
 	// ============================================================================
@@ -160,9 +776,11 @@ namespace shine::image
 	{
 		rawJpegData.clear();
 		imageData.clear();
-		scanData.clear();
 		components.clear();
-		scanComponentIds.clear();
+		coefficients.clear();
+		scans.clear();
+		restartInterval = 0;
+		progressive = false;
 		
 		// 重置表
 		for (auto& table : quantizationTables)
@@ -180,6 +798,8 @@ namespace shine::image
 		
 		_width = 0;
 		_height = 0;
+		_outputWidth = 0;
+		_outputHeight = 0;
 		componentCount = 0;
 		_loaded = false;
 		setState(shine::loader::EAssetLoadState::NONE);
@@ -333,6 +953,7 @@ namespace shine::image
 			case MARKER_SOF0:  // Baseline DCT
 			case MARKER_SOF1:  // Extended DCT
 			case MARKER_SOF2:  // Progressive DCT
+				progressive = (marker == MARKER_SOF2);
 				parseSuccess = parseSOF(segmentData, segmentDataLength);
 				break;
 
@@ -344,63 +965,59 @@ namespace shine::image
 				parseSuccess = parseDHT(segmentData, segmentDataLength);
 				break;
 
+			case MARKER_DRI:
+				parseSuccess = parseDRI(segmentData, segmentDataLength);
+				break;
+
 			case MARKER_SOS:
 			{
-				parseSuccess = parseSOS(segmentData, segmentDataLength);
-				// SOS 之后是扫描数据，需要特殊处理
+				if (!parseSOS(segmentData, segmentDataLength))
+				{
+					return std::unexpected("解析 JPEG 段失败: 标记 0xDA");
+				}
+				// SOS 之后是熵编码数据，需要特殊处理
 				pos += segmentDataLength;
 				
-				// 读取扫描数据（直到下一个标记或 EOI）
+				// 熵编码数据持续到下一个非 RSTn 标记（渐进式 JPEG 之后还有 DHT/SOS 等段）
 				size_t scanStart = pos;
 				while (pos < data.size())
 				{
-					if (data[pos] == std::byte{0xFF})
+					if (data[pos] == std::byte{0xFF} && pos + 1 < data.size())
 					{
-						// 检查是否是标记
-						if (pos + 1 < data.size())
+						uint8_t nextByte = static_cast<uint8_t>(data[pos + 1]);
+						bool isRestart = nextByte >= MARKER_RST0 && nextByte <= MARKER_RST7;
+						if (nextByte != 0x00 && nextByte != 0xFF && !isRestart)
 						{
-							uint8_t nextByte = static_cast<uint8_t>(data[pos + 1]);
-							if (nextByte != 0x00 && nextByte != 0xFF)
-							{
-								// 找到下一个标记，扫描数据结束
-								break;
-							}
+							// 找到下一个标记，扫描数据结束
+							break;
 						}
 					}
 					pos++;
 				}
 				
-				// 保存扫描数据
-				if (pos > scanStart)
-				{
-					scanData.assign(
-						reinterpret_cast<const uint8_t*>(data.data() + scanStart),
-						reinterpret_cast<const uint8_t*>(data.data() + pos)
-					);
-				}
-				
-				// 如果找到 EOI，退出循环
-				if (pos + 1 < data.size() && data[pos] == std::byte{0xFF} && 
-				    static_cast<uint8_t>(data[pos + 1]) == MARKER_EOI)
-				{
-					return {};
-				}
-				break;
+				// 记录熵编码数据的位置（数据本身保存在 rawJpegData 中）
+				scans.back().dataOffset = scanStart;
+				scans.back().dataSize = pos - scanStart;
+				continue;
 			}
 
-			case MARKER_APP0:
-			case MARKER_APP15:
 			case MARKER_COM:
-				// 应用程序数据和注释段，暂时跳过
+				// 注释段，跳过
 				break;
 
 			default:
+				if (marker >= MARKER_APP0 && marker <= MARKER_APP15)
+				{
+					// 应用程序数据段（JFIF/Exif/ICC 等），跳过
+					break;
+				}
 				// 未知段，跳过
 				fmt::println("警告: 未知的 JPEG 段标记: 0x{:02X}", marker);
 				break;
 			}
 
-			if (!parseSuccess && marker != MARKER_APP0 && marker != MARKER_APP15 && marker != MARKER_COM)
+			if (!parseSuccess && (marker == MARKER_SOF0 || marker == MARKER_SOF1 || marker == MARKER_SOF2 ||
+				marker == MARKER_DQT || marker == MARKER_DHT || marker == MARKER_DRI))
 			{
 				return std::unexpected(fmt::format("解析 JPEG 段失败: 标记 0x{:02X}", marker));
 			}
@@ -419,6 +1036,11 @@ namespace shine::image
 			return std::unexpected("未找到颜色分量信息");
 		}
 
+		if (scans.empty())
+		{
+			return std::unexpected("未找到 SOS 段");
+		}
+
 		return {};
 	}
 
@@ -437,8 +1059,8 @@ namespace shine::image
 		// 每个分量 3 字节：ID, 采样因子, 量化表ID
 
 		precision = read_u8(data, 0);
-		read_be_ref(data, _height, 1);
-		read_be_ref(data, _width, 3);
+		_height = read_u16(data, 1);
+		_width = read_u16(data, 3);
 		componentCount = read_u8(data, 5);
 
 		if (precision != 8)
@@ -471,12 +1093,24 @@ namespace shine::image
 			component.sampling.v = sampling & 0x0F;
 			component.quantizationTableId = read_u8(data, offset + 2);
 
+			if (component.sampling.h == 0 || component.sampling.h > 4 ||
+				component.sampling.v == 0 || component.sampling.v > 4 ||
+				component.quantizationTableId >= 4)
+			{
+				return false;
+			}
+
 			components.push_back(component);
 			offset += 3;
 		}
 
-		fmt::println("JPEG 图像信息: {}x{}, 精度={}, 分量数={}",
-			_width, _height, precision, componentCount);
+		if (components.size() != componentCount)
+		{
+			return false;
+		}
+
+		fmt::println("JPEG 图像信息: {}x{}, 精度={}, 分量数={}{}",
+			_width, _height, precision, componentCount, progressive ? ", 渐进式" : "");
 
 		return true;
 	}
@@ -513,12 +1147,13 @@ namespace shine::image
 
 			JpegQuantizationTable& table = quantizationTables[tableId];
 
+			// 量化表在文件中按 zigzag 顺序存放，转换为自然顺序以便与系数逐项相乘
 			if (precision == 0)
 			{
 				// 8 位精度
 				for (size_t i = 0; i < 64; ++i)
 				{
-					table.coefficients[i] = read_u8(data, pos + i);
+					table.coefficients[DEZIGZAG[i]] = read_u8(data, pos + i);
 				}
 			}
 			else
@@ -526,7 +1161,7 @@ namespace shine::image
 				// 16 位精度（大端序）
 				for (size_t i = 0; i < 64; ++i)
 				{
-					table.coefficients[i] = read_u16(data, pos + i * 2);
+					table.coefficients[DEZIGZAG[i]] = read_u16(data, pos + i * 2);
 				}
 			}
 
@@ -595,7 +1230,10 @@ namespace shine::image
 			pos += totalSymbols;
 
 			// 构建 Huffman 查找表
-			buildHuffmanLookupTable(table);
+			if (!buildHuffmanLookupTable(table))
+			{
+				return false;
+			}
 			table.isValid = true;
 
 			fmt::println("读取 Huffman 表: {}表, ID={}, 符号数={}",
@@ -607,7 +1245,7 @@ namespace shine::image
 
 	bool jpeg::parseSOS(std::span<const std::byte> data, size_t length)
 	{
-		if (length < 2)
+		if (length < 1)
 		{
 			return false;
 		}
@@ -617,155 +1255,122 @@ namespace shine::image
 		// 每个分量 2 字节：分量ID, Huffman表选择
 		// 3 字节：频谱选择开始, 频谱选择结束, 逐次逼近
 
-		scanComponentCount = read_u8(data, 0);
+		JpegScan scan;
+		scan.componentCount = read_u8(data, 0);
 
-		if (scanComponentCount == 0 || scanComponentCount > 4)
+		if (scan.componentCount == 0 || scan.componentCount > 4 || components.empty() ||
+			length < 1 + 2 * static_cast<size_t>(scan.componentCount) + 3)
 		{
 			return false;
 		}
 
-		scanComponentIds.clear();
-		scanComponentIds.reserve(scanComponentCount);
-
 		size_t offset = 1;
-		for (uint8_t i = 0; i < scanComponentCount && offset + 2 <= length; ++i)
+		for (uint8_t i = 0; i < scan.componentCount; ++i)
 		{
 			uint8_t componentId = read_u8(data, offset);
 			uint8_t huffmanTableSelect = read_u8(data, offset + 1);
 
-			scanComponentIds.push_back(componentId);
+			auto it = std::find_if(components.begin(), components.end(),
+				[componentId](const JpegComponent& comp) { return comp.id == componentId; });
+			if (it == components.end())
+			{
+				return false;
+			}
 
 			// 更新分量的 Huffman 表 ID
-			for (auto& comp : components)
+			it->huffmanDCTableId = huffmanTableSelect >> 4;
+			it->huffmanACTableId = huffmanTableSelect & 0x0F;
+			if (it->huffmanDCTableId >= 4 || it->huffmanACTableId >= 4)
 			{
-				if (comp.id == componentId)
-				{
-					comp.huffmanDCTableId = huffmanTableSelect & 0x0F;
-					comp.huffmanACTableId = (huffmanTableSelect >> 4) & 0x0F;
-					break;
-				}
+				return false;
 			}
 
+			// 渐进式 JPEG 会在扫描之间重新定义 Huffman 表，因此保存当前表的快照
+			scan.componentIndices[i] = static_cast<uint8_t>(it - components.begin());
+			scan.dcTables[i] = dcHuffmanTables[it->huffmanDCTableId];
+			scan.acTables[i] = acHuffmanTables[it->huffmanACTableId];
+
 			offset += 2;
 		}
 
-		fmt::println("读取 SOS 段: 扫描分量数={}", scanComponentCount);
+		scan.spectralStart = read_u8(data, offset);
+		scan.spectralEnd = read_u8(data, offset + 1);
+		uint8_t approximation = read_u8(data, offset + 2);
+		scan.approxHigh = approximation >> 4;
+		scan.approxLow = approximation & 0x0F;
+		scan.restartInterval = restartInterval;
+
+		scans.push_back(std::move(scan));
+
+		fmt::println("读取 SOS 段: 扫描分量数={}, Ss={}, Se={}, Ah={}, Al={}",
+			scans.back().componentCount, scans.back().spectralStart, scans.back().spectralEnd,
+			scans.back().approxHigh, scans.back().approxLow);
 
 		return true;
 	}
 
-	// ============================================================================
-	// Huffman 解码
-	// ============================================================================
-
-	void jpeg::buildHuffmanLookupTable(JpegHuffmanTable& table)
+	bool jpeg::parseDRI(std::span<const std::byte> data, size_t length)
 	{
-		// 构建 Huffman 码值查找表
-		// 使用更高效的查找表结构
-
-		table.codes.clear();
-		table.codes.resize(256, 0xFFFF);  // 初始化查找表，0xFFFF 表示无效
-
-		uint16_t code = 0;
-		size_t symbolIndex = 0;
-
-		for (uint8_t length = 1; length <= 16; ++length)
+		if (length < 2)
 		{
-			uint8_t count = table.codeLengths[length - 1];
-			for (uint8_t i = 0; i < count; ++i)
-			{
-				if (symbolIndex < table.symbols.size())
-				{
-					// 对于短码（<=8位），直接建立查找表
-					if (length <= 8)
-					{
-						// 将 code 左移到 8 位位置，填充所有可能的低位组合
-						uint16_t baseCode = code << (8 - length);
-						uint16_t numEntries = 1u << (8 - length);
-						for (uint16_t j = 0; j < numEntries; ++j)
-						{
-							uint16_t lookupCode = baseCode | j;
-							if (lookupCode < 256)
-							{
-								table.codes[lookupCode] = (table.symbols[symbolIndex] << 8) | length;
-							}
-						}
-					}
-					symbolIndex++;
-				}
-				code++;
-			}
-			// 移动到下一个长度的起始码值
-			if (count > 0)
-			{
-				code <<= 1;
-			}
+			return false;
 		}
+
+		// DRI 段格式：2 字节重启间隔（MCU 数，0 表示禁用）
+		restartInterval = read_u16(data, 0);
+		return true;
 	}
 
-	int32_t jpeg::decodeHuffmanSymbol(util::BitReader& reader, const JpegHuffmanTable& table)
+	// ============================================================================
+	// Huffman 解码
+	// ============================================================================
+
+	bool jpeg::buildHuffmanLookupTable(JpegHuffmanTable& table)
 	{
-		if (!table.isValid)
-		{
-			return -1;
-		}
+		// 规范 Huffman 码：同一码长的码值连续，码长加 1 时左移一位。
+		// 短码（<= 9 位）直接填入快速查找表，长码通过 maxCode/valueOffset 逐长度比较
 
-		// 先尝试快速查找（8位）
-		uint16_t peekCode = reader.peekBits(8);
-		if (peekCode < table.codes.size() && table.codes[peekCode] != 0xFFFF)
-		{
-			uint16_t entry = table.codes[peekCode];
-			uint8_t length = entry & 0xFF;
-			uint8_t symbol = (entry >> 8) & 0xFF;
-			reader.advanceBits(length);
-			return symbol;
-		}
+		table.codes.assign(size_t{1} << HUFFMAN_FAST_BITS, 0xFFFF);
+		table.maxCode.fill(-1);
+		table.valueOffset.fill(0);
 
-		// 慢速查找（超过8位）- 使用正确的 Huffman 解码算法
-		uint16_t code = 0;
-		size_t symbolIndex = 0;
+		int32_t code = 0;
+		int32_t symbolIndex = 0;
 
-		for (uint8_t length = 1; length <= 16; ++length)
+		for (uint32_t length = 1; length <= 16; ++length)
 		{
-			code = (code << 1) | reader.readBits(1);
-
-			uint8_t count = table.codeLengths[length - 1];
-			if (count == 0)
+			const int32_t count = table.codeLengths[length - 1];
+			if (symbolIndex + count > static_cast<int32_t>(table.symbols.size()) || code + count > (1 << length))
 			{
-				continue;  // 该长度没有符号，继续
-			}
-
-			if (symbolIndex + count > table.symbols.size())
-			{
-				return -1;
+				return false;
 			}
 
-			// 计算该长度的起始码值
-			// 对于长度 L，起始码值 = (前 L-1 长度的所有符号数) << 1
-			uint16_t startCode = 0;
-			for (uint8_t i = 0; i < length - 1; ++i)
+			table.valueOffset[length] = symbolIndex - code;
+			if (count > 0)
 			{
-				if (i < table.codeLengths.size())
-				{
-					startCode = (startCode << 1) + table.codeLengths[i];
-				}
+				table.maxCode[length] = code + count - 1;
 			}
-			startCode <<= 1;
 
-			// 检查当前码值是否在该长度范围内
-			if (code >= startCode && code < startCode + count)
+			for (int32_t i = 0; i < count; ++i, ++code, ++symbolIndex)
 			{
-				size_t index = symbolIndex + (code - startCode);
-				if (index < table.symbols.size())
+				if (length <= HUFFMAN_FAST_BITS)
 				{
-					return table.symbols[index];
+					// 将 code 左移到 9 位位置，填充所有可能的低位组合
+					const uint32_t shift = HUFFMAN_FAST_BITS - length;
+					const uint32_t baseCode = static_cast<uint32_t>(code) << shift;
+					for (uint32_t j = 0; j < (1u << shift); ++j)
+					{
+						table.codes[baseCode | j] = static_cast<uint16_t>((table.symbols[symbolIndex] << 8) | length);
+					}
 				}
 			}
 
-			symbolIndex += count;
+			// 移动到下一个长度的起始码值
+			code <<= 1;
 		}
 
-		return -1;
+		table.maxCode[17] = INT32_MAX;
+		return true;
 	}
 
 	// ============================================================================
@@ -777,9 +1382,28 @@ namespace shine::image
 		return decodeInternal();
 	}
 
-	std::expected<void, std::string> jpeg::decodeInternal()
+	std::expected<void, std::string> jpeg::decodeScaled(JpegScale scale)
 	{
-		if (scanData.empty())
+		return decodeInternal(scale);
+	}
+
+	JpegScale jpeg::selectScale(uint32_t width, uint32_t height, uint32_t minSize) noexcept
+	{
+		const uint32_t longest = std::max(width, height);
+		for (JpegScale scale : { JpegScale::Eighth, JpegScale::Quarter, JpegScale::Half })
+		{
+			const uint32_t denom = static_cast<uint32_t>(scale);
+			if ((longest + denom - 1) / denom >= minSize)
+			{
+				return scale;
+			}
+		}
+		return JpegScale::Full;
+	}
+
+	std::expected<void, std::string> jpeg::decodeInternal(JpegScale scale)
+	{
+		if (scans.empty())
 		{
 			return std::unexpected("没有扫描数据可解码");
 		}
@@ -794,204 +1418,201 @@ namespace shine::image
 			return std::unexpected("没有颜色分量信息");
 		}
 
-		util::FunctionTimer timer("JPEG 解码", util::TimerPrecision::Nanoseconds);
-
-		// 1. Huffman 解码扫描数据
-		auto decodeResult = decodeScanData(scanData);
-		if (!decodeResult.has_value())
-		{
-			return std::unexpected("扫描数据解码失败: " + decodeResult.error());
-		}
-
-		std::vector<int16_t> mcuData = std::move(decodeResult.value());
-
-		// 2. 计算 MCU 信息
-		uint8_t maxHSampling = 0;
-		uint8_t maxVSampling = 0;
-		for (const auto& comp : components)
+		if (componentCount != 1 && componentCount != 3)
 		{
-			if (comp.sampling.h > maxHSampling) maxHSampling = comp.sampling.h;
-			if (comp.sampling.v > maxVSampling) maxVSampling = comp.sampling.v;
+			return std::unexpected(fmt::format("不支持的分量数量: {}", componentCount));
 		}
 
-		uint32_t mcuWidth = maxHSampling * 8;
-		uint32_t mcuHeight = maxVSampling * 8;
-		uint32_t mcuCols = (_width + mcuWidth - 1) / mcuWidth;
-		uint32_t mcuRows = (_height + mcuHeight - 1) / mcuHeight;
+		util::FunctionTimer timer("JPEG 解码", util::TimerPrecision::Nanoseconds);
 
-		// 3. 处理每个分量
-		// 计算每个 MCU 中每个分量的块数
-		std::vector<uint32_t> blocksPerMCUPerComponent(componentCount);
-		uint32_t totalBlocksPerMCU = 0;
-		for (uint32_t compIdx = 0; compIdx < componentCount; ++compIdx)
+		// 1. Huffman 解码到系数缓冲
+		//    只有一个顺序扫描且包含全部分量时，熵解码与重建逐 MCU 行交替进行，系数缓冲只保留一个 MCU 行；
+		//    渐进式、多个扫描或按重启间隔多线程解码时，先把所有扫描解码到整幅系数缓冲
+		const JpegScan& firstScan = scans.front();
+		const bool streaming = !progressive && scans.size() == 1 && firstScan.componentCount == componentCount &&
+			(componentCount != 1 || (components[0].sampling.h == 1 && components[0].sampling.v == 1)) &&
+			!shouldDecodeParallel(firstScan);
+		allocateCoefficients(streaming);
+
+		ScanDecodeContext streamContext{ &firstScan, ScanKind::Baseline, &components, &coefficients, mcuCols };
+		std::optional<ScanDecodeState> streamState;
+		if (streaming)
 		{
-			blocksPerMCUPerComponent[compIdx] = components[compIdx].sampling.h * components[compIdx].sampling.v;
-			totalBlocksPerMCU += blocksPerMCUPerComponent[compIdx];
+			if (firstScan.dataSize == 0 || firstScan.dataOffset + firstScan.dataSize > rawJpegData.size())
+			{
+				return std::unexpected("扫描 0 解码失败: 扫描数据为空");
+			}
+			auto kind = classifyScan(firstScan, progressive, components);
+			if (!kind.has_value())
+			{
+				return std::unexpected(fmt::format("扫描 0 解码失败: {}", kind.error()));
+			}
+			streamState.emplace(JpegBitReader(rawJpegData.data() + firstScan.dataOffset, firstScan.dataSize));
 		}
-
-		std::vector<std::vector<int16_t>> componentPixels(componentCount);
-
-		// 处理每个分量
-		for (uint32_t compIdx = 0; compIdx < componentCount; ++compIdx)
+		else
 		{
-			const auto& comp = components[compIdx];
-			uint32_t blocksPerMCU = blocksPerMCUPerComponent[compIdx];
-			uint32_t componentWidth = (_width * comp.sampling.h + maxHSampling - 1) / maxHSampling;
-			uint32_t componentHeight = (_height * comp.sampling.v + maxVSampling - 1) / maxVSampling;
-			uint32_t totalBlocks = blocksPerMCU * mcuCols * mcuRows;
-
-			// 提取该分量的所有块数据（从 mcuData 中按 MCU 顺序提取）
-			std::vector<int16_t> componentMCUData;
-			componentMCUData.reserve(totalBlocks * 64);
-			
-			// mcuData 结构：MCU0[分量0块0...块N, 分量1块0...块M, ...], MCU1[...], ...
-			// 需要提取：分量compIdx的所有块（跨所有MCU）
-			for (uint32_t mcu = 0; mcu < mcuCols * mcuRows; ++mcu)
-			{
-				// 计算当前 MCU 中该分量之前的块数
-				uint32_t blocksBefore = 0;
-				for (uint32_t c = 0; c < compIdx; ++c)
+			std::array<bool, 4> dcDecoded{};
+			bool previewEmitted = false;
+			for (uint32_t scanIdx = 0; scanIdx < scans.size(); ++scanIdx)
+			{
+				const JpegScan& scan = scans[scanIdx];
+				auto decodeResult = decodeScanData(scan);
+				if (!decodeResult.has_value())
 				{
-					blocksBefore += blocksPerMCUPerComponent[c];
+					return std::unexpected(fmt::format("扫描 {} 解码失败: {}", scanIdx, decodeResult.error()));
 				}
-				
-				// 提取该 MCU 中该分量的所有块
-				size_t mcuStartPos = mcu * totalBlocksPerMCU * 64 + blocksBefore * 64;
-				for (uint32_t block = 0; block < blocksPerMCU; ++block)
+
+				if (scan.spectralStart == 0 && scan.approxHigh == 0)
 				{
-					for (uint32_t i = 0; i < 64; ++i)
+					for (uint32_t i = 0; i < scan.componentCount; ++i)
 					{
-						size_t pos = mcuStartPos + block * 64 + i;
-						if (pos < mcuData.size())
-						{
-							componentMCUData.push_back(mcuData[pos]);
-						}
+						dcDecoded[scan.componentIndices[i]] = true;
 					}
 				}
-			}
 
-			auto dequantized = dequantize(componentMCUData, comp.id);
-			if (dequantized.empty())
-			{
-				return std::unexpected(fmt::format("分量 {} 反量化失败", comp.id));
+				// 所有分量都有了 DC 且还有后续扫描时，先输出一张低分辨率预览
+				if (previewCallback && !previewEmitted && scanIdx + 1 < scans.size() &&
+					std::all_of(dcDecoded.begin(), dcDecoded.begin() + componentCount, [](bool ready) { return ready; }))
+				{
+					emitPreview(scanIdx);
+					previewEmitted = true;
+				}
 			}
+		}
 
-			// IDCT 和重组
-			componentPixels[compIdx].resize(componentWidth * componentHeight);
-			uint32_t blockIdx = 0;
-
-			for (uint32_t mcuRow = 0; mcuRow < mcuRows; ++mcuRow)
+		// 2. 按 MCU 行重建：反量化 + IDCT 写入 8 位条带，随即颜色转换写入 RGBA
+		//    （条带只有一个 MCU 行高，不再生成整幅分量平面和全分辨率色度平面）
+		for (uint32_t compIdx = 0; compIdx < componentCount; ++compIdx)
+		{
+			if (!quantizationTables[components[compIdx].quantizationTableId].isValid)
 			{
-				for (uint32_t mcuCol = 0; mcuCol < mcuCols; ++mcuCol)
-				{
-					for (uint32_t vBlock = 0; vBlock < comp.sampling.v; ++vBlock)
-					{
-						for (uint32_t hBlock = 0; hBlock < comp.sampling.h; ++hBlock)
-						{
-							// 提取 8x8 块
-							std::array<int16_t, 64> block{};
-							for (uint32_t i = 0; i < 64; ++i)
-							{
-								block[i] = dequantized[blockIdx * 64 + i];
-							}
-
-							// IDCT
-							auto idctResult = idct(block);
-
-							// 写入到分量图像
-							uint32_t baseX = mcuCol * mcuWidth + hBlock * 8;
-							uint32_t baseY = mcuRow * mcuHeight + vBlock * 8;
-
-							for (uint32_t y = 0; y < 8; ++y)
-							{
-								uint32_t pixelY = baseY + y;
-								if (pixelY >= componentHeight) break;
+				return std::unexpected(fmt::format("分量 {} 反量化失败", components[compIdx].id));
+			}
+		}
 
-								for (uint32_t x = 0; x < 8; ++x)
-								{
-									uint32_t pixelX = baseX + x;
-									if (pixelX >= componentWidth) break;
+		// 缩放解码时亮度块输出 blockSize×blockSize 像素；下采样的色度分量在不超过输出分辨率的前提下
+		// 使用更大的 IDCT（例如 4:2:0 的 1/2 解码，色度做完整 8x8 IDCT），减少甚至免去上采样
+		const uint32_t blockSize = 8 / static_cast<uint32_t>(scale);
+		_outputWidth = (_width * blockSize + 7) / 8;
+		_outputHeight = (_height * blockSize + 7) / 8;
 
-									uint32_t pixelIdx = pixelY * componentWidth + pixelX;
-									componentPixels[compIdx][pixelIdx] = idctResult[y * 8 + x];
-								}
-							}
+		const uint32_t mcuWidth = maxHSampling * blockSize;
+		const uint32_t mcuHeight = maxVSampling * blockSize;
 
-							blockIdx++;
-						}
-					}
-				}
+		std::array<uint32_t, 3> componentBlockSize{};
+		std::array<uint32_t, 3> componentMcuWidth{};   ///< 每个 MCU 中该分量的样本列数
+		std::array<uint32_t, 3> componentMcuHeight{};  ///< 每个 MCU 中该分量的样本行数
+		std::array<std::vector<uint8_t>, 3> strips;
+		std::array<size_t, 3> stripStride{};
+		for (uint32_t compIdx = 0; compIdx < componentCount; ++compIdx)
+		{
+			const JpegComponent& comp = components[compIdx];
+			uint32_t size = blockSize;
+			while (size < 8 && comp.sampling.h * size * 2 <= mcuWidth && comp.sampling.v * size * 2 <= mcuHeight)
+			{
+				size *= 2;
 			}
+			componentBlockSize[compIdx] = size;
+			componentMcuWidth[compIdx] = comp.sampling.h * size;
+			componentMcuHeight[compIdx] = comp.sampling.v * size;
+			stripStride[compIdx] = static_cast<size_t>(comp.blocksPerLine) * size;
+			strips[compIdx].resize(stripStride[compIdx] * componentMcuHeight[compIdx]);
 		}
 
-		// 4. 颜色空间转换
-		imageData.clear();
-		imageData.reserve(_width * _height * 4);
-
-		if (componentCount == 1)
+		// 色度水平 1:1 或 2:1 且 Y 未下采样时，行内核直接读取条带；其他比例先把每行扩展到全宽
+		std::array<uint32_t, 3> chromaShift{};
+		bool directRows = true;
+		for (uint32_t compIdx = 0; compIdx < componentCount; ++compIdx)
 		{
-			// 灰度图像
-			convertGrayscaleToRGBA(componentPixels[0], imageData);
+			if (componentMcuWidth[compIdx] == mcuWidth)
+			{
+				chromaShift[compIdx] = 0;
+			}
+			else if (compIdx != 0 && componentMcuWidth[compIdx] * 2 == mcuWidth)
+			{
+				chromaShift[compIdx] = 1;
+			}
+			else
+			{
+				directRows = false;
+			}
 		}
-		else if (componentCount == 3)
+		if (componentCount == 3 && chromaShift[1] != chromaShift[2])
 		{
-			// YCbCr 图像
-			// 需要上采样色度分量（如果采样因子不同）
-			std::vector<int16_t> yData = componentPixels[0];
-			std::vector<int16_t> cbData = componentPixels[1];
-			std::vector<int16_t> crData = componentPixels[2];
-
-			// 简单的上采样（最近邻）
-			if (components[1].sampling.h < maxHSampling || components[1].sampling.v < maxVSampling)
-			{
-				uint32_t cbWidth = (_width * components[1].sampling.h + maxHSampling - 1) / maxHSampling;
-				uint32_t cbHeight = (_height * components[1].sampling.v + maxVSampling - 1) / maxVSampling;
-				
-				std::vector<int16_t> upsampledCb(_width * _height);
-				std::vector<int16_t> upsampledCr(_width * _height);
-
-				for (uint32_t y = 0; y < _height; ++y)
-				{
-					uint32_t srcY = (y * cbHeight) / _height;
-					if (srcY >= cbHeight) srcY = cbHeight - 1;
+			directRows = false;
+		}
 
-					for (uint32_t x = 0; x < _width; ++x)
-					{
-						uint32_t srcX = (x * cbWidth) / _width;
-						if (srcX >= cbWidth) srcX = cbWidth - 1;
+		std::vector<uint8_t> expandedRows(directRows ? 0 : static_cast<size_t>(_outputWidth) * componentCount);
 
-						uint32_t srcIdx = srcY * cbWidth + srcX;
-						uint32_t dstIdx = y * _width + x;
+		imageData.resize(static_cast<size_t>(_outputWidth) * _outputHeight * 4);
 
-						upsampledCb[dstIdx] = cbData[srcIdx];
-						upsampledCr[dstIdx] = crData[srcIdx];
-					}
+		for (uint32_t mcuRow = 0; mcuRow < mcuRows; ++mcuRow)
+		{
+			if (streaming)
+			{
+				for (auto& componentCoefficients : coefficients)
+				{
+					std::fill(componentCoefficients.begin(), componentCoefficients.end(), int16_t{ 0 });
+				}
+				streamContext.unitRowBase = mcuRow;
+				auto decodeResult = decodeScanUnits(streamContext, *streamState, mcuRow * mcuCols, (mcuRow + 1) * mcuCols);
+				if (!decodeResult.has_value())
+				{
+					imageData.clear();
+					return std::unexpected(fmt::format("扫描 0 解码失败: {}", decodeResult.error()));
 				}
-
-				cbData = std::move(upsampledCb);
-				crData = std::move(upsampledCr);
 			}
 
-			convertYCbCrToRGBA(yData, cbData, crData, imageData);
-		}
-		else
-		{
-			return std::unexpected(fmt::format("不支持的分量数量: {}", componentCount));
-		}
-
-		// 裁剪到实际图像尺寸（如果 MCU 边界超出）
-		// 注意：由于 MCU 对齐，imageData 可能包含超出边界的像素
-		if (imageData.size() >= _width * _height * 4)
-		{
-			// 如果大小正好，不需要裁剪
-			if (imageData.size() == _width * _height * 4)
+			// 流式解码时系数缓冲只有当前 MCU 行
+			const size_t coefficientRow = streaming ? 0 : mcuRow;
+			for (uint32_t compIdx = 0; compIdx < componentCount; ++compIdx)
 			{
-				// 大小正确，无需裁剪
+				const JpegComponent& comp = components[compIdx];
+				const uint16_t* quant = quantizationTables[comp.quantizationTableId].coefficients.data();
+				const uint32_t size = componentBlockSize[compIdx];
+				for (uint32_t blockRow = 0; blockRow < comp.sampling.v; ++blockRow)
+				{
+					const size_t blockIndex = (coefficientRow * comp.sampling.v + blockRow) * comp.blocksPerLine;
+					jpeg_dsp::idctBlocksReduced(coefficients[compIdx].data() + blockIndex * 64, quant,
+						strips[compIdx].data() + blockRow * size * stripStride[compIdx], stripStride[compIdx],
+						comp.blocksPerLine, size);
+				}
 			}
-			else
+
+			const uint32_t yBegin = mcuRow * mcuHeight;
+			const uint32_t yEnd = std::min(yBegin + mcuHeight, _outputHeight);
+			for (uint32_t y = yBegin; y < yEnd; ++y)
 			{
-				// 需要裁剪：只保留前 _width * _height * 4 个字节
-				imageData.resize(_width * _height * 4);
+				// 最近邻上采样：分量行 = 输出行 * 分量每 MCU 行数 / 输出每 MCU 行数
+				std::array<const uint8_t*, 3> rows{};
+				for (uint32_t compIdx = 0; compIdx < componentCount; ++compIdx)
+				{
+					const uint32_t stripY = (y - yBegin) * componentMcuHeight[compIdx] / mcuHeight;
+					rows[compIdx] = strips[compIdx].data() + stripY * stripStride[compIdx];
+				}
+
+				if (!directRows)
+				{
+					for (uint32_t compIdx = 0; compIdx < componentCount; ++compIdx)
+					{
+						uint8_t* expanded = expandedRows.data() + static_cast<size_t>(compIdx) * _outputWidth;
+						for (uint32_t x = 0; x < _outputWidth; ++x)
+						{
+							expanded[x] = rows[compIdx][x * componentMcuWidth[compIdx] / mcuWidth];
+						}
+						rows[compIdx] = expanded;
+					}
+				}
+
+				uint8_t* out = imageData.data() + static_cast<size_t>(y) * _outputWidth * 4;
+				if (componentCount == 1)
+				{
+					jpeg_dsp::grayToRgbaRow(rows[0], out, _outputWidth);
+				}
+				else
+				{
+					jpeg_dsp::yccToRgbaRow(rows[0], rows[1], rows[2], out, _outputWidth, directRows ? chromaShift[1] : 0);
+				}
 			}
 		}
 
@@ -1024,375 +1645,140 @@ namespace shine::image
 	// 辅助函数实现
 	// ============================================================================
 
-	std::expected<std::vector<int16_t>, std::string> jpeg::decodeScanData(
-		std::span<const uint8_t> scanDataSpan)
+	void jpeg::allocateCoefficients(bool singleMcuRow)
 	{
-		if (scanDataSpan.empty())
-		{
-			return std::unexpected("扫描数据为空");
-		}
-
-		util::BitReader reader(scanDataSpan.data(), scanDataSpan.size());
-
-		// 计算 MCU（最小编码单元）数量
-		// MCU 大小取决于采样因子
-		uint8_t maxHSampling = 0;
-		uint8_t maxVSampling = 0;
+		maxHSampling = 1;
+		maxVSampling = 1;
 		for (const auto& comp : components)
 		{
-			if (comp.sampling.h > maxHSampling) maxHSampling = comp.sampling.h;
-			if (comp.sampling.v > maxVSampling) maxVSampling = comp.sampling.v;
+			maxHSampling = std::max(maxHSampling, comp.sampling.h);
+			maxVSampling = std::max(maxVSampling, comp.sampling.v);
 		}
 
+		// MCU 大小取决于最大采样因子
 		uint32_t mcuWidth = maxHSampling * 8;
 		uint32_t mcuHeight = maxVSampling * 8;
-		uint32_t mcuCols = (_width + mcuWidth - 1) / mcuWidth;
-		uint32_t mcuRows = (_height + mcuHeight - 1) / mcuHeight;
-		uint32_t totalMCUs = mcuCols * mcuRows;
-
-		// 每个 MCU 包含多个 8x8 块（根据采样因子）
-		uint32_t blocksPerMCU = 0;
-		for (const auto& comp : components)
-		{
-			blocksPerMCU += comp.sampling.h * comp.sampling.v;
-		}
-
-		std::vector<int16_t> mcuData;
-		mcuData.reserve(totalMCUs * blocksPerMCU * 64);
-
-		// DC 预测器（每个分量一个）
-		std::vector<int16_t> dcPredictors(componentCount, 0);
+		mcuCols = (_width + mcuWidth - 1) / mcuWidth;
+		mcuRows = (_height + mcuHeight - 1) / mcuHeight;
 
-		// 解码每个 MCU
-		for (uint32_t mcu = 0; mcu < totalMCUs; ++mcu)
+		// 系数缓冲按 MCU 对齐分配，交错扫描中 MCU 边缘的填充块也有落脚处
+		coefficients.resize(components.size());
+		for (size_t i = 0; i < components.size(); ++i)
 		{
-			uint32_t componentIndex = 0;
-			for (const auto& comp : components)
-			{
-				// 获取该分量的 Huffman 表
-				if (comp.huffmanDCTableId >= 4 || comp.huffmanACTableId >= 4)
-				{
-					return std::unexpected(fmt::format("分量 {} 的 Huffman 表 ID 无效", comp.id));
-				}
-
-				const auto& dcTable = dcHuffmanTables[comp.huffmanDCTableId];
-				const auto& acTable = acHuffmanTables[comp.huffmanACTableId];
-
-				if (!dcTable.isValid || !acTable.isValid)
-				{
-					return std::unexpected(fmt::format("分量 {} 的 Huffman 表无效", comp.id));
-				}
-
-				// 解码该分量的所有块（根据采样因子）
-				uint32_t blocksInComponent = comp.sampling.h * comp.sampling.v;
-				for (uint32_t block = 0; block < blocksInComponent; ++block)
-				{
-					std::array<int16_t, 64> blockData{};
-					
-					// 解码 DC 系数
-					int32_t dcSymbol = decodeHuffmanSymbol(reader, dcTable);
-					if (dcSymbol < 0)
-					{
-						return std::unexpected("DC 系数解码失败");
-					}
-
-					int16_t dcValue = 0;
-					if (dcSymbol != 0)
-					{
-						// 读取额外的位数
-						uint32_t extraBits = reader.readBits(dcSymbol);
-						// 扩展符号（如果最高位为0，则为负数）
-						if (extraBits < (1u << (dcSymbol - 1)))
-						{
-							dcValue = static_cast<int16_t>(extraBits - (1u << dcSymbol) + 1);
-						}
-						else
-						{
-							dcValue = static_cast<int16_t>(extraBits);
-						}
-					}
-
-					// DC 预测
-					dcValue += dcPredictors[componentIndex];
-					dcPredictors[componentIndex] = dcValue;
-					blockData[0] = dcValue;
-
-					// 解码 AC 系数（Zigzag 顺序）
-					constexpr uint8_t zigzag[64] = {
-						0,  1,  5,  6, 14, 15, 27, 28,
-						2,  4,  7, 13, 16, 26, 29, 42,
-						3,  8, 12, 17, 25, 30, 41, 43,
-						9, 11, 18, 24, 31, 40, 44, 53,
-						10, 19, 23, 32, 39, 45, 52, 54,
-						20, 22, 33, 38, 46, 51, 55, 60,
-						21, 34, 37, 47, 50, 56, 59, 61,
-						35, 36, 48, 49, 57, 58, 62, 63
-					};
-
-					uint8_t acIndex = 1;
-					while (acIndex < 64)
-					{
-						int32_t acSymbol = decodeHuffmanSymbol(reader, acTable);
-						if (acSymbol < 0)
-						{
-							return std::unexpected("AC 系数解码失败");
-						}
-
-						if (acSymbol == 0)
-						{
-							// EOB（End of Block）
-							break;
-						}
-
-						uint8_t zeroRun = (acSymbol >> 4) & 0x0F;
-						uint8_t acSize = acSymbol & 0x0F;
-
-						acIndex += zeroRun;
-						if (acIndex >= 64)
-						{
-							return std::unexpected("AC 系数索引超出范围");
-						}
-
-						if (acSize != 0)
-						{
-							int16_t acValue = 0;
-							uint32_t extraBits = reader.readBits(acSize);
-							// 扩展符号（如果最高位为0，则为负数）
-							if (extraBits < (1u << (acSize - 1)))
-							{
-								acValue = static_cast<int16_t>(extraBits - (1u << acSize) + 1);
-							}
-							else
-							{
-								acValue = static_cast<int16_t>(extraBits);
-							}
-
-							blockData[zigzag[acIndex]] = acValue;
-						}
-
-						acIndex++;
-					}
-
-					// 将块数据添加到 MCU 数据
-					for (int16_t val : blockData)
-					{
-						mcuData.push_back(val);
-					}
-				}
-
-				componentIndex++;
-			}
+			JpegComponent& comp = components[i];
+			comp.blocksPerLine = mcuCols * comp.sampling.h;
+			comp.blocksPerColumn = mcuRows * comp.sampling.v;
+			const uint32_t blockRows = singleMcuRow ? comp.sampling.v : comp.blocksPerColumn;
+			coefficients[i].assign(static_cast<size_t>(comp.blocksPerLine) * blockRows * 64, 0);
 		}
+	}
 
-		return mcuData;
+	bool jpeg::shouldDecodeParallel(const JpegScan& scan) const noexcept
+	{
+#if !defined(SHINE_PLATFORM_WASM) && !defined(__EMSCRIPTEN__)
+		return _parallelDecode && scan.restartInterval != 0 &&
+			static_cast<size_t>(_width) * _height >= _parallelMinPixels &&
+			util::ThreadPool::Get().GetThreadCount() > 1;
+#else
+		(void)scan;
+		return false;
+#endif
 	}
 
-	std::vector<int16_t> jpeg::dequantize(const std::vector<int16_t>& mcuData, uint8_t componentId)
+	std::expected<void, std::string> jpeg::decodeScanData(const JpegScan& scan)
 	{
-		// 查找对应的量化表
-		const JpegComponent* comp = nullptr;
-		for (const auto& c : components)
+		if (scan.dataSize == 0 || scan.dataOffset + scan.dataSize > rawJpegData.size())
 		{
-			if (c.id == componentId)
-			{
-				comp = &c;
-				break;
-			}
+			return std::unexpected("扫描数据为空");
 		}
 
-		if (!comp || comp->quantizationTableId >= 4)
+		auto kind = classifyScan(scan, progressive, components);
+		if (!kind.has_value())
 		{
-			return {};
+			return std::unexpected(kind.error());
 		}
 
-		const auto& qTable = quantizationTables[comp->quantizationTableId];
-		if (!qTable.isValid)
+		// 单分量扫描不交错：MCU 就是一个块，块数按分量的实际尺寸计算（不含 MCU 填充）。
+		// 多分量扫描交错：每个 MCU 依次包含各分量的 H×V 个块
+		uint32_t unitsX = mcuCols;
+		uint32_t unitsY = mcuRows;
+		if (scan.componentCount == 1)
 		{
-			return {};
+			const JpegComponent& comp = components[scan.componentIndices[0]];
+			uint32_t componentWidth = (_width * comp.sampling.h + maxHSampling - 1) / maxHSampling;
+			uint32_t componentHeight = (_height * comp.sampling.v + maxVSampling - 1) / maxVSampling;
+			unitsX = (componentWidth + 7) / 8;
+			unitsY = (componentHeight + 7) / 8;
 		}
 
-		// 反量化：每个 8x8 块
-		// 注意：mcuData 中的数据已经是正常顺序（在 decodeScanData 中通过 zigzag[acIndex] 索引存储）
-		std::vector<int16_t> dequantized;
-		dequantized.reserve(mcuData.size());
+		const ScanDecodeContext ctx{ &scan, *kind, &components, &coefficients, unitsX };
+		const uint8_t* data = rawJpegData.data() + scan.dataOffset;
+		const uint32_t unitCount = unitsX * unitsY;
 
-		size_t blockCount = mcuData.size() / 64;
-		for (size_t block = 0; block < blockCount; ++block)
+#if !defined(SHINE_PLATFORM_WASM) && !defined(__EMSCRIPTEN__)
+		// 重启间隔之间没有任何依赖（预测器和 EOB 游程在 RSTn 处清零），可以按 RSTn 切分后并行解码
+		if (shouldDecodeParallel(scan))
 		{
-			// 直接反量化，数据已经是正常顺序
-			for (uint8_t i = 0; i < 64; ++i)
+			const uint32_t intervalCount = (unitCount + scan.restartInterval - 1) / scan.restartInterval;
+			std::vector<std::pair<size_t, size_t>> segments;
+			if (intervalCount > 1 && findRestartSegments(data, scan.dataSize, intervalCount, segments))
 			{
-				int16_t quantizedValue = mcuData[block * 64 + i];
-				dequantized.push_back(quantizedValue * static_cast<int16_t>(qTable.coefficients[i]));
+				return decodeScanParallel(ctx, data, segments, unitCount);
 			}
 		}
+#endif
 
-		return dequantized;
+		ScanDecodeState state{ JpegBitReader(data, scan.dataSize) };
+		return decodeScanUnits(ctx, state, 0, unitCount);
 	}
 
-	std::array<int16_t, 64> jpeg::idct(const std::array<int16_t, 64>& coefficients)
+	void jpeg::emitPreview(uint32_t scanIndex)
 	{
-		// IDCT 1D 变换宏（参考 stb_image 实现）
-		#define IDCT_1D(s0, s1, s2, s3, s4, s5, s6, s7) \
-			do { \
-				int32_t x0 = s0, x1 = s1, x2 = s2, x3 = s3, x4 = s4, x5 = s5, x6 = s6, x7 = s7; \
-				int32_t x8 = x7 - x1; \
-				int32_t x9 = x1 + x7; \
-				int32_t xa = x5 - x3; \
-				int32_t xb = x3 + x5; \
-				int32_t xc = x0 - x4; \
-				int32_t xd = x0 + x4; \
-				int32_t xe = (x8 + xa) * 181; \
-				x8 = (x8 - xa) * 181; \
-				xa = x9 - xb; \
-				xb = x9 + xb; \
-				x9 = (xa + xc) * 181; \
-				xa = (xa - xc) * 181; \
-				xc = xd + xb; \
-				xd = xd - xb; \
-				xb = x6 + x2; \
-				x2 = x6 - x2; \
-				x6 = x2 + x8; \
-				x2 = x2 - x8; \
-				x8 = xb + x4; \
-				x4 = xb - x4; \
-				xb = x8 + xc; \
-				x8 = x8 - xc; \
-				xc = x4 + x6; \
-				x4 = x4 - x6; \
-				x6 = x2 + xa; \
-				x2 = x2 - xa; \
-				xa = x6 + x9; \
-				x6 = x6 - x9; \
-				x9 = xa + xc; \
-				xa = xa - xc; \
-				s0 = (x9 + xb) >> 10; \
-				s7 = (x9 - xb) >> 10; \
-				s1 = (xa + x8) >> 10; \
-				s6 = (xa - x8) >> 10; \
-				s2 = (x6 + x4) >> 10; \
-				s5 = (x6 - x4) >> 10; \
-				s3 = (x2 + xc) >> 10; \
-				s4 = (x2 - xc) >> 10; \
-			} while (0)
-
-		std::array<int16_t, 64> result{};
-		std::array<int32_t, 64> temp{};
-
-		// 列变换
-		for (int col = 0; col < 8; ++col)
-		{
-			int32_t c0 = coefficients[col * 8 + 0];
-			int32_t c1 = coefficients[col * 8 + 1];
-			int32_t c2 = coefficients[col * 8 + 2];
-			int32_t c3 = coefficients[col * 8 + 3];
-			int32_t c4 = coefficients[col * 8 + 4];
-			int32_t c5 = coefficients[col * 8 + 5];
-			int32_t c6 = coefficients[col * 8 + 6];
-			int32_t c7 = coefficients[col * 8 + 7];
-			
-			// 如果列全为零，快速路径
-			if (c1 == 0 && c2 == 0 && c3 == 0 && c4 == 0 &&
-			    c5 == 0 && c6 == 0 && c7 == 0)
-			{
-				int32_t dcterm = c0 * 4;
-				temp[col * 8 + 0] = dcterm;
-				temp[col * 8 + 1] = dcterm;
-				temp[col * 8 + 2] = dcterm;
-				temp[col * 8 + 3] = dcterm;
-				temp[col * 8 + 4] = dcterm;
-				temp[col * 8 + 5] = dcterm;
-				temp[col * 8 + 6] = dcterm;
-				temp[col * 8 + 7] = dcterm;
-			}
-			else
-			{
-				IDCT_1D(c0, c1, c2, c3, c4, c5, c6, c7);
-				temp[col * 8 + 0] = c0;
-				temp[col * 8 + 1] = c1;
-				temp[col * 8 + 2] = c2;
-				temp[col * 8 + 3] = c3;
-				temp[col * 8 + 4] = c4;
-				temp[col * 8 + 5] = c5;
-				temp[col * 8 + 6] = c6;
-				temp[col * 8 + 7] = c7;
-			}
-		}
+		// 每个 8x8 亮度块对应一个预览像素；DC 系数经 IDCT 后是块的平均值（DC * Q / 8 + 128）
+		const uint32_t previewWidth = (_width + 7) / 8;
+		const uint32_t previewHeight = (_height + 7) / 8;
 
-		// 行变换并输出
-		for (int row = 0; row < 8; ++row)
-		{
-			int32_t t0 = temp[row * 8 + 0];
-			int32_t t1 = temp[row * 8 + 1];
-			int32_t t2 = temp[row * 8 + 2];
-			int32_t t3 = temp[row * 8 + 3];
-			int32_t t4 = temp[row * 8 + 4];
-			int32_t t5 = temp[row * 8 + 5];
-			int32_t t6 = temp[row * 8 + 6];
-			int32_t t7 = temp[row * 8 + 7];
-			
-			IDCT_1D(t0, t1, t2, t3, t4, t5, t6, t7);
-			
-			// 添加偏移并限制范围到 0-255
-			result[row * 8 + 0] = static_cast<int16_t>(std::clamp(t0 + 128, 0, 255));
-			result[row * 8 + 1] = static_cast<int16_t>(std::clamp(t1 + 128, 0, 255));
-			result[row * 8 + 2] = static_cast<int16_t>(std::clamp(t2 + 128, 0, 255));
-			result[row * 8 + 3] = static_cast<int16_t>(std::clamp(t3 + 128, 0, 255));
-			result[row * 8 + 4] = static_cast<int16_t>(std::clamp(t4 + 128, 0, 255));
-			result[row * 8 + 5] = static_cast<int16_t>(std::clamp(t5 + 128, 0, 255));
-			result[row * 8 + 6] = static_cast<int16_t>(std::clamp(t6 + 128, 0, 255));
-			result[row * 8 + 7] = static_cast<int16_t>(std::clamp(t7 + 128, 0, 255));
-		}
-
-		#undef IDCT_1D
-		return result;
-	}
+		std::array<std::vector<uint8_t>, 3> planes;
+		for (uint32_t compIdx = 0; compIdx < componentCount; ++compIdx)
+		{
+			const JpegComponent& comp = components[compIdx];
+			const int32_t quant = quantizationTables[comp.quantizationTableId].coefficients[0];
+			planes[compIdx].resize(static_cast<size_t>(previewWidth) * previewHeight);
 
-	void jpeg::convertYCbCrToRGBA(
-		const std::vector<int16_t>& yData,
-		const std::vector<int16_t>& cbData,
-		const std::vector<int16_t>& crData,
-		std::vector<uint8_t>& output)
-	{
-		size_t pixelCount = yData.size();
-		output.clear();
-		output.reserve(pixelCount * 4);
-
-		for (size_t i = 0; i < pixelCount; ++i)
-		{
-			int16_t y = yData[i];
-			int16_t cb = cbData[i];
-			int16_t cr = crData[i];
-
-			// YCbCr 到 RGB 转换公式
-			int32_t r = y + ((cr - 128) * 1436) / 1024;
-			int32_t g = y - ((cb - 128) * 352) / 1024 - ((cr - 128) * 731) / 1024;
-			int32_t b = y + ((cb - 128) * 1814) / 1024;
-
-			// 限制范围到 0-255
-			output.push_back(static_cast<uint8_t>(std::clamp(r, 0, 255)));
-			output.push_back(static_cast<uint8_t>(std::clamp(g, 0, 255)));
-			output.push_back(static_cast<uint8_t>(std::clamp(b, 0, 255)));
-			output.push_back(255);  // Alpha
+			for (uint32_t y = 0; y < previewHeight; ++y)
+			{
+				uint32_t blockY = std::min(y * comp.sampling.v / maxVSampling, comp.blocksPerColumn - 1);
+				for (uint32_t x = 0; x < previewWidth; ++x)
+				{
+					uint32_t blockX = std::min(x * comp.sampling.h / maxHSampling, comp.blocksPerLine - 1);
+					int32_t dc = coefficients[compIdx][(static_cast<size_t>(blockY) * comp.blocksPerLine + blockX) * 64];
+					planes[compIdx][y * previewWidth + x] = static_cast<uint8_t>(std::clamp(((dc * quant + 4) >> 3) + 128, 0, 255));
+				}
+			}
 		}
-	}
 
-	void jpeg::convertGrayscaleToRGBA(
-		const std::vector<int16_t>& grayData,
-		std::vector<uint8_t>& output)
-	{
-		size_t pixelCount = grayData.size();
-		output.clear();
-		output.reserve(pixelCount * 4);
-
-		for (size_t i = 0; i < pixelCount; ++i)
+		std::vector<uint8_t> rgba(static_cast<size_t>(previewWidth) * previewHeight * 4);
+		for (uint32_t y = 0; y < previewHeight; ++y)
 		{
-			uint8_t gray = static_cast<uint8_t>(std::clamp(grayData[i], int16_t(0), int16_t(255)));
-			output.push_back(gray);
-			output.push_back(gray);
-			output.push_back(gray);
-			output.push_back(255);  // Alpha
+			const size_t offset = static_cast<size_t>(y) * previewWidth;
+			if (componentCount == 1)
+			{
+				jpeg_dsp::grayToRgbaRow(planes[0].data() + offset, rgba.data() + offset * 4, previewWidth);
+			}
+			else
+			{
+				jpeg_dsp::yccToRgbaRow(planes[0].data() + offset, planes[1].data() + offset, planes[2].data() + offset,
+					rgba.data() + offset * 4, previewWidth, 0);
+			}
 		}
+
+		JpegPreview preview;
+		preview.width = previewWidth;
+		preview.height = previewHeight;
+		preview.rgba = rgba;
+		preview.scanIndex = scanIndex;
+		preview.scanCount = static_cast<uint32_t>(scans.size());
+		previewCallback(preview);
 	}
 
 } // namespace shine::image
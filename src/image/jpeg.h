@@ -6,15 +6,11 @@
 #include <expected>
 #include <span>
 #include <array>
+#include <functional>
 
 #include "loader/core/loader.h"
 #include "loader/image/image_loader.h"
 
-namespace shine::util
-{
-	class BitReader;
-}
-
 namespace shine::image
 {
 
@@ -54,6 +50,8 @@ namespace shine::image
 		uint8_t quantizationTableId = 0;   ///< 量化表 ID
 		uint8_t huffmanDCTableId = 0;      ///< DC Huffman 表 ID
 		uint8_t huffmanACTableId = 0;      ///< AC Huffman 表 ID
+		uint32_t blocksPerLine = 0;        ///< 系数缓冲每行的块数（按 MCU 对齐）
+		uint32_t blocksPerColumn = 0;      ///< 系数缓冲每列的块数（按 MCU 对齐）
 	};
 
 	/**
@@ -63,7 +61,9 @@ namespace shine::image
 	{
 		std::vector<uint8_t> codeLengths;  ///< 每个码长的符号数量
 		std::vector<uint8_t> symbols;     ///< Huffman 符号值
-		std::vector<uint16_t> codes;      ///< Huffman 码值（用于快速查找）
+		std::vector<uint16_t> codes;      ///< 快速查找表（前 9 位索引，值为 符号<<8 | 码长，0xFFFF 表示长码）
+		std::array<int32_t, 18> maxCode{};     ///< 每个码长的最大码值（-1 表示该长度无符号）
+		std::array<int32_t, 17> valueOffset{}; ///< 每个码长的 符号下标 - 码值 偏移
 		bool isValid = false;              ///< 表是否有效
 	};
 
@@ -76,6 +76,58 @@ namespace shine::image
 		bool isValid = false;                  ///< 表是否有效
 	};
 
+	/**
+	 * @brief JPEG 扫描（SOS 段）描述
+	 *
+	 * 基线 JPEG 通常只有一个交错扫描；渐进式 JPEG 由多个扫描组成，
+	 * 每个扫描只编码部分频谱（Ss..Se）或部分位平面（Ah/Al）。
+	 */
+	struct JpegScan
+	{
+		uint8_t componentCount = 0;                     ///< 扫描中的分量数量
+		std::array<uint8_t, 4> componentIndices{};      ///< 扫描分量在 components 中的下标
+		std::array<JpegHuffmanTable, 4> dcTables;       ///< 扫描分量使用的 DC 表（SOS 时的快照）
+		std::array<JpegHuffmanTable, 4> acTables;       ///< 扫描分量使用的 AC 表（SOS 时的快照）
+		uint8_t spectralStart = 0;                      ///< 频谱选择开始（Ss）
+		uint8_t spectralEnd = 63;                       ///< 频谱选择结束（Se）
+		uint8_t approxHigh = 0;                         ///< 逐次逼近高位（Ah，0 表示首次扫描）
+		uint8_t approxLow = 0;                          ///< 逐次逼近低位（Al）
+		uint16_t restartInterval = 0;                   ///< 重启间隔（MCU 数，0 表示无）
+		size_t dataOffset = 0;                          ///< 熵编码数据在原始文件中的偏移
+		size_t dataSize = 0;                            ///< 熵编码数据长度（包含 RSTn 标记）
+	};
+
+	/**
+	 * @brief 缩放解码比例（输出尺寸 = 原尺寸 / 比例，向上取整）
+	 *
+	 * 缩小解码直接在 DCT 域完成：每个 8x8 块只做 4x4 / 2x2 / 1x1 的缩小 IDCT，
+	 * 与 libjpeg 的 scale_denom 相同，用于缩略图和 mip 尾部。
+	 */
+	enum class JpegScale : uint8_t
+	{
+		Full = 1,     ///< 原尺寸
+		Half = 2,     ///< 1/2（4x4 IDCT）
+		Quarter = 4,  ///< 1/4（2x2 IDCT）
+		Eighth = 8    ///< 1/8（只用 DC 系数）
+	};
+
+	/**
+	 * @brief 渐进式解码的低分辨率预览
+	 *
+	 * 由所有分量的 DC 系数生成，每个 8x8 块对应一个像素（1/8 分辨率）。
+	 */
+	struct JpegPreview
+	{
+		uint32_t width = 0;                 ///< 预览宽度（像素）
+		uint32_t height = 0;                ///< 预览高度（像素）
+		std::span<const uint8_t> rgba;      ///< RGBA 像素（仅在回调期间有效）
+		uint32_t scanIndex = 0;             ///< 产生预览时已完成的扫描下标
+		uint32_t scanCount = 0;             ///< 扫描总数
+	};
+
+	/// 预览回调（在调用 decode() 的线程上执行）
+	using JpegPreviewCallback = std::function<void(const JpegPreview&)>;
+
 	// ============================================================================
 	// JPEG 解码器类
 	// ============================================================================
@@ -93,8 +145,10 @@ namespace shine::image
 	 * - 反量化
 	 * - IDCT（逆离散余弦变换）
 	 * - 颜色空间转换（YCbCr -> RGB）
+	 * - 渐进式 JPEG（频谱选择 + 逐次逼近），首个 DC 扫描后可输出低分辨率预览
 	 * 
-	 * @note 当前实现支持标准 JPEG 格式，渐进式 JPEG 支持待完善
+	 * 所有扫描先解码到按分量存放的系数缓冲，全部扫描完成后统一反量化和 IDCT，
+	 * 因此基线与渐进式共用同一套重建流程。
 	 */
 	class jpeg : public loader::IImageLoader
 	{
@@ -149,6 +203,18 @@ namespace shine::image
 		 */
 		constexpr uint8_t getComponentCount() const noexcept { return componentCount; }
 
+		/**
+		 * @brief 是否为渐进式 JPEG（SOF2）
+		 * @return true 如果是渐进式
+		 */
+		bool isProgressive() const noexcept { return progressive; }
+
+		/**
+		 * @brief 获取扫描数量
+		 * @return SOS 段数量
+		 */
+		size_t getScanCount() const noexcept { return scans.size(); }
+
 		/**
 		 * @brief 检查是否已加载
 		 * @return true 如果已加载
@@ -187,6 +253,37 @@ namespace shine::image
 		 */
 		std::expected<void, std::string> decode();
 
+		/**
+		 * @brief 按比例缩小解码为 RGBA 格式
+		 *
+		 * 熵解码仍需读完整个文件，但反量化、IDCT 和颜色转换只在缩小后的分辨率上进行，
+		 * 输出缓冲也只有缩小后的大小。单扫描的顺序式 JPEG 逐 MCU 行边解码边重建，不分配整幅系数缓冲。
+		 * 解码结果的尺寸通过 getOutputWidth() / getOutputHeight() 获取。
+		 *
+		 * @param scale 缩放比例
+		 * @return 成功返回 void，失败返回错误信息
+		 */
+		std::expected<void, std::string> decodeScaled(JpegScale scale);
+
+		/**
+		 * @brief 选择输出尺寸不小于目标尺寸的最小缩放比例
+		 * @param width 图像宽度
+		 * @param height 图像高度
+		 * @param minSize 输出较长边至少需要的像素数（例如缩略图的边长）
+		 * @return 缩放比例
+		 */
+		static JpegScale selectScale(uint32_t width, uint32_t height, uint32_t minSize) noexcept;
+
+		/**
+		 * @brief 获取最近一次解码输出的宽度（缩放解码时小于 getWidth()）
+		 */
+		uint32_t getOutputWidth() const noexcept { return _outputWidth; }
+
+		/**
+		 * @brief 获取最近一次解码输出的高度（缩放解码时小于 getHeight()）
+		 */
+		uint32_t getOutputHeight() const noexcept { return _outputHeight; }
+
 		/**
 		 * @brief 解码 JPEG 图像数据为 RGB 格式
 		 * 
@@ -209,6 +306,41 @@ namespace shine::image
 		 */
 		bool isDecoded() const noexcept { return !imageData.empty(); }
 
+		/**
+		 * @brief 设置渐进式解码的预览回调
+		 *
+		 * 渐进式 JPEG 的所有分量都完成首个 DC 扫描后，回调收到一张 1/8 分辨率的
+		 * RGBA 预览（例如资源浏览器可先显示缩略图）；之后的 AC/细化扫描继续解码，
+		 * 最终结果仍由 getImageData() 获取。基线 JPEG 只有一次完整扫描，不会触发回调。
+		 *
+		 * @param callback 回调函数，传入空函数表示取消
+		 */
+		void setPreviewCallback(JpegPreviewCallback callback) { previewCallback = std::move(callback); }
+
+		/**
+		 * @brief 启用或关闭多线程熵解码（默认关闭）
+		 *
+		 * 带重启间隔（DRI）的扫描在每个 RSTn 标记处重置 DC 预测器和 EOB 游程，各间隔互不依赖。
+		 * 开启后，像素数不少于 minPixels 的图像先扫描 RSTn 标记切分熵编码数据，再把连续的若干
+		 * 间隔（通常一个间隔就是一个或几个 MCU 行）分给 util::ThreadPool 并行 Huffman 解码，
+		 * 各间隔直接写入互不重叠的系数块。没有 DRI、或 RSTn 数量与间隔数不符时回退到串行解码。
+		 *
+		 * 调用线程在等待时会参与执行剩余任务，因此可以在线程池的工作线程中调用。
+		 *
+		 * @param enable 是否启用
+		 * @param minPixels 启用多线程的最小像素数，小图像的调度开销大于收益
+		 */
+		void setParallelDecode(bool enable, size_t minPixels = 512 * 512) noexcept
+		{
+			_parallelDecode = enable;
+			_parallelMinPixels = minPixels;
+		}
+
+		/**
+		 * @brief 是否启用了多线程熵解码
+		 */
+		bool isParallelDecode() const noexcept { return _parallelDecode; }
+
 	private:
 		// ========================================================================
 		// 私有接口：JPEG 解码核心实现
@@ -216,9 +348,10 @@ namespace shine::image
 
 		/**
 		 * @brief JPEG 解码内部实现
+		 * @param scale 缩放比例
 		 * @return 成功返回 void，失败返回错误信息
 		 */
-		std::expected<void, std::string> decodeInternal();
+		std::expected<void, std::string> decodeInternal(JpegScale scale = JpegScale::Full);
 
 		/**
 		 * @brief 解析 JPEG 段
@@ -260,63 +393,43 @@ namespace shine::image
 		bool parseSOS(std::span<const std::byte> data, size_t length);
 
 		/**
-		 * @brief 构建 Huffman 查找表
-		 * @param table Huffman 表引用
-		 */
-		void buildHuffmanLookupTable(JpegHuffmanTable& table);
-
-		/**
-		 * @brief Huffman 解码符号
-		 * @param reader 位读取器
-		 * @param table Huffman 表
-		 * @return 解码的符号值
+		 * @brief 解析 DRI（Define Restart Interval）段
+		 * @param data 段数据
+		 * @param length 段长度
+		 * @return true 如果解析成功
 		 */
-		int32_t decodeHuffmanSymbol(util::BitReader& reader, const JpegHuffmanTable& table);
+		bool parseDRI(std::span<const std::byte> data, size_t length);
 
 		/**
-		 * @brief 解码 JPEG 扫描数据
-		 * @param scanData 扫描数据
-		 * @return 成功返回解码后的 MCU 数据，失败返回错误信息
+		 * @brief 构建 Huffman 查找表
+		 * @param table Huffman 表引用
+		 * @return true 如果码长分布合法
 		 */
-		std::expected<std::vector<int16_t>, std::string> decodeScanData(
-			std::span<const uint8_t> scanData);
+		bool buildHuffmanLookupTable(JpegHuffmanTable& table);
 
 		/**
-		 * @brief 反量化 DCT 系数
-		 * @param mcuData MCU 数据
-		 * @param componentId 分量 ID
-		 * @return 反量化后的 DCT 系数
+		 * @brief 根据帧参数分配各分量的系数缓冲
+		 * @param singleMcuRow 只分配一个 MCU 行（逐行流式解码），否则分配整幅图像
 		 */
-		std::vector<int16_t> dequantize(const std::vector<int16_t>& mcuData, uint8_t componentId);
+		void allocateCoefficients(bool singleMcuRow = false);
 
 		/**
-		 * @brief IDCT（逆离散余弦变换）
-		 * @param coefficients DCT 系数（8x8 块）
-		 * @return IDCT 后的像素值（8x8 块）
+		 * @brief 该扫描是否按重启间隔多线程熵解码
 		 */
-		std::array<int16_t, 64> idct(const std::array<int16_t, 64>& coefficients);
+		bool shouldDecodeParallel(const JpegScan& scan) const noexcept;
 
 		/**
-		 * @brief 颜色空间转换：YCbCr -> RGB
-		 * @param yData Y 分量数据
-		 * @param cbData Cb 分量数据
-		 * @param crData Cr 分量数据
-		 * @param output 输出 RGBA 数据
+		 * @brief 解码一个扫描的熵编码数据到系数缓冲
+		 * @param scan 扫描描述
+		 * @return 成功返回 void，失败返回错误信息
 		 */
-		void convertYCbCrToRGBA(
-			const std::vector<int16_t>& yData,
-			const std::vector<int16_t>& cbData,
-			const std::vector<int16_t>& crData,
-			std::vector<uint8_t>& output);
+		std::expected<void, std::string> decodeScanData(const JpegScan& scan);
 
 		/**
-		 * @brief 颜色空间转换：灰度 -> RGBA
-		 * @param grayData 灰度数据
-		 * @param output 输出 RGBA 数据
+		 * @brief 由 DC 系数生成 1/8 分辨率预览并调用预览回调
+		 * @param scanIndex 已完成的扫描下标
 		 */
-		void convertGrayscaleToRGBA(
-			const std::vector<int16_t>& grayData,
-			std::vector<uint8_t>& output);
+		void emitPreview(uint32_t scanIndex);
 
 		// ========================================================================
 		// 成员变量：基本图像信息
@@ -327,6 +440,8 @@ namespace shine::image
 
 		uint32_t _width = 0;            ///< 图像宽度（像素）
 		uint32_t _height = 0;           ///< 图像高度（像素）
+		uint32_t _outputWidth = 0;      ///< 解码输出宽度（像素）
+		uint32_t _outputHeight = 0;     ///< 解码输出高度（像素）
 		uint8_t precision = 8;          ///< 采样精度（通常为 8 位）
 		uint8_t componentCount = 0;      ///< 颜色分量数量（1=灰度，3=RGB/YCbCr）
 
@@ -336,13 +451,13 @@ namespace shine::image
 
 		std::vector<uint8_t> rawJpegData;    ///< 原始 JPEG 文件数据
 		std::vector<uint8_t> imageData;      ///< 解码后的图像数据（RGBA 格式，每像素 4 字节）
-		std::vector<uint8_t> scanData;       ///< 扫描数据（压缩的图像数据）
 
 		// ========================================================================
 		// 成员变量：颜色分量信息
 		// ========================================================================
 
 		std::vector<JpegComponent> components;  ///< 颜色分量信息列表
+		std::vector<std::vector<int16_t>> coefficients;  ///< 每个分量的量化 DCT 系数（按块存放，块内为自然顺序）
 
 		// ========================================================================
 		// 成员变量：量化表和 Huffman 表
@@ -356,8 +471,17 @@ namespace shine::image
 		// 成员变量：扫描参数
 		// ========================================================================
 
-		uint8_t scanComponentCount = 0;  ///< 扫描中的分量数量
-		std::vector<uint8_t> scanComponentIds;  ///< 扫描中的分量 ID 列表
+		std::vector<JpegScan> scans;       ///< 所有扫描（按文件顺序）
+		uint16_t restartInterval = 0;      ///< 当前重启间隔（DRI）
+		bool progressive = false;          ///< 是否为渐进式 JPEG
+		uint8_t maxHSampling = 1;          ///< 最大水平采样因子
+		uint8_t maxVSampling = 1;          ///< 最大垂直采样因子
+		uint32_t mcuCols = 0;              ///< 每行 MCU 数
+		uint32_t mcuRows = 0;              ///< 每列 MCU 数
+
+		JpegPreviewCallback previewCallback;  ///< 渐进式预览回调
+		bool _parallelDecode = false;            ///< 是否启用多线程熵解码
+		size_t _parallelMinPixels = 512 * 512;   ///< 启用多线程熵解码的最小像素数
 	};
 
 } // namespace shine::image
@@ -0,0 +1,778 @@
+#include "jpeg_dsp.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if !defined(__EMSCRIPTEN__) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define SHINE_JPEG_DSP_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要按函数开启指令集，MSVC 的 intrinsic 不依赖编译选项
+#if defined(SHINE_JPEG_DSP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SHINE_TARGET_SSE2 __attribute__((target("sse2")))
+#define SHINE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SHINE_TARGET_SSE2
+#define SHINE_TARGET_AVX2
+#endif
+
+/**
+ * @file jpeg_dsp.cpp
+ * @brief JPEG 像素重建内核实现
+ *
+ * SIMD IDCT 沿用 stb_image 的构造：列变换结果饱和到 16 位后转置，再做行变换，
+ * 标量实现同样在列变换后饱和到 16 位，因此任意输入下各内核结果一致。
+ */
+
+namespace shine::image::jpeg_dsp
+{
+	namespace
+	{
+		/// 浮点常数 -> 4096 倍定点
+		constexpr int32_t f2f(double x) noexcept
+		{
+			return static_cast<int32_t>(x * 4096 + 0.5);
+		}
+
+		// YCbCr -> RGB 系数（JFIF，14 位定点）
+		constexpr int32_t CR_TO_R = 22970;    // 1.402
+		constexpr int32_t CB_TO_G = -5638;    // -0.344136
+		constexpr int32_t CR_TO_G = -11700;   // -0.714136
+		constexpr int32_t CB_TO_B = 29032;    // 1.772
+		constexpr int32_t YCC_ROUND = 1 << 13;
+
+		// ============================================================================
+		// 标量参考实现
+		// ============================================================================
+
+		/// 按 16 位回绕（与 SIMD 的 add_epi16 / sub_epi16 一致）
+		inline int32_t wrap16(int32_t v) noexcept
+		{
+			return static_cast<int16_t>(static_cast<uint16_t>(v));
+		}
+
+		inline int32_t saturate16(int32_t v) noexcept
+		{
+			return std::clamp(v, -32768, 32767);
+		}
+
+		/**
+		 * @brief IDCT 1D 变换（参考 stb_image / libjpeg jidctint）
+		 *
+		 * 输出 x0..x3（偶数部分）与 t0..t3（奇数部分），最终结果为 x[i] ± t[3-i]。
+		 * SIMD 内核中 s0±s4、s1+s7、s3+s5 在 16 位下计算，这里同样按 16 位回绕。
+		 */
+		struct Idct1D
+		{
+			int32_t x0, x1, x2, x3;
+			int32_t t0, t1, t2, t3;
+
+			Idct1D(int32_t s0, int32_t s1, int32_t s2, int32_t s3,
+				int32_t s4, int32_t s5, int32_t s6, int32_t s7) noexcept
+			{
+				int32_t p1 = (s2 + s6) * f2f(0.5411961);
+				t2 = p1 + s6 * f2f(-1.847759065);
+				t3 = p1 + s2 * f2f(0.765366865);
+				t0 = wrap16(s0 + s4) * 4096;
+				t1 = wrap16(s0 - s4) * 4096;
+				x0 = t0 + t3;
+				x3 = t0 - t3;
+				x1 = t1 + t2;
+				x2 = t1 - t2;
+
+				const int32_t sum17 = wrap16(s1 + s7);
+				const int32_t sum35 = wrap16(s3 + s5);
+				int32_t p3 = s7 + s3;
+				int32_t p4 = s5 + s1;
+				const int32_t p5 = (sum17 + sum35) * f2f(1.175875602);
+				t0 = s7 * f2f(0.298631336);
+				t1 = s5 * f2f(2.053119869);
+				t2 = s3 * f2f(3.072711026);
+				t3 = s1 * f2f(1.501321110);
+				p1 = p5 + sum17 * f2f(-0.899976223);
+				const int32_t p2 = p5 + sum35 * f2f(-2.562915447);
+				p3 = p3 * f2f(-1.961570560);
+				p4 = p4 * f2f(-0.390180644);
+				t3 += p1 + p4;
+				t2 += p2 + p3;
+				t1 += p2 + p4;
+				t0 += p1 + p3;
+			}
+		};
+
+		inline uint8_t clampByte(int32_t v) noexcept
+		{
+			return static_cast<uint8_t>(std::clamp(v, 0, 255));
+		}
+
+		void idctBlockScalar(const int16_t* coefficients, const uint16_t* quantTable, uint8_t* out, size_t outStride) noexcept
+		{
+			// 反量化（与 SIMD 的 16 位乘法一致，按 16 位截断）
+			int16_t data[64];
+			for (int i = 0; i < 64; ++i)
+			{
+				data[i] = static_cast<int16_t>(coefficients[i] * quantTable[i]);
+			}
+
+			int32_t temp[64];
+
+			// 列变换
+			for (int col = 0; col < 8; ++col)
+			{
+				const int16_t* d = data + col;
+				int32_t* v = temp + col;
+
+				// 如果列的 AC 全为零，快速路径
+				if (d[8] == 0 && d[16] == 0 && d[24] == 0 && d[32] == 0 &&
+				    d[40] == 0 && d[48] == 0 && d[56] == 0)
+				{
+					const int32_t dcterm = saturate16(d[0] * 4);
+					v[0] = v[8] = v[16] = v[24] = v[32] = v[40] = v[48] = v[56] = dcterm;
+					continue;
+				}
+
+				const Idct1D r(d[0], d[8], d[16], d[24], d[32], d[40], d[48], d[56]);
+				// 常数放大了 1<<12，缩回时保留 2 位额外精度
+				v[0] = saturate16((r.x0 + 512 + r.t3) >> 10);
+				v[56] = saturate16((r.x0 + 512 - r.t3) >> 10);
+				v[8] = saturate16((r.x1 + 512 + r.t2) >> 10);
+				v[48] = saturate16((r.x1 + 512 - r.t2) >> 10);
+				v[16] = saturate16((r.x2 + 512 + r.t1) >> 10);
+				v[40] = saturate16((r.x2 + 512 - r.t1) >> 10);
+				v[24] = saturate16((r.x3 + 512 + r.t0) >> 10);
+				v[32] = saturate16((r.x3 + 512 - r.t0) >> 10);
+			}
+
+			// 行变换并输出
+			// 共需移除 1<<17（常数 1<<12、列变换的 1<<2、两次 sqrt(8) 的 1<<3），同时加上舍入和 128 的电平偏移
+			constexpr int32_t bias = 65536 + (128 << 17);
+			for (int row = 0; row < 8; ++row, out += outStride)
+			{
+				const int32_t* v = temp + row * 8;
+				const Idct1D r(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+				out[0] = clampByte((r.x0 + bias + r.t3) >> 17);
+				out[7] = clampByte((r.x0 + bias - r.t3) >> 17);
+				out[1] = clampByte((r.x1 + bias + r.t2) >> 17);
+				out[6] = clampByte((r.x1 + bias - r.t2) >> 17);
+				out[2] = clampByte((r.x2 + bias + r.t1) >> 17);
+				out[5] = clampByte((r.x2 + bias - r.t1) >> 17);
+				out[3] = clampByte((r.x3 + bias + r.t0) >> 17);
+				out[4] = clampByte((r.x3 + bias - r.t0) >> 17);
+			}
+		}
+
+		/**
+		 * @brief 对 8 行像素按 Factor×Factor 区域取平均（四舍五入），宽度 width 须为 Factor 的倍数
+		 */
+		template <uint32_t Factor>
+		void boxDownscale8Rows(const uint8_t* in, size_t inStride, size_t width, uint8_t* out, size_t outStride) noexcept
+		{
+			constexpr uint32_t shift = Factor == 4 ? 4 : 2;
+			constexpr uint32_t round = 1u << (shift - 1);
+			for (uint32_t y = 0; y < 8 / Factor; ++y, in += inStride * Factor, out += outStride)
+			{
+				for (size_t x = 0; x < width / Factor; ++x)
+				{
+					uint32_t sum = round;
+					for (uint32_t dy = 0; dy < Factor; ++dy)
+					{
+						const uint8_t* p = in + dy * inStride + x * Factor;
+						for (uint32_t dx = 0; dx < Factor; ++dx)
+						{
+							sum += p[dx];
+						}
+					}
+					out[x] = static_cast<uint8_t>(sum >> shift);
+				}
+			}
+		}
+
+		void yccToRgbaScalar(const uint8_t* y, const uint8_t* cb, const uint8_t* cr,
+			uint8_t* rgba, size_t begin, size_t width, uint32_t chromaShift) noexcept
+		{
+			for (size_t x = begin; x < width; ++x)
+			{
+				const int32_t luma = y[x];
+				const int32_t b = cb[x >> chromaShift] - 128;
+				const int32_t r = cr[x >> chromaShift] - 128;
+
+				uint8_t* p = rgba + x * 4;
+				p[0] = clampByte(luma + ((r * CR_TO_R + YCC_ROUND) >> 14));
+				p[1] = clampByte(luma + ((b * CB_TO_G + r * CR_TO_G + YCC_ROUND) >> 14));
+				p[2] = clampByte(luma + ((b * CB_TO_B + YCC_ROUND) >> 14));
+				p[3] = 255;
+			}
+		}
+
+#if defined(SHINE_JPEG_DSP_X86)
+		// ============================================================================
+		// x86 SSE2 / AVX2 内核
+		// ============================================================================
+
+		// IDCT 的 SIMD 构造（参考 stb_image stbi__idct_simd）。
+		// 宏通过 JPEG_V(op) 选择 _mm_ 或 _mm256_ 前缀，AVX2 版本的每条指令都只在 128 位通道内运算，
+		// 因此两个通道各自独立地完成一个块的变换。
+
+		// out(0) = c0[偶]*x + c0[奇]*y，out(1) = c1[偶]*x + c1[奇]*y（16 位输入，32 位输出）
+		#define JPEG_DCT_ROT(out0, out1, x, y, c0, c1) \
+			const VecT out0##_lo_in = JPEG_V(unpacklo_epi16)((x), (y)); \
+			const VecT out0##_hi_in = JPEG_V(unpackhi_epi16)((x), (y)); \
+			const VecT out0##_l = JPEG_V(madd_epi16)(out0##_lo_in, c0); \
+			const VecT out0##_h = JPEG_V(madd_epi16)(out0##_hi_in, c0); \
+			const VecT out1##_l = JPEG_V(madd_epi16)(out0##_lo_in, c1); \
+			const VecT out1##_h = JPEG_V(madd_epi16)(out0##_hi_in, c1)
+
+		// out = in << 12（16 位输入，32 位输出）
+		#define JPEG_DCT_WIDEN(out, in) \
+			const VecT out##_l = JPEG_V(srai_epi32)(JPEG_V(unpacklo_epi16)(JPEG_ZERO(), (in)), 4); \
+			const VecT out##_h = JPEG_V(srai_epi32)(JPEG_V(unpackhi_epi16)(JPEG_ZERO(), (in)), 4)
+
+		#define JPEG_DCT_WADD(out, a, b) \
+			const VecT out##_l = JPEG_V(add_epi32)(a##_l, b##_l); \
+			const VecT out##_h = JPEG_V(add_epi32)(a##_h, b##_h)
+
+		#define JPEG_DCT_WSUB(out, a, b) \
+			const VecT out##_l = JPEG_V(sub_epi32)(a##_l, b##_l); \
+			const VecT out##_h = JPEG_V(sub_epi32)(a##_h, b##_h)
+
+		// 蝶形运算 a ± b，加偏置后右移 s 位并饱和打包为 16 位
+		#define JPEG_DCT_BFLY(out0, out1, a, b, bias, s) \
+			{ \
+				const VecT abiased_l = JPEG_V(add_epi32)(a##_l, bias); \
+				const VecT abiased_h = JPEG_V(add_epi32)(a##_h, bias); \
+				JPEG_DCT_WADD(sum, abiased, b); \
+				JPEG_DCT_WSUB(dif, abiased, b); \
+				out0 = JPEG_V(packs_epi32)(JPEG_V(srai_epi32)(sum_l, s), JPEG_V(srai_epi32)(sum_h, s)); \
+				out1 = JPEG_V(packs_epi32)(JPEG_V(srai_epi32)(dif_l, s), JPEG_V(srai_epi32)(dif_h, s)); \
+			}
+
+		#define JPEG_DCT_INTERLEAVE8(a, b) \
+			tmp = a; \
+			a = JPEG_V(unpacklo_epi8)(a, b); \
+			b = JPEG_V(unpackhi_epi8)(tmp, b)
+
+		#define JPEG_DCT_INTERLEAVE16(a, b) \
+			tmp = a; \
+			a = JPEG_V(unpacklo_epi16)(a, b); \
+			b = JPEG_V(unpackhi_epi16)(tmp, b)
+
+		#define JPEG_DCT_PASS(bias, shift) \
+			{ \
+				/* 偶数部分 */ \
+				JPEG_DCT_ROT(t2e, t3e, row2, row6, rot0_0, rot0_1); \
+				const VecT sum04 = JPEG_V(add_epi16)(row0, row4); \
+				const VecT dif04 = JPEG_V(sub_epi16)(row0, row4); \
+				JPEG_DCT_WIDEN(t0e, sum04); \
+				JPEG_DCT_WIDEN(t1e, dif04); \
+				JPEG_DCT_WADD(x0, t0e, t3e); \
+				JPEG_DCT_WSUB(x3, t0e, t3e); \
+				JPEG_DCT_WADD(x1, t1e, t2e); \
+				JPEG_DCT_WSUB(x2, t1e, t2e); \
+				/* 奇数部分 */ \
+				JPEG_DCT_ROT(y0o, y2o, row7, row3, rot2_0, rot2_1); \
+				JPEG_DCT_ROT(y1o, y3o, row5, row1, rot3_0, rot3_1); \
+				const VecT sum17 = JPEG_V(add_epi16)(row1, row7); \
+				const VecT sum35 = JPEG_V(add_epi16)(row3, row5); \
+				JPEG_DCT_ROT(y4o, y5o, sum17, sum35, rot1_0, rot1_1); \
+				JPEG_DCT_WADD(x4, y0o, y4o); \
+				JPEG_DCT_WADD(x5, y1o, y5o); \
+				JPEG_DCT_WADD(x6, y2o, y5o); \
+				JPEG_DCT_WADD(x7, y3o, y4o); \
+				JPEG_DCT_BFLY(row0, row7, x0, x7, bias, shift); \
+				JPEG_DCT_BFLY(row1, row6, x1, x6, bias, shift); \
+				JPEG_DCT_BFLY(row2, row5, x2, x5, bias, shift); \
+				JPEG_DCT_BFLY(row3, row4, x3, x4, bias, shift); \
+			}
+
+		// 两个 16 位常数交替排列（偶数位 x，奇数位 y），配合 madd 完成旋转
+		#define JPEG_DCT_CONST(x, y) JPEG_V(setr_epi16)( \
+			static_cast<short>(x), static_cast<short>(y), static_cast<short>(x), static_cast<short>(y), \
+			static_cast<short>(x), static_cast<short>(y), static_cast<short>(x), static_cast<short>(y) JPEG_DCT_CONST_TAIL(x, y))
+
+		// 列变换 -> 16 位 8x8 转置 -> 行变换 -> 8 位打包并转置回行顺序
+		#define JPEG_DCT_BODY() \
+			const VecT rot0_0 = JPEG_DCT_CONST(f2f(0.5411961), f2f(0.5411961) + f2f(-1.847759065)); \
+			const VecT rot0_1 = JPEG_DCT_CONST(f2f(0.5411961) + f2f(0.765366865), f2f(0.5411961)); \
+			const VecT rot1_0 = JPEG_DCT_CONST(f2f(1.175875602) + f2f(-0.899976223), f2f(1.175875602)); \
+			const VecT rot1_1 = JPEG_DCT_CONST(f2f(1.175875602), f2f(1.175875602) + f2f(-2.562915447)); \
+			const VecT rot2_0 = JPEG_DCT_CONST(f2f(-1.961570560) + f2f(0.298631336), f2f(-1.961570560)); \
+			const VecT rot2_1 = JPEG_DCT_CONST(f2f(-1.961570560), f2f(-1.961570560) + f2f(3.072711026)); \
+			const VecT rot3_0 = JPEG_DCT_CONST(f2f(-0.390180644) + f2f(2.053119869), f2f(-0.390180644)); \
+			const VecT rot3_1 = JPEG_DCT_CONST(f2f(-0.390180644), f2f(-0.390180644) + f2f(1.501321110)); \
+			const VecT bias0 = JPEG_V(set1_epi32)(512); \
+			const VecT bias1 = JPEG_V(set1_epi32)(65536 + (128 << 17)); \
+			VecT tmp; \
+			JPEG_DCT_PASS(bias0, 10); \
+			JPEG_DCT_INTERLEAVE16(row0, row4); \
+			JPEG_DCT_INTERLEAVE16(row1, row5); \
+			JPEG_DCT_INTERLEAVE16(row2, row6); \
+			JPEG_DCT_INTERLEAVE16(row3, row7); \
+			JPEG_DCT_INTERLEAVE16(row0, row2); \
+			JPEG_DCT_INTERLEAVE16(row1, row3); \
+			JPEG_DCT_INTERLEAVE16(row4, row6); \
+			JPEG_DCT_INTERLEAVE16(row5, row7); \
+			JPEG_DCT_INTERLEAVE16(row0, row1); \
+			JPEG_DCT_INTERLEAVE16(row2, row3); \
+			JPEG_DCT_INTERLEAVE16(row4, row5); \
+			JPEG_DCT_INTERLEAVE16(row6, row7); \
+			JPEG_DCT_PASS(bias1, 17); \
+			VecT p0 = JPEG_V(packus_epi16)(row0, row1); \
+			VecT p1 = JPEG_V(packus_epi16)(row2, row3); \
+			VecT p2 = JPEG_V(packus_epi16)(row4, row5); \
+			VecT p3 = JPEG_V(packus_epi16)(row6, row7); \
+			JPEG_DCT_INTERLEAVE8(p0, p2); \
+			JPEG_DCT_INTERLEAVE8(p1, p3); \
+			JPEG_DCT_INTERLEAVE8(p0, p1); \
+			JPEG_DCT_INTERLEAVE8(p2, p3); \
+			JPEG_DCT_INTERLEAVE8(p0, p2); \
+			JPEG_DCT_INTERLEAVE8(p1, p3)
+
+		/**
+		 * @brief 按 8 字节存储打包结果的 8 行：p0 低/高、p2 低/高、p1 低/高、p3 低/高
+		 */
+		SHINE_TARGET_SSE2 inline void storeIdctRows(uint8_t* out, size_t outStride,
+			__m128i p0, __m128i p1, __m128i p2, __m128i p3) noexcept
+		{
+			const __m128i rows[4] = { p0, p2, p1, p3 };
+			for (const __m128i& r : rows)
+			{
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(out), r);
+				out += outStride;
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi32(r, 0x4E));
+				out += outStride;
+			}
+		}
+
+		/// 载入一行系数并与量化表相乘（16 位截断，与标量实现一致）
+		SHINE_TARGET_SSE2 inline __m128i loadDequantSSE2(const int16_t* coefficients, const uint16_t* quantTable, int row) noexcept
+		{
+			return _mm_mullo_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(coefficients + row * 8)),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(quantTable + row * 8)));
+		}
+
+		/// 载入两个相邻块的同一行系数（低 128 位块 A，高 128 位块 B）并反量化
+		SHINE_TARGET_AVX2 inline __m256i loadDequantPairAVX2(const int16_t* coefficients, const uint16_t* quantTable, int row) noexcept
+		{
+			const __m256i coef = _mm256_inserti128_si256(
+				_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(coefficients + row * 8))),
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(coefficients + 64 + row * 8)), 1);
+			const __m256i quant = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(quantTable + row * 8)));
+			return _mm256_mullo_epi16(coef, quant);
+		}
+
+		#define JPEG_V(op) _mm_##op
+		#define JPEG_ZERO() _mm_setzero_si128()
+		#define JPEG_DCT_CONST_TAIL(x, y)
+
+		SHINE_TARGET_SSE2 void idctBlockSSE2(const int16_t* coefficients, const uint16_t* quantTable,
+			uint8_t* out, size_t outStride) noexcept
+		{
+			using VecT = __m128i;
+
+			VecT row0 = loadDequantSSE2(coefficients, quantTable, 0);
+			VecT row1 = loadDequantSSE2(coefficients, quantTable, 1);
+			VecT row2 = loadDequantSSE2(coefficients, quantTable, 2);
+			VecT row3 = loadDequantSSE2(coefficients, quantTable, 3);
+			VecT row4 = loadDequantSSE2(coefficients, quantTable, 4);
+			VecT row5 = loadDequantSSE2(coefficients, quantTable, 5);
+			VecT row6 = loadDequantSSE2(coefficients, quantTable, 6);
+			VecT row7 = loadDequantSSE2(coefficients, quantTable, 7);
+
+			JPEG_DCT_BODY();
+
+			storeIdctRows(out, outStride, p0, p1, p2, p3);
+		}
+
+		#undef JPEG_V
+		#undef JPEG_ZERO
+		#undef JPEG_DCT_CONST_TAIL
+		#define JPEG_V(op) _mm256_##op
+		#define JPEG_ZERO() _mm256_setzero_si256()
+		#define JPEG_DCT_CONST_TAIL(x, y) , \
+			static_cast<short>(x), static_cast<short>(y), static_cast<short>(x), static_cast<short>(y), \
+			static_cast<short>(x), static_cast<short>(y), static_cast<short>(x), static_cast<short>(y)
+
+		/**
+		 * @brief AVX2：一次变换两个相邻块（低 128 位为块 A，高 128 位为块 B）
+		 */
+		SHINE_TARGET_AVX2 void idctBlockPairAVX2(const int16_t* coefficients, const uint16_t* quantTable,
+			uint8_t* out, size_t outStride) noexcept
+		{
+			using VecT = __m256i;
+
+			VecT row0 = loadDequantPairAVX2(coefficients, quantTable, 0);
+			VecT row1 = loadDequantPairAVX2(coefficients, quantTable, 1);
+			VecT row2 = loadDequantPairAVX2(coefficients, quantTable, 2);
+			VecT row3 = loadDequantPairAVX2(coefficients, quantTable, 3);
+			VecT row4 = loadDequantPairAVX2(coefficients, quantTable, 4);
+			VecT row5 = loadDequantPairAVX2(coefficients, quantTable, 5);
+			VecT row6 = loadDequantPairAVX2(coefficients, quantTable, 6);
+			VecT row7 = loadDequantPairAVX2(coefficients, quantTable, 7);
+
+			JPEG_DCT_BODY();
+
+			storeIdctRows(out, outStride,
+				_mm256_castsi256_si128(p0), _mm256_castsi256_si128(p1),
+				_mm256_castsi256_si128(p2), _mm256_castsi256_si128(p3));
+			storeIdctRows(out + 8, outStride,
+				_mm256_extracti128_si256(p0, 1), _mm256_extracti128_si256(p1, 1),
+				_mm256_extracti128_si256(p2, 1), _mm256_extracti128_si256(p3, 1));
+		}
+
+		#undef JPEG_V
+		#undef JPEG_ZERO
+		#undef JPEG_DCT_CONST_TAIL
+		#undef JPEG_DCT_BODY
+		#undef JPEG_DCT_CONST
+		#undef JPEG_DCT_PASS
+		#undef JPEG_DCT_INTERLEAVE16
+		#undef JPEG_DCT_INTERLEAVE8
+		#undef JPEG_DCT_BFLY
+		#undef JPEG_DCT_WSUB
+		#undef JPEG_DCT_WADD
+		#undef JPEG_DCT_WIDEN
+		#undef JPEG_DCT_ROT
+
+		/**
+		 * @brief 8 个像素的色度（Cb/Cr 交错为 16 位对）与系数做乘加，舍入后右移 14 位，饱和为 16 位
+		 */
+		SHINE_TARGET_SSE2 inline __m128i chromaTermSSE2(__m128i lo, __m128i hi, __m128i coeff) noexcept
+		{
+			const __m128i round = _mm_set1_epi32(YCC_ROUND);
+			return _mm_packs_epi32(
+				_mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(lo, coeff), round), 14),
+				_mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(hi, coeff), round), 14));
+		}
+
+		SHINE_TARGET_SSE2 void yccToRgbaSSE2(const uint8_t* y, const uint8_t* cb, const uint8_t* cr,
+			uint8_t* rgba, size_t width, uint32_t chromaShift) noexcept
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i bias = _mm_set1_epi16(128);
+			const __m128i alpha = _mm_set1_epi16(static_cast<short>(0xFF00));
+			const __m128i kR = _mm_set1_epi32(static_cast<int32_t>(static_cast<uint32_t>(CR_TO_R) << 16));
+			const __m128i kG = _mm_set1_epi32(static_cast<int32_t>((static_cast<uint32_t>(CR_TO_G) << 16) | (static_cast<uint32_t>(CB_TO_G) & 0xFFFF)));
+			const __m128i kB = _mm_set1_epi32(CB_TO_B);
+
+			size_t x = 0;
+			for (; x + 8 <= width; x += 8)
+			{
+				const __m128i luma = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(y + x)), zero);
+
+				__m128i cb8;
+				__m128i cr8;
+				if (chromaShift == 0)
+				{
+					cb8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(cb + x));
+					cr8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(cr + x));
+				}
+				else
+				{
+					// 4 个色度样本各复制一次
+					int32_t cb4;
+					int32_t cr4;
+					std::memcpy(&cb4, cb + (x >> 1), 4);
+					std::memcpy(&cr4, cr + (x >> 1), 4);
+					cb8 = _mm_cvtsi32_si128(cb4);
+					cr8 = _mm_cvtsi32_si128(cr4);
+					cb8 = _mm_unpacklo_epi8(cb8, cb8);
+					cr8 = _mm_unpacklo_epi8(cr8, cr8);
+				}
+				const __m128i cb16 = _mm_sub_epi16(_mm_unpacklo_epi8(cb8, zero), bias);
+				const __m128i cr16 = _mm_sub_epi16(_mm_unpacklo_epi8(cr8, zero), bias);
+				const __m128i lo = _mm_unpacklo_epi16(cb16, cr16);
+				const __m128i hi = _mm_unpackhi_epi16(cb16, cr16);
+
+				const __m128i r = _mm_add_epi16(luma, chromaTermSSE2(lo, hi, kR));
+				const __m128i g = _mm_add_epi16(luma, chromaTermSSE2(lo, hi, kG));
+				const __m128i b = _mm_add_epi16(luma, chromaTermSSE2(lo, hi, kB));
+
+				// 饱和到 0-255 后组合为 RG / BA 两个 16 位通道
+				const __m128i r8 = _mm_packus_epi16(r, zero);
+				const __m128i g8 = _mm_packus_epi16(g, zero);
+				const __m128i b8 = _mm_packus_epi16(b, zero);
+				const __m128i rg = _mm_unpacklo_epi8(r8, g8);
+				const __m128i ba = _mm_or_si128(_mm_unpacklo_epi8(b8, zero), alpha);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + x * 4), _mm_unpacklo_epi16(rg, ba));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + x * 4 + 16), _mm_unpackhi_epi16(rg, ba));
+			}
+
+			yccToRgbaScalar(y, cb, cr, rgba, x, width, chromaShift);
+		}
+
+		SHINE_TARGET_AVX2 inline __m256i chromaTermAVX2(__m256i lo, __m256i hi, __m256i coeff) noexcept
+		{
+			const __m256i round = _mm256_set1_epi32(YCC_ROUND);
+			return _mm256_packs_epi32(
+				_mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(lo, coeff), round), 14),
+				_mm256_srai_epi32(_mm256_add_epi32(_mm256_madd_epi16(hi, coeff), round), 14));
+		}
+
+		SHINE_TARGET_AVX2 void yccToRgbaAVX2(const uint8_t* y, const uint8_t* cb, const uint8_t* cr,
+			uint8_t* rgba, size_t width, uint32_t chromaShift) noexcept
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i maxByte = _mm256_set1_epi16(255);
+			const __m256i bias = _mm256_set1_epi16(128);
+			const __m256i alpha = _mm256_set1_epi16(static_cast<short>(0xFF00));
+			const __m256i kR = _mm256_set1_epi32(static_cast<int32_t>(static_cast<uint32_t>(CR_TO_R) << 16));
+			const __m256i kG = _mm256_set1_epi32(static_cast<int32_t>((static_cast<uint32_t>(CR_TO_G) << 16) | (static_cast<uint32_t>(CB_TO_G) & 0xFFFF)));
+			const __m256i kB = _mm256_set1_epi32(CB_TO_B);
+
+			size_t x = 0;
+			for (; x + 16 <= width; x += 16)
+			{
+				const __m256i luma = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x)));
+
+				__m128i cb8;
+				__m128i cr8;
+				if (chromaShift == 0)
+				{
+					cb8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cb + x));
+					cr8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cr + x));
+				}
+				else
+				{
+					cb8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(cb + (x >> 1)));
+					cr8 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(cr + (x >> 1)));
+					cb8 = _mm_unpacklo_epi8(cb8, cb8);
+					cr8 = _mm_unpacklo_epi8(cr8, cr8);
+				}
+				const __m256i cb16 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(cb8), bias);
+				const __m256i cr16 = _mm256_sub_epi16(_mm256_cvtepu8_epi16(cr8), bias);
+
+				// 通道内交错：lo = 像素 0-3 | 8-11，hi = 4-7 | 12-15；packs 后恢复 0-15 的顺序
+				const __m256i lo = _mm256_unpacklo_epi16(cb16, cr16);
+				const __m256i hi = _mm256_unpackhi_epi16(cb16, cr16);
+
+				const __m256i r = _mm256_min_epi16(_mm256_max_epi16(_mm256_add_epi16(luma, chromaTermAVX2(lo, hi, kR)), zero), maxByte);
+				const __m256i g = _mm256_min_epi16(_mm256_max_epi16(_mm256_add_epi16(luma, chromaTermAVX2(lo, hi, kG)), zero), maxByte);
+				const __m256i b = _mm256_min_epi16(_mm256_max_epi16(_mm256_add_epi16(luma, chromaTermAVX2(lo, hi, kB)), zero), maxByte);
+
+				const __m256i rg = _mm256_or_si256(r, _mm256_slli_epi16(g, 8));
+				const __m256i ba = _mm256_or_si256(b, alpha);
+				const __m256i pxLo = _mm256_unpacklo_epi16(rg, ba);  // 像素 0-3 | 8-11
+				const __m256i pxHi = _mm256_unpackhi_epi16(rg, ba);  // 像素 4-7 | 12-15
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(rgba + x * 4), _mm256_permute2x128_si256(pxLo, pxHi, 0x20));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(rgba + x * 4 + 32), _mm256_permute2x128_si256(pxLo, pxHi, 0x31));
+			}
+
+			yccToRgbaScalar(y, cb, cr, rgba, x, width, chromaShift);
+		}
+#endif // SHINE_JPEG_DSP_X86
+
+		// ============================================================================
+		// 运行时检测
+		// ============================================================================
+
+#if defined(SHINE_JPEG_DSP_X86)
+		bool cpuHasSSE2() noexcept
+		{
+#if defined(__x86_64__) || defined(_M_X64)
+			return true; // x86-64 基线
+#elif defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 1);
+			return (info[3] & (1 << 26)) != 0;
+#else
+			return __builtin_cpu_supports("sse2");
+#endif
+		}
+
+		bool cpuHasAVX2() noexcept
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7)
+			{
+				return false;
+			}
+			__cpuid(info, 1);
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+			const bool avx = (info[2] & (1 << 28)) != 0;
+			if (!osxsave || !avx)
+			{
+				return false;
+			}
+			// 操作系统需保存 XMM/YMM 状态
+			if ((_xgetbv(0) & 0x6) != 0x6)
+			{
+				return false;
+			}
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			return __builtin_cpu_supports("avx2");
+#endif
+		}
+#endif
+
+		DspBackend detectBackend() noexcept
+		{
+#if defined(SHINE_JPEG_DSP_X86)
+			if (cpuHasAVX2())
+			{
+				return DspBackend::AVX2;
+			}
+			if (cpuHasSSE2())
+			{
+				return DspBackend::SSE2;
+			}
+#endif
+			return DspBackend::Scalar;
+		}
+	} // namespace
+
+	DspBackend activeBackend() noexcept
+	{
+		static const DspBackend backend = detectBackend();
+		return backend;
+	}
+
+	bool isBackendSupported(DspBackend backend) noexcept
+	{
+		switch (backend)
+		{
+		case DspBackend::Scalar:
+			return true;
+#if defined(SHINE_JPEG_DSP_X86)
+		case DspBackend::SSE2:
+			return cpuHasSSE2();
+		case DspBackend::AVX2:
+			return cpuHasAVX2();
+#endif
+		default:
+			return false;
+		}
+	}
+
+	const char* backendName(DspBackend backend) noexcept
+	{
+		switch (backend)
+		{
+		case DspBackend::Scalar: return "Scalar";
+		case DspBackend::SSE2: return "SSE2";
+		case DspBackend::AVX2: return "AVX2";
+		}
+		return "Unknown";
+	}
+
+	void idctBlocks(const int16_t* coefficients, const uint16_t* quantTable,
+		uint8_t* out, size_t outStride, size_t blockCount) noexcept
+	{
+		idctBlocks(activeBackend(), coefficients, quantTable, out, outStride, blockCount);
+	}
+
+	void idctBlocks(DspBackend backend, const int16_t* coefficients, const uint16_t* quantTable,
+		uint8_t* out, size_t outStride, size_t blockCount) noexcept
+	{
+		if (!isBackendSupported(backend))
+		{
+			backend = DspBackend::Scalar;
+		}
+
+		size_t i = 0;
+#if defined(SHINE_JPEG_DSP_X86)
+		if (backend == DspBackend::AVX2)
+		{
+			for (; i + 2 <= blockCount; i += 2)
+			{
+				idctBlockPairAVX2(coefficients + i * 64, quantTable, out + i * 8, outStride);
+			}
+		}
+		if (backend != DspBackend::Scalar)
+		{
+			for (; i < blockCount; ++i)
+			{
+				idctBlockSSE2(coefficients + i * 64, quantTable, out + i * 8, outStride);
+			}
+		}
+#endif
+		for (; i < blockCount; ++i)
+		{
+			idctBlockScalar(coefficients + i * 64, quantTable, out + i * 8, outStride);
+		}
+	}
+
+	void idctBlocksReduced(const int16_t* coefficients, const uint16_t* quantTable,
+		uint8_t* out, size_t outStride, size_t blockCount, uint32_t outputSize) noexcept
+	{
+		if (outputSize == 8)
+		{
+			idctBlocks(coefficients, quantTable, out, outStride, blockCount);
+			return;
+		}
+
+		if (outputSize == 1)
+		{
+			// 整块的平均值只取决于 DC：DC * Q / 8 + 128
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				const int32_t dc = static_cast<int16_t>(coefficients[i * 64] * quantTable[0]);
+				out[i] = clampByte(((dc + 4) >> 3) + 128);
+			}
+			return;
+		}
+
+		// 4x4 / 2x2：完整 SIMD IDCT 写入栈上的小缓冲，再按区域取平均。
+		// 结果等同于把区域平均并入基函数的缩小 IDCT（高频系数被折叠而不是丢弃），
+		// 而 SIMD IDCT 比标量的缩小变换快得多
+		constexpr size_t chunkBlocks = 16;
+		uint8_t scratch[8 * chunkBlocks * 8];
+		for (size_t i = 0; i < blockCount; i += chunkBlocks)
+		{
+			const size_t count = std::min(chunkBlocks, blockCount - i);
+			idctBlocks(coefficients + i * 64, quantTable, scratch, chunkBlocks * 8, count);
+			if (outputSize == 4)
+			{
+				boxDownscale8Rows<2>(scratch, chunkBlocks * 8, count * 8, out + i * 4, outStride);
+			}
+			else
+			{
+				boxDownscale8Rows<4>(scratch, chunkBlocks * 8, count * 8, out + i * 2, outStride);
+			}
+		}
+	}
+
+	void yccToRgbaRow(const uint8_t* y, const uint8_t* cb, const uint8_t* cr,
+		uint8_t* rgba, size_t width, uint32_t chromaShift) noexcept
+	{
+		yccToRgbaRow(activeBackend(), y, cb, cr, rgba, width, chromaShift);
+	}
+
+	void yccToRgbaRow(DspBackend backend, const uint8_t* y, const uint8_t* cb, const uint8_t* cr,
+		uint8_t* rgba, size_t width, uint32_t chromaShift) noexcept
+	{
+#if defined(SHINE_JPEG_DSP_X86)
+		if (backend == DspBackend::AVX2 && isBackendSupported(backend))
+		{
+			yccToRgbaAVX2(y, cb, cr, rgba, width, chromaShift);
+			return;
+		}
+		if (backend == DspBackend::SSE2 && isBackendSupported(backend))
+		{
+			yccToRgbaSSE2(y, cb, cr, rgba, width, chromaShift);
+			return;
+		}
+#endif
+		yccToRgbaScalar(y, cb, cr, rgba, 0, width, chromaShift);
+	}
+
+	void grayToRgbaRow(const uint8_t* y, uint8_t* rgba, size_t width) noexcept
+	{
+		for (size_t x = 0; x < width; ++x)
+		{
+			uint8_t* p = rgba + x * 4;
+			p[0] = p[1] = p[2] = y[x];
+			p[3] = 255;
+		}
+	}
+
+} // namespace shine::image::jpeg_dsp
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @file jpeg_dsp.h
+ * @brief JPEG 像素重建内核：反量化 + IDCT、YCbCr -> RGBA 行转换
+ *
+ * 提供标量参考实现与 SSE2 / AVX2 内核，运行时按 CPU 特性分派，所有内核与标量实现逐字节一致
+ * （见 test/JpegDspTest）。
+ *
+ * - IDCT：libjpeg jidctint 的整数算法（常数放大 4096 倍），反量化融合在载入系数时完成，
+ *   结果直接写入 8 位平面。SSE2 一次处理一个块（16 位乘加），AVX2 一次处理两个相邻块（每个 128 位通道一个块）。
+ *   缩放解码的 4x4 / 2x2 输出为完整 IDCT 结果的区域平均（在 L1 内的小缓冲上完成），1x1 只用 DC 系数。
+ * - 颜色转换：每行直接从 Y/Cb/Cr 平面写出 RGBA，色度水平 2:1 时在内核中复制色度样本，
+ *   不再生成全分辨率的色度平面。
+ *
+ * @see ISO/IEC 10918-1 A.3.3（IDCT）
+ * @see https://www.w3.org/Graphics/JPEG/jfif3.pdf（YCbCr -> RGB）
+ */
+
+namespace shine::image::jpeg_dsp
+{
+	/**
+	 * @brief 内核实现
+	 */
+	enum class DspBackend : uint8_t
+	{
+		Scalar = 0,  ///< 标量参考实现
+		SSE2,        ///< x86 SSE2
+		AVX2         ///< x86 AVX2（IDCT 两块一组，颜色转换 16 像素一组）
+	};
+
+	/**
+	 * @brief 当前 CPU 上选用的内核实现（首次调用时检测并缓存）
+	 */
+	DspBackend activeBackend() noexcept;
+
+	/**
+	 * @brief 检查指定内核在当前 CPU / 编译配置下是否可用
+	 */
+	bool isBackendSupported(DspBackend backend) noexcept;
+
+	/**
+	 * @brief 获取内核名称（用于日志与测试输出）
+	 */
+	const char* backendName(DspBackend backend) noexcept;
+
+	/**
+	 * @brief 反量化并 IDCT 一行相邻的 8x8 块（自动选择最快的可用内核）
+	 * @param coefficients 量化后的 DCT 系数，blockCount 个块连续存放，块内为自然顺序
+	 * @param quantTable 量化表（64 项，自然顺序）
+	 * @param out 第一个块左上角像素，第 i 个块写到 out + i * 8
+	 * @param outStride 输出行跨度（字节）
+	 * @param blockCount 块数
+	 */
+	void idctBlocks(const int16_t* coefficients, const uint16_t* quantTable,
+		uint8_t* out, size_t outStride, size_t blockCount) noexcept;
+
+	/**
+	 * @brief 使用指定内核反量化并 IDCT（内核不可用时回退到标量实现）
+	 */
+	void idctBlocks(DspBackend backend, const int16_t* coefficients, const uint16_t* quantTable,
+		uint8_t* out, size_t outStride, size_t blockCount) noexcept;
+
+	/**
+	 * @brief 缩小分辨率的反量化 + IDCT（用于 1/2、1/4、1/8 缩放解码）
+	 *
+	 * 每个 8x8 块输出 outputSize×outputSize 个像素，等于完整 IDCT 结果按 (8/outputSize)² 区域取平均
+	 * （与 libjpeg scale_denom 的效果相同）。1x1 只用 DC 系数；outputSize 为 8 时等同于 idctBlocks。
+	 * 不需要整幅全分辨率缓冲，每次只在栈上展开少量块。
+	 *
+	 * @param coefficients 量化后的 DCT 系数，blockCount 个块连续存放，块内为自然顺序
+	 * @param quantTable 量化表（64 项，自然顺序）
+	 * @param out 第一个块左上角像素，第 i 个块写到 out + i * outputSize
+	 * @param outStride 输出行跨度（字节）
+	 * @param blockCount 块数
+	 * @param outputSize 每个块输出的边长：8、4、2 或 1
+	 */
+	void idctBlocksReduced(const int16_t* coefficients, const uint16_t* quantTable,
+		uint8_t* out, size_t outStride, size_t blockCount, uint32_t outputSize) noexcept;
+
+	/**
+	 * @brief 将一行 YCbCr 转换为 RGBA（自动选择最快的可用内核）
+	 * @param y 亮度行（width 个样本）
+	 * @param cb Cb 行
+	 * @param cr Cr 行
+	 * @param rgba 输出（width * 4 字节）
+	 * @param width 像素数
+	 * @param chromaShift 色度水平下采样位移：0 表示与亮度同分辨率，1 表示 2:1（第 x 个像素取色度 x >> 1）
+	 */
+	void yccToRgbaRow(const uint8_t* y, const uint8_t* cb, const uint8_t* cr,
+		uint8_t* rgba, size_t width, uint32_t chromaShift) noexcept;
+
+	/**
+	 * @brief 使用指定内核转换一行 YCbCr（内核不可用时回退到标量实现）
+	 */
+	void yccToRgbaRow(DspBackend backend, const uint8_t* y, const uint8_t* cb, const uint8_t* cr,
+		uint8_t* rgba, size_t width, uint32_t chromaShift) noexcept;
+
+	/**
+	 * @brief 将一行灰度转换为 RGBA
+	 * @param y 灰度行
+	 * @param rgba 输出（width * 4 字节）
+	 * @param width 像素数
+	 */
+	void grayToRgbaRow(const uint8_t* y, uint8_t* rgba, size_t width) noexcept;
+
+} // namespace shine::image::jpeg_dsp
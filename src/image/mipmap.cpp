@@ -0,0 +1,434 @@
+#include "mipmap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "util/thread/task_group.h"
+
+#include "mipmap_dsp.h"
+
+/**
+ * @file mipmap.cpp
+ * @brief CPU mipmap 链生成实现
+ *
+ * 每一级的流程：
+ * 1. 为水平、垂直方向分别预计算抽头：目标像素 x 的中心映射到源坐标 (x + 0.5) * scale，
+ *    在 radius * scale 范围内对连续滤波核采样（盒式滤波按面积覆盖），越界下标 clamp 后把权重并入边缘像素，
+ *    最后归一化。同一级内所有像素的抽头数相同（不足的补零权重），便于 SIMD 内核处理；
+ * 2. 水平滤波所有源行到临时缓冲（第 0 级在这一步逐行转为线性 float），再对每个目标行做垂直滤波；
+ *    两步各自按行分片并行；
+ * 3. 目标行 clamp 到有效范围后留作下一级的输入，同时还原直通 Alpha、编码 sRGB 并量化为 RGBA8。
+ */
+
+namespace shine::image::mip
+{
+	namespace
+	{
+		constexpr double kPi = 3.14159265358979323846;
+
+		/// Kaiser 窗的形状参数
+		constexpr double kKaiserAlpha = 4.0;
+
+		/// sRGB 编码表的精度：线性值量化为 14 位后查表，往返 8 位值保持不变
+		constexpr uint32_t kEncodeTableSize = 1u << 14;
+
+		/// 滤波核半径（以目标像素为单位）
+		double filterRadius(MipFilter filter) noexcept
+		{
+			switch (filter)
+			{
+			case MipFilter::Box: return 0.5;
+			case MipFilter::Kaiser: return 3.0;
+			case MipFilter::Lanczos: return 3.0;
+			}
+			return 0.5;
+		}
+
+		double sinc(double x) noexcept
+		{
+			if (std::abs(x) < 1e-9)
+			{
+				return 1.0;
+			}
+			return std::sin(kPi * x) / (kPi * x);
+		}
+
+		/// 第一类零阶修正贝塞尔函数（级数展开）
+		double besselI0(double x) noexcept
+		{
+			double sum = 1.0;
+			double term = 1.0;
+			const double q = x * x * 0.25;
+			for (int k = 1; k < 32 && term > sum * 1e-12; ++k)
+			{
+				term *= q / (static_cast<double>(k) * k);
+				sum += term;
+			}
+			return sum;
+		}
+
+		/// 连续滤波核在 t（目标像素单位）处的值
+		double kernelValue(MipFilter filter, double t) noexcept
+		{
+			const double radius = filterRadius(filter);
+			if (std::abs(t) >= radius)
+			{
+				return 0.0;
+			}
+			switch (filter)
+			{
+			case MipFilter::Kaiser:
+			{
+				const double r = t / radius;
+				return sinc(t) * besselI0(kKaiserAlpha * std::sqrt(1.0 - r * r)) / besselI0(kKaiserAlpha);
+			}
+			case MipFilter::Lanczos:
+				return sinc(t) * sinc(t / radius);
+			default:
+				return 1.0;
+			}
+		}
+
+		/**
+		 * @brief 一个方向上的重采样抽头
+		 */
+		struct Taps
+		{
+			uint32_t count = 0;             ///< 每个目标像素的抽头数
+			std::vector<uint32_t> starts;   ///< 每个目标像素的第一个源下标
+			std::vector<float> weights;     ///< dstSize * count 个权重
+		};
+
+		Taps buildTaps(uint32_t srcSize, uint32_t dstSize, MipFilter filter)
+		{
+			const double scale = static_cast<double>(srcSize) / dstSize;
+			const double support = filterRadius(filter) * scale;
+
+			// 先按实际覆盖范围计算每个目标像素的权重，再统一抽头数
+			std::vector<uint32_t> firsts(dstSize);
+			std::vector<std::vector<double>> perPixel(dstSize);
+			uint32_t maxCount = 1;
+			for (uint32_t x = 0; x < dstSize; ++x)
+			{
+				const double center = (x + 0.5) * scale;
+				const int64_t lo = static_cast<int64_t>(std::floor(center - support));
+				const int64_t hi = static_cast<int64_t>(std::ceil(center + support));
+				const int64_t clampedLo = std::clamp<int64_t>(lo, 0, srcSize - 1);
+				const int64_t clampedHi = std::clamp<int64_t>(hi - 1, 0, srcSize - 1);
+
+				std::vector<double> w(static_cast<size_t>(clampedHi - clampedLo + 1), 0.0);
+				for (int64_t i = lo; i < hi; ++i)
+				{
+					double value;
+					if (filter == MipFilter::Box)
+					{
+						// 源像素 [i, i + 1] 与目标像素覆盖区间的重叠长度
+						value = std::max(0.0, std::min<double>(i + 1, center + support) - std::max<double>(i, center - support));
+					}
+					else
+					{
+						value = kernelValue(filter, (i + 0.5 - center) / scale);
+					}
+					w[static_cast<size_t>(std::clamp<int64_t>(i, 0, srcSize - 1) - clampedLo)] += value;
+				}
+
+				// 去掉两端的零权重
+				size_t begin = 0;
+				size_t end = w.size();
+				while (begin + 1 < end && w[begin] == 0.0) ++begin;
+				while (end > begin + 1 && w[end - 1] == 0.0) --end;
+
+				double sum = 0.0;
+				for (size_t i = begin; i < end; ++i) sum += w[i];
+				perPixel[x].assign(w.begin() + begin, w.begin() + end);
+				for (double& v : perPixel[x]) v = sum != 0.0 ? v / sum : 1.0 / perPixel[x].size();
+				firsts[x] = static_cast<uint32_t>(clampedLo + begin);
+				maxCount = std::max<uint32_t>(maxCount, static_cast<uint32_t>(perPixel[x].size()));
+			}
+
+			Taps taps;
+			taps.count = std::min(maxCount, srcSize);
+			taps.starts.resize(dstSize);
+			taps.weights.assign(static_cast<size_t>(dstSize) * taps.count, 0.0f);
+			for (uint32_t x = 0; x < dstSize; ++x)
+			{
+				// 靠近末尾的像素整体左移窗口，保证 start + count 不越界
+				const uint32_t start = std::min(firsts[x], srcSize - taps.count);
+				taps.starts[x] = start;
+				float* dst = taps.weights.data() + static_cast<size_t>(x) * taps.count + (firsts[x] - start);
+				for (double v : perPixel[x])
+				{
+					*dst++ = static_cast<float>(v);
+				}
+			}
+			return taps;
+		}
+
+		// ============================================================================
+		// sRGB 转换
+		// ============================================================================
+
+		struct SrgbTables
+		{
+			float decode[256];
+			uint8_t encode[kEncodeTableSize];
+		};
+
+		const SrgbTables& srgbTables() noexcept
+		{
+			static const SrgbTables tables = []
+			{
+				SrgbTables t{};
+				for (int i = 0; i < 256; ++i)
+				{
+					const double c = i / 255.0;
+					t.decode[i] = static_cast<float>(c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+				}
+				for (uint32_t i = 0; i < kEncodeTableSize; ++i)
+				{
+					const double l = static_cast<double>(i) / (kEncodeTableSize - 1);
+					const double c = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+					t.encode[i] = static_cast<uint8_t>(std::lround(std::clamp(c, 0.0, 1.0) * 255.0));
+				}
+				return t;
+			}();
+			return tables;
+		}
+
+		inline uint8_t quantizeUnorm(float v) noexcept
+		{
+			return static_cast<uint8_t>(v * 255.0f + 0.5f);
+		}
+
+		// ============================================================================
+		// 每级的处理
+		// ============================================================================
+
+		struct ChainJob
+		{
+			const MipOptions* options;
+			const SrgbTables* tables;
+			const mip_dsp::DspKernels* kernels;
+
+			/// 第 0 级的一行转为线性（预乘）float
+			void loadRow(const uint8_t* s, uint32_t width, float* d) const noexcept
+			{
+				for (uint32_t x = 0; x < width; ++x, s += 4, d += 4)
+				{
+					const float a = s[3] * (1.0f / 255.0f);
+					const float scale = options->premultiplyAlpha ? a : 1.0f;
+					for (int c = 0; c < 3; ++c)
+					{
+						d[c] = (options->srgb ? tables->decode[s[c]] : s[c] * (1.0f / 255.0f)) * scale;
+					}
+					d[3] = a;
+				}
+			}
+
+			/// clamp 到有效范围（原地，供下一级使用）并写出 RGBA8
+			void storeRow(float* row, uint8_t* out, uint32_t width) const noexcept
+			{
+				for (uint32_t x = 0; x < width; ++x, row += 4, out += 4)
+				{
+					const float a = std::clamp(row[3], 0.0f, 1.0f);
+					row[3] = a;
+					out[3] = quantizeUnorm(a);
+					const float limit = options->premultiplyAlpha ? a : 1.0f;
+					const float unpremultiply = options->premultiplyAlpha ? (a > 0.0f ? 1.0f / a : 0.0f) : 1.0f;
+					for (int c = 0; c < 3; ++c)
+					{
+						const float v = std::clamp(row[c], 0.0f, limit);
+						row[c] = v;
+						const float straight = std::min(v * unpremultiply, 1.0f);
+						out[c] = options->srgb
+							? tables->encode[static_cast<uint32_t>(straight * (kEncodeTableSize - 1) + 0.5f)]
+							: quantizeUnorm(straight);
+					}
+				}
+			}
+		};
+
+		bool useThreads(const MipOptions& options, uint32_t width, uint32_t height) noexcept
+		{
+#if !defined(SHINE_PLATFORM_WASM) && !defined(__EMSCRIPTEN__)
+			return options.parallel && height > 1 &&
+				static_cast<size_t>(width) * height >= options.parallelMinPixels &&
+				util::ThreadPool::Get().GetThreadCount() > 0;
+#else
+			(void)options;
+			(void)width;
+			(void)height;
+			return false;
+#endif
+		}
+
+		/**
+		 * @brief 把 [0, rowCount) 分成若干连续行段执行 fn(firstRow, lastRow)
+		 *
+		 * 每个线程约 4 个任务；各行段写入互不重叠的区域，结果与串行相同
+		 */
+		template <typename Fn>
+		void forEachRowBand(uint32_t rowCount, bool parallel, const Fn& fn)
+		{
+			if (!parallel)
+			{
+				fn(0u, rowCount);
+				return;
+			}
+
+#if !defined(SHINE_PLATFORM_WASM) && !defined(__EMSCRIPTEN__)
+			struct Bands
+			{
+				const Fn* fn;
+				uint32_t rowCount;
+				uint32_t rowsPerTask;
+			};
+			const uint32_t threadCount = util::ThreadPool::Get().GetThreadCount() + 1;
+			const uint32_t rowsPerTask = std::max<uint32_t>(1, (rowCount + threadCount * 4 - 1) / (threadCount * 4));
+			const uint32_t taskCount = (rowCount + rowsPerTask - 1) / rowsPerTask;
+			Bands bands{ &fn, rowCount, rowsPerTask };
+
+			util::TaskGroup group(taskCount, [](void* userdata, u32 task)
+			{
+				const auto& b = *static_cast<const Bands*>(userdata);
+				const uint32_t firstRow = task * b.rowsPerTask;
+				(*b.fn)(firstRow, std::min(b.rowCount, firstRow + b.rowsPerTask));
+			}, &bands);
+			for (uint32_t task = 0; task < taskCount; ++task)
+			{
+				group.Submit(task);
+			}
+			group.Wait();
+#endif
+		}
+	} // namespace
+
+	uint32_t mipLevelCount(uint32_t width, uint32_t height) noexcept
+	{
+		uint32_t size = std::max(width, height);
+		uint32_t levels = 1;
+		while (size > 1)
+		{
+			size >>= 1;
+			++levels;
+		}
+		return levels;
+	}
+
+	const char* filterName(MipFilter filter) noexcept
+	{
+		switch (filter)
+		{
+		case MipFilter::Box: return "Box";
+		case MipFilter::Kaiser: return "Kaiser";
+		case MipFilter::Lanczos: return "Lanczos";
+		}
+		return "Unknown";
+	}
+
+	std::expected<MipChain, std::string> buildMipChain(const uint8_t* rgba, uint32_t width, uint32_t height,
+		size_t rgbaStride, const MipOptions& options)
+	{
+		if (!rgba)
+		{
+			return std::unexpected("mipmap: null buffer");
+		}
+		if (width == 0 || height == 0)
+		{
+			return std::unexpected("mipmap: empty image");
+		}
+		if (rgbaStride < static_cast<size_t>(width) * 4)
+		{
+			return std::unexpected("mipmap: stride is smaller than a row");
+		}
+
+		uint32_t levelCount = mipLevelCount(width, height);
+		if (options.maxLevels != 0)
+		{
+			levelCount = std::min(levelCount, options.maxLevels);
+		}
+
+		MipChain chain;
+		size_t totalBytes = 0;
+		for (uint32_t level = 1, w = width, h = height; level < levelCount; ++level)
+		{
+			w = std::max(1u, w >> 1);
+			h = std::max(1u, h >> 1);
+			const size_t bytes = static_cast<size_t>(w) * h * 4;
+			chain.levels.push_back({ w, h, totalBytes, bytes });
+			totalBytes += bytes;
+		}
+		if (chain.levels.empty())
+		{
+			return chain;
+		}
+		chain.data.resize(totalBytes);
+
+		const ChainJob job{ &options, &srgbTables(), &mip_dsp::kernels() };
+
+		// 第 0 级不整体转换为 float：水平滤波时逐行转换，省去一份 16 字节 / 像素的缓冲
+		std::vector<float> src;
+		std::vector<float> horizontal;
+		std::vector<float> dst;
+		uint32_t srcWidth = width;
+		uint32_t srcHeight = height;
+		for (const MipLevel& level : chain.levels)
+		{
+			const Taps hTaps = buildTaps(srcWidth, level.width, options.filter);
+			const Taps vTaps = buildTaps(srcHeight, level.height, options.filter);
+			const bool parallel = useThreads(options, srcWidth, srcHeight);
+			const bool fromBase = src.empty();
+
+			// 水平：源行 -> 临时行（宽度已缩小）
+			horizontal.resize(static_cast<size_t>(level.width) * srcHeight * 4);
+			forEachRowBand(srcHeight, parallel, [&](uint32_t firstRow, uint32_t lastRow)
+			{
+				std::vector<float> baseRow(fromBase ? static_cast<size_t>(srcWidth) * 4 : 0);
+				for (uint32_t y = firstRow; y < lastRow; ++y)
+				{
+					const float* row = src.data() + static_cast<size_t>(y) * srcWidth * 4;
+					if (fromBase)
+					{
+						job.loadRow(rgba + static_cast<size_t>(y) * rgbaStride, width, baseRow.data());
+						row = baseRow.data();
+					}
+					job.kernels->resampleRow(row, horizontal.data() + static_cast<size_t>(y) * level.width * 4,
+						level.width, hTaps.starts.data(), hTaps.weights.data(), hTaps.count);
+				}
+			});
+
+			// 垂直：临时行 -> 目标行，随后写出 RGBA8
+			dst.resize(static_cast<size_t>(level.width) * level.height * 4);
+			uint8_t* out = chain.data.data() + level.offset;
+			forEachRowBand(level.height, parallel, [&](uint32_t firstRow, uint32_t lastRow)
+			{
+				std::vector<const float*> rows(vTaps.count);
+				const size_t rowFloats = static_cast<size_t>(level.width) * 4;
+				for (uint32_t y = firstRow; y < lastRow; ++y)
+				{
+					for (uint32_t k = 0; k < vTaps.count; ++k)
+					{
+						rows[k] = horizontal.data() + (vTaps.starts[y] + k) * rowFloats;
+					}
+					float* row = dst.data() + y * rowFloats;
+					job.kernels->blendRows(rows.data(), vTaps.weights.data() + static_cast<size_t>(y) * vTaps.count,
+						vTaps.count, row, rowFloats);
+					job.storeRow(row, out + y * rowFloats, level.width);
+				}
+			});
+
+			src.swap(dst);
+			srcWidth = level.width;
+			srcHeight = level.height;
+		}
+		return chain;
+	}
+
+	std::expected<MipChain, std::string> buildMipChain(const uint8_t* rgba, uint32_t width, uint32_t height,
+		const MipOptions& options)
+	{
+		return buildMipChain(rgba, width, height, static_cast<size_t>(width) * 4, options);
+	}
+
+} // namespace shine::image::mip
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <expected>
+
+/**
+ * @file mipmap.h
+ * @brief CPU 端 mipmap 链生成（用于离线烘焙与按级流式上传，替代驱动的 glGenerateMipmap）
+ *
+ * 每一级都由上一级缩小一半（向下取整，最小为 1）得到，直到 1x1：
+ * - 滤波在线性空间进行：sRGB 颜色先解码为线性值，输出时再编码，避免直接平均 sRGB 值导致的变暗；
+ * - 按预乘 Alpha 滤波，透明像素的颜色不会渗入相邻的不透明像素，输出时再还原为直通 Alpha；
+ * - 可分离滤波：先水平后垂直，边缘按 clamp 寻址；非偶数尺寸按实际缩放比例计算权重。
+ *
+ * 整条链在 float 精度下逐级计算，只在写出每一级时量化为 RGBA8，量化误差不会逐级累积。
+ * 行内的乘加由 mipmap_dsp 的 SIMD 内核完成，每一级按行分片到 util::ThreadPool 并行，结果与串行完全相同。
+ */
+
+namespace shine::image::mip
+{
+	/**
+	 * @brief 降采样滤波器
+	 */
+	enum class MipFilter : uint8_t
+	{
+		Box,      ///< 盒式滤波（按面积覆盖加权，2 倍缩小时为 2x2 平均）
+		Kaiser,   ///< Kaiser 窗 sinc（半径 3，alpha = 4），锐利且振铃较轻
+		Lanczos   ///< Lanczos3，最锐利，振铃略多
+	};
+
+	/**
+	 * @brief 生成选项
+	 */
+	struct MipOptions
+	{
+		MipFilter filter = MipFilter::Kaiser;
+		bool srgb = true;                       ///< 颜色通道为 sRGB 编码（法线、遮罩等数据纹理应关闭）
+		bool premultiplyAlpha = true;           ///< 按预乘 Alpha 滤波（输入输出均为直通 Alpha）
+		uint32_t maxLevels = 0;                 ///< 最多生成的级数（含第 0 级），0 表示完整链
+		bool parallel = true;                   ///< 按行分片到线程池并行
+		uint32_t parallelMinPixels = 256 * 256; ///< 源级像素数低于该值时串行处理
+	};
+
+	/**
+	 * @brief 一级 mip 在 MipChain::data 中的位置
+	 */
+	struct MipLevel
+	{
+		uint32_t width = 0;
+		uint32_t height = 0;
+		size_t offset = 0;  ///< 字节偏移
+		size_t size = 0;    ///< 字节数（width * height * 4）
+	};
+
+	/**
+	 * @brief 第 1 级起的 mip 链（第 0 级即原图，不重复保存）
+	 */
+	struct MipChain
+	{
+		std::vector<MipLevel> levels;  ///< levels[0] 为第 1 级，依次减半到 1x1
+		std::vector<uint8_t> data;     ///< 各级紧密排列的 RGBA8
+
+		bool empty() const noexcept { return levels.empty(); }
+		const uint8_t* levelData(size_t index) const noexcept { return data.data() + levels[index].offset; }
+	};
+
+	/**
+	 * @brief 完整 mip 链的级数（含第 0 级），即 floor(log2(max(width, height))) + 1
+	 */
+	uint32_t mipLevelCount(uint32_t width, uint32_t height) noexcept;
+
+	/**
+	 * @brief 滤波器名称（用于日志与测试输出）
+	 */
+	const char* filterName(MipFilter filter) noexcept;
+
+	/**
+	 * @brief 生成 mip 链
+	 * @param rgba 第 0 级图像（直通 Alpha 的 RGBA8）
+	 * @param width 宽度
+	 * @param height 高度
+	 * @param rgbaStride 源行跨度（字节）
+	 * @param options 生成选项
+	 * @return 第 1 级起的 mip 链（1x1 图像或 maxLevels == 1 时为空），失败返回错误信息
+	 */
+	std::expected<MipChain, std::string> buildMipChain(const uint8_t* rgba, uint32_t width, uint32_t height,
+		size_t rgbaStride, const MipOptions& options = {});
+
+	/**
+	 * @brief 生成紧密排列图像的 mip 链
+	 */
+	std::expected<MipChain, std::string> buildMipChain(const uint8_t* rgba, uint32_t width, uint32_t height,
+		const MipOptions& options = {});
+
+} // namespace shine::image::mip
@@ -0,0 +1,222 @@
+#include "mipmap_dsp.h"
+
+#if !defined(__EMSCRIPTEN__) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define SHINE_MIP_DSP_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要按函数开启指令集，MSVC 的 intrinsic 不依赖编译选项
+#if defined(SHINE_MIP_DSP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SHINE_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define SHINE_TARGET_SSE2
+#endif
+
+/**
+ * @file mipmap_dsp.cpp
+ * @brief Mipmap 重采样内核实现
+ *
+ * 标量版本按"抽头在外、通道在内"的顺序逐个乘加，SSE2 版本对 4 个通道同时做同样的乘加，
+ * 两者不使用 FMA，逐元素的舍入顺序一致。
+ */
+
+namespace shine::image::mip_dsp
+{
+	namespace
+	{
+		// ============================================================================
+		// 标量参考实现
+		// ============================================================================
+
+		void resampleRowScalar(const float* src, float* dst, uint32_t dstWidth,
+			const uint32_t* starts, const float* weights, uint32_t taps)
+		{
+			for (uint32_t x = 0; x < dstWidth; ++x, weights += taps, dst += 4)
+			{
+				const float* s = src + static_cast<size_t>(starts[x]) * 4;
+				float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+				for (uint32_t k = 0; k < taps; ++k, s += 4)
+				{
+					const float w = weights[k];
+					r += w * s[0];
+					g += w * s[1];
+					b += w * s[2];
+					a += w * s[3];
+				}
+				dst[0] = r;
+				dst[1] = g;
+				dst[2] = b;
+				dst[3] = a;
+			}
+		}
+
+		void blendRowsScalar(const float* const* rows, const float* weights, uint32_t taps, float* dst, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				float sum = 0.0f;
+				for (uint32_t k = 0; k < taps; ++k)
+				{
+					sum += weights[k] * rows[k][i];
+				}
+				dst[i] = sum;
+			}
+		}
+
+		constexpr DspKernels kScalarKernels = {
+			resampleRowScalar,
+			blendRowsScalar,
+		};
+
+#if defined(SHINE_MIP_DSP_X86)
+		// ============================================================================
+		// SSE2
+		// ============================================================================
+
+		SHINE_TARGET_SSE2 void resampleRowSSE2(const float* src, float* dst, uint32_t dstWidth,
+			const uint32_t* starts, const float* weights, uint32_t taps)
+		{
+			// 两个目标像素交错累加，隐藏加法延迟
+			uint32_t x = 0;
+			for (; x + 2 <= dstWidth; x += 2, weights += taps * 2, dst += 8)
+			{
+				const float* s0 = src + static_cast<size_t>(starts[x]) * 4;
+				const float* s1 = src + static_cast<size_t>(starts[x + 1]) * 4;
+				const float* w1 = weights + taps;
+				__m128 acc0 = _mm_setzero_ps();
+				__m128 acc1 = _mm_setzero_ps();
+				for (uint32_t k = 0; k < taps; ++k, s0 += 4, s1 += 4)
+				{
+					acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(s0)));
+					acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_set1_ps(w1[k]), _mm_loadu_ps(s1)));
+				}
+				_mm_storeu_ps(dst, acc0);
+				_mm_storeu_ps(dst + 4, acc1);
+			}
+			for (; x < dstWidth; ++x, weights += taps, dst += 4)
+			{
+				const float* s = src + static_cast<size_t>(starts[x]) * 4;
+				__m128 acc = _mm_setzero_ps();
+				for (uint32_t k = 0; k < taps; ++k, s += 4)
+				{
+					acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(s)));
+				}
+				_mm_storeu_ps(dst, acc);
+			}
+		}
+
+		SHINE_TARGET_SSE2 void blendRowsSSE2(const float* const* rows, const float* weights, uint32_t taps,
+			float* dst, size_t count)
+		{
+			// 一次处理两个像素，减少权重广播与循环开销
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m128 acc0 = _mm_setzero_ps();
+				__m128 acc1 = _mm_setzero_ps();
+				for (uint32_t k = 0; k < taps; ++k)
+				{
+					const __m128 w = _mm_set1_ps(weights[k]);
+					acc0 = _mm_add_ps(acc0, _mm_mul_ps(w, _mm_loadu_ps(rows[k] + i)));
+					acc1 = _mm_add_ps(acc1, _mm_mul_ps(w, _mm_loadu_ps(rows[k] + i + 4)));
+				}
+				_mm_storeu_ps(dst + i, acc0);
+				_mm_storeu_ps(dst + i + 4, acc1);
+			}
+			for (; i < count; i += 4)
+			{
+				__m128 acc = _mm_setzero_ps();
+				for (uint32_t k = 0; k < taps; ++k)
+				{
+					acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(rows[k] + i)));
+				}
+				_mm_storeu_ps(dst + i, acc);
+			}
+		}
+
+		constexpr DspKernels kSSE2Kernels = {
+			resampleRowSSE2,
+			blendRowsSSE2,
+		};
+
+		// ============================================================================
+		// 运行时检测
+		// ============================================================================
+
+		bool cpuHasSSE2() noexcept
+		{
+#if defined(__x86_64__) || defined(_M_X64)
+			return true; // x86-64 基线
+#elif defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 1);
+			return (info[3] & (1 << 26)) != 0;
+#else
+			return __builtin_cpu_supports("sse2");
+#endif
+		}
+#endif // SHINE_MIP_DSP_X86
+
+		DspBackend detectBackend() noexcept
+		{
+#if defined(SHINE_MIP_DSP_X86)
+			if (cpuHasSSE2())
+			{
+				return DspBackend::SSE2;
+			}
+#endif
+			return DspBackend::Scalar;
+		}
+	} // namespace
+
+	DspBackend activeBackend() noexcept
+	{
+		static const DspBackend backend = detectBackend();
+		return backend;
+	}
+
+	bool isBackendSupported(DspBackend backend) noexcept
+	{
+		switch (backend)
+		{
+		case DspBackend::Scalar:
+			return true;
+#if defined(SHINE_MIP_DSP_X86)
+		case DspBackend::SSE2:
+			return cpuHasSSE2();
+#endif
+		default:
+			return false;
+		}
+	}
+
+	const char* backendName(DspBackend backend) noexcept
+	{
+		switch (backend)
+		{
+		case DspBackend::Scalar: return "Scalar";
+		case DspBackend::SSE2: return "SSE2";
+		}
+		return "Unknown";
+	}
+
+	const DspKernels& kernels() noexcept
+	{
+		return kernels(activeBackend());
+	}
+
+	const DspKernels& kernels(DspBackend backend) noexcept
+	{
+#if defined(SHINE_MIP_DSP_X86)
+		if (backend == DspBackend::SSE2 && isBackendSupported(backend))
+		{
+			return kSSE2Kernels;
+		}
+#endif
+		return kScalarKernels;
+	}
+
+} // namespace shine::image::mip_dsp
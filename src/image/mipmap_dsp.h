@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @file mipmap_dsp.h
+ * @brief Mipmap 重采样内核：以线性空间的 RGBA float 像素为单位做可分离滤波
+ *
+ * 每个像素的 4 个通道正好是一个 128 位向量，因此水平方向按像素展开，
+ * 每个抽头一次乘加整个像素；垂直方向把若干行按权重逐元素相加。
+ * 提供标量参考实现与 SSE2 内核，运行时按 CPU 特性分派；两者的运算顺序相同（见 test/MipmapTest）。
+ */
+
+namespace shine::image::mip_dsp
+{
+	/**
+	 * @brief 内核实现
+	 */
+	enum class DspBackend : uint8_t
+	{
+		Scalar = 0,  ///< 标量参考实现
+		SSE2         ///< x86 SSE2
+	};
+
+	/**
+	 * @brief 当前 CPU 上选用的内核实现（首次调用时检测并缓存）
+	 */
+	DspBackend activeBackend() noexcept;
+
+	/**
+	 * @brief 检查指定内核在当前 CPU / 编译配置下是否可用
+	 */
+	bool isBackendSupported(DspBackend backend) noexcept;
+
+	/**
+	 * @brief 获取内核名称（用于日志与测试输出）
+	 */
+	const char* backendName(DspBackend backend) noexcept;
+
+	/**
+	 * @brief 一组内核函数
+	 */
+	struct DspKernels
+	{
+		/**
+		 * @brief 水平重采样一行
+		 * @param src 源行（RGBA float 像素）
+		 * @param dst 目标行（dstWidth 个 RGBA float 像素）
+		 * @param dstWidth 目标像素数
+		 * @param starts 每个目标像素的第一个源像素下标
+		 * @param weights 每个目标像素 taps 个权重（dstWidth * taps）
+		 * @param taps 每个目标像素的抽头数
+		 */
+		void (*resampleRow)(const float* src, float* dst, uint32_t dstWidth,
+			const uint32_t* starts, const float* weights, uint32_t taps);
+
+		/**
+		 * @brief 垂直方向：dst[i] = Σ weights[k] * rows[k][i]
+		 * @param rows taps 个源行指针
+		 * @param weights taps 个权重
+		 * @param taps 行数
+		 * @param dst 目标行
+		 * @param count 每行的 float 数（4 的倍数）
+		 */
+		void (*blendRows)(const float* const* rows, const float* weights, uint32_t taps, float* dst, size_t count);
+	};
+
+	/**
+	 * @brief 当前 CPU 上最快的内核
+	 */
+	const DspKernels& kernels() noexcept;
+
+	/**
+	 * @brief 指定实现的内核（不可用时回退到标量实现）
+	 */
+	const DspKernels& kernels(DspBackend backend) noexcept;
+
+} // namespace shine::image::mip_dsp
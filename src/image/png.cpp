@@ -1,4 +1,5 @@
 #include "png.h"
+#include "png_filter.h"
 
 #include <array>
 #include <algorithm>
@@ -18,12 +19,16 @@
 
 #include "shine_define.h"
 #include "util/timer/function_timer.h"
+#include "util/thread/task_group.h"
 #include "util/file_util.ixx"
 
 #include "util/encoding/byte_convert.ixx"
 #include "util/encoding/bit_reader.ixx"
 #include "util/encoding/huffman_tree.h"
 #include "util/encoding/huffman_decoder.h"
+#include "util/encoding/deflate_tables.h"
+#include "util/encoding/inflate.h"
+#include "util/encoding/deflate.h"
 #include "string/shine_string.h"
 
 
@@ -107,6 +112,12 @@ namespace shine::image
 	static constexpr std::array EXIF{ std::byte{'e'}, std::byte{'X'}, std::byte{'I'}, std::byte{'F'} };  ///< EXIF 块
 	static constexpr std::array SBIT{ std::byte{'s'}, std::byte{'B'}, std::byte{'I'}, std::byte{'T'} };  ///< 有效位深度块
 
+	/// Adam7 交织参数
+	static constexpr uint32_t ADAM7_IX[7] = { 0, 4, 0, 2, 0, 1, 0 }; ///< x 起始位置
+	static constexpr uint32_t ADAM7_IY[7] = { 0, 0, 4, 0, 2, 0, 1 }; ///< y 起始位置
+	static constexpr uint32_t ADAM7_DX[7] = { 8, 8, 4, 4, 2, 2, 1 }; ///< x 步长
+	static constexpr uint32_t ADAM7_DY[7] = { 8, 8, 8, 4, 4, 2, 2 }; ///< y 步长
+
 	// ============================================================================
 	// 辅助函数
 	// ============================================================================
@@ -1377,11 +1388,27 @@ namespace shine::image
 			return std::unexpected("图像尺寸无效");
 		}
 
-		// 1. Zlib 解压缩 IDAT 数据
+		// 1. Zlib 解压缩 IDAT 数据（解压大小可由图像头精确算出，一次分配到位）
+		size_t expectedRawSize = static_cast<size_t>(_height) * (scanlineBytes(_width) + 1);
+		if (interlaceMethod == 1)
+		{
+			expectedRawSize = 0;
+			for (int pass = 0; pass < 7; ++pass)
+			{
+				const uint32_t passWidth = (_width + ADAM7_DX[pass] - ADAM7_IX[pass] - 1) / ADAM7_DX[pass];
+				const uint32_t passHeight = (_height + ADAM7_DY[pass] - ADAM7_IY[pass] - 1) / ADAM7_DY[pass];
+				if (passWidth != 0 && passHeight != 0)
+				{
+					expectedRawSize += static_cast<size_t>(passHeight) * (scanlineBytes(passWidth) + 1);
+				}
+			}
+		}
+
 		std::expected<std::vector<uint8_t>, std::string> decompressedResult;
 		{
 			util::FunctionTimer timer1("PNG解码: Zlib解压缩", util::TimerPrecision::Milliseconds);
-			decompressedResult = zlibDecompress(idatData);
+			// 期望大小同时作为上限：超出的流直接拒绝
+			decompressedResult = zlibDecompress(idatData, expectedRawSize, expectedRawSize);
 		}
 		if (!decompressedResult.has_value())
 		{
@@ -1391,41 +1418,24 @@ namespace shine::image
 		auto& decompressed = decompressedResult.value();
 		
 		// 2. 计算每像素字节数（仅用于滤波器，低位深度按位计算）
-		size_t bytesPerPixel = 0;
-		switch (colorType)
+		const size_t bytesPerPixel = filterBytesPerPixel();
+		if (bytesPerPixel == 0)
 		{
-		case PngColorType::GERY:
-			bytesPerPixel = (bitDepth == 16) ? 2 : ((bitDepth >= 8) ? 1 : 1);
-			break;
-		case PngColorType::RGB:
-			bytesPerPixel = (bitDepth == 16) ? 6 : ((bitDepth >= 8) ? 3 : 1);
-			break;
-		case PngColorType::PALETTE:
-			bytesPerPixel = 1; // 调色板总是1字节索引，但实际位深度可能小于8
-			break;
-		case PngColorType::GERY_ALPHA:
-			bytesPerPixel = (bitDepth == 16) ? 4 : ((bitDepth >= 8) ? 2 : 1);
-			break;
-		case PngColorType::RGBA:
-			bytesPerPixel = (bitDepth == 16) ? 8 : ((bitDepth >= 8) ? 4 : 1);
-			break;
-		default:
 			return std::unexpected("不支持的颜色类型");
 		}
 		
-		// 3. 计算扫描线宽度（包括滤波器字节）
-		// 对于低位深度，需要按位计算；对于8位及以上，按字节计算
-		size_t scanlineWidth = 0;
-		if (bitDepth >= 8)
-		{
-			scanlineWidth = _width * bytesPerPixel;
-		}
-		else
+		// 3. 计算扫描线宽度（不含滤波器字节）
+		const size_t scanlineWidth = scanlineBytes(_width);
+		
+#if !defined(SHINE_PLATFORM_WASM) && !defined(__EMSCRIPTEN__)
+		// 大图像可选多线程路径：解滤波与 RGBA 转换流水线并行
+		if (_parallelDecode && static_cast<size_t>(_width) * _height >= _parallelMinPixels &&
+			util::ThreadPool::Get().GetThreadCount() > 1)
 		{
-			// 对于低位深度，扫描线宽度 = ceil(width * bitDepth / 8)
-			// PNG 规范：扫描线必须向上取整到字节边界
-			scanlineWidth = ((_width * bitDepth) + 7) / 8;
+			util::FunctionTimer timer("PNG解码: 多线程解滤波+转换", util::TimerPrecision::Milliseconds);
+			return decodeParallel(decompressed, bytesPerPixel, scanlineWidth);
 		}
+#endif
 		
 		// 4. 处理交织（Adam7 或非交织）
 		std::vector<uint8_t> unfilteredData;
@@ -1521,6 +1531,270 @@ namespace shine::image
 		return {};
 	}
 
+	size_t png::filterBytesPerPixel() const noexcept
+	{
+		switch (colorType)
+		{
+		case PngColorType::GERY:
+		case PngColorType::PALETTE: // 调色板总是1字节索引，但实际位深度可能小于8
+			return (bitDepth == 16) ? 2 : 1;
+		case PngColorType::RGB:
+			return (bitDepth == 16) ? 6 : 3;
+		case PngColorType::GERY_ALPHA:
+			return (bitDepth == 16) ? 4 : 2;
+		case PngColorType::RGBA:
+			return (bitDepth == 16) ? 8 : 4;
+		default:
+			return 0;
+		}
+	}
+
+	size_t png::scanlineBytes(uint32_t width) const noexcept
+	{
+		// 对于低位深度，扫描线宽度 = ceil(width * bitDepth / 8)
+		// PNG 规范：扫描线必须向上取整到字节边界
+		if (bitDepth < 8)
+		{
+			return (static_cast<size_t>(width) * bitDepth + 7) / 8;
+		}
+		return static_cast<size_t>(width) * filterBytesPerPixel();
+	}
+
+	// ============================================================================
+	// 多线程解码
+	// ============================================================================
+
+	std::expected<void, std::string> png::decodeParallel(
+		std::span<const uint8_t> decompressed, size_t bytesPerPixel, size_t scanlineWidth)
+	{
+		const uint32_t height = _height;
+		const size_t rgbaStride = static_cast<size_t>(_width) * 4;
+
+		// 行带大小：每个工作线程约 4 个行带，兼顾负载均衡与调度开销
+		const uint32_t threadCount = util::ThreadPool::Get().GetThreadCount() + 1;
+		const uint32_t bandRows = std::max<uint32_t>(16, (height + threadCount * 4 - 1) / (threadCount * 4));
+		const uint32_t bandCount = (height + bandRows - 1) / bandRows;
+
+		imageData.assign(rgbaStride * height, 0);
+
+		if (interlaceMethod == 0)
+		{
+			std::vector<uint8_t> unfiltered(static_cast<size_t>(height) * scanlineWidth);
+
+			struct ConvertContext
+			{
+				const png* self;
+				const uint8_t* rows;
+				size_t rowStride;
+				uint8_t* rgba;
+				size_t rgbaStride;
+				uint32_t bandRows;
+				uint32_t height;
+			} ctx{ this, unfiltered.data(), scanlineWidth, imageData.data(), rgbaStride, bandRows, height };
+
+			// 生产者每完成一个行带就提交，工作线程只读取已完成的行
+			util::TaskGroup convert(bandCount, [](void* userdata, u32 band)
+			{
+				const auto& c = *static_cast<const ConvertContext*>(userdata);
+				const uint32_t end = std::min(c.height, (band + 1) * c.bandRows);
+				for (uint32_t y = band * c.bandRows; y < end; ++y)
+				{
+					c.self->convertRowToRGBA(std::span<const uint8_t>(c.rows + y * c.rowStride, c.rowStride),
+						c.rgba + y * c.rgbaStride);
+				}
+			}, &ctx);
+
+			// 错误检查的顺序与信息和串行路径保持一致
+			const uint8_t* prevline = nullptr;
+			for (uint32_t y = 0; y < height; ++y)
+			{
+				const size_t offset = static_cast<size_t>(y) * (scanlineWidth + 1);
+				if (offset >= decompressed.size())
+				{
+					convert.Wait();
+					imageData.clear();
+					return std::unexpected(fmt::format("解压缩数据大小不足: 需要至少 {} 字节，但只有 {} 字节",
+						offset + scanlineWidth + 1, decompressed.size()));
+				}
+
+				const uint8_t filterType = decompressed[offset];
+				if (filterType > 4)
+				{
+					convert.Wait();
+					imageData.clear();
+					return std::unexpected(fmt::format("无效的滤波器类型: {} (第 {} 行)", filterType, y));
+				}
+
+				if (offset + 1 + scanlineWidth > decompressed.size())
+				{
+					convert.Wait();
+					imageData.clear();
+					return std::unexpected(fmt::format("扫描线数据不足: 第 {} 行需要 {} 字节，但只有 {} 字节",
+						y, scanlineWidth, decompressed.size() - offset - 1));
+				}
+
+				std::span<uint8_t> recon(unfiltered.data() + static_cast<size_t>(y) * scanlineWidth, scanlineWidth);
+				unfilterScanline(recon, std::span<const uint8_t>(decompressed.data() + offset + 1, scanlineWidth),
+					prevline, bytesPerPixel, filterType);
+				prevline = recon.data();
+
+				if ((y + 1) % bandRows == 0 || y + 1 == height)
+				{
+					convert.Submit(y / bandRows);
+				}
+			}
+
+			convert.Wait();
+			return {};
+		}
+
+		// Adam7：先计算各通道布局并一次性校验数据长度，之后的并行任务不会失败
+		struct PassLayout
+		{
+			uint32_t width = 0;
+			uint32_t height = 0;
+			size_t scanlineWidth = 0;
+			size_t filteredOffset = 0;  ///< 在解压缩数据中的起始位置
+			size_t reconOffset = 0;     ///< 在通道缓冲区中的起始位置
+		};
+
+		std::array<PassLayout, 7> passes{};
+		size_t filteredSize = 0;
+		size_t reconSize = 0;
+		for (int i = 0; i < 7; ++i)
+		{
+			PassLayout& pass = passes[i];
+			pass.width = (_width + ADAM7_DX[i] - ADAM7_IX[i] - 1) / ADAM7_DX[i];
+			pass.height = (_height + ADAM7_DY[i] - ADAM7_IY[i] - 1) / ADAM7_DY[i];
+			if (pass.width == 0 || pass.height == 0)
+			{
+				pass.width = pass.height = 0;
+				continue;
+			}
+			pass.scanlineWidth = scanlineBytes(pass.width);
+			pass.filteredOffset = filteredSize;
+			pass.reconOffset = reconSize;
+			filteredSize += static_cast<size_t>(pass.height) * (pass.scanlineWidth + 1);
+			reconSize += static_cast<size_t>(pass.height) * pass.scanlineWidth;
+		}
+
+		if (filteredSize > decompressed.size())
+		{
+			// 找出串行路径会首先报错的通道与扫描线，返回相同的错误信息
+			imageData.clear();
+			for (int i = 0; i < 7; ++i)
+			{
+				const PassLayout& pass = passes[i];
+				const size_t rowStride = pass.scanlineWidth + 1;
+				if (pass.height == 0 || pass.filteredOffset + pass.height * rowStride <= decompressed.size())
+				{
+					continue;
+				}
+				const size_t offset = pass.filteredOffset + (decompressed.size() - pass.filteredOffset) / rowStride * rowStride;
+				return std::unexpected("Adam7 交织解码失败: Adam7 通道 " + std::to_string(i) +
+					(offset >= decompressed.size() ? " 数据不足" : " 扫描线数据不足"));
+			}
+		}
+
+		std::vector<uint8_t> passData(reconSize);
+
+		struct Adam7Context
+		{
+			const png* self;
+			const uint8_t* filtered;
+			uint8_t* passData;
+			const std::array<PassLayout, 7>* passes;
+			size_t bytesPerPixel;
+			size_t scanlineWidth;
+			uint8_t* rgba;
+			size_t rgbaStride;
+			uint32_t bandRows;
+			uint32_t height;
+		} ctx{ this, decompressed.data(), passData.data(), &passes, bytesPerPixel, scanlineWidth,
+			imageData.data(), rgbaStride, bandRows, height };
+
+		// 1. 各通道互相独立，并行解滤波（从最大的通道开始投递）
+		{
+			util::TaskGroup unfilterPasses(7, [](void* userdata, u32 index)
+			{
+				const auto& c = *static_cast<const Adam7Context*>(userdata);
+				const PassLayout& pass = (*c.passes)[index];
+				const uint8_t* prevline = nullptr;
+				for (uint32_t y = 0; y < pass.height; ++y)
+				{
+					const uint8_t* filtered = c.filtered + pass.filteredOffset + y * (pass.scanlineWidth + 1);
+					uint8_t* recon = c.passData + pass.reconOffset + y * pass.scanlineWidth;
+					c.self->unfilterScanline(std::span<uint8_t>(recon, pass.scanlineWidth),
+						std::span<const uint8_t>(filtered + 1, pass.scanlineWidth), prevline, c.bytesPerPixel, filtered[0]);
+					prevline = recon;
+				}
+			}, &ctx);
+
+			for (u32 pass = 7; pass-- > 0;)
+			{
+				if (passes[pass].height != 0)
+				{
+					unfilterPasses.Submit(pass);
+				}
+			}
+		}
+
+		// 2. 按行带并行去交织并转换为 RGBA
+		util::TaskGroup convert(bandCount, [](void* userdata, u32 band)
+		{
+			const auto& c = *static_cast<const Adam7Context*>(userdata);
+			const png& self = *c.self;
+			const uint32_t bitDepth = self.bitDepth;
+			std::vector<uint8_t> row(c.scanlineWidth);
+
+			const uint32_t end = std::min(c.height, (band + 1) * c.bandRows);
+			for (uint32_t y = band * c.bandRows; y < end; ++y)
+			{
+				std::fill(row.begin(), row.end(), uint8_t{0});
+
+				for (int p = 0; p < 7; ++p)
+				{
+					const PassLayout& pass = (*c.passes)[p];
+					if (pass.height == 0 || y < ADAM7_IY[p] || (y - ADAM7_IY[p]) % ADAM7_DY[p] != 0)
+					{
+						continue;
+					}
+
+					const uint8_t* src = c.passData + pass.reconOffset + ((y - ADAM7_IY[p]) / ADAM7_DY[p]) * pass.scanlineWidth;
+					if (bitDepth >= 8)
+					{
+						for (uint32_t x = 0; x < pass.width; ++x)
+						{
+							const size_t dstX = ADAM7_IX[p] + static_cast<size_t>(x) * ADAM7_DX[p];
+							std::memcpy(row.data() + dstX * c.bytesPerPixel, src + x * c.bytesPerPixel, c.bytesPerPixel);
+						}
+					}
+					else
+					{
+						// 低位深度：按 MSB 优先逐像素搬运位
+						const uint32_t mask = (1u << bitDepth) - 1;
+						for (uint32_t x = 0; x < pass.width; ++x)
+						{
+							const size_t srcBit = static_cast<size_t>(x) * bitDepth;
+							const uint32_t value = (src[srcBit >> 3] >> (8 - bitDepth - (srcBit & 7))) & mask;
+							const size_t dstBit = (ADAM7_IX[p] + static_cast<size_t>(x) * ADAM7_DX[p]) * bitDepth;
+							row[dstBit >> 3] |= static_cast<uint8_t>(value << (8 - bitDepth - (dstBit & 7)));
+						}
+					}
+				}
+
+				self.convertRowToRGBA(row, c.rgba + y * c.rgbaStride);
+			}
+		}, &ctx);
+
+		for (u32 band = 0; band < bandCount; ++band)
+		{
+			convert.Submit(band);
+		}
+		convert.Wait();
+		return {};
+	}
+
 	std::expected<std::vector<uint8_t>, std::string> png::decodeRGB()
 	{
 		// 先解码为 RGBA，然后转换为 RGB
@@ -1547,705 +1821,425 @@ namespace shine::image
 	// Deflate/Zlib 解压缩实现
 	// ========================================================================
 	
-	// Deflate 常量定义
-	namespace {
-		constexpr uint32_t FIRST_LENGTH_CODE_INDEX = 257;
-		constexpr uint32_t LAST_LENGTH_CODE_INDEX = 285;
-		constexpr uint32_t NUM_DEFLATE_CODE_SYMBOLS = 288; // 256 literals + end code + length codes
-		constexpr uint32_t NUM_DISTANCE_SYMBOLS = 32;
-		constexpr uint32_t NUM_CODE_LENGTH_CODES = 19;
-		constexpr uint32_t FIRSTBITS = 9; // 用于 Huffman 查找表的根位数
-		constexpr uint32_t INVALIDSYMBOL = 65535;
-		
-		// 长度码的基础值（代码 257-285）
-		constexpr uint16_t LENGTHBASE[29] = {
-			3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59,
-			67, 83, 99, 115, 131, 163, 195, 227, 258
-		};
-		
-		// 长度码的额外位数
-		constexpr uint8_t LENGTHEXTRA[29] = {
-			0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
-			4, 4, 4, 4, 5, 5, 5, 5, 0
-		};
-		
-		// 距离码的基础值
-		constexpr uint16_t DISTANCEBASE[30] = {
-			1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513,
-			769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
-		};
-		
-		// 距离码的额外位数
-		constexpr uint8_t DISTANCEEXTRA[30] = {
-			0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8,
-			8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
-		};
-		
-		// 代码长度码的顺序
-		constexpr uint8_t CLCL_ORDER[NUM_CODE_LENGTH_CODES] = {
-			16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
-		};
-		
-		// 反转位顺序（用于 Huffman 解码）
-		constexpr uint32_t reverseBits(uint32_t bits, uint32_t num) noexcept
-		{
-			uint32_t result = 0;
-			for (uint32_t i = 0; i < num; ++i)
-			{
-				result |= ((bits >> (num - i - 1)) & 1) << i;
-			}
-			return result;
-		}
-	}
-	
-	// 使用通用的 HuffmanTree（来自 util/encoding/huffman_tree.h）
-	using HuffmanTree = util::HuffmanTree;
-	
-	// 从码长度构建 Huffman 树（使用通用实现）
-	static std::expected<HuffmanTree, std::string> buildHuffmanTree(
-		const uint32_t* bitlen, size_t numcodes, uint32_t maxbitlen)
-	{
-		// 使用通用实现
-		return util::buildHuffmanTree(bitlen, numcodes, maxbitlen);
-	}
-	
-	// 从固定树构建 Huffman 树（BTYPE=1）
-	static std::expected<std::pair<HuffmanTree, HuffmanTree>, std::string> buildFixedHuffmanTrees()
+	// Zlib 解压缩（委托给 util::zlibInflate 表驱动解压引擎）
+	std::expected<std::vector<uint8_t>, std::string> png::zlibDecompress(std::span<const uint8_t> compressed, size_t sizeHint, size_t maxOutput) const
 	{
-		// 构建 literal/length 树
-		std::vector<uint32_t> bitlen_ll(NUM_DEFLATE_CODE_SYMBOLS);
-		for (uint32_t i = 0; i <= 143; ++i) bitlen_ll[i] = 8;
-		for (uint32_t i = 144; i <= 255; ++i) bitlen_ll[i] = 9;
-		for (uint32_t i = 256; i <= 279; ++i) bitlen_ll[i] = 7;
-		for (uint32_t i = 280; i <= 287; ++i) bitlen_ll[i] = 8;
-		
-		auto tree_ll = buildHuffmanTree(bitlen_ll.data(), NUM_DEFLATE_CODE_SYMBOLS, 15);
-		if (!tree_ll.has_value())
+		auto output = util::zlibInflate(compressed, sizeHint, maxOutput);
+		if (!output.has_value())
 		{
-			return std::unexpected("构建固定 literal/length 树失败: " + tree_ll.error());
+			return output;
 		}
 		
-		// 构建距离树
-		std::vector<uint32_t> bitlen_d(NUM_DISTANCE_SYMBOLS, 5);
-		auto tree_d = buildHuffmanTree(bitlen_d.data(), NUM_DISTANCE_SYMBOLS, 15);
-		if (!tree_d.has_value())
+		if (output->empty())
 		{
-			return std::unexpected("构建固定距离树失败: " + tree_d.error());
+			return std::unexpected("解压缩后数据为空");
 		}
 		
-		return std::make_pair(std::move(tree_ll.value()), std::move(tree_d.value()));
+		return output;
 	}
 	
-	// Huffman 解码符号（使用通用实现）
-	// 注意：直接使用 util::huffmanDecodeSymbol 避免函数调用不明确
+	// ========================================================================
+	// 流式 Zlib 解压缩（用于逐行解码）
+	// ========================================================================
 	
-	// 解压缩 Huffman 块（BTYPE=1 或 2）
-	// 注意：output 参数用于累积所有块的数据，使得距离码可以引用之前块的数据
-	static std::expected<void, std::string> inflateHuffmanBlock(
-		util::BitReader& reader, uint32_t btype, std::vector<uint8_t>& output, size_t max_output_size = 0)
-	{
-		HuffmanTree tree_ll, tree_d;
-		
-		// 构建 Huffman 树
-		if (btype == 1)
-		{
-			// 固定树
-			auto trees = buildFixedHuffmanTrees();
-			if (!trees.has_value())
-			{
-				return std::unexpected(trees.error());
-			}
-			tree_ll = std::move(trees->first);
-			tree_d = std::move(trees->second);
-		}
-		else // btype == 2
-		{
-			// 动态树
-			// 检查是否有足够的数据读取头部（至少需要14位：5+5+4）
-			if (!reader.hasMoreData() || reader.remainingBytes() < 2)
-			{
-				return std::unexpected("数据不足：无法读取动态Huffman树头部");
-			}
-
-			
-			// 读取 HLIT, HDIST, HCLEN
-			uint32_t HLIT = reader.readBits(5) + 257;
-			uint32_t HDIST = reader.readBits(5) + 1;
-			uint32_t HCLEN = reader.readBits(4) + 4;
-			
-			if (HLIT > 286 || HDIST > 30)
-			{
-				return std::unexpected("无效的 HLIT 或 HDIST");
-			}
-			
-			// 读取代码长度码的长度
-			std::vector<uint32_t> bitlen_cl(NUM_CODE_LENGTH_CODES, 0);
-			for (uint32_t i = 0; i < HCLEN; ++i)
-			{
-				uint32_t order = CLCL_ORDER[i];
-				if (order >= NUM_CODE_LENGTH_CODES)
-				{
-					return std::unexpected("无效的代码长度码顺序");
-				}
-				bitlen_cl[order] = reader.readBits(3);
-			}
-			
-			// 构建代码长度码的 Huffman 树
-			auto tree_cl_result = buildHuffmanTree(bitlen_cl.data(), NUM_CODE_LENGTH_CODES, 7);
-			if (!tree_cl_result.has_value())
-			{
-				return std::unexpected("构建代码长度码树失败: " + tree_cl_result.error());
-			}
-			HuffmanTree tree_cl = std::move(tree_cl_result.value());
-			
-			// 解码 literal/length 和 distance 的码长度
-			std::vector<uint32_t> bitlen_ll(HLIT, 0);
-			std::vector<uint32_t> bitlen_d(HDIST, 0);
-			
-			uint32_t i = 0;
-			while (i < HLIT + HDIST)
-			{
-				// 检查是否有足够的数据
-				if (!reader.hasMoreData())
-				{
-					return std::unexpected("数据不足：无法读取代码长度码");
-				}
-				uint32_t code = util::huffmanDecodeSymbol(reader, tree_cl);
-				
-				if (code == INVALIDSYMBOL)
+	namespace {
+		using namespace util::deflate;
+		
+		/**
+		 * @brief 可暂停/恢复的 Zlib 解压器
+		 * 
+		 * 与 zlibDecompress 不同，输出不会累积到一个完整缓冲区，
+		 * 只保留 32KB 的 LZ77 滑动窗口；调用方按需拉取任意长度的数据。
+		 * 块头部、未完成的匹配复制和无压缩块剩余长度都保存在状态中，
+		 * 因此一次 read 可以在任意字节处结束。
+		 */
+		class ZlibInflateStream
+		{
+		public:
+			std::expected<void, std::string> init(std::span<const uint8_t> compressed)
+			{
+				if (compressed.size() < 6)
 				{
-					return std::unexpected("解码代码长度码失败");
+					return std::unexpected("Zlib 数据太小");
 				}
 				
-				uint32_t repeat = 0;
-				uint32_t value = 0;
-				
-				if (code <= 15)
-				{
-					// 直接使用码长度
-					value = code;
-					repeat = 1;
-				}
-				else if (code == 16)
-				{
-					// 重复前一个码长度 3-6 次
-					repeat = reader.readBits(2) + 3;
-					if (i == 0)
-					{
-						return std::unexpected("代码长度码 16 不能是第一个");
-					}
-					value = (i <= HLIT) ? bitlen_ll[i - 1] : bitlen_d[i - HLIT - 1];
-				}
-				else if (code == 17)
+				const uint8_t cmf = compressed[0];
+				const uint8_t flg = compressed[1];
+				if (((static_cast<uint32_t>(cmf) << 8) | flg) % 31 != 0)
 				{
-					// 重复 0 码长度 3-10 次
-					repeat = reader.readBits(3) + 3;
-					value = 0;
+					return std::unexpected("无效的 Zlib 头");
 				}
-				else if (code == 18)
+				if ((cmf & 0x0F) != 8 || ((cmf >> 4) & 0x0F) > 7)
 				{
-					// 重复 0 码长度 11-138 次
-					repeat = reader.readBits(7) + 11;
-					value = 0;
+					return std::unexpected("不支持的压缩方法");
 				}
-				else
+				if ((flg >> 5) & 0x01)
 				{
-					return std::unexpected("无效的代码长度码: " + std::to_string(code));
+					return std::unexpected("不支持预设字典");
 				}
 				
-				// 填充码长度
-				for (uint32_t j = 0; j < repeat && i < HLIT + HDIST; ++j, ++i)
+				// 跳过 zlib 头，保留最后4字节用于 Adler-32
+				_data = compressed.subspan(2, compressed.size() - 6);
+				_expectedAdler = util::read_be32(compressed.data(), compressed.size(), compressed.size() - 4);
+				_reader.emplace(_data.data(), _data.size());
+				_window.assign(WINDOW_SIZE, 0);
+				return {};
+			}
+			
+			/**
+			 * @brief 精确读取 size 字节
+			 * @return 成功返回 void；数据流提前结束或数据损坏返回错误信息
+			 */
+			std::expected<void, std::string> read(uint8_t* dst, size_t size)
+			{
+				size_t produced = 0;
+				while (produced < size)
 				{
-					if (i < HLIT)
+					if (_state == State::Done && _matchRemaining == 0)
 					{
-						bitlen_ll[i] = value;
+						return std::unexpected(fmt::format("解压缩数据不足: 还需要 {} 字节", size - produced));
 					}
-					else
+					auto stepResult = step(dst, produced, size);
+					if (!stepResult.has_value())
 					{
-						bitlen_d[i - HLIT] = value;
+						return stepResult;
 					}
 				}
+				
+				_adler = util::adler32(_adler, dst, size);
+				return {};
 			}
 			
-			// 检查结束码必须存在
-			if (bitlen_ll.size() <= 256 || bitlen_ll[256] == 0)
-			{
-				return std::unexpected("结束码 256 的长度必须大于 0");
+			/**
+			 * @brief 消耗剩余的块直到流结束，并校验 Adler-32
+			 * 
+			 * 正常的 PNG 数据在最后一行之后只剩结束码；多余的数据照常解码并计入校验和
+			 */
+			std::expected<void, std::string> finish()
+			{
+				uint8_t scratch = 0;
+				while (_state != State::Done || _matchRemaining > 0)
+				{
+					size_t produced = 0;
+					auto stepResult = step(&scratch, produced, 1);
+					if (!stepResult.has_value())
+					{
+						return stepResult;
+					}
+					_adler = util::adler32(_adler, &scratch, produced);
+				}
+				
+				if (_adler != _expectedAdler)
+				{
+					return std::unexpected("Adler-32 校验失败: 期望=" +
+						std::to_string(_expectedAdler) + ", 计算=" + std::to_string(_adler));
+				}
+				return {};
 			}
 			
-			// 构建 literal/length 和 distance 树
-			auto tree_ll_result = buildHuffmanTree(bitlen_ll.data(), HLIT, 15);
-			if (!tree_ll_result.has_value())
-			{
-				return std::unexpected("构建 literal/length 树失败: " + tree_ll_result.error());
-			}
-			tree_ll = std::move(tree_ll_result.value());
+		private:
+			static constexpr size_t WINDOW_SIZE = 32768;
+			static constexpr size_t WINDOW_MASK = WINDOW_SIZE - 1;
 			
-			auto tree_d_result = buildHuffmanTree(bitlen_d.data(), HDIST, 15);
-			if (!tree_d_result.has_value())
-			{
-				return std::unexpected("构建距离树失败: " + tree_d_result.error());
-			}
-			tree_d = std::move(tree_d_result.value());
-		}
-		
-		bool done = false;
-		while (!done)
-		{
-			// 检查是否有足够的数据
-			if (!reader.hasMoreData())
+			enum class State : uint8_t
 			{
-				return std::unexpected("数据不足：无法读取Huffman符号");
-			}
-			
-			// 解码符号（huffmanDecodeSymbol内部会调用ensureBits，这里不需要重复调用）
-			uint32_t code_ll = util::huffmanDecodeSymbol(reader, tree_ll);
+				BlockHeader,
+				Stored,
+				Huffman,
+				Done
+			};
 			
-			if (code_ll == INVALIDSYMBOL)
+			void emit(uint8_t& out, uint8_t value) noexcept
 			{
-				return std::unexpected("无效的 Huffman 符号");
+				out = value;
+				_window[_totalOut & WINDOW_MASK] = value;
+				++_totalOut;
 			}
 			
-			if (code_ll <= 255)
+			// 执行一步解压：复制一段匹配、读取块头、复制一段无压缩数据或解码一个符号
+			std::expected<void, std::string> step(uint8_t* dst, size_t& produced, size_t size)
 			{
-				// 字面量
-				output.push_back(static_cast<uint8_t>(code_ll));
-			}
-			else if (code_ll >= FIRST_LENGTH_CODE_INDEX && code_ll <= LAST_LENGTH_CODE_INDEX)
-			{
-				// 长度/距离对
-				uint32_t length = LENGTHBASE[code_ll - FIRST_LENGTH_CODE_INDEX];
-				uint8_t numextrabits_l = LENGTHEXTRA[code_ll - FIRST_LENGTH_CODE_INDEX];
-				
-				if (numextrabits_l > 0)
+				// 先完成上一次未复制完的匹配
+				if (_matchRemaining > 0)
 				{
-					length += reader.readBits(numextrabits_l);
+					const size_t n = (std::min)(static_cast<size_t>(_matchRemaining), size - produced);
+					for (size_t i = 0; i < n; ++i)
+					{
+						emit(dst[produced++], _window[(_totalOut - _matchDistance) & WINDOW_MASK]);
+					}
+					_matchRemaining -= static_cast<uint32_t>(n);
+					return {};
 				}
 				
-				// 解码距离码（huffmanDecodeSymbol内部会调用ensureBits）
-				uint32_t code_d = util::huffmanDecodeSymbol(reader, tree_d);
-				
-				if (code_d == INVALIDSYMBOL || code_d > 29)
+				switch (_state)
 				{
-					return std::unexpected("无效的距离码");
-				}
-				
-				uint32_t distance = DISTANCEBASE[code_d];
-				uint8_t numextrabits_d = DISTANCEEXTRA[code_d];
-				
-				if (numextrabits_d > 0)
+				case State::BlockHeader:
+					if (_finalBlock)
+					{
+						_state = State::Done;
+						return {};
+					}
+					return readBlockHeader();
+					
+				case State::Stored:
 				{
-					distance += reader.readBits(numextrabits_d);
+					if (_storedRemaining == 0)
+					{
+						_state = State::BlockHeader;
+						return {};
+					}
+					const size_t bytePos = _reader->getBytePos();
+					const size_t available = (bytePos < _data.size()) ? (_data.size() - bytePos) : 0;
+					const size_t n = (std::min)({ static_cast<size_t>(_storedRemaining), size - produced, available });
+					if (n == 0)
+					{
+						return std::unexpected("无压缩块数据超出范围");
+					}
+					for (size_t i = 0; i < n; ++i)
+					{
+						emit(dst[produced++], _data[bytePos + i]);
+					}
+					_reader->advanceBits(n * 8);
+					_storedRemaining -= static_cast<uint32_t>(n);
+					return {};
 				}
 				
-				// LZ77 解码：从输出缓冲区复制（可以引用之前所有块的数据）
-				if (distance > output.size())
+				case State::Huffman:
+					return decodeSymbol(dst, produced);
+					
+				case State::Done:
+					break;
+				}
+				return {};
+			}
+			
+			std::expected<void, std::string> readBlockHeader()
+			{
+				if (!_reader->hasMoreData())
 				{
-					return std::unexpected("距离超出输出缓冲区");
+					return std::unexpected("数据不足：无法读取块头部");
 				}
 				
-				size_t start = output.size();
-				size_t backward = start - distance;
-				output.resize(start + length);
+				_finalBlock = _reader->readBits(1) != 0;
+				const uint32_t btype = _reader->readBits(2);
 				
-				if (distance < length)
+				if (btype == 0)
 				{
-					// 需要重复复制
-					std::memcpy(output.data() + start, output.data() + backward, distance);
-					uint32_t forward = distance;
-					while (forward < length)
+					_reader->alignToByte();
+					const size_t bytePos = _reader->getBytePos();
+					if (bytePos + 4 > _data.size())
+					{
+						return std::unexpected("无压缩块数据不足");
+					}
+					// LEN/NLEN 为小端序（RFC 1951 3.2.4）
+					const uint16_t len = util::read_le16(_data.data(), _data.size(), bytePos);
+					const uint16_t nlen = util::read_le16(_data.data(), _data.size(), bytePos + 2);
+					if ((len ^ nlen) != 0xFFFF)
 					{
-						size_t copyLen = std::min(distance, length - forward);
-						std::memcpy(output.data() + start + forward, 
-						           output.data() + backward, copyLen);
-						forward += copyLen;
+						return std::unexpected("无压缩块长度校验失败");
 					}
+					_reader->advanceBits(32);
+					_storedRemaining = len;
+					_state = State::Stored;
 				}
-				else
+				else if (btype == 1 || btype == 2)
 				{
-					std::memcpy(output.data() + start, output.data() + backward, length);
+					auto treesResult = util::readDeflateBlockTrees(*_reader, btype, _treeLL, _treeD);
+					if (!treesResult.has_value())
+					{
+						return std::unexpected("Huffman 块解码失败: " + treesResult.error());
+					}
+					_state = State::Huffman;
 				}
-			}
-			else if (code_ll == 256)
-			{
-				// 结束码
-				done = true;
-			}
-			else
-			{
-				return std::unexpected("无效的 Huffman 码");
+				else
+				{
+					return std::unexpected("无效的 BTYPE");
+				}
+				return {};
 			}
 			
-			if (max_output_size > 0 && output.size() > max_output_size)
+			// 解码一个 literal/length 符号；字面量直接写出，长度码转为待复制的匹配
+			std::expected<void, std::string> decodeSymbol(uint8_t* dst, size_t& produced)
 			{
-				return std::unexpected("输出大小超出限制");
+				if (!_reader->hasMoreData())
+				{
+					return std::unexpected("数据不足：无法读取Huffman符号");
+				}
+				
+				const uint32_t code_ll = util::huffmanDecodeSymbol(*_reader, _treeLL);
+				if (code_ll <= 255)
+				{
+					emit(dst[produced++], static_cast<uint8_t>(code_ll));
+					return {};
+				}
+				if (code_ll == 256)
+				{
+					_state = State::BlockHeader;
+					return {};
+				}
+				if (code_ll < FIRST_LENGTH_CODE_INDEX || code_ll > LAST_LENGTH_CODE_INDEX)
+				{
+					return std::unexpected("无效的 Huffman 符号");
+				}
+				
+				uint32_t length = LENGTHBASE[code_ll - FIRST_LENGTH_CODE_INDEX];
+				const uint8_t numextrabits_l = LENGTHEXTRA[code_ll - FIRST_LENGTH_CODE_INDEX];
+				if (numextrabits_l > 0)
+				{
+					length += _reader->readBits(numextrabits_l);
+				}
+				
+				const uint32_t code_d = util::huffmanDecodeSymbol(*_reader, _treeD);
+				if (code_d == INVALIDSYMBOL || code_d > 29)
+				{
+					return std::unexpected("无效的距离码");
+				}
+				
+				uint32_t distance = DISTANCEBASE[code_d];
+				const uint8_t numextrabits_d = DISTANCEEXTRA[code_d];
+				if (numextrabits_d > 0)
+				{
+					distance += _reader->readBits(numextrabits_d);
+				}
+				
+				if (distance > _totalOut || distance > WINDOW_SIZE)
+				{
+					return std::unexpected("距离超出输出缓冲区");
+				}
+				
+				_matchDistance = distance;
+				_matchRemaining = length;
+				return {};
 			}
-		}
-		
-		return {};
+			
+			std::span<const uint8_t> _data;
+			std::optional<util::BitReader> _reader;
+			std::vector<uint8_t> _window;
+			HuffmanTree _treeLL;
+			HuffmanTree _treeD;
+			
+			State _state = State::BlockHeader;
+			bool _finalBlock = false;
+			uint32_t _storedRemaining = 0;
+			uint32_t _matchRemaining = 0;
+			uint32_t _matchDistance = 0;
+			size_t _totalOut = 0;
+			uint32_t _adler = 1;
+			uint32_t _expectedAdler = 0;
+		};
 	}
 	
-	// Zlib 解压缩实现（完整版，支持 Deflate）
-	std::expected<std::vector<uint8_t>, std::string> png::zlibDecompress(std::span<const uint8_t> compressed) const
+	// ========================================================================
+	// 流式解码
+	// ========================================================================
+	
+	std::expected<void, std::string> png::decodeStreaming(const ScanlineSink& sink)
 	{
-		if (compressed.size() < 2)
+		if (!sink)
 		{
-			return std::unexpected("Zlib 数据太小");
+			return std::unexpected("未提供扫描线回调");
 		}
 		
-		// 使用 byte_convert 工具读取 zlib 头
-		std::span<const std::byte> compressedSpan(reinterpret_cast<const std::byte*>(compressed.data()), compressed.size());
-		uint16_t header = read_u16(compressedSpan, 0);
-	
-	if ((header % 31) != 0)
-	{
-		return std::unexpected("无效的 Zlib 头");
-	}
-	
-	uint8_t cm = read_u8(compressedSpan, 0) & 0x0F;
-	uint8_t cinfo = (read_u8(compressedSpan, 0) >> 4) & 0x0F;
-	uint8_t fdict = (read_u8(compressedSpan, 1) >> 5) & 0x01;
-		
-		if (cm != 8 || cinfo > 7)
+		if (idatData.empty())
 		{
-			return std::unexpected("不支持的压缩方法");
+			return std::unexpected("没有 IDAT 数据可解码");
 		}
 		
-		if (fdict != 0)
+		if (_width == 0 || _height == 0)
 		{
-			return std::unexpected("不支持预设字典");
+			return std::unexpected("图像尺寸无效");
 		}
 		
-		// 跳过 zlib 头，开始 deflate 数据
-		std::span<const uint8_t> deflateData = compressed.subspan(2);
-		if (deflateData.size() < 4) // 至少需要 Adler-32
+		const size_t bytesPerPixel = filterBytesPerPixel();
+		if (bytesPerPixel == 0)
 		{
-			return std::unexpected("Deflate 数据太小");
+			return std::unexpected("不支持的颜色类型");
 		}
 		
-		// 创建位读取器
-		util::BitReader reader(deflateData.data(), deflateData.size() - 4); // 保留最后4字节用于 Adler-32
+		const size_t rgbaRowBytes = static_cast<size_t>(_width) * 4;
 		
-		std::vector<uint8_t> output;
-		// 优化：根据压缩数据大小估算解压后大小，减少重新分配
-		// PNG图像解压后大小约为：height * (width * bytesPerPixel + 1)
-		// 对于844x167 RGBA，约为 167 * (844*4 + 1) ≈ 563KB
-		// 保守估计：压缩比通常为2-10倍，预分配压缩大小的5倍
-		size_t estimatedSize = compressed.size() * 5;
-		if (estimatedSize < 1024) estimatedSize = 1024; // 至少1KB
-		output.reserve(estimatedSize);
-		
-		// 解压缩 deflate 块
-		bool bfinal = false;
-		while (!bfinal)
+		if (interlaceMethod == 1)
 		{
-			if (reader.getBitPos() + 3 > reader.getBytePos() * 8 + (deflateData.size() - 4) * 8)
-			{
-				return std::unexpected("位指针超出范围");
-			}
-			
-			// 读取 BFINAL (1 bit) 和 BTYPE (2 bits)
-			bfinal = reader.readBits(1) != 0;
-			uint32_t btype = reader.readBits(2);
-			
-			if (btype == 3)
+			// Adam7：任意一行都要等到第 7 个通道才完整，无法有界输出，退化为完整解码
+			std::vector<uint8_t> previous = std::move(imageData);
+			auto result = decodeInternal();
+			std::vector<uint8_t> full = std::move(imageData);
+			imageData = std::move(previous);
+			if (!result.has_value())
 			{
-				return std::unexpected("无效的 BTYPE");
+				return result;
 			}
 			
-			// 处理不同类型的块
-			if (btype == 0)
-			{
-				// 无压缩块
-				reader.alignToByte();
-				size_t bytePos = reader.getBytePos();
-				
-				if (bytePos + 4 > deflateData.size() - 4)
-				{
-					return std::unexpected("无压缩块数据不足");
-				}
-				
-				// 使用 byte_convert 工具读取长度
-				std::span<const std::byte> deflateSpan(reinterpret_cast<const std::byte*>(deflateData.data()), deflateData.size());
-				uint16_t len = read_u16(deflateSpan, bytePos);
-			uint16_t nlen = read_u16(deflateSpan, bytePos + 2);
-				
-				if ((len + nlen) != 0xFFFF)
-				{
-					return std::unexpected("无压缩块长度校验失败");
-				}
-				
-				bytePos += 4;
-				if (bytePos + len > deflateData.size() - 4)
-				{
-					return std::unexpected("无压缩块数据超出范围");
-				}
-				
-				size_t oldSize = output.size();
-				output.resize(oldSize + len);
-				std::memcpy(output.data() + oldSize, deflateData.data() + bytePos, len);
-				
-				reader.advanceBits(len * 8);
-			}
-			else if (btype == 1 || btype == 2)
+			for (uint32_t y = 0; y < _height; ++y)
 			{
-				// BTYPE=1 (固定 Huffman) 或 BTYPE=2 (动态 Huffman)
-				// 注意：传递累积的输出缓冲区，使得距离码可以引用之前块的数据
-				auto blockResult = inflateHuffmanBlock(reader, btype, output);
-				if (!blockResult.has_value())
+				if (!sink(y, std::span<const uint8_t>(full.data() + y * rgbaRowBytes, rgbaRowBytes)))
 				{
-					return std::unexpected("Huffman 块解码失败: " + blockResult.error());
+					return std::unexpected("扫描线回调中止解码");
 				}
 			}
-			else
-			{
-				return std::unexpected("不支持的 BTYPE: " + std::to_string(btype));
-			}
+			return {};
 		}
 		
-		// 验证 Adler-32 校验和
-		// Adler-32校验和在zlib中是大端序存储的，read_u32会将其转换为本机字节序
-		if (deflateData.size() >= 4)
+		ZlibInflateStream inflater;
+		auto initResult = inflater.init(idatData);
+		if (!initResult.has_value())
 		{
-			// 读取期望的Adler-32校验和（大端序，read_u32会转换为本机字节序）
-			uint32_t expectedAdler = read_u32(compressedSpan, compressed.size() - 4);
-			
-			// 计算Adler-32校验和
-			// Adler-32算法：s1和s2初始值分别为1和0
-			// 对于每个字节：s1 = (s1 + byte) % 65521, s2 = (s2 + s1) % 65521
-			// 最终校验和 = (s2 << 16) | s1
-			uint32_t s1 = 1, s2 = 0;
-			const uint32_t ADLER_MOD = 65521;
-			
-			// 优化：批量处理减少模运算次数
-			// 由于s1每次最多加255，可以累积约257个字节后再做模运算（65521/255 ≈ 257）
-			// 使用延迟模运算优化性能
-			const size_t BATCH_SIZE = 256; // 批量处理大小
-			size_t i = 0;
-			const size_t size = output.size();
-			
-			// 批量处理
-			for (; i + BATCH_SIZE <= size; i += BATCH_SIZE)
+			return std::unexpected("Zlib 解压缩失败: " + initResult.error());
+		}
+		
+		// 只保留：当前滤波扫描线 + 两条重建扫描线（当前/上一行）+ 一行 RGBA
+		const size_t scanlineWidth = scanlineBytes(_width);
+		std::vector<uint8_t> filtered(scanlineWidth + 1);
+		std::vector<uint8_t> reconLines(scanlineWidth * 2);
+		std::vector<uint8_t> rgbaRow(rgbaRowBytes);
+		
+		const uint8_t* prevline = nullptr;
+		for (uint32_t y = 0; y < _height; ++y)
+		{
+			auto readResult = inflater.read(filtered.data(), filtered.size());
+			if (!readResult.has_value())
 			{
-				for (size_t j = 0; j < BATCH_SIZE; ++j)
-				{
-					s1 += output[i + j];
-					s2 += s1;
-				}
-				// 延迟模运算：批量处理后再做模运算
-				s1 %= ADLER_MOD;
-				s2 %= ADLER_MOD;
+				return std::unexpected(fmt::format("Zlib 解压缩失败（第 {} 行）: {}", y, readResult.error()));
 			}
 			
-			// 处理剩余字节
-			for (; i < size; ++i)
+			const uint8_t filterType = filtered[0];
+			if (filterType > 4)
 			{
-				s1 = (s1 + output[i]) % ADLER_MOD;
-				s2 = (s2 + s1) % ADLER_MOD;
+				return std::unexpected(fmt::format("无效的滤波器类型: {} (第 {} 行)", filterType, y));
 			}
 			
-			// 组合校验和：高16位是s2，低16位是s1
-			uint32_t calculatedAdler = (s2 << 16) | s1;
+			std::span<uint8_t> recon(reconLines.data() + (y & 1) * scanlineWidth, scanlineWidth);
+			unfilterScanline(recon, std::span<const uint8_t>(filtered.data() + 1, scanlineWidth),
+				prevline, bytesPerPixel, filterType);
+			prevline = recon.data();
 			
-			if (expectedAdler != calculatedAdler)
+			convertRowToRGBA(recon, rgbaRow.data());
+			if (!sink(y, rgbaRow))
 			{
-				return std::unexpected("Adler-32 校验失败: 期望=" + 
-					std::to_string(expectedAdler) + ", 计算=" + std::to_string(calculatedAdler));
+				return std::unexpected("扫描线回调中止解码");
 			}
 		}
 		
-		if (output.empty())
+		auto finishResult = inflater.finish();
+		if (!finishResult.has_value())
 		{
-			return std::unexpected("解压缩后数据为空");
+			return std::unexpected("Zlib 解压缩失败: " + finishResult.error());
 		}
 		
-		return output;
+		return {};
 	}
 	
-	// PNG 滤波器处理
+	// PNG 滤波器处理（内核按 CPU 特性分派，见 png_filter.cpp）
 	void png::unfilterScanline(std::span<uint8_t> recon, std::span<const uint8_t> scanline,
 	                            const uint8_t* prevline, size_t bytewidth, uint8_t filterType) const
 	{
-		const size_t length = recon.size();
-		
-		switch (filterType)
-		{
-		case 0: // None
-			std::memcpy(recon.data(), scanline.data(), length);
-			break;
-			
-		case 1: // Sub
-		{
-			// 复制前bytewidth个字节
-			const size_t copyLen = (bytewidth < length) ? bytewidth : length;
-			std::memcpy(recon.data(), scanline.data(), copyLen);
-			
-			// 优化：使用SIMD加速Sub滤波器（如果可用）
-#ifndef __EMSCRIPTEN__
-#if defined(__AVX2__) && (defined(_MSC_VER) || defined(__GNUC__) || defined(__clang__))
-			// AVX2优化：批量处理Sub滤波器
-			if (length > bytewidth + 32)
-			{
-				size_t i = bytewidth;
-				const uint8_t* src = scanline.data();
-				uint8_t* dst = recon.data();
-				
-				// 处理对齐部分
-				for (; i + 32 <= length; i += 32)
-				{
-					__m256i scan = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
-					__m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i - bytewidth));
-					__m256i result = _mm256_add_epi8(scan, prev);
-					_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), result);
-				}
-				
-				// 处理剩余字节
-				for (; i < length; ++i)
-				{
-					dst[i] = src[i] + dst[i - bytewidth];
-				}
-			}
-			else
-			{
-				// 标准实现（小数据）
-				for (size_t i = bytewidth; i < length; ++i)
-				{
-					recon[i] = scanline[i] + recon[i - bytewidth];
-				}
-			}
-#else
-			// 标准实现（无AVX2）
-			for (size_t i = bytewidth; i < length; ++i)
-			{
-				recon[i] = scanline[i] + recon[i - bytewidth];
-			}
-#endif
-#else
-			// 标准实现（WASM平台）
-			for (size_t i = bytewidth; i < length; ++i)
-			{
-				recon[i] = scanline[i] + recon[i - bytewidth];
-			}
-#endif
-			break;
-		}
-		
-		case 2: // Up
-		{
-			if (prevline)
-			{
-				// 优化：使用SIMD加速Up滤波器（如果可用）
-#ifndef __EMSCRIPTEN__
-#if defined(__AVX2__) && (defined(_MSC_VER) || defined(__GNUC__) || defined(__clang__))
-				if (length >= 32)
-				{
-					size_t i = 0;
-					const uint8_t* src = scanline.data();
-					const uint8_t* prev = prevline;
-					uint8_t* dst = recon.data();
-					
-					// AVX2批量处理
-					for (; i + 32 <= length; i += 32)
-					{
-						__m256i scan = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
-						__m256i prev_vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + i));
-						__m256i result = _mm256_add_epi8(scan, prev_vec);
-						_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), result);
-					}
-					
-					// 处理剩余字节
-					for (; i < length; ++i)
-					{
-						dst[i] = src[i] + prev[i];
-					}
-					break;
-				}
-#endif
-#endif
-				// 标准实现
-				for (size_t i = 0; i < length; ++i)
-				{
-					recon[i] = scanline[i] + prevline[i];
-				}
-			}
-			else
-			{
-				std::memcpy(recon.data(), scanline.data(), length);
-			}
-			break;
-		}
-		
-		case 3: // Average
-		{
-			if (prevline)
-			{
-				for (size_t i = 0; i < bytewidth && i < length; ++i)
-				{
-					recon[i] = scanline[i] + (prevline[i] / 2);
-				}
-				for (size_t i = bytewidth; i < length; ++i)
-				{
-					recon[i] = scanline[i] + ((recon[i - bytewidth] + prevline[i]) / 2);
-				}
-			}
-			else
-			{
-				for (size_t i = 0; i < bytewidth && i < length; ++i)
-				{
-					recon[i] = scanline[i];
-				}
-				for (size_t i = bytewidth; i < length; ++i)
-				{
-					recon[i] = scanline[i] + (recon[i - bytewidth] / 2);
-				}
-			}
-			break;
-		}
-		
-		case 4: // Paeth
-		{
-			if (prevline)
-			{
-				for (size_t i = 0; i < bytewidth && i < length; ++i)
-				{
-					recon[i] = scanline[i] + prevline[i];
-				}
-				for (size_t i = bytewidth; i < length; ++i)
-				{
-					recon[i] = scanline[i] + paethPredictor(recon[i - bytewidth], prevline[i], prevline[i - bytewidth]);
-				}
-			}
-			else
-			{
-				for (size_t i = 0; i < bytewidth && i < length; ++i)
-				{
-					recon[i] = scanline[i];
-				}
-				for (size_t i = bytewidth; i < length; ++i)
-				{
-					recon[i] = scanline[i] + recon[i - bytewidth];
-				}
-			}
-			break;
-		}
-		
-		default:
-			// 未知滤波器类型，复制原始数据
-			std::memcpy(recon.data(), scanline.data(), length);
-			break;
-		}
+		png_filter::unfilterScanline(recon.data(), scanline.data(), prevline, recon.size(), bytewidth, filterType);
 	}
 	
 	// Adam7 交织解码
 	std::expected<std::vector<uint8_t>, std::string> png::decodeAdam7(
 		std::span<const uint8_t> decompressed, size_t bytesPerPixel, size_t scanlineWidth) const
 	{
-		// Adam7 常量定义
-		constexpr uint32_t ADAM7_IX[7] = { 0, 4, 0, 2, 0, 1, 0 }; // x 起始位置
-		constexpr uint32_t ADAM7_IY[7] = { 0, 0, 4, 0, 2, 0, 1 }; // y 起始位置
-		constexpr uint32_t ADAM7_DX[7] = { 8, 8, 4, 4, 2, 2, 1 }; // x 步长
-		constexpr uint32_t ADAM7_DY[7] = { 8, 8, 8, 4, 4, 2, 2 }; // y 步长
-		
 		// 计算每个通道的宽度和高度
 		uint32_t passw[7], passh[7];
 		size_t filter_passstart[8] = {0}; // 每个通道在解压缩数据中的起始位置
@@ -2266,11 +2260,11 @@ namespace shine::image
 				passScanlineWidth = ((passw[i] * bitDepth) + 7) / 8;
 			}
 			
-			// 计算下一个通道的起始位置
+			// 计算下一个通道的起始位置（宽或高为 0 的通道没有扫描线，也没有滤波器字节）
 			if (i < 6)
 			{
 				filter_passstart[i + 1] = filter_passstart[i];
-				for (uint32_t y = 0; y < passh[i]; ++y)
+				for (uint32_t y = 0; passw[i] != 0 && y < passh[i]; ++y)
 				{
 					filter_passstart[i + 1] += passScanlineWidth + 1; // +1 是滤波器字节
 				}
@@ -3027,6 +3021,336 @@ namespace shine::image
 			output.clear();
 		}
 	}
+	
+	// 单行颜色转换到 RGBA（流式解码使用）
+	void png::convertRowToRGBA(std::span<const uint8_t> row, uint8_t* dst) const
+	{
+		const size_t width = _width;
+		const uint8_t* src = row.data();
+		
+		auto writePalette = [this](uint8_t index, uint8_t* out) noexcept
+		{
+			if (index < palettColors.size())
+			{
+				std::memcpy(out, palettColors[index].data(), 4);
+			}
+			else
+			{
+				// 索引超出范围，使用黑色
+				out[0] = 0; out[1] = 0; out[2] = 0; out[3] = 255;
+			}
+		};
+		
+		if (bitDepth == 8)
+		{
+			switch (colorType)
+			{
+			case PngColorType::GERY:
+				for (size_t x = 0; x < width; ++x, dst += 4)
+				{
+					dst[0] = dst[1] = dst[2] = src[x];
+					dst[3] = 255;
+				}
+				break;
+				
+			case PngColorType::RGB:
+				for (size_t x = 0; x < width; ++x, src += 3, dst += 4)
+				{
+					dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2];
+					dst[3] = 255;
+				}
+				break;
+				
+			case PngColorType::PALETTE:
+				for (size_t x = 0; x < width; ++x, dst += 4)
+				{
+					writePalette(src[x], dst);
+				}
+				break;
+				
+			case PngColorType::GERY_ALPHA:
+				for (size_t x = 0; x < width; ++x, src += 2, dst += 4)
+				{
+					dst[0] = dst[1] = dst[2] = src[0];
+					dst[3] = src[1];
+				}
+				break;
+				
+			case PngColorType::RGBA:
+				std::memcpy(dst, src, width * 4);
+				break;
+				
+			default:
+				break;
+			}
+		}
+		else if (bitDepth == 16)
+		{
+			// 16位大端序，降采样取高8位（即每个样本的第一个字节）
+			switch (colorType)
+			{
+			case PngColorType::GERY:
+				for (size_t x = 0; x < width; ++x, src += 2, dst += 4)
+				{
+					dst[0] = dst[1] = dst[2] = src[0];
+					dst[3] = 255;
+				}
+				break;
+				
+			case PngColorType::RGB:
+				for (size_t x = 0; x < width; ++x, src += 6, dst += 4)
+				{
+					dst[0] = src[0]; dst[1] = src[2]; dst[2] = src[4];
+					dst[3] = 255;
+				}
+				break;
+				
+			case PngColorType::GERY_ALPHA:
+				for (size_t x = 0; x < width; ++x, src += 4, dst += 4)
+				{
+					dst[0] = dst[1] = dst[2] = src[0];
+					dst[3] = src[2];
+				}
+				break;
+				
+			case PngColorType::RGBA:
+				for (size_t x = 0; x < width; ++x, src += 8, dst += 4)
+				{
+					dst[0] = src[0]; dst[1] = src[2]; dst[2] = src[4]; dst[3] = src[6];
+				}
+				break;
+				
+			default:
+				break;
+			}
+		}
+		else if (bitDepth == 1 || bitDepth == 2 || bitDepth == 4)
+		{
+			// 低位深度：MSB 优先，行尾可能有填充位
+			const uint32_t mask = (1u << bitDepth) - 1u;
+			const uint32_t scale = 255u / mask; // 1→255, 2→85, 4→17
+			for (size_t x = 0; x < width; ++x, dst += 4)
+			{
+				const size_t bitPos = x * bitDepth;
+				const uint32_t shift = 8 - bitDepth - static_cast<uint32_t>(bitPos & 7);
+				const uint8_t value = static_cast<uint8_t>((src[bitPos >> 3] >> shift) & mask);
+				
+				if (colorType == PngColorType::PALETTE)
+				{
+					writePalette(value, dst);
+				}
+				else
+				{
+					dst[0] = dst[1] = dst[2] = static_cast<uint8_t>(value * scale);
+					dst[3] = 255;
+				}
+			}
+		}
+	}
+	
+	// ========================================================================
+	// PNG 编码
+	// ========================================================================
+
+	namespace {
+		/// CRC-32 查找表（PNG 块校验，多项式 0xEDB88320）
+		constexpr auto CRC_TABLE = []
+		{
+			std::array<uint32_t, 256> table{};
+			for (uint32_t n = 0; n < 256; ++n)
+			{
+				uint32_t c = n;
+				for (int k = 0; k < 8; ++k)
+				{
+					c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : (c >> 1);
+				}
+				table[n] = c;
+			}
+			return table;
+		}();
+
+		uint32_t updateCrc32(uint32_t crc, const uint8_t* data, size_t size) noexcept
+		{
+			for (size_t i = 0; i < size; ++i)
+			{
+				crc = CRC_TABLE[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+			}
+			return crc;
+		}
+
+		void appendBe32(std::vector<uint8_t>& out, uint32_t value)
+		{
+			out.push_back(static_cast<uint8_t>(value >> 24));
+			out.push_back(static_cast<uint8_t>(value >> 16));
+			out.push_back(static_cast<uint8_t>(value >> 8));
+			out.push_back(static_cast<uint8_t>(value));
+		}
+
+		/// 追加一个完整的块：长度 + 类型 + 数据 + CRC（CRC 覆盖类型与数据）
+		void appendChunk(std::vector<uint8_t>& out, const std::array<std::byte, 4>& type, const uint8_t* data, size_t size)
+		{
+			appendBe32(out, static_cast<uint32_t>(size));
+			const uint8_t* typeBytes = reinterpret_cast<const uint8_t*>(type.data());
+			out.insert(out.end(), typeBytes, typeBytes + 4);
+			out.insert(out.end(), data, data + size);
+
+			uint32_t crc = updateCrc32(0xFFFFFFFFu, typeBytes, 4);
+			crc = updateCrc32(crc, data, size);
+			appendBe32(out, crc ^ 0xFFFFFFFFu);
+		}
+
+		/// 单个 IDAT 块的最大数据量（超过时拆分为多个 IDAT）
+		constexpr size_t MAX_IDAT_SIZE = 1u << 20;
+
+		/// 编码滤波的行带划分
+		struct FilterContext
+		{
+			const uint8_t* pixels;
+			uint8_t* filtered;
+			size_t stride;
+			size_t bytesPerPixel;
+			uint32_t height;
+			uint32_t rowsPerBand;
+			bool adaptive;
+		};
+
+		void filterBand(void* userdata, u32 band)
+		{
+			const auto& c = *static_cast<const FilterContext*>(userdata);
+			const uint32_t y0 = band * c.rowsPerBand;
+			const uint32_t y1 = (std::min)(c.height, y0 + c.rowsPerBand);
+			std::vector<uint8_t> scratch(c.adaptive ? c.stride : 0);
+
+			for (uint32_t y = y0; y < y1; ++y)
+			{
+				const uint8_t* row = c.pixels + static_cast<size_t>(y) * c.stride;
+				const uint8_t* prev = y > 0 ? row - c.stride : nullptr;
+				uint8_t* dst = c.filtered + static_cast<size_t>(y) * (c.stride + 1);
+
+				if (c.adaptive)
+				{
+					dst[0] = png_filter::filterScanlineAdaptive(dst + 1, scratch.data(), row, prev, c.stride, c.bytesPerPixel);
+				}
+				else
+				{
+					dst[0] = 0;
+					std::memcpy(dst + 1, row, c.stride);
+				}
+			}
+		}
+	}
+
+	std::expected<std::vector<uint8_t>, std::string> png::encode(std::span<const uint8_t> pixels,
+		uint32_t width, uint32_t height, PngColorType colorType, const PngEncodeOptions& options)
+	{
+		util::FunctionTimer timer("PNG编码", util::TimerPrecision::Milliseconds);
+
+		size_t channels = 0;
+		switch (colorType)
+		{
+		case PngColorType::GERY: channels = 1; break;
+		case PngColorType::GERY_ALPHA: channels = 2; break;
+		case PngColorType::RGB: channels = 3; break;
+		case PngColorType::RGBA: channels = 4; break;
+		default:
+			return std::unexpected("PNG 编码不支持调色板图像");
+		}
+
+		if (width == 0 || height == 0 || width > 0x7FFFFFFFu || height > 0x7FFFFFFFu)
+		{
+			return std::unexpected("图像尺寸无效");
+		}
+
+		const size_t stride = static_cast<size_t>(width) * channels;
+		if (pixels.size() < stride * height)
+		{
+			return std::unexpected(fmt::format("像素数据不足: 需要 {} 字节，但只有 {} 字节", stride * height, pixels.size()));
+		}
+
+		// 1. 逐行滤波（每行只依赖原始像素，各行带可独立处理）
+		std::vector<uint8_t> filtered((stride + 1) * height);
+		FilterContext filterCtx{ pixels.data(), filtered.data(), stride, channels, height, height,
+			options.compression != PngCompression::Store };
+		{
+			util::FunctionTimer filterTimer("PNG编码: 滤波", util::TimerPrecision::Milliseconds);
+#if !defined(SHINE_PLATFORM_WASM) && !defined(__EMSCRIPTEN__)
+			const uint32_t threadCount = util::ThreadPool::Get().GetThreadCount() + 1;
+			if (options.parallel && filterCtx.adaptive && threadCount > 1 && height >= 64)
+			{
+				const uint32_t bandCount = (std::min)(height / 16, threadCount * 4);
+				filterCtx.rowsPerBand = (height + bandCount - 1) / bandCount;
+				util::TaskGroup group((height + filterCtx.rowsPerBand - 1) / filterCtx.rowsPerBand, filterBand, &filterCtx);
+				for (u32 band = 0; band * filterCtx.rowsPerBand < height; ++band)
+				{
+					group.Submit(band);
+				}
+				group.Wait();
+			}
+			else
+#endif
+			{
+				filterBand(&filterCtx, 0);
+			}
+		}
+
+		// 2. Zlib 压缩
+		util::DeflateLevel level = util::DeflateLevel::Default;
+		if (options.compression == PngCompression::Store) level = util::DeflateLevel::Store;
+		else if (options.compression == PngCompression::Fast) level = util::DeflateLevel::Fast;
+
+		std::vector<uint8_t> compressed;
+		{
+			util::FunctionTimer deflateTimer("PNG编码: Zlib压缩", util::TimerPrecision::Milliseconds);
+#if !defined(SHINE_PLATFORM_WASM) && !defined(__EMSCRIPTEN__)
+			const util::DeflateExecutor executor = options.parallel ? &util::TaskGroup::Run : nullptr;
+#else
+			const util::DeflateExecutor executor = nullptr;
+#endif
+			compressed = util::zlibCompress(filtered, level, executor);
+		}
+
+		// 3. 组装文件：签名 + IHDR + IDAT... + IEND
+		std::vector<uint8_t> out;
+		out.reserve(compressed.size() + compressed.size() / MAX_IDAT_SIZE * 12 + 64);
+
+		const uint8_t* signature = reinterpret_cast<const uint8_t*>(png_header.data());
+		out.insert(out.end(), signature, signature + 8);
+
+		std::vector<uint8_t> ihdr;
+		appendBe32(ihdr, width);
+		appendBe32(ihdr, height);
+		ihdr.push_back(8);                                 // 位深度
+		ihdr.push_back(static_cast<uint8_t>(colorType));   // 颜色类型
+		ihdr.push_back(0);                                 // 压缩方法
+		ihdr.push_back(0);                                 // 滤波方法
+		ihdr.push_back(0);                                 // 无交织
+		static constexpr std::array IHDR{ std::byte{'I'}, std::byte{'H'}, std::byte{'D'}, std::byte{'R'} };
+		appendChunk(out, IHDR, ihdr.data(), ihdr.size());
+
+		for (size_t offset = 0; offset < compressed.size(); offset += MAX_IDAT_SIZE)
+		{
+			appendChunk(out, IDAT, compressed.data() + offset, (std::min)(MAX_IDAT_SIZE, compressed.size() - offset));
+		}
+		appendChunk(out, IEND, nullptr, 0);
+
+		return out;
+	}
+
+	std::expected<void, std::string> png::encodeToFile(std::string_view filePath, std::span<const uint8_t> pixels,
+		uint32_t width, uint32_t height, PngColorType colorType, const PngEncodeOptions& options)
+	{
+		auto encoded = encode(pixels, width, height, colorType, options);
+		if (!encoded.has_value())
+		{
+			return std::unexpected(encoded.error());
+		}
+
+		if (!util::SaveData(SString::from_utf8(filePath), encoded->data(), encoded->size()))
+		{
+			return std::unexpected(fmt::format("写入文件失败: {}", filePath));
+		}
+		return {};
+	}
 }
 
 
@@ -7,6 +7,7 @@
 #include <span>
 #include <optional>
 #include <array>
+#include <functional>
 #include "loader/core/loader.h"
 #include "loader/image/image_loader.h"
 
@@ -175,6 +176,25 @@ namespace shine::image
 		uint8_t a = 0;  ///< Alpha 有效位深度
 	};
 
+	/**
+	 * @brief PNG 编码压缩级别
+	 */
+	enum class PngCompression : uint8_t
+	{
+		Store,    ///< 不压缩：None 滤波器 + 无压缩块，适合临时转储 GPU 回读数据
+		Fast,     ///< 快速压缩：自适应滤波 + 短哈希链贪心匹配
+		Default   ///< 默认压缩：自适应滤波 + 长哈希链惰性匹配
+	};
+
+	/**
+	 * @brief PNG 编码选项
+	 */
+	struct PngEncodeOptions
+	{
+		PngCompression compression = PngCompression::Default; ///< 压缩级别
+		bool parallel = true;  ///< 是否在 util::ThreadPool 上并行滤波与分块压缩
+	};
+
 	// ============================================================================
 	// PNG 解码器类
 	// ============================================================================
@@ -189,6 +209,7 @@ namespace shine::image
 	 * - 所有滤波器类型（None, Sub, Up, Average, Paeth）
 	 * - Zlib/Deflate 解压缩
 	 * - 完整的元数据支持（tEXt, zTXt, iTXt, tRNS, bKGD, pHYs, gAMA, cHRM, sRGB, cICP, mDCV, cLLI, sBIT）
+	 * - 8 位灰度/RGB/RGBA 编码（encode / encodeToFile）
 	 * 
 	 * @see https://www.w3.org/TR/png-3/
 	 */
@@ -358,6 +379,87 @@ namespace shine::image
 		 */
 		std::expected<std::vector<uint8_t>, std::string> decodeRGB();
 
+		/**
+		 * @brief 流式解码的行回调
+		 * 
+		 * 参数 y 为行号（从 0 开始），rgbaRow 为该行的 RGBA 数据（width * 4 字节），
+		 * 仅在回调期间有效。返回 false 中止解码。
+		 */
+		using ScanlineSink = std::function<bool(uint32_t y, std::span<const uint8_t> rgbaRow)>;
+
+		/**
+		 * @brief 流式解码 PNG 图像（有界内存）
+		 * 
+		 * 增量解压 IDAT 数据，每解出一条扫描线就解滤波、转换为 RGBA 并交给 sink。
+		 * 内存占用为两条扫描线 + 一行 RGBA + 32KB 解压窗口，不会填充 imageData，
+		 * 适合将超大图集直接解码到暂存缓冲区或 mip 生成器。
+		 * 
+		 * Adam7 交织图像的每一行要到最后一个通道才完整，因此退化为完整解码后逐行输出。
+		 * 
+		 * @param sink 行回调
+		 * @return 成功返回 void，失败或被 sink 中止返回错误信息
+		 */
+		std::expected<void, std::string> decodeStreaming(const ScanlineSink& sink);
+
+		/**
+		 * @brief 启用或关闭多线程解码（默认关闭）
+		 * 
+		 * 开启后，像素数不少于 minPixels 的图像在 decode() 中使用 util::ThreadPool：
+		 * - 非交织图像：解滤波（行间有依赖）在调用线程顺序执行，每完成一个行带就投递给工作线程
+		 *   做 RGBA 转换（调色板展开、16 位降为 8 位等），两者流水线并行；
+		 * - Adam7 图像：7 个通道互相独立，并行解滤波，随后按行带并行去交织并转换为 RGBA。
+		 * 
+		 * 调用线程在等待时会参与执行剩余任务，因此可以在线程池的工作线程中调用。
+		 * 
+		 * @param enable 是否启用
+		 * @param minPixels 启用多线程的最小像素数，小图像的调度开销大于收益
+		 */
+		void setParallelDecode(bool enable, size_t minPixels = 512 * 512) noexcept
+		{
+			_parallelDecode = enable;
+			_parallelMinPixels = minPixels;
+		}
+
+		/**
+		 * @brief 是否启用了多线程解码
+		 */
+		bool isParallelDecode() const noexcept { return _parallelDecode; }
+
+		// ========================================================================
+		// 公共接口：图像编码
+		// ========================================================================
+
+		/**
+		 * @brief 将 8 位像素数据编码为 PNG 文件数据
+		 * 
+		 * 每行自适应选择滤波器（Store 级别固定为 None），IDAT 数据按 256KB 分块独立压缩，
+		 * 每块用前一块末尾的 32KB 作为字典预热，开启 parallel 时分块压缩在 util::ThreadPool 上并行。
+		 * 
+		 * @param pixels 像素数据（行紧密排列，每行 width * 通道数 字节）
+		 * @param width 图像宽度
+		 * @param height 图像高度
+		 * @param colorType 像素格式（GERY / GERY_ALPHA / RGB / RGBA，不支持调色板）
+		 * @param options 编码选项
+		 * @return 成功返回 PNG 文件数据，失败返回错误信息
+		 */
+		static std::expected<std::vector<uint8_t>, std::string> encode(std::span<const uint8_t> pixels,
+			uint32_t width, uint32_t height, PngColorType colorType = PngColorType::RGBA,
+			const PngEncodeOptions& options = {});
+
+		/**
+		 * @brief 将 8 位像素数据编码为 PNG 并写入文件
+		 * @param filePath 输出文件路径
+		 * @param pixels 像素数据
+		 * @param width 图像宽度
+		 * @param height 图像高度
+		 * @param colorType 像素格式
+		 * @param options 编码选项
+		 * @return 成功返回 void，失败返回错误信息
+		 */
+		static std::expected<void, std::string> encodeToFile(std::string_view filePath, std::span<const uint8_t> pixels,
+			uint32_t width, uint32_t height, PngColorType colorType = PngColorType::RGBA,
+			const PngEncodeOptions& options = {});
+
 		/**
 		 * @brief 获取解码后的图像数据（RGBA 格式）
 		 * @return RGBA 图像数据向量引用（每像素 4 字节）
@@ -381,13 +483,38 @@ namespace shine::image
 		 */
 		std::expected<void, std::string> decodeInternal();
 
+		/**
+		 * @brief 多线程解码（解滤波与 RGBA 转换并行，结果写入 imageData）
+		 * @param decompressed 解压缩后的扫描线数据（含滤波器字节）
+		 * @param bytesPerPixel 每像素字节数（滤波器使用）
+		 * @param scanlineWidth 扫描线宽度（字节，不含滤波器字节）
+		 * @return 成功返回 void，失败返回错误信息
+		 */
+		std::expected<void, std::string> decodeParallel(
+			std::span<const uint8_t> decompressed, size_t bytesPerPixel, size_t scanlineWidth);
+
+		/**
+		 * @brief 滤波器使用的每像素字节数（低位深度按 1 字节计）
+		 * @return 每像素字节数，颜色类型无效时返回 0
+		 */
+		size_t filterBytesPerPixel() const noexcept;
+
+		/**
+		 * @brief 计算一条扫描线的字节数（不含滤波器字节）
+		 * @param width 扫描线像素数
+		 * @return 字节数（低位深度向上取整到字节边界）
+		 */
+		size_t scanlineBytes(uint32_t width) const noexcept;
+
 		/**
 		 * @brief Zlib/Deflate 解压缩
 		 * @param compressed 压缩的数据
+		 * @param sizeHint 预计解压大小（0 表示按输入估算）
+		 * @param maxOutput 输出大小上限（0 表示不限制），超出时返回错误
 		 * @return 成功返回解压缩数据，失败返回错误信息
 		 */
 		std::expected<std::vector<uint8_t>, std::string> zlibDecompress(
-			std::span<const uint8_t> compressed) const;
+			std::span<const uint8_t> compressed, size_t sizeHint = 0, size_t maxOutput = 0) const;
 
 		/**
 		 * @brief PNG 扫描线滤波器处理
@@ -454,24 +581,11 @@ namespace shine::image
 		void convertToRGBA(std::span<const uint8_t> rawData, std::vector<uint8_t>& output) const;
 
 		/**
-		 * @brief Paeth 预测器（用于 PNG 滤波器）
-		 * @param a 左像素值
-		 * @param b 上像素值
-		 * @param c 左上像素值
-		 * @return 预测值
+		 * @brief 颜色转换：将一条解滤波后的扫描线转换为 RGBA 格式
+		 * @param row 扫描线数据（低位深度时包含行尾填充位）
+		 * @param dst 输出 RGBA 数据（至少 width * 4 字节）
 		 */
-		static constexpr uint8_t paethPredictor(int a, int b, int c) noexcept
-		{
-			int p = a + b - c;
-			// Use constexpr-compatible abs implementation
-			auto abs_val = [](int x) constexpr -> int { return x < 0 ? -x : x; };
-			int pa = abs_val(p - a);
-			int pb = abs_val(p - b);
-			int pc = abs_val(p - c);
-			if (pa <= pb && pa <= pc) return static_cast<uint8_t>(a);
-			if (pb <= pc) return static_cast<uint8_t>(b);
-			return static_cast<uint8_t>(c);
-		}
+		void convertRowToRGBA(std::span<const uint8_t> row, uint8_t* dst) const;
 
 		// ========================================================================
 		// 成员变量：基本图像信息
@@ -488,6 +602,9 @@ namespace shine::image
 		uint8_t filterMethod = 0;       ///< 滤波器方法（0 = 标准）
 		uint8_t interlaceMethod = 0;     ///< 交织方法（0 = 无交织，1 = Adam7）
 
+		bool _parallelDecode = false;          ///< 是否启用多线程解码
+		size_t _parallelMinPixels = 512 * 512; ///< 启用多线程解码的最小像素数
+
 		PngColorType colorType = PngColorType::RGBA;  ///< 颜色类型
 
 		// ========================================================================
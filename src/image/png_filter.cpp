@@ -0,0 +1,710 @@
+#include "png_filter.h"
+
+#include <cstring>
+#include <utility>
+
+#if !defined(__EMSCRIPTEN__) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define SHINE_PNG_FILTER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif !defined(__EMSCRIPTEN__) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define SHINE_PNG_FILTER_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC/Clang 需要按函数开启指令集，MSVC 的 intrinsic 不依赖编译选项
+#if defined(SHINE_PNG_FILTER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SHINE_TARGET_SSE2 __attribute__((target("sse2")))
+#define SHINE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SHINE_TARGET_SSE2
+#define SHINE_TARGET_AVX2
+#endif
+
+/**
+ * @file png_filter.cpp
+ * @brief PNG 扫描线解滤波内核实现
+ *
+ * 所有 SIMD 内核与标量实现逐字节一致（见 test/PngFilterTest）。
+ */
+
+namespace shine::image::png_filter
+{
+	namespace
+	{
+		// ============================================================================
+		// 标量参考实现
+		// ============================================================================
+
+		void unfilterScalar(uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline,
+			size_t length, size_t bytewidth, uint8_t filterType) noexcept
+		{
+			const size_t head = bytewidth < length ? bytewidth : length;
+
+			switch (filterType)
+			{
+			case 1: // Sub
+				std::memcpy(recon, scanline, head);
+				for (size_t i = bytewidth; i < length; ++i)
+				{
+					recon[i] = static_cast<uint8_t>(scanline[i] + recon[i - bytewidth]);
+				}
+				break;
+
+			case 2: // Up
+				if (!prevline)
+				{
+					std::memcpy(recon, scanline, length);
+					break;
+				}
+				for (size_t i = 0; i < length; ++i)
+				{
+					recon[i] = static_cast<uint8_t>(scanline[i] + prevline[i]);
+				}
+				break;
+
+			case 3: // Average
+				if (prevline)
+				{
+					for (size_t i = 0; i < head; ++i)
+					{
+						recon[i] = static_cast<uint8_t>(scanline[i] + (prevline[i] >> 1));
+					}
+					for (size_t i = bytewidth; i < length; ++i)
+					{
+						recon[i] = static_cast<uint8_t>(scanline[i] + ((recon[i - bytewidth] + prevline[i]) >> 1));
+					}
+				}
+				else
+				{
+					std::memcpy(recon, scanline, head);
+					for (size_t i = bytewidth; i < length; ++i)
+					{
+						recon[i] = static_cast<uint8_t>(scanline[i] + (recon[i - bytewidth] >> 1));
+					}
+				}
+				break;
+
+			case 4: // Paeth
+				if (prevline)
+				{
+					for (size_t i = 0; i < head; ++i)
+					{
+						recon[i] = static_cast<uint8_t>(scanline[i] + prevline[i]);
+					}
+					for (size_t i = bytewidth; i < length; ++i)
+					{
+						recon[i] = static_cast<uint8_t>(scanline[i] +
+							paethPredictor(recon[i - bytewidth], prevline[i], prevline[i - bytewidth]));
+					}
+				}
+				else
+				{
+					// 上一行视为全 0 时 Paeth 退化为 Sub
+					std::memcpy(recon, scanline, head);
+					for (size_t i = bytewidth; i < length; ++i)
+					{
+						recon[i] = static_cast<uint8_t>(scanline[i] + recon[i - bytewidth]);
+					}
+				}
+				break;
+
+			default: // None / 未知滤波器类型
+				std::memcpy(recon, scanline, length);
+				break;
+			}
+		}
+
+		/**
+		 * @brief SIMD 内核覆盖的像素宽度
+		 */
+		constexpr bool isSimdBytewidth(size_t bytewidth) noexcept
+		{
+			return bytewidth == 3 || bytewidth == 4 || bytewidth == 6 || bytewidth == 8;
+		}
+
+#if defined(SHINE_PNG_FILTER_X86)
+		// ============================================================================
+		// x86 SSE2 / AVX2 内核
+		// ============================================================================
+
+		// 按 BPP 字节读写单个像素，避免越过行尾
+		template <size_t BPP>
+		SHINE_TARGET_SSE2 inline __m128i loadPixel(const uint8_t* p) noexcept
+		{
+			uint64_t v = 0;
+			std::memcpy(&v, p, BPP);
+			return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&v));
+		}
+
+		template <size_t BPP>
+		SHINE_TARGET_SSE2 inline void storePixel(uint8_t* p, __m128i x) noexcept
+		{
+			uint64_t v;
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(&v), x);
+			std::memcpy(p, &v, BPP);
+		}
+
+		SHINE_TARGET_SSE2 inline __m128i absEpi16(__m128i x) noexcept
+		{
+			return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+		}
+
+		SHINE_TARGET_SSE2 inline __m128i selectEpi16(__m128i mask, __m128i t, __m128i f) noexcept
+		{
+			return _mm_or_si128(_mm_and_si128(mask, t), _mm_andnot_si128(mask, f));
+		}
+
+		SHINE_TARGET_SSE2 void unfilterUpSSE2(uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline,
+			size_t length) noexcept
+		{
+			size_t i = 0;
+			for (; i + 16 <= length; i += 16)
+			{
+				const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(scanline + i));
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prevline + i));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(recon + i), _mm_add_epi8(x, b));
+			}
+			for (; i < length; ++i)
+			{
+				recon[i] = static_cast<uint8_t>(scanline[i] + prevline[i]);
+			}
+		}
+
+		SHINE_TARGET_AVX2 void unfilterUpAVX2(uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline,
+			size_t length) noexcept
+		{
+			size_t i = 0;
+			for (; i + 32 <= length; i += 32)
+			{
+				const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(scanline + i));
+				const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prevline + i));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(recon + i), _mm256_add_epi8(x, b));
+			}
+			for (; i < length; ++i)
+			{
+				recon[i] = static_cast<uint8_t>(scanline[i] + prevline[i]);
+			}
+		}
+
+		template <size_t BPP>
+		SHINE_TARGET_SSE2 void unfilterSubSSE2(uint8_t* recon, const uint8_t* scanline, size_t length) noexcept
+		{
+			__m128i a = _mm_setzero_si128();
+			size_t i = 0;
+			for (; i + BPP <= length; i += BPP)
+			{
+				a = _mm_add_epi8(loadPixel<BPP>(scanline + i), a);
+				storePixel<BPP>(recon + i, a);
+			}
+			for (; i < length; ++i)
+			{
+				recon[i] = static_cast<uint8_t>(scanline[i] + (i >= BPP ? recon[i - BPP] : 0));
+			}
+		}
+
+		template <size_t BPP, bool HasPrev>
+		SHINE_TARGET_SSE2 void unfilterAvgSSE2(uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline,
+			size_t length) noexcept
+		{
+			const __m128i one = _mm_set1_epi8(1);
+			__m128i a = _mm_setzero_si128();
+			size_t i = 0;
+			for (; i + BPP <= length; i += BPP)
+			{
+				const __m128i b = HasPrev ? loadPixel<BPP>(prevline + i) : _mm_setzero_si128();
+				// _mm_avg_epu8 向上取整，减去 (a ^ b) & 1 得到 (a + b) >> 1
+				const __m128i avg = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+				a = _mm_add_epi8(loadPixel<BPP>(scanline + i), avg);
+				storePixel<BPP>(recon + i, a);
+			}
+			for (; i < length; ++i)
+			{
+				const int left = i >= BPP ? recon[i - BPP] : 0;
+				const int up = HasPrev ? prevline[i] : 0;
+				recon[i] = static_cast<uint8_t>(scanline[i] + ((left + up) >> 1));
+			}
+		}
+
+		template <size_t BPP>
+		SHINE_TARGET_SSE2 void unfilterPaethSSE2(uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline,
+			size_t length) noexcept
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i lowByte = _mm_set1_epi16(0xFF);
+			__m128i a = zero;  // 左像素（已重建，16 位）
+			__m128i c = zero;  // 左上像素（16 位）
+			size_t i = 0;
+			for (; i + BPP <= length; i += BPP)
+			{
+				const __m128i b = _mm_unpacklo_epi8(loadPixel<BPP>(prevline + i), zero);
+				const __m128i x = _mm_unpacklo_epi8(loadPixel<BPP>(scanline + i), zero);
+
+				// p = a + b - c：pa = |b - c|（与 a 无关，不在依赖链上），pb = |a - c|，pc = |(b - c) + (a - c)|
+				const __m128i pa0 = _mm_sub_epi16(b, c);
+				const __m128i pa = absEpi16(pa0);
+				const __m128i pb0 = _mm_sub_epi16(a, c);
+				const __m128i pb = absEpi16(pb0);
+				const __m128i pc = absEpi16(_mm_add_epi16(pa0, pb0));
+
+				// 与规范判定顺序一致：pa <= pb && pa <= pc 取 a，否则 pb <= pc 取 b，否则取 c
+				const __m128i notA = _mm_or_si128(_mm_cmpgt_epi16(pa, pb), _mm_cmpgt_epi16(pa, pc));
+				const __m128i bc = selectEpi16(_mm_cmpgt_epi16(pb, pc), c, b);
+				const __m128i nearest = selectEpi16(notA, bc, a);
+
+				// 在 16 位通道内完成模 256 加法，打包只用于写回，不进入下一像素的依赖链
+				a = _mm_and_si128(_mm_add_epi16(x, nearest), lowByte);
+				storePixel<BPP>(recon + i, _mm_packus_epi16(a, a));
+				c = b;
+			}
+			for (; i < length; ++i)
+			{
+				const int left = i >= BPP ? recon[i - BPP] : 0;
+				const int upLeft = i >= BPP ? prevline[i - BPP] : 0;
+				recon[i] = static_cast<uint8_t>(scanline[i] + paethPredictor(left, prevline[i], upLeft));
+			}
+		}
+
+		template <size_t BPP>
+		void unfilterX86(UnfilterBackend backend, uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline,
+			size_t length, uint8_t filterType) noexcept
+		{
+			switch (filterType)
+			{
+			case 1:
+				unfilterSubSSE2<BPP>(recon, scanline, length);
+				break;
+			case 2:
+				if (!prevline)
+				{
+					std::memcpy(recon, scanline, length);
+				}
+				else if (backend == UnfilterBackend::AVX2)
+				{
+					unfilterUpAVX2(recon, scanline, prevline, length);
+				}
+				else
+				{
+					unfilterUpSSE2(recon, scanline, prevline, length);
+				}
+				break;
+			case 3:
+				if (prevline)
+				{
+					unfilterAvgSSE2<BPP, true>(recon, scanline, prevline, length);
+				}
+				else
+				{
+					unfilterAvgSSE2<BPP, false>(recon, scanline, nullptr, length);
+				}
+				break;
+			case 4:
+				if (prevline)
+				{
+					unfilterPaethSSE2<BPP>(recon, scanline, prevline, length);
+				}
+				else
+				{
+					unfilterSubSSE2<BPP>(recon, scanline, length);
+				}
+				break;
+			default:
+				std::memcpy(recon, scanline, length);
+				break;
+			}
+		}
+#endif // SHINE_PNG_FILTER_X86
+
+#if defined(SHINE_PNG_FILTER_NEON)
+		// ============================================================================
+		// ARM NEON 内核
+		// ============================================================================
+
+		template <size_t BPP>
+		inline uint8x8_t loadPixel(const uint8_t* p) noexcept
+		{
+			uint64_t v = 0;
+			std::memcpy(&v, p, BPP);
+			return vcreate_u8(v);
+		}
+
+		template <size_t BPP>
+		inline void storePixel(uint8_t* p, uint8x8_t x) noexcept
+		{
+			const uint64_t v = vget_lane_u64(vreinterpret_u64_u8(x), 0);
+			std::memcpy(p, &v, BPP);
+		}
+
+		void unfilterUpNEON(uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline, size_t length) noexcept
+		{
+			size_t i = 0;
+			for (; i + 16 <= length; i += 16)
+			{
+				vst1q_u8(recon + i, vaddq_u8(vld1q_u8(scanline + i), vld1q_u8(prevline + i)));
+			}
+			for (; i < length; ++i)
+			{
+				recon[i] = static_cast<uint8_t>(scanline[i] + prevline[i]);
+			}
+		}
+
+		template <size_t BPP>
+		void unfilterSubNEON(uint8_t* recon, const uint8_t* scanline, size_t length) noexcept
+		{
+			uint8x8_t a = vdup_n_u8(0);
+			size_t i = 0;
+			for (; i + BPP <= length; i += BPP)
+			{
+				a = vadd_u8(loadPixel<BPP>(scanline + i), a);
+				storePixel<BPP>(recon + i, a);
+			}
+			for (; i < length; ++i)
+			{
+				recon[i] = static_cast<uint8_t>(scanline[i] + (i >= BPP ? recon[i - BPP] : 0));
+			}
+		}
+
+		template <size_t BPP, bool HasPrev>
+		void unfilterAvgNEON(uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline, size_t length) noexcept
+		{
+			uint8x8_t a = vdup_n_u8(0);
+			size_t i = 0;
+			for (; i + BPP <= length; i += BPP)
+			{
+				const uint8x8_t b = HasPrev ? loadPixel<BPP>(prevline + i) : vdup_n_u8(0);
+				// vhadd_u8 即 (a + b) >> 1（向下取整）
+				a = vadd_u8(loadPixel<BPP>(scanline + i), vhadd_u8(a, b));
+				storePixel<BPP>(recon + i, a);
+			}
+			for (; i < length; ++i)
+			{
+				const int left = i >= BPP ? recon[i - BPP] : 0;
+				const int up = HasPrev ? prevline[i] : 0;
+				recon[i] = static_cast<uint8_t>(scanline[i] + ((left + up) >> 1));
+			}
+		}
+
+		template <size_t BPP>
+		void unfilterPaethNEON(uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline, size_t length) noexcept
+		{
+			uint8x8_t a8 = vdup_n_u8(0);
+			int16x8_t c = vdupq_n_s16(0);
+			size_t i = 0;
+			for (; i + BPP <= length; i += BPP)
+			{
+				const int16x8_t a = vreinterpretq_s16_u16(vmovl_u8(a8));
+				const int16x8_t b = vreinterpretq_s16_u16(vmovl_u8(loadPixel<BPP>(prevline + i)));
+
+				const int16x8_t pa0 = vsubq_s16(b, c);
+				const int16x8_t pb0 = vsubq_s16(a, c);
+				const int16x8_t pc = vabsq_s16(vaddq_s16(pa0, pb0));
+				const int16x8_t pa = vabsq_s16(pa0);
+				const int16x8_t pb = vabsq_s16(pb0);
+
+				const int16x8_t bc = vbslq_s16(vcleq_s16(pb, pc), b, c);
+				const uint16x8_t useA = vandq_u16(vcleq_s16(pa, pb), vcleq_s16(pa, pc));
+				const int16x8_t nearest = vbslq_s16(useA, a, bc);
+
+				a8 = vadd_u8(loadPixel<BPP>(scanline + i), vmovn_u16(vreinterpretq_u16_s16(nearest)));
+				storePixel<BPP>(recon + i, a8);
+				c = b;
+			}
+			for (; i < length; ++i)
+			{
+				const int left = i >= BPP ? recon[i - BPP] : 0;
+				const int upLeft = i >= BPP ? prevline[i - BPP] : 0;
+				recon[i] = static_cast<uint8_t>(scanline[i] + paethPredictor(left, prevline[i], upLeft));
+			}
+		}
+
+		template <size_t BPP>
+		void unfilterNEON(uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline,
+			size_t length, uint8_t filterType) noexcept
+		{
+			switch (filterType)
+			{
+			case 1:
+				unfilterSubNEON<BPP>(recon, scanline, length);
+				break;
+			case 2:
+				if (prevline)
+				{
+					unfilterUpNEON(recon, scanline, prevline, length);
+				}
+				else
+				{
+					std::memcpy(recon, scanline, length);
+				}
+				break;
+			case 3:
+				if (prevline)
+				{
+					unfilterAvgNEON<BPP, true>(recon, scanline, prevline, length);
+				}
+				else
+				{
+					unfilterAvgNEON<BPP, false>(recon, scanline, nullptr, length);
+				}
+				break;
+			case 4:
+				if (prevline)
+				{
+					unfilterPaethNEON<BPP>(recon, scanline, prevline, length);
+				}
+				else
+				{
+					unfilterSubNEON<BPP>(recon, scanline, length);
+				}
+				break;
+			default:
+				std::memcpy(recon, scanline, length);
+				break;
+			}
+		}
+#endif // SHINE_PNG_FILTER_NEON
+
+		// ============================================================================
+		// 运行时检测
+		// ============================================================================
+
+#if defined(SHINE_PNG_FILTER_X86)
+		bool cpuHasSSE2() noexcept
+		{
+#if defined(__x86_64__) || defined(_M_X64)
+			return true; // x86-64 基线
+#elif defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 1);
+			return (info[3] & (1 << 26)) != 0;
+#else
+			return __builtin_cpu_supports("sse2");
+#endif
+		}
+
+		bool cpuHasAVX2() noexcept
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7)
+			{
+				return false;
+			}
+			__cpuid(info, 1);
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+			const bool avx = (info[2] & (1 << 28)) != 0;
+			if (!osxsave || !avx)
+			{
+				return false;
+			}
+			// 操作系统需保存 XMM/YMM 状态
+			if ((_xgetbv(0) & 0x6) != 0x6)
+			{
+				return false;
+			}
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			return __builtin_cpu_supports("avx2");
+#endif
+		}
+#endif
+
+		UnfilterBackend detectBackend() noexcept
+		{
+#if defined(SHINE_PNG_FILTER_X86)
+			if (cpuHasAVX2())
+			{
+				return UnfilterBackend::AVX2;
+			}
+			if (cpuHasSSE2())
+			{
+				return UnfilterBackend::SSE2;
+			}
+#elif defined(SHINE_PNG_FILTER_NEON)
+			return UnfilterBackend::NEON;
+#endif
+			return UnfilterBackend::Scalar;
+		}
+	} // namespace
+
+	UnfilterBackend activeBackend() noexcept
+	{
+		static const UnfilterBackend backend = detectBackend();
+		return backend;
+	}
+
+	bool isBackendSupported(UnfilterBackend backend) noexcept
+	{
+		switch (backend)
+		{
+		case UnfilterBackend::Scalar:
+			return true;
+#if defined(SHINE_PNG_FILTER_X86)
+		case UnfilterBackend::SSE2:
+			return cpuHasSSE2();
+		case UnfilterBackend::AVX2:
+			return cpuHasAVX2();
+#elif defined(SHINE_PNG_FILTER_NEON)
+		case UnfilterBackend::NEON:
+			return true;
+#endif
+		default:
+			return false;
+		}
+	}
+
+	const char* backendName(UnfilterBackend backend) noexcept
+	{
+		switch (backend)
+		{
+		case UnfilterBackend::Scalar: return "Scalar";
+		case UnfilterBackend::SSE2: return "SSE2";
+		case UnfilterBackend::AVX2: return "AVX2";
+		case UnfilterBackend::NEON: return "NEON";
+		}
+		return "Unknown";
+	}
+
+	void unfilterScanline(uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline,
+		size_t length, size_t bytewidth, uint8_t filterType) noexcept
+	{
+		unfilterScanline(activeBackend(), recon, scanline, prevline, length, bytewidth, filterType);
+	}
+
+	void unfilterScanline(UnfilterBackend backend, uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline,
+		size_t length, size_t bytewidth, uint8_t filterType) noexcept
+	{
+		if (backend == UnfilterBackend::Scalar || !isSimdBytewidth(bytewidth) || !isBackendSupported(backend))
+		{
+			unfilterScalar(recon, scanline, prevline, length, bytewidth, filterType);
+			return;
+		}
+
+#if defined(SHINE_PNG_FILTER_X86)
+		switch (bytewidth)
+		{
+		case 3: unfilterX86<3>(backend, recon, scanline, prevline, length, filterType); return;
+		case 4: unfilterX86<4>(backend, recon, scanline, prevline, length, filterType); return;
+		case 6: unfilterX86<6>(backend, recon, scanline, prevline, length, filterType); return;
+		case 8: unfilterX86<8>(backend, recon, scanline, prevline, length, filterType); return;
+		default: break;
+		}
+#elif defined(SHINE_PNG_FILTER_NEON)
+		switch (bytewidth)
+		{
+		case 3: unfilterNEON<3>(recon, scanline, prevline, length, filterType); return;
+		case 4: unfilterNEON<4>(recon, scanline, prevline, length, filterType); return;
+		case 6: unfilterNEON<6>(recon, scanline, prevline, length, filterType); return;
+		case 8: unfilterNEON<8>(recon, scanline, prevline, length, filterType); return;
+		default: break;
+		}
+#endif
+		unfilterScalar(recon, scanline, prevline, length, bytewidth, filterType);
+	}
+
+	void filterScanline(uint8_t* out, const uint8_t* scanline, const uint8_t* prevline,
+		size_t length, size_t bytewidth, uint8_t filterType) noexcept
+	{
+		const size_t head = bytewidth < length ? bytewidth : length;
+
+		switch (filterType)
+		{
+		case 1: // Sub
+			std::memcpy(out, scanline, head);
+			for (size_t i = bytewidth; i < length; ++i)
+			{
+				out[i] = static_cast<uint8_t>(scanline[i] - scanline[i - bytewidth]);
+			}
+			break;
+
+		case 2: // Up
+			if (!prevline)
+			{
+				std::memcpy(out, scanline, length);
+				break;
+			}
+			for (size_t i = 0; i < length; ++i)
+			{
+				out[i] = static_cast<uint8_t>(scanline[i] - prevline[i]);
+			}
+			break;
+
+		case 3: // Average
+			for (size_t i = 0; i < head; ++i)
+			{
+				out[i] = static_cast<uint8_t>(scanline[i] - (prevline ? prevline[i] >> 1 : 0));
+			}
+			for (size_t i = bytewidth; i < length; ++i)
+			{
+				const int up = prevline ? prevline[i] : 0;
+				out[i] = static_cast<uint8_t>(scanline[i] - ((scanline[i - bytewidth] + up) >> 1));
+			}
+			break;
+
+		case 4: // Paeth
+			if (!prevline)
+			{
+				// 上一行视为全 0 时 Paeth 退化为 Sub
+				filterScanline(out, scanline, nullptr, length, bytewidth, 1);
+				break;
+			}
+			for (size_t i = 0; i < head; ++i)
+			{
+				out[i] = static_cast<uint8_t>(scanline[i] - prevline[i]);
+			}
+			for (size_t i = bytewidth; i < length; ++i)
+			{
+				out[i] = static_cast<uint8_t>(scanline[i] -
+					paethPredictor(scanline[i - bytewidth], prevline[i], prevline[i - bytewidth]));
+			}
+			break;
+
+		default: // None
+			std::memcpy(out, scanline, length);
+			break;
+		}
+	}
+
+	uint8_t filterScanlineAdaptive(uint8_t* out, uint8_t* scratch, const uint8_t* scanline, const uint8_t* prevline,
+		size_t length, size_t bytewidth) noexcept
+	{
+		auto cost = [length](const uint8_t* data)
+		{
+			uint64_t sum = 0;
+			for (size_t i = 0; i < length; ++i)
+			{
+				const int v = static_cast<int8_t>(data[i]);
+				sum += static_cast<uint64_t>(v < 0 ? -v : v);
+			}
+			return sum;
+		};
+
+		uint8_t* best = out;
+		uint8_t* trial = scratch;
+		uint8_t bestFilter = 0;
+		filterScanline(best, scanline, prevline, length, bytewidth, 0);
+		uint64_t bestCost = cost(best);
+
+		for (uint8_t filter = 1; filter <= 4; ++filter)
+		{
+			filterScanline(trial, scanline, prevline, length, bytewidth, filter);
+			const uint64_t trialCost = cost(trial);
+			if (trialCost < bestCost)
+			{
+				bestCost = trialCost;
+				bestFilter = filter;
+				std::swap(best, trial);
+			}
+		}
+
+		if (best != out)
+		{
+			std::memcpy(out, best, length);
+		}
+		return bestFilter;
+	}
+
+} // namespace shine::image::png_filter
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @file png_filter.h
+ * @brief PNG 扫描线解滤波内核（Sub / Up / Average / Paeth）与编码用的滤波
+ *
+ * 提供标量参考实现与 SSE2 / AVX2 / NEON 内核，运行时按 CPU 特性分派。
+ * SIMD 内核覆盖每像素 3/4/6/8 字节（8 位与 16 位的 RGB/RGBA），
+ * 其余像素宽度（灰度、灰度+Alpha、低位深度）走标量路径。
+ *
+ * Sub/Average/Paeth 在行内存在逐像素依赖，SIMD 内核按“一次一个像素、像素内各字节并行”的方式处理；
+ * Up 没有行内依赖，按 16/32 字节整块处理。
+ *
+ * @see https://www.w3.org/TR/png-3/#9Filters
+ */
+
+namespace shine::image::png_filter
+{
+	/**
+	 * @brief 解滤波内核实现
+	 */
+	enum class UnfilterBackend : uint8_t
+	{
+		Scalar = 0,  ///< 标量参考实现
+		SSE2,        ///< x86 SSE2
+		AVX2,        ///< x86 AVX2（Up 使用 256 位，其余与 SSE2 相同）
+		NEON         ///< ARM NEON
+	};
+
+	/**
+	 * @brief Paeth 预测器（无分支版本，与 PNG 规范的判定顺序一致）
+	 * @param a 左像素值
+	 * @param b 上像素值
+	 * @param c 左上像素值
+	 * @return 预测值
+	 */
+	constexpr uint8_t paethPredictor(int a, int b, int c) noexcept
+	{
+		// p = a + b - c，则 |p-a| = |b-c|，|p-b| = |a-c|，|p-c| = |a+b-2c|
+		const int pa0 = b - c;
+		const int pb0 = a - c;
+		const int pa = pa0 < 0 ? -pa0 : pa0;
+		const int pb = pb0 < 0 ? -pb0 : pb0;
+		const int pc = (pa0 + pb0) < 0 ? -(pa0 + pb0) : (pa0 + pb0);
+		const int bc = (pb <= pc) ? b : c;
+		return static_cast<uint8_t>((pa <= pb && pa <= pc) ? a : bc);
+	}
+
+	/**
+	 * @brief 当前 CPU 上选用的内核实现（首次调用时检测并缓存）
+	 */
+	UnfilterBackend activeBackend() noexcept;
+
+	/**
+	 * @brief 检查指定内核在当前 CPU / 编译配置下是否可用
+	 */
+	bool isBackendSupported(UnfilterBackend backend) noexcept;
+
+	/**
+	 * @brief 获取内核名称（用于日志与测试输出）
+	 */
+	const char* backendName(UnfilterBackend backend) noexcept;
+
+	/**
+	 * @brief 解滤波一条扫描线（自动选择最快的可用内核）
+	 * @param recon 重建的扫描线（输出，length 字节）
+	 * @param scanline 当前扫描线（输入，不含滤波器字节）
+	 * @param prevline 前一条已重建的扫描线（第一行为 nullptr）
+	 * @param length 扫描线字节数
+	 * @param bytewidth 每像素字节数（低位深度按 1 计）
+	 * @param filterType 滤波器类型（0-4，其他值按 None 处理）
+	 */
+	void unfilterScanline(uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline,
+		size_t length, size_t bytewidth, uint8_t filterType) noexcept;
+
+	/**
+	 * @brief 使用指定内核解滤波一条扫描线
+	 *
+	 * 内核不可用或像素宽度不在 SIMD 覆盖范围内时回退到标量实现，
+	 * 主要用于逐字节对比测试与性能测试。
+	 */
+	void unfilterScanline(UnfilterBackend backend, uint8_t* recon, const uint8_t* scanline, const uint8_t* prevline,
+		size_t length, size_t bytewidth, uint8_t filterType) noexcept;
+
+	/**
+	 * @brief 滤波一条扫描线（编码使用，unfilterScanline 的逆运算）
+	 * @param out 滤波后的扫描线（输出，length 字节，不含滤波器字节）
+	 * @param scanline 原始扫描线
+	 * @param prevline 前一条原始扫描线（第一行为 nullptr）
+	 * @param length 扫描线字节数
+	 * @param bytewidth 每像素字节数
+	 * @param filterType 滤波器类型（0-4，其他值按 None 处理）
+	 */
+	void filterScanline(uint8_t* out, const uint8_t* scanline, const uint8_t* prevline,
+		size_t length, size_t bytewidth, uint8_t filterType) noexcept;
+
+	/**
+	 * @brief 自适应选择滤波器并滤波一条扫描线
+	 *
+	 * 逐个尝试 5 种滤波器，选择输出按有符号字节计算的绝对值之和最小的一种
+	 * （PNG 规范推荐的“最小绝对差之和”启发式）。
+	 *
+	 * @param out 滤波后的扫描线（输出，length 字节，不含滤波器字节）
+	 * @param scratch 临时缓冲区（length 字节）
+	 * @return 选用的滤波器类型
+	 */
+	uint8_t filterScanlineAdaptive(uint8_t* out, uint8_t* scratch, const uint8_t* scanline, const uint8_t* prevline,
+		size_t length, size_t bytewidth) noexcept;
+
+} // namespace shine::image::png_filter
@@ -0,0 +1,2054 @@
+#include "vp8.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "util/thread/task_group.h"
+#include "vp8_dsp.h"
+
+/**
+ * @file vp8.cpp
+ * @brief VP8 关键帧解码实现
+ *
+ * 熵解码、概率表和重建顺序与 libwebp（src/dec）一致：每个宏块在 32 字节跨度的工作缓冲中
+ * 预测并叠加残差，左侧样本取自上一个宏块，上方样本取自保存的未滤波行，
+ * 然后复制到整帧的 Y/U/V 平面。环路滤波直接在平面上进行，不影响后续宏块的预测。
+ */
+
+namespace shine::image::vp8
+{
+	namespace
+	{
+		// ============================================================================
+		// 常量与概率表
+		// ============================================================================
+
+		constexpr int kNumSegments = 4;
+		constexpr int kNumBModes = 10;
+
+		/// 帧内预测模式（16x16 与色度只用前四种）
+		enum PredMode : uint8_t
+		{
+			B_DC_PRED = 0,
+			B_TM_PRED,
+			B_VE_PRED,
+			B_HE_PRED,
+			B_RD_PRED,
+			B_VR_PRED,
+			B_LD_PRED,
+			B_VL_PRED,
+			B_HD_PRED,
+			B_HU_PRED
+		};
+
+		/// 量化索引 -> DC 量化步长（RFC 6386 14.1）
+		constexpr uint8_t kDcTable[128] = {
+			4, 5, 6, 7, 8, 9, 10, 10, 11, 12, 13, 14, 15, 16, 17, 17,
+			18, 19, 20, 20, 21, 21, 22, 22, 23, 23, 24, 25, 25, 26, 27, 28,
+			29, 30, 31, 32, 33, 34, 35, 36, 37, 37, 38, 39, 40, 41, 42, 43,
+			44, 45, 46, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58,
+			59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74,
+			75, 76, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89,
+			91, 93, 95, 96, 98, 100, 101, 102, 104, 106, 108, 110, 112, 114, 116, 118,
+			122, 124, 126, 128, 130, 132, 134, 136, 138, 140, 143, 145, 148, 151, 154, 157
+		};
+
+		/// 量化索引 -> AC 量化步长
+		constexpr uint16_t kAcTable[128] = {
+			4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19,
+			20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35,
+			36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,
+			52, 53, 54, 55, 56, 57, 58, 60, 62, 64, 66, 68, 70, 72, 74, 76,
+			78, 80, 82, 84, 86, 88, 90, 92, 94, 96, 98, 100, 102, 104, 106, 108,
+			110, 112, 114, 116, 119, 122, 125, 128, 131, 134, 137, 140, 143, 146, 149, 152,
+			155, 158, 161, 164, 167, 170, 173, 177, 181, 185, 189, 193, 197, 201, 205, 209,
+			213, 217, 221, 225, 229, 234, 239, 245, 249, 254, 259, 264, 269, 274, 279, 284
+		};
+
+		/// 系数概率的更新概率（RFC 6386 13.4）
+		constexpr uint8_t kCoeffsUpdateProba[4][8][3][11] = {
+			{
+				{
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 176, 246, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 223, 241, 252, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 249, 253, 253, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 244, 252, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 234, 254, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 253, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 246, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 239, 253, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 254, 255, 254, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 248, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 251, 255, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 253, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 251, 254, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 254, 255, 254, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 254, 253, 255, 254, 255, 255, 255, 255, 255, 255 },
+					{ 250, 255, 254, 255, 254, 255, 255, 255, 255, 255, 255 },
+					{ 254, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				}
+			},
+			{
+				{
+					{ 217, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 225, 252, 241, 253, 255, 255, 254, 255, 255, 255, 255 },
+					{ 234, 250, 241, 250, 253, 255, 253, 254, 255, 255, 255 }
+				},
+				{
+					{ 255, 254, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 223, 254, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 238, 253, 254, 254, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 248, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 249, 254, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 253, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 247, 254, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 253, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 252, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 254, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 253, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 254, 253, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 250, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 254, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				}
+			},
+			{
+				{
+					{ 186, 251, 250, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 234, 251, 244, 254, 255, 255, 255, 255, 255, 255, 255 },
+					{ 251, 251, 243, 253, 254, 255, 254, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 253, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 236, 253, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 251, 253, 253, 254, 254, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 254, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 254, 254, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 254, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 254, 254, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 254, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 254, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				}
+			},
+			{
+				{
+					{ 248, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 250, 254, 252, 254, 255, 255, 255, 255, 255, 255, 255 },
+					{ 248, 254, 249, 253, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 253, 253, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 246, 253, 253, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 252, 254, 251, 254, 254, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 254, 252, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 248, 254, 253, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 253, 255, 254, 254, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 251, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 245, 251, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 253, 253, 254, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 251, 253, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 252, 253, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 254, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 252, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 249, 255, 254, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 254, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 255, 253, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 250, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				},
+				{
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 254, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 },
+					{ 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255 }
+				}
+			}
+		};
+
+		/// 系数概率的默认值（RFC 6386 13.5）
+		constexpr uint8_t kCoeffsProba0[4][8][3][11] = {
+			{
+				{
+					{ 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128 },
+					{ 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128 },
+					{ 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128 }
+				},
+				{
+					{ 253, 136, 254, 255, 228, 219, 128, 128, 128, 128, 128 },
+					{ 189, 129, 242, 255, 227, 213, 255, 219, 128, 128, 128 },
+					{ 106, 126, 227, 252, 214, 209, 255, 255, 128, 128, 128 }
+				},
+				{
+					{ 1, 98, 248, 255, 236, 226, 255, 255, 128, 128, 128 },
+					{ 181, 133, 238, 254, 221, 234, 255, 154, 128, 128, 128 },
+					{ 78, 134, 202, 247, 198, 180, 255, 219, 128, 128, 128 }
+				},
+				{
+					{ 1, 185, 249, 255, 243, 255, 128, 128, 128, 128, 128 },
+					{ 184, 150, 247, 255, 236, 224, 128, 128, 128, 128, 128 },
+					{ 77, 110, 216, 255, 236, 230, 128, 128, 128, 128, 128 }
+				},
+				{
+					{ 1, 101, 251, 255, 241, 255, 128, 128, 128, 128, 128 },
+					{ 170, 139, 241, 252, 236, 209, 255, 255, 128, 128, 128 },
+					{ 37, 116, 196, 243, 228, 255, 255, 255, 128, 128, 128 }
+				},
+				{
+					{ 1, 204, 254, 255, 245, 255, 128, 128, 128, 128, 128 },
+					{ 207, 160, 250, 255, 238, 128, 128, 128, 128, 128, 128 },
+					{ 102, 103, 231, 255, 211, 171, 128, 128, 128, 128, 128 }
+				},
+				{
+					{ 1, 152, 252, 255, 240, 255, 128, 128, 128, 128, 128 },
+					{ 177, 135, 243, 255, 234, 225, 128, 128, 128, 128, 128 },
+					{ 80, 129, 211, 255, 194, 224, 128, 128, 128, 128, 128 }
+				},
+				{
+					{ 1, 1, 255, 128, 128, 128, 128, 128, 128, 128, 128 },
+					{ 246, 1, 255, 128, 128, 128, 128, 128, 128, 128, 128 },
+					{ 255, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128 }
+				}
+			},
+			{
+				{
+					{ 198, 35, 237, 223, 193, 187, 162, 160, 145, 155, 62 },
+					{ 131, 45, 198, 221, 172, 176, 220, 157, 252, 221, 1 },
+					{ 68, 47, 146, 208, 149, 167, 221, 162, 255, 223, 128 }
+				},
+				{
+					{ 1, 149, 241, 255, 221, 224, 255, 255, 128, 128, 128 },
+					{ 184, 141, 234, 253, 222, 220, 255, 199, 128, 128, 128 },
+					{ 81, 99, 181, 242, 176, 190, 249, 202, 255, 255, 128 }
+				},
+				{
+					{ 1, 129, 232, 253, 214, 197, 242, 196, 255, 255, 128 },
+					{ 99, 121, 210, 250, 201, 198, 255, 202, 128, 128, 128 },
+					{ 23, 91, 163, 242, 170, 187, 247, 210, 255, 255, 128 }
+				},
+				{
+					{ 1, 200, 246, 255, 234, 255, 128, 128, 128, 128, 128 },
+					{ 109, 178, 241, 255, 231, 245, 255, 255, 128, 128, 128 },
+					{ 44, 130, 201, 253, 205, 192, 255, 255, 128, 128, 128 }
+				},
+				{
+					{ 1, 132, 239, 251, 219, 209, 255, 165, 128, 128, 128 },
+					{ 94, 136, 225, 251, 218, 190, 255, 255, 128, 128, 128 },
+					{ 22, 100, 174, 245, 186, 161, 255, 199, 128, 128, 128 }
+				},
+				{
+					{ 1, 182, 249, 255, 232, 235, 128, 128, 128, 128, 128 },
+					{ 124, 143, 241, 255, 227, 234, 128, 128, 128, 128, 128 },
+					{ 35, 77, 181, 251, 193, 211, 255, 205, 128, 128, 128 }
+				},
+				{
+					{ 1, 157, 247, 255, 236, 231, 255, 255, 128, 128, 128 },
+					{ 121, 141, 235, 255, 225, 227, 255, 255, 128, 128, 128 },
+					{ 45, 99, 188, 251, 195, 217, 255, 224, 128, 128, 128 }
+				},
+				{
+					{ 1, 1, 251, 255, 213, 255, 128, 128, 128, 128, 128 },
+					{ 203, 1, 248, 255, 255, 128, 128, 128, 128, 128, 128 },
+					{ 137, 1, 177, 255, 224, 255, 128, 128, 128, 128, 128 }
+				}
+			},
+			{
+				{
+					{ 253, 9, 248, 251, 207, 208, 255, 192, 128, 128, 128 },
+					{ 175, 13, 224, 243, 193, 185, 249, 198, 255, 255, 128 },
+					{ 73, 17, 171, 221, 161, 179, 236, 167, 255, 234, 128 }
+				},
+				{
+					{ 1, 95, 247, 253, 212, 183, 255, 255, 128, 128, 128 },
+					{ 239, 90, 244, 250, 211, 209, 255, 255, 128, 128, 128 },
+					{ 155, 77, 195, 248, 188, 195, 255, 255, 128, 128, 128 }
+				},
+				{
+					{ 1, 24, 239, 251, 218, 219, 255, 205, 128, 128, 128 },
+					{ 201, 51, 219, 255, 196, 186, 128, 128, 128, 128, 128 },
+					{ 69, 46, 190, 239, 201, 218, 255, 228, 128, 128, 128 }
+				},
+				{
+					{ 1, 191, 251, 255, 255, 128, 128, 128, 128, 128, 128 },
+					{ 223, 165, 249, 255, 213, 255, 128, 128, 128, 128, 128 },
+					{ 141, 124, 248, 255, 255, 128, 128, 128, 128, 128, 128 }
+				},
+				{
+					{ 1, 16, 248, 255, 255, 128, 128, 128, 128, 128, 128 },
+					{ 190, 36, 230, 255, 236, 255, 128, 128, 128, 128, 128 },
+					{ 149, 1, 255, 128, 128, 128, 128, 128, 128, 128, 128 }
+				},
+				{
+					{ 1, 226, 255, 128, 128, 128, 128, 128, 128, 128, 128 },
+					{ 247, 192, 255, 128, 128, 128, 128, 128, 128, 128, 128 },
+					{ 240, 128, 255, 128, 128, 128, 128, 128, 128, 128, 128 }
+				},
+				{
+					{ 1, 134, 252, 255, 255, 128, 128, 128, 128, 128, 128 },
+					{ 213, 62, 250, 255, 255, 128, 128, 128, 128, 128, 128 },
+					{ 55, 93, 255, 128, 128, 128, 128, 128, 128, 128, 128 }
+				},
+				{
+					{ 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128 },
+					{ 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128 },
+					{ 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128 }
+				}
+			},
+			{
+				{
+					{ 202, 24, 213, 235, 186, 191, 220, 160, 240, 175, 255 },
+					{ 126, 38, 182, 232, 169, 184, 228, 174, 255, 187, 128 },
+					{ 61, 46, 138, 219, 151, 178, 240, 170, 255, 216, 128 }
+				},
+				{
+					{ 1, 112, 230, 250, 199, 191, 247, 159, 255, 255, 128 },
+					{ 166, 109, 228, 252, 211, 215, 255, 174, 128, 128, 128 },
+					{ 39, 77, 162, 232, 172, 180, 245, 178, 255, 255, 128 }
+				},
+				{
+					{ 1, 52, 220, 246, 198, 199, 249, 220, 255, 255, 128 },
+					{ 124, 74, 191, 243, 183, 193, 250, 221, 255, 255, 128 },
+					{ 24, 71, 130, 219, 154, 170, 243, 182, 255, 255, 128 }
+				},
+				{
+					{ 1, 182, 225, 249, 219, 240, 255, 224, 128, 128, 128 },
+					{ 149, 150, 226, 252, 216, 205, 255, 171, 128, 128, 128 },
+					{ 28, 108, 170, 242, 183, 194, 254, 223, 255, 255, 128 }
+				},
+				{
+					{ 1, 81, 230, 252, 204, 203, 255, 192, 128, 128, 128 },
+					{ 123, 102, 209, 247, 188, 196, 255, 233, 128, 128, 128 },
+					{ 20, 95, 153, 243, 164, 173, 255, 203, 128, 128, 128 }
+				},
+				{
+					{ 1, 222, 248, 255, 216, 213, 128, 128, 128, 128, 128 },
+					{ 168, 175, 246, 252, 235, 205, 255, 255, 128, 128, 128 },
+					{ 47, 116, 215, 255, 211, 212, 255, 255, 128, 128, 128 }
+				},
+				{
+					{ 1, 121, 236, 253, 212, 214, 255, 255, 128, 128, 128 },
+					{ 141, 84, 213, 252, 201, 202, 255, 219, 128, 128, 128 },
+					{ 42, 80, 160, 240, 162, 185, 255, 205, 128, 128, 128 }
+				},
+				{
+					{ 1, 1, 255, 128, 128, 128, 128, 128, 128, 128, 128 },
+					{ 244, 1, 255, 128, 128, 128, 128, 128, 128, 128, 128 },
+					{ 238, 1, 255, 128, 128, 128, 128, 128, 128, 128, 128 }
+				}
+			}
+		};
+
+		/// 4x4 帧内模式概率，按 [上方模式][左侧模式] 索引（RFC 6386 11.5）
+		constexpr uint8_t kBModesProba[10][10][9] = {
+			{
+				{ 231, 120, 48, 89, 115, 113, 120, 152, 112 },
+				{ 152, 179, 64, 126, 170, 118, 46, 70, 95 },
+				{ 175, 69, 143, 80, 85, 82, 72, 155, 103 },
+				{ 56, 58, 10, 171, 218, 189, 17, 13, 152 },
+				{ 114, 26, 17, 163, 44, 195, 21, 10, 173 },
+				{ 121, 24, 80, 195, 26, 62, 44, 64, 85 },
+				{ 144, 71, 10, 38, 171, 213, 144, 34, 26 },
+				{ 170, 46, 55, 19, 136, 160, 33, 206, 71 },
+				{ 63, 20, 8, 114, 114, 208, 12, 9, 226 },
+				{ 81, 40, 11, 96, 182, 84, 29, 16, 36 }
+			},
+			{
+				{ 134, 183, 89, 137, 98, 101, 106, 165, 148 },
+				{ 72, 187, 100, 130, 157, 111, 32, 75, 80 },
+				{ 66, 102, 167, 99, 74, 62, 40, 234, 128 },
+				{ 41, 53, 9, 178, 241, 141, 26, 8, 107 },
+				{ 74, 43, 26, 146, 73, 166, 49, 23, 157 },
+				{ 65, 38, 105, 160, 51, 52, 31, 115, 128 },
+				{ 104, 79, 12, 27, 217, 255, 87, 17, 7 },
+				{ 87, 68, 71, 44, 114, 51, 15, 186, 23 },
+				{ 47, 41, 14, 110, 182, 183, 21, 17, 194 },
+				{ 66, 45, 25, 102, 197, 189, 23, 18, 22 }
+			},
+			{
+				{ 88, 88, 147, 150, 42, 46, 45, 196, 205 },
+				{ 43, 97, 183, 117, 85, 38, 35, 179, 61 },
+				{ 39, 53, 200, 87, 26, 21, 43, 232, 171 },
+				{ 56, 34, 51, 104, 114, 102, 29, 93, 77 },
+				{ 39, 28, 85, 171, 58, 165, 90, 98, 64 },
+				{ 34, 22, 116, 206, 23, 34, 43, 166, 73 },
+				{ 107, 54, 32, 26, 51, 1, 81, 43, 31 },
+				{ 68, 25, 106, 22, 64, 171, 36, 225, 114 },
+				{ 34, 19, 21, 102, 132, 188, 16, 76, 124 },
+				{ 62, 18, 78, 95, 85, 57, 50, 48, 51 }
+			},
+			{
+				{ 193, 101, 35, 159, 215, 111, 89, 46, 111 },
+				{ 60, 148, 31, 172, 219, 228, 21, 18, 111 },
+				{ 112, 113, 77, 85, 179, 255, 38, 120, 114 },
+				{ 40, 42, 1, 196, 245, 209, 10, 25, 109 },
+				{ 88, 43, 29, 140, 166, 213, 37, 43, 154 },
+				{ 61, 63, 30, 155, 67, 45, 68, 1, 209 },
+				{ 100, 80, 8, 43, 154, 1, 51, 26, 71 },
+				{ 142, 78, 78, 16, 255, 128, 34, 197, 171 },
+				{ 41, 40, 5, 102, 211, 183, 4, 1, 221 },
+				{ 51, 50, 17, 168, 209, 192, 23, 25, 82 }
+			},
+			{
+				{ 138, 31, 36, 171, 27, 166, 38, 44, 229 },
+				{ 67, 87, 58, 169, 82, 115, 26, 59, 179 },
+				{ 63, 59, 90, 180, 59, 166, 93, 73, 154 },
+				{ 40, 40, 21, 116, 143, 209, 34, 39, 175 },
+				{ 47, 15, 16, 183, 34, 223, 49, 45, 183 },
+				{ 46, 17, 33, 183, 6, 98, 15, 32, 183 },
+				{ 57, 46, 22, 24, 128, 1, 54, 17, 37 },
+				{ 65, 32, 73, 115, 28, 128, 23, 128, 205 },
+				{ 40, 3, 9, 115, 51, 192, 18, 6, 223 },
+				{ 87, 37, 9, 115, 59, 77, 64, 21, 47 }
+			},
+			{
+				{ 104, 55, 44, 218, 9, 54, 53, 130, 226 },
+				{ 64, 90, 70, 205, 40, 41, 23, 26, 57 },
+				{ 54, 57, 112, 184, 5, 41, 38, 166, 213 },
+				{ 30, 34, 26, 133, 152, 116, 10, 32, 134 },
+				{ 39, 19, 53, 221, 26, 114, 32, 73, 255 },
+				{ 31, 9, 65, 234, 2, 15, 1, 118, 73 },
+				{ 75, 32, 12, 51, 192, 255, 160, 43, 51 },
+				{ 88, 31, 35, 67, 102, 85, 55, 186, 85 },
+				{ 56, 21, 23, 111, 59, 205, 45, 37, 192 },
+				{ 55, 38, 70, 124, 73, 102, 1, 34, 98 }
+			},
+			{
+				{ 125, 98, 42, 88, 104, 85, 117, 175, 82 },
+				{ 95, 84, 53, 89, 128, 100, 113, 101, 45 },
+				{ 75, 79, 123, 47, 51, 128, 81, 171, 1 },
+				{ 57, 17, 5, 71, 102, 57, 53, 41, 49 },
+				{ 38, 33, 13, 121, 57, 73, 26, 1, 85 },
+				{ 41, 10, 67, 138, 77, 110, 90, 47, 114 },
+				{ 115, 21, 2, 10, 102, 255, 166, 23, 6 },
+				{ 101, 29, 16, 10, 85, 128, 101, 196, 26 },
+				{ 57, 18, 10, 102, 102, 213, 34, 20, 43 },
+				{ 117, 20, 15, 36, 163, 128, 68, 1, 26 }
+			},
+			{
+				{ 102, 61, 71, 37, 34, 53, 31, 243, 192 },
+				{ 69, 60, 71, 38, 73, 119, 28, 222, 37 },
+				{ 68, 45, 128, 34, 1, 47, 11, 245, 171 },
+				{ 62, 17, 19, 70, 146, 85, 55, 62, 70 },
+				{ 37, 43, 37, 154, 100, 163, 85, 160, 1 },
+				{ 63, 9, 92, 136, 28, 64, 32, 201, 85 },
+				{ 75, 15, 9, 9, 64, 255, 184, 119, 16 },
+				{ 86, 6, 28, 5, 64, 255, 25, 248, 1 },
+				{ 56, 8, 17, 132, 137, 255, 55, 116, 128 },
+				{ 58, 15, 20, 82, 135, 57, 26, 121, 40 }
+			},
+			{
+				{ 164, 50, 31, 137, 154, 133, 25, 35, 218 },
+				{ 51, 103, 44, 131, 131, 123, 31, 6, 158 },
+				{ 86, 40, 64, 135, 148, 224, 45, 183, 128 },
+				{ 22, 26, 17, 131, 240, 154, 14, 1, 209 },
+				{ 45, 16, 21, 91, 64, 222, 7, 1, 197 },
+				{ 56, 21, 39, 155, 60, 138, 23, 102, 213 },
+				{ 83, 12, 13, 54, 192, 255, 68, 47, 28 },
+				{ 85, 26, 85, 85, 128, 128, 32, 146, 171 },
+				{ 18, 11, 7, 63, 144, 171, 4, 4, 246 },
+				{ 35, 27, 10, 146, 174, 171, 12, 26, 128 }
+			},
+			{
+				{ 190, 80, 35, 99, 180, 80, 126, 54, 45 },
+				{ 85, 126, 47, 87, 176, 51, 41, 20, 32 },
+				{ 101, 75, 128, 139, 118, 146, 116, 128, 85 },
+				{ 56, 41, 15, 176, 236, 85, 37, 9, 62 },
+				{ 71, 30, 17, 119, 118, 255, 17, 18, 138 },
+				{ 101, 38, 60, 138, 55, 70, 43, 26, 142 },
+				{ 146, 36, 19, 30, 171, 255, 97, 27, 20 },
+				{ 138, 45, 61, 62, 219, 1, 81, 188, 64 },
+				{ 32, 41, 20, 117, 151, 142, 20, 21, 163 },
+				{ 112, 19, 12, 61, 195, 128, 48, 4, 24 }
+			}
+		};
+
+
+		/// 4x4 模式树（负值为叶子，对应 -模式）
+		constexpr int8_t kYModesIntra4[18] = {
+			-B_DC_PRED, 1,
+			-B_TM_PRED, 2,
+			-B_VE_PRED, 3,
+			4, 6,
+			-B_HE_PRED, 5,
+			-B_RD_PRED, -B_VR_PRED,
+			-B_LD_PRED, 7,
+			-B_VL_PRED, 8,
+			-B_HD_PRED, -B_HU_PRED
+		};
+
+		/// 系数位置 -> 概率带
+		constexpr uint8_t kBands[16 + 1] = { 0, 1, 2, 3, 6, 4, 5, 6, 6, 6, 6, 6, 6, 6, 6, 7, 0 };
+
+		constexpr uint8_t kZigzag[16] = { 0, 1, 4, 8, 5, 2, 3, 6, 9, 12, 13, 10, 7, 11, 14, 15 };
+
+		/// DCT_CAT3..6 额外位的概率（以 0 结尾）
+		constexpr uint8_t kCat3[] = { 173, 148, 140, 0 };
+		constexpr uint8_t kCat4[] = { 176, 155, 140, 135, 0 };
+		constexpr uint8_t kCat5[] = { 180, 157, 141, 134, 130, 0 };
+		constexpr uint8_t kCat6[] = { 254, 254, 243, 230, 196, 177, 153, 140, 133, 130, 129, 0 };
+		constexpr const uint8_t* kCat3456[] = { kCat3, kCat4, kCat5, kCat6 };
+
+		// ============================================================================
+		// 布尔熵解码器（RFC 6386 第 7 节，按 libwebp 的 56 位批量读取实现）
+		// ============================================================================
+
+		class BoolDecoder
+		{
+		public:
+			void init(const uint8_t* data, size_t size) noexcept
+			{
+				_buf = data;
+				_end = data + size;
+				_value = 0;
+				_range = 255 - 1;
+				_bits = -8;
+				_eof = false;
+				loadNewBytes();
+			}
+
+			/// 以概率 prob / 256 解码一位 0
+			int getBit(int prob) noexcept
+			{
+				uint32_t range = _range;
+				if (_bits < 0)
+				{
+					loadNewBytes();
+				}
+
+				const int pos = _bits;
+				const uint32_t split = (range * static_cast<uint32_t>(prob)) >> 8;
+				const uint32_t value = static_cast<uint32_t>(_value >> pos);
+				const int bit = value > split;
+				if (bit)
+				{
+					range -= split;
+					_value -= static_cast<uint64_t>(split + 1) << pos;
+				}
+				else
+				{
+					range = split + 1;
+				}
+
+				// 归一化到 [128, 255]
+				const int shift = 7 ^ (std::bit_width(range) - 1);
+				range <<= shift;
+				_bits -= shift;
+				_range = range - 1;
+				return bit;
+			}
+
+			/// 以概率 1/2 解码 bits 位无符号数（高位在前）
+			uint32_t getValue(int bits) noexcept
+			{
+				uint32_t v = 0;
+				while (bits-- > 0)
+				{
+					v |= static_cast<uint32_t>(getBit(0x80)) << bits;
+				}
+				return v;
+			}
+
+			/// bits 位数值 + 符号位
+			int32_t getSignedValue(int bits) noexcept
+			{
+				const int32_t value = static_cast<int32_t>(getValue(bits));
+				return getBit(0x80) ? -value : value;
+			}
+
+			/// 以概率 1/2 为 v 附加符号
+			int32_t getSigned(int32_t v) noexcept
+			{
+				return getBit(0x80) ? -v : v;
+			}
+
+			bool eof() const noexcept { return _eof; }
+
+		private:
+			void loadNewBytes() noexcept
+			{
+				if (_end - _buf >= 8)
+				{
+					uint64_t raw;
+					std::memcpy(&raw, _buf, sizeof(raw));
+					if constexpr (std::endian::native == std::endian::little)
+					{
+						raw = std::byteswap(raw);
+					}
+					_buf += 7;
+					_value = (_value << 56) | (raw >> 8);
+					_bits += 56;
+				}
+				else if (_buf < _end)
+				{
+					_value = (_value << 8) | *_buf++;
+					_bits += 8;
+				}
+				else if (!_eof)
+				{
+					// 越过末尾时补一个 0 字节并标记，之后的读取不再移位
+					_value <<= 8;
+					_bits += 8;
+					_eof = true;
+				}
+				else
+				{
+					_bits = 0;
+				}
+			}
+
+			const uint8_t* _buf = nullptr;
+			const uint8_t* _end = nullptr;
+			uint64_t _value = 0;
+			uint32_t _range = 255 - 1;  ///< 区间大小减一
+			int _bits = -8;             ///< _value 中尚未使用的位数减 8
+			bool _eof = false;
+		};
+
+		// ============================================================================
+		// 帧内预测（在跨度为 BPS 的工作缓冲上进行，左侧 / 上方样本已就位）
+		// ============================================================================
+
+		constexpr ptrdiff_t BPS = 32;
+
+		inline uint8_t avg2(int a, int b) noexcept
+		{
+			return static_cast<uint8_t>((a + b + 1) >> 1);
+		}
+
+		inline uint8_t avg3(int a, int b, int c) noexcept
+		{
+			return static_cast<uint8_t>((a + 2 * b + c + 2) >> 2);
+		}
+
+		void fillBlock(uint8_t* dst, int size, int value) noexcept
+		{
+			for (int j = 0; j < size; ++j)
+			{
+				std::memset(dst + j * BPS, value, size);
+			}
+		}
+
+		void trueMotion(uint8_t* dst, int size) noexcept
+		{
+			const uint8_t* top = dst - BPS;
+			const int topLeft = top[-1];
+			for (int y = 0; y < size; ++y)
+			{
+				const int base = dst[-1] - topLeft;
+				for (int x = 0; x < size; ++x)
+				{
+					dst[x] = static_cast<uint8_t>(std::clamp(base + top[x], 0, 255));
+				}
+				dst += BPS;
+			}
+		}
+
+		void verticalPred(uint8_t* dst, int size) noexcept
+		{
+			for (int j = 0; j < size; ++j)
+			{
+				std::memcpy(dst + j * BPS, dst - BPS, size);
+			}
+		}
+
+		void horizontalPred(uint8_t* dst, int size) noexcept
+		{
+			for (int j = 0; j < size; ++j)
+			{
+				std::memset(dst + j * BPS, dst[j * BPS - 1], size);
+			}
+		}
+
+		/// 16x16 亮度或 8x8 色度预测；DC 在图像边缘只用存在的一侧（都不存在时为 128）
+		void predictBlock(uint8_t* dst, int size, uint8_t mode, bool hasTop, bool hasLeft) noexcept
+		{
+			switch (mode)
+			{
+			case B_TM_PRED:
+				trueMotion(dst, size);
+				return;
+			case B_VE_PRED:
+				verticalPred(dst, size);
+				return;
+			case B_HE_PRED:
+				horizontalPred(dst, size);
+				return;
+			default:
+				break;
+			}
+
+			const int shift = size == 16 ? 4 : 3;
+			int sum = 0;
+			if (hasTop)
+			{
+				for (int i = 0; i < size; ++i)
+				{
+					sum += dst[i - BPS];
+				}
+			}
+			if (hasLeft)
+			{
+				for (int j = 0; j < size; ++j)
+				{
+					sum += dst[j * BPS - 1];
+				}
+			}
+
+			int dc = 0x80;
+			if (hasTop && hasLeft)
+			{
+				dc = (sum + size) >> (shift + 1);
+			}
+			else if (hasTop || hasLeft)
+			{
+				dc = (sum + size / 2) >> shift;
+			}
+			fillBlock(dst, size, dc);
+		}
+
+		/// 4x4 子块预测（RFC 6386 12.3），上方右侧的 4 个样本位于 dst - BPS + 4
+		void predictSubblock(uint8_t* dst, uint8_t mode) noexcept
+		{
+			const uint8_t* top = dst - BPS;
+			const int X = top[-1];
+			const int A = top[0], B = top[1], C = top[2], D = top[3];
+			const int E = top[4], F = top[5], G = top[6], H = top[7];
+			const int I = dst[-1], J = dst[BPS - 1], K = dst[2 * BPS - 1], L = dst[3 * BPS - 1];
+			auto put = [dst](int x, int y, uint8_t v) { dst[x + y * BPS] = v; };
+
+			switch (mode)
+			{
+			case B_DC_PRED:
+			{
+				int dc = 4;
+				for (int i = 0; i < 4; ++i)
+				{
+					dc += top[i] + dst[i * BPS - 1];
+				}
+				fillBlock(dst, 4, dc >> 3);
+				break;
+			}
+			case B_TM_PRED:
+				trueMotion(dst, 4);
+				break;
+			case B_VE_PRED:
+			{
+				const uint8_t vals[4] = { avg3(X, A, B), avg3(A, B, C), avg3(B, C, D), avg3(C, D, E) };
+				for (int j = 0; j < 4; ++j)
+				{
+					std::memcpy(dst + j * BPS, vals, 4);
+				}
+				break;
+			}
+			case B_HE_PRED:
+				std::memset(dst + 0 * BPS, avg3(X, I, J), 4);
+				std::memset(dst + 1 * BPS, avg3(I, J, K), 4);
+				std::memset(dst + 2 * BPS, avg3(J, K, L), 4);
+				std::memset(dst + 3 * BPS, avg3(K, L, L), 4);
+				break;
+			case B_RD_PRED:
+				put(0, 3, avg3(J, K, L));
+				put(1, 3, avg3(I, J, K)); put(0, 2, avg3(I, J, K));
+				put(2, 3, avg3(X, I, J)); put(1, 2, avg3(X, I, J)); put(0, 1, avg3(X, I, J));
+				put(3, 3, avg3(A, X, I)); put(2, 2, avg3(A, X, I)); put(1, 1, avg3(A, X, I)); put(0, 0, avg3(A, X, I));
+				put(3, 2, avg3(B, A, X)); put(2, 1, avg3(B, A, X)); put(1, 0, avg3(B, A, X));
+				put(3, 1, avg3(C, B, A)); put(2, 0, avg3(C, B, A));
+				put(3, 0, avg3(D, C, B));
+				break;
+			case B_VR_PRED:
+				put(0, 0, avg2(X, A)); put(1, 2, avg2(X, A));
+				put(1, 0, avg2(A, B)); put(2, 2, avg2(A, B));
+				put(2, 0, avg2(B, C)); put(3, 2, avg2(B, C));
+				put(3, 0, avg2(C, D));
+				put(0, 3, avg3(K, J, I));
+				put(0, 2, avg3(J, I, X));
+				put(0, 1, avg3(I, X, A)); put(1, 3, avg3(I, X, A));
+				put(1, 1, avg3(X, A, B)); put(2, 3, avg3(X, A, B));
+				put(2, 1, avg3(A, B, C)); put(3, 3, avg3(A, B, C));
+				put(3, 1, avg3(B, C, D));
+				break;
+			case B_LD_PRED:
+				put(0, 0, avg3(A, B, C));
+				put(1, 0, avg3(B, C, D)); put(0, 1, avg3(B, C, D));
+				put(2, 0, avg3(C, D, E)); put(1, 1, avg3(C, D, E)); put(0, 2, avg3(C, D, E));
+				put(3, 0, avg3(D, E, F)); put(2, 1, avg3(D, E, F)); put(1, 2, avg3(D, E, F)); put(0, 3, avg3(D, E, F));
+				put(3, 1, avg3(E, F, G)); put(2, 2, avg3(E, F, G)); put(1, 3, avg3(E, F, G));
+				put(3, 2, avg3(F, G, H)); put(2, 3, avg3(F, G, H));
+				put(3, 3, avg3(G, H, H));
+				break;
+			case B_VL_PRED:
+				put(0, 0, avg2(A, B));
+				put(1, 0, avg2(B, C)); put(0, 2, avg2(B, C));
+				put(2, 0, avg2(C, D)); put(1, 2, avg2(C, D));
+				put(3, 0, avg2(D, E)); put(2, 2, avg2(D, E));
+				put(0, 1, avg3(A, B, C));
+				put(1, 1, avg3(B, C, D)); put(0, 3, avg3(B, C, D));
+				put(2, 1, avg3(C, D, E)); put(1, 3, avg3(C, D, E));
+				put(3, 1, avg3(D, E, F)); put(2, 3, avg3(D, E, F));
+				put(3, 2, avg3(E, F, G));
+				put(3, 3, avg3(F, G, H));
+				break;
+			case B_HD_PRED:
+				put(0, 0, avg2(I, X)); put(2, 1, avg2(I, X));
+				put(0, 1, avg2(J, I)); put(2, 2, avg2(J, I));
+				put(0, 2, avg2(K, J)); put(2, 3, avg2(K, J));
+				put(0, 3, avg2(L, K));
+				put(3, 0, avg3(A, B, C));
+				put(2, 0, avg3(X, A, B));
+				put(1, 0, avg3(I, X, A)); put(3, 1, avg3(I, X, A));
+				put(1, 1, avg3(J, I, X)); put(3, 2, avg3(J, I, X));
+				put(1, 2, avg3(K, J, I)); put(3, 3, avg3(K, J, I));
+				put(1, 3, avg3(L, K, J));
+				break;
+			default: // B_HU_PRED
+				put(0, 0, avg2(I, J));
+				put(2, 0, avg2(J, K)); put(0, 1, avg2(J, K));
+				put(2, 1, avg2(K, L)); put(0, 2, avg2(K, L));
+				put(1, 0, avg3(I, J, K));
+				put(3, 0, avg3(J, K, L)); put(1, 1, avg3(J, K, L));
+				put(3, 1, avg3(K, L, L)); put(1, 2, avg3(K, L, L));
+				put(3, 2, static_cast<uint8_t>(L)); put(2, 2, static_cast<uint8_t>(L));
+				put(0, 3, static_cast<uint8_t>(L)); put(1, 3, static_cast<uint8_t>(L));
+				put(2, 3, static_cast<uint8_t>(L)); put(3, 3, static_cast<uint8_t>(L));
+				break;
+			}
+		}
+
+		// ============================================================================
+		// 帧级数据结构
+		// ============================================================================
+
+		/// 一个概率带的系数概率 [上下文][节点]
+		struct BandProbas
+		{
+			uint8_t probas[3][11];
+		};
+
+		struct QuantMatrix
+		{
+			int32_t y1[2];  ///< 亮度 [DC, AC]
+			int32_t y2[2];  ///< Y2（16x16 模式的 DC 块）
+			int32_t uv[2];  ///< 色度
+		};
+
+		/// 宏块的环路滤波参数（limit 为 0 表示不滤波）
+		struct FilterInfo
+		{
+			uint8_t limit = 0;
+			uint8_t interiorLimit = 0;
+			uint8_t hevThreshold = 0;
+			bool inner = false;  ///< 是否滤波内部子块边
+		};
+
+		/// 一行中每个宏块的模式
+		struct MacroblockModes
+		{
+			uint8_t segment = 0;
+			bool skip = false;
+			bool isI4x4 = false;
+			uint8_t uvMode = B_DC_PRED;
+			std::array<uint8_t, 16> yModes{};  ///< 16x16 模式只用 [0]
+		};
+
+		/// 宏块的非零系数上下文（按位存放各子块，低 4 位亮度，之后各 2 位 U / V）
+		struct NonZeroContext
+		{
+			uint8_t nz = 0;
+			uint8_t nzDc = 0;
+		};
+
+		/// 宏块最下一行 / 最右一列未滤波的样本，用于下一行的帧内预测
+		struct TopSamples
+		{
+			uint8_t y[16];
+			uint8_t u[8];
+			uint8_t v[8];
+		};
+
+		/// 残差块的逆变换方式
+		enum class BlockTransform : uint8_t
+		{
+			None,
+			DC,
+			Full
+		};
+
+		constexpr uint32_t kAbortedFlag = 1u << 31;
+
+		// ============================================================================
+		// 解码器
+		// ============================================================================
+
+		class Decoder
+		{
+		public:
+			Decoder(const uint8_t* data, size_t size, uint8_t* rgba, size_t rgbaStride, const Vp8DecodeOptions& options)
+				: _data(data), _size(size), _rgba(rgba), _rgbaStride(rgbaStride), _options(options),
+				  _dsp(vp8_dsp::kernels())
+			{
+			}
+
+			std::expected<void, std::string> decode();
+
+		private:
+			std::expected<void, std::string> parseHeaders();
+			void parseSegmentHeader();
+			void parseFilterHeader();
+			std::expected<void, std::string> parsePartitions(const uint8_t* buf, size_t size);
+			void parseQuant();
+			void parseProba();
+			void precomputeFilterStrengths();
+
+			void parseIntraModeRow();
+			bool decodeMacroblock(uint32_t mbX, uint32_t mbY, BoolDecoder& tokens);
+			bool parseResiduals(uint32_t mbX, const MacroblockModes& modes, BoolDecoder& tokens);
+			void reconstructMacroblock(uint32_t mbX, uint32_t mbY, const MacroblockModes& modes);
+
+			void filterMacroblock(uint32_t mbX, uint32_t mbY) const;
+			void convertRows(uint32_t mbRow, std::vector<uint8_t>& scratch) const;
+			void finishRow(uint32_t mbY, std::vector<uint8_t>& scratch) const;
+
+			bool shouldFilterParallel() const noexcept;
+
+			// 输入与输出
+			const uint8_t* _data;
+			size_t _size;
+			uint8_t* _rgba;
+			size_t _rgbaStride;
+			Vp8DecodeOptions _options;
+			const vp8_dsp::DspKernels& _dsp;
+
+			// 帧头
+			uint32_t _width = 0;
+			uint32_t _height = 0;
+			uint32_t _mbW = 0;
+			uint32_t _mbH = 0;
+
+			bool _useSegment = false;
+			bool _updateMap = false;
+			bool _absoluteDelta = true;
+			int8_t _segmentQuantizer[kNumSegments]{};
+			int8_t _segmentFilterStrength[kNumSegments]{};
+			uint8_t _segmentProba[3] = { 255, 255, 255 };
+
+			bool _simpleFilter = false;
+			int _filterLevel = 0;
+			int _sharpness = 0;
+			bool _useLfDelta = false;
+			int _refLfDelta[4]{};
+			int _modeLfDelta[4]{};
+			int _filterType = 0;  ///< 0 = 不滤波，1 = 简单，2 = 复杂
+
+			BoolDecoder _br;  ///< 第一分区（模式）
+			std::vector<BoolDecoder> _partitions;  ///< 残差分区（1/2/4/8 个，按宏块行轮流使用）
+
+			QuantMatrix _dqm[kNumSegments]{};
+			BandProbas _bands[4][8]{};
+			const BandProbas* _bandsPtr[4][16 + 1]{};
+			bool _useSkipProba = false;
+			uint8_t _skipProba = 0;
+			FilterInfo _filterStrengths[kNumSegments][2];
+
+			// 宏块行解码状态
+			std::vector<MacroblockModes> _rowModes;
+			std::vector<uint8_t> _intraTop;     ///< 每个宏块 4 个：上方子块的预测模式
+			uint8_t _intraLeft[4]{};
+			std::vector<NonZeroContext> _nzTop;
+			NonZeroContext _nzLeft;
+			std::vector<TopSamples> _topSamples;
+			std::vector<FilterInfo> _filterInfo;  ///< 整帧，每宏块一个
+			alignas(16) int16_t _coeffs[384]{};   ///< 当前宏块：16 个亮度块、4 个 U、4 个 V
+			BlockTransform _transforms[24]{};
+			alignas(16) uint8_t _work[BPS * 17 + BPS * 9]{};
+
+			// 整帧平面（宏块对齐）
+			std::vector<uint8_t> _yPlane;
+			std::vector<uint8_t> _uPlane;
+			std::vector<uint8_t> _vPlane;
+			size_t _yStride = 0;
+			size_t _uvStride = 0;
+		};
+
+		std::expected<void, std::string> Decoder::parseHeaders()
+		{
+			auto info = parseFrameInfo(_data, _size);
+			if (!info.has_value())
+			{
+				return std::unexpected(info.error());
+			}
+			_width = info->width;
+			_height = info->height;
+			_mbW = (_width + 15) >> 4;
+			_mbH = (_height + 15) >> 4;
+
+			const uint8_t* buf = _data + 10;
+			const size_t remaining = _size - 10;
+			_br.init(buf, info->firstPartitionSize);
+
+			_br.getValue(1);  // 颜色空间（只定义了 YUV）
+			_br.getValue(1);  // 像素钳位类型（总是钳位）
+			parseSegmentHeader();
+			parseFilterHeader();
+			auto partitions = parsePartitions(buf + info->firstPartitionSize, remaining - info->firstPartitionSize);
+			if (!partitions.has_value())
+			{
+				return partitions;
+			}
+			parseQuant();
+			_br.getValue(1);  // refresh_entropy_probs，单帧解码不需要
+			parseProba();
+
+			if (_br.eof())
+			{
+				return std::unexpected("VP8 frame header is truncated");
+			}
+			return {};
+		}
+
+		void Decoder::parseSegmentHeader()
+		{
+			_useSegment = _br.getValue(1) != 0;
+			if (!_useSegment)
+			{
+				_updateMap = false;
+				return;
+			}
+
+			_updateMap = _br.getValue(1) != 0;
+			if (_br.getValue(1))
+			{
+				_absoluteDelta = _br.getValue(1) != 0;
+				for (int s = 0; s < kNumSegments; ++s)
+				{
+					_segmentQuantizer[s] = static_cast<int8_t>(_br.getValue(1) ? _br.getSignedValue(7) : 0);
+				}
+				for (int s = 0; s < kNumSegments; ++s)
+				{
+					_segmentFilterStrength[s] = static_cast<int8_t>(_br.getValue(1) ? _br.getSignedValue(6) : 0);
+				}
+			}
+			if (_updateMap)
+			{
+				for (int s = 0; s < 3; ++s)
+				{
+					_segmentProba[s] = static_cast<uint8_t>(_br.getValue(1) ? _br.getValue(8) : 255u);
+				}
+			}
+		}
+
+		void Decoder::parseFilterHeader()
+		{
+			_simpleFilter = _br.getValue(1) != 0;
+			_filterLevel = static_cast<int>(_br.getValue(6));
+			_sharpness = static_cast<int>(_br.getValue(3));
+			_useLfDelta = _br.getValue(1) != 0;
+			if (_useLfDelta && _br.getValue(1))
+			{
+				for (int i = 0; i < 4; ++i)
+				{
+					if (_br.getValue(1))
+					{
+						_refLfDelta[i] = _br.getSignedValue(6);
+					}
+				}
+				for (int i = 0; i < 4; ++i)
+				{
+					if (_br.getValue(1))
+					{
+						_modeLfDelta[i] = _br.getSignedValue(6);
+					}
+				}
+			}
+			_filterType = _filterLevel == 0 ? 0 : (_simpleFilter ? 1 : 2);
+		}
+
+		std::expected<void, std::string> Decoder::parsePartitions(const uint8_t* buf, size_t size)
+		{
+			// 除最后一个分区外，每个分区的大小以 3 字节小端序存放在分区数据之前
+			const size_t lastPart = (size_t{ 1 } << _br.getValue(2)) - 1;
+			if (size < 3 * lastPart)
+			{
+				return std::unexpected("VP8 partition table is truncated");
+			}
+
+			_partitions.resize(lastPart + 1);
+			const uint8_t* sizes = buf;
+			const uint8_t* partStart = buf + lastPart * 3;
+			size_t sizeLeft = size - lastPart * 3;
+			for (size_t p = 0; p < lastPart; ++p)
+			{
+				size_t partSize = sizes[0] | (sizes[1] << 8) | (sizes[2] << 16);
+				partSize = std::min(partSize, sizeLeft);
+				_partitions[p].init(partStart, partSize);
+				partStart += partSize;
+				sizeLeft -= partSize;
+				sizes += 3;
+			}
+			_partitions[lastPart].init(partStart, sizeLeft);
+
+			if (sizeLeft == 0)
+			{
+				return std::unexpected("VP8 token partitions are truncated");
+			}
+			return {};
+		}
+
+		void Decoder::parseQuant()
+		{
+			auto clip = [](int v, int maxValue) { return std::clamp(v, 0, maxValue); };
+
+			const int baseQ0 = static_cast<int>(_br.getValue(7));
+			const int dqy1Dc = _br.getValue(1) ? _br.getSignedValue(4) : 0;
+			const int dqy2Dc = _br.getValue(1) ? _br.getSignedValue(4) : 0;
+			const int dqy2Ac = _br.getValue(1) ? _br.getSignedValue(4) : 0;
+			const int dquvDc = _br.getValue(1) ? _br.getSignedValue(4) : 0;
+			const int dquvAc = _br.getValue(1) ? _br.getSignedValue(4) : 0;
+
+			for (int s = 0; s < kNumSegments; ++s)
+			{
+				int q = baseQ0;
+				if (_useSegment)
+				{
+					q = _segmentQuantizer[s] + (_absoluteDelta ? 0 : baseQ0);
+				}
+				else if (s > 0)
+				{
+					_dqm[s] = _dqm[0];
+					continue;
+				}
+
+				QuantMatrix& m = _dqm[s];
+				m.y1[0] = kDcTable[clip(q + dqy1Dc, 127)];
+				m.y1[1] = kAcTable[clip(q, 127)];
+				m.y2[0] = kDcTable[clip(q + dqy2Dc, 127)] * 2;
+				// 即 ac * 155 / 100，使用定点乘法
+				m.y2[1] = std::max((kAcTable[clip(q + dqy2Ac, 127)] * 101581) >> 16, 8);
+				m.uv[0] = kDcTable[clip(q + dquvDc, 117)];
+				m.uv[1] = kAcTable[clip(q + dquvAc, 127)];
+			}
+		}
+
+		void Decoder::parseProba()
+		{
+			for (int t = 0; t < 4; ++t)
+			{
+				for (int b = 0; b < 8; ++b)
+				{
+					for (int c = 0; c < 3; ++c)
+					{
+						for (int p = 0; p < 11; ++p)
+						{
+							_bands[t][b].probas[c][p] = _br.getBit(kCoeffsUpdateProba[t][b][c][p])
+								? static_cast<uint8_t>(_br.getValue(8))
+								: kCoeffsProba0[t][b][c][p];
+						}
+					}
+				}
+				for (int i = 0; i < 16 + 1; ++i)
+				{
+					_bandsPtr[t][i] = &_bands[t][kBands[i]];
+				}
+			}
+
+			_useSkipProba = _br.getValue(1) != 0;
+			if (_useSkipProba)
+			{
+				_skipProba = static_cast<uint8_t>(_br.getValue(8));
+			}
+		}
+
+		void Decoder::precomputeFilterStrengths()
+		{
+			if (_filterType == 0)
+			{
+				return;
+			}
+
+			for (int s = 0; s < kNumSegments; ++s)
+			{
+				int baseLevel = _filterLevel;
+				if (_useSegment)
+				{
+					baseLevel = _segmentFilterStrength[s] + (_absoluteDelta ? 0 : _filterLevel);
+				}
+
+				for (int i4x4 = 0; i4x4 <= 1; ++i4x4)
+				{
+					FilterInfo& info = _filterStrengths[s][i4x4];
+					int level = baseLevel;
+					if (_useLfDelta)
+					{
+						// 关键帧只有帧内参考帧，模式增量只区分 4x4 预测
+						level += _refLfDelta[0];
+						if (i4x4)
+						{
+							level += _modeLfDelta[0];
+						}
+					}
+					level = std::clamp(level, 0, 63);
+
+					if (level > 0)
+					{
+						int interiorLimit = level;
+						if (_sharpness > 0)
+						{
+							interiorLimit >>= _sharpness > 4 ? 2 : 1;
+							interiorLimit = std::min(interiorLimit, 9 - _sharpness);
+						}
+						interiorLimit = std::max(interiorLimit, 1);
+						info.interiorLimit = static_cast<uint8_t>(interiorLimit);
+						info.limit = static_cast<uint8_t>(2 * level + interiorLimit);
+						info.hevThreshold = static_cast<uint8_t>(level >= 40 ? 2 : (level >= 15 ? 1 : 0));
+					}
+					else
+					{
+						info.limit = 0;
+					}
+					info.inner = i4x4 != 0;
+				}
+			}
+		}
+
+		// ----------------------------------------------------------------------------
+		// 模式与残差
+		// ----------------------------------------------------------------------------
+
+		void Decoder::parseIntraModeRow()
+		{
+			for (uint32_t mbX = 0; mbX < _mbW; ++mbX)
+			{
+				MacroblockModes& block = _rowModes[mbX];
+				uint8_t* top = _intraTop.data() + 4 * mbX;
+
+				block.segment = 0;
+				if (_updateMap)
+				{
+					block.segment = static_cast<uint8_t>(!_br.getBit(_segmentProba[0])
+						? _br.getBit(_segmentProba[1])
+						: _br.getBit(_segmentProba[2]) + 2);
+				}
+				block.skip = _useSkipProba ? _br.getBit(_skipProba) != 0 : false;
+
+				block.isI4x4 = !_br.getBit(145);
+				if (!block.isI4x4)
+				{
+					const uint8_t ymode = _br.getBit(156)
+						? (_br.getBit(128) ? B_TM_PRED : B_HE_PRED)
+						: (_br.getBit(163) ? B_VE_PRED : B_DC_PRED);
+					block.yModes[0] = ymode;
+					std::memset(top, ymode, 4);
+					std::memset(_intraLeft, ymode, 4);
+				}
+				else
+				{
+					uint8_t* modes = block.yModes.data();
+					for (int y = 0; y < 4; ++y)
+					{
+						int ymode = _intraLeft[y];
+						for (int x = 0; x < 4; ++x)
+						{
+							const uint8_t* prob = kBModesProba[top[x]][ymode];
+							int i = kYModesIntra4[_br.getBit(prob[0])];
+							while (i > 0)
+							{
+								i = kYModesIntra4[2 * i + _br.getBit(prob[i])];
+							}
+							ymode = -i;
+							top[x] = static_cast<uint8_t>(ymode);
+						}
+						std::memcpy(modes, top, 4);
+						modes += 4;
+						_intraLeft[y] = static_cast<uint8_t>(ymode);
+					}
+				}
+
+				block.uvMode = !_br.getBit(142) ? B_DC_PRED
+					: !_br.getBit(114) ? B_VE_PRED
+					: _br.getBit(183) ? B_TM_PRED : B_HE_PRED;
+			}
+		}
+
+		/// DCT_CAT 2 及以上的系数值（RFC 6386 13.2）
+		int getLargeValue(BoolDecoder& br, const uint8_t* p)
+		{
+			if (!br.getBit(p[3]))
+			{
+				return !br.getBit(p[4]) ? 2 : 3 + br.getBit(p[5]);
+			}
+			if (!br.getBit(p[6]))
+			{
+				if (!br.getBit(p[7]))
+				{
+					return 5 + br.getBit(159);
+				}
+				int v = 7 + 2 * br.getBit(165);
+				return v + br.getBit(145);
+			}
+
+			const int bit1 = br.getBit(p[8]);
+			const int bit0 = br.getBit(p[9 + bit1]);
+			const int cat = 2 * bit1 + bit0;
+			int v = 0;
+			for (const uint8_t* tab = kCat3456[cat]; *tab; ++tab)
+			{
+				v += v + br.getBit(*tab);
+			}
+			return v + 3 + (8 << cat);
+		}
+
+		/**
+		 * @brief 解码一个 4x4 块的系数（反量化后按自然顺序写入 out）
+		 * @return 最后一个已解码位置 + 1（没有系数时为 first）
+		 */
+		int getCoeffs(BoolDecoder& br, const BandProbas* const* prob, int ctx, const int32_t* dq, int n, int16_t* out)
+		{
+			const uint8_t* p = prob[n]->probas[ctx];
+			for (; n < 16; ++n)
+			{
+				if (!br.getBit(p[0]))
+				{
+					return n;  // EOB
+				}
+				while (!br.getBit(p[1]))
+				{
+					p = prob[++n]->probas[0];
+					if (n == 16)
+					{
+						return 16;
+					}
+				}
+
+				const BandProbas* next = prob[n + 1];
+				int v;
+				if (!br.getBit(p[2]))
+				{
+					v = 1;
+					p = next->probas[1];
+				}
+				else
+				{
+					v = getLargeValue(br, p);
+					p = next->probas[2];
+				}
+				out[kZigzag[n]] = static_cast<int16_t>(br.getSigned(v) * dq[n > 0]);
+			}
+			return 16;
+		}
+
+		inline BlockTransform selectTransform(int nz, const int16_t* block) noexcept
+		{
+			return nz > 1 ? BlockTransform::Full : (block[0] != 0 ? BlockTransform::DC : BlockTransform::None);
+		}
+
+		/**
+		 * @brief 解码宏块的全部残差
+		 * @return 是否所有块都没有非零系数
+		 */
+		bool Decoder::parseResiduals(uint32_t mbX, const MacroblockModes& modes, BoolDecoder& tokens)
+		{
+			const QuantMatrix& q = _dqm[modes.segment];
+			NonZeroContext& top = _nzTop[mbX];
+			NonZeroContext& left = _nzLeft;
+			int16_t* dst = _coeffs;
+			std::memset(_coeffs, 0, sizeof(_coeffs));
+
+			const BandProbas* const* acProba;
+			int first;
+			if (!modes.isI4x4)
+			{
+				// Y2：16 个亮度块的 DC 经 WHT 后分发
+				alignas(16) int16_t dc[16] = {};
+				const int ctx = top.nzDc + left.nzDc;
+				const int nz = getCoeffs(tokens, _bandsPtr[1], ctx, q.y2, 0, dc);
+				top.nzDc = left.nzDc = nz > 0;
+				if (nz > 1)
+				{
+					vp8_dsp::inverseWalshHadamard(dc, dst);
+				}
+				else
+				{
+					const int16_t dc0 = static_cast<int16_t>((dc[0] + 3) >> 3);
+					for (int i = 0; i < 16 * 16; i += 16)
+					{
+						dst[i] = dc0;
+					}
+				}
+				first = 1;
+				acProba = _bandsPtr[0];
+			}
+			else
+			{
+				first = 0;
+				acProba = _bandsPtr[3];
+			}
+
+			bool allZero = true;
+			uint32_t tnz = top.nz & 0x0f;
+			uint32_t lnz = left.nz & 0x0f;
+			for (int y = 0; y < 4; ++y)
+			{
+				uint32_t l = lnz & 1;
+				for (int x = 0; x < 4; ++x)
+				{
+					const int ctx = static_cast<int>(l + (tnz & 1));
+					const int nz = getCoeffs(tokens, acProba, ctx, q.y1, first, dst);
+					l = nz > first;
+					tnz = (tnz >> 1) | (l << 7);
+					const BlockTransform transform = selectTransform(nz, dst);
+					_transforms[y * 4 + x] = transform;
+					allZero &= transform == BlockTransform::None;
+					dst += 16;
+				}
+				tnz >>= 4;
+				lnz = (lnz >> 1) | (l << 7);
+			}
+			uint32_t outTopNz = tnz;
+			uint32_t outLeftNz = lnz >> 4;
+
+			for (int ch = 0; ch < 4; ch += 2)
+			{
+				tnz = top.nz >> (4 + ch);
+				lnz = left.nz >> (4 + ch);
+				for (int y = 0; y < 2; ++y)
+				{
+					uint32_t l = lnz & 1;
+					for (int x = 0; x < 2; ++x)
+					{
+						const int ctx = static_cast<int>(l + (tnz & 1));
+						const int nz = getCoeffs(tokens, _bandsPtr[2], ctx, q.uv, 0, dst);
+						l = nz > 0;
+						tnz = (tnz >> 1) | (l << 3);
+						const BlockTransform transform = selectTransform(nz, dst);
+						_transforms[16 + ch * 2 + y * 2 + x] = transform;
+						allZero &= transform == BlockTransform::None;
+						dst += 16;
+					}
+					tnz >>= 2;
+					lnz = (lnz >> 1) | (l << 5);
+				}
+				outTopNz |= (tnz << 4) << ch;
+				outLeftNz |= (lnz & 0xf0) << ch;
+			}
+			top.nz = static_cast<uint8_t>(outTopNz);
+			left.nz = static_cast<uint8_t>(outLeftNz);
+			return allZero;
+		}
+
+		bool Decoder::decodeMacroblock(uint32_t mbX, uint32_t mbY, BoolDecoder& tokens)
+		{
+			const MacroblockModes& modes = _rowModes[mbX];
+			bool skip = modes.skip;
+			if (!skip)
+			{
+				skip = parseResiduals(mbX, modes, tokens);
+			}
+			else
+			{
+				_nzLeft.nz = _nzTop[mbX].nz = 0;
+				if (!modes.isI4x4)
+				{
+					_nzLeft.nzDc = _nzTop[mbX].nzDc = 0;
+				}
+				std::fill(std::begin(_transforms), std::end(_transforms), BlockTransform::None);
+			}
+
+			if (_filterType > 0)
+			{
+				FilterInfo info = _filterStrengths[modes.segment][modes.isI4x4];
+				info.inner |= !skip;
+				_filterInfo[static_cast<size_t>(mbY) * _mbW + mbX] = info;
+			}
+
+			reconstructMacroblock(mbX, mbY, modes);
+			return !tokens.eof();
+		}
+
+		// ----------------------------------------------------------------------------
+		// 重建
+		// ----------------------------------------------------------------------------
+
+		constexpr ptrdiff_t kYOffset = BPS * 1 + 8;
+		constexpr ptrdiff_t kUOffset = kYOffset + BPS * 16 + BPS;
+		constexpr ptrdiff_t kVOffset = kUOffset + 16;
+
+		void Decoder::reconstructMacroblock(uint32_t mbX, uint32_t mbY, const MacroblockModes& modes)
+		{
+			uint8_t* yDst = _work + kYOffset;
+			uint8_t* uDst = _work + kUOffset;
+			uint8_t* vDst = _work + kVOffset;
+
+			if (mbX == 0)
+			{
+				// 左边界为 129；第一行上边界为 127（包括左上角和右上方）
+				for (int j = 0; j < 16; ++j)
+				{
+					yDst[j * BPS - 1] = 129;
+				}
+				for (int j = 0; j < 8; ++j)
+				{
+					uDst[j * BPS - 1] = 129;
+					vDst[j * BPS - 1] = 129;
+				}
+				if (mbY > 0)
+				{
+					yDst[-1 - BPS] = uDst[-1 - BPS] = vDst[-1 - BPS] = 129;
+				}
+				else
+				{
+					std::memset(yDst - BPS - 1, 127, 16 + 4 + 1);
+					std::memset(uDst - BPS - 1, 127, 8 + 1);
+					std::memset(vDst - BPS - 1, 127, 8 + 1);
+				}
+			}
+			else
+			{
+				// 上一个宏块的最右 4 列（含上方行）移到左侧
+				for (int j = -1; j < 16; ++j)
+				{
+					std::memcpy(yDst + j * BPS - 4, yDst + j * BPS + 12, 4);
+				}
+				for (int j = -1; j < 8; ++j)
+				{
+					std::memcpy(uDst + j * BPS - 4, uDst + j * BPS + 4, 4);
+					std::memcpy(vDst + j * BPS - 4, vDst + j * BPS + 4, 4);
+				}
+			}
+
+			const TopSamples* topSamples = _topSamples.data() + mbX;
+			if (mbY > 0)
+			{
+				std::memcpy(yDst - BPS, topSamples[0].y, 16);
+				std::memcpy(uDst - BPS, topSamples[0].u, 8);
+				std::memcpy(vDst - BPS, topSamples[0].v, 8);
+			}
+
+			const bool hasTop = mbY > 0;
+			const bool hasLeft = mbX > 0;
+			if (modes.isI4x4)
+			{
+				uint8_t* topRight = yDst - BPS + 16;
+				if (mbY > 0)
+				{
+					if (mbX + 1 >= _mbW)
+					{
+						std::memset(topRight, topSamples[0].y[15], 4);
+					}
+					else
+					{
+						std::memcpy(topRight, topSamples[1].y, 4);
+					}
+				}
+				// 右列子块的右上方样本都取自宏块上方
+				for (int row = 1; row < 4; ++row)
+				{
+					std::memcpy(topRight + row * 4 * BPS, topRight, 4);
+				}
+
+				for (int n = 0; n < 16; ++n)
+				{
+					uint8_t* dst = yDst + (n & 3) * 4 + (n >> 2) * 4 * BPS;
+					predictSubblock(dst, modes.yModes[n]);
+					if (_transforms[n] == BlockTransform::Full)
+					{
+						_dsp.inverseTransform(_coeffs + n * 16, dst, BPS, 1);
+					}
+					else if (_transforms[n] == BlockTransform::DC)
+					{
+						vp8_dsp::inverseTransformDC(_coeffs + n * 16, dst, BPS);
+					}
+				}
+			}
+			else
+			{
+				predictBlock(yDst, 16, modes.yModes[0], hasTop, hasLeft);
+			}
+
+			predictBlock(uDst, 8, modes.uvMode, hasTop, hasLeft);
+			predictBlock(vDst, 8, modes.uvMode, hasTop, hasLeft);
+
+			// 16x16 与色度：预测完成后按水平相邻的块对做逆变换
+			auto addResiduals = [this](int firstBlock, int blocksPerRow, int rows, uint8_t* dst)
+			{
+				for (int row = 0; row < rows; ++row)
+				{
+					for (int col = 0; col < blocksPerRow; col += 2)
+					{
+						const int n = firstBlock + row * blocksPerRow + col;
+						uint8_t* d = dst + row * 4 * BPS + col * 4;
+						if (_transforms[n] == BlockTransform::Full && _transforms[n + 1] == BlockTransform::Full)
+						{
+							_dsp.inverseTransform(_coeffs + n * 16, d, BPS, 2);
+							continue;
+						}
+						for (int k = 0; k < 2; ++k)
+						{
+							if (_transforms[n + k] == BlockTransform::Full)
+							{
+								_dsp.inverseTransform(_coeffs + (n + k) * 16, d + k * 4, BPS, 1);
+							}
+							else if (_transforms[n + k] == BlockTransform::DC)
+							{
+								vp8_dsp::inverseTransformDC(_coeffs + (n + k) * 16, d + k * 4, BPS);
+							}
+						}
+					}
+				}
+			};
+			if (!modes.isI4x4)
+			{
+				addResiduals(0, 4, 4, yDst);
+			}
+			addResiduals(16, 2, 2, uDst);
+			addResiduals(20, 2, 2, vDst);
+
+			// 保存未滤波的最下一行，供下一行宏块预测
+			TopSamples& stash = _topSamples[mbX];
+			std::memcpy(stash.y, yDst + 15 * BPS, 16);
+			std::memcpy(stash.u, uDst + 7 * BPS, 8);
+			std::memcpy(stash.v, vDst + 7 * BPS, 8);
+
+			// 写入整帧平面
+			uint8_t* yOut = _yPlane.data() + static_cast<size_t>(mbY) * 16 * _yStride + mbX * 16;
+			uint8_t* uOut = _uPlane.data() + static_cast<size_t>(mbY) * 8 * _uvStride + mbX * 8;
+			uint8_t* vOut = _vPlane.data() + static_cast<size_t>(mbY) * 8 * _uvStride + mbX * 8;
+			for (int j = 0; j < 16; ++j)
+			{
+				std::memcpy(yOut + j * _yStride, yDst + j * BPS, 16);
+			}
+			for (int j = 0; j < 8; ++j)
+			{
+				std::memcpy(uOut + j * _uvStride, uDst + j * BPS, 8);
+				std::memcpy(vOut + j * _uvStride, vDst + j * BPS, 8);
+			}
+		}
+
+		// ----------------------------------------------------------------------------
+		// 环路滤波与输出
+		// ----------------------------------------------------------------------------
+
+		void Decoder::filterMacroblock(uint32_t mbX, uint32_t mbY) const
+		{
+			const FilterInfo& info = _filterInfo[static_cast<size_t>(mbY) * _mbW + mbX];
+			const int limit = info.limit;
+			if (limit == 0)
+			{
+				return;
+			}
+
+			const ptrdiff_t yStride = static_cast<ptrdiff_t>(_yStride);
+			uint8_t* yDst = const_cast<uint8_t*>(_yPlane.data()) + static_cast<size_t>(mbY) * 16 * _yStride + mbX * 16;
+			if (_filterType == 1)
+			{
+				if (mbX > 0)
+				{
+					_dsp.simpleH16(yDst, yStride, limit + 4);
+				}
+				if (info.inner)
+				{
+					_dsp.simpleH16Inner(yDst, yStride, limit);
+				}
+				if (mbY > 0)
+				{
+					_dsp.simpleV16(yDst, yStride, limit + 4);
+				}
+				if (info.inner)
+				{
+					_dsp.simpleV16Inner(yDst, yStride, limit);
+				}
+				return;
+			}
+
+			const ptrdiff_t uvStride = static_cast<ptrdiff_t>(_uvStride);
+			const size_t uvOffset = static_cast<size_t>(mbY) * 8 * _uvStride + mbX * 8;
+			uint8_t* uDst = const_cast<uint8_t*>(_uPlane.data()) + uvOffset;
+			uint8_t* vDst = const_cast<uint8_t*>(_vPlane.data()) + uvOffset;
+			const int ilevel = info.interiorLimit;
+			const int hevThresh = info.hevThreshold;
+			if (mbX > 0)
+			{
+				_dsp.h16(yDst, yStride, limit + 4, ilevel, hevThresh);
+				_dsp.h8(uDst, vDst, uvStride, limit + 4, ilevel, hevThresh);
+			}
+			if (info.inner)
+			{
+				_dsp.h16Inner(yDst, yStride, limit, ilevel, hevThresh);
+				_dsp.h8Inner(uDst, vDst, uvStride, limit, ilevel, hevThresh);
+			}
+			if (mbY > 0)
+			{
+				_dsp.v16(yDst, yStride, limit + 4, ilevel, hevThresh);
+				_dsp.v8(uDst, vDst, uvStride, limit + 4, ilevel, hevThresh);
+			}
+			if (info.inner)
+			{
+				_dsp.v16Inner(yDst, yStride, limit, ilevel, hevThresh);
+				_dsp.v8Inner(uDst, vDst, uvStride, limit, ilevel, hevThresh);
+			}
+		}
+
+		/**
+		 * @brief 转换一个宏块行覆盖的输出行
+		 *
+		 * 输出行 r 的色度取色度行 r/2 附近的两行：奇数行为 (r-1)/2 与 (r+1)/2，偶数行为 r/2 与 r/2-1，
+		 * 首行与偶数高度的末行两行相同。因此调用前该行及下一宏块行的首个色度行必须已完成滤波。
+		 *
+		 * @param scratch 临时缓冲（两行上采样后的色度）
+		 */
+		void Decoder::convertRows(uint32_t mbRow, std::vector<uint8_t>& scratch) const
+		{
+			const uint32_t rowBegin = mbRow * 16;
+			const uint32_t rowEnd = std::min(rowBegin + 16, _height);
+			const uint32_t chromaHeight = (_height + 1) / 2;
+			scratch.resize(static_cast<size_t>(_width) * 2);
+			uint8_t* uRow = scratch.data();
+			uint8_t* vRow = scratch.data() + _width;
+
+			for (uint32_t r = rowBegin; r < rowEnd; ++r)
+			{
+				uint32_t nearRow;
+				uint32_t farRow;
+				if (r == 0)
+				{
+					nearRow = farRow = 0;
+				}
+				else if (r & 1)
+				{
+					nearRow = (r - 1) / 2;
+					farRow = std::min((r + 1) / 2, chromaHeight - 1);
+				}
+				else
+				{
+					nearRow = r / 2;
+					farRow = r / 2 - 1;
+				}
+
+				_dsp.upsampleRow(_uPlane.data() + nearRow * _uvStride, _uPlane.data() + farRow * _uvStride, uRow, _width);
+				_dsp.upsampleRow(_vPlane.data() + nearRow * _uvStride, _vPlane.data() + farRow * _uvStride, vRow, _width);
+				_dsp.yuvToRgbaRow(_yPlane.data() + r * _yStride, uRow, vRow, _rgba + r * _rgbaStride, _width);
+			}
+		}
+
+		/// 宏块行 mbY 滤波完成后：上一行的像素不再变化，可以输出
+		void Decoder::finishRow(uint32_t mbY, std::vector<uint8_t>& scratch) const
+		{
+			if (mbY > 0)
+			{
+				convertRows(mbY - 1, scratch);
+			}
+			if (mbY + 1 == _mbH)
+			{
+				convertRows(mbY, scratch);
+			}
+		}
+
+		bool Decoder::shouldFilterParallel() const noexcept
+		{
+#if !defined(SHINE_PLATFORM_WASM) && !defined(__EMSCRIPTEN__)
+			return _options.parallel && _mbH > 1 &&
+				static_cast<size_t>(_width) * _height >= _options.parallelMinPixels &&
+				util::ThreadPool::Get().GetThreadCount() > 0;
+#else
+			return false;
+#endif
+		}
+
+		std::expected<void, std::string> Decoder::decode()
+		{
+			auto headers = parseHeaders();
+			if (!headers.has_value())
+			{
+				return headers;
+			}
+			precomputeFilterStrengths();
+
+			_yStride = static_cast<size_t>(_mbW) * 16;
+			_uvStride = static_cast<size_t>(_mbW) * 8;
+			_yPlane.resize(_yStride * _mbH * 16);
+			_uPlane.resize(_uvStride * _mbH * 8);
+			_vPlane.resize(_uvStride * _mbH * 8);
+			_rowModes.resize(_mbW);
+			_intraTop.assign(static_cast<size_t>(_mbW) * 4, B_DC_PRED);
+			_nzTop.assign(_mbW, NonZeroContext{});
+			_topSamples.resize(_mbW);
+			_filterInfo.resize(static_cast<size_t>(_mbW) * _mbH);
+
+			// 解码第 mbY 行：模式来自第一分区，残差来自按行轮换的分区，随后立即重建
+			auto decodeRow = [this](uint32_t mbY) -> std::expected<void, std::string>
+			{
+				_nzLeft = NonZeroContext{};
+				std::memset(_intraLeft, B_DC_PRED, sizeof(_intraLeft));
+				parseIntraModeRow();
+				if (_br.eof())
+				{
+					return std::unexpected("Premature end of VP8 partition 0");
+				}
+
+				BoolDecoder& tokens = _partitions[mbY & (_partitions.size() - 1)];
+				for (uint32_t mbX = 0; mbX < _mbW; ++mbX)
+				{
+					if (!decodeMacroblock(mbX, mbY, tokens))
+					{
+						return std::unexpected("Premature end of VP8 token partition");
+					}
+				}
+				return {};
+			};
+
+			auto filterRow = [this](uint32_t mbY)
+			{
+				if (_filterType > 0)
+				{
+					for (uint32_t mbX = 0; mbX < _mbW; ++mbX)
+					{
+						filterMacroblock(mbX, mbY);
+					}
+				}
+			};
+
+			if (!shouldFilterParallel())
+			{
+				std::vector<uint8_t> scratch;
+				for (uint32_t mbY = 0; mbY < _mbH; ++mbY)
+				{
+					auto row = decodeRow(mbY);
+					if (!row.has_value())
+					{
+						return row;
+					}
+					filterRow(mbY);
+					finishRow(mbY, scratch);
+				}
+				return {};
+			}
+
+#if !defined(SHINE_PLATFORM_WASM) && !defined(__EMSCRIPTEN__)
+			// 调用线程负责熵解码与重建；工作线程按宏块行领取滤波与输出任务。
+			// 宏块 (x, y) 的左边 / 上边滤波会读写 (x+1, y-1) 左边滤波修改过的像素，
+			// 因此要等第 y-1 行完成 x+2 个宏块（波前）。滤波不影响预测（预测使用保存的未滤波样本），
+			// 所以滤波可以与后续行的重建同时进行
+			struct ParallelContext
+			{
+				const Decoder* decoder;
+				std::atomic<uint32_t> nextRow{ 0 };
+				std::atomic<uint32_t> reconstructedRows{ 0 };  ///< 已重建的行数，最高位表示解码失败
+				std::unique_ptr<std::atomic<uint32_t>[]> progress;  ///< 每行已滤波的宏块数
+			} ctx;
+			ctx.decoder = this;
+			ctx.progress = std::make_unique<std::atomic<uint32_t>[]>(_mbH);
+			for (uint32_t i = 0; i < _mbH; ++i)
+			{
+				ctx.progress[i].store(0, std::memory_order_relaxed);
+			}
+
+			// 重建通常是瓶颈，少量工作线程就能跟上
+			constexpr uint32_t kMaxFilterTasks = 4;
+			const uint32_t taskCount = std::min({ util::ThreadPool::Get().GetThreadCount(), _mbH, kMaxFilterTasks });
+
+			util::TaskGroup group(taskCount, [](void* userdata, u32)
+			{
+				auto& c = *static_cast<ParallelContext*>(userdata);
+				const Decoder& d = *c.decoder;
+				std::vector<uint8_t> scratch;
+				for (;;)
+				{
+					const uint32_t mbY = c.nextRow.fetch_add(1, std::memory_order_relaxed);
+					if (mbY >= d._mbH)
+					{
+						return;
+					}
+
+					// 等待该行重建完成；解码失败时放弃尚未重建的行
+					for (uint32_t state = c.reconstructedRows.load(std::memory_order_acquire);
+						(state & ~kAbortedFlag) <= mbY;
+						state = c.reconstructedRows.load(std::memory_order_acquire))
+					{
+						if (state & kAbortedFlag)
+						{
+							return;
+						}
+						c.reconstructedRows.wait(state, std::memory_order_acquire);
+					}
+
+					if (d._filterType > 0)
+					{
+						for (uint32_t mbX = 0; mbX < d._mbW; ++mbX)
+						{
+							if (mbY > 0)
+							{
+								const uint32_t needed = std::min(mbX + 2, d._mbW);
+								std::atomic<uint32_t>& above = c.progress[mbY - 1];
+								for (uint32_t done = above.load(std::memory_order_acquire); done < needed;
+									done = above.load(std::memory_order_acquire))
+								{
+									above.wait(done, std::memory_order_acquire);
+								}
+							}
+							d.filterMacroblock(mbX, mbY);
+							c.progress[mbY].store(mbX + 1, std::memory_order_release);
+							c.progress[mbY].notify_all();
+						}
+					}
+
+					d.finishRow(mbY, scratch);
+				}
+			}, &ctx);
+
+			for (uint32_t task = 0; task < taskCount; ++task)
+			{
+				group.Submit(task);
+			}
+
+			std::expected<void, std::string> result;
+			for (uint32_t mbY = 0; mbY < _mbH; ++mbY)
+			{
+				result = decodeRow(mbY);
+				if (!result.has_value())
+				{
+					ctx.reconstructedRows.fetch_or(kAbortedFlag, std::memory_order_release);
+					ctx.reconstructedRows.notify_all();
+					break;
+				}
+				ctx.reconstructedRows.store(mbY + 1, std::memory_order_release);
+				ctx.reconstructedRows.notify_all();
+			}
+			group.Wait();
+			return result;
+#else
+			return {};
+#endif
+		}
+	} // namespace
+
+	std::expected<Vp8FrameInfo, std::string> parseFrameInfo(const uint8_t* data, size_t size)
+	{
+		// 帧标记（3 字节）+ 起始码 9D 01 2A + 宽高（各 14 位 + 2 位缩放）
+		if (!data || size < 10)
+		{
+			return std::unexpected("VP8 frame is too small");
+		}
+
+		const uint32_t bits = data[0] | (data[1] << 8) | (data[2] << 16);
+		const bool keyFrame = (bits & 1) == 0;
+		const uint32_t profile = (bits >> 1) & 7;
+		const bool show = ((bits >> 4) & 1) != 0;
+		if (!keyFrame)
+		{
+			return std::unexpected("VP8 frame is not a key frame");
+		}
+		if (profile > 3)
+		{
+			return std::unexpected("Unsupported VP8 profile");
+		}
+		if (!show)
+		{
+			return std::unexpected("VP8 frame is not displayable");
+		}
+		if (data[3] != 0x9D || data[4] != 0x01 || data[5] != 0x2A)
+		{
+			return std::unexpected("Invalid VP8 signature");
+		}
+
+		Vp8FrameInfo info;
+		info.width = (data[6] | (data[7] << 8)) & 0x3FFF;
+		info.height = (data[8] | (data[9] << 8)) & 0x3FFF;
+		info.firstPartitionSize = bits >> 5;
+		if (info.width == 0 || info.height == 0)
+		{
+			return std::unexpected("Invalid VP8 dimensions");
+		}
+		if (info.firstPartitionSize > size - 10)
+		{
+			return std::unexpected("VP8 first partition is truncated");
+		}
+		return info;
+	}
+
+	std::expected<void, std::string> decodeFrame(const uint8_t* data, size_t size,
+		uint8_t* rgba, size_t rgbaStride, const Vp8DecodeOptions& options)
+	{
+		if (!rgba)
+		{
+			return std::unexpected("VP8 output buffer is null");
+		}
+		// 解码器状态约 2KB，加上每行 / 每宏块的向量，放在堆上
+		auto decoder = std::make_unique<Decoder>(data, size, rgba, rgbaStride, options);
+		return decoder->decode();
+	}
+
+} // namespace shine::image::vp8
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <expected>
+
+/**
+ * @file vp8.h
+ * @brief VP8 关键帧解码（有损 WebP 的 "VP8 " 块）
+ *
+ * 完整实现 RFC 6386 的关键帧解码流程：布尔熵解码、帧内预测、逆 WHT / DCT、环路滤波，
+ * 最后用 libwebp 的双线性色度上采样转换为 RGBA，输出与 libwebp 逐字节一致。
+ *
+ * 解码按宏块行流水线进行：调用线程逐行熵解码并重建（未滤波），环路滤波与颜色转换
+ * 可交给 util::ThreadPool 按波前方式并行（第 y 行的第 x 个宏块在第 y-1 行完成到 x+1 之后滤波）。
+ *
+ * @see https://datatracker.ietf.org/doc/html/rfc6386
+ */
+
+namespace shine::image::vp8
+{
+	/**
+	 * @brief VP8 帧头信息
+	 */
+	struct Vp8FrameInfo
+	{
+		uint32_t width = 0;              ///< 图像宽度（像素）
+		uint32_t height = 0;             ///< 图像高度（像素）
+		uint32_t firstPartitionSize = 0; ///< 第一分区（模式与概率）的字节数
+	};
+
+	/**
+	 * @brief 解码选项
+	 */
+	struct Vp8DecodeOptions
+	{
+		bool parallel = true;                    ///< 是否允许多线程环路滤波与颜色转换
+		size_t parallelMinPixels = 512 * 512;    ///< 启用多线程的最小像素数
+	};
+
+	/**
+	 * @brief 解析 VP8 帧头（3 字节帧标记 + 起始码 + 尺寸）
+	 * @param data "VP8 " 块数据
+	 * @param size 数据大小
+	 * @return 帧信息，非关键帧或数据无效时返回错误
+	 */
+	std::expected<Vp8FrameInfo, std::string> parseFrameInfo(const uint8_t* data, size_t size);
+
+	/**
+	 * @brief 解码一个 VP8 关键帧为 RGBA（alpha 为 255）
+	 * @param data "VP8 " 块数据
+	 * @param size 数据大小
+	 * @param rgba 输出缓冲，至少 height 行，每行 width * 4 字节
+	 * @param rgbaStride 输出行跨度（字节）
+	 * @param options 解码选项
+	 * @return 成功返回 void，失败返回错误信息
+	 */
+	std::expected<void, std::string> decodeFrame(const uint8_t* data, size_t size,
+		uint8_t* rgba, size_t rgbaStride, const Vp8DecodeOptions& options = {});
+
+} // namespace shine::image::vp8
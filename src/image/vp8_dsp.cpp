@@ -0,0 +1,1089 @@
+#include "vp8_dsp.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if !defined(__EMSCRIPTEN__) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define SHINE_VP8_DSP_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要按函数开启指令集，MSVC 的 intrinsic 不依赖编译选项
+#if defined(SHINE_VP8_DSP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SHINE_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define SHINE_TARGET_SSE2
+#endif
+
+/**
+ * @file vp8_dsp.cpp
+ * @brief VP8 像素重建内核实现
+ *
+ * 逆变换与环路滤波的 SIMD 构造沿用 libwebp dec_sse2.c：变换中的 16 位乘法用
+ * mulhi(x, k) + x 表示 (x * K) >> 16，滤波在翻转符号位后的 int8 上做饱和运算。
+ * 标量实现按同样的 16 位回绕计算逆变换；滤波的饱和运算与 RFC 6386 的钳位等价，
+ * 因此任意输入下各内核结果一致。
+ */
+
+namespace shine::image::vp8_dsp
+{
+	namespace
+	{
+		// 逆变换常数：sqrt(2) * cos(pi/8) 与 sqrt(2) * sin(pi/8) 的 16 位定点值减去 1 << 16
+		constexpr int32_t kC1 = 20091;           // 85627 - 65536
+		constexpr int32_t kC2 = 35468 - 65536;   // 作为 int16 为 -30068
+
+		// YUV -> RGB 系数（BT.601，14 位定点，输入样本放大 256 倍后取乘积高 16 位）
+		constexpr int32_t kYScale = 19077;   // 1.164
+		constexpr int32_t kVToR = 26149;     // 1.596
+		constexpr int32_t kUToG = 6419;      // 0.391
+		constexpr int32_t kVToG = 13320;     // 0.813
+		constexpr int32_t kUToB = 33050;     // 2.018
+		constexpr int32_t kROffset = 14234;
+		constexpr int32_t kGOffset = 8708;
+		constexpr int32_t kBOffset = 17685;
+
+		// ============================================================================
+		// 标量参考实现
+		// ============================================================================
+
+		/// 按 16 位回绕（与 SIMD 的 add_epi16 / sub_epi16 一致）
+		inline int32_t wrap16(int32_t v) noexcept
+		{
+			return static_cast<int16_t>(static_cast<uint16_t>(v));
+		}
+
+		/// 与 _mm_mulhi_epi16 一致
+		inline int32_t mulhi16(int32_t a, int32_t k) noexcept
+		{
+			return (a * k) >> 16;
+		}
+
+		inline uint8_t clampByte(int32_t v) noexcept
+		{
+			return static_cast<uint8_t>(std::clamp(v, 0, 255));
+		}
+
+		/**
+		 * @brief 一维逆变换（四个输入，结果按 16 位回绕）
+		 */
+		inline void idct4(int32_t i0, int32_t i1, int32_t i2, int32_t i3, int32_t* out) noexcept
+		{
+			const int32_t a = wrap16(i0 + i2);
+			const int32_t b = wrap16(i0 - i2);
+			const int32_t c = wrap16(wrap16(i1 - i3) + wrap16(mulhi16(i1, kC2) - mulhi16(i3, kC1)));
+			const int32_t d = wrap16(wrap16(i1 + i3) + wrap16(mulhi16(i1, kC1) + mulhi16(i3, kC2)));
+			out[0] = wrap16(a + d);
+			out[1] = wrap16(b + c);
+			out[2] = wrap16(b - c);
+			out[3] = wrap16(a - d);
+		}
+
+		void inverseTransformBlockScalar(const int16_t* in, uint8_t* dst, ptrdiff_t stride) noexcept
+		{
+			// 竖直方向：tmp[行 * 4 + 列]
+			int32_t tmp[16];
+			for (int col = 0; col < 4; ++col)
+			{
+				int32_t out[4];
+				idct4(in[col], in[4 + col], in[8 + col], in[12 + col], out);
+				for (int row = 0; row < 4; ++row)
+				{
+					tmp[row * 4 + col] = out[row];
+				}
+			}
+
+			// 水平方向，舍入常数加在 DC 上
+			for (int row = 0; row < 4; ++row)
+			{
+				const int32_t* t = tmp + row * 4;
+				int32_t out[4];
+				idct4(wrap16(t[0] + 4), t[1], t[2], t[3], out);
+				uint8_t* d = dst + row * stride;
+				for (int col = 0; col < 4; ++col)
+				{
+					d[col] = clampByte(d[col] + (out[col] >> 3));
+				}
+			}
+		}
+
+		void inverseTransformScalar(const int16_t* coefficients, uint8_t* dst, ptrdiff_t stride, size_t blockCount)
+		{
+			for (size_t i = 0; i < blockCount; ++i)
+			{
+				inverseTransformBlockScalar(coefficients + i * 16, dst + i * 4, stride);
+			}
+		}
+
+		// ----------------------------------------------------------------------------
+		// 环路滤波（RFC 6386 15.2 - 15.4）
+		// ----------------------------------------------------------------------------
+
+		inline int32_t clampS8(int32_t v) noexcept
+		{
+			return std::clamp(v, -128, 127);
+		}
+
+		inline int32_t clampS4(int32_t v) noexcept
+		{
+			return std::clamp(v, -16, 15);
+		}
+
+		inline int32_t absDiff(int32_t a, int32_t b) noexcept
+		{
+			return a > b ? a - b : b - a;
+		}
+
+		/// 修改 p0、q0（简单滤波器与高方差边）
+		inline void doFilter2(uint8_t* p, ptrdiff_t step) noexcept
+		{
+			const int32_t p1 = p[-2 * step], p0 = p[-step], q0 = p[0], q1 = p[step];
+			const int32_t a = 3 * (q0 - p0) + clampS8(p1 - q1);
+			const int32_t a1 = clampS4((a + 4) >> 3);
+			const int32_t a2 = clampS4((a + 3) >> 3);
+			p[-step] = clampByte(p0 + a2);
+			p[0] = clampByte(q0 - a1);
+		}
+
+		/// 修改 p1..q1（子块边）
+		inline void doFilter4(uint8_t* p, ptrdiff_t step) noexcept
+		{
+			const int32_t p1 = p[-2 * step], p0 = p[-step], q0 = p[0], q1 = p[step];
+			const int32_t a = 3 * (q0 - p0);
+			const int32_t a1 = clampS4((a + 4) >> 3);
+			const int32_t a2 = clampS4((a + 3) >> 3);
+			const int32_t a3 = (a1 + 1) >> 1;
+			p[-2 * step] = clampByte(p1 + a3);
+			p[-step] = clampByte(p0 + a2);
+			p[0] = clampByte(q0 - a1);
+			p[step] = clampByte(q1 - a3);
+		}
+
+		/// 修改 p2..q2（宏块边）
+		inline void doFilter6(uint8_t* p, ptrdiff_t step) noexcept
+		{
+			const int32_t p2 = p[-3 * step], p1 = p[-2 * step], p0 = p[-step];
+			const int32_t q0 = p[0], q1 = p[step], q2 = p[2 * step];
+			const int32_t a = clampS8(3 * (q0 - p0) + clampS8(p1 - q1));
+			const int32_t a1 = (27 * a + 63) >> 7;
+			const int32_t a2 = (18 * a + 63) >> 7;
+			const int32_t a3 = (9 * a + 63) >> 7;
+			p[-3 * step] = clampByte(p2 + a3);
+			p[-2 * step] = clampByte(p1 + a2);
+			p[-step] = clampByte(p0 + a1);
+			p[0] = clampByte(q0 - a1);
+			p[step] = clampByte(q1 - a2);
+			p[2 * step] = clampByte(q2 - a3);
+		}
+
+		inline bool highEdgeVariance(const uint8_t* p, ptrdiff_t step, int thresh) noexcept
+		{
+			return absDiff(p[-2 * step], p[-step]) > thresh || absDiff(p[step], p[0]) > thresh;
+		}
+
+		/// 2 * |p0 - q0| + |p1 - q1| / 2 <= thresh，写成不含除法的形式（thresh2 = 2 * thresh + 1）
+		inline bool needsFilter(const uint8_t* p, ptrdiff_t step, int thresh2) noexcept
+		{
+			return 4 * absDiff(p[-step], p[0]) + absDiff(p[-2 * step], p[step]) <= thresh2;
+		}
+
+		inline bool needsFilter2(const uint8_t* p, ptrdiff_t step, int thresh2, int ithresh) noexcept
+		{
+			if (!needsFilter(p, step, thresh2))
+			{
+				return false;
+			}
+			const int32_t p3 = p[-4 * step], p2 = p[-3 * step], p1 = p[-2 * step], p0 = p[-step];
+			const int32_t q0 = p[0], q1 = p[step], q2 = p[2 * step], q3 = p[3 * step];
+			return absDiff(p3, p2) <= ithresh && absDiff(p2, p1) <= ithresh && absDiff(p1, p0) <= ithresh &&
+				absDiff(q3, q2) <= ithresh && absDiff(q2, q1) <= ithresh && absDiff(q1, q0) <= ithresh;
+		}
+
+		void simpleFilterScalar(uint8_t* p, ptrdiff_t step, ptrdiff_t advance, int thresh) noexcept
+		{
+			const int thresh2 = 2 * thresh + 1;
+			for (int i = 0; i < 16; ++i, p += advance)
+			{
+				if (needsFilter(p, step, thresh2))
+				{
+					doFilter2(p, step);
+				}
+			}
+		}
+
+		void simpleV16Scalar(uint8_t* p, ptrdiff_t stride, int thresh)
+		{
+			simpleFilterScalar(p, stride, 1, thresh);
+		}
+
+		void simpleH16Scalar(uint8_t* p, ptrdiff_t stride, int thresh)
+		{
+			simpleFilterScalar(p, 1, stride, thresh);
+		}
+
+		void simpleV16InnerScalar(uint8_t* p, ptrdiff_t stride, int thresh)
+		{
+			for (int k = 1; k < 4; ++k)
+			{
+				simpleFilterScalar(p + 4 * k * stride, stride, 1, thresh);
+			}
+		}
+
+		void simpleH16InnerScalar(uint8_t* p, ptrdiff_t stride, int thresh)
+		{
+			for (int k = 1; k < 4; ++k)
+			{
+				simpleFilterScalar(p + 4 * k, 1, stride, thresh);
+			}
+		}
+
+		/**
+		 * @brief 复杂滤波器沿一条边处理 size 个像素
+		 * @param edge 宏块边（Filter6）或子块边（Filter4），高方差处都用 Filter2
+		 */
+		void complexFilterScalar(uint8_t* p, ptrdiff_t step, ptrdiff_t advance, int size,
+			int thresh, int ithresh, int hevThresh, bool edge) noexcept
+		{
+			const int thresh2 = 2 * thresh + 1;
+			for (int i = 0; i < size; ++i, p += advance)
+			{
+				if (!needsFilter2(p, step, thresh2, ithresh))
+				{
+					continue;
+				}
+				if (highEdgeVariance(p, step, hevThresh))
+				{
+					doFilter2(p, step);
+				}
+				else if (edge)
+				{
+					doFilter6(p, step);
+				}
+				else
+				{
+					doFilter4(p, step);
+				}
+			}
+		}
+
+		void v16Scalar(uint8_t* p, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			complexFilterScalar(p, stride, 1, 16, thresh, ithresh, hevThresh, true);
+		}
+
+		void h16Scalar(uint8_t* p, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			complexFilterScalar(p, 1, stride, 16, thresh, ithresh, hevThresh, true);
+		}
+
+		void v16InnerScalar(uint8_t* p, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			for (int k = 1; k < 4; ++k)
+			{
+				complexFilterScalar(p + 4 * k * stride, stride, 1, 16, thresh, ithresh, hevThresh, false);
+			}
+		}
+
+		void h16InnerScalar(uint8_t* p, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			for (int k = 1; k < 4; ++k)
+			{
+				complexFilterScalar(p + 4 * k, 1, stride, 16, thresh, ithresh, hevThresh, false);
+			}
+		}
+
+		void v8Scalar(uint8_t* u, uint8_t* v, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			complexFilterScalar(u, stride, 1, 8, thresh, ithresh, hevThresh, true);
+			complexFilterScalar(v, stride, 1, 8, thresh, ithresh, hevThresh, true);
+		}
+
+		void h8Scalar(uint8_t* u, uint8_t* v, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			complexFilterScalar(u, 1, stride, 8, thresh, ithresh, hevThresh, true);
+			complexFilterScalar(v, 1, stride, 8, thresh, ithresh, hevThresh, true);
+		}
+
+		void v8InnerScalar(uint8_t* u, uint8_t* v, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			complexFilterScalar(u + 4 * stride, stride, 1, 8, thresh, ithresh, hevThresh, false);
+			complexFilterScalar(v + 4 * stride, stride, 1, 8, thresh, ithresh, hevThresh, false);
+		}
+
+		void h8InnerScalar(uint8_t* u, uint8_t* v, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			complexFilterScalar(u + 4, 1, stride, 8, thresh, ithresh, hevThresh, false);
+			complexFilterScalar(v + 4, 1, stride, 8, thresh, ithresh, hevThresh, false);
+		}
+
+		// ----------------------------------------------------------------------------
+		// 色度上采样与颜色转换
+		// ----------------------------------------------------------------------------
+
+		/// 输出像素 2x - 1 与 2x 的色度（a/b 为近行 x-1、x 处的样本，c/d 为远行）
+		inline void upsamplePair(int32_t a, int32_t b, int32_t c, int32_t d, uint8_t* out) noexcept
+		{
+			const int32_t avg = a + b + c + d + 8;
+			out[0] = static_cast<uint8_t>((((avg + 2 * (b + c)) >> 3) + a) >> 1);
+			out[1] = static_cast<uint8_t>((((avg + 2 * (a + d)) >> 3) + b) >> 1);
+		}
+
+		/// 从色度样本 first 开始处理剩余的像素对与行尾
+		void upsampleRowTail(const uint8_t* near, const uint8_t* far, uint8_t* out, size_t width, size_t first) noexcept
+		{
+			const size_t lastPair = (width - 1) >> 1;
+			for (size_t x = first; x <= lastPair; ++x)
+			{
+				upsamplePair(near[x - 1], near[x], far[x - 1], far[x], out + 2 * x - 1);
+			}
+			if ((width & 1) == 0)
+			{
+				out[width - 1] = static_cast<uint8_t>((3 * near[lastPair] + far[lastPair] + 2) >> 2);
+			}
+		}
+
+		void upsampleRowScalar(const uint8_t* near, const uint8_t* far, uint8_t* out, size_t width)
+		{
+			if (width == 0)
+			{
+				return;
+			}
+			out[0] = static_cast<uint8_t>((3 * near[0] + far[0] + 2) >> 2);
+			upsampleRowTail(near, far, out, width, 1);
+		}
+
+		inline int32_t multHi(int32_t v, int32_t coeff) noexcept
+		{
+			return (v * coeff) >> 8;
+		}
+
+		/// 14 位定点结果 -> 8 位（负数为 0，溢出为 255）
+		inline uint8_t clip8(int32_t v) noexcept
+		{
+			return (v & ~16383) == 0 ? static_cast<uint8_t>(v >> 6) : (v < 0 ? 0 : 255);
+		}
+
+		void yuvToRgbaScalar(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* rgba, size_t begin, size_t width) noexcept
+		{
+			for (size_t x = begin; x < width; ++x)
+			{
+				const int32_t luma = multHi(y[x], kYScale);
+				uint8_t* p = rgba + x * 4;
+				p[0] = clip8(luma + multHi(v[x], kVToR) - kROffset);
+				p[1] = clip8(luma - multHi(u[x], kUToG) - multHi(v[x], kVToG) + kGOffset);
+				p[2] = clip8(luma + multHi(u[x], kUToB) - kBOffset);
+				p[3] = 255;
+			}
+		}
+
+		void yuvToRgbaRowScalar(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* rgba, size_t width)
+		{
+			yuvToRgbaScalar(y, u, v, rgba, 0, width);
+		}
+
+		constexpr DspKernels kScalarKernels = {
+			inverseTransformScalar,
+			simpleV16Scalar, simpleH16Scalar, simpleV16InnerScalar, simpleH16InnerScalar,
+			v16Scalar, h16Scalar, v16InnerScalar, h16InnerScalar,
+			v8Scalar, h8Scalar, v8InnerScalar, h8InnerScalar,
+			upsampleRowScalar,
+			yuvToRgbaRowScalar,
+		};
+
+#if defined(SHINE_VP8_DSP_X86)
+		// ============================================================================
+		// SSE2
+		// ============================================================================
+
+		SHINE_TARGET_SSE2 inline __m128i loadU32(const uint8_t* p) noexcept
+		{
+			int32_t v;
+			std::memcpy(&v, p, 4);
+			return _mm_cvtsi32_si128(v);
+		}
+
+		SHINE_TARGET_SSE2 inline void storeU32(uint8_t* p, __m128i v) noexcept
+		{
+			const int32_t x = _mm_cvtsi128_si32(v);
+			std::memcpy(p, &x, 4);
+		}
+
+		/// 两个 4x4 的 16 位矩阵分别转置（低 4 个通道为第一块，高 4 个为第二块）
+		SHINE_TARGET_SSE2 inline void transpose2x4x4(__m128i& r0, __m128i& r1, __m128i& r2, __m128i& r3) noexcept
+		{
+			const __m128i t0 = _mm_unpacklo_epi16(r0, r1);
+			const __m128i t1 = _mm_unpacklo_epi16(r2, r3);
+			const __m128i t2 = _mm_unpackhi_epi16(r0, r1);
+			const __m128i t3 = _mm_unpackhi_epi16(r2, r3);
+			const __m128i u0 = _mm_unpacklo_epi32(t0, t1);
+			const __m128i u1 = _mm_unpackhi_epi32(t0, t1);
+			const __m128i u2 = _mm_unpacklo_epi32(t2, t3);
+			const __m128i u3 = _mm_unpackhi_epi32(t2, t3);
+			r0 = _mm_unpacklo_epi64(u0, u2);
+			r1 = _mm_unpackhi_epi64(u0, u2);
+			r2 = _mm_unpacklo_epi64(u1, u3);
+			r3 = _mm_unpackhi_epi64(u1, u3);
+		}
+
+		SHINE_TARGET_SSE2 inline void idct4SSE2(__m128i i0, __m128i i1, __m128i i2, __m128i i3,
+			__m128i& o0, __m128i& o1, __m128i& o2, __m128i& o3) noexcept
+		{
+			const __m128i k1 = _mm_set1_epi16(static_cast<int16_t>(kC1));
+			const __m128i k2 = _mm_set1_epi16(static_cast<int16_t>(kC2));
+			const __m128i a = _mm_add_epi16(i0, i2);
+			const __m128i b = _mm_sub_epi16(i0, i2);
+			const __m128i c = _mm_add_epi16(_mm_sub_epi16(i1, i3),
+				_mm_sub_epi16(_mm_mulhi_epi16(i1, k2), _mm_mulhi_epi16(i3, k1)));
+			const __m128i d = _mm_add_epi16(_mm_add_epi16(i1, i3),
+				_mm_add_epi16(_mm_mulhi_epi16(i1, k1), _mm_mulhi_epi16(i3, k2)));
+			o0 = _mm_add_epi16(a, d);
+			o1 = _mm_add_epi16(b, c);
+			o2 = _mm_sub_epi16(b, c);
+			o3 = _mm_sub_epi16(a, d);
+		}
+
+		/**
+		 * @brief 逆变换一个或两个水平相邻的块
+		 */
+		SHINE_TARGET_SSE2 void inverseTransformSSE2Pair(const int16_t* in, uint8_t* dst, ptrdiff_t stride, bool two) noexcept
+		{
+			__m128i r0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 0));
+			__m128i r1 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 4));
+			__m128i r2 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 8));
+			__m128i r3 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 12));
+			if (two)
+			{
+				r0 = _mm_unpacklo_epi64(r0, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 16)));
+				r1 = _mm_unpacklo_epi64(r1, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 20)));
+				r2 = _mm_unpacklo_epi64(r2, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 24)));
+				r3 = _mm_unpacklo_epi64(r3, _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 28)));
+			}
+
+			// 竖直方向（每个通道一列），转置后每个通道一行
+			__m128i t0, t1, t2, t3;
+			idct4SSE2(r0, r1, r2, r3, t0, t1, t2, t3);
+			transpose2x4x4(t0, t1, t2, t3);
+
+			// 水平方向
+			idct4SSE2(_mm_add_epi16(t0, _mm_set1_epi16(4)), t1, t2, t3, r0, r1, r2, r3);
+			r0 = _mm_srai_epi16(r0, 3);
+			r1 = _mm_srai_epi16(r1, 3);
+			r2 = _mm_srai_epi16(r2, 3);
+			r3 = _mm_srai_epi16(r3, 3);
+			transpose2x4x4(r0, r1, r2, r3);
+
+			// 叠加到预测值上
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i rows[4] = { r0, r1, r2, r3 };
+			for (int row = 0; row < 4; ++row)
+			{
+				uint8_t* d = dst + row * stride;
+				const __m128i pred = two ? _mm_loadl_epi64(reinterpret_cast<const __m128i*>(d)) : loadU32(d);
+				const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi8(pred, zero), rows[row]);
+				const __m128i packed = _mm_packus_epi16(sum, sum);
+				if (two)
+				{
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(d), packed);
+				}
+				else
+				{
+					storeU32(d, packed);
+				}
+			}
+		}
+
+		void inverseTransformSSE2(const int16_t* coefficients, uint8_t* dst, ptrdiff_t stride, size_t blockCount)
+		{
+			size_t i = 0;
+			for (; i + 2 <= blockCount; i += 2)
+			{
+				inverseTransformSSE2Pair(coefficients + i * 16, dst + i * 4, stride, true);
+			}
+			if (i < blockCount)
+			{
+				inverseTransformSSE2Pair(coefficients + i * 16, dst + i * 4, stride, false);
+			}
+		}
+
+		// ----------------------------------------------------------------------------
+		// 环路滤波：每个 __m128i 是一条边同一侧的 16 个像素
+		// ----------------------------------------------------------------------------
+
+		/// |p - q|（无符号）
+		SHINE_TARGET_SSE2 inline __m128i absDiffU8(__m128i p, __m128i q) noexcept
+		{
+			return _mm_or_si128(_mm_subs_epu8(q, p), _mm_subs_epu8(p, q));
+		}
+
+		SHINE_TARGET_SSE2 inline __m128i flipSign(__m128i v) noexcept
+		{
+			return _mm_xor_si128(v, _mm_set1_epi8(static_cast<char>(0x80)));
+		}
+
+		/// 有符号字节算术右移 3 位
+		SHINE_TARGET_SSE2 inline __m128i signedShift3(__m128i v) noexcept
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(zero, v), 3 + 8);
+			const __m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(zero, v), 3 + 8);
+			return _mm_packs_epi16(lo, hi);
+		}
+
+		/// 2 * |p0 - q0| + |p1 - q1| / 2 <= thresh 的掩码（输入为无符号像素）
+		SHINE_TARGET_SSE2 inline __m128i needsFilterMask(__m128i p1, __m128i p0, __m128i q0, __m128i q1, int thresh) noexcept
+		{
+			const __m128i halfOuter = _mm_srli_epi16(_mm_and_si128(absDiffU8(p1, q1), _mm_set1_epi8(static_cast<char>(0xFE))), 1);
+			const __m128i inner = absDiffU8(p0, q0);
+			const __m128i sum = _mm_adds_epu8(_mm_adds_epu8(inner, inner), halfOuter);
+			const __m128i over = _mm_subs_epu8(sum, _mm_set1_epi8(static_cast<char>(thresh)));
+			return _mm_cmpeq_epi8(over, _mm_setzero_si128());
+		}
+
+		/// max(|p1 - p0|, |q1 - q0|) <= hevThresh 的掩码
+		SHINE_TARGET_SSE2 inline __m128i notHighEdgeVariance(__m128i p1, __m128i p0, __m128i q0, __m128i q1, int hevThresh) noexcept
+		{
+			const __m128i maxDiff = _mm_max_epu8(absDiffU8(p1, p0), absDiffU8(q1, q0));
+			const __m128i over = _mm_subs_epu8(maxDiff, _mm_set1_epi8(static_cast<char>(hevThresh)));
+			return _mm_cmpeq_epi8(over, _mm_setzero_si128());
+		}
+
+		/// p1 - q1 + 3 * (q0 - p0)，按 int8 饱和（输入已翻转符号位）
+		SHINE_TARGET_SSE2 inline __m128i baseDelta(__m128i p1, __m128i p0, __m128i q0, __m128i q1) noexcept
+		{
+			const __m128i p1q1 = _mm_subs_epi8(p1, q1);
+			const __m128i q0p0 = _mm_subs_epi8(q0, p0);
+			const __m128i s1 = _mm_adds_epi8(p1q1, q0p0);
+			const __m128i s2 = _mm_adds_epi8(q0p0, s1);
+			return _mm_adds_epi8(q0p0, s2);
+		}
+
+		/// p0 += (f + 3) >> 3，q0 -= (f + 4) >> 3（有符号）
+		SHINE_TARGET_SSE2 inline void applySimpleDelta(__m128i& p0, __m128i& q0, __m128i f) noexcept
+		{
+			const __m128i v3 = signedShift3(_mm_adds_epi8(f, _mm_set1_epi8(3)));
+			const __m128i v4 = signedShift3(_mm_adds_epi8(f, _mm_set1_epi8(4)));
+			q0 = _mm_subs_epi8(q0, v4);
+			p0 = _mm_adds_epi8(p0, v3);
+		}
+
+		SHINE_TARGET_SSE2 inline void doFilter2SSE2(__m128i p1, __m128i& p0, __m128i& q0, __m128i q1, int thresh) noexcept
+		{
+			const __m128i mask = needsFilterMask(p1, p0, q0, q1, thresh);
+			p0 = flipSign(p0);
+			q0 = flipSign(q0);
+			const __m128i a = _mm_and_si128(baseDelta(flipSign(p1), p0, q0, flipSign(q1)), mask);
+			applySimpleDelta(p0, q0, a);
+			p0 = flipSign(p0);
+			q0 = flipSign(q0);
+		}
+
+		/// 子块边：高方差处只改 p0/q0（带外侧抽头），否则改 p1..q1
+		SHINE_TARGET_SSE2 inline void doFilter4SSE2(__m128i& p1, __m128i& p0, __m128i& q0, __m128i& q1, __m128i mask, int hevThresh) noexcept
+		{
+			const __m128i notHev = notHighEdgeVariance(p1, p0, q0, q1, hevThresh);
+			p1 = flipSign(p1);
+			p0 = flipSign(p0);
+			q0 = flipSign(q0);
+			q1 = flipSign(q1);
+
+			__m128i t1 = _mm_andnot_si128(notHev, _mm_subs_epi8(p1, q1));
+			const __m128i t2 = _mm_subs_epi8(q0, p0);
+			t1 = _mm_adds_epi8(t1, t2);
+			t1 = _mm_adds_epi8(t1, t2);
+			t1 = _mm_adds_epi8(t1, t2);
+			t1 = _mm_and_si128(t1, mask);
+
+			const __m128i a2 = signedShift3(_mm_adds_epi8(t1, _mm_set1_epi8(3)));
+			const __m128i a1 = signedShift3(_mm_adds_epi8(t1, _mm_set1_epi8(4)));
+			p0 = flipSign(_mm_adds_epi8(p0, a2));
+			q0 = flipSign(_mm_subs_epi8(q0, a1));
+
+			// 有符号 (a1 + 1) >> 1
+			__m128i a3 = _mm_avg_epu8(_mm_add_epi8(a1, _mm_set1_epi8(static_cast<char>(0x80))), _mm_setzero_si128());
+			a3 = _mm_sub_epi8(a3, _mm_set1_epi8(64));
+			a3 = _mm_and_si128(notHev, a3);
+			q1 = flipSign(_mm_subs_epi8(q1, a3));
+			p1 = flipSign(_mm_adds_epi8(p1, a3));
+		}
+
+		/// p += (a >> 7)，q -= (a >> 7)，输出翻转回无符号
+		SHINE_TARGET_SSE2 inline void update2Pixels(__m128i& p, __m128i& q, __m128i aLo, __m128i aHi) noexcept
+		{
+			const __m128i delta = _mm_packs_epi16(_mm_srai_epi16(aLo, 7), _mm_srai_epi16(aHi, 7));
+			p = flipSign(_mm_adds_epi8(p, delta));
+			q = flipSign(_mm_subs_epi8(q, delta));
+		}
+
+		/// 宏块边：高方差处只改 p0/q0，否则按 27/18/9 权重改 p2..q2
+		SHINE_TARGET_SSE2 inline void doFilter6SSE2(__m128i& p2, __m128i& p1, __m128i& p0, __m128i& q0, __m128i& q1, __m128i& q2,
+			__m128i mask, int hevThresh) noexcept
+		{
+			const __m128i notHev = notHighEdgeVariance(p1, p0, q0, q1, hevThresh);
+			p2 = flipSign(p2);
+			p1 = flipSign(p1);
+			p0 = flipSign(p0);
+			q0 = flipSign(q0);
+			q1 = flipSign(q1);
+			q2 = flipSign(q2);
+			const __m128i a = baseDelta(p1, p0, q0, q1);
+
+			applySimpleDelta(p0, q0, _mm_and_si128(a, _mm_andnot_si128(notHev, mask)));
+
+			// f * 9：f 放在 16 位的高字节，与 0x0900 相乘取高 16 位
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i k9 = _mm_set1_epi16(0x0900);
+			const __m128i k63 = _mm_set1_epi16(63);
+			const __m128i f = _mm_and_si128(a, _mm_and_si128(notHev, mask));
+			const __m128i f9Lo = _mm_mulhi_epi16(_mm_unpacklo_epi8(zero, f), k9);
+			const __m128i f9Hi = _mm_mulhi_epi16(_mm_unpackhi_epi8(zero, f), k9);
+			const __m128i a2Lo = _mm_add_epi16(f9Lo, k63);
+			const __m128i a2Hi = _mm_add_epi16(f9Hi, k63);
+			const __m128i a1Lo = _mm_add_epi16(a2Lo, f9Lo);
+			const __m128i a1Hi = _mm_add_epi16(a2Hi, f9Hi);
+			const __m128i a0Lo = _mm_add_epi16(a1Lo, f9Lo);
+			const __m128i a0Hi = _mm_add_epi16(a1Hi, f9Hi);
+			update2Pixels(p2, q2, a2Lo, a2Hi);
+			update2Pixels(p1, q1, a1Lo, a1Hi);
+			update2Pixels(p0, q0, a0Lo, a0Hi);
+		}
+
+		/**
+		 * @brief 复杂滤波器（p3..q3 为边两侧各 4 个像素）
+		 */
+		SHINE_TARGET_SSE2 inline void complexFilterSSE2(__m128i& p3, __m128i& p2, __m128i& p1, __m128i& p0,
+			__m128i& q0, __m128i& q1, __m128i& q2, __m128i& q3, int thresh, int ithresh, int hevThresh, bool edge) noexcept
+		{
+			__m128i maxDiff = _mm_max_epu8(absDiffU8(p3, p2), absDiffU8(p2, p1));
+			maxDiff = _mm_max_epu8(maxDiff, absDiffU8(p1, p0));
+			maxDiff = _mm_max_epu8(maxDiff, absDiffU8(q3, q2));
+			maxDiff = _mm_max_epu8(maxDiff, absDiffU8(q2, q1));
+			maxDiff = _mm_max_epu8(maxDiff, absDiffU8(q1, q0));
+			const __m128i interiorOk = _mm_cmpeq_epi8(_mm_subs_epu8(maxDiff, _mm_set1_epi8(static_cast<char>(ithresh))), _mm_setzero_si128());
+			const __m128i mask = _mm_and_si128(interiorOk, needsFilterMask(p1, p0, q0, q1, thresh));
+
+			if (edge)
+			{
+				doFilter6SSE2(p2, p1, p0, q0, q1, q2, mask, hevThresh);
+			}
+			else
+			{
+				doFilter4SSE2(p1, p0, q0, q1, mask, hevThresh);
+			}
+		}
+
+		/**
+		 * @brief 载入竖直边两侧各 4 列（r0 起 8 行、r8 起 8 行），转置为 8 个 16 像素的列向量
+		 */
+		SHINE_TARGET_SSE2 inline void loadColumns(const uint8_t* r0, const uint8_t* r8, ptrdiff_t stride, __m128i* cols) noexcept
+		{
+			__m128i t[8];
+			for (int i = 0; i < 4; ++i)
+			{
+				t[i] = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(r0 + (2 * i) * stride)),
+					_mm_loadl_epi64(reinterpret_cast<const __m128i*>(r0 + (2 * i + 1) * stride)));
+				t[4 + i] = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(r8 + (2 * i) * stride)),
+					_mm_loadl_epi64(reinterpret_cast<const __m128i*>(r8 + (2 * i + 1) * stride)));
+			}
+
+			// 每 4 行一组：u[2g] 为第 0..3 列，u[2g+1] 为第 4..7 列
+			__m128i u[8];
+			for (int g = 0; g < 4; ++g)
+			{
+				u[2 * g] = _mm_unpacklo_epi16(t[2 * g], t[2 * g + 1]);
+				u[2 * g + 1] = _mm_unpackhi_epi16(t[2 * g], t[2 * g + 1]);
+			}
+
+			// v[h*4 + k]：第 h 个 8 行组的第 2k、2k+1 列
+			__m128i v[8];
+			for (int h = 0; h < 2; ++h)
+			{
+				v[h * 4 + 0] = _mm_unpacklo_epi32(u[h * 4 + 0], u[h * 4 + 2]);
+				v[h * 4 + 1] = _mm_unpackhi_epi32(u[h * 4 + 0], u[h * 4 + 2]);
+				v[h * 4 + 2] = _mm_unpacklo_epi32(u[h * 4 + 1], u[h * 4 + 3]);
+				v[h * 4 + 3] = _mm_unpackhi_epi32(u[h * 4 + 1], u[h * 4 + 3]);
+			}
+
+			for (int k = 0; k < 4; ++k)
+			{
+				cols[2 * k] = _mm_unpacklo_epi64(v[k], v[4 + k]);
+				cols[2 * k + 1] = _mm_unpackhi_epi64(v[k], v[4 + k]);
+			}
+		}
+
+		/**
+		 * @brief loadColumns 的逆操作
+		 */
+		SHINE_TARGET_SSE2 inline void storeColumns(uint8_t* r0, uint8_t* r8, ptrdiff_t stride, const __m128i* cols) noexcept
+		{
+			// a[k] / a[4+k]：第 2k、2k+1 列交错，前 8 行 / 后 8 行
+			__m128i a[8];
+			for (int k = 0; k < 4; ++k)
+			{
+				a[k] = _mm_unpacklo_epi8(cols[2 * k], cols[2 * k + 1]);
+				a[4 + k] = _mm_unpackhi_epi8(cols[2 * k], cols[2 * k + 1]);
+			}
+
+			for (int h = 0; h < 2; ++h)
+			{
+				const __m128i* s = a + h * 4;
+				const __m128i b0 = _mm_unpacklo_epi16(s[0], s[1]);  // 第 0..3 行的第 0..3 列
+				const __m128i b1 = _mm_unpackhi_epi16(s[0], s[1]);  // 第 4..7 行的第 0..3 列
+				const __m128i b2 = _mm_unpacklo_epi16(s[2], s[3]);  // 第 0..3 行的第 4..7 列
+				const __m128i b3 = _mm_unpackhi_epi16(s[2], s[3]);
+				const __m128i rows[4] = {
+					_mm_unpacklo_epi32(b0, b2), _mm_unpackhi_epi32(b0, b2),
+					_mm_unpacklo_epi32(b1, b3), _mm_unpackhi_epi32(b1, b3)
+				};
+				uint8_t* base = h == 0 ? r0 : r8;
+				for (int i = 0; i < 4; ++i)
+				{
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(base + (2 * i) * stride), rows[i]);
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(base + (2 * i + 1) * stride), _mm_srli_si128(rows[i], 8));
+				}
+			}
+		}
+
+		SHINE_TARGET_SSE2 inline __m128i loadRow(const uint8_t* p) noexcept
+		{
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		}
+
+		SHINE_TARGET_SSE2 inline void storeRow(uint8_t* p, __m128i v) noexcept
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+		}
+
+		SHINE_TARGET_SSE2 void simpleV16SSE2(uint8_t* p, ptrdiff_t stride, int thresh)
+		{
+			const __m128i p1 = loadRow(p - 2 * stride);
+			__m128i p0 = loadRow(p - stride);
+			__m128i q0 = loadRow(p);
+			const __m128i q1 = loadRow(p + stride);
+			doFilter2SSE2(p1, p0, q0, q1, thresh);
+			storeRow(p - stride, p0);
+			storeRow(p, q0);
+		}
+
+		SHINE_TARGET_SSE2 void simpleH16SSE2(uint8_t* p, ptrdiff_t stride, int thresh)
+		{
+			__m128i cols[8];
+			loadColumns(p - 4, p - 4 + 8 * stride, stride, cols);
+			doFilter2SSE2(cols[2], cols[3], cols[4], cols[5], thresh);
+			storeColumns(p - 4, p - 4 + 8 * stride, stride, cols);
+		}
+
+		SHINE_TARGET_SSE2 void simpleV16InnerSSE2(uint8_t* p, ptrdiff_t stride, int thresh)
+		{
+			for (int k = 1; k < 4; ++k)
+			{
+				simpleV16SSE2(p + 4 * k * stride, stride, thresh);
+			}
+		}
+
+		SHINE_TARGET_SSE2 void simpleH16InnerSSE2(uint8_t* p, ptrdiff_t stride, int thresh)
+		{
+			for (int k = 1; k < 4; ++k)
+			{
+				simpleH16SSE2(p + 4 * k, stride, thresh);
+			}
+		}
+
+		/// 水平边：q0 所在行为 p，读写上下各 4 行
+		SHINE_TARGET_SSE2 void complexRowsSSE2(uint8_t* p, ptrdiff_t stride, int thresh, int ithresh, int hevThresh, bool edge) noexcept
+		{
+			__m128i r[8];
+			for (int i = 0; i < 8; ++i)
+			{
+				r[i] = loadRow(p + (i - 4) * stride);
+			}
+			complexFilterSSE2(r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7], thresh, ithresh, hevThresh, edge);
+			for (int i = 1; i < 7; ++i)
+			{
+				storeRow(p + (i - 4) * stride, r[i]);
+			}
+		}
+
+		/// 竖直边：r0 / r8 为前后 8 行中 q0 所在列
+		SHINE_TARGET_SSE2 void complexColumnsSSE2(uint8_t* r0, uint8_t* r8, ptrdiff_t stride, int thresh, int ithresh, int hevThresh, bool edge) noexcept
+		{
+			__m128i c[8];
+			loadColumns(r0 - 4, r8 - 4, stride, c);
+			complexFilterSSE2(c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], thresh, ithresh, hevThresh, edge);
+			storeColumns(r0 - 4, r8 - 4, stride, c);
+		}
+
+		/// 色度水平边：U、V 各 8 个像素拼成一个向量
+		SHINE_TARGET_SSE2 void complexChromaRowsSSE2(uint8_t* u, uint8_t* v, ptrdiff_t stride, int thresh, int ithresh, int hevThresh, bool edge) noexcept
+		{
+			__m128i r[8];
+			for (int i = 0; i < 8; ++i)
+			{
+				r[i] = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + (i - 4) * stride)),
+					_mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + (i - 4) * stride)));
+			}
+			complexFilterSSE2(r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7], thresh, ithresh, hevThresh, edge);
+			for (int i = 1; i < 7; ++i)
+			{
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(u + (i - 4) * stride), r[i]);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(v + (i - 4) * stride), _mm_srli_si128(r[i], 8));
+			}
+		}
+
+		SHINE_TARGET_SSE2 void v16SSE2(uint8_t* p, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			complexRowsSSE2(p, stride, thresh, ithresh, hevThresh, true);
+		}
+
+		SHINE_TARGET_SSE2 void h16SSE2(uint8_t* p, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			complexColumnsSSE2(p, p + 8 * stride, stride, thresh, ithresh, hevThresh, true);
+		}
+
+		SHINE_TARGET_SSE2 void v16InnerSSE2(uint8_t* p, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			for (int k = 1; k < 4; ++k)
+			{
+				complexRowsSSE2(p + 4 * k * stride, stride, thresh, ithresh, hevThresh, false);
+			}
+		}
+
+		SHINE_TARGET_SSE2 void h16InnerSSE2(uint8_t* p, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			for (int k = 1; k < 4; ++k)
+			{
+				complexColumnsSSE2(p + 4 * k, p + 4 * k + 8 * stride, stride, thresh, ithresh, hevThresh, false);
+			}
+		}
+
+		SHINE_TARGET_SSE2 void v8SSE2(uint8_t* u, uint8_t* v, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			complexChromaRowsSSE2(u, v, stride, thresh, ithresh, hevThresh, true);
+		}
+
+		SHINE_TARGET_SSE2 void h8SSE2(uint8_t* u, uint8_t* v, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			complexColumnsSSE2(u, v, stride, thresh, ithresh, hevThresh, true);
+		}
+
+		SHINE_TARGET_SSE2 void v8InnerSSE2(uint8_t* u, uint8_t* v, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			complexChromaRowsSSE2(u + 4 * stride, v + 4 * stride, stride, thresh, ithresh, hevThresh, false);
+		}
+
+		SHINE_TARGET_SSE2 void h8InnerSSE2(uint8_t* u, uint8_t* v, ptrdiff_t stride, int thresh, int ithresh, int hevThresh)
+		{
+			complexColumnsSSE2(u + 4, v + 4, stride, thresh, ithresh, hevThresh, false);
+		}
+
+		// ----------------------------------------------------------------------------
+		// 色度上采样与颜色转换
+		// ----------------------------------------------------------------------------
+
+		SHINE_TARGET_SSE2 void upsampleRowSSE2(const uint8_t* near, const uint8_t* far, uint8_t* out, size_t width)
+		{
+			if (width == 0)
+			{
+				return;
+			}
+			out[0] = static_cast<uint8_t>((3 * near[0] + far[0] + 2) >> 2);
+
+			// 每次 8 个色度样本 x..x+7，输出像素 2x-1 .. 2x+14
+			const size_t lastPair = (width - 1) >> 1;
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i k8 = _mm_set1_epi16(8);
+			size_t x = 1;
+			for (; x + 7 <= lastPair; x += 8)
+			{
+				const __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(near + x - 1)), zero);
+				const __m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(near + x)), zero);
+				const __m128i c = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(far + x - 1)), zero);
+				const __m128i d = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(far + x)), zero);
+				const __m128i avg = _mm_add_epi16(_mm_add_epi16(_mm_add_epi16(a, b), _mm_add_epi16(c, d)), k8);
+				const __m128i diagBC = _mm_srli_epi16(_mm_add_epi16(avg, _mm_slli_epi16(_mm_add_epi16(b, c), 1)), 3);
+				const __m128i diagAD = _mm_srli_epi16(_mm_add_epi16(avg, _mm_slli_epi16(_mm_add_epi16(a, d), 1)), 3);
+				const __m128i odd = _mm_srli_epi16(_mm_add_epi16(diagBC, a), 1);
+				const __m128i even = _mm_srli_epi16(_mm_add_epi16(diagAD, b), 1);
+				storeRow(out + 2 * x - 1, _mm_or_si128(odd, _mm_slli_epi16(even, 8)));
+			}
+			upsampleRowTail(near, far, out, width, x);
+		}
+
+		/// 8 个像素（16 位通道，样本放大 256 倍）-> R/G/B（16 位）
+		SHINE_TARGET_SSE2 inline void yuvToRgb8(__m128i y, __m128i u, __m128i v, __m128i& r, __m128i& g, __m128i& b) noexcept
+		{
+			const __m128i luma = _mm_mulhi_epu16(y, _mm_set1_epi16(static_cast<int16_t>(kYScale)));
+
+			const __m128i r0 = _mm_mulhi_epu16(v, _mm_set1_epi16(static_cast<int16_t>(kVToR)));
+			r = _mm_srai_epi16(_mm_add_epi16(_mm_sub_epi16(luma, _mm_set1_epi16(static_cast<int16_t>(kROffset))), r0), 6);
+
+			const __m128i g0 = _mm_add_epi16(_mm_mulhi_epu16(u, _mm_set1_epi16(static_cast<int16_t>(kUToG))),
+				_mm_mulhi_epu16(v, _mm_set1_epi16(static_cast<int16_t>(kVToG))));
+			g = _mm_srai_epi16(_mm_sub_epi16(_mm_add_epi16(luma, _mm_set1_epi16(static_cast<int16_t>(kGOffset))), g0), 6);
+
+			// 蓝色分量可能超过 32767，使用无符号饱和运算与逻辑右移
+			const __m128i b0 = _mm_adds_epu16(_mm_mulhi_epu16(u, _mm_set1_epi16(static_cast<int16_t>(kUToB))), luma);
+			b = _mm_srli_epi16(_mm_subs_epu16(b0, _mm_set1_epi16(static_cast<int16_t>(kBOffset))), 6);
+		}
+
+		SHINE_TARGET_SSE2 void yuvToRgbaRowSSE2(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* rgba, size_t width)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+			size_t x = 0;
+			for (; x + 16 <= width; x += 16)
+			{
+				const __m128i ys = loadRow(y + x);
+				const __m128i us = loadRow(u + x);
+				const __m128i vs = loadRow(v + x);
+
+				__m128i rLo, gLo, bLo, rHi, gHi, bHi;
+				yuvToRgb8(_mm_unpacklo_epi8(zero, ys), _mm_unpacklo_epi8(zero, us), _mm_unpacklo_epi8(zero, vs), rLo, gLo, bLo);
+				yuvToRgb8(_mm_unpackhi_epi8(zero, ys), _mm_unpackhi_epi8(zero, us), _mm_unpackhi_epi8(zero, vs), rHi, gHi, bHi);
+				const __m128i r = _mm_packus_epi16(rLo, rHi);
+				const __m128i g = _mm_packus_epi16(gLo, gHi);
+				const __m128i b = _mm_packus_epi16(bLo, bHi);
+
+				const __m128i rgLo = _mm_unpacklo_epi8(r, g);
+				const __m128i rgHi = _mm_unpackhi_epi8(r, g);
+				const __m128i baLo = _mm_unpacklo_epi8(b, alpha);
+				const __m128i baHi = _mm_unpackhi_epi8(b, alpha);
+				storeRow(rgba + x * 4, _mm_unpacklo_epi16(rgLo, baLo));
+				storeRow(rgba + x * 4 + 16, _mm_unpackhi_epi16(rgLo, baLo));
+				storeRow(rgba + x * 4 + 32, _mm_unpacklo_epi16(rgHi, baHi));
+				storeRow(rgba + x * 4 + 48, _mm_unpackhi_epi16(rgHi, baHi));
+			}
+			yuvToRgbaScalar(y, u, v, rgba, x, width);
+		}
+
+		constexpr DspKernels kSSE2Kernels = {
+			inverseTransformSSE2,
+			simpleV16SSE2, simpleH16SSE2, simpleV16InnerSSE2, simpleH16InnerSSE2,
+			v16SSE2, h16SSE2, v16InnerSSE2, h16InnerSSE2,
+			v8SSE2, h8SSE2, v8InnerSSE2, h8InnerSSE2,
+			upsampleRowSSE2,
+			yuvToRgbaRowSSE2,
+		};
+
+		// ============================================================================
+		// 运行时检测
+		// ============================================================================
+
+		bool cpuHasSSE2() noexcept
+		{
+#if defined(__x86_64__) || defined(_M_X64)
+			return true; // x86-64 基线
+#elif defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 1);
+			return (info[3] & (1 << 26)) != 0;
+#else
+			return __builtin_cpu_supports("sse2");
+#endif
+		}
+#endif // SHINE_VP8_DSP_X86
+
+		DspBackend detectBackend() noexcept
+		{
+#if defined(SHINE_VP8_DSP_X86)
+			if (cpuHasSSE2())
+			{
+				return DspBackend::SSE2;
+			}
+#endif
+			return DspBackend::Scalar;
+		}
+	} // namespace
+
+	DspBackend activeBackend() noexcept
+	{
+		static const DspBackend backend = detectBackend();
+		return backend;
+	}
+
+	bool isBackendSupported(DspBackend backend) noexcept
+	{
+		switch (backend)
+		{
+		case DspBackend::Scalar:
+			return true;
+#if defined(SHINE_VP8_DSP_X86)
+		case DspBackend::SSE2:
+			return cpuHasSSE2();
+#endif
+		default:
+			return false;
+		}
+	}
+
+	const char* backendName(DspBackend backend) noexcept
+	{
+		switch (backend)
+		{
+		case DspBackend::Scalar: return "Scalar";
+		case DspBackend::SSE2: return "SSE2";
+		}
+		return "Unknown";
+	}
+
+	const DspKernels& kernels() noexcept
+	{
+		return kernels(activeBackend());
+	}
+
+	const DspKernels& kernels(DspBackend backend) noexcept
+	{
+#if defined(SHINE_VP8_DSP_X86)
+		if (backend == DspBackend::SSE2 && isBackendSupported(backend))
+		{
+			return kSSE2Kernels;
+		}
+#endif
+		return kScalarKernels;
+	}
+
+	void inverseTransformDC(const int16_t* coefficients, uint8_t* dst, ptrdiff_t stride) noexcept
+	{
+		const int32_t dc = (coefficients[0] + 4) >> 3;
+		for (int row = 0; row < 4; ++row)
+		{
+			uint8_t* d = dst + row * stride;
+			for (int col = 0; col < 4; ++col)
+			{
+				d[col] = clampByte(d[col] + dc);
+			}
+		}
+	}
+
+	void inverseWalshHadamard(const int16_t* in, int16_t* out) noexcept
+	{
+		int32_t tmp[16];
+		for (int i = 0; i < 4; ++i)
+		{
+			const int32_t a0 = in[0 + i] + in[12 + i];
+			const int32_t a1 = in[4 + i] + in[8 + i];
+			const int32_t a2 = in[4 + i] - in[8 + i];
+			const int32_t a3 = in[0 + i] - in[12 + i];
+			tmp[0 + i] = a0 + a1;
+			tmp[8 + i] = a0 - a1;
+			tmp[4 + i] = a3 + a2;
+			tmp[12 + i] = a3 - a2;
+		}
+		for (int i = 0; i < 4; ++i)
+		{
+			const int32_t dc = tmp[0 + i * 4] + 3;
+			const int32_t a0 = dc + tmp[3 + i * 4];
+			const int32_t a1 = tmp[1 + i * 4] + tmp[2 + i * 4];
+			const int32_t a2 = tmp[1 + i * 4] - tmp[2 + i * 4];
+			const int32_t a3 = dc - tmp[3 + i * 4];
+			int16_t* row = out + i * 64;
+			row[0] = static_cast<int16_t>((a0 + a1) >> 3);
+			row[16] = static_cast<int16_t>((a3 + a2) >> 3);
+			row[32] = static_cast<int16_t>((a0 - a1) >> 3);
+			row[48] = static_cast<int16_t>((a3 - a2) >> 3);
+		}
+	}
+
+} // namespace shine::image::vp8_dsp
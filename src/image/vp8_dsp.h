@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @file vp8_dsp.h
+ * @brief VP8（有损 WebP）像素重建内核：逆 DCT、环路滤波、色度上采样与 YUV -> RGBA 行转换
+ *
+ * 提供标量参考实现与 SSE2 内核，运行时按 CPU 特性分派，所有内核与标量实现逐字节一致
+ * （见 test/Vp8DspTest），结果与 libwebp 解码器相同。
+ *
+ * - 逆变换：RFC 6386 14.3 的 4x4 整数变换，SSE2 一次处理两个相邻块；标量实现按 16 位回绕模拟 SIMD。
+ * - 环路滤波：RFC 6386 第 15 节的简单 / 复杂滤波器，SSE2 用饱和 int8 运算一次处理一条边上的 16 个像素，
+ *   竖直边先转置 16x8 再按水平边处理。
+ * - 颜色转换：libwebp 的 "fancy" 双线性色度上采样 + BT.601 定点转换（14 位常数）。
+ *
+ * @see https://datatracker.ietf.org/doc/html/rfc6386
+ */
+
+namespace shine::image::vp8_dsp
+{
+	/**
+	 * @brief 内核实现
+	 */
+	enum class DspBackend : uint8_t
+	{
+		Scalar = 0,  ///< 标量参考实现
+		SSE2         ///< x86 SSE2
+	};
+
+	/**
+	 * @brief 当前 CPU 上选用的内核实现（首次调用时检测并缓存）
+	 */
+	DspBackend activeBackend() noexcept;
+
+	/**
+	 * @brief 检查指定内核在当前 CPU / 编译配置下是否可用
+	 */
+	bool isBackendSupported(DspBackend backend) noexcept;
+
+	/**
+	 * @brief 获取内核名称（用于日志与测试输出）
+	 */
+	const char* backendName(DspBackend backend) noexcept;
+
+	/**
+	 * @brief 简单滤波器（只处理亮度，修改边两侧各 1 个像素）
+	 * @param p 边后第一个像素（q0）
+	 * @param stride 行跨度（字节）
+	 * @param thresh 边缘阈值（宏块边为 limit + 4）
+	 */
+	using SimpleFilterFn = void (*)(uint8_t* p, ptrdiff_t stride, int thresh);
+
+	/**
+	 * @brief 复杂滤波器（一个 16 像素的亮度宏块）
+	 * @param p 宏块左上角像素
+	 * @param stride 行跨度（字节）
+	 * @param thresh 边缘阈值
+	 * @param ithresh 内部差值阈值
+	 * @param hevThresh 高边缘方差阈值
+	 */
+	using ComplexFilterFn = void (*)(uint8_t* p, ptrdiff_t stride, int thresh, int ithresh, int hevThresh);
+
+	/**
+	 * @brief 复杂滤波器（U、V 两个 8 像素的色度块一起处理）
+	 */
+	using ChromaFilterFn = void (*)(uint8_t* u, uint8_t* v, ptrdiff_t stride, int thresh, int ithresh, int hevThresh);
+
+	/**
+	 * @brief 一组内核函数
+	 *
+	 * 函数名中 V 表示水平边（上下相邻的像素，沿竖直方向滤波），H 表示竖直边；
+	 * 带 Inner 的版本处理宏块内部位于 4、8、12 处的三条子块边，不带的处理宏块的上边 / 左边。
+	 */
+	struct DspKernels
+	{
+		/**
+		 * @brief 反量化后的系数逆变换并叠加到预测值上
+		 * @param coefficients blockCount 个 4x4 块的系数（每块 16 个，行优先）
+		 * @param dst 第一个块左上角像素，第 i 个块位于 dst + 4 * i
+		 * @param stride 行跨度（字节）
+		 * @param blockCount 水平相邻的块数
+		 */
+		void (*inverseTransform)(const int16_t* coefficients, uint8_t* dst, ptrdiff_t stride, size_t blockCount);
+
+		SimpleFilterFn simpleV16;
+		SimpleFilterFn simpleH16;
+		SimpleFilterFn simpleV16Inner;
+		SimpleFilterFn simpleH16Inner;
+
+		ComplexFilterFn v16;
+		ComplexFilterFn h16;
+		ComplexFilterFn v16Inner;
+		ComplexFilterFn h16Inner;
+
+		ChromaFilterFn v8;
+		ChromaFilterFn h8;
+		ChromaFilterFn v8Inner;
+		ChromaFilterFn h8Inner;
+
+		/**
+		 * @brief 色度行上采样到亮度宽度（libwebp fancy upsampling）
+		 *
+		 * 输出像素 x 的色度取近行与远行中相邻两个样本的 9:3:3:1 加权，行首和偶数宽度的行尾只用一列样本。
+		 *
+		 * @param near 距当前亮度行较近的色度行
+		 * @param far 另一条色度行（图像上下边界处与 near 相同）
+		 * @param out 输出（width 个样本）
+		 * @param width 亮度宽度
+		 */
+		void (*upsampleRow)(const uint8_t* near, const uint8_t* far, uint8_t* out, size_t width);
+
+		/**
+		 * @brief 全分辨率 YUV 行转换为 RGBA（alpha 为 255）
+		 */
+		void (*yuvToRgbaRow)(const uint8_t* y, const uint8_t* u, const uint8_t* v, uint8_t* rgba, size_t width);
+	};
+
+	/**
+	 * @brief 当前 CPU 上最快的内核
+	 */
+	const DspKernels& kernels() noexcept;
+
+	/**
+	 * @brief 指定实现的内核（不可用时回退到标量实现）
+	 */
+	const DspKernels& kernels(DspBackend backend) noexcept;
+
+	/**
+	 * @brief 只有 DC 系数的块的逆变换（所有实现共用）
+	 */
+	void inverseTransformDC(const int16_t* coefficients, uint8_t* dst, ptrdiff_t stride) noexcept;
+
+	/**
+	 * @brief Y2 块的逆 Walsh-Hadamard 变换
+	 * @param in 16 个反量化后的 Y2 系数
+	 * @param out 16 个亮度块的系数，结果写入每块的 DC（out[i * 16]）
+	 */
+	void inverseWalshHadamard(const int16_t* in, int16_t* out) noexcept;
+
+} // namespace shine::image::vp8_dsp
@@ -0,0 +1,1257 @@
+#include "vp8l.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "vp8l_dsp.h"
+
+/**
+ * @file vp8l.cpp
+ * @brief VP8L 无损解码实现
+ *
+ * 位读取、前缀码建表（8 位根表 + 二级表）、Huffman 组的平凡字面量与打包表判定均与
+ * libwebp（src/dec/vp8l_dec.c、src/utils/huffman_utils.c）一致。
+ * 与 libwebp 不同的是逆变换不按 16 行批处理，而是每完成一行就把该行送入流水线：
+ * 残差行只读（后向引用需要变换前的数据），各级变换在行缓冲中接力，预测变换保存自己的上一行输出。
+ */
+
+namespace shine::image::vp8l
+{
+	namespace
+	{
+		// ============================================================================
+		// 常量
+		// ============================================================================
+
+		constexpr uint8_t kSignature = 0x2f;
+		constexpr size_t kHeaderSize = 5;
+
+		constexpr int kNumLiteralCodes = 256;
+		constexpr int kNumLengthCodes = 24;
+		constexpr int kNumDistanceCodes = 40;
+		constexpr int kMaxCacheBits = 11;
+		constexpr int kNumCodeLengthCodes = 19;
+		constexpr int kMaxCodeLength = 15;
+		constexpr int kDefaultCodeLength = 8;
+		constexpr int kMaxAlphabetSize = kNumLiteralCodes + kNumLengthCodes + (1 << kMaxCacheBits);
+
+		constexpr int kRootBits = 8;
+		constexpr uint32_t kRootMask = (1u << kRootBits) - 1;
+		constexpr int kLengthsTableBits = 7;
+
+		/// 单个前缀码表的最大项数（绿色码在 11 位颜色缓存时最大，取自 libwebp 的 kTableSize）
+		constexpr int kMaxTableSize = 2704;
+
+		/// 四个字面量码的最长码长之和小于该值时使用打包表
+		constexpr int kPackedBits = 6;
+		constexpr uint32_t kPackedTableSize = 1u << kPackedBits;
+		constexpr int kBitsSpecialMarker = 0x100;
+		constexpr int kPackedNonLiteralCode = 0;
+
+		constexpr uint32_t kColorCacheMultiplier = 0x1e35a7bdu;
+
+		enum HuffIndex : int
+		{
+			GREEN = 0,
+			RED,
+			BLUE,
+			ALPHA,
+			DIST,
+			kCodesPerGroup
+		};
+
+		constexpr int kAlphabetSize[kCodesPerGroup] = {
+			kNumLiteralCodes + kNumLengthCodes, kNumLiteralCodes, kNumLiteralCodes, kNumLiteralCodes, kNumDistanceCodes
+		};
+
+		constexpr uint8_t kCodeLengthCodeOrder[kNumCodeLengthCodes] = {
+			17, 18, 0, 1, 2, 3, 4, 5, 16, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+		};
+
+		// 码长 16 / 17 / 18：重复上一个非零码长 / 零
+		constexpr int kCodeLengthLiterals = 16;
+		constexpr int kCodeLengthRepeatCode = 16;
+		constexpr int kCodeLengthExtraBits[3] = { 2, 3, 7 };
+		constexpr int kCodeLengthRepeatOffsets[3] = { 3, 3, 11 };
+
+		/// 距离码 1-120 -> (yoffset << 4) | (8 - xoffset)
+		constexpr int kCodeToPlaneCodes = 120;
+		constexpr uint8_t kCodeToPlane[kCodeToPlaneCodes] = {
+			0x18, 0x07, 0x17, 0x19, 0x28, 0x06, 0x27, 0x29, 0x16, 0x1a, 0x26, 0x2a,
+			0x38, 0x05, 0x37, 0x39, 0x15, 0x1b, 0x36, 0x3a, 0x25, 0x2b, 0x48, 0x04,
+			0x47, 0x49, 0x14, 0x1c, 0x35, 0x3b, 0x46, 0x4a, 0x24, 0x2c, 0x58, 0x45,
+			0x4b, 0x34, 0x3c, 0x03, 0x57, 0x59, 0x13, 0x1d, 0x56, 0x5a, 0x23, 0x2d,
+			0x44, 0x4c, 0x55, 0x5b, 0x33, 0x3d, 0x68, 0x02, 0x67, 0x69, 0x12, 0x1e,
+			0x66, 0x6a, 0x22, 0x2e, 0x54, 0x5c, 0x43, 0x4d, 0x65, 0x6b, 0x32, 0x3e,
+			0x78, 0x01, 0x77, 0x79, 0x53, 0x5d, 0x11, 0x1f, 0x64, 0x6c, 0x42, 0x4e,
+			0x76, 0x7a, 0x21, 0x2f, 0x75, 0x7b, 0x31, 0x3f, 0x63, 0x6d, 0x52, 0x5e,
+			0x00, 0x74, 0x7c, 0x41, 0x4f, 0x10, 0x20, 0x62, 0x6e, 0x30, 0x73, 0x7d,
+			0x51, 0x5f, 0x40, 0x72, 0x7e, 0x61, 0x6f, 0x50, 0x71, 0x7f, 0x60, 0x70
+		};
+
+		enum class TransformType : uint8_t
+		{
+			Predictor = 0,
+			CrossColor = 1,
+			SubtractGreen = 2,
+			ColorIndexing = 3
+		};
+
+		inline uint32_t subSampleSize(uint32_t size, int bits) noexcept
+		{
+			return (size + (1u << bits) - 1) >> bits;
+		}
+
+		inline uint32_t addPixels(uint32_t a, uint32_t b) noexcept
+		{
+			const uint32_t alphaGreen = (a & 0xff00ff00u) + (b & 0xff00ff00u);
+			const uint32_t redBlue = (a & 0x00ff00ffu) + (b & 0x00ff00ffu);
+			return (alphaGreen & 0xff00ff00u) | (redBlue & 0x00ff00ffu);
+		}
+
+		// ============================================================================
+		// 位读取（LSB 优先，64 位窗口，与 libwebp VP8LBitReader 相同）
+		// ============================================================================
+
+		class BitReader
+		{
+		public:
+			void init(const uint8_t* data, size_t size) noexcept
+			{
+				_data = data;
+				_size = size;
+				_value = 0;
+				_bitPos = 0;
+				_eos = false;
+				const size_t count = std::min<size_t>(size, 8);
+				for (size_t i = 0; i < count; ++i)
+				{
+					_value |= static_cast<uint64_t>(data[i]) << (8 * i);
+				}
+				_pos = count;
+			}
+
+			/// 窗口中未消耗的低 32 位（至少 32 位有效，除非已到末尾）
+			uint32_t peek() const noexcept
+			{
+				return _bitPos < 64 ? static_cast<uint32_t>(_value >> _bitPos) : 0;
+			}
+
+			void skip(int bits) noexcept
+			{
+				_bitPos += bits;
+			}
+
+			/// 保证窗口中至少有 32 位可供 peek
+			void fill() noexcept
+			{
+				if (_bitPos >= 32)
+				{
+					shiftBytes();
+				}
+			}
+
+			/// 读取 bits 位（bits <= 24）
+			uint32_t readBits(int bits) noexcept
+			{
+				const uint32_t value = peek() & ((1u << bits) - 1);
+				_bitPos += bits;
+				shiftBytes();
+				return value;
+			}
+
+			bool eos() const noexcept
+			{
+				return _eos || (_pos == _size && _bitPos > 64);
+			}
+
+		private:
+			void shiftBytes() noexcept
+			{
+				if (_bitPos >= 32 && _pos + 4 <= _size)
+				{
+					uint32_t next;
+					std::memcpy(&next, _data + _pos, 4);
+					_value = (_value >> 32) | (static_cast<uint64_t>(next) << 32);
+					_pos += 4;
+					_bitPos -= 32;
+				}
+				while (_bitPos >= 8 && _pos < _size)
+				{
+					_value = (_value >> 8) | (static_cast<uint64_t>(_data[_pos++]) << 56);
+					_bitPos -= 8;
+				}
+				if (_pos == _size && _bitPos > 64)
+				{
+					// 读过末尾：之后只返回 0，由调用方报错
+					_eos = true;
+					_value = 0;
+					_bitPos = 0;
+				}
+			}
+
+			const uint8_t* _data = nullptr;
+			size_t _size = 0;
+			size_t _pos = 0;
+			uint64_t _value = 0;
+			int _bitPos = 0;
+			bool _eos = false;
+		};
+
+		// ============================================================================
+		// 前缀码表
+		// ============================================================================
+
+		struct HuffmanCode
+		{
+			uint8_t bits = 0;    ///< 根表：码长，或根位数 + 二级表位数；二级表：剩余码长
+			uint16_t value = 0;  ///< 符号，或二级表相对偏移
+		};
+
+		/// 打包表项：bits < kBitsSpecialMarker 时 value 为完整 ARGB，否则为绿色码中的非字面量符号
+		struct HuffmanCode32
+		{
+			int bits = 0;
+			uint32_t value = 0;
+		};
+
+		/// 一组五个前缀码（绿 + 长度 + 缓存、红、蓝、Alpha、距离）
+		struct HTreeGroup
+		{
+			const HuffmanCode* htrees[kCodesPerGroup]{};
+			bool isTrivialLiteral = false;  ///< 红、蓝、Alpha 都只有一个符号
+			bool isTrivialCode = false;     ///< 所有码只有一个符号且绿色为字面量：整组退化为常量像素
+			bool usePackedTable = false;
+			uint32_t literalArb = 0;
+			HuffmanCode32 packedTable[kPackedTableSize];
+		};
+
+		/// 按位反转的顺序取下一个 len 位的码
+		inline int nextKey(int key, int len) noexcept
+		{
+			int step = 1 << (len - 1);
+			while (key & step)
+			{
+				step >>= 1;
+			}
+			return step ? (key & (step - 1)) + step : key;
+		}
+
+		inline void replicateValue(HuffmanCode* table, int step, int end, HuffmanCode code) noexcept
+		{
+			do
+			{
+				end -= step;
+				table[end] = code;
+			} while (end > 0);
+		}
+
+		/// 二级表的位数：足以容纳以当前根前缀开头的所有码
+		inline int nextTableBitSize(const int* count, int len, int rootBits) noexcept
+		{
+			int left = 1 << (len - rootBits);
+			while (len < kMaxCodeLength)
+			{
+				left -= count[len];
+				if (left <= 0)
+				{
+					break;
+				}
+				++len;
+				left <<= 1;
+			}
+			return len - rootBits;
+		}
+
+		/**
+		 * @brief 按码长构建查找表
+		 * @return 表项总数；码不完整、超额或超出 capacity 时返回 0
+		 */
+		int buildHuffmanTable(HuffmanCode* rootTable, int rootBits, const uint8_t* codeLengths, int codeLengthsSize, int capacity)
+		{
+			int totalSize = 1 << rootBits;
+			if (totalSize > capacity)
+			{
+				return 0;
+			}
+
+			int count[kMaxCodeLength + 1] = {};
+			int offset[kMaxCodeLength + 1] = {};
+			uint16_t sorted[kMaxAlphabetSize];
+
+			for (int symbol = 0; symbol < codeLengthsSize; ++symbol)
+			{
+				if (codeLengths[symbol] > kMaxCodeLength)
+				{
+					return 0;
+				}
+				++count[codeLengths[symbol]];
+			}
+			if (count[0] == codeLengthsSize)
+			{
+				return 0;
+			}
+
+			for (int len = 1; len < kMaxCodeLength; ++len)
+			{
+				if (count[len] > (1 << len))
+				{
+					return 0;
+				}
+				offset[len + 1] = offset[len] + count[len];
+			}
+			for (int symbol = 0; symbol < codeLengthsSize; ++symbol)
+			{
+				if (codeLengths[symbol] > 0)
+				{
+					sorted[offset[codeLengths[symbol]]++] = static_cast<uint16_t>(symbol);
+				}
+			}
+
+			// 只有一个符号：不消耗任何位
+			if (offset[kMaxCodeLength] == 1)
+			{
+				replicateValue(rootTable, 1, totalSize, HuffmanCode{ 0, sorted[0] });
+				return totalSize;
+			}
+
+			HuffmanCode* table = rootTable;
+			const int mask = totalSize - 1;
+			int low = -1;
+			int key = 0;
+			int numNodes = 1;
+			int numOpen = 1;
+			int tableSize = 1 << rootBits;
+			int symbol = 0;
+
+			// 根表
+			for (int len = 1, step = 2; len <= rootBits; ++len, step <<= 1)
+			{
+				numOpen <<= 1;
+				numNodes += numOpen;
+				numOpen -= count[len];
+				if (numOpen < 0)
+				{
+					return 0;
+				}
+				for (; count[len] > 0; --count[len])
+				{
+					replicateValue(&table[key], step, tableSize,
+						HuffmanCode{ static_cast<uint8_t>(len), sorted[symbol++] });
+					key = nextKey(key, len);
+				}
+			}
+
+			// 二级表，根表中对应项指向它
+			for (int len = rootBits + 1, step = 2; len <= kMaxCodeLength; ++len, step <<= 1)
+			{
+				numOpen <<= 1;
+				numNodes += numOpen;
+				numOpen -= count[len];
+				if (numOpen < 0)
+				{
+					return 0;
+				}
+				for (; count[len] > 0; --count[len])
+				{
+					if ((key & mask) != low)
+					{
+						table += tableSize;
+						const int tableBits = nextTableBitSize(count, len, rootBits);
+						tableSize = 1 << tableBits;
+						totalSize += tableSize;
+						if (totalSize > capacity)
+						{
+							return 0;
+						}
+						low = key & mask;
+						rootTable[low].bits = static_cast<uint8_t>(tableBits + rootBits);
+						rootTable[low].value = static_cast<uint16_t>((table - rootTable) - low);
+					}
+					replicateValue(&table[key >> rootBits], step, tableSize,
+						HuffmanCode{ static_cast<uint8_t>(len - rootBits), sorted[symbol++] });
+					key = nextKey(key, len);
+				}
+			}
+
+			// 码必须恰好填满二叉树
+			if (numNodes != 2 * offset[kMaxCodeLength] - 1)
+			{
+				return 0;
+			}
+			return totalSize;
+		}
+
+		inline int readSymbol(const HuffmanCode* table, BitReader& br) noexcept
+		{
+			uint32_t value = br.peek();
+			table += value & kRootMask;
+			const int extraBits = table->bits - kRootBits;
+			if (extraBits > 0)
+			{
+				br.skip(kRootBits);
+				value = br.peek();
+				table += table->value;
+				table += value & ((1u << extraBits) - 1);
+			}
+			br.skip(table->bits);
+			return table->value;
+		}
+
+		/// 打包表：一次查表读出绿、红、蓝、Alpha，绿色为长度码或缓存码时只消耗绿色码的位
+		inline int readPackedSymbols(const HTreeGroup& group, BitReader& br, uint32_t* dst) noexcept
+		{
+			const HuffmanCode32 code = group.packedTable[br.peek() & (kPackedTableSize - 1)];
+			if (code.bits < kBitsSpecialMarker)
+			{
+				br.skip(code.bits);
+				*dst = code.value;
+				return kPackedNonLiteralCode;
+			}
+			br.skip(code.bits - kBitsSpecialMarker);
+			return static_cast<int>(code.value);
+		}
+
+		void buildPackedTable(HTreeGroup& group)
+		{
+			for (uint32_t code = 0; code < kPackedTableSize; ++code)
+			{
+				uint32_t bits = code;
+				HuffmanCode32& packed = group.packedTable[code];
+				const HuffmanCode green = group.htrees[GREEN][bits];
+				if (green.value >= kNumLiteralCodes)
+				{
+					packed.bits = green.bits + kBitsSpecialMarker;
+					packed.value = green.value;
+					continue;
+				}
+
+				packed.bits = 0;
+				packed.value = 0;
+				auto accumulate = [&](const HuffmanCode& hcode, int shift)
+				{
+					packed.bits += hcode.bits;
+					packed.value |= static_cast<uint32_t>(hcode.value) << shift;
+					bits >>= hcode.bits;
+				};
+				accumulate(green, 8);
+				accumulate(group.htrees[RED][bits], 16);
+				accumulate(group.htrees[BLUE][bits], 0);
+				accumulate(group.htrees[ALPHA][bits], 24);
+			}
+		}
+
+		/// LZ77 长度 / 距离前缀码 -> 数值
+		inline uint32_t getCopyDistance(int symbol, BitReader& br) noexcept
+		{
+			if (symbol < 4)
+			{
+				return static_cast<uint32_t>(symbol) + 1;
+			}
+			const int extraBits = (symbol - 2) >> 1;
+			const uint32_t offset = static_cast<uint32_t>(2 + (symbol & 1)) << extraBits;
+			return offset + br.readBits(extraBits) + 1;
+		}
+
+		/// 距离码 -> 线性距离（前 120 个码表示二维邻域）
+		inline uint32_t planeCodeToDistance(uint32_t xsize, uint32_t planeCode) noexcept
+		{
+			if (planeCode > kCodeToPlaneCodes)
+			{
+				return planeCode - kCodeToPlaneCodes;
+			}
+			const int distCode = kCodeToPlane[planeCode - 1];
+			const int yoffset = distCode >> 4;
+			const int xoffset = 8 - (distCode & 0xf);
+			const int64_t dist = static_cast<int64_t>(yoffset) * xsize + xoffset;
+			return dist >= 1 ? static_cast<uint32_t>(dist) : 1;
+		}
+
+		// ============================================================================
+		// 解码器
+		// ============================================================================
+
+		/// 一幅熵编码图像的前缀码
+		struct HuffmanMetadata
+		{
+			int colorCacheBits = 0;
+			int subsampleBits = 0;           ///< 元前缀码图像的缩放位数，0 表示全图一组
+			uint32_t huffmanXSize = 0;
+			uint32_t huffmanMask = ~0u;      ///< 列号与之为 0 时切换 Huffman 组
+			std::vector<uint32_t> huffmanImage;  ///< 每块的组号（已压缩为实际用到的组）
+			std::vector<HuffmanCode> tables;
+			std::vector<HTreeGroup> groups;
+		};
+
+		struct Transform
+		{
+			TransformType type = TransformType::Predictor;
+			int bits = 0;
+			uint32_t xsize = 0;            ///< 变换输出宽度
+			std::vector<uint32_t> data;    ///< 预测 / 颜色变换的子图像，或展开后的调色板
+			std::vector<uint32_t> rows;    ///< 预测变换：上一行输出 + 当前行输出（连续，最后一列的右上取当前行首像素）
+		};
+
+		class Decoder
+		{
+		public:
+			Decoder(const uint8_t* data, size_t size)
+				: _dsp(vp8l_dsp::kernels())
+			{
+				_br.init(data, size);
+			}
+
+			/// 解码主图像，rgba 与 alpha 二选一
+			std::expected<void, std::string> decode(uint32_t width, uint32_t height,
+				uint8_t* rgba, size_t rgbaStride, uint8_t* alpha);
+
+		private:
+			std::expected<void, std::string> decodeImageStream(uint32_t xsize, uint32_t ysize, bool isLevel0,
+				std::vector<uint32_t>& output);
+			std::expected<void, std::string> readTransform(uint32_t& xsize);
+			std::expected<void, std::string> readHuffmanCodes(uint32_t xsize, uint32_t ysize, bool allowRecursion,
+				HuffmanMetadata& hdr);
+			int readHuffmanCode(int alphabetSize, uint8_t* codeLengths, HuffmanCode* table);
+			bool readHuffmanCodeLengths(const uint8_t* codeLengthCodeLengths, int numSymbols, uint8_t* codeLengths);
+			std::expected<void, std::string> decodeImageData(const HuffmanMetadata& hdr, uint32_t* data,
+				uint32_t width, uint32_t height, bool isLevel0);
+
+			void processRows(uint32_t rowEnd);
+			void predictRow(const Transform& transform, uint32_t y, const uint32_t* in, uint32_t* upper, uint32_t* out) const;
+			void colorSpaceInverseRow(const Transform& transform, uint32_t y, uint32_t* row) const;
+			void colorIndexInverseRow(const Transform& transform, const uint32_t* in, uint32_t* out) const;
+
+			BitReader _br;
+			const vp8l_dsp::DspKernels& _dsp;
+
+			uint32_t _width = 0;
+			uint32_t _height = 0;
+			uint8_t* _rgba = nullptr;
+			size_t _rgbaStride = 0;
+			uint8_t* _alpha = nullptr;
+
+			std::vector<Transform> _transforms;  ///< 按读取顺序，逆变换时倒序应用
+			uint32_t _transformsSeen = 0;
+
+			// 逐行流水线
+			uint32_t _codedWidth = 0;            ///< 熵编码图像宽度（调色板打包后）
+			std::vector<uint32_t> _pixels;       ///< 变换前的整幅残差（后向引用的来源）
+			std::vector<uint32_t> _rowBuffers[2];
+			uint32_t _lastRow = 0;
+
+			std::vector<uint8_t> _codeLengths;
+			std::vector<HuffmanCode> _scratchTable;
+		};
+
+		std::expected<void, std::string> Decoder::decode(uint32_t width, uint32_t height,
+			uint8_t* rgba, size_t rgbaStride, uint8_t* alpha)
+		{
+			_width = width;
+			_height = height;
+			_rgba = rgba;
+			_rgbaStride = rgbaStride;
+			_alpha = alpha;
+			_codeLengths.assign(kMaxAlphabetSize, 0);
+			_scratchTable.resize(kMaxTableSize);
+
+			std::vector<uint32_t> unused;
+			return decodeImageStream(width, height, true, unused);
+		}
+
+		std::expected<void, std::string> Decoder::decodeImageStream(uint32_t xsize, uint32_t ysize, bool isLevel0,
+			std::vector<uint32_t>& output)
+		{
+			uint32_t transformXSize = xsize;
+			if (isLevel0)
+			{
+				while (_br.readBits(1))
+				{
+					auto result = readTransform(transformXSize);
+					if (!result.has_value())
+					{
+						return result;
+					}
+				}
+			}
+
+			HuffmanMetadata hdr;
+			if (_br.readBits(1))
+			{
+				hdr.colorCacheBits = static_cast<int>(_br.readBits(4));
+				if (hdr.colorCacheBits < 1 || hdr.colorCacheBits > kMaxCacheBits)
+				{
+					return std::unexpected("Invalid VP8L color cache size");
+				}
+			}
+
+			auto codes = readHuffmanCodes(transformXSize, ysize, isLevel0, hdr);
+			if (!codes.has_value())
+			{
+				return codes;
+			}
+			if (_br.eos())
+			{
+				return std::unexpected("Premature end of VP8L data");
+			}
+
+			if (!isLevel0)
+			{
+				output.resize(static_cast<size_t>(transformXSize) * ysize);
+				return decodeImageData(hdr, output.data(), transformXSize, ysize, false);
+			}
+
+			// 主图像：准备逐行流水线
+			_codedWidth = transformXSize;
+			_pixels.resize(static_cast<size_t>(transformXSize) * ysize);
+			for (auto& row : _rowBuffers)
+			{
+				row.resize(_width);
+			}
+			for (auto& transform : _transforms)
+			{
+				if (transform.type == TransformType::Predictor)
+				{
+					transform.rows.assign(static_cast<size_t>(transform.xsize) * 2, 0);
+				}
+			}
+			_lastRow = 0;
+			return decodeImageData(hdr, _pixels.data(), transformXSize, ysize, true);
+		}
+
+		std::expected<void, std::string> Decoder::readTransform(uint32_t& xsize)
+		{
+			const auto type = static_cast<TransformType>(_br.readBits(2));
+			const uint32_t typeBit = 1u << static_cast<uint32_t>(type);
+			if (_transformsSeen & typeBit)
+			{
+				return std::unexpected("Duplicate VP8L transform");
+			}
+			_transformsSeen |= typeBit;
+
+			Transform transform;
+			transform.type = type;
+			transform.xsize = xsize;
+
+			switch (type)
+			{
+			case TransformType::Predictor:
+			case TransformType::CrossColor:
+			{
+				transform.bits = 2 + static_cast<int>(_br.readBits(3));
+				auto result = decodeImageStream(subSampleSize(xsize, transform.bits), subSampleSize(_height, transform.bits),
+					false, transform.data);
+				if (!result.has_value())
+				{
+					return result;
+				}
+				break;
+			}
+			case TransformType::ColorIndexing:
+			{
+				const uint32_t numColors = _br.readBits(8) + 1;
+				transform.bits = numColors > 16 ? 0 : numColors > 4 ? 1 : numColors > 2 ? 2 : 3;
+				xsize = subSampleSize(xsize, transform.bits);
+				auto result = decodeImageStream(numColors, 1, false, transform.data);
+				if (!result.has_value())
+				{
+					return result;
+				}
+				// 调色板按差分存储；补零到 256 项，越界索引取透明黑
+				for (uint32_t i = 1; i < numColors; ++i)
+				{
+					transform.data[i] = addPixels(transform.data[i], transform.data[i - 1]);
+				}
+				transform.data.resize(256, 0);
+				break;
+			}
+			case TransformType::SubtractGreen:
+				break;
+			}
+
+			_transforms.push_back(std::move(transform));
+			return {};
+		}
+
+		std::expected<void, std::string> Decoder::readHuffmanCodes(uint32_t xsize, uint32_t ysize, bool allowRecursion,
+			HuffmanMetadata& hdr)
+		{
+			uint32_t numGroupsMax = 1;
+			uint32_t numGroups = 1;
+			std::vector<int32_t> mapping;
+
+			if (allowRecursion && _br.readBits(1))
+			{
+				const int precision = 2 + static_cast<int>(_br.readBits(3));
+				const uint32_t huffmanXSize = subSampleSize(xsize, precision);
+				const uint32_t huffmanYSize = subSampleSize(ysize, precision);
+				auto result = decodeImageStream(huffmanXSize, huffmanYSize, false, hdr.huffmanImage);
+				if (!result.has_value())
+				{
+					return result;
+				}
+				hdr.subsampleBits = precision;
+				hdr.huffmanXSize = huffmanXSize;
+				hdr.huffmanMask = (1u << precision) - 1;
+
+				for (uint32_t& entry : hdr.huffmanImage)
+				{
+					entry = (entry >> 8) & 0xffff;
+					numGroupsMax = std::max(numGroupsMax, entry + 1);
+				}
+
+				// 组号可以稀疏（最多 65536 组），按出现顺序重新编号，未使用的组只解析不保存
+				mapping.assign(numGroupsMax, -1);
+				numGroups = 0;
+				for (uint32_t& entry : hdr.huffmanImage)
+				{
+					if (mapping[entry] < 0)
+					{
+						mapping[entry] = static_cast<int32_t>(numGroups++);
+					}
+					entry = static_cast<uint32_t>(mapping[entry]);
+				}
+			}
+
+			if (_br.eos())
+			{
+				return std::unexpected("Premature end of VP8L data");
+			}
+
+			const int cacheSize = hdr.colorCacheBits > 0 ? 1 << hdr.colorCacheBits : 0;
+			std::vector<std::array<uint32_t, kCodesPerGroup>> tableOffsets(numGroups);
+			hdr.groups.resize(numGroups);
+
+			for (uint32_t i = 0; i < numGroupsMax; ++i)
+			{
+				const int32_t target = mapping.empty() ? static_cast<int32_t>(i) : mapping[i];
+				HTreeGroup* group = target >= 0 ? &hdr.groups[target] : nullptr;
+
+				bool isTrivialLiteral = true;
+				int totalBits = 0;
+				int maxBits = 0;
+				HuffmanCode firstEntries[kCodesPerGroup];
+				for (int j = 0; j < kCodesPerGroup; ++j)
+				{
+					const int alphabetSize = kAlphabetSize[j] + (j == GREEN ? cacheSize : 0);
+					const int size = readHuffmanCode(alphabetSize, _codeLengths.data(), _scratchTable.data());
+					if (size == 0)
+					{
+						return std::unexpected("Invalid VP8L Huffman code");
+					}
+					if (!group)
+					{
+						continue;
+					}
+
+					firstEntries[j] = _scratchTable[0];
+					if (j == RED || j == BLUE || j == ALPHA)
+					{
+						isTrivialLiteral = isTrivialLiteral && _scratchTable[0].bits == 0;
+					}
+					totalBits += _scratchTable[0].bits;
+					if (j <= ALPHA)
+					{
+						maxBits += *std::max_element(_codeLengths.begin(), _codeLengths.begin() + alphabetSize);
+					}
+
+					tableOffsets[target][j] = static_cast<uint32_t>(hdr.tables.size());
+					hdr.tables.insert(hdr.tables.end(), _scratchTable.begin(), _scratchTable.begin() + size);
+				}
+				if (!group)
+				{
+					continue;
+				}
+
+				group->isTrivialLiteral = isTrivialLiteral;
+				group->isTrivialCode = false;
+				if (isTrivialLiteral)
+				{
+					group->literalArb = (static_cast<uint32_t>(firstEntries[ALPHA].value) << 24) |
+						(static_cast<uint32_t>(firstEntries[RED].value) << 16) | firstEntries[BLUE].value;
+					if (totalBits == 0 && firstEntries[GREEN].value < kNumLiteralCodes)
+					{
+						group->isTrivialCode = true;
+						group->literalArb |= static_cast<uint32_t>(firstEntries[GREEN].value) << 8;
+					}
+				}
+				group->usePackedTable = !group->isTrivialCode && maxBits < kPackedBits;
+			}
+
+			// 表全部读完后地址才稳定
+			for (uint32_t g = 0; g < numGroups; ++g)
+			{
+				HTreeGroup& group = hdr.groups[g];
+				for (int j = 0; j < kCodesPerGroup; ++j)
+				{
+					group.htrees[j] = hdr.tables.data() + tableOffsets[g][j];
+				}
+				if (group.usePackedTable)
+				{
+					buildPackedTable(group);
+				}
+			}
+			return {};
+		}
+
+		int Decoder::readHuffmanCode(int alphabetSize, uint8_t* codeLengths, HuffmanCode* table)
+		{
+			std::memset(codeLengths, 0, kMaxAlphabetSize);
+
+			bool ok = true;
+			if (_br.readBits(1))
+			{
+				// 简单码：1 或 2 个符号，第一个符号可用 1 位或 8 位表示
+				const uint32_t numSymbols = _br.readBits(1) + 1;
+				const uint32_t firstSymbolBits = _br.readBits(1) ? 8 : 1;
+				codeLengths[_br.readBits(static_cast<int>(firstSymbolBits))] = 1;
+				if (numSymbols == 2)
+				{
+					codeLengths[_br.readBits(8)] = 1;
+				}
+			}
+			else
+			{
+				uint8_t codeLengthCodeLengths[kNumCodeLengthCodes] = {};
+				const uint32_t numCodes = _br.readBits(4) + 4;
+				for (uint32_t i = 0; i < numCodes; ++i)
+				{
+					codeLengthCodeLengths[kCodeLengthCodeOrder[i]] = static_cast<uint8_t>(_br.readBits(3));
+				}
+				ok = readHuffmanCodeLengths(codeLengthCodeLengths, alphabetSize, codeLengths);
+			}
+
+			if (!ok || _br.eos())
+			{
+				return 0;
+			}
+			return buildHuffmanTable(table, kRootBits, codeLengths, alphabetSize, kMaxTableSize);
+		}
+
+		bool Decoder::readHuffmanCodeLengths(const uint8_t* codeLengthCodeLengths, int numSymbols, uint8_t* codeLengths)
+		{
+			HuffmanCode table[1 << kLengthsTableBits];
+			if (buildHuffmanTable(table, kLengthsTableBits, codeLengthCodeLengths, kNumCodeLengthCodes, 1 << kLengthsTableBits) == 0)
+			{
+				return false;
+			}
+
+			int maxSymbol = numSymbols;
+			if (_br.readBits(1))
+			{
+				const int lengthBits = 2 + 2 * static_cast<int>(_br.readBits(3));
+				maxSymbol = 2 + static_cast<int>(_br.readBits(lengthBits));
+				if (maxSymbol > numSymbols)
+				{
+					return false;
+				}
+			}
+
+			int symbol = 0;
+			int prevCodeLength = kDefaultCodeLength;
+			while (symbol < numSymbols)
+			{
+				if (maxSymbol-- == 0)
+				{
+					break;
+				}
+				_br.fill();
+				const HuffmanCode& entry = table[_br.peek() & ((1u << kLengthsTableBits) - 1)];
+				_br.skip(entry.bits);
+				const int codeLength = entry.value;
+				if (codeLength < kCodeLengthLiterals)
+				{
+					codeLengths[symbol++] = static_cast<uint8_t>(codeLength);
+					if (codeLength != 0)
+					{
+						prevCodeLength = codeLength;
+					}
+					continue;
+				}
+
+				const int slot = codeLength - kCodeLengthLiterals;
+				const int repeat = static_cast<int>(_br.readBits(kCodeLengthExtraBits[slot])) + kCodeLengthRepeatOffsets[slot];
+				if (symbol + repeat > numSymbols)
+				{
+					return false;
+				}
+				const uint8_t length = codeLength == kCodeLengthRepeatCode ? static_cast<uint8_t>(prevCodeLength) : 0;
+				std::memset(codeLengths + symbol, length, static_cast<size_t>(repeat));
+				symbol += repeat;
+			}
+			return true;
+		}
+
+		std::expected<void, std::string> Decoder::decodeImageData(const HuffmanMetadata& hdr, uint32_t* data,
+			uint32_t width, uint32_t height, bool isLevel0)
+		{
+			const int cacheBits = hdr.colorCacheBits;
+			const int cacheShift = 32 - cacheBits;
+			std::vector<uint32_t> colorCache(cacheBits > 0 ? size_t{ 1 } << cacheBits : 0);
+			const int lengthCodeLimit = kNumLiteralCodes + kNumLengthCodes;
+			const int colorCacheLimit = lengthCodeLimit + static_cast<int>(colorCache.size());
+
+			auto groupForPos = [&hdr](uint32_t x, uint32_t y) -> const HTreeGroup*
+			{
+				if (hdr.subsampleBits == 0)
+				{
+					return hdr.groups.data();
+				}
+				const size_t index = static_cast<size_t>(y >> hdr.subsampleBits) * hdr.huffmanXSize + (x >> hdr.subsampleBits);
+				return &hdr.groups[hdr.huffmanImage[index]];
+			};
+
+			uint32_t* src = data;
+			uint32_t* const srcEnd = data + static_cast<size_t>(width) * height;
+			uint32_t* lastCached = src;
+			uint32_t col = 0;
+			uint32_t row = 0;
+			const HTreeGroup* group = groupForPos(0, 0);
+
+			auto flushColorCache = [&]()
+			{
+				if (cacheBits > 0)
+				{
+					while (lastCached < src)
+					{
+						const uint32_t argb = *lastCached++;
+						colorCache[(kColorCacheMultiplier * argb) >> cacheShift] = argb;
+					}
+				}
+			};
+
+			while (src < srcEnd)
+			{
+				if ((col & hdr.huffmanMask) == 0)
+				{
+					group = groupForPos(col, row);
+				}
+
+				if (group->isTrivialCode)
+				{
+					*src = group->literalArb;
+				}
+				else
+				{
+					_br.fill();
+					int code;
+					if (group->usePackedTable)
+					{
+						code = readPackedSymbols(*group, _br, src);
+					}
+					else
+					{
+						code = readSymbol(group->htrees[GREEN], _br);
+					}
+
+					if (group->usePackedTable && code == kPackedNonLiteralCode)
+					{
+						// 打包表已写出完整像素
+					}
+					else if (code < kNumLiteralCodes)
+					{
+						if (group->isTrivialLiteral)
+						{
+							*src = group->literalArb | (static_cast<uint32_t>(code) << 8);
+						}
+						else
+						{
+							const uint32_t red = static_cast<uint32_t>(readSymbol(group->htrees[RED], _br));
+							_br.fill();
+							const uint32_t blue = static_cast<uint32_t>(readSymbol(group->htrees[BLUE], _br));
+							const uint32_t alpha = static_cast<uint32_t>(readSymbol(group->htrees[ALPHA], _br));
+							*src = (alpha << 24) | (red << 16) | (static_cast<uint32_t>(code) << 8) | blue;
+						}
+					}
+					else if (code < lengthCodeLimit)
+					{
+						// 后向引用：长度 + 距离
+						const uint32_t length = getCopyDistance(code - kNumLiteralCodes, _br);
+						_br.fill();
+						const int distSymbol = readSymbol(group->htrees[DIST], _br);
+						_br.fill();
+						const uint32_t distCode = getCopyDistance(distSymbol, _br);
+						const uint32_t dist = planeCodeToDistance(width, distCode);
+						if (_br.eos())
+						{
+							break;
+						}
+						if (static_cast<size_t>(src - data) < dist || static_cast<size_t>(srcEnd - src) < length)
+						{
+							return std::unexpected("Invalid VP8L backward reference");
+						}
+
+						const uint32_t* copySrc = src - dist;
+						if (dist >= length)
+						{
+							std::memcpy(src, copySrc, static_cast<size_t>(length) * sizeof(uint32_t));
+						}
+						else
+						{
+							for (uint32_t i = 0; i < length; ++i)
+							{
+								src[i] = copySrc[i];
+							}
+						}
+
+						src += length;
+						col += length;
+						while (col >= width)
+						{
+							col -= width;
+							++row;
+						}
+						if (isLevel0 && row > _lastRow)
+						{
+							processRows(row);
+						}
+						if (src < srcEnd && (col & hdr.huffmanMask) != 0)
+						{
+							group = groupForPos(col, row);
+						}
+						flushColorCache();
+						continue;
+					}
+					else if (code < colorCacheLimit)
+					{
+						const int key = code - lengthCodeLimit;
+						flushColorCache();
+						*src = colorCache[key];
+					}
+					else
+					{
+						return std::unexpected("Invalid VP8L symbol");
+					}
+				}
+
+				++src;
+				++col;
+				if (col >= width)
+				{
+					col = 0;
+					++row;
+					if (_br.eos())
+					{
+						break;
+					}
+					if (isLevel0)
+					{
+						processRows(row);
+					}
+					flushColorCache();
+				}
+			}
+
+			if (_br.eos())
+			{
+				return std::unexpected("Premature end of VP8L data");
+			}
+			return {};
+		}
+
+		// ============================================================================
+		// 逐行逆变换
+		// ============================================================================
+
+		void Decoder::predictRow(const Transform& transform, uint32_t y, const uint32_t* in, uint32_t* upper, uint32_t* out) const
+		{
+			const uint32_t width = transform.xsize;
+			if (y == 0)
+			{
+				// 首行：首像素预测为不透明黑，其余取左侧
+				_dsp.predictorAdd[0](in, upper, 1, out);
+				_dsp.predictorAdd[1](in + 1, upper + 1, width - 1, out + 1);
+				return;
+			}
+
+			// 首列取上方
+			_dsp.predictorAdd[2](in, upper, 1, out);
+
+			const int bits = transform.bits;
+			const uint32_t tileWidth = 1u << bits;
+			const uint32_t* modes = transform.data.data() + static_cast<size_t>(y >> bits) * subSampleSize(width, bits);
+			uint32_t x = 1;
+			while (x < width)
+			{
+				const uint32_t mode = (modes[x >> bits] >> 8) & 0xf;
+				const uint32_t xEnd = std::min((x & ~(tileWidth - 1)) + tileWidth, width);
+				// 模式 14、15 按 libwebp 视为模式 0
+				_dsp.predictorAdd[mode < vp8l_dsp::kNumPredictorModes ? mode : 0](in + x, upper + x, xEnd - x, out + x);
+				x = xEnd;
+			}
+		}
+
+		void Decoder::colorSpaceInverseRow(const Transform& transform, uint32_t y, uint32_t* row) const
+		{
+			const uint32_t width = transform.xsize;
+			const int bits = transform.bits;
+			const uint32_t tileWidth = 1u << bits;
+			const uint32_t* codes = transform.data.data() + static_cast<size_t>(y >> bits) * subSampleSize(width, bits);
+			for (uint32_t x = 0; x < width; x += tileWidth)
+			{
+				const uint32_t code = codes[x >> bits];
+				vp8l_dsp::ColorMultipliers multipliers;
+				multipliers.greenToRed = static_cast<uint8_t>(code);
+				multipliers.greenToBlue = static_cast<uint8_t>(code >> 8);
+				multipliers.redToBlue = static_cast<uint8_t>(code >> 16);
+				_dsp.transformColorInverse(multipliers, row + x, std::min(tileWidth, width - x));
+			}
+		}
+
+		void Decoder::colorIndexInverseRow(const Transform& transform, const uint32_t* in, uint32_t* out) const
+		{
+			const uint32_t width = transform.xsize;
+			const uint32_t* palette = transform.data.data();
+			if (transform.bits == 0)
+			{
+				for (uint32_t x = 0; x < width; ++x)
+				{
+					out[x] = palette[(in[x] >> 8) & 0xff];
+				}
+				return;
+			}
+
+			// 每个绿色字节打包 2/4/8 个索引，低位在前
+			const int bitsPerPixel = 8 >> transform.bits;
+			const uint32_t countMask = (1u << transform.bits) - 1;
+			const uint32_t bitMask = (1u << bitsPerPixel) - 1;
+			uint32_t packed = 0;
+			for (uint32_t x = 0; x < width; ++x)
+			{
+				if ((x & countMask) == 0)
+				{
+					packed = (*in++ >> 8) & 0xff;
+				}
+				out[x] = palette[packed & bitMask];
+				packed >>= bitsPerPixel;
+			}
+		}
+
+		void Decoder::processRows(uint32_t rowEnd)
+		{
+			rowEnd = std::min(rowEnd, _height);
+			for (uint32_t y = _lastRow; y < rowEnd; ++y)
+			{
+				// 残差行只读；就地变换先复制到行缓冲，行缓冲之间交替使用
+				const uint32_t* in = _pixels.data() + static_cast<size_t>(y) * _codedWidth;
+				uint32_t* const buffers[2] = { _rowBuffers[0].data(), _rowBuffers[1].data() };
+				auto otherBuffer = [&buffers](const uint32_t* current)
+				{
+					return current == buffers[0] ? buffers[1] : buffers[0];
+				};
+
+				for (auto it = _transforms.rbegin(); it != _transforms.rend(); ++it)
+				{
+					Transform& transform = *it;
+					switch (transform.type)
+					{
+					case TransformType::Predictor:
+					{
+						uint32_t* upper = transform.rows.data();
+						uint32_t* out = upper + transform.xsize;
+						predictRow(transform, y, in, upper, out);
+						std::memcpy(upper, out, transform.xsize * sizeof(uint32_t));
+						in = upper;
+						break;
+					}
+					case TransformType::CrossColor:
+					case TransformType::SubtractGreen:
+					{
+						uint32_t* row = const_cast<uint32_t*>(in);
+						if (in != buffers[0] && in != buffers[1])
+						{
+							row = buffers[0];
+							std::memcpy(row, in, transform.xsize * sizeof(uint32_t));
+						}
+						if (transform.type == TransformType::SubtractGreen)
+						{
+							_dsp.addGreenToBlueAndRed(row, transform.xsize);
+						}
+						else
+						{
+							colorSpaceInverseRow(transform, y, row);
+						}
+						in = row;
+						break;
+					}
+					case TransformType::ColorIndexing:
+					{
+						uint32_t* out = otherBuffer(in);
+						colorIndexInverseRow(transform, in, out);
+						in = out;
+						break;
+					}
+					}
+				}
+
+				if (_rgba)
+				{
+					_dsp.argbToRgba(in, _width, _rgba + y * _rgbaStride);
+				}
+				else
+				{
+					uint8_t* alpha = _alpha + static_cast<size_t>(y) * _width;
+					for (uint32_t x = 0; x < _width; ++x)
+					{
+						alpha[x] = static_cast<uint8_t>(in[x] >> 8);
+					}
+				}
+			}
+			_lastRow = std::max(_lastRow, rowEnd);
+		}
+	} // namespace
+
+	std::expected<Vp8lImageInfo, std::string> parseImageInfo(const uint8_t* data, size_t size)
+	{
+		if (!data || size < kHeaderSize)
+		{
+			return std::unexpected("VP8L data is too small");
+		}
+		if (data[0] != kSignature)
+		{
+			return std::unexpected("Invalid VP8L signature");
+		}
+
+		const uint32_t bits = data[1] | (data[2] << 8) | (data[3] << 16) | (static_cast<uint32_t>(data[4]) << 24);
+		if ((bits >> 29) != 0)
+		{
+			return std::unexpected("Unsupported VP8L version");
+		}
+
+		Vp8lImageInfo info;
+		info.width = (bits & 0x3fff) + 1;
+		info.height = ((bits >> 14) & 0x3fff) + 1;
+		info.hasAlpha = ((bits >> 28) & 1) != 0;
+		return info;
+	}
+
+	std::expected<void, std::string> decodeImage(const uint8_t* data, size_t size, uint8_t* rgba, size_t rgbaStride)
+	{
+		auto info = parseImageInfo(data, size);
+		if (!info.has_value())
+		{
+			return std::unexpected(info.error());
+		}
+		if (!rgba)
+		{
+			return std::unexpected("Invalid output buffer");
+		}
+
+		Decoder decoder(data + kHeaderSize, size - kHeaderSize);
+		return decoder.decode(info->width, info->height, rgba, rgbaStride, nullptr);
+	}
+
+	std::expected<void, std::string> decodeAlphaStream(const uint8_t* data, size_t size,
+		uint32_t width, uint32_t height, uint8_t* alpha)
+	{
+		if (!data || !alpha || width == 0 || height == 0)
+		{
+			return std::unexpected("Invalid VP8L alpha stream");
+		}
+
+		Decoder decoder(data, size);
+		return decoder.decode(width, height, nullptr, 0, alpha);
+	}
+
+} // namespace shine::image::vp8l
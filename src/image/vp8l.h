@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <expected>
+
+/**
+ * @file vp8l.h
+ * @brief VP8L 无损解码（无损 WebP 的 "VP8L" 块，以及 ALPH 块中的无损 Alpha 流）
+ *
+ * 完整实现 WebP 无损位流：四种变换、颜色缓存、元前缀码（Huffman 组）与 LZ77 后向引用，
+ * 输出与 libwebp 逐字节一致。
+ *
+ * 每组五个前缀码按 libwebp 的方式建成 8 位根表 + 二级表；当绿/红/蓝/Alpha 四个码的最长码长之和
+ * 小于 6 时，额外展开为 64 项的打包表，一次查表得到整个 ARGB 字面量。
+ * 逆变换按行流水线执行：熵解码每完成一行（后向引用可能一次完成多行），立即对该行依次应用
+ * 全部逆变换并转换为 RGBA，每个像素在缓存中只被访问常数次。
+ *
+ * @see https://developers.google.com/speed/webp/docs/webp_lossless_bitstream_specification
+ */
+
+namespace shine::image::vp8l
+{
+	/**
+	 * @brief VP8L 图像头信息
+	 */
+	struct Vp8lImageInfo
+	{
+		uint32_t width = 0;     ///< 图像宽度（像素）
+		uint32_t height = 0;    ///< 图像高度（像素）
+		bool hasAlpha = false;  ///< 头部的 alpha_is_used 提示位
+	};
+
+	/**
+	 * @brief 解析 VP8L 头（签名 0x2f + 14 位宽 + 14 位高 + Alpha 位 + 3 位版本）
+	 * @param data "VP8L" 块数据
+	 * @param size 数据大小
+	 * @return 图像信息，签名或版本无效时返回错误
+	 */
+	std::expected<Vp8lImageInfo, std::string> parseImageInfo(const uint8_t* data, size_t size);
+
+	/**
+	 * @brief 解码一个 VP8L 块为 RGBA
+	 * @param data "VP8L" 块数据（含 5 字节头）
+	 * @param size 数据大小
+	 * @param rgba 输出缓冲，至少 height 行，每行 width * 4 字节
+	 * @param rgbaStride 输出行跨度（字节）
+	 * @return 成功返回 void，失败返回错误信息
+	 */
+	std::expected<void, std::string> decodeImage(const uint8_t* data, size_t size, uint8_t* rgba, size_t rgbaStride);
+
+	/**
+	 * @brief 解码 ALPH 块中的无损 Alpha 流（无 VP8L 头，尺寸由外部给出，Alpha 取自绿色通道）
+	 * @param data 压缩数据（ALPH 头字节之后）
+	 * @param size 数据大小
+	 * @param width 图像宽度
+	 * @param height 图像高度
+	 * @param alpha 输出缓冲，width * height 字节
+	 * @return 成功返回 void，失败返回错误信息
+	 */
+	std::expected<void, std::string> decodeAlphaStream(const uint8_t* data, size_t size,
+		uint32_t width, uint32_t height, uint8_t* alpha);
+
+} // namespace shine::image::vp8l
@@ -0,0 +1,478 @@
+#include "vp8l_dsp.h"
+
+#include <cstdlib>
+
+#if !defined(__EMSCRIPTEN__) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define SHINE_VP8L_DSP_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要按函数开启指令集，MSVC 的 intrinsic 不依赖编译选项
+#if defined(SHINE_VP8L_DSP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SHINE_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define SHINE_TARGET_SSE2
+#endif
+
+/**
+ * @file vp8l_dsp.cpp
+ * @brief VP8L 逆变换内核实现
+ *
+ * 只依赖上一行的预测模式（0、2、3、4、8、9）在 SSE2 中一次处理 4 个像素；
+ * 模式 1 用行内前缀和；依赖左侧像素的其余模式逐像素计算，其中 11-13 在 16 位通道上完成。
+ * 颜色逆变换沿用 libwebp lossless_sse2.c 的 mulhi 构造：系数预先左移 8 位再算术右移 5 位，
+ * 使 (int8 * int8) >> 5 恰好落在乘积的高 16 位。
+ */
+
+namespace shine::image::vp8l_dsp
+{
+	namespace
+	{
+		// ============================================================================
+		// 标量参考实现
+		// ============================================================================
+
+		/// 逐通道模 256 相加
+		inline uint32_t addPixels(uint32_t a, uint32_t b) noexcept
+		{
+			const uint32_t alphaGreen = (a & 0xff00ff00u) + (b & 0xff00ff00u);
+			const uint32_t redBlue = (a & 0x00ff00ffu) + (b & 0x00ff00ffu);
+			return (alphaGreen & 0xff00ff00u) | (redBlue & 0x00ff00ffu);
+		}
+
+		/// 逐通道向下取整的平均值
+		inline uint32_t average2(uint32_t a, uint32_t b) noexcept
+		{
+			return (((a ^ b) & 0xfefefefeu) >> 1) + (a & b);
+		}
+
+		inline uint32_t clip255(uint32_t a) noexcept
+		{
+			if (a < 256)
+			{
+				return a;
+			}
+			// 负数（高位为 1）得到 0，正向溢出得到 255
+			return ~a >> 24;
+		}
+
+		inline int channelDistance(uint32_t a, uint32_t b, int shift) noexcept
+		{
+			return std::abs(static_cast<int>((a >> shift) & 0xff) - static_cast<int>((b >> shift) & 0xff));
+		}
+
+		/// 模式 11：选择与左上角梯度更接近的 T 或 L
+		inline uint32_t select(uint32_t top, uint32_t left, uint32_t topLeft) noexcept
+		{
+			int score = 0;
+			for (int shift = 0; shift < 32; shift += 8)
+			{
+				score += channelDistance(left, topLeft, shift) - channelDistance(top, topLeft, shift);
+			}
+			return score <= 0 ? top : left;
+		}
+
+		inline uint32_t clampedAddSubtractFull(uint32_t c0, uint32_t c1, uint32_t c2) noexcept
+		{
+			uint32_t result = 0;
+			for (int shift = 0; shift < 32; shift += 8)
+			{
+				const uint32_t v = ((c0 >> shift) & 0xff) + ((c1 >> shift) & 0xff) - ((c2 >> shift) & 0xff);
+				result |= clip255(v) << shift;
+			}
+			return result;
+		}
+
+		inline uint32_t clampedAddSubtractHalf(uint32_t c0, uint32_t c1, uint32_t c2) noexcept
+		{
+			const uint32_t average = average2(c0, c1);
+			uint32_t result = 0;
+			for (int shift = 0; shift < 32; shift += 8)
+			{
+				const int a = static_cast<int>((average >> shift) & 0xff);
+				const int b = static_cast<int>((c2 >> shift) & 0xff);
+				result |= clip255(static_cast<uint32_t>(a + (a - b) / 2)) << shift;
+			}
+			return result;
+		}
+
+		// 预测函数：left 为左侧输出像素，top 指向上一行同列（top[-1] 为左上，top[1] 为右上）
+		inline uint32_t predict0(uint32_t, const uint32_t*) noexcept { return 0xff000000u; }
+		inline uint32_t predict1(uint32_t left, const uint32_t*) noexcept { return left; }
+		inline uint32_t predict2(uint32_t, const uint32_t* top) noexcept { return top[0]; }
+		inline uint32_t predict3(uint32_t, const uint32_t* top) noexcept { return top[1]; }
+		inline uint32_t predict4(uint32_t, const uint32_t* top) noexcept { return top[-1]; }
+		inline uint32_t predict5(uint32_t left, const uint32_t* top) noexcept { return average2(average2(left, top[1]), top[0]); }
+		inline uint32_t predict6(uint32_t left, const uint32_t* top) noexcept { return average2(left, top[-1]); }
+		inline uint32_t predict7(uint32_t left, const uint32_t* top) noexcept { return average2(left, top[0]); }
+		inline uint32_t predict8(uint32_t, const uint32_t* top) noexcept { return average2(top[-1], top[0]); }
+		inline uint32_t predict9(uint32_t, const uint32_t* top) noexcept { return average2(top[0], top[1]); }
+		inline uint32_t predict10(uint32_t left, const uint32_t* top) noexcept
+		{
+			return average2(average2(left, top[-1]), average2(top[0], top[1]));
+		}
+		inline uint32_t predict11(uint32_t left, const uint32_t* top) noexcept { return select(top[0], left, top[-1]); }
+		inline uint32_t predict12(uint32_t left, const uint32_t* top) noexcept { return clampedAddSubtractFull(left, top[0], top[-1]); }
+		inline uint32_t predict13(uint32_t left, const uint32_t* top) noexcept { return clampedAddSubtractHalf(left, top[0], top[-1]); }
+
+		template <uint32_t (*Predict)(uint32_t, const uint32_t*) noexcept>
+		void predictorAddScalar(const uint32_t* in, const uint32_t* upper, size_t count, uint32_t* out)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				out[i] = addPixels(in[i], Predict(out[i - 1], upper + i));
+			}
+		}
+
+		void addGreenToBlueAndRedScalar(uint32_t* argb, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const uint32_t green = (argb[i] >> 8) & 0xff;
+				uint32_t redBlue = argb[i] & 0x00ff00ffu;
+				redBlue += (green << 16) | green;
+				argb[i] = (argb[i] & 0xff00ff00u) | (redBlue & 0x00ff00ffu);
+			}
+		}
+
+		inline int colorTransformDelta(int8_t predictor, int8_t color) noexcept
+		{
+			return (static_cast<int>(predictor) * static_cast<int>(color)) >> 5;
+		}
+
+		void transformColorInverseScalar(const ColorMultipliers& m, uint32_t* argb, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const uint32_t pixel = argb[i];
+				const int8_t green = static_cast<int8_t>(pixel >> 8);
+				int red = static_cast<int>((pixel >> 16) & 0xff);
+				int blue = static_cast<int>(pixel & 0xff);
+				red += colorTransformDelta(static_cast<int8_t>(m.greenToRed), green);
+				red &= 0xff;
+				blue += colorTransformDelta(static_cast<int8_t>(m.greenToBlue), green);
+				blue += colorTransformDelta(static_cast<int8_t>(m.redToBlue), static_cast<int8_t>(red));
+				blue &= 0xff;
+				argb[i] = (pixel & 0xff00ff00u) | (static_cast<uint32_t>(red) << 16) | static_cast<uint32_t>(blue);
+			}
+		}
+
+		void argbToRgbaScalar(const uint32_t* argb, size_t count, uint8_t* rgba)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const uint32_t pixel = argb[i];
+				rgba[i * 4 + 0] = static_cast<uint8_t>(pixel >> 16);
+				rgba[i * 4 + 1] = static_cast<uint8_t>(pixel >> 8);
+				rgba[i * 4 + 2] = static_cast<uint8_t>(pixel);
+				rgba[i * 4 + 3] = static_cast<uint8_t>(pixel >> 24);
+			}
+		}
+
+		constexpr DspKernels kScalarKernels = {
+			{
+				predictorAddScalar<predict0>, predictorAddScalar<predict1>,
+				predictorAddScalar<predict2>, predictorAddScalar<predict3>,
+				predictorAddScalar<predict4>, predictorAddScalar<predict5>,
+				predictorAddScalar<predict6>, predictorAddScalar<predict7>,
+				predictorAddScalar<predict8>, predictorAddScalar<predict9>,
+				predictorAddScalar<predict10>, predictorAddScalar<predict11>,
+				predictorAddScalar<predict12>, predictorAddScalar<predict13>,
+			},
+			addGreenToBlueAndRedScalar,
+			transformColorInverseScalar,
+			argbToRgbaScalar,
+		};
+
+#if defined(SHINE_VP8L_DSP_X86)
+		// ============================================================================
+		// SSE2
+		// ============================================================================
+
+		SHINE_TARGET_SSE2 inline __m128i load4(const uint32_t* p) noexcept
+		{
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		}
+
+		SHINE_TARGET_SSE2 inline void store4(uint32_t* p, __m128i v) noexcept
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+		}
+
+		/// 逐字节向下取整平均：avg_epu8 向上取整，减去两数奇偶不同的最低位
+		SHINE_TARGET_SSE2 inline __m128i average2SSE2(__m128i a, __m128i b) noexcept
+		{
+			const __m128i ones = _mm_set1_epi8(1);
+			const __m128i rounded = _mm_avg_epu8(a, b);
+			return _mm_sub_epi8(rounded, _mm_and_si128(_mm_xor_si128(a, b), ones));
+		}
+
+		/// 预测值只依赖上一行：每次 4 个像素，尾部交给标量实现
+		template <int Mode>
+		SHINE_TARGET_SSE2 void predictorAddUpperSSE2(const uint32_t* in, const uint32_t* upper, size_t count, uint32_t* out)
+		{
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i pred;
+				if constexpr (Mode == 0)
+				{
+					pred = _mm_set1_epi32(static_cast<int>(0xff000000u));
+				}
+				else if constexpr (Mode == 2)
+				{
+					pred = load4(upper + i);
+				}
+				else if constexpr (Mode == 3)
+				{
+					pred = load4(upper + i + 1);
+				}
+				else if constexpr (Mode == 4)
+				{
+					pred = load4(upper + i - 1);
+				}
+				else if constexpr (Mode == 8)
+				{
+					pred = average2SSE2(load4(upper + i - 1), load4(upper + i));
+				}
+				else
+				{
+					static_assert(Mode == 9);
+					pred = average2SSE2(load4(upper + i), load4(upper + i + 1));
+				}
+				store4(out + i, _mm_add_epi8(load4(in + i), pred));
+			}
+			if (i < count)
+			{
+				kScalarKernels.predictorAdd[Mode](in + i, upper + i, count - i, out + i);
+			}
+		}
+
+		/// 模式 1：行内前缀和，每次 4 个像素
+		SHINE_TARGET_SSE2 void predictorAdd1SSE2(const uint32_t* in, const uint32_t* upper, size_t count, uint32_t* out)
+		{
+			__m128i left = _mm_set1_epi32(static_cast<int>(out[-1]));
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i sum = load4(in + i);
+				sum = _mm_add_epi8(sum, _mm_slli_si128(sum, 4));
+				sum = _mm_add_epi8(sum, _mm_slli_si128(sum, 8));
+				sum = _mm_add_epi8(sum, left);
+				store4(out + i, sum);
+				left = _mm_shuffle_epi32(sum, _MM_SHUFFLE(3, 3, 3, 3));
+			}
+			if (i < count)
+			{
+				kScalarKernels.predictorAdd[1](in + i, upper + i, count - i, out + i);
+			}
+		}
+
+		SHINE_TARGET_SSE2 inline __m128i loadPixel16(uint32_t pixel, __m128i zero) noexcept
+		{
+			return _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(pixel)), zero);
+		}
+
+		/// 模式 11：用 sad_epu8 求四个通道的绝对差之和
+		SHINE_TARGET_SSE2 void predictorAdd11SSE2(const uint32_t* in, const uint32_t* upper, size_t count, uint32_t* out)
+		{
+			uint32_t left = out[-1];
+			for (size_t i = 0; i < count; ++i)
+			{
+				const __m128i t = _mm_cvtsi32_si128(static_cast<int>(upper[i]));
+				const __m128i tl = _mm_cvtsi32_si128(static_cast<int>(upper[i - 1]));
+				const __m128i l = _mm_cvtsi32_si128(static_cast<int>(left));
+				const int distTop = _mm_cvtsi128_si32(_mm_sad_epu8(t, tl));
+				const int distLeft = _mm_cvtsi128_si32(_mm_sad_epu8(l, tl));
+				const uint32_t pred = distLeft <= distTop ? upper[i] : left;
+				left = addPixels(in[i], pred);
+				out[i] = left;
+			}
+		}
+
+		/// 模式 12：16 位通道上计算 L + T - TL，packus 完成钳位
+		SHINE_TARGET_SSE2 void predictorAdd12SSE2(const uint32_t* in, const uint32_t* upper, size_t count, uint32_t* out)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			__m128i left = loadPixel16(out[-1], zero);
+			for (size_t i = 0; i < count; ++i)
+			{
+				const __m128i diff = _mm_sub_epi16(loadPixel16(upper[i], zero), loadPixel16(upper[i - 1], zero));
+				const __m128i pred16 = _mm_add_epi16(left, diff);
+				const __m128i pred = _mm_packus_epi16(pred16, pred16);
+				const __m128i result = _mm_add_epi8(_mm_cvtsi32_si128(static_cast<int>(in[i])), pred);
+				out[i] = static_cast<uint32_t>(_mm_cvtsi128_si32(result));
+				left = _mm_unpacklo_epi8(result, zero);
+			}
+		}
+
+		/// 模式 13：a + (a - TL) / 2，a = avg(L, T)，除法按 C 语义向零取整
+		SHINE_TARGET_SSE2 void predictorAdd13SSE2(const uint32_t* in, const uint32_t* upper, size_t count, uint32_t* out)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			__m128i left = loadPixel16(out[-1], zero);
+			for (size_t i = 0; i < count; ++i)
+			{
+				const __m128i average = _mm_srli_epi16(_mm_add_epi16(left, loadPixel16(upper[i], zero)), 1);
+				const __m128i diff = _mm_sub_epi16(average, loadPixel16(upper[i - 1], zero));
+				const __m128i half = _mm_srai_epi16(_mm_add_epi16(diff, _mm_srli_epi16(diff, 15)), 1);
+				const __m128i pred16 = _mm_add_epi16(average, half);
+				const __m128i pred = _mm_packus_epi16(pred16, pred16);
+				const __m128i result = _mm_add_epi8(_mm_cvtsi32_si128(static_cast<int>(in[i])), pred);
+				out[i] = static_cast<uint32_t>(_mm_cvtsi128_si32(result));
+				left = _mm_unpacklo_epi8(result, zero);
+			}
+		}
+
+		SHINE_TARGET_SSE2 void addGreenToBlueAndRedSSE2(uint32_t* argb, size_t count)
+		{
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128i in = load4(argb + i);
+				const __m128i ag = _mm_srli_epi16(in, 8);                                  // 0 a 0 g
+				const __m128i lo = _mm_shufflelo_epi16(ag, _MM_SHUFFLE(2, 2, 0, 0));
+				const __m128i gg = _mm_shufflehi_epi16(lo, _MM_SHUFFLE(2, 2, 0, 0));      // 0 g 0 g
+				store4(argb + i, _mm_add_epi8(in, gg));
+			}
+			addGreenToBlueAndRedScalar(argb + i, count - i);
+		}
+
+		SHINE_TARGET_SSE2 void transformColorInverseSSE2(const ColorMultipliers& m, uint32_t* argb, size_t count)
+		{
+			// 系数按 int8 << 8 再 >> 5，与 int8 << 8 的绿色 mulhi 后恰为 (g * m) >> 5
+			const auto scaled = [](uint8_t v) { return static_cast<uint32_t>(static_cast<uint16_t>(static_cast<int16_t>(static_cast<int16_t>(v << 8) >> 5))); };
+			const __m128i multsRB = _mm_set1_epi32(static_cast<int>((scaled(m.greenToRed) << 16) | scaled(m.greenToBlue)));
+			const __m128i multsB2 = _mm_set1_epi32(static_cast<int>(scaled(m.redToBlue) << 16));
+			const __m128i maskAG = _mm_set1_epi32(static_cast<int>(0xff00ff00u));
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128i in = load4(argb + i);
+				const __m128i a = _mm_and_si128(in, maskAG);                                // a 0 g 0
+				const __m128i b = _mm_shufflelo_epi16(a, _MM_SHUFFLE(2, 2, 0, 0));
+				const __m128i c = _mm_shufflehi_epi16(b, _MM_SHUFFLE(2, 2, 0, 0));         // g 0 g 0
+				const __m128i d = _mm_mulhi_epi16(c, multsRB);                              // x dr x db1
+				const __m128i e = _mm_add_epi8(in, d);                                      // x r' x b'
+				const __m128i f = _mm_slli_epi16(e, 8);                                     // r' 0 b' 0
+				const __m128i g = _mm_mulhi_epi16(f, multsB2);                              // x db2 0 0
+				const __m128i h = _mm_srli_epi32(g, 8);                                     // 0 x db2 0
+				const __m128i k = _mm_add_epi8(h, f);                                       // r' x b'' 0
+				const __m128i j = _mm_srli_epi16(k, 8);                                     // 0 r' 0 b''
+				store4(argb + i, _mm_or_si128(j, a));
+			}
+			transformColorInverseScalar(m, argb + i, count - i);
+		}
+
+		SHINE_TARGET_SSE2 void argbToRgbaSSE2(const uint32_t* argb, size_t count, uint8_t* rgba)
+		{
+			const __m128i maskAG = _mm_set1_epi32(static_cast<int>(0xff00ff00u));
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128i in = load4(argb + i);
+				const __m128i ag = _mm_and_si128(in, maskAG);
+				const __m128i rb = _mm_andnot_si128(maskAG, in);                            // 0 r 0 b
+				const __m128i lo = _mm_shufflelo_epi16(rb, _MM_SHUFFLE(2, 3, 0, 1));
+				const __m128i br = _mm_shufflehi_epi16(lo, _MM_SHUFFLE(2, 3, 0, 1));       // 0 b 0 r
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4), _mm_or_si128(ag, br));
+			}
+			argbToRgbaScalar(argb + i, count - i, rgba + i * 4);
+		}
+
+		constexpr DspKernels kSSE2Kernels = {
+			{
+				predictorAddUpperSSE2<0>, predictorAdd1SSE2,
+				predictorAddUpperSSE2<2>, predictorAddUpperSSE2<3>,
+				predictorAddUpperSSE2<4>, predictorAddScalar<predict5>,
+				predictorAddScalar<predict6>, predictorAddScalar<predict7>,
+				predictorAddUpperSSE2<8>, predictorAddUpperSSE2<9>,
+				predictorAddScalar<predict10>, predictorAdd11SSE2,
+				predictorAdd12SSE2, predictorAdd13SSE2,
+			},
+			addGreenToBlueAndRedSSE2,
+			transformColorInverseSSE2,
+			argbToRgbaSSE2,
+		};
+
+		// ============================================================================
+		// 运行时检测
+		// ============================================================================
+
+		bool cpuHasSSE2() noexcept
+		{
+#if defined(__x86_64__) || defined(_M_X64)
+			return true; // x86-64 基线
+#elif defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 1);
+			return (info[3] & (1 << 26)) != 0;
+#else
+			return __builtin_cpu_supports("sse2");
+#endif
+		}
+#endif // SHINE_VP8L_DSP_X86
+
+		DspBackend detectBackend() noexcept
+		{
+#if defined(SHINE_VP8L_DSP_X86)
+			if (cpuHasSSE2())
+			{
+				return DspBackend::SSE2;
+			}
+#endif
+			return DspBackend::Scalar;
+		}
+	} // namespace
+
+	DspBackend activeBackend() noexcept
+	{
+		static const DspBackend backend = detectBackend();
+		return backend;
+	}
+
+	bool isBackendSupported(DspBackend backend) noexcept
+	{
+		switch (backend)
+		{
+		case DspBackend::Scalar:
+			return true;
+#if defined(SHINE_VP8L_DSP_X86)
+		case DspBackend::SSE2:
+			return cpuHasSSE2();
+#endif
+		default:
+			return false;
+		}
+	}
+
+	const char* backendName(DspBackend backend) noexcept
+	{
+		switch (backend)
+		{
+		case DspBackend::Scalar: return "Scalar";
+		case DspBackend::SSE2: return "SSE2";
+		}
+		return "Unknown";
+	}
+
+	const DspKernels& kernels() noexcept
+	{
+		return kernels(activeBackend());
+	}
+
+	const DspKernels& kernels(DspBackend backend) noexcept
+	{
+#if defined(SHINE_VP8L_DSP_X86)
+		if (backend == DspBackend::SSE2 && isBackendSupported(backend))
+		{
+			return kSSE2Kernels;
+		}
+#endif
+		return kScalarKernels;
+	}
+
+} // namespace shine::image::vp8l_dsp
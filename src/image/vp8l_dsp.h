@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @file vp8l_dsp.h
+ * @brief VP8L（无损 WebP）逆变换内核：预测、颜色变换、减绿与 ARGB -> RGBA 行转换
+ *
+ * 所有内核按行处理，解码器在一行残差解码完成后立即依次调用各逆变换，像素仍在缓存中。
+ * 提供标量参考实现与 SSE2 内核，运行时按 CPU 特性分派，结果逐字节一致（见 test/Vp8lDspTest）。
+ *
+ * 像素按 libwebp 的约定存放为 uint32_t ARGB（A 在最高字节）。
+ *
+ * @see https://developers.google.com/speed/webp/docs/webp_lossless_bitstream_specification
+ */
+
+namespace shine::image::vp8l_dsp
+{
+	/**
+	 * @brief 内核实现
+	 */
+	enum class DspBackend : uint8_t
+	{
+		Scalar = 0,  ///< 标量参考实现
+		SSE2         ///< x86 SSE2
+	};
+
+	/**
+	 * @brief 当前 CPU 上选用的内核实现（首次调用时检测并缓存）
+	 */
+	DspBackend activeBackend() noexcept;
+
+	/**
+	 * @brief 检查指定内核在当前 CPU / 编译配置下是否可用
+	 */
+	bool isBackendSupported(DspBackend backend) noexcept;
+
+	/**
+	 * @brief 获取内核名称（用于日志与测试输出）
+	 */
+	const char* backendName(DspBackend backend) noexcept;
+
+	constexpr int kNumPredictorModes = 14;
+
+	/**
+	 * @brief 预测逆变换：out[i] = in[i] + predict(out[i - 1], upper[i - 1], upper[i], upper[i + 1])（逐通道模 256）
+	 * @param in 残差
+	 * @param upper 上一行的输出（与 out 对齐）
+	 * @param count 像素数
+	 * @param out 输出，out[-1] 为左侧像素
+	 */
+	using PredictorAddFn = void (*)(const uint32_t* in, const uint32_t* upper, size_t count, uint32_t* out);
+
+	/**
+	 * @brief 颜色变换系数（ColorTransformElement，均按 int8 解释）
+	 */
+	struct ColorMultipliers
+	{
+		uint8_t greenToRed = 0;
+		uint8_t greenToBlue = 0;
+		uint8_t redToBlue = 0;
+	};
+
+	/**
+	 * @brief 一组内核函数
+	 */
+	struct DspKernels
+	{
+		PredictorAddFn predictorAdd[kNumPredictorModes];  ///< 按预测模式 0-13 索引
+
+		/// 减绿逆变换：红、蓝通道加上绿色（原地）
+		void (*addGreenToBlueAndRed)(uint32_t* argb, size_t count);
+
+		/// 颜色逆变换（原地）
+		void (*transformColorInverse)(const ColorMultipliers& multipliers, uint32_t* argb, size_t count);
+
+		/// ARGB 行转换为 RGBA 字节
+		void (*argbToRgba)(const uint32_t* argb, size_t count, uint8_t* rgba);
+	};
+
+	/**
+	 * @brief 当前 CPU 上最快的内核
+	 */
+	const DspKernels& kernels() noexcept;
+
+	/**
+	 * @brief 指定实现的内核（不可用时回退到标量实现）
+	 */
+	const DspKernels& kernels(DspBackend backend) noexcept;
+
+} // namespace shine::image::vp8l_dsp
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 #include <expected>
@@ -44,6 +45,23 @@ namespace shine::image
 		uint32_t loopCount = 0;        ///< 循环次数 (0 = 无限循环)
 		uint32_t canvasWidth = 0;      ///< 画布宽度
 		uint32_t canvasHeight = 0;    ///< 画布高度
+		uint32_t backgroundColor = 0; ///< 建议的背景色（BGRA 字节序，合成时不使用）
+	};
+
+	/**
+	 * @brief 动画帧信息（ANMF 块）
+	 */
+	struct WebPFrameInfo
+	{
+		uint32_t x = 0;                    ///< 帧在画布上的水平偏移（像素）
+		uint32_t y = 0;                    ///< 帧在画布上的竖直偏移（像素）
+		uint32_t width = 0;                ///< 帧宽度
+		uint32_t height = 0;               ///< 帧高度
+		uint32_t duration = 0;             ///< 显示时长（毫秒）
+		bool blend = true;                 ///< 与画布做 alpha 混合，否则直接覆盖帧区域
+		bool disposeToBackground = false;  ///< 显示后把帧区域清为透明
+		bool hasAlpha = false;             ///< 帧数据包含 alpha
+		bool keyFrame = false;             ///< 合成结果不依赖之前的帧
 	};
 
 	// ============================================================================
@@ -155,6 +173,26 @@ namespace shine::image
 		// 公共接口：图像解码
 		// ========================================================================
 
+		/**
+		 * @brief 启用或关闭多线程有损解码（默认启用）
+		 *
+		 * VP8 的熵解码与重建只能按宏块顺序进行，由调用线程完成；环路滤波和 YUV -> RGBA 转换
+		 * 按宏块行交给 util::ThreadPool，以波前方式紧跟在重建之后。结果与串行解码逐字节一致。
+		 *
+		 * @param enable 是否启用
+		 * @param minPixels 启用多线程的最小像素数，小图像的调度开销大于收益
+		 */
+		void setParallelDecode(bool enable, size_t minPixels = 512 * 512) noexcept
+		{
+			_parallelDecode = enable;
+			_parallelMinPixels = minPixels;
+		}
+
+		/**
+		 * @brief 是否启用了多线程有损解码
+		 */
+		bool isParallelDecode() const noexcept { return _parallelDecode; }
+
 		/**
 		 * @brief 解码 WebP 图像数据为 RGBA 格式
 		 * 
@@ -221,6 +259,38 @@ namespace shine::image
 		 */
 		const WebPAnimationInfo& getAnimationInfo() const noexcept { return animationInfo; }
 
+		// ========================================================================
+		// 公共接口：动画
+		// ========================================================================
+
+		/**
+		 * @brief 获取所有动画帧的信息
+		 * @return 帧信息（静态图像为空）
+		 */
+		std::span<const WebPFrameInfo> getFrames() const noexcept { return _frames; }
+
+		/**
+		 * @brief 解码并合成一帧动画
+		 *
+		 * 按 ANMF 的混合与处置方式把帧叠加到前一帧的画布上（初始画布为全透明，与 libwebp 的
+		 * WebPAnimDecoder 一致），返回整张画布的 RGBA 数据。
+		 *
+		 * 不需要逐帧预先解码：合成从最近的可用起点开始，依次为缓存中的帧、检查点、关键帧
+		 * （覆盖整个画布且不依赖之前内容的帧）。顺序播放时每次只解码一帧，随机跳转最多重放
+		 * checkpointInterval 帧。返回的画布在缓存淘汰后仍然有效。
+		 *
+		 * @param index 帧序号
+		 * @return 画布 RGBA 数据（canvasWidth * canvasHeight * 4 字节），失败返回错误信息
+		 */
+		std::expected<std::shared_ptr<const std::vector<uint8_t>>, std::string> decodeFrame(uint32_t index);
+
+		/**
+		 * @brief 设置合成帧缓存（会清空已缓存的帧）
+		 * @param capacity 最多保留的最近使用帧数（至少 1）
+		 * @param checkpointInterval 距关键帧每隔多少帧额外保存一张画布作为跳转起点，0 表示不保存
+		 */
+		void setFrameCache(size_t capacity, uint32_t checkpointInterval = 16);
+
 	private:
 		// ========================================================================
 		// 私有接口：WebP 解码核心实现
@@ -258,7 +328,8 @@ namespace shine::image
 		 * @param output 输出缓冲区（RGBA 格式）
 		 * @return 成功返回 void，失败返回错误信息
 		 */
-		std::expected<void, std::string> decodeVP8L(const uint8_t* data, size_t size, std::vector<uint8_t>& output);
+		std::expected<void, std::string> decodeVP8L(const uint8_t* data, size_t size, uint32_t width, uint32_t height,
+			std::vector<uint8_t>& output);
 
 		/**
 		 * @brief 解码 VP8 有损格式
@@ -267,7 +338,8 @@ namespace shine::image
 		 * @param output 输出缓冲区（RGBA 格式）
 		 * @return 成功返回 void，失败返回错误信息
 		 */
-		std::expected<void, std::string> decodeVP8(const uint8_t* data, size_t size, std::vector<uint8_t>& output);
+		std::expected<void, std::string> decodeVP8(const uint8_t* data, size_t size, uint32_t width, uint32_t height,
+			std::vector<uint8_t>& output);
 
 		/**
 		 * @brief 解码 ALPH Alpha 通道块
@@ -276,7 +348,34 @@ namespace shine::image
 		 * @param output 输出缓冲区（Alpha 通道数据）
 		 * @return 成功返回 void，失败返回错误信息
 		 */
-		std::expected<void, std::string> decodeALPH(const uint8_t* data, size_t size, std::vector<uint8_t>& output);
+		std::expected<void, std::string> decodeALPH(const uint8_t* data, size_t size, uint32_t width, uint32_t height,
+			std::vector<uint8_t>& output);
+
+		/**
+		 * @brief 解码一组图像块（可选的 ALPH + VP8，或 VP8L）
+		 * @param data 第一个子块的块头
+		 * @param size 数据大小
+		 * @param width 图像宽度
+		 * @param height 图像高度
+		 * @param output 输出缓冲区（RGBA 格式，width * height * 4 字节）
+		 * @return 成功返回 void，失败返回错误信息
+		 */
+		std::expected<void, std::string> decodeImageChunks(const uint8_t* data, size_t size, uint32_t width, uint32_t height,
+			std::vector<uint8_t>& output);
+
+		/**
+		 * @brief 把一帧合成到画布上
+		 * @param index 帧序号
+		 * @param canvas 前一帧的画布（关键帧时内容无关），合成后为本帧画布
+		 * @param scratch 帧像素的临时缓冲
+		 * @return 成功返回 void，失败返回错误信息
+		 */
+		std::expected<void, std::string> compositeFrame(uint32_t index, std::vector<uint8_t>& canvas, std::vector<uint8_t>& scratch);
+
+		/**
+		 * @brief 计算每帧是否为关键帧及其所属关键帧（解析完 ANMF 后调用）
+		 */
+		void computeKeyFrames();
 
 		// ========================================================================
 		// 成员变量：基本图像信息
@@ -292,6 +391,9 @@ namespace shine::image
 		bool _hasAlpha = false;        ///< 是否包含 Alpha 通道
 		bool _hasAnimation = false;    ///< 是否包含动画
 
+		bool _parallelDecode = true;             ///< 是否启用多线程有损解码
+		size_t _parallelMinPixels = 512 * 512;   ///< 启用多线程有损解码的最小像素数
+
 		// ========================================================================
 		// 成员变量：图像数据
 		// ========================================================================
@@ -306,6 +408,38 @@ namespace shine::image
 		std::vector<uint8_t> iccProfile;     ///< ICC 色彩配置文件
 		std::vector<uint8_t> exifData;       ///< EXIF 元数据
 		WebPAnimationInfo animationInfo;      ///< 动画信息
+
+		// ========================================================================
+		// 成员变量：动画帧
+		// ========================================================================
+
+		/**
+		 * @brief ANMF 帧数据在原始文件中的位置
+		 */
+		struct FrameChunk
+		{
+			size_t offset = 0;          ///< 帧数据（第一个子块）的偏移
+			size_t size = 0;            ///< 帧数据大小
+			uint32_t keyFrameIndex = 0; ///< 合成时最近的关键帧
+		};
+
+		/**
+		 * @brief 缓存的合成帧
+		 */
+		struct CachedFrame
+		{
+			uint32_t index = 0;
+			uint64_t lastUse = 0;
+			std::shared_ptr<const std::vector<uint8_t>> canvas;
+		};
+
+		std::vector<WebPFrameInfo> _frames;         ///< 动画帧信息
+		std::vector<FrameChunk> _frameChunks;       ///< 与 _frames 一一对应
+		std::vector<CachedFrame> _frameCache;       ///< 最近使用的合成帧（LRU）
+		std::vector<std::shared_ptr<const std::vector<uint8_t>>> _checkpoints;  ///< 检查点画布，按帧序号索引
+		size_t _frameCacheCapacity = 8;             ///< LRU 缓存容量
+		uint32_t _checkpointInterval = 16;          ///< 检查点间隔（帧）
+		uint64_t _frameCacheClock = 0;              ///< LRU 计时
 	};
 
 } // namespace shine::image
@@ -3,6 +3,7 @@
 #include "image/jpeg.h"
 #include "image/webp.h"
 #include "image/Texture.h"
+#include "image/cooked_texture.h"
 #include "loader/model/gltfLoader.h"
 #include "loader/model/objLoader.h"
 #include "fmt/format.h"
@@ -195,6 +196,68 @@ namespace shine::manager
         return texture;
     }
 
+    bool AssetManager::CookTexture(const std::string& sourcePath, const std::string& cookedPath,
+        const image::cooked::CookOptions& options)
+    {
+        shine::util::FunctionTimer timer("AssetManager::CookTexture", shine::util::TimerPrecision::Nanoseconds);
+
+        // 源文件哈希与选项哈希写入文件头，两者一致时复用已有的烘焙文件
+#ifndef SHINE_PLATFORM_WASM
+        auto sourceBytes = util::read_file_bytes(std::string_view(sourcePath));
+        if (!sourceBytes.has_value())
+        {
+            fmt::print("AssetManager: 读取源图片失败: {} - {}\n", sourcePath, sourceBytes.error());
+            return false;
+        }
+        const uint64_t sourceHash = image::cooked::hashBytes(sourceBytes->data(), sourceBytes->size());
+#else
+        bool success = false;
+        std::vector<std::byte> sourceBytes = util::read_file_bytes(std::string_view(sourcePath), &success);
+        if (!success)
+        {
+            fmt::print("AssetManager: 读取源图片失败: {}\n", sourcePath);
+            return false;
+        }
+        const uint64_t sourceHash = image::cooked::hashBytes(sourceBytes.data(), sourceBytes.size());
+#endif
+
+        if (auto existing = image::cooked::CookedTexture::open(cookedPath); existing.has_value() &&
+            existing->sourceHash() == sourceHash && existing->optionsHash() == image::cooked::hashOptions(options))
+        {
+            return true;
+        }
+
+        // 借用已有的解码路径；本次新加载的资源在烘焙后卸载
+        const bool wasLoaded = GetAssetHandleByPath(sourcePath).isValid();
+        auto assetHandle = LoadTextureAsset(sourcePath);
+        if (!assetHandle.isValid())
+        {
+            return false;
+        }
+
+        const auto* loader = GetImageLoader(assetHandle);
+        image::cooked::CookOptions cookOptions = options;
+        cookOptions.sourceHash = sourceHash;
+        auto cooked = image::cooked::cook(loader->getImageData().data(), loader->getWidth(), loader->getHeight(),
+            cookOptions);
+        if (!wasLoaded)
+        {
+            UnloadAsset(assetHandle);
+        }
+        if (!cooked.has_value())
+        {
+            fmt::print("AssetManager: 烘焙纹理失败: {} - {}\n", sourcePath, cooked.error());
+            return false;
+        }
+
+        if (!util::SaveData(SString::from_utf8(cookedPath), cooked->data(), cooked->size()))
+        {
+            fmt::print("AssetManager: 写入烘焙纹理失败: {}\n", cookedPath);
+            return false;
+        }
+        return true;
+    }
+
     AssetHandle AssetManager::LoadModel(const std::string& filePath)
     {
         shine::util::FunctionTimer timer("AssetManager::LoadModel", shine::util::TimerPrecision::Nanoseconds);
@@ -19,6 +19,11 @@ namespace shine::image
     class STexture;
 }
 
+namespace shine::image::cooked
+{
+    struct CookOptions;
+}
+
 namespace shine::manager
 {
     /**
@@ -101,6 +106,18 @@ namespace shine::manager
          */
         std::shared_ptr<image::STexture> LoadTexture(const std::string& filePath);
 
+        /**
+         * @brief 导入图片并烘焙为 .stex（解码、生成 mip、可选块压缩后写入文件）
+         * 已有烘焙文件的源文件哈希与烘焙选项哈希均一致时跳过；
+         * 这是手动调用的导入接口（编辑器/构建脚本），运行时加载 .stex 走 TextureManager::CreateTextureFromFile
+         * @param sourcePath 源图片路径
+         * @param cookedPath 输出的 .stex 路径
+         * @param options 烘焙选项（sourceHash 由本函数填写）
+         * @return 成功返回true
+         */
+        bool CookTexture(const std::string& sourcePath, const std::string& cookedPath,
+            const image::cooked::CookOptions& options);
+
         // ========================================================================
         // 模型资源管理
         // ========================================================================
@@ -0,0 +1,229 @@
+#ifdef SHINE_USE_MODULE
+module shine.memory.frame;
+import <atomic>;
+import <mutex>;
+import <vector>;
+import shine.memory;
+#endif
+
+
+
+#ifndef SHINE_USE_MODULE
+#include "frame_allocator.ixx"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace shine::co {
+
+    namespace {
+
+        constexpr size_t kChunkAlign = 64;
+        constexpr size_t kChunkHeaderSize = 64;      // header padded to a cache line
+        constexpr uint32_t kThreadSpareLimit = 4;    // chunks a thread keeps for itself
+
+        struct Chunk {
+            Chunk* next;
+            size_t capacity;  // usable bytes after the header
+
+            char* Begin() noexcept { return reinterpret_cast<char*>(this) + kChunkHeaderSize; }
+            char* End() noexcept { return Begin() + capacity; }
+        };
+
+        std::atomic<size_t> g_reservedBytes{0};
+        std::atomic<uint32_t> g_chunkCount{0};
+
+        // Chunks of exited threads (and overflow from busy ones). A chunk left behind by a
+        // thread may still be read until its frame has cycled out.
+        struct SharedChunks {
+            struct Entry {
+                Chunk* chunk;
+                uint64_t reusableFrom;
+            };
+            std::mutex mutex;
+            std::vector<Entry> entries;
+        };
+
+        // Leaked on purpose so thread_local arenas can still return chunks during shutdown
+        SharedChunks& Shared() {
+            static SharedChunks* shared = new SharedChunks();
+            return *shared;
+        }
+
+        Chunk* NewChunk(size_t capacity) noexcept {
+            MemoryScope scope(MemoryTag::Core);
+            void* p = Memory::Alloc(kChunkHeaderSize + capacity, kChunkAlign);
+            if (!p) return nullptr;
+            g_reservedBytes.fetch_add(kChunkHeaderSize + capacity, std::memory_order_relaxed);
+            g_chunkCount.fetch_add(1, std::memory_order_relaxed);
+            return ::new (p) Chunk{ nullptr, capacity };
+        }
+
+        void DeleteChunk(Chunk* chunk) noexcept {
+            g_reservedBytes.fetch_sub(kChunkHeaderSize + chunk->capacity, std::memory_order_relaxed);
+            g_chunkCount.fetch_sub(1, std::memory_order_relaxed);
+            Memory::Free(chunk);
+        }
+
+        void ShareChunk(Chunk* chunk, uint64_t reusableFrom) {
+            SharedChunks& shared = Shared();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.entries.push_back({ chunk, reusableFrom });
+        }
+
+        char* AlignUp(char* p, size_t align) noexcept {
+            const uintptr_t value = reinterpret_cast<uintptr_t>(p);
+            return reinterpret_cast<char*>((value + align - 1) & ~(uintptr_t)(align - 1));
+        }
+
+        // One buffered frame of one thread
+        struct FrameBuffer {
+            uint64_t frame = ~0ull;
+            Chunk* chunks = nullptr;  // newest first; the cursor runs through the head
+            char* cursor = nullptr;
+            char* end = nullptr;
+        };
+
+        struct ThreadArena {
+            FrameBuffer buffers[kFrameBufferCount];
+            Chunk* spare = nullptr;
+            uint32_t spareCount = 0;
+
+            ~ThreadArena() {
+                for (FrameBuffer& buffer : buffers) {
+                    while (Chunk* chunk = buffer.chunks) {
+                        buffer.chunks = chunk->next;
+                        if (chunk->capacity == FrameAllocator::kChunkSize) ShareChunk(chunk, buffer.frame + kFrameBufferCount);
+                        else DeleteChunk(chunk);  // oversized chunks are never reused, see Release
+                    }
+                }
+                while (Chunk* chunk = spare) {
+                    spare = chunk->next;
+                    ShareChunk(chunk, 0);
+                }
+            }
+
+            // The buffer for the current frame, recycled first if it still holds an old frame
+            FrameBuffer& Current() noexcept {
+                const uint64_t frame = FrameAllocator::GetFrameIndex();
+                FrameBuffer& buffer = buffers[frame % kFrameBufferCount];
+                if (buffer.frame != frame) {
+                    ReleaseUntil(buffer, nullptr);
+                    buffer.frame = frame;
+                }
+                return buffer;
+            }
+
+            // Pop chunks off `buffer` until `keep` is the head again
+            void ReleaseUntil(FrameBuffer& buffer, Chunk* keep) noexcept {
+                while (buffer.chunks != keep) {
+                    Chunk* chunk = buffer.chunks;
+                    buffer.chunks = chunk->next;
+                    Release(chunk);
+                }
+                buffer.cursor = keep ? keep->Begin() : nullptr;
+                buffer.end = keep ? keep->End() : nullptr;
+            }
+
+            void Release(Chunk* chunk) noexcept {
+                if (chunk->capacity != FrameAllocator::kChunkSize) {
+                    DeleteChunk(chunk);
+                } else if (spareCount < kThreadSpareLimit) {
+                    chunk->next = spare;
+                    spare = chunk;
+                    ++spareCount;
+                } else {
+                    ShareChunk(chunk, 0);
+                }
+            }
+
+            Chunk* AcquireStandard() noexcept {
+                if (Chunk* chunk = spare) {
+                    spare = chunk->next;
+                    --spareCount;
+                    return chunk;
+                }
+                {
+                    const uint64_t frame = FrameAllocator::GetFrameIndex();
+                    SharedChunks& shared = Shared();
+                    std::lock_guard<std::mutex> lock(shared.mutex);
+                    for (size_t i = shared.entries.size(); i-- > 0;) {
+                        if (shared.entries[i].reusableFrom <= frame) {
+                            Chunk* chunk = shared.entries[i].chunk;
+                            shared.entries[i] = shared.entries.back();
+                            shared.entries.pop_back();
+                            return chunk;
+                        }
+                    }
+                }
+                return NewChunk(FrameAllocator::kChunkSize);
+            }
+
+            void* AllocSlow(FrameBuffer& buffer, size_t size, size_t align) noexcept {
+                // Worst-case padding at the chunk start is align - kChunkAlign for larger alignments
+                const size_t needed = size + (align > kChunkAlign ? align : 0);
+                Chunk* chunk = needed <= FrameAllocator::kChunkSize ? AcquireStandard() : NewChunk(needed);
+                if (!chunk) return nullptr;
+
+                chunk->next = buffer.chunks;
+                buffer.chunks = chunk;
+                char* p = AlignUp(chunk->Begin(), align);
+                buffer.cursor = p + size;
+                buffer.end = chunk->End();
+                return p;
+            }
+        };
+
+        thread_local ThreadArena t_arena;
+
+    } // namespace
+
+    // ============================================================
+    // FrameAllocator Implementation
+    // ============================================================
+
+    void FrameAllocator::BeginFrame() noexcept {
+        g_frameContext.frame_index.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    void* FrameAllocator::Alloc(size_t size, size_t align) noexcept {
+        if (size == 0) size = 1;
+        FrameBuffer& buffer = t_arena.Current();
+        if (buffer.cursor) {
+            char* p = AlignUp(buffer.cursor, align);
+            if (p + size <= buffer.end) {
+                buffer.cursor = p + size;
+                return p;
+            }
+        }
+        return t_arena.AllocSlow(buffer, size, align);
+    }
+
+    FrameAllocatorStats FrameAllocator::GetStats() noexcept {
+        return {
+            g_reservedBytes.load(std::memory_order_relaxed),
+            g_chunkCount.load(std::memory_order_relaxed)
+        };
+    }
+
+    // ============================================================
+    // FrameScope Implementation
+    // ============================================================
+
+    FrameScope::FrameScope() noexcept {
+        FrameBuffer& buffer = t_arena.Current();
+        _frame = buffer.frame;
+        _chunk = buffer.chunks;
+        _cursor = buffer.cursor;
+    }
+
+    FrameScope::~FrameScope() noexcept {
+        FrameBuffer& buffer = t_arena.buffers[_frame % kFrameBufferCount];
+        // The frame moved on meanwhile; the whole buffer is recycled anyway
+        if (buffer.frame != _frame) return;
+        t_arena.ReleaseUntil(buffer, static_cast<Chunk*>(_chunk));
+        buffer.cursor = _cursor;
+    }
+
+} // namespace shine::co
@@ -0,0 +1,134 @@
+#ifdef SHINE_USE_MODULE
+
+export module shine.memory.frame;
+
+import <cstddef>;
+import <cstdint>;
+import <new>;
+import <type_traits>;
+import <utility>;
+import <vector>;
+import shine.memory;
+
+#else
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "memory.ixx"
+
+#endif
+
+
+
+namespace shine::co {
+
+    // ============================================================
+    // FrameAllocator
+    // ============================================================
+
+    // Frames a frame allocation survives: the frame it was made in plus the two frames that
+    // may still be in flight (render / GPU) when the next one starts
+    SHINE_MODULE_EXPORT inline constexpr uint32_t kFrameBufferCount = 3;
+
+    struct FrameAllocatorStats {
+        size_t   reserved_bytes;  // chunk memory held by every thread, in use or spare
+        uint32_t chunk_count;
+    };
+
+    // Per-frame linear allocator.
+    //
+    // Every thread bumps a pointer through its own 64KB chunks, one chunk list per buffered
+    // frame. Nothing is freed individually: when frame_index advances, the first allocation a
+    // thread makes in the new frame recycles the chunks it used kFrameBufferCount frames ago.
+    // Memory returned in frame N stays valid until BeginFrame() has been called
+    // kFrameBufferCount times after it, on every thread.
+    //
+    // Only trivially destructible data belongs here; destructors never run.
+    SHINE_MODULE_EXPORT class FrameAllocator {
+    public:
+        static constexpr size_t kChunkSize = 64 * 1024;
+
+        // Advance g_frameContext.frame_index (main loop, once per frame)
+        static void BeginFrame() noexcept;
+
+        static uint64_t GetFrameIndex() noexcept {
+            return g_frameContext.frame_index.load(std::memory_order_acquire);
+        }
+
+        // nullptr only if the backing chunk allocation fails
+        static void* Alloc(size_t size, size_t align = alignof(std::max_align_t)) noexcept;
+
+        template<typename T, typename... Args>
+        static T* New(Args&&... args) {
+            static_assert(std::is_trivially_destructible_v<T>, "frame memory never runs destructors");
+            void* p = Alloc(sizeof(T), alignof(T));
+            return p ? ::new (p) T(std::forward<Args>(args)...) : nullptr;
+        }
+
+        // Value-initialised array
+        template<typename T>
+        static T* NewArray(size_t count) {
+            static_assert(std::is_trivially_destructible_v<T>, "frame memory never runs destructors");
+            void* p = Alloc(sizeof(T) * count, alignof(T));
+            return p ? ::new (p) T[count]() : nullptr;
+        }
+
+        static FrameAllocatorStats GetStats() noexcept;
+    };
+
+    // ============================================================
+    // FrameScope (RAII rewind)
+    // ============================================================
+
+    // Marks the calling thread's frame cursor; frame allocations made inside the scope are
+    // handed back when it ends, so scratch built in a hot loop doesn't accumulate over the
+    // frame. Nothing allocated inside may outlive the scope, including allocations made by
+    // jobs this thread runs while the scope is open.
+    SHINE_MODULE_EXPORT class FrameScope {
+    public:
+        FrameScope() noexcept;
+        ~FrameScope() noexcept;
+
+        FrameScope(const FrameScope&) = delete;
+        FrameScope& operator=(const FrameScope&) = delete;
+
+    private:
+        uint64_t _frame;
+        void*    _chunk;
+        char*    _cursor;
+    };
+
+    // ============================================================
+    // FrameVector
+    // ============================================================
+
+    // deallocate is a no-op: growth leaves the old block behind until the frame recycles
+    SHINE_MODULE_EXPORT template<typename T>
+    struct FrameStlAllocator {
+        using value_type = T;
+
+        FrameStlAllocator() noexcept = default;
+        template<typename U>
+        FrameStlAllocator(const FrameStlAllocator<U>&) noexcept {}
+
+        T* allocate(size_t count) {
+            void* p = FrameAllocator::Alloc(sizeof(T) * count, alignof(T));
+            if (!p) throw std::bad_alloc();
+            return static_cast<T*>(p);
+        }
+
+        void deallocate(T*, size_t) noexcept {}
+
+        template<typename U>
+        bool operator==(const FrameStlAllocator<U>&) const noexcept { return true; }
+    };
+
+    SHINE_MODULE_EXPORT template<typename T>
+    using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+
+} // namespace shine::co
@@ -80,7 +80,7 @@ namespace shine::co {
         if (stats.pending_alloc_count > 0) {
             global.alloc_count.fetch_add(stats.pending_alloc_count, std::memory_order_relaxed);
             global.allocs_this_frame.fetch_add((uint32_t)stats.pending_alloc_count, std::memory_order_relaxed);
-            global.last_alloc_frame.store(g_frameContext.frame_index, std::memory_order_relaxed);
+            global.last_alloc_frame.store(g_frameContext.frame_index.load(std::memory_order_relaxed), std::memory_order_relaxed);
         }
 
         if (stats.pending_free_bytes > 0) {
@@ -90,7 +90,7 @@ namespace shine::co {
         if (stats.pending_free_count > 0) {
             global.free_count.fetch_add(stats.pending_free_count, std::memory_order_relaxed);
             global.frees_this_frame.fetch_add((uint32_t)stats.pending_free_count, std::memory_order_relaxed);
-            global.last_free_frame.store(g_frameContext.frame_index, std::memory_order_relaxed);
+            global.last_free_frame.store(g_frameContext.frame_index.load(std::memory_order_relaxed), std::memory_order_relaxed);
         }
 
         // Reset
@@ -101,6 +101,8 @@ namespace shine::co {
     }
 
     static void UpdateAllocStats(MemoryTag tag, size_t size) {
+        detail::CountTimelineAlloc(tag, size);
+
         auto& stats = g_tlsTagStats[(size_t)tag];
         stats.pending_alloc_bytes += size;
         stats.pending_alloc_count++;
@@ -112,6 +114,8 @@ namespace shine::co {
     }
 
     static void UpdateFreeStats(MemoryTag tag, size_t size) {
+        detail::CountTimelineFree(tag, size);
+
         auto& stats = g_tlsTagStats[(size_t)tag];
         stats.pending_free_bytes += size;
         stats.pending_free_count++;
@@ -122,6 +126,95 @@ namespace shine::co {
         }
     }
 
+    // ============================================================
+    // Per-tag Arenas (header-free mode)
+    // ============================================================
+
+    struct TagArena {
+        mi_arena_id_t id = 0;
+        uintptr_t begin = 0;
+        uintptr_t end = 0;
+    };
+
+    // Written once by EnableHeaderFree before g_headerFree is published
+    static TagArena g_tagArenas[(size_t)MemoryTag::Count];
+    static uintptr_t g_arenaLow = 0;
+    static uintptr_t g_arenaHigh = 0;
+    static std::atomic<bool> g_headerFree{false};
+
+    // mimalloc heaps belong to one thread, so each thread creates its own heap per tag.
+    // The pointers are plain thread_locals so they stay readable while other thread_local
+    // destructors run; once the guard is gone the thread falls back to the header path,
+    // and mimalloc deletes the heaps itself when the thread exits.
+    enum class HeapState : uint8_t { Unset, Live, Dead };
+
+    thread_local mi_heap_t* t_tagHeaps[(size_t)MemoryTag::Count] = {};
+    thread_local HeapState t_heapState = HeapState::Unset;
+
+    struct ThreadHeapGuard {
+        void Touch() noexcept { t_heapState = HeapState::Live; }
+        ~ThreadHeapGuard() {
+            t_heapState = HeapState::Dead;
+            for (mi_heap_t*& heap : t_tagHeaps) heap = nullptr;
+        }
+    };
+
+    thread_local ThreadHeapGuard t_heapGuard;
+
+    static mi_heap_t* TagHeap(MemoryTag tag) noexcept {
+        mi_heap_t*& heap = t_tagHeaps[(size_t)tag];
+        if (heap) return heap;
+        if (t_heapState == HeapState::Dead) return nullptr;
+        if (t_heapState == HeapState::Unset) t_heapGuard.Touch();
+        heap = mi_heap_new_in_arena(g_tagArenas[(size_t)tag].id);
+        return heap;
+    }
+
+    // Tag of a header-free block, or -1 for blocks carrying an AllocationHeader
+    static int ArenaTagOf(const void* p) noexcept {
+        if (!g_headerFree.load(std::memory_order_acquire)) return -1;
+        const uintptr_t addr = reinterpret_cast<uintptr_t>(p);
+        if (addr < g_arenaLow || addr >= g_arenaHigh) return -1;
+        for (size_t i = 0; i < (size_t)MemoryTag::Count; ++i) {
+            if (addr >= g_tagArenas[i].begin && addr < g_tagArenas[i].end) return (int)i;
+        }
+        return -1;
+    }
+
+    bool Memory::EnableHeaderFree(size_t reservePerTag) noexcept {
+        static const bool enabled = [reservePerTag] {
+            uintptr_t low = UINTPTR_MAX;
+            uintptr_t high = 0;
+            for (TagArena& arena : g_tagArenas) {
+                // Reserved only; pages are committed as the heaps grow
+                if (mi_reserve_os_memory_ex(reservePerTag, false, false, true, &arena.id) != 0) return false;
+                size_t size = 0;
+                void* start = mi_arena_area(arena.id, &size);
+                if (!start) return false;
+                arena.begin = reinterpret_cast<uintptr_t>(start);
+                arena.end = arena.begin + size;
+                low = std::min(low, arena.begin);
+                high = std::max(high, arena.end);
+            }
+            g_arenaLow = low;
+            g_arenaHigh = high;
+            g_headerFree.store(true, std::memory_order_release);
+            return true;
+        }();
+        return enabled;
+    }
+
+    bool Memory::IsHeaderFree() noexcept {
+        return g_headerFree.load(std::memory_order_relaxed);
+    }
+
+    size_t Memory::UsableSize(const void* p) noexcept {
+        if (!p) return 0;
+        if (ArenaTagOf(p) >= 0) return mi_usable_size(p);
+        auto* header = reinterpret_cast<const AllocationHeader*>(static_cast<const char*>(p) - sizeof(AllocationHeader));
+        return mi_usable_size(static_cast<const char*>(p) - header->offset) - header->offset;
+    }
+
     // ============================================================
     // Memory Implementation
     // ============================================================
@@ -147,7 +240,20 @@ namespace shine::co {
         // To minimize waste, we want smallest padding.
         // But we can just force the offset to be a multiple of align.
         
-        size_t headerSize = sizeof(AllocationHeader);
+        const bool tracked = detail::g_trackingEnabled.load(std::memory_order_relaxed);
+
+        // Header-free: the tag is implied by the arena the block comes from
+        if (!tracked && g_headerFree.load(std::memory_order_acquire)) {
+            const MemoryTag tag = g_tlsMemoryTag;
+            if (mi_heap_t* heap = TagHeap(tag)) {
+                if (void* p = mi_heap_malloc_aligned(heap, size, align)) {
+                    UpdateAllocStats(tag, mi_usable_size(p));
+                    return p;
+                }
+            }
+        }
+
+        size_t headerSize = sizeof(AllocationHeader) + (tracked ? sizeof(AllocationSiteHeader) : 0);
         size_t offset = (headerSize + align - 1) & ~(align - 1); // Align up header size
         
         // Ensure the allocation is also aligned to the header requirements
@@ -187,14 +293,25 @@ namespace shine::co {
         // header->pad is not needed to be set.
 
         UpdateAllocStats((MemoryTag)header->tag, size);
-        
-        (void)loc; 
+
+        if (tracked) {
+            auto* site = reinterpret_cast<AllocationSiteHeader*>(reinterpret_cast<char*>(header) - sizeof(AllocationSiteHeader));
+            site->site = detail::TrackSiteAlloc(loc, size);
+            header->tag |= kTrackedTagBit;
+        }
+
         return userPtr;
     }
 
     void Memory::Free(void* p) noexcept {
         if (!p) return;
 
+        if (const int arenaTag = ArenaTagOf(p); arenaTag >= 0) {
+            UpdateFreeStats((MemoryTag)arenaTag, mi_usable_size(p));
+            mi_free(p);
+            return;
+        }
+
         // We need to recover the header.
         // But wait, where is the header?
         // In Alloc, we did: userPtr = p_raw + offset.
@@ -205,10 +322,15 @@ namespace shine::co {
         auto* header = reinterpret_cast<AllocationHeader*>(static_cast<char*>(p) - sizeof(AllocationHeader));
         
         size_t size = header->size;
-        MemoryTag tag = (MemoryTag)header->tag;
+        MemoryTag tag = (MemoryTag)(header->tag & ~kTrackedTagBit);
         
         UpdateFreeStats(tag, size);
 
+        if (header->tag & kTrackedTagBit) {
+            auto* site = reinterpret_cast<AllocationSiteHeader*>(reinterpret_cast<char*>(header) - sizeof(AllocationSiteHeader));
+            detail::TrackSiteFree(site->site, size);
+        }
+
         // Now we need to free the RAW pointer.
         // raw = userPtr - offset.
         // But we don't know offset because we don't know align!
@@ -266,8 +388,13 @@ namespace shine::co {
             return nullptr;
         }
 
-        auto* header = reinterpret_cast<AllocationHeader*>(static_cast<char*>(p) - sizeof(AllocationHeader));
-        size_t oldSize = header->size;
+        size_t oldSize;
+        if (ArenaTagOf(p) >= 0) {
+            oldSize = mi_usable_size(p);
+        } else {
+            auto* header = reinterpret_cast<AllocationHeader*>(static_cast<char*>(p) - sizeof(AllocationHeader));
+            oldSize = header->size;
+        }
         
         // Optimization: if newSize <= oldSize, just return p?
         // Or shrink?
@@ -296,6 +423,14 @@ namespace shine::co {
         return newPtr;
     }
 
+    void Memory::TrackAlloc(MemoryTag tag, size_t size) noexcept {
+        UpdateAllocStats(tag, size);
+    }
+
+    void Memory::TrackFree(MemoryTag tag, size_t size) noexcept {
+        UpdateFreeStats(tag, size);
+    }
+
     MemoryTagStats Memory::GetTagStats(MemoryTag tag) noexcept {
         auto& s = g_tagStats[(size_t)tag];
         return {
@@ -358,7 +493,7 @@ namespace shine::co {
 
             std::printf(
                 "[Memory][Frame %llu][%s] allocs=%u current=%.2fMB\n",
-                (unsigned long long)g_frameContext.frame_index,
+                (unsigned long long)g_frameContext.frame_index.load(std::memory_order_relaxed),
                 g_memoryTagNames[i],
                 allocs,
                 double(s.bytes_current.load()) / (1024.0 * 1024.0)
@@ -9,6 +9,7 @@ import <algorithm>;
 import <cstdio>;
 import <cstring>;
 import <source_location>;
+import <vector>;
 
 #else
 
@@ -21,6 +22,7 @@ import <source_location>;
 #include <cstdio>
 #include <cstring>
 #include <source_location>
+#include <vector>
 
 #endif
 
@@ -33,7 +35,8 @@ namespace shine::co {
     // ============================================================
 
     struct FrameContext {
-        uint64_t frame_index = 0;
+        // Advanced once per frame by FrameAllocator::BeginFrame; read from any thread
+        std::atomic<uint64_t> frame_index{0};
     };
 
     SHINE_MODULE_EXPORT extern FrameContext g_frameContext;
@@ -88,10 +91,19 @@ namespace shine::co {
 
     struct AllocationHeader {
         uint32_t size;
-        uint16_t tag;
+        uint16_t tag;    // MemoryTag, plus kTrackedTagBit when a site header precedes this one
         uint16_t offset; // Offset from raw pointer to user pointer
     };
 
+    // Set in AllocationHeader::tag for allocations made while call-site tracking was on
+    inline constexpr uint16_t kTrackedTagBit = 0x8000;
+
+    // Placed immediately before AllocationHeader for tracked allocations
+    struct AllocationSiteHeader {
+        uint32_t site;
+        uint32_t reserved;
+    };
+
     // Declarations
     SHINE_MODULE_EXPORT extern MemoryTagStatsAtomic g_tagStats[(size_t)MemoryTag::Count];
     SHINE_MODULE_EXPORT extern thread_local MemoryTag g_tlsMemoryTag;
@@ -143,6 +155,26 @@ namespace shine::co {
             const std::source_location& loc =
                 std::source_location::current()) noexcept;
 
+        // --------------------------------------------------------
+        // Header-free mode
+        // --------------------------------------------------------
+        // Reserve one mimalloc arena (address range) per MemoryTag and serve untracked
+        // allocations from per-thread heaps inside it: no AllocationHeader, and Free finds
+        // the tag from the range the pointer falls in. Call once, early in main. Blocks
+        // allocated before, while call-site tracking is on, or after a tag's arena fills
+        // up keep the header path, and both kinds can be freed at any time.
+        static bool EnableHeaderFree(size_t reservePerTag = size_t(1) << 30) noexcept;
+        static bool IsHeaderFree() noexcept;
+
+        // Bytes the block actually occupies in its mimalloc page (excluding any header)
+        static size_t UsableSize(const void* p) noexcept;
+
+        // --------------------------------------------------------
+        // External allocators (pools) that bypass Alloc / Free
+        // --------------------------------------------------------
+        static void TrackAlloc(MemoryTag tag, size_t size) noexcept;
+        static void TrackFree(MemoryTag tag, size_t size) noexcept;
+
         // --------------------------------------------------------
         // Stats
         // --------------------------------------------------------
@@ -152,4 +184,93 @@ namespace shine::co {
         static void DumpFrameSpikes(uint32_t allocThreshold = 64) noexcept;
     };
 
+    // ============================================================
+    // MemoryTracker (call-site tracking, opt-in)
+    // ============================================================
+
+    // Counters of one call site. In a snapshot they are totals; in a diff they are the change
+    // between the two snapshots (live_* may go negative).
+    struct CallSiteStats {
+        const char* file;
+        const char* function;
+        uint32_t    line;
+        int64_t     live_bytes;
+        int64_t     live_count;
+        uint64_t    alloc_count;
+        uint64_t    alloc_bytes;
+    };
+
+    struct CallSiteSnapshot {
+        uint64_t frame = 0;
+        std::vector<CallSiteStats> sites;  // indexed by site id, so two snapshots line up
+    };
+
+    // While enabled, Memory::Alloc records its source_location in a lock-free table of call
+    // sites, with counters sharded per thread. Only allocations made while tracking was on
+    // are counted, so enable it early (or diff snapshots) to find leaks. Allocations through
+    // global operator new all report the operator new call site.
+    SHINE_MODULE_EXPORT class MemoryTracker {
+    public:
+        static void SetEnabled(bool enabled) noexcept;
+        static bool IsEnabled() noexcept;
+
+        static CallSiteSnapshot Snapshot();
+
+        // newer - older, sites without activity dropped
+        static std::vector<CallSiteStats> Diff(const CallSiteSnapshot& older, const CallSiteSnapshot& newer);
+
+        // Once per frame: keeps the snapshots of this and the previous frame
+        static void EndFrame();
+
+        // Sites that allocated the most bytes between the last two EndFrame calls
+        static std::vector<CallSiteStats> TopThisFrame(size_t count);
+
+        // Print every site that still has live tracked allocations (call at shutdown)
+        static void DumpLeaks() noexcept;
+    };
+
+    // ============================================================
+    // MemoryTimeline (per-frame history)
+    // ============================================================
+
+    struct FrameTagSample {
+        int64_t  bytes_current;    // exact at the frame boundary
+        int64_t  bytes_peak;       // upper bound: bytes at frame start + bytes allocated in the frame
+        uint64_t bytes_allocated;
+        uint32_t allocs;
+        uint32_t frees;
+    };
+
+    struct FrameMemorySample {
+        uint64_t       frame;
+        float          frame_ms;   // wall time since the previous sample
+        FrameTagSample tags[(size_t)MemoryTag::Count];
+    };
+
+    // Ring of the last kCapacity frames. Every thread keeps running per-tag totals that only
+    // it writes; SampleFrame sums them (plus those of exited threads), so a sample is exact
+    // regardless of the batched g_tagStats flush thresholds.
+    SHINE_MODULE_EXPORT class MemoryTimeline {
+    public:
+        static constexpr size_t kCapacity = 4096;
+
+        // Once per frame from the main loop, after the frame's work
+        static void SampleFrame() noexcept;
+
+        // Oldest first; returns the number of samples written to `out`
+        static size_t CopyRecent(std::vector<FrameMemorySample>& out, size_t maxFrames);
+    };
+
+    namespace detail {
+        extern std::atomic<bool> g_trackingEnabled;
+
+        // Hooks used by the stats updates in Memory::Alloc / Free
+        void CountTimelineAlloc(MemoryTag tag, size_t size) noexcept;
+        void CountTimelineFree(MemoryTag tag, size_t size) noexcept;
+
+        // Hooks used by Memory::Alloc / Free
+        uint32_t TrackSiteAlloc(const std::source_location& loc, size_t size) noexcept;
+        void TrackSiteFree(uint32_t site, size_t size) noexcept;
+    }
+
 } // namespace shine::co
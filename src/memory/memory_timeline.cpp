@@ -0,0 +1,213 @@
+#ifdef SHINE_USE_MODULE
+module shine.memory;
+import <algorithm>;
+import <atomic>;
+import <chrono>;
+import <mutex>;
+import <thread>;
+import <vector>;
+#endif
+
+
+
+#ifndef SHINE_USE_MODULE
+#include "memory.ixx"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace shine::co {
+
+    namespace {
+
+        constexpr size_t kTagCount = (size_t)MemoryTag::Count;
+
+        // Running totals of one tag on one thread. Only the owning thread writes, so a
+        // relaxed load + store is enough and the hot path needs no locked instruction.
+        struct TagTotals {
+            std::atomic<uint64_t> alloc_bytes{0};
+            std::atomic<uint64_t> alloc_count{0};
+            std::atomic<uint64_t> free_bytes{0};
+            std::atomic<uint64_t> free_count{0};
+        };
+
+        struct ThreadTotals {
+            TagTotals tags[kTagCount];
+            ThreadTotals* prev = nullptr;
+            ThreadTotals* next = nullptr;
+        };
+
+        struct PlainTotals {
+            uint64_t alloc_bytes = 0;
+            uint64_t alloc_count = 0;
+            uint64_t free_bytes = 0;
+            uint64_t free_count = 0;
+        };
+
+        // A spin lock rather than std::mutex: it is taken from inside Memory::Alloc on a
+        // thread's first allocation and must stay usable during static destruction.
+        class SpinLock {
+        public:
+            void lock() noexcept {
+                while (flag_.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+            }
+            void unlock() noexcept { flag_.clear(std::memory_order_release); }
+        private:
+            std::atomic_flag flag_;
+        };
+
+        // Registry of live threads plus the totals of threads that already exited
+        SpinLock g_threadsLock;
+        ThreadTotals* g_threads = nullptr;
+        PlainTotals g_exitedTotals[kTagCount];
+
+        // Same lifetime scheme as the tag heaps in memory.cpp: the totals are trivially
+        // destructible thread_locals, the guard unlinks them when the thread exits and any
+        // later allocation from that thread goes straight into g_exitedTotals.
+        enum class TotalsState : uint8_t { Unset, Live, Dead };
+
+        thread_local ThreadTotals t_totals;
+        thread_local TotalsState t_totalsState = TotalsState::Unset;
+
+        struct ThreadTotalsGuard {
+            void Touch() noexcept { t_totalsState = TotalsState::Live; }
+            ~ThreadTotalsGuard() {
+                std::lock_guard<SpinLock> lock(g_threadsLock);
+                for (size_t i = 0; i < kTagCount; ++i) {
+                    const TagTotals& tag = t_totals.tags[i];
+                    g_exitedTotals[i].alloc_bytes += tag.alloc_bytes.load(std::memory_order_relaxed);
+                    g_exitedTotals[i].alloc_count += tag.alloc_count.load(std::memory_order_relaxed);
+                    g_exitedTotals[i].free_bytes += tag.free_bytes.load(std::memory_order_relaxed);
+                    g_exitedTotals[i].free_count += tag.free_count.load(std::memory_order_relaxed);
+                }
+                if (t_totals.prev) t_totals.prev->next = t_totals.next;
+                else g_threads = t_totals.next;
+                if (t_totals.next) t_totals.next->prev = t_totals.prev;
+                t_totalsState = TotalsState::Dead;
+            }
+        };
+
+        thread_local ThreadTotalsGuard t_totalsGuard;
+
+        TagTotals* ThisThreadTotals(MemoryTag tag) noexcept {
+            if (t_totalsState == TotalsState::Live) return &t_totals.tags[(size_t)tag];
+            if (t_totalsState == TotalsState::Dead) return nullptr;
+            {
+                std::lock_guard<SpinLock> lock(g_threadsLock);
+                t_totals.next = g_threads;
+                if (g_threads) g_threads->prev = &t_totals;
+                g_threads = &t_totals;
+            }
+            t_totalsGuard.Touch();
+            return &t_totals.tags[(size_t)tag];
+        }
+
+        void Bump(std::atomic<uint64_t>& counter, uint64_t value) noexcept {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        // The ring itself; samples are written by SampleFrame and copied out by readers
+        struct Timeline {
+            SpinLock lock;
+            FrameMemorySample samples[MemoryTimeline::kCapacity];
+            size_t next = 0;
+            size_t count = 0;
+
+            PlainTotals previous[kTagCount];
+            std::chrono::steady_clock::time_point lastSample;
+            bool started = false;
+        };
+
+        Timeline g_timeline;
+
+    } // namespace
+
+    // ============================================================
+    // Hooks
+    // ============================================================
+
+    void detail::CountTimelineAlloc(MemoryTag tag, size_t size) noexcept {
+        if (TagTotals* totals = ThisThreadTotals(tag)) {
+            Bump(totals->alloc_bytes, size);
+            Bump(totals->alloc_count, 1);
+            return;
+        }
+        std::lock_guard<SpinLock> lock(g_threadsLock);
+        g_exitedTotals[(size_t)tag].alloc_bytes += size;
+        g_exitedTotals[(size_t)tag].alloc_count += 1;
+    }
+
+    void detail::CountTimelineFree(MemoryTag tag, size_t size) noexcept {
+        if (TagTotals* totals = ThisThreadTotals(tag)) {
+            Bump(totals->free_bytes, size);
+            Bump(totals->free_count, 1);
+            return;
+        }
+        std::lock_guard<SpinLock> lock(g_threadsLock);
+        g_exitedTotals[(size_t)tag].free_bytes += size;
+        g_exitedTotals[(size_t)tag].free_count += 1;
+    }
+
+    // ============================================================
+    // MemoryTimeline Implementation
+    // ============================================================
+
+    void MemoryTimeline::SampleFrame() noexcept {
+        PlainTotals totals[kTagCount];
+        {
+            std::lock_guard<SpinLock> lock(g_threadsLock);
+            std::copy(std::begin(g_exitedTotals), std::end(g_exitedTotals), totals);
+            for (const ThreadTotals* thread = g_threads; thread; thread = thread->next) {
+                for (size_t i = 0; i < kTagCount; ++i) {
+                    const TagTotals& tag = thread->tags[i];
+                    totals[i].alloc_bytes += tag.alloc_bytes.load(std::memory_order_relaxed);
+                    totals[i].alloc_count += tag.alloc_count.load(std::memory_order_relaxed);
+                    totals[i].free_bytes += tag.free_bytes.load(std::memory_order_relaxed);
+                    totals[i].free_count += tag.free_count.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard<SpinLock> lock(g_timeline.lock);
+        FrameMemorySample& sample = g_timeline.samples[g_timeline.next];
+        sample.frame = g_frameContext.frame_index.load(std::memory_order_relaxed);
+        sample.frame_ms = g_timeline.started
+            ? std::chrono::duration<float, std::milli>(now - g_timeline.lastSample).count()
+            : 0.0f;
+
+        for (size_t i = 0; i < kTagCount; ++i) {
+            const PlainTotals& then = g_timeline.previous[i];
+            const PlainTotals& total = totals[i];
+            FrameTagSample& tag = sample.tags[i];
+            const int64_t startBytes = static_cast<int64_t>(then.alloc_bytes - then.free_bytes);
+            tag.bytes_current = static_cast<int64_t>(total.alloc_bytes - total.free_bytes);
+            tag.bytes_allocated = total.alloc_bytes - then.alloc_bytes;
+            tag.bytes_peak = std::max(tag.bytes_current, startBytes + static_cast<int64_t>(tag.bytes_allocated));
+            tag.allocs = static_cast<uint32_t>(total.alloc_count - then.alloc_count);
+            tag.frees = static_cast<uint32_t>(total.free_count - then.free_count);
+        }
+
+        std::copy(std::begin(totals), std::end(totals), g_timeline.previous);
+        g_timeline.lastSample = now;
+        g_timeline.started = true;
+        g_timeline.next = (g_timeline.next + 1) % kCapacity;
+        g_timeline.count = std::min(g_timeline.count + 1, kCapacity);
+    }
+
+    size_t MemoryTimeline::CopyRecent(std::vector<FrameMemorySample>& out, size_t maxFrames) {
+        // Reserve before locking: growing `out` allocates, and Alloc never takes this lock
+        out.reserve(std::min(maxFrames, kCapacity));
+        out.clear();
+        std::lock_guard<SpinLock> lock(g_timeline.lock);
+        const size_t count = std::min({ maxFrames, g_timeline.count, out.capacity() });
+        size_t index = (g_timeline.next + kCapacity - count) % kCapacity;
+        for (size_t i = 0; i < count; ++i, index = (index + 1) % kCapacity) {
+            out.push_back(g_timeline.samples[index]);
+        }
+        return count;
+    }
+
+} // namespace shine::co
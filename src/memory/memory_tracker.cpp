@@ -0,0 +1,237 @@
+#ifdef SHINE_USE_MODULE
+module shine.memory;
+import <algorithm>;
+import <atomic>;
+import <cstdio>;
+import <functional>;
+import <mutex>;
+import <source_location>;
+import <thread>;
+import <vector>;
+#endif
+
+
+
+#ifndef SHINE_USE_MODULE
+#include "memory.ixx"
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace shine::co {
+
+    namespace detail {
+        std::atomic<bool> g_trackingEnabled{false};
+    }
+
+    namespace {
+
+        constexpr uint32_t kMaxSites = 4096;   // power of two; site 0 collects overflow
+        constexpr uint32_t kShardCount = 8;    // counter shards, picked per thread
+
+        struct CallSite {
+            std::atomic<uint64_t> key{0};
+            std::atomic<bool> ready{false};  // metadata below is published
+            const char* file = nullptr;
+            const char* function = nullptr;
+            uint32_t line = 0;
+        };
+
+        struct SiteCounters {
+            std::atomic<int64_t> live_bytes{0};
+            std::atomic<int64_t> live_count{0};
+            std::atomic<uint64_t> alloc_count{0};
+            std::atomic<uint64_t> alloc_bytes{0};
+        };
+
+        // Plain arrays so the hooks never allocate (they run inside Memory::Alloc)
+        CallSite g_sites[kMaxSites];
+        SiteCounters g_counters[kShardCount][kMaxSites];
+        std::atomic<uint32_t> g_siteHighWater{1};
+
+        uint64_t HashSite(const std::source_location& loc) noexcept {
+            uint64_t h = reinterpret_cast<uintptr_t>(loc.file_name()) * 0x9E3779B97F4A7C15ull;
+            h ^= (reinterpret_cast<uintptr_t>(loc.function_name()) + (uint64_t(loc.line()) << 32) + loc.column()) * 0xC2B2AE3D27D4EB4Full;
+            h ^= h >> 29;
+            return h | 1;  // 0 marks an empty slot
+        }
+
+        uint32_t FindOrInsertSite(const std::source_location& loc) noexcept {
+            const uint64_t key = HashSite(loc);
+            uint32_t index = static_cast<uint32_t>(key >> 20) & (kMaxSites - 1);
+            for (uint32_t probe = 0; probe < kMaxSites; ++probe, index = (index + 1) & (kMaxSites - 1)) {
+                if (index == 0) continue;
+                CallSite& site = g_sites[index];
+                uint64_t current = site.key.load(std::memory_order_acquire);
+                if (current == key) return index;
+                if (current != 0) continue;
+                if (site.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                    site.file = loc.file_name();
+                    site.function = loc.function_name();
+                    site.line = loc.line();
+                    site.ready.store(true, std::memory_order_release);
+                    uint32_t high = g_siteHighWater.load(std::memory_order_relaxed);
+                    while (high <= index && !g_siteHighWater.compare_exchange_weak(high, index + 1, std::memory_order_relaxed)) {}
+                    return index;
+                }
+                if (current == key) return index;
+            }
+            return 0;
+        }
+
+        uint32_t ShardOfThisThread() noexcept {
+            thread_local const uint32_t shard =
+                static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) % kShardCount;
+            return shard;
+        }
+
+        struct FrameHistory {
+            std::mutex mutex;
+            CallSiteSnapshot previous;
+            CallSiteSnapshot current;
+        };
+
+        FrameHistory& History() {
+            static FrameHistory* history = new FrameHistory();
+            return *history;
+        }
+
+    } // namespace
+
+    // ============================================================
+    // Hooks
+    // ============================================================
+
+    uint32_t detail::TrackSiteAlloc(const std::source_location& loc, size_t size) noexcept {
+        const uint32_t site = FindOrInsertSite(loc);
+        SiteCounters& counters = g_counters[ShardOfThisThread()][site];
+        counters.live_bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+        counters.live_count.fetch_add(1, std::memory_order_relaxed);
+        counters.alloc_count.fetch_add(1, std::memory_order_relaxed);
+        counters.alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+        return site;
+    }
+
+    void detail::TrackSiteFree(uint32_t site, size_t size) noexcept {
+        SiteCounters& counters = g_counters[ShardOfThisThread()][site];
+        counters.live_bytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+        counters.live_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // ============================================================
+    // MemoryTracker Implementation
+    // ============================================================
+
+    void MemoryTracker::SetEnabled(bool enabled) noexcept {
+        detail::g_trackingEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool MemoryTracker::IsEnabled() noexcept {
+        return detail::g_trackingEnabled.load(std::memory_order_relaxed);
+    }
+
+    CallSiteSnapshot MemoryTracker::Snapshot() {
+        CallSiteSnapshot snapshot;
+        snapshot.frame = g_frameContext.frame_index.load(std::memory_order_relaxed);
+        const uint32_t count = g_siteHighWater.load(std::memory_order_acquire);
+        snapshot.sites.resize(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            CallSiteStats& stats = snapshot.sites[i];
+            stats = {};
+            if (i == 0) {
+                stats.file = "<overflow>";
+                stats.function = "";
+            } else if (g_sites[i].ready.load(std::memory_order_acquire)) {
+                stats.file = g_sites[i].file;
+                stats.function = g_sites[i].function;
+                stats.line = g_sites[i].line;
+            } else {
+                continue;
+            }
+            for (uint32_t shard = 0; shard < kShardCount; ++shard) {
+                const SiteCounters& counters = g_counters[shard][i];
+                stats.live_bytes += counters.live_bytes.load(std::memory_order_relaxed);
+                stats.live_count += counters.live_count.load(std::memory_order_relaxed);
+                stats.alloc_count += counters.alloc_count.load(std::memory_order_relaxed);
+                stats.alloc_bytes += counters.alloc_bytes.load(std::memory_order_relaxed);
+            }
+        }
+        return snapshot;
+    }
+
+    std::vector<CallSiteStats> MemoryTracker::Diff(const CallSiteSnapshot& older, const CallSiteSnapshot& newer) {
+        std::vector<CallSiteStats> result;
+        for (size_t i = 0; i < newer.sites.size(); ++i) {
+            const CallSiteStats& now = newer.sites[i];
+            if (!now.file) continue;
+            CallSiteStats delta = now;
+            if (i < older.sites.size() && older.sites[i].file) {
+                const CallSiteStats& then = older.sites[i];
+                delta.live_bytes -= then.live_bytes;
+                delta.live_count -= then.live_count;
+                delta.alloc_count -= then.alloc_count;
+                delta.alloc_bytes -= then.alloc_bytes;
+            }
+            if (delta.alloc_count != 0 || delta.live_count != 0) result.push_back(delta);
+        }
+        return result;
+    }
+
+    void MemoryTracker::EndFrame() {
+        if (!IsEnabled()) return;
+        CallSiteSnapshot snapshot = Snapshot();
+        FrameHistory& history = History();
+        std::lock_guard<std::mutex> lock(history.mutex);
+        history.previous = std::move(history.current);
+        history.current = std::move(snapshot);
+    }
+
+    std::vector<CallSiteStats> MemoryTracker::TopThisFrame(size_t count) {
+        std::vector<CallSiteStats> top;
+        {
+            FrameHistory& history = History();
+            std::lock_guard<std::mutex> lock(history.mutex);
+            top = Diff(history.previous, history.current);
+        }
+        const size_t keep = std::min(count, top.size());
+        std::partial_sort(top.begin(), top.begin() + keep, top.end(),
+            [](const CallSiteStats& a, const CallSiteStats& b) { return a.alloc_bytes > b.alloc_bytes; });
+        top.resize(keep);
+        return top;
+    }
+
+    void MemoryTracker::DumpLeaks() noexcept {
+        const uint32_t count = g_siteHighWater.load(std::memory_order_acquire);
+        size_t totalBytes = 0;
+        uint64_t totalCount = 0;
+
+        std::printf("[Memory] ===== Live Tracked Allocations =====\n");
+        for (uint32_t i = 0; i < count; ++i) {
+            int64_t bytes = 0;
+            int64_t live = 0;
+            for (uint32_t shard = 0; shard < kShardCount; ++shard) {
+                bytes += g_counters[shard][i].live_bytes.load(std::memory_order_relaxed);
+                live += g_counters[shard][i].live_count.load(std::memory_order_relaxed);
+            }
+            if (live <= 0) continue;
+
+            const bool ready = i != 0 && g_sites[i].ready.load(std::memory_order_acquire);
+            std::printf(
+                "[Memory][Leak] %s:%u %s count=%lld bytes=%lld\n",
+                ready ? g_sites[i].file : "<overflow>",
+                ready ? g_sites[i].line : 0u,
+                ready ? g_sites[i].function : "",
+                (long long)live,
+                (long long)bytes
+            );
+            totalBytes += static_cast<size_t>(bytes);
+            totalCount += static_cast<uint64_t>(live);
+        }
+        std::printf("[Memory] %llu allocations, %.2fMB still live\n", (unsigned long long)totalCount,
+            double(totalBytes) / (1024.0 * 1024.0));
+        std::printf("[Memory] ====================================\n");
+    }
+
+} // namespace shine::co
@@ -0,0 +1,228 @@
+#ifdef SHINE_USE_MODULE
+module shine.memory.pool;
+import <algorithm>;
+import <array>;
+import <atomic>;
+import <cassert>;
+import <mutex>;
+import <vector>;
+import shine.memory;
+#endif
+
+
+
+#ifndef SHINE_USE_MODULE
+#include "pool_allocator.ixx"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <vector>
+#include "../third/mimalloc/mimalloc.h"
+#endif
+
+namespace shine::co {
+
+    namespace {
+
+        constexpr size_t kTagCount = (size_t)MemoryTag::Count;
+        constexpr size_t kSlabHeaderSize = 64;  // keeps the first block cache-line aligned
+        constexpr uint32_t kSlabMagic = 0x534C4142;  // 'SLAB'
+
+        // 16-byte steps up to 128, then four classes per power of two (<= 25% waste)
+        constexpr uint16_t kClassSizes[] = {
+            16, 32, 48, 64, 80, 96, 112, 128,
+            160, 192, 224, 256,
+            320, 384, 448, 512,
+            640, 768, 896, 1024
+        };
+        constexpr size_t kClassCount = std::size(kClassSizes);
+
+        static_assert(kClassSizes[kClassCount - 1] == PoolAllocator::kMaxSize);
+        static_assert((PoolAllocator::kSlabSize & (PoolAllocator::kSlabSize - 1)) == 0);
+
+        // (size + 15) / 16 -> class index
+        constexpr auto kClassLookup = [] {
+            std::array<uint8_t, PoolAllocator::kMaxSize / 16 + 1> table{};
+            size_t cls = 0;
+            for (size_t i = 0; i < table.size(); ++i) {
+                while (kClassSizes[cls] < i * 16) ++cls;
+                table[i] = (uint8_t)cls;
+            }
+            return table;
+        }();
+
+        struct SlabHeader {
+            uint32_t magic;
+            uint16_t tag;
+            uint16_t cls;
+        };
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        struct Batch {
+            FreeBlock* head;
+            uint32_t count;
+        };
+
+        std::atomic<size_t> g_reservedBytes{0};
+        std::atomic<uint32_t> g_slabCount{0};
+
+        // Full batches handed over by threads with surplus blocks
+        struct DepotBin {
+            std::mutex mutex;
+            std::vector<Batch> batches;
+        };
+
+        // Leaked on purpose so thread caches can drain into it during shutdown
+        DepotBin& Depot(size_t tag, size_t cls) {
+            static DepotBin* bins = new DepotBin[kTagCount * kClassCount];
+            return bins[tag * kClassCount + cls];
+        }
+
+        void PushBatch(size_t tag, size_t cls, Batch batch) {
+            DepotBin& bin = Depot(tag, cls);
+            std::lock_guard<std::mutex> lock(bin.mutex);
+            bin.batches.push_back(batch);
+        }
+
+        bool PopBatch(size_t tag, size_t cls, Batch& batch) {
+            DepotBin& bin = Depot(tag, cls);
+            std::lock_guard<std::mutex> lock(bin.mutex);
+            if (bin.batches.empty()) return false;
+            batch = bin.batches.back();
+            bin.batches.pop_back();
+            return true;
+        }
+
+        SlabHeader* SlabOf(void* p) noexcept {
+            return reinterpret_cast<SlabHeader*>(reinterpret_cast<uintptr_t>(p) & ~(uintptr_t)(PoolAllocator::kSlabSize - 1));
+        }
+
+        char* NewSlab(size_t tag, size_t cls) noexcept {
+            void* p = mi_malloc_aligned(PoolAllocator::kSlabSize, PoolAllocator::kSlabSize);
+            if (!p) return nullptr;
+            g_reservedBytes.fetch_add(PoolAllocator::kSlabSize, std::memory_order_relaxed);
+            g_slabCount.fetch_add(1, std::memory_order_relaxed);
+            ::new (p) SlabHeader{ kSlabMagic, (uint16_t)tag, (uint16_t)cls };
+            return static_cast<char*>(p);
+        }
+
+        // One (tag, class) free list of one thread
+        struct Bin {
+            FreeBlock* head = nullptr;
+            uint32_t count = 0;
+            char* cursor = nullptr;  // uncarved tail of the newest slab
+            char* end = nullptr;
+        };
+
+        struct ThreadCache {
+            Bin bins[kTagCount][kClassCount];
+
+            ~ThreadCache() {
+                for (size_t tag = 0; tag < kTagCount; ++tag) {
+                    for (size_t cls = 0; cls < kClassCount; ++cls) {
+                        Bin& bin = bins[tag][cls];
+                        const size_t size = kClassSizes[cls];
+                        for (; (size_t)(bin.end - bin.cursor) >= size; bin.cursor += size) {
+                            auto* block = reinterpret_cast<FreeBlock*>(bin.cursor);
+                            block->next = bin.head;
+                            bin.head = block;
+                            ++bin.count;
+                        }
+                        while (bin.count > 0) Spill(bin, tag, cls, std::min(bin.count, PoolAllocator::kBatchSize));
+                    }
+                }
+            }
+
+            // Move the first `count` blocks of the list to the depot
+            static void Spill(Bin& bin, size_t tag, size_t cls, uint32_t count) noexcept {
+                FreeBlock* head = bin.head;
+                FreeBlock* last = head;
+                for (uint32_t i = 1; i < count; ++i) last = last->next;
+                bin.head = last->next;
+                bin.count -= count;
+                last->next = nullptr;
+                PushBatch(tag, cls, { head, count });
+            }
+
+            void* Refill(Bin& bin, size_t tag, size_t cls) noexcept {
+                Batch batch;
+                if (PopBatch(tag, cls, batch)) {
+                    FreeBlock* block = batch.head;
+                    bin.head = block->next;
+                    bin.count = batch.count - 1;
+                    return block;
+                }
+                char* slab = NewSlab(tag, cls);
+                if (!slab) return nullptr;
+                char* block = slab + kSlabHeaderSize;
+                bin.cursor = block + kClassSizes[cls];
+                bin.end = slab + PoolAllocator::kSlabSize;
+                return block;
+            }
+        };
+
+        thread_local ThreadCache t_cache;
+
+    } // namespace
+
+    // ============================================================
+    // PoolAllocator Implementation
+    // ============================================================
+
+    void* PoolAllocator::Alloc(size_t size, MemoryTag tag) noexcept {
+        if (size == 0 || size > kMaxSize) return nullptr;
+        const size_t cls = kClassLookup[(size + 15) / 16];
+        const size_t classSize = kClassSizes[cls];
+        Bin& bin = t_cache.bins[(size_t)tag][cls];
+
+        void* p;
+        if (FreeBlock* block = bin.head) {
+            bin.head = block->next;
+            --bin.count;
+            p = block;
+        } else if ((size_t)(bin.end - bin.cursor) >= classSize) {
+            p = bin.cursor;
+            bin.cursor += classSize;
+        } else {
+            p = t_cache.Refill(bin, (size_t)tag, cls);
+            if (!p) return nullptr;
+        }
+
+        Memory::TrackAlloc(tag, classSize);
+        return p;
+    }
+
+    void PoolAllocator::Free(void* p) noexcept {
+        if (!p) return;
+        const SlabHeader* slab = SlabOf(p);
+        assert(slab->magic == kSlabMagic && "pointer not from PoolAllocator");
+        const size_t tag = slab->tag;
+        const size_t cls = slab->cls;
+        Bin& bin = t_cache.bins[tag][cls];
+
+        auto* block = static_cast<FreeBlock*>(p);
+        block->next = bin.head;
+        bin.head = block;
+        if (++bin.count >= 2 * kBatchSize) ThreadCache::Spill(bin, tag, cls, kBatchSize);
+
+        Memory::TrackFree((MemoryTag)tag, kClassSizes[cls]);
+    }
+
+    size_t PoolAllocator::GetClassSize(size_t size) noexcept {
+        if (size == 0 || size > kMaxSize) return 0;
+        return kClassSizes[kClassLookup[(size + 15) / 16]];
+    }
+
+    PoolAllocatorStats PoolAllocator::GetStats() noexcept {
+        return {
+            g_reservedBytes.load(std::memory_order_relaxed),
+            g_slabCount.load(std::memory_order_relaxed)
+        };
+    }
+
+} // namespace shine::co
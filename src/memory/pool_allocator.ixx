@@ -0,0 +1,102 @@
+#ifdef SHINE_USE_MODULE
+
+export module shine.memory.pool;
+
+import <cstddef>;
+import <cstdint>;
+import <memory>;
+import <new>;
+import <type_traits>;
+import <utility>;
+import shine.memory;
+
+#else
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "memory.ixx"
+
+#endif
+
+
+
+namespace shine::co {
+
+    // ============================================================
+    // PoolAllocator
+    // ============================================================
+
+    struct PoolAllocatorStats {
+        size_t   reserved_bytes;  // slab memory, never returned while the process runs
+        uint32_t slab_count;
+    };
+
+    // Slab allocator for small fixed-size objects.
+    //
+    // Requests are rounded to one of the size classes (16 bytes .. kMaxSize) and served from
+    // 64KB slabs, one set of slabs per (MemoryTag, size class). Slabs are aligned to their
+    // size, so Free finds the owning slab by masking the pointer and no per-block header is
+    // needed. Each thread pops and pushes its own free lists; a list that grows past two
+    // batches hands one batch of kBatchSize blocks to a global depot, where other threads
+    // refill from. Blocks are counted against their tag in g_tagStats at class size.
+    SHINE_MODULE_EXPORT class PoolAllocator {
+    public:
+        static constexpr size_t kMaxSize = 1024;
+        static constexpr size_t kAlignment = 16;
+        static constexpr size_t kSlabSize = 64 * 1024;
+        static constexpr uint32_t kBatchSize = 64;
+
+        // size must be in [1, kMaxSize]; nullptr otherwise or when out of memory
+        static void* Alloc(size_t size, MemoryTag tag = g_tlsMemoryTag) noexcept;
+
+        // p must come from Alloc (any thread)
+        static void Free(void* p) noexcept;
+
+        // Size actually reserved for a request of `size` bytes
+        static size_t GetClassSize(size_t size) noexcept;
+
+        static PoolAllocatorStats GetStats() noexcept;
+    };
+
+    // ============================================================
+    // Typed helpers
+    // ============================================================
+
+    // Destroys through the (virtual) destructor and returns the block; works for base
+    // pointers because the slab is found from the most-derived object's address
+    SHINE_MODULE_EXPORT struct PoolDeleter {
+        template<typename T>
+        void operator()(T* p) const noexcept {
+            if (!p) return;
+            void* block;
+            if constexpr (std::is_polymorphic_v<T>) block = dynamic_cast<void*>(p);
+            else block = p;
+            p->~T();
+            PoolAllocator::Free(block);
+        }
+    };
+
+    SHINE_MODULE_EXPORT template<typename T>
+    using PoolPtr = std::unique_ptr<T, PoolDeleter>;
+
+    // Construct a T in the pool of the current MemoryScope tag
+    SHINE_MODULE_EXPORT template<typename T, typename... Args>
+    PoolPtr<T> MakePooled(Args&&... args) {
+        static_assert(sizeof(T) <= PoolAllocator::kMaxSize, "type too large for PoolAllocator");
+        static_assert(alignof(T) <= PoolAllocator::kAlignment, "over-aligned type in PoolAllocator");
+        void* p = PoolAllocator::Alloc(sizeof(T));
+        if (!p) throw std::bad_alloc();
+        try {
+            return PoolPtr<T>(::new (p) T(std::forward<Args>(args)...));
+        } catch (...) {
+            PoolAllocator::Free(p);
+            throw;
+        }
+    }
+
+} // namespace shine::co
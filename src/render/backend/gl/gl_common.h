@@ -2,6 +2,10 @@
 
 #include <GL/glew.h>
 
+#include <cstddef>
+
+#include "image/Texture.h"
+
 namespace shine::render::backend::gl
 {
     struct ViewportInfo {
@@ -21,4 +25,158 @@ namespace shine::render::backend::gl
         ViewportInfo& operator=(const ViewportInfo&) = default;
         ViewportInfo& operator=(ViewportInfo&&) = default;
     };
+
+    // ========================================================================
+    // mip 级上传（OpenGL 3.3 与 WebGL2 共用）
+    // ========================================================================
+
+    /**
+     * @brief 上传 RGBA 纹理的一级 mip
+     * @param internalFormat 与第 0 级相同的内部格式（各级不一致时纹理不完整）
+     */
+    inline bool UploadTexture2DLevel(GLuint textureId, GLint internalFormat, int level, int width, int height,
+        const void* data)
+    {
+        if (textureId == 0 || level < 0 || width <= 0 || height <= 0 || data == nullptr)
+        {
+            return false;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, textureId);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexImage2D(GL_TEXTURE_2D, level, internalFormat,
+            static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return true;
+    }
+
+    inline void SetTextureLevelRange(GLuint textureId, int baseLevel, int maxLevel)
+    {
+        if (textureId == 0)
+        {
+            return;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, textureId);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, baseLevel);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, maxLevel);
+        if (maxLevel > 0)
+        {
+            // 以单级创建的纹理（如压缩纹理）补上mip链后，缩小过滤需要改为带mip的版本
+            GLint minFilter = 0;
+            glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &minFilter);
+            if (minFilter == GL_LINEAR)
+            {
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            }
+            else if (minFilter == GL_NEAREST)
+            {
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+            }
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    // ========================================================================
+    // 块压缩纹理（OpenGL 3.3 与 WebGL2 共用）
+    // ========================================================================
+
+    /**
+     * @brief 压缩格式对应的 GL 内部格式，不支持的格式返回 0
+     */
+    inline GLenum CompressedInternalFormat(image::TextureFormat format)
+    {
+        switch (format)
+        {
+        case image::TextureFormat::BC1_RGB: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case image::TextureFormat::BC1_RGBA: return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case image::TextureFormat::BC3_RGBA: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case image::TextureFormat::BC4_R: return GL_COMPRESSED_RED_RGTC1;
+        case image::TextureFormat::BC5_RG: return GL_COMPRESSED_RG_RGTC2;
+        case image::TextureFormat::BC7_RGBA: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        default: return 0;
+        }
+    }
+
+    /**
+     * @brief 当前上下文是否暴露了该格式所需的扩展（S3TC / RGTC / BPTC）
+     */
+    inline bool IsCompressedFormatSupported(image::TextureFormat format)
+    {
+        switch (format)
+        {
+        case image::TextureFormat::BC1_RGB:
+        case image::TextureFormat::BC1_RGBA:
+        case image::TextureFormat::BC3_RGBA:
+            return GLEW_EXT_texture_compression_s3tc;
+        case image::TextureFormat::BC4_R:
+        case image::TextureFormat::BC5_RG:
+            return GLEW_VERSION_3_0 || GLEW_ARB_texture_compression_rgtc;
+        case image::TextureFormat::BC7_RGBA:
+            return GLEW_VERSION_4_2 || GLEW_ARB_texture_compression_bptc;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * @brief 创建块压缩纹理并上传第 0 级，失败返回 0
+     */
+    inline GLuint CreateCompressedTexture2D(int width, int height, image::TextureFormat format, const void* data,
+        size_t dataSize, bool linearFilter, bool clampToEdge)
+    {
+        const GLenum internalFormat = CompressedInternalFormat(format);
+        if (width <= 0 || height <= 0 || data == nullptr || internalFormat == 0 || !IsCompressedFormatSupported(format))
+        {
+            return 0;
+        }
+
+        GLuint textureId = 0;
+        glGenTextures(1, &textureId);
+        glBindTexture(GL_TEXTURE_2D, textureId);
+
+        const GLint filter = linearFilter ? GL_LINEAR : GL_NEAREST;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+        const GLint wrapMode = clampToEdge ? GL_CLAMP_TO_EDGE : GL_REPEAT;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapMode);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+        while (glGetError() != GL_NO_ERROR) {}
+        glCompressedTexImage2D(GL_TEXTURE_2D, 0, internalFormat,
+            static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0,
+            static_cast<GLsizei>(dataSize), data);
+        const bool ok = glGetError() == GL_NO_ERROR;
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+        if (!ok)
+        {
+            glDeleteTextures(1, &textureId);
+            return 0;
+        }
+        return textureId;
+    }
+
+    /**
+     * @brief 上传块压缩纹理的指定 mip 级，失败返回 false
+     */
+    inline bool UploadCompressedTexture2DLevel(GLuint textureId, int level, int width, int height,
+        image::TextureFormat format, const void* data, size_t dataSize)
+    {
+        const GLenum internalFormat = CompressedInternalFormat(format);
+        if (textureId == 0 || level < 0 || width <= 0 || height <= 0 || data == nullptr || internalFormat == 0)
+        {
+            return false;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, textureId);
+        while (glGetError() != GL_NO_ERROR) {}
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat,
+            static_cast<GLsizei>(width), static_cast<GLsizei>(height), 0,
+            static_cast<GLsizei>(dataSize), data);
+        const bool ok = glGetError() == GL_NO_ERROR;
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return ok;
+    }
 }
@@ -471,6 +471,36 @@ unsigned long long OpenGLRenderBackend::GetViewportTexture(u32 handle)
 		}
 	}
 
+	bool OpenGLRenderBackend::UploadTexture2DLevel(uint32_t textureId, int level, int width, int height, const void* data)
+	{
+		// 与 CreateTexture2D 的第 0 级保持相同的内部格式
+		return backend::gl::UploadTexture2DLevel(static_cast<GLuint>(textureId), GL_RGBA, level, width, height, data);
+	}
+
+	void OpenGLRenderBackend::SetTextureLevelRange(uint32_t textureId, int baseLevel, int maxLevel)
+	{
+		backend::gl::SetTextureLevelRange(static_cast<GLuint>(textureId), baseLevel, maxLevel);
+	}
+
+	bool OpenGLRenderBackend::SupportsCompressedFormat(image::TextureFormat format) const
+	{
+		return backend::gl::IsCompressedFormatSupported(format);
+	}
+
+	uint32_t OpenGLRenderBackend::CreateCompressedTexture2D(int width, int height, image::TextureFormat format,
+		const void* data, size_t dataSize, bool linearFilter, bool clampToEdge)
+	{
+		return static_cast<uint32_t>(backend::gl::CreateCompressedTexture2D(
+			width, height, format, data, dataSize, linearFilter, clampToEdge));
+	}
+
+	bool OpenGLRenderBackend::UploadCompressedTexture2DLevel(uint32_t textureId, int level, int width, int height,
+		image::TextureFormat format, const void* data, size_t dataSize)
+	{
+		return backend::gl::UploadCompressedTexture2DLevel(static_cast<GLuint>(textureId), level, width, height,
+			format, data, dataSize);
+	}
+
     uint32_t OpenGLRenderBackend::CreateShaderProgram(const char* vsSource, const char* fsSource, std::string& outLog)
     {
         GLint ok = 0; outLog.clear();
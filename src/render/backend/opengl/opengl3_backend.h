@@ -117,6 +117,18 @@ namespace shine::render::opengl3
 
         virtual void ReleaseTexture(uint32_t textureId) override;
 
+        virtual bool UploadTexture2DLevel(uint32_t textureId, int level, int width, int height, const void* data) override;
+
+        virtual void SetTextureLevelRange(uint32_t textureId, int baseLevel, int maxLevel) override;
+
+        virtual bool SupportsCompressedFormat(image::TextureFormat format) const override;
+
+        virtual uint32_t CreateCompressedTexture2D(int width, int height, image::TextureFormat format, const void* data,
+            size_t dataSize, bool linearFilter = true, bool clampToEdge = true) override;
+
+        virtual bool UploadCompressedTexture2DLevel(uint32_t textureId, int level, int width, int height,
+            image::TextureFormat format, const void* data, size_t dataSize) override;
+
         // Shader creation interface implementation
         virtual uint32_t CreateShaderProgram(const char* vsSource, const char* fsSource, std::string& outLog) override;
         virtual void ReleaseShaderProgram(uint32_t programId) override;
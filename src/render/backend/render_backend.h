@@ -18,6 +18,10 @@ namespace shine::render {
 class CommandBuffer;
 }
 
+namespace shine::image {
+enum class TextureFormat;
+}
+
 namespace shine::render::backend {
 
 class IRenderBackend {
@@ -108,6 +112,92 @@ class IRenderBackend {
      */
     virtual void ReleaseTexture(uint32_t textureId) = 0;
 
+    /**
+     * @brief 上传RGBA纹理的指定mip级（用于CPU生成的mip链，替代glGenerateMipmap）
+     * @param textureId 纹理ID
+     * @param level mip级（0为原图）
+     * @param width 该级宽度
+     * @param height 该级高度
+     * @param data 该级RGBA数据
+     * @return 后端不支持按级上传时返回false
+     */
+    virtual bool UploadTexture2DLevel(uint32_t textureId, int level, int width, int height, const void *data) {
+        (void)textureId;
+        (void)level;
+        (void)width;
+        (void)height;
+        (void)data;
+        return false;
+    }
+
+    /**
+     * @brief 设置纹理可采样的mip级范围（流式加载时先上传低分辨率级，再逐步降低baseLevel）
+     * maxLevel大于0时，不带mip的缩小过滤会切换为对应的mip过滤
+     * @param textureId 纹理ID
+     * @param baseLevel 最高分辨率的可用级
+     * @param maxLevel 最低分辨率的可用级
+     */
+    virtual void SetTextureLevelRange(uint32_t textureId, int baseLevel, int maxLevel) {
+        (void)textureId;
+        (void)baseLevel;
+        (void)maxLevel;
+    }
+
+    /**
+     * @brief 是否支持直接上传该块压缩格式（不支持时由调用方在CPU上解压为RGBA）
+     * @param format 压缩格式（BC1/BC3/BC4/BC5/BC7）
+     */
+    virtual bool SupportsCompressedFormat(image::TextureFormat format) const {
+        (void)format;
+        return false;
+    }
+
+    /**
+     * @brief 创建块压缩2D纹理（只上传第0级，不生成mipmap）
+     * @param width 纹理宽度
+     * @param height 纹理高度
+     * @param format 压缩格式
+     * @param data 压缩块数据（按块行优先排列）
+     * @param dataSize 数据字节数
+     * @param linearFilter 是否使用线性过滤
+     * @param clampToEdge 是否使用CLAMP_TO_EDGE（否则使用REPEAT）
+     * @return 纹理ID，失败或不支持该格式时返回0
+     */
+    virtual uint32_t CreateCompressedTexture2D(int width, int height, image::TextureFormat format, const void *data,
+                                               size_t dataSize, bool linearFilter = true, bool clampToEdge = true) {
+        (void)width;
+        (void)height;
+        (void)format;
+        (void)data;
+        (void)dataSize;
+        (void)linearFilter;
+        (void)clampToEdge;
+        return 0;
+    }
+
+    /**
+     * @brief 上传块压缩纹理的指定mip级（用于烘焙纹理的预压缩mip链）
+     * @param textureId 由CreateCompressedTexture2D创建的纹理ID
+     * @param level mip级（0为原图）
+     * @param width 该级宽度
+     * @param height 该级高度
+     * @param format 压缩格式，须与创建时一致
+     * @param data 该级压缩块数据
+     * @param dataSize 数据字节数
+     * @return 后端不支持按级上传或上传失败时返回false
+     */
+    virtual bool UploadCompressedTexture2DLevel(uint32_t textureId, int level, int width, int height,
+                                                image::TextureFormat format, const void *data, size_t dataSize) {
+        (void)textureId;
+        (void)level;
+        (void)width;
+        (void)height;
+        (void)format;
+        (void)data;
+        (void)dataSize;
+        return false;
+    }
+
     // ========================================================================
     // Shader Creation Interface
     // ========================================================================
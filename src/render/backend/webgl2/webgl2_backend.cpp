@@ -496,6 +496,36 @@ void WebGL2RenderBackend::ReleaseTexture(uint32_t textureId)
     }
 }
 
+bool WebGL2RenderBackend::UploadTexture2DLevel(uint32_t textureId, int level, int width, int height, const void* data)
+{
+    // Same sized internal format as level 0 in CreateTexture2D
+    return backend::gl::UploadTexture2DLevel(static_cast<GLuint>(textureId), GL_RGBA8, level, width, height, data);
+}
+
+void WebGL2RenderBackend::SetTextureLevelRange(uint32_t textureId, int baseLevel, int maxLevel)
+{
+    backend::gl::SetTextureLevelRange(static_cast<GLuint>(textureId), baseLevel, maxLevel);
+}
+
+bool WebGL2RenderBackend::SupportsCompressedFormat(image::TextureFormat format) const
+{
+    return backend::gl::IsCompressedFormatSupported(format);
+}
+
+uint32_t WebGL2RenderBackend::CreateCompressedTexture2D(int width, int height, image::TextureFormat format,
+    const void* data, size_t dataSize, bool linearFilter, bool clampToEdge)
+{
+    return static_cast<uint32_t>(backend::gl::CreateCompressedTexture2D(
+        width, height, format, data, dataSize, linearFilter, clampToEdge));
+}
+
+bool WebGL2RenderBackend::UploadCompressedTexture2DLevel(uint32_t textureId, int level, int width, int height,
+    image::TextureFormat format, const void* data, size_t dataSize)
+{
+    return backend::gl::UploadCompressedTexture2DLevel(static_cast<GLuint>(textureId), level, width, height,
+        format, data, dataSize);
+}
+
 uint32_t WebGL2RenderBackend::CreateShaderProgram(const char* vsSource, const char* fsSource, std::string& outLog)
 {
     // WebGL2 shares identical shader creation logic with OpenGL 3.3 for this basic use case
@@ -1,7 +1,9 @@
 #include "render/resources/TextureManager.h"
 #include "render/backend/render_backend.h"
 #include "image/Texture.h"
+#include "util/file_util.ixx"
 #include "fmt/format.h"
+#include <algorithm>
 
 // 暂时引入全局上下文，后续应通过依赖注入传递
 #include "../../EngineCore/engine_context.h"
@@ -92,16 +94,90 @@ namespace shine::render
             return TextureHandle{};
         }
 
-        // 通过渲染后端创建纹理
-        uint32_t textureId = renderBackend_->CreateTexture2D(
-            info.width,
-            info.height,
-            info.data,
-            info.generateMipmaps,
-            info.linearFilter,
-            info.clampToEdge
-        );
+        const auto bcFormat = image::toBcFormat(info.format);
+        if (info.format != image::TextureFormat::RGBA && !bcFormat)
+        {
+            fmt::println("TextureManager: 不支持的纹理格式");
+            return TextureHandle{};
+        }
+
+        uint32_t textureId = 0;
+        image::TextureFormat format = info.format;
+        size_t memoryBytes = 0;
+        if (bcFormat)
+        {
+            const size_t expectedSize = image::bc::compressedSize(*bcFormat,
+                static_cast<uint32_t>(info.width), static_cast<uint32_t>(info.height));
+            if (!info.data || info.dataSize < expectedSize)
+            {
+                fmt::println("TextureManager: 压缩纹理数据不足（{} < {} 字节）", info.dataSize, expectedSize);
+                return TextureHandle{};
+            }
 
+            if (renderBackend_->SupportsCompressedFormat(info.format))
+            {
+                textureId = renderBackend_->CreateCompressedTexture2D(
+                    info.width,
+                    info.height,
+                    info.format,
+                    info.data,
+                    expectedSize,
+                    info.linearFilter,
+                    info.clampToEdge
+                );
+                memoryBytes = expectedSize;
+            }
+
+            if (textureId == 0)
+            {
+                // 后端不支持该格式（或上传失败）：在CPU上解压后按RGBA上传
+                auto rgba = image::bc::decompress(static_cast<const uint8_t*>(info.data), info.dataSize,
+                    static_cast<uint32_t>(info.width), static_cast<uint32_t>(info.height), *bcFormat);
+                if (!rgba.has_value())
+                {
+                    fmt::println("TextureManager: 解压纹理失败: {}", rgba.error());
+                    return TextureHandle{};
+                }
+                textureId = renderBackend_->CreateTexture2D(info.width, info.height, rgba->data(),
+                    false, info.linearFilter, info.clampToEdge);
+                format = image::TextureFormat::RGBA;
+                memoryBytes = static_cast<size_t>(info.width) * static_cast<size_t>(info.height) * 4;
+            }
+        }
+        else if (info.mipChain && !info.mipChain->empty())
+        {
+            std::vector<MipLevelView> levels;
+            levels.reserve(info.mipChain->levels.size());
+            for (size_t i = 0; i < info.mipChain->levels.size(); ++i)
+            {
+                const auto& mip = info.mipChain->levels[i];
+                levels.push_back({ static_cast<int>(mip.width), static_cast<int>(mip.height),
+                    info.mipChain->levelData(i), mip.size });
+            }
+            textureId = CreateTextureWithMips(info, levels);
+            memoryBytes = static_cast<size_t>(info.width) * static_cast<size_t>(info.height) * 4 + info.mipChain->data.size();
+        }
+        else
+        {
+            // 通过渲染后端创建纹理
+            textureId = renderBackend_->CreateTexture2D(
+                info.width,
+                info.height,
+                info.data,
+                info.generateMipmaps,
+                info.linearFilter,
+                info.clampToEdge
+            );
+            // RGBA8 = 4字节/像素，mipmap估算为1.33倍
+            memoryBytes = static_cast<size_t>(info.width) * static_cast<size_t>(info.height) * 4 * 4 / 3;
+        }
+
+        return RegisterTexture(textureId, info.width, info.height, format, memoryBytes);
+    }
+
+    TextureHandle TextureManager::RegisterTexture(uint32_t textureId, int width, int height, image::TextureFormat format,
+        size_t memoryBytes)
+    {
         if (textureId == 0)
         {
             fmt::println("TextureManager: 创建纹理失败");
@@ -115,13 +191,173 @@ namespace shine::render
         // 存储纹理数据
         TextureData data;
         data.textureId = textureId;
-        data.width = info.width;
-        data.height = info.height;
+        data.width = width;
+        data.height = height;
+        data.format = format;
+        data.memoryBytes = memoryBytes;
         textures_[handle.id] = data;
 
         return handle;
     }
 
+    uint32_t TextureManager::CreateTextureWithMips(const TextureCreateInfo& info, const std::vector<MipLevelView>& levels)
+    {
+        const int maxLevel = static_cast<int>(levels.size());
+
+        if (info.format != image::TextureFormat::RGBA)
+        {
+            // 压缩纹理只能带数据创建：先以第 0 级创建，再依次补上其余各级
+            uint32_t textureId = renderBackend_->CreateCompressedTexture2D(info.width, info.height, info.format,
+                info.data, info.dataSize, info.linearFilter, info.clampToEdge);
+            if (textureId == 0)
+            {
+                return 0;
+            }
+
+            int uploaded = 0;
+            for (int level = 1; level <= maxLevel; ++level)
+            {
+                const auto& mip = levels[level - 1];
+                if (!renderBackend_->UploadCompressedTexture2DLevel(textureId, level, mip.width, mip.height,
+                    info.format, mip.data, mip.size))
+                {
+                    // 后端不支持按级上传：只保留已上传的完整前缀
+                    break;
+                }
+                uploaded = level;
+            }
+            renderBackend_->SetTextureLevelRange(textureId, 0, uploaded);
+            return textureId;
+        }
+
+        // 先只分配第 0 级（不上传数据，也不让驱动生成mipmap），过滤模式按带mipmap设置
+        uint32_t textureId = renderBackend_->CreateTexture2D(info.width, info.height, nullptr,
+            true, info.linearFilter, info.clampToEdge);
+        if (textureId == 0)
+        {
+            return 0;
+        }
+
+        // 从最小级开始上传，每上传一级就把可采样范围扩展到该级，
+        // 纹理在任何时刻都是完整的，流式加载时可以只先上传低分辨率的尾部
+        for (int level = maxLevel; level >= 1; --level)
+        {
+            const auto& mip = levels[level - 1];
+            if (!renderBackend_->UploadTexture2DLevel(textureId, level, mip.width, mip.height, mip.data))
+            {
+                // 后端不支持按级上传：退回驱动生成mipmap
+                renderBackend_->ReleaseTexture(textureId);
+                return renderBackend_->CreateTexture2D(info.width, info.height, info.data,
+                    true, info.linearFilter, info.clampToEdge);
+            }
+            renderBackend_->SetTextureLevelRange(textureId, level, maxLevel);
+        }
+
+        renderBackend_->UploadTexture2DLevel(textureId, 0, info.width, info.height, info.data);
+        renderBackend_->SetTextureLevelRange(textureId, 0, maxLevel);
+        return textureId;
+    }
+
+    TextureHandle TextureManager::CreateTextureFromCooked(const image::cooked::CookedTexture& cooked,
+        bool linearFilter, bool clampToEdge)
+    {
+        if (!renderBackend_)
+        {
+            fmt::println("TextureManager: 渲染后端未初始化");
+            return TextureHandle{};
+        }
+
+        const auto bcFormat = cooked.compression();
+        const auto base = cooked.level(0);
+
+        TextureCreateInfo info;
+        info.width = static_cast<int>(base.width);
+        info.height = static_cast<int>(base.height);
+        info.data = base.data;
+        info.dataSize = base.size;
+        info.format = bcFormat ? image::toTextureFormat(*bcFormat) : image::TextureFormat::RGBA;
+        info.linearFilter = linearFilter;
+        info.clampToEdge = clampToEdge;
+
+        if (bcFormat && !renderBackend_->SupportsCompressedFormat(info.format))
+        {
+            // 后端不支持该压缩格式：逐级解压为RGBA，仍然上传完整的mip链
+            auto rgba = image::bc::decompress(base.data, base.size, base.width, base.height, *bcFormat);
+            if (!rgba.has_value())
+            {
+                fmt::println("TextureManager: 解压纹理失败: {}", rgba.error());
+                return TextureHandle{};
+            }
+
+            image::mip::MipChain chain;
+            for (uint32_t i = 1; i < cooked.levelCount(); ++i)
+            {
+                const auto level = cooked.level(i);
+                auto levelRgba = image::bc::decompress(level.data, level.size, level.width, level.height, *bcFormat);
+                if (!levelRgba.has_value())
+                {
+                    fmt::println("TextureManager: 解压纹理失败: {}", levelRgba.error());
+                    return TextureHandle{};
+                }
+                chain.levels.push_back({ level.width, level.height, chain.data.size(), levelRgba->size() });
+                chain.data.insert(chain.data.end(), levelRgba->begin(), levelRgba->end());
+            }
+
+            info.format = image::TextureFormat::RGBA;
+            info.data = rgba->data();
+            info.dataSize = 0;
+            info.mipChain = &chain;
+            return CreateTexture(info);
+        }
+
+        if (cooked.levelCount() == 1)
+        {
+            return CreateTexture(info);
+        }
+
+        std::vector<MipLevelView> levels;
+        levels.reserve(cooked.levelCount() - 1);
+        size_t memoryBytes = base.size;
+        for (uint32_t i = 1; i < cooked.levelCount(); ++i)
+        {
+            const auto level = cooked.level(i);
+            levels.push_back({ static_cast<int>(level.width), static_cast<int>(level.height), level.data, level.size });
+            memoryBytes += level.size;
+        }
+
+        const uint32_t textureId = CreateTextureWithMips(info, levels);
+        return RegisterTexture(textureId, info.width, info.height, info.format, memoryBytes);
+    }
+
+    TextureHandle TextureManager::CreateTextureFromFile(const std::string& filePath)
+    {
+        std::string ext = util::get_file_extension(filePath);
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+        if (ext == image::cooked::kFileExtension)
+        {
+            // 映射只在上传期间保留，上传完成后随 cooked 析构释放
+            auto cooked = image::cooked::CookedTexture::open(filePath);
+            if (!cooked.has_value())
+            {
+                fmt::println("TextureManager: 加载烘焙纹理失败: {} - {}", filePath, cooked.error());
+                return TextureHandle{};
+            }
+            return CreateTextureFromCooked(*cooked);
+        }
+
+        if (!shine::EngineContext::IsInitialized()) return TextureHandle{};
+
+        auto assetHandle = shine::EngineContext::Get().GetSystem<manager::AssetManager>()->LoadTextureAsset(filePath);
+        if (!assetHandle.isValid())
+        {
+            fmt::println("TextureManager: 加载图片失败: {}", filePath);
+            return TextureHandle{};
+        }
+
+        return CreateTextureFromAsset(assetHandle);
+    }
+
     void TextureManager::ReleaseTexture(const TextureHandle& handle)
     {
         if (!handle.isValid())
@@ -196,8 +432,21 @@ namespace shine::render
             return;
         }
 
+        auto it = textures_.find(handle.id);
+        if (it == textures_.end())
+        {
+            return;
+        }
+
+        // 压缩纹理无法按RGBA子区域更新
+        if (it->second.format != image::TextureFormat::RGBA)
+        {
+            fmt::println("TextureManager: 压缩纹理不支持 UpdateTexture，请重新创建");
+            return;
+        }
+
         // 更新纹理数据
-        renderBackend_->UpdateTexture2D(handle.id, width, height, data);
+        renderBackend_->UpdateTexture2D(it->second.textureId, width, height, data);
     }
 
     bool TextureManager::GetTextureSize(const TextureHandle& handle, int& width, int& height) const
@@ -230,6 +479,12 @@ namespace shine::render
         info.width = static_cast<int>(texture.getWidth());
         info.height = static_cast<int>(texture.getHeight());
         info.data = texture.getData().data();
+        if (texture.isCompressed())
+        {
+            info.format = texture.getFormat();
+            info.data = texture.getCompressedData().data();
+            info.dataSize = texture.getCompressedData().size();
+        }
         info.generateMipmaps = false; // 可以从 texture 获取设置
         info.linearFilter = true;     // 可以从 texture 获取设置
         info.clampToEdge = true;      // 可以从 texture 获取设置
@@ -256,10 +511,8 @@ namespace shine::render
 
         for (const auto& pair : textures_)
         {
-            const auto& textureData = pair.second;
-            // 估算内存使用：RGBA8 格式，每像素4字节，加上可能的mipmap（估算为1.33倍）
-            size_t pixelCount = static_cast<size_t>(textureData.width) * static_cast<size_t>(textureData.height);
-            totalMemory += pixelCount * 4 * 4 / 3; // RGBA8 = 4字节/像素，mipmap估算为1.33倍
+            // 创建时按实际格式估算（RGBA8 含mipmap估算，压缩纹理为压缩块大小）
+            totalMemory += pair.second.memoryBytes;
         }
     }
 
@@ -4,6 +4,8 @@
 #include <unordered_map>
 #include <cstdint>
 #include "render/resources/texture_handle.h"
+#include "image/Texture.h"
+#include "image/cooked_texture.h"
 #include "manager/AssetManager.h"
 // #include "util/singleton.h"
 #include "EngineCore/subsystem.h"
@@ -30,8 +32,11 @@ namespace shine::render
     {
         int width = 0;
         int height = 0;
-        const void* data = nullptr;  // RGBA数据，每像素4字节
-        bool generateMipmaps = false;
+        const void* data = nullptr;  // RGBA数据，每像素4字节；压缩格式时为按行排列的压缩块
+        image::TextureFormat format = image::TextureFormat::RGBA;  // RGBA 或 BC1/BC3/BC4/BC5/BC7
+        size_t dataSize = 0;         // 压缩格式时的数据字节数（RGBA 时忽略）
+        bool generateMipmaps = false; // 压缩格式或提供 mipChain 时忽略
+        const image::mip::MipChain* mipChain = nullptr;  // CPU 生成的第 1 级起的 mip 链（仅 RGBA），非空时逐级上传
         bool linearFilter = true;    // true=LINEAR, false=NEAREST
         bool clampToEdge = true;     // true=CLAMP_TO_EDGE, false=REPEAT
     };
@@ -62,7 +67,9 @@ namespace shine::render
         TextureHandle CreateTextureFromAsset(const manager::AssetHandle& assetHandle);
 
         /**
-         * @brief 从RGBA数据创建纹理
+         * @brief 从RGBA或块压缩数据创建纹理
+         * 后端不支持该压缩格式时，在CPU上解压为RGBA再上传；
+         * 提供 mipChain 时从最小级开始逐级上传，后端不支持按级上传时退回驱动生成mipmap
          * @param info 纹理创建信息
          * @return 纹理句柄，失败返回无效句柄
          */
@@ -70,11 +77,23 @@ namespace shine::render
 
         /**
          * @brief 从文件路径创建纹理（自动加载并创建）
+         * .stex 烘焙纹理通过文件映射直接上传各级，其他格式经 AssetManager 解码
          * @param filePath 图片文件路径
          * @return 纹理句柄，失败返回无效句柄
          */
         TextureHandle CreateTextureFromFile(const std::string& filePath);
 
+        /**
+         * @brief 从烘焙纹理创建纹理
+         * 各级数据直接从映射的文件页上传，不解码也不拷贝；后端不支持该压缩格式时在CPU上逐级解压
+         * @param cooked 已打开的烘焙纹理
+         * @param linearFilter 是否使用线性过滤
+         * @param clampToEdge 是否使用CLAMP_TO_EDGE（否则使用REPEAT）
+         * @return 纹理句柄，失败返回无效句柄
+         */
+        TextureHandle CreateTextureFromCooked(const image::cooked::CookedTexture& cooked,
+            bool linearFilter = true, bool clampToEdge = true);
+
         /**
          * @brief 从内存数据创建纹理（自动加载并创建）
          * @param data 图片数据
@@ -88,7 +107,7 @@ namespace shine::render
         TextureHandle CreateTextureFromImage(image::STexture& texture);
 
         /**
-         * @brief 更新纹理数据
+         * @brief 更新纹理数据（仅RGBA纹理，压缩纹理需重新创建）
          * @param handle 纹理句柄
          * @param data 新的纹理数据（RGBA格式）
          * @param width 纹理宽度
@@ -159,6 +178,31 @@ namespace shine::render
         TextureHandle GetTextureHandleByAsset(const manager::AssetHandle& assetHandle) const;
 
     private:
+        /**
+         * @brief 一级 mip 的数据（指向 MipChain 或映射的烘焙文件）
+         */
+        struct MipLevelView
+        {
+            int width = 0;
+            int height = 0;
+            const void* data = nullptr;
+            size_t size = 0;
+        };
+
+        /**
+         * @brief 创建纹理并逐级上传 mip 链
+         * @param info 第 0 级的创建信息（RGBA 或块压缩）
+         * @param levels 第 1 级起的各级数据，格式与第 0 级相同
+         * @return 纹理ID，失败返回0
+         */
+        uint32_t CreateTextureWithMips(const TextureCreateInfo& info, const std::vector<MipLevelView>& levels);
+
+        /**
+         * @brief 登记已创建的后端纹理并分配句柄
+         */
+        TextureHandle RegisterTexture(uint32_t textureId, int width, int height, image::TextureFormat format,
+            size_t memoryBytes);
+
         /**
          * @brief 内部纹理数据
          */
@@ -167,6 +211,8 @@ namespace shine::render
             uint32_t textureId = 0;  // API特定的纹理ID
             int width = 0;
             int height = 0;
+            image::TextureFormat format = image::TextureFormat::RGBA;  // GPU 端实际格式
+            size_t memoryBytes = 0;  // 显存占用估算
             manager::AssetHandle assetHandle;  // 关联的资源句柄（如果有）
         };
 
@@ -30,7 +30,7 @@ namespace shine::util
 		 * @param data 数据指针
 		 * @param size 数据大小（字节）
 		 */
-		explicit BitReader(const u8* data, u8 size) noexcept
+		explicit BitReader(const u8* data, size_t size) noexcept
 			: data_(data), size_(size), bitPos_(0), buffer_(0)
 		{
 			bitsize_ = (size < (S64_MAX / 8)) ? size * 8 : S64_MAX;
@@ -64,11 +64,19 @@ namespace shine::util
 
 		/**
 		 * @brief 推进位指针
-		 * @param nbits 要推进的位数
+		 * @param nbits 要推进的位数（可超过 32，如跳过无压缩块的整段数据）
 		 */
 		void advanceBits(size_t nbits) noexcept
 		{
-			buffer_ >>= nbits;
+			// 移位数不小于缓冲区位宽是未定义行为，此时缓冲区内容全部作废
+			if (nbits >= 32)
+			{
+				buffer_ = 0;
+			}
+			else
+			{
+				buffer_ >>= nbits;
+			}
 			bitPos_ += nbits;
 		}
 
@@ -0,0 +1,773 @@
+#include "deflate.h"
+#include "deflate_tables.h"
+#include "inflate.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <queue>
+
+namespace shine::util
+{
+	namespace
+	{
+		using namespace deflate;
+
+		constexpr size_t CHUNK_SIZE = 256 * 1024;          ///< 分块大小（并行压缩的粒度）
+		constexpr size_t MAX_BLOCK_TOKENS = 1u << 15;      ///< 每个 Deflate 块最多的符号数
+		constexpr size_t MAX_STORED_BLOCK = 65535;
+		constexpr uint32_t MIN_MATCH = 3;
+		constexpr uint32_t HASH_BITS = 15;
+		constexpr uint32_t WINDOW_MASK = WINDOW_SIZE - 1;
+		constexpr uint32_t NUM_LITLEN_USED = 286;          ///< 286/287 不会出现在数据中
+		constexpr uint32_t NUM_DIST_USED = 30;
+
+		struct LevelParams
+		{
+			uint32_t maxChain;      ///< 哈希链最多检查的候选数
+			uint32_t goodLength;    ///< 已有匹配不短于该长度时只检查 1/4 的候选
+			uint32_t niceLength;    ///< 达到该长度即停止搜索
+			uint32_t lazyLimit;     ///< 匹配短于该长度时尝试下一个位置（0 表示贪心）
+			bool insertInMatch;     ///< 是否为匹配内部的位置插入哈希
+		};
+
+		constexpr LevelParams levelParams(DeflateLevel level) noexcept
+		{
+			return level == DeflateLevel::Fast
+				? LevelParams{ 4, 4, 16, 0, false }
+				: LevelParams{ 128, 8, 128, 16, true };
+		}
+
+		/**
+		 * @brief LSB 优先的位写入器（64 位累加器，满 32 位写出）
+		 */
+		class BitWriter
+		{
+		public:
+			explicit BitWriter(std::vector<uint8_t>& out) : _out(out) {}
+
+			void put(uint32_t bits, uint32_t count)
+			{
+				_acc |= static_cast<uint64_t>(bits) << _count;
+				_count += count;
+				if (_count >= 32)
+				{
+					const uint8_t bytes[4] = {
+						static_cast<uint8_t>(_acc), static_cast<uint8_t>(_acc >> 8),
+						static_cast<uint8_t>(_acc >> 16), static_cast<uint8_t>(_acc >> 24) };
+					_out.insert(_out.end(), bytes, bytes + 4);
+					_acc >>= 32;
+					_count -= 32;
+				}
+			}
+
+			// 补 0 到字节边界并写出累加器中的剩余位
+			void align()
+			{
+				while (_count > 0)
+				{
+					_out.push_back(static_cast<uint8_t>(_acc));
+					_acc >>= 8;
+					_count = _count > 8 ? _count - 8 : 0;
+				}
+				_acc = 0;
+			}
+
+			std::vector<uint8_t>& bytes() { return _out; }
+
+		private:
+			std::vector<uint8_t>& _out;
+			uint64_t _acc = 0;
+			uint32_t _count = 0;
+		};
+
+		/// 匹配长度（3-258）到长度码（257-285）的映射
+		constexpr auto LENGTH_SYMBOL = []
+		{
+			std::array<uint16_t, MAX_MATCH_LENGTH + 1> table{};
+			for (uint32_t i = 0; i < 29; ++i)
+			{
+				const uint32_t last = (i == 28) ? MAX_MATCH_LENGTH : LENGTHBASE[i + 1] - 1u;
+				for (uint32_t len = LENGTHBASE[i]; len <= last; ++len)
+				{
+					table[len] = static_cast<uint16_t>(FIRST_LENGTH_CODE_INDEX + i);
+				}
+			}
+			table[MAX_MATCH_LENGTH] = LAST_LENGTH_CODE_INDEX;
+			return table;
+		}();
+
+		constexpr uint32_t distanceSymbol(uint32_t distance) noexcept
+		{
+			if (distance <= 4)
+			{
+				return distance - 1;
+			}
+			const uint32_t log2 = static_cast<uint32_t>(std::bit_width(distance - 1)) - 1;
+			return 2 * log2 + (((distance - 1) >> (log2 - 1)) & 1);
+		}
+
+		struct Token
+		{
+			uint16_t litlen;    ///< 字面量，或匹配长度（distance != 0 时）
+			uint16_t distance;  ///< 0 表示字面量
+		};
+
+		/**
+		 * @brief 由频率构建长度不超过 maxLength 的 Huffman 码长
+		 *
+		 * 超出上限时把频率减半（保持非 0）后重建，直到满足限制。
+		 * 只有一个符号时再补一个符号，保证码是完整的。
+		 */
+		void buildCodeLengths(const uint32_t* freqs, uint32_t count, uint32_t maxLength, uint8_t* lengths)
+		{
+			std::array<uint32_t, NUM_DEFLATE_CODE_SYMBOLS> work{};
+			std::copy(freqs, freqs + count, work.begin());
+
+			uint32_t used = 0;
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				used += work[i] != 0;
+			}
+			if (used < 2)
+			{
+				// 补充符号使码完整（1 位码各占一半）
+				for (uint32_t i = 0; i < count && used < 2; ++i)
+				{
+					if (work[i] == 0)
+					{
+						work[i] = 1;
+						++used;
+					}
+				}
+			}
+
+			using Node = std::pair<uint64_t, uint32_t>;
+			std::array<uint32_t, NUM_DEFLATE_CODE_SYMBOLS * 2> parent{};
+			for (;;)
+			{
+				std::priority_queue<Node, std::vector<Node>, std::greater<>> heap;
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					if (work[i]) heap.push({ work[i], i });
+				}
+
+				uint32_t next = count;
+				while (heap.size() > 1)
+				{
+					const auto [fa, a] = heap.top();
+					heap.pop();
+					const auto [fb, b] = heap.top();
+					heap.pop();
+					parent[a] = parent[b] = next;
+					heap.push({ fa + fb, next++ });
+				}
+				const uint32_t root = next - 1;
+
+				// 内部节点编号递增，按逆序计算深度
+				std::array<uint8_t, NUM_DEFLATE_CODE_SYMBOLS * 2> depth{};
+				for (uint32_t node = root; node-- > count;)
+				{
+					depth[node] = static_cast<uint8_t>(depth[parent[node]] + 1);
+				}
+
+				bool fits = true;
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					lengths[i] = work[i] ? static_cast<uint8_t>(depth[parent[i]] + 1) : 0;
+					fits &= lengths[i] <= maxLength;
+				}
+				if (fits)
+				{
+					return;
+				}
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					if (work[i]) work[i] = (work[i] + 1) / 2;
+				}
+			}
+		}
+
+		/**
+		 * @brief 由码长生成按位反转的规范 Huffman 码（可直接 LSB 优先写出）
+		 */
+		void buildCodes(const uint8_t* lengths, uint32_t count, uint16_t* codes)
+		{
+			uint32_t lengthCount[MAX_CODE_LENGTH + 1] = {};
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				++lengthCount[lengths[i]];
+			}
+			lengthCount[0] = 0;
+
+			uint32_t nextCode[MAX_CODE_LENGTH + 1] = {};
+			for (uint32_t len = 1, code = 0; len <= MAX_CODE_LENGTH; ++len)
+			{
+				code = (code + lengthCount[len - 1]) << 1;
+				nextCode[len] = code;
+			}
+
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				const uint32_t len = lengths[i];
+				if (len == 0) continue;
+				uint32_t code = nextCode[len]++;
+				uint32_t reversed = 0;
+				for (uint32_t b = 0; b < len; ++b)
+				{
+					reversed = (reversed << 1) | (code & 1);
+					code >>= 1;
+				}
+				codes[i] = static_cast<uint16_t>(reversed);
+			}
+		}
+
+		/**
+		 * @brief 压缩一个分块 [begin, end)，输出以字节对齐结尾
+		 */
+		class ChunkCompressor
+		{
+		public:
+			ChunkCompressor(std::span<const uint8_t> input, size_t begin, size_t end, bool last, DeflateLevel level,
+				std::vector<uint8_t>& out)
+				: _input(input), _begin(begin), _end(end), _last(last), _level(level)
+				, _params(levelParams(level)), _writer(out)
+			{
+			}
+
+			void compress()
+			{
+				if (_level == DeflateLevel::Store)
+				{
+					writeStored(_begin, _end, _last);
+				}
+				else
+				{
+					compressLz77();
+				}
+
+				if (!_last)
+				{
+					// sync flush：空的无压缩块，使本段以字节边界结束
+					_writer.put(0, 3);
+					_writer.align();
+					_writer.put(0x0000, 16);
+					_writer.put(0xFFFF, 16);
+				}
+				_writer.align();
+			}
+
+		private:
+			uint32_t hashAt(size_t pos) const noexcept
+			{
+				const uint8_t* p = _input.data() + pos;
+				const uint32_t v = p[0] | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16);
+				return (v * 2654435761u) >> (32 - HASH_BITS);
+			}
+
+			void insert(size_t pos) noexcept
+			{
+				if (pos + MIN_MATCH > _input.size()) return;
+				const uint32_t h = hashAt(pos);
+				_prev[pos & WINDOW_MASK] = _head[h];
+				_head[h] = static_cast<int64_t>(pos);
+			}
+
+			uint32_t matchLength(const uint8_t* a, const uint8_t* b, uint32_t limit) const noexcept
+			{
+				uint32_t len = 0;
+				while (len + 8 <= limit)
+				{
+					uint64_t x, y;
+					std::memcpy(&x, a + len, 8);
+					std::memcpy(&y, b + len, 8);
+					const uint64_t diff = x ^ y;
+					if (diff != 0)
+					{
+						if constexpr (std::endian::native == std::endian::little)
+						{
+							return len + static_cast<uint32_t>(std::countr_zero(diff)) / 8;
+						}
+						else
+						{
+							return len + static_cast<uint32_t>(std::countl_zero(diff)) / 8;
+						}
+					}
+					len += 8;
+				}
+				while (len < limit && a[len] == b[len]) ++len;
+				return len;
+			}
+
+			// 在哈希链上查找 pos 处长于 prevLength 的最长匹配（不超过分块末尾）
+			std::pair<uint32_t, uint32_t> findMatch(size_t pos, uint32_t prevLength) const noexcept
+			{
+				const uint32_t limit = static_cast<uint32_t>(std::min<size_t>(MAX_MATCH_LENGTH, _end - pos));
+				if (limit < MIN_MATCH)
+				{
+					return { 0, 0 };
+				}
+
+				const uint8_t* cur = _input.data() + pos;
+				uint32_t bestLength = std::max(MIN_MATCH - 1, prevLength);
+				if (bestLength >= limit)
+				{
+					return { 0, 0 };
+				}
+				uint32_t bestDistance = 0;
+				uint32_t chain = prevLength >= _params.goodLength ? _params.maxChain >> 2 : _params.maxChain;
+				int64_t candidate = _head[hashAt(pos)];
+				for (; chain > 0 && candidate >= 0; --chain)
+				{
+					const size_t distance = pos - static_cast<size_t>(candidate);
+					if (distance == 0 || distance > WINDOW_SIZE || static_cast<size_t>(candidate) < _windowStart)
+					{
+						break;
+					}
+
+					const uint8_t* ref = _input.data() + candidate;
+					if (ref[bestLength] == cur[bestLength] && ref[0] == cur[0])
+					{
+						const uint32_t length = matchLength(cur, ref, limit);
+						if (length > bestLength)
+						{
+							bestLength = length;
+							bestDistance = static_cast<uint32_t>(distance);
+							if (length >= std::min(limit, _params.niceLength)) break;
+						}
+					}
+
+					const int64_t next = _prev[candidate & WINDOW_MASK];
+					if (next >= candidate) break;
+					candidate = next;
+				}
+
+				return bestDistance ? std::pair{ bestLength, bestDistance } : std::pair{ 0u, 0u };
+			}
+
+			void emitLiteral(size_t pos)
+			{
+				_tokens.push_back({ _input[pos], 0 });
+				++_litFreq[_input[pos]];
+			}
+
+			void emitMatch(uint32_t length, uint32_t distance)
+			{
+				_tokens.push_back({ static_cast<uint16_t>(length), static_cast<uint16_t>(distance) });
+				++_litFreq[LENGTH_SYMBOL[length]];
+				++_distFreq[distanceSymbol(distance)];
+			}
+
+			void insertRange(size_t from, size_t to)
+			{
+				if (!_params.insertInMatch) return;
+				for (size_t p = from; p < to; ++p) insert(p);
+			}
+
+			void compressLz77()
+			{
+				_head.assign(size_t{1} << HASH_BITS, -1);
+				_prev.assign(WINDOW_SIZE, -1);
+				_tokens.reserve(MAX_BLOCK_TOKENS + 1);
+
+				// 字典预热：用前一分块末尾的窗口填充哈希表
+				_windowStart = _begin > WINDOW_SIZE ? _begin - WINDOW_SIZE : 0;
+				for (size_t p = _windowStart; p < _begin; ++p) insert(p);
+
+				_blockStart = _begin;
+				size_t pos = _begin;
+				uint32_t prevLength = 0, prevDistance = 0;
+
+				while (pos < _end)
+				{
+					const auto [length, distance] = findMatch(pos, prevLength);
+					insert(pos);
+
+					if (prevLength != 0)
+					{
+						// 上一位置的匹配等待比较（惰性匹配）
+						if (length > prevLength)
+						{
+							emitLiteral(pos - 1);
+							prevLength = length;
+							prevDistance = distance;
+							++pos;
+						}
+						else
+						{
+							emitMatch(prevLength, prevDistance);
+							insertRange(pos + 1, pos - 1 + prevLength);
+							pos = pos - 1 + prevLength;
+							prevLength = 0;
+						}
+					}
+					else if (length >= MIN_MATCH)
+					{
+						if (length < _params.lazyLimit)
+						{
+							prevLength = length;
+							prevDistance = distance;
+							++pos;
+						}
+						else
+						{
+							emitMatch(length, distance);
+							insertRange(pos + 1, pos + length);
+							pos += length;
+						}
+					}
+					else
+					{
+						emitLiteral(pos);
+						++pos;
+					}
+
+					if (_tokens.size() >= MAX_BLOCK_TOKENS && prevLength == 0)
+					{
+						flushBlock(pos, false);
+					}
+				}
+
+				if (prevLength != 0)
+				{
+					emitMatch(prevLength, prevDistance);
+				}
+				flushBlock(_end, _last);
+			}
+
+			// 把当前符号输出为一个 Deflate 块，选择动态/固定/无压缩中最短的编码
+			void flushBlock(size_t blockEnd, bool final)
+			{
+				++_litFreq[END_OF_BLOCK];
+
+				// 动态 Huffman
+				uint8_t litLengths[NUM_DEFLATE_CODE_SYMBOLS] = {};
+				uint8_t distLengths[NUM_DISTANCE_SYMBOLS] = {};
+				buildCodeLengths(_litFreq.data(), NUM_LITLEN_USED, MAX_CODE_LENGTH, litLengths);
+				buildCodeLengths(_distFreq.data(), NUM_DIST_USED, MAX_CODE_LENGTH, distLengths);
+				const DynamicHeader header = buildHeader(litLengths, distLengths);
+				const uint64_t dynamicBits = 3 + header.bits + dataBits(litLengths, distLengths);
+
+				// 固定 Huffman
+				uint8_t fixedLit[NUM_DEFLATE_CODE_SYMBOLS];
+				uint8_t fixedDist[NUM_DISTANCE_SYMBOLS];
+				std::fill(fixedLit, fixedLit + 144, uint8_t{8});
+				std::fill(fixedLit + 144, fixedLit + 256, uint8_t{9});
+				std::fill(fixedLit + 256, fixedLit + 280, uint8_t{7});
+				std::fill(fixedLit + 280, fixedLit + 288, uint8_t{8});
+				std::fill(fixedDist, fixedDist + NUM_DISTANCE_SYMBOLS, uint8_t{5});
+				const uint64_t fixedBits = 3 + dataBits(fixedLit, fixedDist);
+
+				// 无压缩（对齐填充按最坏情况 7 位估计）
+				const size_t rawSize = blockEnd - _blockStart;
+				const size_t storedBlocks = std::max<size_t>(1, (rawSize + MAX_STORED_BLOCK - 1) / MAX_STORED_BLOCK);
+				const uint64_t storedBits = static_cast<uint64_t>(rawSize + storedBlocks * 4) * 8 + storedBlocks * 10;
+
+				if (storedBits <= fixedBits && storedBits <= dynamicBits)
+				{
+					writeStored(_blockStart, blockEnd, final);
+				}
+				else if (fixedBits <= dynamicBits)
+				{
+					_writer.put(final ? 1 : 0, 1);
+					_writer.put(1, 2);
+					writeTokens(fixedLit, fixedDist);
+				}
+				else
+				{
+					_writer.put(final ? 1 : 0, 1);
+					_writer.put(2, 2);
+					writeHeader(header);
+					writeTokens(litLengths, distLengths);
+				}
+
+				_tokens.clear();
+				_litFreq.fill(0);
+				_distFreq.fill(0);
+				_blockStart = blockEnd;
+			}
+
+			uint64_t dataBits(const uint8_t* litLengths, const uint8_t* distLengths) const noexcept
+			{
+				uint64_t bits = 0;
+				for (uint32_t s = 0; s < NUM_LITLEN_USED; ++s)
+				{
+					if (!_litFreq[s]) continue;
+					uint32_t extra = 0;
+					if (s >= FIRST_LENGTH_CODE_INDEX) extra = LENGTHEXTRA[s - FIRST_LENGTH_CODE_INDEX];
+					bits += static_cast<uint64_t>(_litFreq[s]) * (litLengths[s] + extra);
+				}
+				for (uint32_t s = 0; s < NUM_DIST_USED; ++s)
+				{
+					bits += static_cast<uint64_t>(_distFreq[s]) * (distLengths[s] + DISTANCEEXTRA[s]);
+				}
+				return bits;
+			}
+
+			struct DynamicHeader
+			{
+				uint32_t hlit = 0;
+				uint32_t hdist = 0;
+				uint32_t hclen = 0;
+				std::vector<std::pair<uint8_t, uint8_t>> rle;  ///< (代码长度码, 额外位的值)
+				uint8_t precodeLengths[NUM_CODE_LENGTH_CODES] = {};
+				uint64_t bits = 0;
+			};
+
+			// 行程编码代码长度序列，并构建代码长度码
+			static DynamicHeader buildHeader(const uint8_t* litLengths, const uint8_t* distLengths)
+			{
+				DynamicHeader header;
+				header.hlit = NUM_LITLEN_USED;
+				while (header.hlit > 257 && litLengths[header.hlit - 1] == 0) --header.hlit;
+				header.hdist = NUM_DIST_USED;
+				while (header.hdist > 1 && distLengths[header.hdist - 1] == 0) --header.hdist;
+
+				uint8_t all[NUM_DEFLATE_CODE_SYMBOLS + NUM_DISTANCE_SYMBOLS];
+				std::copy(litLengths, litLengths + header.hlit, all);
+				std::copy(distLengths, distLengths + header.hdist, all + header.hlit);
+				const size_t total = header.hlit + header.hdist;
+
+				uint32_t precodeFreq[NUM_CODE_LENGTH_CODES] = {};
+				for (size_t i = 0; i < total;)
+				{
+					size_t run = 1;
+					while (i + run < total && all[i + run] == all[i]) ++run;
+
+					if (all[i] == 0 && run >= 11)
+					{
+						run = std::min<size_t>(run, 138);
+						header.rle.push_back({ 18, static_cast<uint8_t>(run - 11) });
+					}
+					else if (all[i] == 0 && run >= 3)
+					{
+						header.rle.push_back({ 17, static_cast<uint8_t>(run - 3) });
+					}
+					else if (i > 0 && all[i] == all[i - 1] && run >= 3)
+					{
+						run = std::min<size_t>(run, 6);
+						header.rle.push_back({ 16, static_cast<uint8_t>(run - 3) });
+					}
+					else
+					{
+						run = 1;
+						header.rle.push_back({ all[i], 0 });
+					}
+					++precodeFreq[header.rle.back().first];
+					i += run;
+				}
+
+				buildCodeLengths(precodeFreq, NUM_CODE_LENGTH_CODES, 7, header.precodeLengths);
+
+				header.hclen = NUM_CODE_LENGTH_CODES;
+				while (header.hclen > 4 && header.precodeLengths[CLCL_ORDER[header.hclen - 1]] == 0) --header.hclen;
+
+				header.bits = 5 + 5 + 4 + 3 * header.hclen;
+				for (const auto& [symbol, extra] : header.rle)
+				{
+					header.bits += header.precodeLengths[symbol];
+					header.bits += symbol == 16 ? 2 : symbol == 17 ? 3 : symbol == 18 ? 7 : 0;
+				}
+				return header;
+			}
+
+			void writeHeader(const DynamicHeader& header)
+			{
+				uint16_t precodes[NUM_CODE_LENGTH_CODES] = {};
+				buildCodes(header.precodeLengths, NUM_CODE_LENGTH_CODES, precodes);
+
+				_writer.put(header.hlit - 257, 5);
+				_writer.put(header.hdist - 1, 5);
+				_writer.put(header.hclen - 4, 4);
+				for (uint32_t i = 0; i < header.hclen; ++i)
+				{
+					_writer.put(header.precodeLengths[CLCL_ORDER[i]], 3);
+				}
+				for (const auto& [symbol, extra] : header.rle)
+				{
+					_writer.put(precodes[symbol], header.precodeLengths[symbol]);
+					if (symbol == 16) _writer.put(extra, 2);
+					else if (symbol == 17) _writer.put(extra, 3);
+					else if (symbol == 18) _writer.put(extra, 7);
+				}
+			}
+
+			void writeTokens(const uint8_t* litLengths, const uint8_t* distLengths)
+			{
+				uint16_t litCodes[NUM_DEFLATE_CODE_SYMBOLS] = {};
+				uint16_t distCodes[NUM_DISTANCE_SYMBOLS] = {};
+				buildCodes(litLengths, NUM_DEFLATE_CODE_SYMBOLS, litCodes);
+				buildCodes(distLengths, NUM_DISTANCE_SYMBOLS, distCodes);
+
+				for (const Token& token : _tokens)
+				{
+					if (token.distance == 0)
+					{
+						_writer.put(litCodes[token.litlen], litLengths[token.litlen]);
+						continue;
+					}
+
+					const uint32_t ls = LENGTH_SYMBOL[token.litlen];
+					const uint32_t li = ls - FIRST_LENGTH_CODE_INDEX;
+					_writer.put(litCodes[ls], litLengths[ls]);
+					_writer.put(token.litlen - LENGTHBASE[li], LENGTHEXTRA[li]);
+
+					const uint32_t ds = distanceSymbol(token.distance);
+					_writer.put(distCodes[ds], distLengths[ds]);
+					_writer.put(token.distance - DISTANCEBASE[ds], DISTANCEEXTRA[ds]);
+				}
+				_writer.put(litCodes[END_OF_BLOCK], litLengths[END_OF_BLOCK]);
+			}
+
+			void writeStored(size_t from, size_t to, bool final)
+			{
+				do
+				{
+					const size_t length = std::min(to - from, MAX_STORED_BLOCK);
+					const bool lastPiece = from + length == to;
+					_writer.put(final && lastPiece ? 1 : 0, 1);
+					_writer.put(0, 2);
+					_writer.align();
+					_writer.put(static_cast<uint32_t>(length), 16);
+					_writer.put(static_cast<uint32_t>(length) ^ 0xFFFF, 16);
+					auto& bytes = _writer.bytes();
+					bytes.insert(bytes.end(), _input.begin() + from, _input.begin() + from + length);
+					from += length;
+				} while (from < to);
+			}
+
+			std::span<const uint8_t> _input;
+			size_t _begin;
+			size_t _end;
+			bool _last;
+			DeflateLevel _level;
+			LevelParams _params;
+			BitWriter _writer;
+
+			size_t _windowStart = 0;
+			size_t _blockStart = 0;
+			std::vector<int64_t> _head;
+			std::vector<int64_t> _prev;
+			std::vector<Token> _tokens;
+			std::array<uint32_t, NUM_DEFLATE_CODE_SYMBOLS> _litFreq{};
+			std::array<uint32_t, NUM_DISTANCE_SYMBOLS> _distFreq{};
+		};
+
+		struct ChunkContext
+		{
+			std::span<const uint8_t> input;
+			DeflateLevel level;
+			size_t chunkCount;
+			std::vector<std::vector<uint8_t>> outputs;
+			std::vector<uint32_t> adlers;
+			bool computeAdler;
+		};
+
+		void compressChunk(void* userdata, uint32_t index)
+		{
+			auto& ctx = *static_cast<ChunkContext*>(userdata);
+			const size_t begin = index * CHUNK_SIZE;
+			const size_t end = std::min(ctx.input.size(), begin + CHUNK_SIZE);
+			auto& out = ctx.outputs[index];
+			out.reserve(ctx.level == DeflateLevel::Store ? (end - begin) + (end - begin) / MAX_STORED_BLOCK * 5 + 16
+				: (end - begin) / 2 + 64);
+
+			ChunkCompressor(ctx.input, begin, end, index + 1 == ctx.chunkCount, ctx.level, out).compress();
+			if (ctx.computeAdler)
+			{
+				ctx.adlers[index] = adler32(1, ctx.input.data() + begin, end - begin);
+			}
+		}
+
+		// 压缩全部分块，返回拼接后的原始 Deflate 数据；adler 非空时同时计算 Adler-32
+		std::vector<uint8_t> compressChunks(std::span<const uint8_t> input, DeflateLevel level, DeflateExecutor executor,
+			uint32_t* adler, size_t reserveFront)
+		{
+			ChunkContext ctx;
+			ctx.input = input;
+			ctx.level = level;
+			ctx.chunkCount = std::max<size_t>(1, (input.size() + CHUNK_SIZE - 1) / CHUNK_SIZE);
+			ctx.outputs.resize(ctx.chunkCount);
+			ctx.adlers.resize(ctx.chunkCount, 1);
+			ctx.computeAdler = adler != nullptr;
+
+			if (executor && ctx.chunkCount > 1)
+			{
+				executor(static_cast<uint32_t>(ctx.chunkCount), compressChunk, &ctx);
+			}
+			else
+			{
+				for (uint32_t i = 0; i < ctx.chunkCount; ++i)
+				{
+					compressChunk(&ctx, i);
+				}
+			}
+
+			size_t totalSize = reserveFront;
+			for (const auto& out : ctx.outputs) totalSize += out.size();
+
+			std::vector<uint8_t> result;
+			result.reserve(totalSize + 4);
+			result.resize(reserveFront);
+			for (const auto& out : ctx.outputs)
+			{
+				result.insert(result.end(), out.begin(), out.end());
+			}
+
+			if (adler)
+			{
+				uint32_t combined = 1;
+				for (size_t i = 0; i < ctx.chunkCount; ++i)
+				{
+					const size_t begin = i * CHUNK_SIZE;
+					const size_t length = std::min(input.size(), begin + CHUNK_SIZE) - std::min(input.size(), begin);
+					combined = adler32Combine(combined, ctx.adlers[i], length);
+				}
+				*adler = combined;
+			}
+			return result;
+		}
+	}
+
+	std::vector<uint8_t> deflateRaw(std::span<const uint8_t> input, DeflateLevel level, DeflateExecutor executor)
+	{
+		return compressChunks(input, level, executor, nullptr, 0);
+	}
+
+	std::vector<uint8_t> zlibCompress(std::span<const uint8_t> input, DeflateLevel level, DeflateExecutor executor)
+	{
+		uint32_t adler = 1;
+		std::vector<uint8_t> result = compressChunks(input, level, executor, &adler, 2);
+
+		// CMF: CM=8（Deflate），CINFO=7（32KB 窗口）；FLG: FLEVEL + FCHECK
+		const uint8_t cmf = 0x78;
+		const uint32_t flevel = level == DeflateLevel::Default ? 2 : 0;
+		uint32_t flg = flevel << 6;
+		flg += 31 - ((static_cast<uint32_t>(cmf) << 8) | flg) % 31;
+		result[0] = cmf;
+		result[1] = static_cast<uint8_t>(flg);
+
+		for (int shift = 24; shift >= 0; shift -= 8)
+		{
+			result.push_back(static_cast<uint8_t>(adler >> shift));
+		}
+		return result;
+	}
+
+	uint32_t adler32Combine(uint32_t adler1, uint32_t adler2, size_t length2) noexcept
+	{
+		constexpr uint32_t ADLER_MOD = 65521;
+		const uint32_t rem = static_cast<uint32_t>(length2 % ADLER_MOD);
+		uint32_t sum1 = adler1 & 0xFFFF;
+		uint32_t sum2 = (rem * sum1) % ADLER_MOD;
+		sum1 += (adler2 & 0xFFFF) + ADLER_MOD - 1;
+		sum2 += ((adler1 >> 16) & 0xFFFF) + ((adler2 >> 16) & 0xFFFF) + ADLER_MOD - rem;
+		if (sum1 >= ADLER_MOD) sum1 -= ADLER_MOD;
+		if (sum1 >= ADLER_MOD) sum1 -= ADLER_MOD;
+		if (sum2 >= ADLER_MOD * 2) sum2 -= ADLER_MOD * 2;
+		if (sum2 >= ADLER_MOD) sum2 -= ADLER_MOD;
+		return sum1 | (sum2 << 16);
+	}
+
+} // namespace shine::util
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <span>
+
+/**
+ * @file deflate.h
+ * @brief Deflate/Zlib 压缩（PNG 编码等导出场景使用）
+ *
+ * 输入被切成固定大小的分块，每块独立压缩为以字节对齐结尾的一段 Deflate 数据
+ * （非最后一块以空的无压缩块收尾，即 zlib 的 sync flush），各段直接拼接即为合法的流。
+ * 每块用前一块末尾的 32KB 预填充哈希表（字典预热），因此匹配可以跨越分块边界，
+ * 压缩率与整体串行压缩几乎相同；分块之间没有依赖，可交给调用方注入的执行器并行（pigz 的做法），
+ * 本模块自身不依赖线程库。
+ *
+ * 每个块按动态 Huffman / 固定 Huffman / 无压缩三者中编码后最短的一种输出。
+ *
+ * @see https://www.rfc-editor.org/rfc/rfc1951
+ * @see https://www.rfc-editor.org/rfc/rfc1950
+ */
+
+namespace shine::util
+{
+	/**
+	 * @brief 压缩级别
+	 */
+	enum class DeflateLevel : uint8_t
+	{
+		Store = 0,   ///< 仅使用无压缩块，几乎等同于内存复制
+		Fast,        ///< 短哈希链 + 贪心匹配，匹配内部不插入哈希
+		Default      ///< 长哈希链 + 惰性匹配
+	};
+
+	/**
+	 * @brief 分块执行器：对 [0, count) 中的每个下标调用 task(userdata, index)，全部完成后返回
+	 *
+	 * 由调用方提供并行实现（例如 util::TaskGroup::Run）；为空时在调用线程上串行执行
+	 */
+	using DeflateExecutor = void (*)(uint32_t count, void (*task)(void* userdata, uint32_t index), void* userdata);
+
+	/**
+	 * @brief 压缩为原始 Deflate 数据（RFC 1951，无 zlib 头）
+	 * @param input 原始数据
+	 * @param level 压缩级别
+	 * @param executor 并行压缩各分块的执行器，为空时串行
+	 * @return 压缩后的数据
+	 */
+	std::vector<uint8_t> deflateRaw(std::span<const uint8_t> input,
+		DeflateLevel level = DeflateLevel::Default, DeflateExecutor executor = nullptr);
+
+	/**
+	 * @brief 压缩为 zlib 数据（RFC 1950，含 2 字节头与 Adler-32）
+	 * @param input 原始数据
+	 * @param level 压缩级别
+	 * @param executor 并行压缩各分块的执行器，为空时串行
+	 * @return 压缩后的数据
+	 */
+	std::vector<uint8_t> zlibCompress(std::span<const uint8_t> input,
+		DeflateLevel level = DeflateLevel::Default, DeflateExecutor executor = nullptr);
+
+	/**
+	 * @brief 合并两段数据的 Adler-32
+	 * @param adler1 第一段的校验和
+	 * @param adler2 第二段的校验和（以 1 为初值单独计算）
+	 * @param length2 第二段的长度
+	 * @return 两段拼接后的校验和
+	 */
+	uint32_t adler32Combine(uint32_t adler1, uint32_t adler2, size_t length2) noexcept;
+
+} // namespace shine::util
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @file deflate_tables.h
+ * @brief Deflate (RFC 1951) 公共常量：长度/距离码表、代码长度码顺序
+ *
+ * 解压（inflate.cpp、huffman_decoder.cpp、PNG 流式解压）与压缩（deflate.cpp）共用
+ *
+ * @see https://www.rfc-editor.org/rfc/rfc1951
+ */
+
+namespace shine::util::deflate
+{
+	constexpr uint32_t FIRST_LENGTH_CODE_INDEX = 257;
+	constexpr uint32_t LAST_LENGTH_CODE_INDEX = 285;
+	constexpr uint32_t END_OF_BLOCK = 256;
+	constexpr uint32_t NUM_DEFLATE_CODE_SYMBOLS = 288; ///< 256 个字面量 + 结束码 + 长度码
+	constexpr uint32_t NUM_DISTANCE_SYMBOLS = 32;
+	constexpr uint32_t NUM_CODE_LENGTH_CODES = 19;
+	constexpr uint32_t MAX_CODE_LENGTH = 15;
+	constexpr uint32_t MAX_MATCH_LENGTH = 258;
+	constexpr uint32_t WINDOW_SIZE = 32768;
+	constexpr uint32_t INVALIDSYMBOL = 65535;
+
+	/// 长度码的基础值（代码 257-285）
+	constexpr uint16_t LENGTHBASE[29] = {
+		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59,
+		67, 83, 99, 115, 131, 163, 195, 227, 258
+	};
+
+	/// 长度码的额外位数
+	constexpr uint8_t LENGTHEXTRA[29] = {
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+		4, 4, 4, 4, 5, 5, 5, 5, 0
+	};
+
+	/// 距离码的基础值
+	constexpr uint16_t DISTANCEBASE[30] = {
+		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513,
+		769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+	};
+
+	/// 距离码的额外位数
+	constexpr uint8_t DISTANCEEXTRA[30] = {
+		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8,
+		8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+	};
+
+	/// 代码长度码的顺序
+	constexpr uint8_t CLCL_ORDER[NUM_CODE_LENGTH_CODES] = {
+		16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+	};
+
+} // namespace shine::util::deflate
@@ -1,4 +1,8 @@
 #include "huffman_decoder.h"
+#include "deflate_tables.h"
+
+#include <utility>
+#include <vector>
 
 namespace shine::util
 {
@@ -45,5 +49,181 @@ namespace shine::util
 		}
 	}
 
+	// 从固定树构建 Huffman 树（BTYPE=1）
+	static std::expected<std::pair<HuffmanTree, HuffmanTree>, std::string> buildFixedHuffmanTrees()
+	{
+		// 构建 literal/length 树
+		std::vector<uint32_t> bitlen_ll(deflate::NUM_DEFLATE_CODE_SYMBOLS);
+		for (uint32_t i = 0; i <= 143; ++i) bitlen_ll[i] = 8;
+		for (uint32_t i = 144; i <= 255; ++i) bitlen_ll[i] = 9;
+		for (uint32_t i = 256; i <= 279; ++i) bitlen_ll[i] = 7;
+		for (uint32_t i = 280; i <= 287; ++i) bitlen_ll[i] = 8;
+		
+		auto tree_ll = buildHuffmanTree(bitlen_ll.data(), deflate::NUM_DEFLATE_CODE_SYMBOLS, 15);
+		if (!tree_ll.has_value())
+		{
+			return std::unexpected("构建固定 literal/length 树失败: " + tree_ll.error());
+		}
+		
+		// 构建距离树
+		std::vector<uint32_t> bitlen_d(deflate::NUM_DISTANCE_SYMBOLS, 5);
+		auto tree_d = buildHuffmanTree(bitlen_d.data(), deflate::NUM_DISTANCE_SYMBOLS, 15);
+		if (!tree_d.has_value())
+		{
+			return std::unexpected("构建固定距离树失败: " + tree_d.error());
+		}
+		
+		return std::make_pair(std::move(tree_ll.value()), std::move(tree_d.value()));
+	}
+	
+	// 读取块头部的 Huffman 树（BTYPE=1 固定树，BTYPE=2 动态树）
+	std::expected<void, std::string> readDeflateBlockTrees(
+		BitReader& reader, uint32_t btype, HuffmanTree& tree_ll, HuffmanTree& tree_d)
+	{
+		if (btype == 1)
+		{
+			// 固定树
+			auto trees = buildFixedHuffmanTrees();
+			if (!trees.has_value())
+			{
+				return std::unexpected(trees.error());
+			}
+			tree_ll = std::move(trees->first);
+			tree_d = std::move(trees->second);
+		}
+		else // btype == 2
+		{
+			// 动态树
+			// 检查是否有足够的数据读取头部（至少需要14位：5+5+4）
+			if (!reader.hasMoreData() || reader.remainingBytes() < 2)
+			{
+				return std::unexpected("数据不足：无法读取动态Huffman树头部");
+			}
+
+			
+			// 读取 HLIT, HDIST, HCLEN
+			uint32_t HLIT = reader.readBits(5) + 257;
+			uint32_t HDIST = reader.readBits(5) + 1;
+			uint32_t HCLEN = reader.readBits(4) + 4;
+			
+			if (HLIT > 286 || HDIST > 30)
+			{
+				return std::unexpected("无效的 HLIT 或 HDIST");
+			}
+			
+			// 读取代码长度码的长度
+			std::vector<uint32_t> bitlen_cl(deflate::NUM_CODE_LENGTH_CODES, 0);
+			for (uint32_t i = 0; i < HCLEN; ++i)
+			{
+				uint32_t order = deflate::CLCL_ORDER[i];
+				if (order >= deflate::NUM_CODE_LENGTH_CODES)
+				{
+					return std::unexpected("无效的代码长度码顺序");
+				}
+				bitlen_cl[order] = reader.readBits(3);
+			}
+			
+			// 构建代码长度码的 Huffman 树
+			auto tree_cl_result = buildHuffmanTree(bitlen_cl.data(), deflate::NUM_CODE_LENGTH_CODES, 7);
+			if (!tree_cl_result.has_value())
+			{
+				return std::unexpected("构建代码长度码树失败: " + tree_cl_result.error());
+			}
+			HuffmanTree tree_cl = std::move(tree_cl_result.value());
+			
+			// 解码 literal/length 和 distance 的码长度
+			std::vector<uint32_t> bitlen_ll(HLIT, 0);
+			std::vector<uint32_t> bitlen_d(HDIST, 0);
+			
+			uint32_t i = 0;
+			while (i < HLIT + HDIST)
+			{
+				// 检查是否有足够的数据
+				if (!reader.hasMoreData())
+				{
+					return std::unexpected("数据不足：无法读取代码长度码");
+				}
+				uint32_t code = huffmanDecodeSymbol(reader, tree_cl);
+				
+				if (code == INVALIDSYMBOL)
+				{
+					return std::unexpected("解码代码长度码失败");
+				}
+				
+				uint32_t repeat = 0;
+				uint32_t value = 0;
+				
+				if (code <= 15)
+				{
+					// 直接使用码长度
+					value = code;
+					repeat = 1;
+				}
+				else if (code == 16)
+				{
+					// 重复前一个码长度 3-6 次
+					repeat = reader.readBits(2) + 3;
+					if (i == 0)
+					{
+						return std::unexpected("代码长度码 16 不能是第一个");
+					}
+					value = (i <= HLIT) ? bitlen_ll[i - 1] : bitlen_d[i - HLIT - 1];
+				}
+				else if (code == 17)
+				{
+					// 重复 0 码长度 3-10 次
+					repeat = reader.readBits(3) + 3;
+					value = 0;
+				}
+				else if (code == 18)
+				{
+					// 重复 0 码长度 11-138 次
+					repeat = reader.readBits(7) + 11;
+					value = 0;
+				}
+				else
+				{
+					return std::unexpected("无效的代码长度码: " + std::to_string(code));
+				}
+				
+				// 填充码长度
+				for (uint32_t j = 0; j < repeat && i < HLIT + HDIST; ++j, ++i)
+				{
+					if (i < HLIT)
+					{
+						bitlen_ll[i] = value;
+					}
+					else
+					{
+						bitlen_d[i - HLIT] = value;
+					}
+				}
+			}
+			
+			// 检查结束码必须存在
+			if (bitlen_ll.size() <= 256 || bitlen_ll[256] == 0)
+			{
+				return std::unexpected("结束码 256 的长度必须大于 0");
+			}
+			
+			// 构建 literal/length 和 distance 树
+			auto tree_ll_result = buildHuffmanTree(bitlen_ll.data(), HLIT, 15);
+			if (!tree_ll_result.has_value())
+			{
+				return std::unexpected("构建 literal/length 树失败: " + tree_ll_result.error());
+			}
+			tree_ll = std::move(tree_ll_result.value());
+			
+			auto tree_d_result = buildHuffmanTree(bitlen_d.data(), HDIST, 15);
+			if (!tree_d_result.has_value())
+			{
+				return std::unexpected("构建距离树失败: " + tree_d_result.error());
+			}
+			tree_d = std::move(tree_d_result.value());
+		}
+
+		return {};
+	}
+
 } // namespace shine::util
 
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <expected>
+#include <string>
+
 #include "huffman_tree.h"
 #include "bit_reader.ixx"
 
@@ -14,5 +18,19 @@ namespace shine::util
 	 */
 	uint32_t huffmanDecodeSymbol(BitReader& reader, const HuffmanTree& tree);
 
+	/**
+	 * @brief 读取块头部的 Huffman 树（BTYPE=1 固定树，BTYPE=2 动态树）
+	 * 
+	 * 供逐符号推进的解码器使用（PNG 流式解压、test/InflateTest 中的对照实现）
+	 * 
+	 * @param reader 位读取器（位于 BTYPE 之后）
+	 * @param btype 块类型（1 或 2）
+	 * @param tree_ll 输出 literal/length 树
+	 * @param tree_d 输出距离树
+	 * @return 成功返回 void，失败返回错误信息
+	 */
+	std::expected<void, std::string> readDeflateBlockTrees(
+		BitReader& reader, uint32_t btype, HuffmanTree& tree_ll, HuffmanTree& tree_d);
+
 } // namespace shine::util
 
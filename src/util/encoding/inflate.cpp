@@ -0,0 +1,760 @@
+#include "inflate.h"
+#include "deflate_tables.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <memory>
+
+/**
+ * @file inflate.cpp
+ * @brief 表驱动 Deflate 解压引擎实现
+ *
+ * 查找表项为 32 位，布局：[31:16] 值 | [15:12] 类型 | [11:8] 额外位数（或子表位数） | [7:0] 码字位数。
+ * 一次补充后位缓冲至少有 56 位，足够解码一个 literal/length 码（15 位）+ 长度额外位（5 位）
+ * + 距离码（15 位）+ 距离额外位（13 位），因此每个符号只需补充一次。
+ */
+
+namespace shine::util
+{
+	namespace
+	{
+		using namespace deflate;
+
+		constexpr uint32_t LITLEN_TABLE_BITS = 11;
+		constexpr uint32_t DIST_TABLE_BITS = 8;
+		constexpr uint32_t PRECODE_TABLE_BITS = 7;
+
+		// 每个长码至多新开一张子表，子表大小不超过 2^(15 - 根表位数)
+		constexpr size_t LITLEN_TABLE_SIZE = (size_t{1} << LITLEN_TABLE_BITS) +
+			NUM_DEFLATE_CODE_SYMBOLS * (size_t{1} << (MAX_CODE_LENGTH - LITLEN_TABLE_BITS));
+		constexpr size_t DIST_TABLE_SIZE = (size_t{1} << DIST_TABLE_BITS) +
+			NUM_DISTANCE_SYMBOLS * (size_t{1} << (MAX_CODE_LENGTH - DIST_TABLE_BITS));
+		constexpr size_t PRECODE_TABLE_SIZE = size_t{1} << PRECODE_TABLE_BITS;
+
+		// 输出缓冲区尾部余量：宽匹配复制一次最多多写 15 字节
+		constexpr size_t OUTPUT_SLACK = 32;
+
+		// Deflate 的最大压缩比（258 字节的匹配最少只占约 2 位），用于限制按 sizeHint 预分配的大小
+		constexpr size_t MAX_DEFLATE_RATIO = 1032;
+
+		// 位缓冲中的虚拟 0 字节超过该值说明已经读到数据末尾之后
+		constexpr size_t MAX_OVERREAD = 16;
+
+		enum EntryType : uint32_t
+		{
+			ENTRY_LITERAL = 0,   ///< 一个字面量
+			ENTRY_LITERAL2 = 1,  ///< 两个字面量（低字节在前）
+			ENTRY_BASE = 2,      ///< 长度码或距离码：基础值 + 额外位
+			ENTRY_END = 3,       ///< 块结束码
+			ENTRY_SUBTABLE = 4,  ///< 指向二级子表
+			ENTRY_INVALID = 5    ///< 未使用的码字
+		};
+
+		constexpr uint32_t makeEntry(uint32_t type, uint32_t value, uint32_t extra, uint32_t bits) noexcept
+		{
+			return (value << 16) | (type << 12) | (extra << 8) | bits;
+		}
+
+		constexpr uint32_t entryType(uint32_t e) noexcept { return (e >> 12) & 0xF; }
+		constexpr uint32_t entryValue(uint32_t e) noexcept { return e >> 16; }
+		constexpr uint32_t entryExtra(uint32_t e) noexcept { return (e >> 8) & 0xF; }
+		constexpr uint32_t entryBits(uint32_t e) noexcept { return e & 0xFF; }
+
+		constexpr uint32_t INVALID_ENTRY = makeEntry(ENTRY_INVALID, 0, 0, 0);
+
+		uint32_t litlenEntry(uint32_t sym, uint32_t bits) noexcept
+		{
+			if (sym < 256) return makeEntry(ENTRY_LITERAL, sym, 0, bits);
+			if (sym == END_OF_BLOCK) return makeEntry(ENTRY_END, 0, 0, bits);
+			if (sym <= LAST_LENGTH_CODE_INDEX)
+			{
+				const uint32_t i = sym - FIRST_LENGTH_CODE_INDEX;
+				return makeEntry(ENTRY_BASE, LENGTHBASE[i], LENGTHEXTRA[i], bits);
+			}
+			return makeEntry(ENTRY_INVALID, 0, 0, bits);
+		}
+
+		uint32_t distEntry(uint32_t sym, uint32_t bits) noexcept
+		{
+			if (sym < 30) return makeEntry(ENTRY_BASE, DISTANCEBASE[sym], DISTANCEEXTRA[sym], bits);
+			return makeEntry(ENTRY_INVALID, 0, 0, bits);
+		}
+
+		uint32_t precodeEntry(uint32_t sym, uint32_t bits) noexcept
+		{
+			return makeEntry(ENTRY_LITERAL, sym, 0, bits);
+		}
+
+		uint32_t reverseCode(uint32_t code, uint32_t len) noexcept
+		{
+			uint32_t result = 0;
+			for (uint32_t i = 0; i < len; ++i)
+			{
+				result = (result << 1) | ((code >> i) & 1);
+			}
+			return result;
+		}
+
+		/**
+		 * @brief 从码长度构建两级查找表
+		 *
+		 * 码字按 Deflate 的 LSB 优先顺序反转后作为下标；长于 tableBits 的码放入子表，
+		 * 同一根表前缀的长码共用一张大小为 2^(最长码长 - tableBits) 的子表。
+		 * 允许不完整的码（未使用的表项为 ENTRY_INVALID），超额订阅时返回 false。
+		 */
+		template <typename MakeEntry>
+		bool buildDecodeTable(uint32_t* table, uint32_t tableBits, const uint8_t* lens, uint32_t numSyms,
+			MakeEntry makeSymbolEntry) noexcept
+		{
+			uint32_t count[MAX_CODE_LENGTH + 1] = {};
+			for (uint32_t s = 0; s < numSyms; ++s)
+			{
+				++count[lens[s]];
+			}
+			count[0] = 0;
+
+			int32_t left = 1;
+			for (uint32_t len = 1; len <= MAX_CODE_LENGTH; ++len)
+			{
+				left = (left << 1) - static_cast<int32_t>(count[len]);
+				if (left < 0)
+				{
+					return false;
+				}
+			}
+
+			uint32_t nextCode[MAX_CODE_LENGTH + 1] = {};
+			uint32_t code = 0;
+			for (uint32_t len = 1; len <= MAX_CODE_LENGTH; ++len)
+			{
+				code = (code + count[len - 1]) << 1;
+				nextCode[len] = code;
+			}
+
+			const uint32_t rootSize = 1u << tableBits;
+			std::fill(table, table + rootSize, INVALID_ENTRY);
+
+			std::array<uint32_t, NUM_DEFLATE_CODE_SYMBOLS> codes{};
+			std::array<uint8_t, size_t{1} << LITLEN_TABLE_BITS> subMaxLen{};
+			bool hasLongCodes = false;
+
+			for (uint32_t s = 0; s < numSyms; ++s)
+			{
+				const uint32_t len = lens[s];
+				if (len == 0) continue;
+
+				codes[s] = reverseCode(nextCode[len]++, len);
+				if (len <= tableBits)
+				{
+					const uint32_t e = makeSymbolEntry(s, len);
+					for (uint32_t i = codes[s]; i < rootSize; i += 1u << len)
+					{
+						table[i] = e;
+					}
+				}
+				else
+				{
+					uint8_t& maxLen = subMaxLen[codes[s] & (rootSize - 1)];
+					maxLen = std::max<uint8_t>(maxLen, static_cast<uint8_t>(len));
+					hasLongCodes = true;
+				}
+			}
+
+			if (!hasLongCodes)
+			{
+				return true;
+			}
+
+			// 分配子表
+			uint32_t next = rootSize;
+			for (uint32_t prefix = 0; prefix < rootSize; ++prefix)
+			{
+				if (subMaxLen[prefix] == 0) continue;
+				const uint32_t subBits = subMaxLen[prefix] - tableBits;
+				table[prefix] = makeEntry(ENTRY_SUBTABLE, next, subBits, tableBits);
+				std::fill(table + next, table + next + (1u << subBits), INVALID_ENTRY);
+				next += 1u << subBits;
+			}
+
+			for (uint32_t s = 0; s < numSyms; ++s)
+			{
+				const uint32_t len = lens[s];
+				if (len <= tableBits) continue;
+
+				const uint32_t root = table[codes[s] & (rootSize - 1)];
+				const uint32_t subBits = entryExtra(root);
+				const uint32_t subLen = len - tableBits;
+				const uint32_t e = makeSymbolEntry(s, subLen);
+				for (uint32_t i = codes[s] >> tableBits; i < (1u << subBits); i += 1u << subLen)
+				{
+					table[entryValue(root) + i] = e;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * @brief 把根表中相邻的两个短字面量合并为一个表项
+		 *
+		 * 下标 i 的字面量占用 b1 位后，剩余的 tableBits - b1 位就是下一个码字的开头；
+		 * 若下一个码字也是字面量且不超过剩余位数，就能在同一次查表中一起输出。
+		 * 从高下标向低处理，保证读取到的 table[i >> b1] 仍是单字面量表项。
+		 */
+		void mergeLiteralPairs(uint32_t* table, uint32_t tableBits) noexcept
+		{
+			for (uint32_t i = (1u << tableBits); i-- > 0;)
+			{
+				const uint32_t first = table[i];
+				if (entryType(first) != ENTRY_LITERAL) continue;
+
+				const uint32_t bits1 = entryBits(first);
+				const uint32_t second = table[i >> bits1];
+				if (entryType(second) != ENTRY_LITERAL || entryBits(second) > tableBits - bits1) continue;
+
+				table[i] = makeEntry(ENTRY_LITERAL2, entryValue(first) | (entryValue(second) << 8), 0,
+					bits1 + entryBits(second));
+			}
+		}
+
+		/**
+		 * @brief 64 位位缓冲（LSB 优先）
+		 *
+		 * 距离输入末尾不少于 8 字节时一次读入 8 字节（多余的高位与后续读入的值相同，OR 不影响结果）；
+		 * 接近末尾时逐字节补充，越界部分补 0 并计入 overread，最后据此检查是否用到了不存在的数据。
+		 */
+		struct BitStream
+		{
+			const uint8_t* begin;
+			const uint8_t* in;
+			const uint8_t* end;
+			uint64_t buffer = 0;
+			uint32_t available = 0;
+			size_t overread = 0;
+
+			void refill() noexcept
+			{
+				if (end - in >= 8)
+				{
+					uint64_t word;
+					std::memcpy(&word, in, 8);
+					if constexpr (std::endian::native == std::endian::big)
+					{
+						word = std::byteswap(word);
+					}
+					buffer |= word << available;
+					in += (63 - available) >> 3;
+					available |= 56;
+				}
+				else
+				{
+					while (available <= 56)
+					{
+						uint64_t byte = 0;
+						if (in != end)
+						{
+							byte = *in++;
+						}
+						else
+						{
+							++overread;
+						}
+						buffer |= byte << available;
+						available += 8;
+					}
+				}
+			}
+
+			uint32_t peek(uint32_t n) const noexcept
+			{
+				return static_cast<uint32_t>(buffer & ((uint64_t{1} << n) - 1));
+			}
+
+			void consume(uint32_t n) noexcept
+			{
+				buffer >>= n;
+				available -= n;
+			}
+
+			uint32_t bits(uint32_t n) noexcept
+			{
+				const uint32_t v = peek(n);
+				consume(n);
+				return v;
+			}
+
+			// 丢弃到字节边界，并把缓冲中未使用的整字节退回输入
+			void alignAndRewind() noexcept
+			{
+				consume(available & 7);
+				size_t unusedBytes = available >> 3;
+				const size_t fromOverread = std::min(unusedBytes, overread);
+				overread -= fromOverread;
+				unusedBytes -= fromOverread;
+				in -= unusedBytes;
+				buffer = 0;
+				available = 0;
+			}
+
+			// 是否消耗了输入末尾之后的位
+			bool overrun() const noexcept
+			{
+				return overread * 8 > available;
+			}
+
+			size_t consumedBytes() const noexcept
+			{
+				const size_t bits = static_cast<size_t>(in - begin) * 8 + overread * 8 - available;
+				return (bits + 7) / 8;
+			}
+		};
+
+		struct FixedTables
+		{
+			std::array<uint32_t, size_t{1} << LITLEN_TABLE_BITS> litlen{};
+			std::array<uint32_t, size_t{1} << DIST_TABLE_BITS> dist{};
+
+			FixedTables()
+			{
+				uint8_t lens[NUM_DEFLATE_CODE_SYMBOLS];
+				std::fill(lens, lens + 144, uint8_t{8});
+				std::fill(lens + 144, lens + 256, uint8_t{9});
+				std::fill(lens + 256, lens + 280, uint8_t{7});
+				std::fill(lens + 280, lens + 288, uint8_t{8});
+				buildDecodeTable(litlen.data(), LITLEN_TABLE_BITS, lens, NUM_DEFLATE_CODE_SYMBOLS, litlenEntry);
+				mergeLiteralPairs(litlen.data(), LITLEN_TABLE_BITS);
+
+				uint8_t distLens[NUM_DISTANCE_SYMBOLS];
+				std::fill(distLens, distLens + NUM_DISTANCE_SYMBOLS, uint8_t{5});
+				buildDecodeTable(dist.data(), DIST_TABLE_BITS, distLens, NUM_DISTANCE_SYMBOLS, distEntry);
+			}
+		};
+
+		const FixedTables& fixedTables()
+		{
+			static const FixedTables tables;
+			return tables;
+		}
+
+		/**
+		 * @brief 解压引擎状态（动态块的查找表在各块之间复用）
+		 */
+		class Inflater
+		{
+		public:
+			Inflater(std::span<const uint8_t> input, size_t sizeHint, size_t maxOutput)
+				: _bits{ input.data(), input.data(), input.data() + input.size() }
+				, _maxOutput(maxOutput)
+			{
+				// sizeHint 可能来自不可信的头部（如 IHDR 尺寸），预分配不超过输入能解出的上限，其余按需增长
+				const size_t inputBound = input.size() > SIZE_MAX / MAX_DEFLATE_RATIO - 1024
+					? SIZE_MAX / 2 : input.size() * MAX_DEFLATE_RATIO + 1024;
+				size_t initial = sizeHint ? std::min(sizeHint, inputBound) : std::max<size_t>(input.size() * 4, 1024);
+				if (_maxOutput) initial = std::min(initial, _maxOutput);
+				_out.resize(initial + OUTPUT_SLACK + MAX_MATCH_LENGTH);
+			}
+
+			std::expected<std::vector<uint8_t>, std::string> run(size_t* consumed)
+			{
+				bool final = false;
+				while (!final)
+				{
+					_bits.refill();
+					final = _bits.bits(1) != 0;
+					const uint32_t btype = _bits.bits(2);
+
+					std::expected<void, std::string> result;
+					switch (btype)
+					{
+					case 0:
+						result = storedBlock();
+						break;
+					case 1:
+						result = huffmanBlock(fixedTables().litlen.data(), fixedTables().dist.data());
+						break;
+					case 2:
+						result = readDynamicTables();
+						if (result.has_value())
+						{
+							result = huffmanBlock(_litlen.data(), _dist.data());
+						}
+						break;
+					default:
+						return std::unexpected("无效的 BTYPE");
+					}
+
+					if (!result.has_value())
+					{
+						return std::unexpected(result.error());
+					}
+					if (_bits.overrun())
+					{
+						return std::unexpected("数据不足：压缩数据提前结束");
+					}
+				}
+
+				// 字面量路径按块检查上限，最后一个块可能越过上限不足一个匹配长度
+				if (_maxOutput && _pos > _maxOutput)
+				{
+					return std::unexpected("输出大小超出限制");
+				}
+				if (consumed)
+				{
+					*consumed = _bits.consumedBytes();
+				}
+				_out.resize(_pos);
+				return std::move(_out);
+			}
+
+		private:
+			// 保证至少还能写入 need 字节（含尾部余量）
+			bool reserve(size_t need)
+			{
+				if (_out.size() - _pos >= need + OUTPUT_SLACK)
+				{
+					return true;
+				}
+				if (_maxOutput && _pos + need > _maxOutput + MAX_MATCH_LENGTH)
+				{
+					return false;
+				}
+				_out.resize(std::max(_out.size() * 2, _pos + need + OUTPUT_SLACK));
+				return true;
+			}
+
+			std::expected<void, std::string> storedBlock()
+			{
+				_bits.alignAndRewind();
+				if (_bits.end - _bits.in < 4)
+				{
+					return std::unexpected("无压缩块数据不足");
+				}
+
+				const uint32_t len = _bits.in[0] | (static_cast<uint32_t>(_bits.in[1]) << 8);
+				const uint32_t nlen = _bits.in[2] | (static_cast<uint32_t>(_bits.in[3]) << 8);
+				if ((len ^ 0xFFFF) != nlen)
+				{
+					return std::unexpected("无压缩块长度校验失败");
+				}
+				_bits.in += 4;
+
+				if (static_cast<size_t>(_bits.end - _bits.in) < len)
+				{
+					return std::unexpected("无压缩块数据超出范围");
+				}
+				if (!reserve(len) || (_maxOutput && _pos + len > _maxOutput))
+				{
+					return std::unexpected("输出大小超出限制");
+				}
+
+				std::memcpy(_out.data() + _pos, _bits.in, len);
+				_pos += len;
+				_bits.in += len;
+				return {};
+			}
+
+			std::expected<void, std::string> readDynamicTables()
+			{
+				_bits.refill();
+				const uint32_t hlit = _bits.bits(5) + 257;
+				const uint32_t hdist = _bits.bits(5) + 1;
+				const uint32_t hclen = _bits.bits(4) + 4;
+				if (hlit > 286 || hdist > 30)
+				{
+					return std::unexpected("无效的 HLIT 或 HDIST");
+				}
+
+				uint8_t precodeLens[NUM_CODE_LENGTH_CODES] = {};
+				for (uint32_t i = 0; i < hclen; ++i)
+				{
+					if (_bits.available < 3) _bits.refill();
+					precodeLens[CLCL_ORDER[i]] = static_cast<uint8_t>(_bits.bits(3));
+				}
+
+				std::array<uint32_t, PRECODE_TABLE_SIZE> precode;
+				if (!buildDecodeTable(precode.data(), PRECODE_TABLE_BITS, precodeLens, NUM_CODE_LENGTH_CODES, precodeEntry))
+				{
+					return std::unexpected("构建代码长度码树失败: 码长度超额订阅");
+				}
+
+				uint8_t lens[NUM_DEFLATE_CODE_SYMBOLS + NUM_DISTANCE_SYMBOLS] = {};
+				const uint32_t total = hlit + hdist;
+				uint32_t i = 0;
+				while (i < total)
+				{
+					if (_bits.overread > MAX_OVERREAD)
+					{
+						return std::unexpected("数据不足：无法读取代码长度码");
+					}
+
+					_bits.refill();
+					const uint32_t e = precode[_bits.peek(PRECODE_TABLE_BITS)];
+					if (entryType(e) != ENTRY_LITERAL)
+					{
+						return std::unexpected("解码代码长度码失败");
+					}
+					_bits.consume(entryBits(e));
+
+					const uint32_t sym = entryValue(e);
+					if (sym < 16)
+					{
+						lens[i++] = static_cast<uint8_t>(sym);
+						continue;
+					}
+
+					uint32_t repeat = 0;
+					uint8_t value = 0;
+					if (sym == 16)
+					{
+						if (i == 0)
+						{
+							return std::unexpected("代码长度码 16 不能是第一个");
+						}
+						repeat = 3 + _bits.bits(2);
+						value = lens[i - 1];
+					}
+					else if (sym == 17)
+					{
+						repeat = 3 + _bits.bits(3);
+					}
+					else
+					{
+						repeat = 11 + _bits.bits(7);
+					}
+
+					if (i + repeat > total)
+					{
+						return std::unexpected("代码长度码重复次数超出范围");
+					}
+					std::fill(lens + i, lens + i + repeat, value);
+					i += repeat;
+				}
+
+				if (lens[END_OF_BLOCK] == 0)
+				{
+					return std::unexpected("结束码 256 的长度必须大于 0");
+				}
+
+				uint8_t litlenLens[NUM_DEFLATE_CODE_SYMBOLS] = {};
+				uint8_t distLens[NUM_DISTANCE_SYMBOLS] = {};
+				std::copy(lens, lens + hlit, litlenLens);
+				std::copy(lens + hlit, lens + total, distLens);
+
+				if (!buildDecodeTable(_litlen.data(), LITLEN_TABLE_BITS, litlenLens, NUM_DEFLATE_CODE_SYMBOLS, litlenEntry))
+				{
+					return std::unexpected("构建 literal/length 树失败: 码长度超额订阅");
+				}
+				mergeLiteralPairs(_litlen.data(), LITLEN_TABLE_BITS);
+
+				if (!buildDecodeTable(_dist.data(), DIST_TABLE_BITS, distLens, NUM_DISTANCE_SYMBOLS, distEntry))
+				{
+					return std::unexpected("构建距离树失败: 码长度超额订阅");
+				}
+				return {};
+			}
+
+			std::expected<void, std::string> huffmanBlock(const uint32_t* litlen, const uint32_t* dist)
+			{
+				for (;;)
+				{
+					if (_bits.overread > MAX_OVERREAD)
+					{
+						return std::unexpected("数据不足：无法读取Huffman符号");
+					}
+					if (_out.size() - _pos < MAX_MATCH_LENGTH + OUTPUT_SLACK && !reserve(MAX_MATCH_LENGTH))
+					{
+						return std::unexpected("输出大小超出限制");
+					}
+
+					_bits.refill();
+					uint32_t e = litlen[_bits.peek(LITLEN_TABLE_BITS)];
+					if (entryType(e) == ENTRY_SUBTABLE)
+					{
+						_bits.consume(LITLEN_TABLE_BITS);
+						e = litlen[entryValue(e) + _bits.peek(entryExtra(e))];
+					}
+
+					const uint32_t type = entryType(e);
+					if (type == ENTRY_LITERAL)
+					{
+						_out[_pos++] = static_cast<uint8_t>(entryValue(e));
+						_bits.consume(entryBits(e));
+						continue;
+					}
+					if (type == ENTRY_LITERAL2)
+					{
+						const uint32_t v = entryValue(e);
+						_out[_pos] = static_cast<uint8_t>(v);
+						_out[_pos + 1] = static_cast<uint8_t>(v >> 8);
+						_pos += 2;
+						_bits.consume(entryBits(e));
+						continue;
+					}
+					if (type == ENTRY_END)
+					{
+						_bits.consume(entryBits(e));
+						return {};
+					}
+					if (type != ENTRY_BASE)
+					{
+						return std::unexpected("无效的 Huffman 符号");
+					}
+
+					// 长度/距离对
+					_bits.consume(entryBits(e));
+					const uint32_t length = entryValue(e) + _bits.bits(entryExtra(e));
+
+					uint32_t d = dist[_bits.peek(DIST_TABLE_BITS)];
+					if (entryType(d) == ENTRY_SUBTABLE)
+					{
+						_bits.consume(DIST_TABLE_BITS);
+						d = dist[entryValue(d) + _bits.peek(entryExtra(d))];
+					}
+					if (entryType(d) != ENTRY_BASE)
+					{
+						return std::unexpected("无效的距离码");
+					}
+					_bits.consume(entryBits(d));
+					const uint32_t distance = entryValue(d) + _bits.bits(entryExtra(d));
+
+					if (distance > _pos)
+					{
+						return std::unexpected("距离超出输出缓冲区");
+					}
+
+					copyMatch(_out.data() + _pos, distance, length);
+					_pos += length;
+
+					if (_maxOutput && _pos > _maxOutput)
+					{
+						return std::unexpected("输出大小超出限制");
+					}
+				}
+			}
+
+			// LZ77 匹配复制：距离不小于 8 时按 8/16 字节宽度重叠写入（允许写过 length，落在余量内）
+			static void copyMatch(uint8_t* dst, uint32_t distance, uint32_t length) noexcept
+			{
+				const uint8_t* src = dst - distance;
+				uint8_t* const end = dst + length;
+
+				if (distance >= 16)
+				{
+					do
+					{
+						std::memcpy(dst, src, 16);
+						dst += 16;
+						src += 16;
+					} while (dst < end);
+				}
+				else if (distance >= 8)
+				{
+					do
+					{
+						std::memcpy(dst, src, 8);
+						dst += 8;
+						src += 8;
+					} while (dst < end);
+				}
+				else if (distance == 1)
+				{
+					std::memset(dst, *src, length);
+				}
+				else
+				{
+					// 短距离：逐字节复制形成重复模式
+					while (dst < end)
+					{
+						*dst++ = *src++;
+					}
+				}
+			}
+
+			BitStream _bits;
+			size_t _maxOutput;
+			std::vector<uint8_t> _out;
+			size_t _pos = 0;
+			std::array<uint32_t, LITLEN_TABLE_SIZE> _litlen;
+			std::array<uint32_t, DIST_TABLE_SIZE> _dist;
+		};
+	}
+
+	std::expected<std::vector<uint8_t>, std::string> inflateRaw(
+		std::span<const uint8_t> input, size_t sizeHint, size_t maxOutput, size_t* consumed)
+	{
+		auto inflater = std::make_unique<Inflater>(input, sizeHint, maxOutput);
+		return inflater->run(consumed);
+	}
+
+	std::expected<std::vector<uint8_t>, std::string> zlibInflate(
+		std::span<const uint8_t> input, size_t sizeHint, size_t maxOutput)
+	{
+		if (input.size() < 6)
+		{
+			return std::unexpected("Zlib 数据太小");
+		}
+
+		const uint8_t cmf = input[0];
+		const uint8_t flg = input[1];
+		if (((static_cast<uint32_t>(cmf) << 8) | flg) % 31 != 0)
+		{
+			return std::unexpected("无效的 Zlib 头");
+		}
+		if ((cmf & 0x0F) != 8 || ((cmf >> 4) & 0x0F) > 7)
+		{
+			return std::unexpected("不支持的压缩方法");
+		}
+		if ((flg >> 5) & 0x01)
+		{
+			return std::unexpected("不支持预设字典");
+		}
+
+		auto output = inflateRaw(input.subspan(2, input.size() - 6), sizeHint, maxOutput);
+		if (!output.has_value())
+		{
+			return output;
+		}
+
+		const uint8_t* tail = input.data() + input.size() - 4;
+		const uint32_t expectedAdler = (static_cast<uint32_t>(tail[0]) << 24) | (static_cast<uint32_t>(tail[1]) << 16) |
+			(static_cast<uint32_t>(tail[2]) << 8) | tail[3];
+		const uint32_t calculatedAdler = adler32(1, output->data(), output->size());
+		if (expectedAdler != calculatedAdler)
+		{
+			return std::unexpected("Adler-32 校验失败: 期望=" +
+				std::to_string(expectedAdler) + ", 计算=" + std::to_string(calculatedAdler));
+		}
+		return output;
+	}
+
+	// 算法：s1和s2初始值分别为1和0（即 adler=1）
+	// 对于每个字节：s1 = (s1 + byte) % 65521, s2 = (s2 + s1) % 65521
+	// 最终校验和 = (s2 << 16) | s1
+	uint32_t adler32(uint32_t adler, const uint8_t* data, size_t size) noexcept
+	{
+		constexpr uint32_t ADLER_MOD = 65521;
+		// 延迟模运算：5552 是保证 s2 不溢出 32 位的最大批量（zlib NMAX）
+		constexpr size_t BATCH_SIZE = 5552;
+
+		uint32_t s1 = adler & 0xFFFF;
+		uint32_t s2 = (adler >> 16) & 0xFFFF;
+
+		while (size > 0)
+		{
+			const size_t n = std::min(size, BATCH_SIZE);
+			for (size_t j = 0; j < n; ++j)
+			{
+				s1 += data[j];
+				s2 += s1;
+			}
+			s1 %= ADLER_MOD;
+			s2 %= ADLER_MOD;
+			data += n;
+			size -= n;
+		}
+
+		return (s2 << 16) | s1;
+	}
+
+} // namespace shine::util
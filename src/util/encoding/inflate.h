@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <expected>
+#include <string>
+#include <span>
+
+/**
+ * @file inflate.h
+ * @brief 高吞吐 Deflate/Zlib 解压引擎
+ *
+ * 与逐符号解码的对照实现（test/InflateTest/inflate_reference.h）相比：
+ * - 64 位位缓冲，每个符号（或长度+距离对）只补充一次，快速路径无逐字节边界检查；
+ * - literal/length 查找表为 11 位根表 + 二级子表，一次查表得到最终结果，
+ *   两个短字面量合并在同一个表项中，一次查表输出两个字节；
+ * - 匹配复制使用 8 字节宽的重叠写入（输出缓冲区尾部预留余量）。
+ *
+ * PNG IDAT、zTXt/iTXt 以及其他需要一次性解压的场景都应使用本引擎。
+ *
+ * @see https://www.rfc-editor.org/rfc/rfc1951
+ * @see https://www.rfc-editor.org/rfc/rfc1950
+ */
+
+namespace shine::util
+{
+	/**
+	 * @brief 解压原始 Deflate 数据（RFC 1951，无 zlib 头）
+	 * @param input 压缩数据
+	 * @param sizeHint 预计解压大小（0 表示按输入大小估算），准确时可避免重新分配
+	 * @param maxOutput 输出大小上限（0 表示不限制），超出时返回错误
+	 * @param consumed 可选，返回实际消耗的输入字节数（最后一个块按字节向上取整）
+	 * @return 解压后的数据，失败返回错误信息
+	 */
+	std::expected<std::vector<uint8_t>, std::string> inflateRaw(
+		std::span<const uint8_t> input, size_t sizeHint = 0, size_t maxOutput = 0, size_t* consumed = nullptr);
+
+	/**
+	 * @brief 解压 zlib 数据（RFC 1950）并校验 Adler-32
+	 * @param input zlib 数据（含 2 字节头与 4 字节 Adler-32）
+	 * @param sizeHint 预计解压大小（0 表示按输入大小估算）
+	 * @param maxOutput 输出大小上限（0 表示不限制）
+	 * @return 解压后的数据，失败返回错误信息
+	 */
+	std::expected<std::vector<uint8_t>, std::string> zlibInflate(
+		std::span<const uint8_t> input, size_t sizeHint = 0, size_t maxOutput = 0);
+
+	/**
+	 * @brief Adler-32 增量计算
+	 * @param adler 之前的校验和（初始为 1）
+	 * @param data 数据
+	 * @param size 数据大小
+	 * @return 更新后的校验和
+	 */
+	uint32_t adler32(uint32_t adler, const uint8_t* data, size_t size) noexcept;
+
+} // namespace shine::util
@@ -52,4 +52,12 @@ namespace shine::util::job
             job.fn(job.userdata, job.deltaTime);
         }
     }
+
+    void JobExecutor::operator()(const JobExecuteIndexed& job)
+    {
+        if (job.fn)
+        {
+            job.fn(job.userdata, job.index);
+        }
+    }
 }
@@ -14,5 +14,6 @@ namespace shine::util::job
         void operator()(const JobShutdown& job);
         void operator()(const JobExecuteTaskNode& job);
         void operator()(const JobExecuteTick& job);
+        void operator()(const JobExecuteIndexed& job);
     };
 }
@@ -0,0 +1,115 @@
+#include "job_record.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace shine::util::job
+{
+    namespace
+    {
+        // Records moved between a thread cache and the shared pool per lock
+        constexpr u32 kCacheBatch = 64;
+
+        // Records allocated at once when the shared pool runs dry
+        constexpr u32 kChunkRecords = 1024;
+
+        // A free record reuses its payload storage as the free-list link
+        JobRecord*& NextFree(JobRecord* record) {
+            return *std::launder(reinterpret_cast<JobRecord**>(record->storage));
+        }
+
+        struct RecordList {
+            JobRecord* head = nullptr;
+            u32 count = 0;
+
+            void Push(JobRecord* record) {
+                ::new (static_cast<void*>(record->storage)) JobRecord*(head);
+                head = record;
+                ++count;
+            }
+
+            JobRecord* Pop() {
+                JobRecord* record = head;
+                head = NextFree(record);
+                --count;
+                return record;
+            }
+
+            // Detach the first `n` records as their own list
+            RecordList Split(u32 n) {
+                RecordList front{head, n};
+                JobRecord* last = head;
+                for (u32 i = 1; i < n; ++i) last = NextFree(last);
+                head = NextFree(last);
+                NextFree(last) = nullptr;
+                count -= n;
+                return front;
+            }
+        };
+
+        struct SharedPool {
+            std::mutex mutex;
+            std::vector<RecordList> batches;
+            std::vector<std::unique_ptr<JobRecord[]>> chunks;
+
+            RecordList Acquire() {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!batches.empty()) {
+                    RecordList batch = batches.back();
+                    batches.pop_back();
+                    return batch;
+                }
+
+                chunks.push_back(std::make_unique<JobRecord[]>(kChunkRecords));
+                RecordList fresh;
+                for (u32 i = 0; i < kChunkRecords; ++i) {
+                    fresh.Push(&chunks.back()[i]);
+                }
+                return fresh;
+            }
+
+            void Release(RecordList batch) {
+                if (batch.count == 0) return;
+                std::lock_guard<std::mutex> lock(mutex);
+                batches.push_back(batch);
+            }
+        };
+
+        // Never destroyed: worker threads may still free records during static destruction
+        SharedPool& Shared() {
+            static SharedPool* pool = new SharedPool();
+            return *pool;
+        }
+
+        struct ThreadCache {
+            RecordList free;
+
+            ~ThreadCache() {
+                Shared().Release(free);
+            }
+        };
+
+        thread_local ThreadCache t_cache;
+    }
+
+    JobRecord* AllocateJobRecord() {
+        RecordList& free = t_cache.free;
+        if (free.count == 0) {
+            free = Shared().Acquire();
+        }
+        JobRecord* record = free.Pop();
+        record->invoke = nullptr;
+        record->counter = nullptr;
+        return record;
+    }
+
+    void FreeJobRecord(JobRecord* record) {
+        // Producers allocate and consumers free, so full batches flow back to the shared pool
+        RecordList& free = t_cache.free;
+        free.Push(record);
+        if (free.count >= 2 * kCacheBatch) {
+            Shared().Release(free.Split(kCacheBatch));
+        }
+    }
+}
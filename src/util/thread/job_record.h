@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "util/shine_define.h"
+
+namespace shine::util
+{
+    class JobCounter;
+}
+
+namespace shine::util::job
+{
+    // One queued job: a function pointer plus the callable stored inline, exactly one cache line.
+    //
+    // Any callable up to kInlineSize bytes (a lambda capturing a few pointers, or a legacy
+    // job::Job variant) lives in the record itself, so submitting it allocates nothing.
+    // Larger callables spill to the heap. Records are recycled through AllocateJobRecord /
+    // FreeJobRecord and two of them never share a cache line.
+    struct alignas(64) JobRecord {
+        static constexpr u32 kInlineSize = 48;
+        static constexpr u32 kInlineAlign = 16;
+
+        // Runs the payload, then destroys it
+        void (*invoke)(JobRecord& record) = nullptr;
+        JobCounter* counter = nullptr;
+        alignas(kInlineAlign) std::byte storage[kInlineSize];
+
+        template <typename T>
+        static constexpr bool StoresInline = sizeof(T) <= kInlineSize && alignof(T) <= kInlineAlign;
+
+        template <typename Fn>
+        void Emplace(Fn&& fn) {
+            using T = std::decay_t<Fn>;
+            if constexpr (StoresInline<T>) {
+                ::new (static_cast<void*>(storage)) T(std::forward<Fn>(fn));
+                invoke = [](JobRecord& record) {
+                    T& payload = *std::launder(reinterpret_cast<T*>(record.storage));
+                    payload();
+                    payload.~T();
+                };
+            } else {
+                ::new (static_cast<void*>(storage)) T*(new T(std::forward<Fn>(fn)));
+                invoke = [](JobRecord& record) {
+                    T* payload = *std::launder(reinterpret_cast<T**>(record.storage));
+                    (*payload)();
+                    delete payload;
+                };
+            }
+        }
+
+        void Invoke() { invoke(*this); }
+    };
+
+    static_assert(sizeof(JobRecord) == 64, "JobRecord must fill exactly one cache line");
+
+    // Take a record from the calling thread's cache (refilled from a shared pool in batches)
+    JobRecord* AllocateJobRecord();
+
+    // Return a record whose payload has already been invoked; any thread may free any record
+    void FreeJobRecord(JobRecord* record);
+}
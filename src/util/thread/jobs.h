@@ -40,12 +40,20 @@ namespace shine::util::job
         float deltaTime;
     };
 
+    // Internal Job to execute one index of a TaskGroup
+    struct JobExecuteIndexed {
+        void(*fn)(void*, u32);
+        void* userdata;
+        u32 index;
+    };
+
     // Internal Job to execute a managed task from Scheduler
     struct JobExecuteTaskNode {
         u32 taskId;
     };
 
-    // The Algebraic Data Type for all possible jobs
+    // The Algebraic Data Type for the built-in jobs. New work does not need a type here:
+    // ThreadPool::Submit also takes any callable (see job_record.h)
     using Job = std::variant<
         JobPhysicsStep,
         JobUpdateLogic,
@@ -54,6 +62,7 @@ namespace shine::util::job
         JobCompileShader,
         JobShutdown,
         JobExecuteTaskNode,
-        JobExecuteTick
+        JobExecuteTick,
+        JobExecuteIndexed
     >;
 }
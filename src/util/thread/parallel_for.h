@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include "util/shine_define.h"
+#include "task_group.h"
+
+namespace shine::util
+{
+    // Run fn(chunkBegin, chunkEnd) over [begin, end) split into chunks of `grain` indices.
+    //
+    // One runner per worker (plus the caller) pulls chunks from a shared atomic cursor, so
+    // uneven chunks balance themselves and a busy pool never sees more than GetThreadCount()
+    // jobs. The caller always takes part through TaskGroup::Wait(), which keeps nested use
+    // from a worker thread deadlock-free. Returns after every chunk has run.
+    template <typename Fn>
+    void ParallelForRange(u32 begin, u32 end, u32 grain, Fn&& fn, ThreadPool& pool = ThreadPool::Get())
+    {
+        if (end <= begin) return;
+        grain = std::max(grain, 1u);
+
+        const u32 chunkCount = (end - begin - 1) / grain + 1;
+        const u32 runnerCount = std::min(chunkCount, pool.GetThreadCount() + 1);
+        if (runnerCount <= 1) {
+            fn(begin, end);
+            return;
+        }
+
+        struct Context {
+            Fn* fn;
+            u32 begin;
+            u32 end;
+            u32 grain;
+            u32 chunkCount;
+            std::atomic<u32> next{0};
+        } context{&fn, begin, end, grain, chunkCount};
+
+        auto runner = [](void* userdata, u32) {
+            auto& ctx = *static_cast<Context*>(userdata);
+            for (u32 chunk = ctx.next.fetch_add(1, std::memory_order_relaxed); chunk < ctx.chunkCount;
+                 chunk = ctx.next.fetch_add(1, std::memory_order_relaxed)) {
+                const u32 chunkBegin = ctx.begin + chunk * ctx.grain;
+                const u32 chunkEnd = std::min(ctx.end, chunkBegin + ctx.grain);
+                (*ctx.fn)(chunkBegin, chunkEnd);
+            }
+        };
+
+        TaskGroup group(runnerCount, runner, &context, pool);
+        for (u32 i = 0; i < runnerCount; ++i) {
+            group.Submit(i);
+        }
+        group.Wait();
+    }
+
+    // Run fn(index) for every index in [begin, end), `grain` consecutive indices per chunk
+    template <typename Fn>
+    void ParallelFor(u32 begin, u32 end, u32 grain, Fn&& fn, ThreadPool& pool = ThreadPool::Get())
+    {
+        ParallelForRange(begin, end, grain, [&fn](u32 chunkBegin, u32 chunkEnd) {
+            for (u32 i = chunkBegin; i < chunkEnd; ++i) {
+                fn(i);
+            }
+        }, pool);
+    }
+}
@@ -0,0 +1,115 @@
+#include "task_group.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace shine::util
+{
+    namespace
+    {
+        enum TaskSlot : u8 {
+            Pending = 0,   // not submitted yet
+            Ready = 1,     // submitted, waiting for a thread
+            Claimed = 2    // taken by a worker or the caller
+        };
+    }
+
+    // Queued jobs may be popped after Wait() returned, so the shared state is ref-counted
+    struct TaskGroup::SharedState {
+        SharedState(TaskFn fn, void* userdata, u32 count)
+            : fn(fn), userdata(userdata), count(count), slots(std::make_unique<std::atomic<u8>[]>(count)) {}
+
+        TaskFn fn;
+        void* userdata;
+        u32 count;
+        std::unique_ptr<std::atomic<u8>[]> slots;
+
+        std::atomic<u32> refs{1};
+        std::atomic<u32> completed{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+
+        bool TryClaim(u32 index) {
+            u8 expected = Ready;
+            return slots[index].compare_exchange_strong(expected, Claimed, std::memory_order_acq_rel);
+        }
+
+        void Run(u32 index) {
+            fn(userdata, index);
+            std::lock_guard<std::mutex> lock(mutex);
+            completed.fetch_add(1, std::memory_order_release);
+            finished.notify_all();
+        }
+
+        void Release() {
+            if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+        }
+    };
+
+    TaskGroup::TaskGroup(u32 taskCount, TaskFn fn, void* userdata, ThreadPool& pool)
+        : _state(new SharedState(fn, userdata, taskCount))
+        , _pool(pool)
+    {
+        for (u32 i = 0; i < taskCount; ++i) {
+            _state->slots[i].store(Pending, std::memory_order_relaxed);
+        }
+    }
+
+    TaskGroup::~TaskGroup() {
+        Wait();
+        _state->Release();
+    }
+
+    void TaskGroup::Submit(u32 index) {
+        if (_waited || index >= _state->count) return;
+
+        u8 expected = Pending;
+        if (!_state->slots[index].compare_exchange_strong(expected, Ready, std::memory_order_acq_rel)) {
+            return;
+        }
+        ++_submitted;
+
+        // No workers: Wait() runs everything inline
+        if (_pool.GetThreadCount() == 0) return;
+
+        _state->refs.fetch_add(1, std::memory_order_relaxed);
+        _pool.Submit(job::JobExecuteIndexed{&TaskGroup::ExecuteJob, _state, index});
+    }
+
+    void TaskGroup::Wait() {
+        if (_waited) return;
+        _waited = true;
+
+        // Help out instead of blocking: avoids deadlock when the pool is busy or we are on a worker
+        for (u32 i = 0; i < _state->count; ++i) {
+            if (_state->TryClaim(i)) {
+                _state->Run(i);
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        _state->finished.wait(lock, [this] {
+            return _state->completed.load(std::memory_order_acquire) == _submitted;
+        });
+    }
+
+    void TaskGroup::Run(u32 taskCount, TaskFn fn, void* userdata) {
+        TaskGroup group(taskCount, fn, userdata);
+        for (u32 i = 0; i < taskCount; ++i) {
+            group.Submit(i);
+        }
+        group.Wait();
+    }
+
+    void TaskGroup::ExecuteJob(void* state, u32 index) {
+        auto* shared = static_cast<SharedState*>(state);
+        if (shared->TryClaim(index)) {
+            shared->Run(index);
+        }
+        shared->Release();
+    }
+}
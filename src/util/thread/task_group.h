@@ -0,0 +1,44 @@
+#pragma once
+
+#include "util/shine_define.h"
+#include "thread_pool.h"
+
+namespace shine::util
+{
+    // A fixed set of index-addressed tasks executed by ThreadPool workers and the calling thread.
+    //
+    // Tasks become ready one by one through Submit(index), so a producer can pipeline work.
+    // Wait() claims every submitted task no worker has picked up yet, runs it on the caller,
+    // then blocks on the ones in flight. This keeps nested use from a worker thread deadlock-free.
+    // Indices that were never submitted are never run; callbacks only run before Wait() returns.
+    class TaskGroup {
+    public:
+        using TaskFn = void(*)(void* userdata, u32 index);
+
+        TaskGroup(u32 taskCount, TaskFn fn, void* userdata, ThreadPool& pool = ThreadPool::Get());
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        // Mark task `index` ready and queue it on the pool
+        void Submit(u32 index);
+
+        // Run unclaimed tasks on this thread and wait for all submitted ones (also called by the destructor)
+        void Wait();
+
+        // Submit tasks [0, taskCount) at once and wait for all of them on the global pool. Fits
+        // callers that take a plain parallel-for callback, such as deflate's chunk executor
+        static void Run(u32 taskCount, TaskFn fn, void* userdata);
+
+    private:
+        struct SharedState;
+
+        static void ExecuteJob(void* state, u32 index);
+
+        SharedState* _state;
+        ThreadPool& _pool;
+        u32 _submitted{0};
+        bool _waited{false};
+    };
+}
@@ -1,135 +1,154 @@
 #include "task_scheduler.h"
 #include "job_executor.h"
-#include <algorithm>
+#include <chrono>
+#include <stdexcept>
 
 namespace shine::util
 {
-    TaskScheduler::TaskScheduler()
-        : _threadPool(ThreadPool::Get())
+    namespace
     {
+        // A waiting worker re-checks the queues this often once it has nothing to help with,
+        // matching ThreadPool::WaitForCounter
+        constexpr auto kWorkerPollInterval = std::chrono::microseconds(200);
+    }
+
+    TaskScheduler::TaskScheduler(ThreadPool& pool)
+        : _threadPool(pool)
+    {
+    }
+
+    TaskScheduler::~TaskScheduler() {
+        WaitAll();
     }
 
     TaskHandle TaskScheduler::CreateTask(job::Job job) {
-        std::lock_guard<std::mutex> lock(_mutex);
-        
-        auto node = std::make_unique<TaskNode>();
-        node->job = std::move(job);
-        node->remainingDeps = 0;
-        
-        u32 id = _nextId++;
-        if (id >= _tasks.size()) {
-            _tasks.resize(id + 1);
-        }
-        _tasks[id] = std::move(node);
-        
-        return TaskHandle{id, true};
+        if (_taskCount == kMaxBlocks * kBlockSize)
+            throw std::length_error("TaskScheduler: too many tasks in one frame");
+
+        const u32 id = _taskCount;
+        _nodes.Reserve(id);
+
+        TaskNode& node = _nodes[id];
+        node.job = std::move(job);
+        node.firstDependent = kNoEdge;
+        node.remainingDeps.store(0, std::memory_order_relaxed);
+        node.state.store(Idle, std::memory_order_relaxed);
+
+        // Published to workers by the pool submit that eventually runs it
+        ++_taskCount;
+        return TaskHandle{id, true, _frame};
     }
 
     void TaskScheduler::AddDependency(TaskHandle task, TaskHandle dependsOn) {
-        if (!task.valid || !dependsOn.valid) return;
-        
-        std::lock_guard<std::mutex> lock(_mutex);
-        
-        if (task.id >= _tasks.size() || dependsOn.id >= _tasks.size()) return;
-        
-        auto& taskNode = _tasks[task.id];
-        auto& depNode = _tasks[dependsOn.id];
-        
-        if (!taskNode || !depNode) return;
-        
-        taskNode->dependencies.push_back(dependsOn.id);
-        depNode->dependents.push_back(task.id);
-        ++taskNode->remainingDeps;
+        TaskNode* taskNode = Resolve(task);
+        TaskNode* depNode = Resolve(dependsOn);
+        if (!taskNode || !depNode || task.id == dependsOn.id) return;
+
+        // Finished dependencies never release anyone, so don't wait on them
+        if (depNode->state.load(std::memory_order_acquire) == Done) return;
+
+        if (_edgeCount == kMaxBlocks * kBlockSize)
+            throw std::length_error("TaskScheduler: too many dependencies in one frame");
+
+        const u32 edge = _edgeCount++;
+        _edges.Reserve(edge);
+        _edges[edge] = Edge{task.id, depNode->firstDependent};
+        depNode->firstDependent = edge;
+        taskNode->remainingDeps.fetch_add(1, std::memory_order_relaxed);
     }
 
     void TaskScheduler::Run(TaskHandle task) {
-        if (!task.valid) return;
-        
-        std::lock_guard<std::mutex> lock(_mutex);
-        
-        if (task.id >= _tasks.size() || !_tasks[task.id]) return;
-        
-        auto& node = _tasks[task.id];
-        if (node->remainingDeps == 0 && !node->completed) {
-            // Change: Submit JobExecuteTaskNode
-            _threadPool.Submit(job::JobExecuteTaskNode{task.id});
+        TaskNode* node = Resolve(task);
+        if (!node) return;
+
+        if (node->remainingDeps.load(std::memory_order_acquire) == 0 && TryQueue(*node)) {
+            Dispatch(task.id);
         }
     }
 
     void TaskScheduler::RunAll() {
-        std::lock_guard<std::mutex> lock(_mutex);
-        
-        for (u32 id = 0; id < _tasks.size(); ++id) {
-            if (_tasks[id] && _tasks[id]->remainingDeps == 0 && !_tasks[id]->completed) {
-                // Change: Submit JobExecuteTaskNode
-                _threadPool.Submit(job::JobExecuteTaskNode{id});
+        for (u32 id = 0; id < _taskCount; ++id) {
+            TaskNode& node = _nodes[id];
+            if (node.remainingDeps.load(std::memory_order_acquire) == 0 && TryQueue(node)) {
+                Dispatch(id);
             }
         }
     }
 
     void TaskScheduler::Wait(TaskHandle task) {
-        if (!task.valid) return;
-        
-        while (true) {
-            {
-                std::lock_guard<std::mutex> lock(_mutex);
-                if (task.id < _tasks.size() && _tasks[task.id] && _tasks[task.id]->completed) {
-                    return;
-                }
+        TaskNode* node = Resolve(task);
+        if (!node) return;
+
+        const bool worker = _threadPool.IsWorkerThread();
+        for (u8 state = node->state.load(std::memory_order_acquire); state != Done;
+             state = node->state.load(std::memory_order_acquire)) {
+            // Run other queued jobs instead of idling, so waiting from a worker can't starve the pool
+            if (_threadPool.TryRunOne()) continue;
+
+            // Nothing to help with: the task is running or waiting on dependencies elsewhere.
+            // Other threads sleep until ExecuteTask publishes Done; a worker still polls so a job
+            // submitted meanwhile (possibly the one it waits for) doesn't wait for a free thread
+            if (worker) {
+                std::this_thread::sleep_for(kWorkerPollInterval);
+            } else {
+                node->state.wait(state, std::memory_order_acquire);
             }
-            std::this_thread::yield();
         }
     }
 
     void TaskScheduler::WaitAll() {
-        _threadPool.WaitAll();
+        // A task queues its dependents before its own job completes, so the counter only
+        // reaches zero once the whole dispatched graph has run
+        _threadPool.WaitForCounter(_inFlight);
+    }
+
+    void TaskScheduler::Reset() {
+        WaitAll();
+        _taskCount = 0;
+        _edgeCount = 0;
+        ++_frame;
     }
 
     void TaskScheduler::ExecuteTask(u32 id) {
-        // This function is running on a worker thread (invoked by JobExecutor)
-        // or potentially on main thread if we had a sync run mode (not here).
-
-        job::Job* currentJobPtr = nullptr;
-        
-        // Scope to retrieve job data
-        {
-            std::lock_guard<std::mutex> lock(_mutex);
-            if (id >= _tasks.size() || !_tasks[id]) return;
-            // We shouldn't move the node out, just access the job.
-            // But to avoid holding lock during execution, we should copy the job if possible
-            // or execute while holding lock? No, executing while holding lock is bad.
-            // But std::variant is value type. We can copy it if it's copyable.
-            // Assuming jobs are lightweight.
-            currentJobPtr = &(_tasks[id]->job);
-        }
-        
-        // Execute the job
-        // Note: We use a fresh executor here to visit the *inner* job.
-        if (currentJobPtr) {
+        for (;;) {
+            TaskNode& node = _nodes[id];
             job::JobExecutor executor;
-            std::visit(executor, *currentJobPtr);
-        }
-        
-        // Update completion status and trigger dependents
-        {
-            std::lock_guard<std::mutex> lock(_mutex);
-            if (!_tasks[id]) return;
-            
-            _tasks[id]->completed = true;
-            
-            auto& currentNode = _tasks[id];
-            for (u32 depId : currentNode->dependents) {
-                if (depId < _tasks.size() && _tasks[depId]) {
-                    --_tasks[depId]->remainingDeps;
-                    if (_tasks[depId]->remainingDeps == 0 && !_tasks[depId]->completed) {
-                        // Submit next job
-                        _threadPool.Submit(job::JobExecuteTaskNode{depId});
-                    }
+            std::visit(executor, node.job);
+            node.state.store(Done, std::memory_order_release);
+            node.state.notify_all();
+
+            // Release dependents: queue every newly ready one except the last, which this
+            // thread runs next without a round trip through the pool
+            u32 next = kNoEdge;
+            for (u32 edge = node.firstDependent; edge != kNoEdge; edge = _edges[edge].next) {
+                const u32 dependent = _edges[edge].task;
+                TaskNode& depNode = _nodes[dependent];
+                if (depNode.remainingDeps.fetch_sub(1, std::memory_order_acq_rel) == 1 && TryQueue(depNode)) {
+                    if (next != kNoEdge) Dispatch(next);
+                    next = dependent;
                 }
             }
+
+            if (next == kNoEdge) return;
+            id = next;
         }
     }
 
+    TaskScheduler::TaskNode* TaskScheduler::Resolve(TaskHandle task) const {
+        if (!task.valid || task.frame != _frame || task.id >= _taskCount) return nullptr;
+        return &_nodes[task.id];
+    }
+
+    bool TaskScheduler::TryQueue(TaskNode& node) {
+        u8 expected = Idle;
+        return node.state.compare_exchange_strong(expected, Queued, std::memory_order_acq_rel);
+    }
+
+    void TaskScheduler::Dispatch(u32 id) {
+        // From a worker this lands on its own deque, where idle workers steal it
+        _threadPool.Submit([this, id] { ExecuteTask(id); }, &_inFlight);
+    }
+
     TaskScheduler& TaskScheduler::Get() {
         static TaskScheduler instance;
         return instance;
@@ -1,9 +1,8 @@
 #pragma once
 
-#include <vector>
+#include <array>
 #include <memory>
 #include <atomic>
-#include <mutex>
 #include "util/shine_define.h"
 #include "thread_pool.h"
 #include "jobs.h"
@@ -13,39 +12,95 @@ namespace shine::util
     struct TaskHandle {
         u32 id;
         bool valid = false;
+        u32 frame = 0;  // handles from an earlier frame are ignored
     };
 
+    // Per-frame task graph.
+    //
+    // One thread builds the graph (CreateTask / AddDependency) and dispatches it (Run / RunAll);
+    // execution is lock-free. A finishing task releases its dependents with an atomic decrement,
+    // queues all but one of the newly ready ones on the current worker's deque and runs the last
+    // one inline. Nodes and edges live in block arenas kept across frames, so Reset() recycles
+    // every id and a steady-state frame allocates nothing.
+    //
+    // All edges of a task must be added before the task or any of its dependencies is dispatched.
     class TaskScheduler {
     public:
-        TaskScheduler();
-        ~TaskScheduler() = default;
+        explicit TaskScheduler(ThreadPool& pool = ThreadPool::Get());
+        ~TaskScheduler();
+
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
 
-        // Change: Takes Job variant instead of std::function
         TaskHandle CreateTask(job::Job job);
-        
+
         void AddDependency(TaskHandle task, TaskHandle dependsOn);
         void Run(TaskHandle task);
         void RunAll();
+
+        // Both help by executing queued jobs first and block once there is nothing left to run
         void Wait(TaskHandle task);
         void WaitAll();
 
-        // Change: Made public so JobExecutor can call it
+        // Wait for the current frame, then drop every task and edge; old handles become invalid
+        void Reset();
+
+        u32 GetTaskCount() const { return _taskCount; }
+
+        // Run task `id` and whatever it makes ready (called by JobExecutor for JobExecuteTaskNode)
         void ExecuteTask(u32 id);
 
         static TaskScheduler& Get();
 
     private:
+        static constexpr u32 kBlockShift = 8;
+        static constexpr u32 kBlockSize = 1u << kBlockShift;
+        static constexpr u32 kMaxBlocks = 1024;  // 256K tasks / edges per frame
+        static constexpr u32 kNoEdge = ~0u;
+
+        enum TaskState : u8 {
+            Idle = 0,     // waiting for dependencies or for Run
+            Queued = 1,   // handed to the pool (or running)
+            Done = 2
+        };
+
         struct TaskNode {
-            job::Job job; // Change: Variant instead of std::function
-            std::vector<u32> dependencies;
-            std::vector<u32> dependents;
+            job::Job job;
+            u32 firstDependent = kNoEdge;
             std::atomic<u32> remainingDeps{0};
-            std::atomic<bool> completed{false};
+            std::atomic<u8> state{Idle};
         };
 
-        u32 _nextId{0};
-        std::vector<std::unique_ptr<TaskNode>> _tasks;
-        std::mutex _mutex;
+        struct Edge {
+            u32 task;
+            u32 next;
+        };
+
+        // Block pointers are written once and never move, so workers can index while the
+        // builder appends
+        template <typename T>
+        struct BlockArena {
+            std::array<std::unique_ptr<T[]>, kMaxBlocks> blocks;
+
+            T& operator[](u32 index) const { return blocks[index >> kBlockShift][index & (kBlockSize - 1)]; }
+
+            void Reserve(u32 count) {
+                const u32 block = count >> kBlockShift;
+                if (!blocks[block]) blocks[block] = std::make_unique<T[]>(kBlockSize);
+            }
+        };
+
+        TaskNode* Resolve(TaskHandle task) const;
+        bool TryQueue(TaskNode& node);
+        void Dispatch(u32 id);
+
+        BlockArena<TaskNode> _nodes;
+        BlockArena<Edge> _edges;
+        u32 _taskCount{0};
+        u32 _edgeCount{0};
+        u32 _frame{1};
+
         ThreadPool& _threadPool;
+        JobCounter _inFlight;
     };
 }
@@ -1,9 +1,58 @@
 #include "thread_pool.h"
 #include "job_executor.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
 #include <thread>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace shine::util
 {
+    namespace
+    {
+        // Polls of all queues before an idle worker parks; the second half yields the core
+        constexpr u32 kSpinRounds = 64;
+
+        // Injected jobs moved to the local deque per lock, so other workers can steal them
+        constexpr u32 kInjectBatch = 32;
+
+        // A worker waiting on a counter re-checks the queues at least this often once idle
+        constexpr auto kHelpPollInterval = std::chrono::microseconds(200);
+
+        // Waits nested inside jobs run by a helping waiter. Deeper ones only pop the worker's own
+        // deque (their children sit on top), so a chain of stolen jobs that each wait can't
+        // overflow the stack
+        constexpr u32 kMaxHelpDepth = 16;
+
+        constexpr u32 kNoWorker = ~0u;
+
+        thread_local ThreadPool* t_pool = nullptr;
+        thread_local u32 t_workerIndex = 0;
+        thread_local u32 t_stealRng = 0;  // victim selection for non-worker threads
+        thread_local u32 t_helpDepth = 0;
+
+        inline void CpuRelax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#else
+            std::this_thread::yield();
+#endif
+        }
+
+        inline u32 NextRandom(u32& state) {
+            // xorshift32
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+    }
 
     ThreadPool::ThreadPool(u32 numThreads) {
         if (numThreads == 0) {
@@ -11,70 +60,154 @@ namespace shine::util
             if (numThreads == 0) numThreads = 4;
         }
 
+        // Queues must all exist before any worker starts stealing
         for (u32 i = 0; i < numThreads; ++i) {
-            _workers.emplace_back([this] {
-                job::JobExecutor executor;
-                for (;;) {
-                    job::Job task;
-
-                    {
-                        std::unique_lock<std::mutex> lock(this->_queueMutex);
-                        this->_condition.wait(lock, [this] {
-                            return this->_stop || !this->_tasks.empty();
-                        });
-
-                        if (this->_stop && this->_tasks.empty()) {
-                            return;
-                        }
-
-                        task = std::move(this->_tasks.front());
-                        this->_tasks.pop();
-                    }
-
-                    // Static polymorphism dispatch using std::visit
-                    std::visit(executor, task);
-                    
-                    {
-                        std::unique_lock<std::mutex> lock(this->_queueMutex);
-                        _activeTasks--;
-                        if (_activeTasks == 0) {
-                            _finished.notify_all();
-                        }
-                    }
-                }
-            });
+            _queues.push_back(std::make_unique<WorkerQueue>());
+            _queues.back()->rng = 0x9E3779B9u * (i + 1);
+        }
+        for (u32 i = 0; i < numThreads; ++i) {
+            _workers.emplace_back([this, i] { WorkerLoop(i); });
         }
     }
 
     ThreadPool::~ThreadPool() {
         {
-            std::unique_lock<std::mutex> lock(_queueMutex);
+            std::lock_guard<std::mutex> lock(_parkMutex);
             _stop = true;
         }
         _condition.notify_all();
 
+        // Workers drain every queued job before exiting
         for (std::thread& worker : _workers) {
             worker.join();
         }
     }
 
-    void ThreadPool::Submit(job::Job job)
+    void ThreadPool::Submit(job::Job job, JobCounter* counter)
     {
-        {
-            std::unique_lock<std::mutex> lock(_queueMutex);
-            if (_stop)
-                throw std::runtime_error("submit on stopped ThreadPool");
+        if (_stop.load(std::memory_order_relaxed))
+            throw std::runtime_error("submit on stopped ThreadPool");
+
+        // A Job variant is 48 bytes, so legacy jobs still fit inline
+        Submit([legacy = std::move(job)] {
+            // Static polymorphism dispatch using std::visit
+            job::JobExecutor executor;
+            std::visit(executor, legacy);
+        }, counter);
+    }
+
+    void ThreadPool::RunJobs(std::span<const job::Job> jobs, JobCounter* counter)
+    {
+        if (jobs.empty()) return;
+        if (_stop.load(std::memory_order_relaxed))
+            throw std::runtime_error("submit on stopped ThreadPool");
+
+        // The whole batch is counted before any job can finish, so the counter never hits
+        // zero early
+        if (counter) {
+            counter->_value.fetch_add(static_cast<u32>(jobs.size()), std::memory_order_relaxed);
+        }
+
+        // Queue in fixed-size slices so the batch needs no heap buffer
+        constexpr u32 kSlice = 64;
+        JobNode* nodes[kSlice];
+        for (size_t first = 0; first < jobs.size(); first += kSlice) {
+            const u32 count = static_cast<u32>(std::min<size_t>(kSlice, jobs.size() - first));
+            for (u32 i = 0; i < count; ++i) {
+                JobNode* node = job::AllocateJobRecord();
+                node->Emplace([legacy = jobs[first + i]] {
+                    job::JobExecutor executor;
+                    std::visit(executor, legacy);
+                });
+                node->counter = counter;
+                nodes[i] = node;
+            }
+            Enqueue(nodes, count);
+        }
+    }
+
+    void ThreadPool::Enqueue(JobNode* const* nodes, u32 count) {
+        _activeTasks.fetch_add(count, std::memory_order_relaxed);
+
+        // Counted before they become visible so a thief never decrements below zero.
+        // Pairs with the sleeper check in WorkerLoop: either we see the sleeper or it sees the job
+        _queued.fetch_add(count, std::memory_order_seq_cst);
+
+        if (t_pool == this) {
+            WorkerQueue& self = *_queues[t_workerIndex];
+            for (u32 i = 0; i < count; ++i) {
+                self.deque.Push(nodes[i]);
+            }
+        } else {
+            std::lock_guard<std::mutex> lock(_injectMutex);
+            for (u32 i = 0; i < count; ++i) {
+                _injected.Push(nodes[i]);
+            }
+            _injectedCount.fetch_add(count, std::memory_order_release);
+        }
+
+        const u32 sleepers = _sleepers.load(std::memory_order_seq_cst);
+        if (sleepers > 0) {
+            Wake(std::min(count, sleepers));
+        }
+    }
 
-            _tasks.push(std::move(job));
-            ++_activeTasks;
+    void ThreadPool::WaitForCounter(JobCounter& counter) {
+        const bool worker = t_pool == this;
+        const bool help = t_helpDepth < kMaxHelpDepth;
+        u32 idle = 0;
+
+        while (!counter.IsDone()) {
+            JobNode* node = nullptr;
+            if (help) {
+                node = worker ? FindJob(t_workerIndex) : FindJobExternal();
+            } else if (worker) {
+                node = PopLocal(*_queues[t_workerIndex]);
+            }
+            if (node) {
+                ++t_helpDepth;
+                Execute(node);
+                --t_helpDepth;
+                idle = 0;
+                continue;
+            }
+
+            if (++idle < kSpinRounds) {
+                if (idle < kSpinRounds / 2) {
+                    CpuRelax();
+                } else {
+                    std::this_thread::yield();
+                }
+                continue;
+            }
+
+            // Nothing left to help with: the remaining jobs are running on other threads.
+            // A worker still polls so jobs submitted meanwhile don't wait for a free thread
+            std::unique_lock<std::mutex> lock(_counterMutex);
+            if (worker) {
+                _counterDone.wait_for(lock, kHelpPollInterval, [&counter] { return counter.IsDone(); });
+            } else {
+                _counterDone.wait(lock, [&counter] { return counter.IsDone(); });
+            }
+            idle = 0;
         }
-        _condition.notify_one();
+    }
+
+    bool ThreadPool::TryRunOne() {
+        JobNode* node = t_pool == this ? FindJob(t_workerIndex) : FindJobExternal();
+        if (!node) return false;
+        Execute(node);
+        return true;
+    }
+
+    bool ThreadPool::IsWorkerThread() const {
+        return t_pool == this;
     }
 
     void ThreadPool::WaitAll() {
-        std::unique_lock<std::mutex> lock(_queueMutex);
+        std::unique_lock<std::mutex> lock(_finishedMutex);
         _finished.wait(lock, [this] {
-            return _tasks.empty() && _activeTasks == 0;
+            return _activeTasks.load(std::memory_order_acquire) == 0;
         });
     }
 
@@ -82,4 +215,156 @@ namespace shine::util
         static ThreadPool instance;
         return instance;
     }
+
+    void ThreadPool::Wake(u32 count) {
+        // Taking the lock orders us after a worker that is between its check and its wait
+        { std::lock_guard<std::mutex> lock(_parkMutex); }
+        if (count == 1) {
+            _condition.notify_one();
+        } else {
+            _condition.notify_all();
+        }
+    }
+
+    void ThreadPool::WorkerLoop(u32 index) {
+        t_pool = this;
+        t_workerIndex = index;
+
+        for (;;) {
+            JobNode* job = FindJob(index);
+            for (u32 spin = 0; !job && spin < kSpinRounds; ++spin) {
+                if (spin < kSpinRounds / 2) {
+                    CpuRelax();
+                } else {
+                    std::this_thread::yield();
+                }
+                job = FindJob(index);
+            }
+
+            if (job) {
+                Execute(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_parkMutex);
+            _sleepers.fetch_add(1, std::memory_order_seq_cst);
+            _condition.wait(lock, [this] {
+                return _stop.load(std::memory_order_relaxed) || _queued.load(std::memory_order_seq_cst) > 0;
+            });
+            _sleepers.fetch_sub(1, std::memory_order_relaxed);
+
+            if (_stop.load(std::memory_order_relaxed) && _queued.load(std::memory_order_seq_cst) == 0) {
+                return;
+            }
+        }
+    }
+
+    ThreadPool::JobNode* ThreadPool::FindJob(u32 index) {
+        WorkerQueue& self = *_queues[index];
+
+        if (JobNode* node = PopLocal(self)) {
+            return node;
+        }
+
+        if (JobNode* node = PopInjected(&self)) {
+            return node;
+        }
+        return Steal(index, self.rng);
+    }
+
+    ThreadPool::JobNode* ThreadPool::PopLocal(WorkerQueue& self) {
+        if (auto node = self.deque.Pop()) {
+            _queued.fetch_sub(1, std::memory_order_relaxed);
+            return *node;
+        }
+        return nullptr;
+    }
+
+    ThreadPool::JobNode* ThreadPool::FindJobExternal() {
+        if (JobNode* node = PopInjected(nullptr)) {
+            return node;
+        }
+        if (t_stealRng == 0) {
+            t_stealRng = static_cast<u32>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+        }
+        return Steal(kNoWorker, t_stealRng);
+    }
+
+    ThreadPool::JobNode* ThreadPool::Steal(u32 self, u32& rng) {
+        // Start from a random victim so thieves spread out
+        const u32 count = static_cast<u32>(_queues.size());
+        const u32 start = NextRandom(rng) % count;
+        for (u32 i = 0; i < count; ++i) {
+            const u32 victim = (start + i) % count;
+            if (victim == self) continue;
+            if (auto node = _queues[victim]->deque.Steal()) {
+                _queued.fetch_sub(1, std::memory_order_relaxed);
+                return *node;
+            }
+        }
+        return nullptr;
+    }
+
+    ThreadPool::JobNode* ThreadPool::PopInjected(WorkerQueue* self) {
+        if (_injectedCount.load(std::memory_order_acquire) == 0) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(_injectMutex);
+        if (_injected.size == 0) {
+            return nullptr;
+        }
+
+        // A worker takes a batch (at most half, so other workers still find some) and keeps the
+        // first one. The rest stay counted in `_queued` and become stealable from its deque.
+        // Non-worker threads have no deque and take a single job.
+        const u32 available = static_cast<u32>(_injected.size);
+        const u32 batch = self ? std::min(kInjectBatch, (available + 1) / 2) : 1;
+        JobNode* node = _injected.Pop();
+        for (u32 i = 1; i < batch; ++i) {
+            self->deque.Push(_injected.Pop());
+        }
+        _injectedCount.fetch_sub(batch, std::memory_order_relaxed);
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        return node;
+    }
+
+    void ThreadPool::Execute(JobNode* node) {
+        node->Invoke();
+        JobCounter* counter = node->counter;
+        job::FreeJobRecord(node);
+
+        // The waiter may destroy the counter as soon as it reads zero, so only pool state is
+        // touched after the decrement
+        if (counter && counter->_value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            { std::lock_guard<std::mutex> lock(_counterMutex); }
+            _counterDone.notify_all();
+        }
+
+        if (_activeTasks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(_finishedMutex);
+            _finished.notify_all();
+        }
+    }
+
+    void ThreadPool::InjectionQueue::Push(JobNode* node) {
+        if (size == slots.size()) {
+            // Unwrap into a buffer twice the size
+            std::vector<JobNode*> grown(std::max<size_t>(64, slots.size() * 2));
+            for (size_t i = 0; i < size; ++i) {
+                grown[i] = slots[(head + i) & (slots.size() - 1)];
+            }
+            slots = std::move(grown);
+            head = 0;
+        }
+        slots[(head + size) & (slots.size() - 1)] = node;
+        ++size;
+    }
+
+    ThreadPool::JobNode* ThreadPool::InjectionQueue::Pop() {
+        JobNode* node = slots[head];
+        head = (head + 1) & (slots.size() - 1);
+        --size;
+        return node;
+    }
 }
@@ -1,16 +1,46 @@
 #pragma once
 
 #include <vector>
-#include <queue>
+#include <memory>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
 #include <thread>
+#include <span>
+#include <concepts>
+#include <stdexcept>
 #include "util/shine_define.h"
 #include "jobs.h"
+#include "job_record.h"
+#include "work_stealing_deque.h"
 
 namespace shine::util
 {
+    // Number of jobs still running in a batch started with ThreadPool::RunJobs.
+    //
+    // The counter is only touched by the pool while jobs are in flight, so it can live on the
+    // waiter's stack as long as WaitForCounter() returns before it goes out of scope.
+    class JobCounter {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        u32 Value() const { return _value.load(std::memory_order_acquire); }
+        bool IsDone() const { return Value() == 0; }
+
+    private:
+        friend class ThreadPool;
+        std::atomic<u32> _value{0};
+    };
+
+    // Work-stealing job pool.
+    //
+    // Every worker owns a Chase-Lev deque: jobs submitted from a worker go to its own deque
+    // (popped LIFO by the owner, stolen FIFO by idle workers), jobs submitted from other
+    // threads go to a shared injection queue. An idle worker spins for a short while
+    // looking for work before parking on a condition variable, so bursts of small jobs
+    // never touch a lock on the hot path.
     class ThreadPool {
     public:
         explicit ThreadPool(u32 numThreads = 0);
@@ -19,24 +49,98 @@ namespace shine::util
         ThreadPool(const ThreadPool&) = delete;
         ThreadPool& operator=(const ThreadPool&) = delete;
 
-        // Submit a concrete job to the pool
-        void Submit(job::Job job);
+        // Submit a concrete job to the pool; `counter` (optional) is decremented when it finishes
+        void Submit(job::Job job, JobCounter* counter = nullptr);
+
+        // Submit any callable. Captures up to JobRecord::kInlineSize bytes are stored in the
+        // queued record itself, so the common case allocates nothing.
+        template <typename Fn>
+            requires std::invocable<std::decay_t<Fn>&>
+        void Submit(Fn&& fn, JobCounter* counter = nullptr) {
+            if (_stop.load(std::memory_order_relaxed))
+                throw std::runtime_error("submit on stopped ThreadPool");
+
+            job::JobRecord* record = job::AllocateJobRecord();
+            record->Emplace(std::forward<Fn>(fn));
+            record->counter = counter;
+            if (counter) {
+                counter->_value.fetch_add(1, std::memory_order_relaxed);
+            }
+            Enqueue(&record, 1);
+        }
+
+        // Submit a batch: adds jobs.size() to `counter` up front, then queues every job
+        void RunJobs(std::span<const job::Job> jobs, JobCounter* counter);
+
+        // Return once `counter` reaches zero. Workers keep executing queued jobs while they
+        // wait, so a job may wait on its own children without tying up a thread; other threads
+        // help until the queues run dry, then sleep until the last job finishes.
+        void WaitForCounter(JobCounter& counter);
+
+        // Execute one queued job on the calling thread; false when nothing was found
+        bool TryRunOne();
 
         u32 GetThreadCount() const { return static_cast<u32>(_workers.size()); }
 
+        // True when called from one of this pool's worker threads
+        bool IsWorkerThread() const;
+
+        // Block until every submitted job has finished (must not be called from a worker,
+        // prefer WaitForCounter for waiting on a specific batch)
         void WaitAll();
 
         static ThreadPool& Get();
 
     private:
+        using JobNode = job::JobRecord;
+
+        // Ring of jobs from non-worker threads, guarded by `_injectMutex`. It grows but never
+        // shrinks, so steady-state submits don't allocate
+        struct InjectionQueue {
+            std::vector<JobNode*> slots;
+            size_t head = 0;
+            size_t size = 0;
+
+            void Push(JobNode* node);
+            JobNode* Pop();
+        };
+
+        struct alignas(64) WorkerQueue {
+            WorkStealingDeque<JobNode*> deque;
+            u32 rng = 0;
+        };
+
+        void Enqueue(JobNode* const* nodes, u32 count);
+        void WorkerLoop(u32 index);
+        JobNode* FindJob(u32 index);
+        JobNode* FindJobExternal();
+        JobNode* PopLocal(WorkerQueue& self);
+        JobNode* PopInjected(WorkerQueue* self);
+        JobNode* Steal(u32 self, u32& rng);
+        void Execute(JobNode* node);
+        void Wake(u32 count);
+
         std::vector<std::thread> _workers;
-        // Queue holds concrete variant jobs, not std::function
-        std::queue<job::Job> _tasks;
+        std::vector<std::unique_ptr<WorkerQueue>> _queues;
+
+        // Jobs submitted from non-worker threads
+        InjectionQueue _injected;
+        std::mutex _injectMutex;
+        std::atomic<u32> _injectedCount{0};
 
-        std::mutex _queueMutex;
+        // Parking: `_queued` counts jobs waiting in any queue, `_sleepers` counts parked workers
+        alignas(64) std::atomic<u32> _queued{0};
+        alignas(64) std::atomic<u32> _sleepers{0};
+        std::mutex _parkMutex;
         std::condition_variable _condition;
         std::atomic<bool> _stop{false};
-        std::atomic<u32> _activeTasks{0};
+
+        alignas(64) std::atomic<u32> _activeTasks{0};
+        std::mutex _finishedMutex;
         std::condition_variable _finished;
+
+        // Signalled whenever a JobCounter reaches zero
+        std::mutex _counterMutex;
+        std::condition_variable _counterDone;
     };
 }
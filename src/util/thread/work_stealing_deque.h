@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include "util/shine_define.h"
+
+namespace shine::util
+{
+    // Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli, PPoPP 2013).
+    //
+    // The owning thread pushes and pops at the bottom (LIFO, cache-warm); any other thread
+    // steals from the top (FIFO, oldest and usually largest work). Only the last element
+    // is contended, and that race is settled by a single CAS on `_top`.
+    //
+    // Slots are read before the CAS that claims them, so T must be trivially copyable
+    // (store pointers or indices). The buffer grows on demand; retired buffers stay alive
+    // until destruction because a thief may still be reading one.
+    template <typename T>
+    class WorkStealingDeque {
+        static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque stores T in atomics");
+
+    public:
+        explicit WorkStealingDeque(u32 capacity = 1024) {
+            u32 size = 16;
+            while (size < capacity) size <<= 1;
+            _retired.push_back(std::make_unique<Buffer>(size));
+            _buffer.store(_retired.back().get(), std::memory_order_relaxed);
+        }
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        // Owner only
+        void Push(T item) {
+            const s64 b = _bottom.load(std::memory_order_relaxed);
+            const s64 t = _top.load(std::memory_order_acquire);
+            Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+            if (b - t > buffer->mask) {
+                buffer = Grow(buffer, b, t);
+            }
+            buffer->Put(b, item);
+            // Release store rather than fence + relaxed store: same ordering, and visible to TSan
+            _bottom.store(b + 1, std::memory_order_release);
+        }
+
+        // Owner only
+        std::optional<T> Pop() {
+            const s64 b = _bottom.load(std::memory_order_relaxed) - 1;
+            Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+            _bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            s64 t = _top.load(std::memory_order_relaxed);
+
+            if (t > b) {
+                // Empty
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            T item = buffer->Get(b);
+            if (t == b) {
+                // Last element: race against thieves
+                const bool won = _top.compare_exchange_strong(t, t + 1,
+                    std::memory_order_seq_cst, std::memory_order_relaxed);
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                if (!won) return std::nullopt;
+            }
+            return item;
+        }
+
+        // Any thread. Returns nullopt when empty or when another thread won the race.
+        std::optional<T> Steal() {
+            s64 t = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const s64 b = _bottom.load(std::memory_order_acquire);
+            if (t >= b) return std::nullopt;
+
+            Buffer* buffer = _buffer.load(std::memory_order_acquire);
+            T item = buffer->Get(t);
+            if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return std::nullopt;
+            }
+            return item;
+        }
+
+        // Approximate when called concurrently
+        u32 Size() const {
+            const s64 b = _bottom.load(std::memory_order_relaxed);
+            const s64 t = _top.load(std::memory_order_relaxed);
+            return b > t ? static_cast<u32>(b - t) : 0;
+        }
+
+        bool Empty() const { return Size() == 0; }
+
+    private:
+        struct Buffer {
+            s64 mask;
+            std::unique_ptr<std::atomic<T>[]> slots;
+
+            explicit Buffer(u32 capacity)
+                : mask(static_cast<s64>(capacity) - 1)
+                , slots(std::make_unique<std::atomic<T>[]>(capacity)) {}
+
+            T Get(s64 index) const { return slots[index & mask].load(std::memory_order_relaxed); }
+            void Put(s64 index, T item) { slots[index & mask].store(item, std::memory_order_relaxed); }
+        };
+
+        Buffer* Grow(Buffer* old, s64 bottom, s64 top) {
+            auto grown = std::make_unique<Buffer>(static_cast<u32>((old->mask + 1) * 2));
+            for (s64 i = top; i < bottom; ++i) {
+                grown->Put(i, old->Get(i));
+            }
+            Buffer* raw = grown.get();
+            _retired.push_back(std::move(grown));
+            _buffer.store(raw, std::memory_order_release);
+            return raw;
+        }
+
+        alignas(64) std::atomic<s64> _top{0};
+        alignas(64) std::atomic<s64> _bottom{0};
+        alignas(64) std::atomic<Buffer*> _buffer{nullptr};
+        std::vector<std::unique_ptr<Buffer>> _retired;  // owner only
+    };
+}
@@ -0,0 +1,365 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../../src/image/cooked_texture.h"
+#include "../SimplePerfTest/benchmark_framework.h"
+#include "fmt/format.h"
+
+using shine::image::bc::BcFormat;
+using shine::image::cooked::CookedHeader;
+using shine::image::cooked::CookedLevelEntry;
+using shine::image::cooked::CookedTexture;
+using shine::image::cooked::CookOptions;
+namespace bc = shine::image::bc;
+namespace cooked = shine::image::cooked;
+namespace mip = shine::image::mip;
+
+namespace {
+
+std::vector<uint8_t> make_image(uint32_t width, uint32_t height, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* p = rgba.data() + (static_cast<size_t>(y) * width + x) * 4;
+            p[0] = static_cast<uint8_t>(x * 255 / std::max(1u, width - 1));
+            p[1] = static_cast<uint8_t>(y * 255 / std::max(1u, height - 1));
+            p[2] = static_cast<uint8_t>(((x / 4 + y / 4) % 2) ? 200 : 40);
+            p[3] = static_cast<uint8_t>(rng() % 8 == 0 ? 0 : 255);
+        }
+    }
+    return rgba;
+}
+
+// ============================================================================
+// 哈希
+// ============================================================================
+
+int test_hash() {
+    // XXH64 参考值（seed = 0）
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < 3; ++i) {
+        for (int v = 0; v < 256; ++v) bytes.push_back(static_cast<uint8_t>(v));
+    }
+    const struct {
+        const void* data;
+        size_t size;
+        uint64_t expected;
+    } vectors[] = {
+        { "", 0, 0xEF46DB3751D8E999ull },
+        { "abc", 3, 0x44BC2CF5AD770999ull },
+        { bytes.data(), bytes.size(), 0x8E03C838C596036Full },
+    };
+
+    int failures = 0;
+    for (const auto& v : vectors) {
+        const uint64_t actual = cooked::hashBytes(v.data, v.size);
+        if (actual != v.expected) {
+            ++failures;
+            fmt::println("  FAIL: hashBytes size={} got {:016x} expected {:016x}", v.size, actual, v.expected);
+        }
+    }
+    return failures;
+}
+
+// ============================================================================
+// 烘焙与解析
+// ============================================================================
+
+int check_layout(const CookedTexture& texture) {
+    int failures = 0;
+    for (uint32_t i = 0; i < texture.levelCount(); ++i) {
+        const auto level = texture.level(i);
+        if ((level.data - texture.data()) % cooked::kLevelAlignment != 0) {
+            ++failures;
+            fmt::println("  FAIL: level {} is not aligned", i);
+        }
+        // 数据区尾部在前：越小的级别偏移越小
+        if (i > 0 && level.data >= texture.level(i - 1).data) {
+            ++failures;
+            fmt::println("  FAIL: level {} is stored after level {}", i, i - 1);
+        }
+    }
+    return failures;
+}
+
+int test_rgba_round_trip() {
+    int failures = 0;
+    for (const auto& [width, height] : { std::pair{ 64u, 64u }, std::pair{ 37u, 5u }, std::pair{ 1u, 1u } }) {
+        const auto image = make_image(width, height, width + height);
+        CookOptions options;
+        options.sourceHash = 0x1234;
+        auto file = cooked::cook(image.data(), width, height, options);
+        auto texture = file ? CookedTexture::fromBytes(std::move(*file)) : std::unexpected(file.error());
+        if (!texture) {
+            ++failures;
+            fmt::println("  FAIL: {}x{}: {}", width, height, texture.error());
+            continue;
+        }
+
+        auto chain = mip::buildMipChain(image.data(), width, height, options.mipOptions);
+        if (texture->width() != width || texture->height() != height || texture->compression() ||
+            texture->levelCount() != mip::mipLevelCount(width, height) || texture->sourceHash() != 0x1234 ||
+            !texture->isSrgb()) {
+            ++failures;
+            fmt::println("  FAIL: {}x{} header mismatch", width, height);
+            continue;
+        }
+        const auto base = texture->level(0);
+        if (base.size != image.size() || std::memcmp(base.data, image.data(), image.size()) != 0) {
+            ++failures;
+            fmt::println("  FAIL: {}x{} base level differs", width, height);
+        }
+        for (uint32_t i = 1; i < texture->levelCount(); ++i) {
+            const auto level = texture->level(i);
+            const auto& expected = chain->levels[i - 1];
+            if (level.width != expected.width || level.height != expected.height || level.size != expected.size ||
+                std::memcmp(level.data, chain->levelData(i - 1), expected.size) != 0) {
+                ++failures;
+                fmt::println("  FAIL: {}x{} level {} differs from buildMipChain", width, height, i);
+            }
+        }
+        failures += check_layout(*texture);
+    }
+
+    // 不生成 mip 时只有一级
+    const auto image = make_image(16, 8, 1);
+    CookOptions options;
+    options.generateMips = false;
+    auto file = cooked::cook(image.data(), 16, 8, options);
+    auto texture = file ? CookedTexture::fromBytes(std::move(*file)) : std::unexpected(file.error());
+    if (!texture || texture->levelCount() != 1) {
+        ++failures;
+        fmt::println("  FAIL: single level texture");
+    }
+    return failures;
+}
+
+int test_bc_round_trip() {
+    int failures = 0;
+    const uint32_t width = 64, height = 48;
+    const auto image = make_image(width, height, 9);
+    for (BcFormat format : { BcFormat::BC1, BcFormat::BC3, BcFormat::BC4, BcFormat::BC5, BcFormat::BC7 }) {
+        CookOptions options;
+        options.compression = format;
+        auto file = cooked::cook(image.data(), width, height, options);
+        auto texture = file ? CookedTexture::fromBytes(std::move(*file)) : std::unexpected(file.error());
+        if (!texture || texture->compression() != format) {
+            ++failures;
+            fmt::println("  FAIL: {} cook", bc::formatName(format));
+            continue;
+        }
+
+        auto chain = mip::buildMipChain(image.data(), width, height, options.mipOptions);
+        for (uint32_t i = 0; i < texture->levelCount(); ++i) {
+            const auto level = texture->level(i);
+            const uint8_t* source = i == 0 ? image.data() : chain->levelData(i - 1);
+            auto blocks = bc::compress(source, level.width, level.height, format, options.compressOptions);
+            if (level.size != bc::compressedSize(format, level.width, level.height) ||
+                std::memcmp(level.data, blocks->data(), blocks->size()) != 0) {
+                ++failures;
+                fmt::println("  FAIL: {} level {} differs from bc::compress", bc::formatName(format), i);
+            }
+        }
+        failures += check_layout(*texture);
+    }
+    return failures;
+}
+
+int test_corruption() {
+    int failures = 0;
+    const auto image = make_image(32, 32, 5);
+    const auto file = cooked::cook(image.data(), 32, 32);
+    CookedHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+
+    auto expect_reject = [&](const char* name, std::vector<uint8_t> bytes, bool verifyHash = true) {
+        if (CookedTexture::fromBytes(std::move(bytes), verifyHash)) {
+            ++failures;
+            fmt::println("  FAIL: {} was accepted", name);
+        }
+    };
+
+    auto bytes = *file;
+    bytes[0] = 'X';
+    expect_reject("bad magic", bytes);
+
+    bytes = *file;
+    bytes[4] = cooked::kVersion + 1;
+    expect_reject("future version", bytes);
+
+    expect_reject("truncated header", std::vector<uint8_t>(file->begin(), file->begin() + 32));
+    expect_reject("truncated payload", std::vector<uint8_t>(file->begin(), file->end() - 1), false);
+
+    bytes = *file;
+    CookedLevelEntry entry;
+    std::memcpy(&entry, bytes.data() + header.levelTableOffset, sizeof(entry));
+    entry.offset = bytes.size() - 8;
+    std::memcpy(bytes.data() + header.levelTableOffset, &entry, sizeof(entry));
+    expect_reject("level out of range", bytes, false);
+
+    bytes = *file;
+    entry.offset = header.payloadOffset;
+    entry.width = 31;
+    std::memcpy(bytes.data() + header.levelTableOffset, &entry, sizeof(entry));
+    expect_reject("level size mismatch", bytes, false);
+
+    // 数据区损坏：校验哈希时拒绝，跳过校验时照常解析
+    bytes = *file;
+    bytes[header.payloadOffset + 5] ^= 0x40;
+    expect_reject("hash mismatch", bytes);
+    auto unchecked = CookedTexture::fromBytes(bytes, false);
+    if (!unchecked || unchecked->verify()) {
+        ++failures;
+        fmt::println("  FAIL: unchecked load of corrupt payload");
+    }
+    return failures;
+}
+
+// 任何影响输出的选项变化都要改变 optionsHash，只影响调度的选项不改变
+int test_options_hash() {
+    int failures = 0;
+    const CookOptions base;
+    const uint64_t baseHash = cooked::hashOptions(base);
+
+    const std::pair<const char*, void (*)(CookOptions&)> changes[] = {
+        { "compression", [](CookOptions& o) { o.compression = bc::BcFormat::BC7; } },
+        { "generateMips", [](CookOptions& o) { o.generateMips = false; } },
+        { "mip filter", [](CookOptions& o) { o.mipOptions.filter = mip::MipFilter::Box; } },
+        { "srgb", [](CookOptions& o) { o.mipOptions.srgb = false; } },
+        { "premultiplyAlpha", [](CookOptions& o) { o.mipOptions.premultiplyAlpha = false; } },
+        { "maxLevels", [](CookOptions& o) { o.mipOptions.maxLevels = 3; } },
+        { "refine", [](CookOptions& o) { o.compressOptions.refine = false; } },
+    };
+    for (const auto& [name, change] : changes) {
+        CookOptions options;
+        change(options);
+        if (cooked::hashOptions(options) == baseHash) {
+            ++failures;
+            fmt::println("  FAIL: changing {} kept the options hash", name);
+        }
+    }
+
+    CookOptions scheduling;
+    scheduling.sourceHash = 0x1234;
+    scheduling.mipOptions.parallel = false;
+    scheduling.compressOptions.parallelMinPixels = 1;
+    if (cooked::hashOptions(scheduling) != baseHash) {
+        ++failures;
+        fmt::println("  FAIL: scheduling-only options changed the hash");
+    }
+
+    const auto image = make_image(16, 16, 3);
+    CookOptions boxed;
+    boxed.mipOptions.filter = mip::MipFilter::Box;
+    auto texture = CookedTexture::fromBytes(*cooked::cook(image.data(), 16, 16, boxed));
+    if (!texture || texture->optionsHash() != cooked::hashOptions(boxed)) {
+        ++failures;
+        fmt::println("  FAIL: cooked header does not carry the options hash");
+    }
+    return failures;
+}
+
+int test_open_file() {
+    const auto image = make_image(128, 64, 7);
+    CookOptions options;
+    options.compression = BcFormat::BC1;
+    const auto file = cooked::cook(image.data(), 128, 64, options);
+    const char* path = "cooked_texture_test.stex";
+    if (FILE* f = std::fopen(path, "wb")) {
+        std::fwrite(file->data(), 1, file->size(), f);
+        std::fclose(f);
+    }
+
+    int failures = 0;
+    {
+        auto texture = CookedTexture::open(path, true);
+        if (!texture) {
+            ++failures;
+            fmt::println("  FAIL: open: {}", texture.error());
+        } else if (texture->size() != file->size() || std::memcmp(texture->data(), file->data(), file->size()) != 0) {
+            ++failures;
+            fmt::println("  FAIL: mapped contents differ");
+        } else {
+            // 移动后各级指针仍指向同一映射
+            const uint8_t* before = texture->level(0).data;
+            CookedTexture moved = std::move(*texture);
+            if (moved.level(0).data != before) {
+                ++failures;
+                fmt::println("  FAIL: level pointer changed after move");
+            }
+        }
+    }
+    std::remove(path);
+    return failures;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试 ===\n");
+    int failures = 0;
+    const std::pair<const char*, int (*)()> cases[] = {
+        { "XXH64", test_hash },
+        { "RGBA 往返", test_rgba_round_trip },
+        { "BC 往返", test_bc_round_trip },
+        { "损坏数据", test_corruption },
+        { "烘焙选项哈希", test_options_hash },
+        { "映射文件", test_open_file },
+    };
+    for (const auto& [name, fn] : cases) {
+        const int caseFailures = fn();
+        fmt::println("{}: {}", name, caseFailures == 0 ? "PASS" : "FAIL");
+        failures += caseFailures;
+    }
+
+    fmt::println("");
+    return failures;
+}
+
+void benchmark() {
+    constexpr uint32_t width = 1024;
+    constexpr uint32_t height = 1024;
+    fmt::println("=== 性能测试（{}x{}） ===\n", width, height);
+    const std::vector<uint8_t> image = make_image(width, height, 3);
+
+    for (auto compression : { std::optional<BcFormat>{}, std::optional<BcFormat>{ BcFormat::BC1 } }) {
+        CookOptions options;
+        options.compression = compression;
+        const char* name = compression ? bc::formatName(*compression) : "RGBA8";
+        std::vector<uint8_t> file;
+        shine::benchmark::run_benchmark(fmt::format("cook / {}", name),
+            [&] { file = std::move(*cooked::cook(image.data(), width, height, options)); }, 3, 1);
+
+        // 加载只映射文件并解析文件头与 mip 表，耗时与图像大小无关
+        const char* path = "cooked_texture_bench.stex";
+        if (FILE* f = std::fopen(path, "wb")) {
+            std::fwrite(file.data(), 1, file.size(), f);
+            std::fclose(f);
+        }
+        const auto load = shine::benchmark::run_benchmark(fmt::format("open / {}", name),
+            [&] { (void)CookedTexture::open(path); }, 20, 2);
+        fmt::println("   {:.1f} 微秒（文件 {:.1f} MB）\n", load.median_time_ns / 1e3, file.size() / 1048576.0);
+        std::remove(path);
+
+        const auto hash = shine::benchmark::run_benchmark(fmt::format("hashBytes / {}", name),
+            [&] { (void)cooked::hashBytes(file.data(), file.size()); }, 20, 2);
+        fmt::println("   吞吐量: {:.2f} GB/s\n", file.size() / hash.median_time_ns);
+    }
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
@@ -0,0 +1,309 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "../../src/memory/frame_allocator.ixx"
+#include "../../src/util/shine_define.h"
+#include "fmt/format.h"
+
+using shine::co::FrameAllocator;
+using shine::co::FrameScope;
+using shine::co::FrameVector;
+using shine::co::kFrameBufferCount;
+
+namespace {
+
+// ============================================================================
+// 正确性
+// ============================================================================
+
+struct Block {
+    u8* ptr;
+    size_t size;
+    u8 pattern;
+};
+
+bool is_aligned(const void* p, size_t align) {
+    return (reinterpret_cast<uintptr_t>(p) & (align - 1)) == 0;
+}
+
+bool check_block(const Block& block) {
+    for (size_t i = 0; i < block.size; ++i) {
+        if (block.ptr[i] != block.pattern) return false;
+    }
+    return true;
+}
+
+// 按给定种子分配一批大小、对齐各异的块并写入图案
+std::vector<Block> fill_blocks(u32 count, u32 seed) {
+    static constexpr size_t kAligns[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256 };
+    std::vector<Block> blocks;
+    blocks.reserve(count);
+    for (u32 i = 0; i < count; ++i) {
+        const u32 mix = (i + seed) * 2654435761u;
+        const size_t size = 1 + mix % 700;
+        const size_t align = kAligns[(mix >> 16) % std::size(kAligns)];
+        auto* p = static_cast<u8*>(FrameAllocator::Alloc(size, align));
+        if (!p || !is_aligned(p, align)) return {};
+        const u8 pattern = static_cast<u8>(mix >> 8);
+        std::memset(p, pattern, size);
+        blocks.push_back({ p, size, pattern });
+    }
+    return blocks;
+}
+
+int test_alignment_and_overlap() {
+    FrameAllocator::BeginFrame();
+    const std::vector<Block> blocks = fill_blocks(5000, 1);
+    if (blocks.size() != 5000) {
+        fmt::println("  FAIL: allocation failed or misaligned");
+        return 1;
+    }
+    for (const Block& block : blocks) {
+        if (!check_block(block)) {
+            fmt::println("  FAIL: block overwritten by a later allocation");
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int test_frame_lifetime() {
+    int failures = 0;
+    FrameAllocator::BeginFrame();
+    const std::vector<Block> kept = fill_blocks(2000, 7);
+
+    // 之后的 kFrameBufferCount - 1 帧里继续大量分配，旧数据必须完好
+    for (u32 frame = 1; frame < kFrameBufferCount; ++frame) {
+        FrameAllocator::BeginFrame();
+        fill_blocks(4000, 100 + frame);
+    }
+    for (const Block& block : kept) {
+        if (!check_block(block)) {
+            ++failures;
+            fmt::println("  FAIL: frame data recycled before {} frames passed", kFrameBufferCount);
+            break;
+        }
+    }
+
+    // 稳定状态下循环复用，预留内存不再增长
+    for (u32 frame = 0; frame < 8; ++frame) {
+        FrameAllocator::BeginFrame();
+        fill_blocks(4000, 200 + frame);
+    }
+    const auto before = FrameAllocator::GetStats();
+    for (u32 frame = 0; frame < 32; ++frame) {
+        FrameAllocator::BeginFrame();
+        fill_blocks(4000, 300 + frame);
+    }
+    const auto after = FrameAllocator::GetStats();
+    if (after.reserved_bytes > before.reserved_bytes) {
+        ++failures;
+        fmt::println("  FAIL: reserved grew {} -> {} bytes in steady state", before.reserved_bytes,
+            after.reserved_bytes);
+    }
+    return failures;
+}
+
+int test_oversized() {
+    int failures = 0;
+    FrameAllocator::BeginFrame();
+    const auto before = FrameAllocator::GetStats();
+
+    constexpr size_t kBig = FrameAllocator::kChunkSize * 3 + 17;
+    auto* big = static_cast<u8*>(FrameAllocator::Alloc(kBig, 4096));
+    if (!big || !is_aligned(big, 4096)) {
+        fmt::println("  FAIL: oversized allocation failed or misaligned");
+        return 1;
+    }
+    std::memset(big, 0x5A, kBig);
+    auto* small = static_cast<u8*>(FrameAllocator::Alloc(64));
+    std::memset(small, 0xA5, 64);
+    if (big[kBig - 1] != 0x5A) {
+        ++failures;
+        fmt::println("  FAIL: oversized block overlapped the next allocation");
+    }
+
+    // 超大块随所在帧一起释放
+    for (u32 frame = 0; frame < kFrameBufferCount; ++frame) {
+        FrameAllocator::BeginFrame();
+        FrameAllocator::Alloc(16);
+    }
+    const auto after = FrameAllocator::GetStats();
+    if (after.reserved_bytes > before.reserved_bytes + FrameAllocator::kChunkSize * 2) {
+        ++failures;
+        fmt::println("  FAIL: oversized chunk kept after recycle ({} -> {} bytes)", before.reserved_bytes,
+            after.reserved_bytes);
+    }
+    return failures;
+}
+
+int test_scope_rewind() {
+    int failures = 0;
+    FrameAllocator::BeginFrame();
+    FrameAllocator::Alloc(24);
+
+    void* first = nullptr;
+    {
+        FrameScope outer;
+        first = FrameAllocator::Alloc(32, 16);
+        {
+            FrameScope inner;
+            // 跨越多个块后回退
+            for (u32 i = 0; i < 100; ++i) FrameAllocator::Alloc(4000);
+        }
+        if (FrameAllocator::Alloc(32, 16) != static_cast<char*>(first) + 32) {
+            ++failures;
+            fmt::println("  FAIL: inner scope did not rewind across chunks");
+        }
+    }
+    if (FrameAllocator::Alloc(32, 16) != first) {
+        ++failures;
+        fmt::println("  FAIL: outer scope did not rewind");
+    }
+
+    // 作用域内换帧：不回退，也不能破坏新帧
+    {
+        FrameScope stale;
+        FrameAllocator::Alloc(128);
+        FrameAllocator::BeginFrame();
+        auto* p = static_cast<u8*>(FrameAllocator::Alloc(16));
+        std::memset(p, 0x11, 16);
+        auto* q = static_cast<u8*>(FrameAllocator::Alloc(16));
+        if (p == q) {
+            ++failures;
+            fmt::println("  FAIL: allocations overlap after frame change");
+        }
+    }
+    return failures;
+}
+
+int test_frame_vector() {
+    FrameAllocator::BeginFrame();
+    FrameVector<u32> values;
+    for (u32 i = 0; i < 100000; ++i) values.push_back(i * 3);
+    FrameVector<u64> copy(values.begin(), values.end());
+    u64 sum = 0;
+    for (u64 v : copy) sum += v;
+    const u64 expected = 3ull * 100000 * 99999 / 2;
+    if (sum != expected || !is_aligned(copy.data(), alignof(u64))) {
+        fmt::println("  FAIL: FrameVector sum {} (expected {})", sum, expected);
+        return 1;
+    }
+    return 0;
+}
+
+int test_multi_thread() {
+    int failures = 0;
+    constexpr u32 kThreads = 8;
+    // 每帧新建线程：线程退出后留下的块要等三帧后才能被别的线程复用
+    for (u32 frame = 0; frame < 12; ++frame) {
+        FrameAllocator::BeginFrame();
+        std::vector<std::thread> threads;
+        std::vector<int> bad(kThreads, 0);
+        for (u32 t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t] {
+                const std::vector<Block> blocks = fill_blocks(3000, frame * 100 + t);
+                if (blocks.empty()) bad[t] = 1;
+                for (const Block& block : blocks) {
+                    if (!check_block(block)) {
+                        bad[t] = 1;
+                        break;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        for (int b : bad) failures += b;
+    }
+    if (failures != 0) fmt::println("  FAIL: {} threads saw corrupted frame memory", failures);
+    return failures;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试 ===\n");
+    int failures = 0;
+    const std::pair<const char*, int (*)()> cases[] = {
+        { "对齐 / 互不重叠", test_alignment_and_overlap },
+        { "三帧生命周期 / 稳定复用", test_frame_lifetime },
+        { "超大分配", test_oversized },
+        { "FrameScope 回退", test_scope_rewind },
+        { "FrameVector", test_frame_vector },
+        { "多线程分配 / 线程退出", test_multi_thread },
+    };
+    for (const auto& [name, fn] : cases) {
+        const int caseFailures = fn();
+        fmt::println("{}: {}", name, caseFailures == 0 ? "PASS" : "FAIL");
+        failures += caseFailures;
+    }
+
+    fmt::println("");
+    return failures;
+}
+
+// ============================================================================
+// 性能：每帧 kPerFrame 次临时分配，单位 ns/次
+// ============================================================================
+
+constexpr u32 kFrames = 200;
+constexpr u32 kPerFrame = 10000;
+
+template<typename Alloc, typename EndFrame>
+double ns_per_alloc(Alloc&& alloc, EndFrame&& endFrame) {
+    std::vector<void*> live(kPerFrame);
+    double best = 1e30;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 frame = 0; frame < kFrames; ++frame) {
+            for (u32 i = 0; i < kPerFrame; ++i) {
+                const size_t size = 16 + (i * 40503u) % 240;
+                live[i] = alloc(size);
+                static_cast<char*>(live[i])[0] = static_cast<char>(i);
+            }
+            endFrame(live);
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, seconds);
+    }
+    return best * 1e9 / (static_cast<double>(kFrames) * kPerFrame);
+}
+
+void benchmark() {
+    fmt::println("=== 性能测试（{} 帧 × {} 次 16~256 字节临时分配，单位：ns/次） ===\n", kFrames, kPerFrame);
+
+    const double frame = ns_per_alloc(
+        [](size_t size) { return FrameAllocator::Alloc(size); },
+        [](std::vector<void*>&) { FrameAllocator::BeginFrame(); });
+
+    const double memory = ns_per_alloc(
+        [](size_t size) { return shine::co::Memory::Alloc(size); },
+        [](std::vector<void*>& live) { for (void* p : live) shine::co::Memory::Free(p); });
+
+    const double crt = ns_per_alloc(
+        [](size_t size) { return std::malloc(size); },
+        [](std::vector<void*>& live) { for (void* p : live) std::free(p); });
+
+    fmt::println("{:>16} | {:>8}", "分配器", "ns/次");
+    fmt::println("{:>16} | {:>8.2f}", "FrameAllocator", frame);
+    fmt::println("{:>16} | {:>8.2f}", "Memory::Alloc", memory);
+    fmt::println("{:>16} | {:>8.2f}", "malloc", crt);
+    fmt::println("");
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
@@ -0,0 +1,262 @@
+#include "inflate_reference.h"
+#include "../../src/util/encoding/inflate.h"
+#include "../../src/util/encoding/deflate_tables.h"
+#include "../../src/util/encoding/huffman_decoder.h"
+#include "../../src/util/encoding/byte_convert.ixx"
+
+#include <algorithm>
+#include <cstring>
+
+namespace shine::util
+{
+	using namespace deflate;
+
+	// 解压缩 Huffman 块（BTYPE=1 或 2）
+	// 注意：output 参数用于累积所有块的数据，使得距离码可以引用之前块的数据
+	static std::expected<void, std::string> inflateHuffmanBlock(
+		BitReader& reader, uint32_t btype, std::vector<uint8_t>& output, size_t max_output_size = 0)
+	{
+		HuffmanTree tree_ll, tree_d;
+		
+		// 构建 Huffman 树
+		auto treesResult = readDeflateBlockTrees(reader, btype, tree_ll, tree_d);
+		if (!treesResult.has_value())
+		{
+			return treesResult;
+		}
+		
+		bool done = false;
+		while (!done)
+		{
+			// 检查是否有足够的数据
+			if (!reader.hasMoreData())
+			{
+				return std::unexpected("数据不足：无法读取Huffman符号");
+			}
+			
+			// 解码符号（huffmanDecodeSymbol内部会调用ensureBits，这里不需要重复调用）
+			uint32_t code_ll = huffmanDecodeSymbol(reader, tree_ll);
+			
+			if (code_ll == INVALIDSYMBOL)
+			{
+				return std::unexpected("无效的 Huffman 符号");
+			}
+			
+			if (code_ll <= 255)
+			{
+				// 字面量
+				output.push_back(static_cast<uint8_t>(code_ll));
+			}
+			else if (code_ll >= FIRST_LENGTH_CODE_INDEX && code_ll <= LAST_LENGTH_CODE_INDEX)
+			{
+				// 长度/距离对
+				uint32_t length = LENGTHBASE[code_ll - FIRST_LENGTH_CODE_INDEX];
+				uint8_t numextrabits_l = LENGTHEXTRA[code_ll - FIRST_LENGTH_CODE_INDEX];
+				
+				if (numextrabits_l > 0)
+				{
+					length += reader.readBits(numextrabits_l);
+				}
+				
+				// 解码距离码（huffmanDecodeSymbol内部会调用ensureBits）
+				uint32_t code_d = huffmanDecodeSymbol(reader, tree_d);
+				
+				if (code_d == INVALIDSYMBOL || code_d > 29)
+				{
+					return std::unexpected("无效的距离码");
+				}
+				
+				uint32_t distance = DISTANCEBASE[code_d];
+				uint8_t numextrabits_d = DISTANCEEXTRA[code_d];
+				
+				if (numextrabits_d > 0)
+				{
+					distance += reader.readBits(numextrabits_d);
+				}
+				
+				// LZ77 解码：从输出缓冲区复制（可以引用之前所有块的数据）
+				if (distance > output.size())
+				{
+					return std::unexpected("距离超出输出缓冲区");
+				}
+				
+				size_t start = output.size();
+				size_t backward = start - distance;
+				output.resize(start + length);
+				
+				if (distance < length)
+				{
+					// 需要重复复制
+					std::memcpy(output.data() + start, output.data() + backward, distance);
+					uint32_t forward = distance;
+					while (forward < length)
+					{
+						size_t copyLen = std::min(distance, length - forward);
+						std::memcpy(output.data() + start + forward, 
+						           output.data() + backward, copyLen);
+						forward += copyLen;
+					}
+				}
+				else
+				{
+					std::memcpy(output.data() + start, output.data() + backward, length);
+				}
+			}
+			else if (code_ll == 256)
+			{
+				// 结束码
+				done = true;
+			}
+			else
+			{
+				return std::unexpected("无效的 Huffman 码");
+			}
+			
+			if (max_output_size > 0 && output.size() > max_output_size)
+			{
+				return std::unexpected("输出大小超出限制");
+			}
+		}
+		
+		return {};
+	}
+	
+	// Zlib 解压缩实现（完整版，支持 Deflate）
+	std::expected<std::vector<uint8_t>, std::string> zlibInflateReference(std::span<const uint8_t> compressed)
+	{
+		if (compressed.size() < 2)
+		{
+			return std::unexpected("Zlib 数据太小");
+		}
+		
+		// 使用 byte_convert 工具读取 zlib 头
+		uint16_t header = read_be16(compressed.data(), compressed.size(), 0);
+		
+		if ((header % 31) != 0)
+		{
+			return std::unexpected("无效的 Zlib 头");
+		}
+		
+		uint8_t cm = compressed[0] & 0x0F;
+		uint8_t cinfo = (compressed[0] >> 4) & 0x0F;
+		uint8_t fdict = (compressed[1] >> 5) & 0x01;
+		
+		if (cm != 8 || cinfo > 7)
+		{
+			return std::unexpected("不支持的压缩方法");
+		}
+		
+		if (fdict != 0)
+		{
+			return std::unexpected("不支持预设字典");
+		}
+		
+		// 跳过 zlib 头，开始 deflate 数据
+		std::span<const uint8_t> deflateData = compressed.subspan(2);
+		if (deflateData.size() < 4) // 至少需要 Adler-32
+		{
+			return std::unexpected("Deflate 数据太小");
+		}
+		
+		// 创建位读取器
+		BitReader reader(deflateData.data(), deflateData.size() - 4); // 保留最后4字节用于 Adler-32
+		
+		std::vector<uint8_t> output;
+		// 优化：根据压缩数据大小估算解压后大小，减少重新分配
+		// PNG图像解压后大小约为：height * (width * bytesPerPixel + 1)
+		// 对于844x167 RGBA，约为 167 * (844*4 + 1) ≈ 563KB
+		// 保守估计：压缩比通常为2-10倍，预分配压缩大小的5倍
+		size_t estimatedSize = compressed.size() * 5;
+		if (estimatedSize < 1024) estimatedSize = 1024; // 至少1KB
+		output.reserve(estimatedSize);
+		
+		// 解压缩 deflate 块
+		bool bfinal = false;
+		while (!bfinal)
+		{
+			if (reader.getBitPos() + 3 > reader.getBytePos() * 8 + (deflateData.size() - 4) * 8)
+			{
+				return std::unexpected("位指针超出范围");
+			}
+			
+			// 读取 BFINAL (1 bit) 和 BTYPE (2 bits)
+			bfinal = reader.readBits(1) != 0;
+			uint32_t btype = reader.readBits(2);
+			
+			if (btype == 3)
+			{
+				return std::unexpected("无效的 BTYPE");
+			}
+			
+			// 处理不同类型的块
+			if (btype == 0)
+			{
+				// 无压缩块
+				reader.alignToByte();
+				size_t bytePos = reader.getBytePos();
+				
+				if (bytePos + 4 > deflateData.size() - 4)
+				{
+					return std::unexpected("无压缩块数据不足");
+				}
+				
+				// LEN/NLEN 为小端序（RFC 1951 3.2.4）
+				uint16_t len = read_le16(deflateData.data(), deflateData.size(), bytePos);
+				uint16_t nlen = read_le16(deflateData.data(), deflateData.size(), bytePos + 2);
+				
+				if ((len + nlen) != 0xFFFF)
+				{
+					return std::unexpected("无压缩块长度校验失败");
+				}
+				
+				bytePos += 4;
+				if (bytePos + len > deflateData.size() - 4)
+				{
+					return std::unexpected("无压缩块数据超出范围");
+				}
+				
+				size_t oldSize = output.size();
+				output.resize(oldSize + len);
+				std::memcpy(output.data() + oldSize, deflateData.data() + bytePos, len);
+				
+				reader.advanceBits((4 + static_cast<size_t>(len)) * 8);
+			}
+			else if (btype == 1 || btype == 2)
+			{
+				// BTYPE=1 (固定 Huffman) 或 BTYPE=2 (动态 Huffman)
+				// 注意：传递累积的输出缓冲区，使得距离码可以引用之前块的数据
+				auto blockResult = inflateHuffmanBlock(reader, btype, output);
+				if (!blockResult.has_value())
+				{
+					return std::unexpected("Huffman 块解码失败: " + blockResult.error());
+				}
+			}
+			else
+			{
+				return std::unexpected("不支持的 BTYPE: " + std::to_string(btype));
+			}
+		}
+		
+		// 验证 Adler-32 校验和
+		// Adler-32校验和在zlib中是大端序存储的
+		if (deflateData.size() >= 4)
+		{
+			uint32_t expectedAdler = read_be32(compressed.data(), compressed.size(), compressed.size() - 4);
+			uint32_t calculatedAdler = adler32(1, output.data(), output.size());
+			
+			if (expectedAdler != calculatedAdler)
+			{
+				return std::unexpected("Adler-32 校验失败: 期望=" + 
+					std::to_string(expectedAdler) + ", 计算=" + std::to_string(calculatedAdler));
+			}
+		}
+		
+		if (output.empty())
+		{
+			return std::unexpected("解压缩后数据为空");
+		}
+		
+		return output;
+	}
+
+} // namespace shine::util
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <expected>
+#include <string>
+#include <span>
+
+#include "../../src/util/encoding/huffman_decoder.h"
+
+/**
+ * @file inflate_reference.h
+ * @brief 逐符号 Deflate 解码器（BitReader + HuffmanTree）
+ *
+ * 实现简单直观，仅用作 inflate.h 快速解压引擎的测试对照，不参与产品构建。
+ * 块头解析（readDeflateBlockTrees）在 huffman_decoder.h 中，与 PNG 流式解压器共用。
+ */
+
+namespace shine::util
+{
+	/**
+	 * @brief 解压 zlib 数据（对照实现）
+	 * @param compressed zlib 数据（含 2 字节头与 Adler-32）
+	 * @return 解压后的数据，失败返回错误信息
+	 */
+	std::expected<std::vector<uint8_t>, std::string> zlibInflateReference(std::span<const uint8_t> compressed);
+
+} // namespace shine::util
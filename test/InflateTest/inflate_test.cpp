@@ -0,0 +1,430 @@
+#include <algorithm>
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "../../src/util/encoding/deflate_tables.h"
+#include "../../src/util/encoding/inflate.h"
+#include "../SimplePerfTest/benchmark_framework.h"
+#include "inflate_reference.h"
+#include "fmt/format.h"
+
+namespace deflate = shine::util::deflate;
+
+namespace {
+
+/**
+ * @brief LSB 优先的位写入器
+ */
+class BitWriter {
+public:
+    void bits(uint32_t value, uint32_t count) {
+        for (uint32_t i = 0; i < count; ++i) {
+            if (_bitPos == 0) _data.push_back(0);
+            _data.back() |= static_cast<uint8_t>(((value >> i) & 1) << _bitPos);
+            _bitPos = (_bitPos + 1) & 7;
+        }
+    }
+
+    // Huffman 码字按 MSB 优先写入
+    void code(uint32_t code, uint32_t length) {
+        for (uint32_t i = length; i-- > 0;) bits((code >> i) & 1, 1);
+    }
+
+    void align() { _bitPos = 0; }
+    std::vector<uint8_t>& data() { return _data; }
+
+private:
+    std::vector<uint8_t> _data;
+    uint32_t _bitPos = 0;
+};
+
+struct Token {
+    uint16_t literalOrLength;  ///< 字面量，或匹配长度（distance != 0 时）
+    uint16_t distance;
+};
+
+/**
+ * @brief 由频率构建长度受限的 Huffman 码长（超限时压平频率重试）
+ */
+std::vector<uint8_t> buildLengths(std::vector<uint32_t> freqs, uint32_t maxLength) {
+    const size_t n = freqs.size();
+    for (;;) {
+        std::vector<uint8_t> lengths(n, 0);
+        using Node = std::pair<uint64_t, int>;
+        std::priority_queue<Node, std::vector<Node>, std::greater<>> heap;
+        std::vector<int> parent(n * 2, -1);
+        int next = static_cast<int>(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (freqs[i]) heap.push({ freqs[i], static_cast<int>(i) });
+        }
+        if (heap.size() == 1) {
+            lengths[heap.top().second] = 1;
+            return lengths;
+        }
+        while (heap.size() > 1) {
+            auto [fa, a] = heap.top(); heap.pop();
+            auto [fb, b] = heap.top(); heap.pop();
+            parent[a] = parent[b] = next;
+            heap.push({ fa + fb, next++ });
+        }
+        bool ok = true;
+        for (size_t i = 0; i < n; ++i) {
+            if (!freqs[i]) continue;
+            uint32_t depth = 0;
+            for (int p = static_cast<int>(i); parent[p] != -1; p = parent[p]) ++depth;
+            lengths[i] = static_cast<uint8_t>(depth);
+            ok &= depth <= maxLength;
+        }
+        if (ok) return lengths;
+        for (auto& f : freqs) if (f) f = (f + 1) / 2;
+    }
+}
+
+std::vector<uint32_t> canonicalCodes(const std::vector<uint8_t>& lengths) {
+    uint32_t count[16] = {}, nextCode[16] = {};
+    for (uint8_t l : lengths) ++count[l];
+    count[0] = 0;
+    for (uint32_t len = 1, code = 0; len < 16; ++len) {
+        code = (code + count[len - 1]) << 1;
+        nextCode[len] = code;
+    }
+    std::vector<uint32_t> codes(lengths.size());
+    for (size_t i = 0; i < lengths.size(); ++i) {
+        if (lengths[i]) codes[i] = nextCode[lengths[i]]++;
+    }
+    return codes;
+}
+
+uint32_t lengthSymbol(uint32_t length, uint32_t& extra, uint32_t& extraBits) {
+    uint32_t i = 28;
+    while (deflate::LENGTHBASE[i] > length) --i;
+    extra = length - deflate::LENGTHBASE[i];
+    extraBits = deflate::LENGTHEXTRA[i];
+    return deflate::FIRST_LENGTH_CODE_INDEX + i;
+}
+
+uint32_t distanceSymbol(uint32_t distance, uint32_t& extra, uint32_t& extraBits) {
+    uint32_t i = 29;
+    while (deflate::DISTANCEBASE[i] > distance) --i;
+    extra = distance - deflate::DISTANCEBASE[i];
+    extraBits = deflate::DISTANCEEXTRA[i];
+    return i;
+}
+
+/**
+ * @brief 随机 Deflate 流生成器：同时产生压缩数据与期望输出
+ */
+class StreamGenerator {
+public:
+    explicit StreamGenerator(uint32_t seed) : _rng(seed) {}
+
+    std::vector<uint8_t>& expected() { return _expected; }
+
+    void storedBlock(bool final, size_t size) {
+        _writer.bits(final, 1);
+        _writer.bits(0, 2);
+        _writer.align();
+        _writer.bits(static_cast<uint32_t>(size), 16);
+        _writer.bits(static_cast<uint32_t>(size) ^ 0xFFFF, 16);
+        for (size_t i = 0; i < size; ++i) {
+            const uint8_t b = randomByte();
+            _writer.bits(b, 8);
+            _expected.push_back(b);
+        }
+    }
+
+    void huffmanBlock(bool final, bool dynamic, size_t tokenCount) {
+        const auto tokens = randomTokens(tokenCount);
+
+        std::vector<uint8_t> litLens(288, 0), distLens(32, 0);
+        if (dynamic) {
+            std::vector<uint32_t> litFreq(286, 0), distFreq(30, 0);
+            litFreq[deflate::END_OF_BLOCK] = 1;
+            for (const Token& t : tokens) {
+                uint32_t extra, extraBits;
+                if (t.distance == 0) {
+                    ++litFreq[t.literalOrLength];
+                } else {
+                    ++litFreq[lengthSymbol(t.literalOrLength, extra, extraBits)];
+                    ++distFreq[distanceSymbol(t.distance, extra, extraBits)];
+                }
+            }
+            if (std::all_of(distFreq.begin(), distFreq.end(), [](uint32_t f) { return f == 0; })) distFreq[0] = 1;
+            auto l = buildLengths(litFreq, 15);
+            auto d = buildLengths(distFreq, 15);
+            std::copy(l.begin(), l.end(), litLens.begin());
+            std::copy(d.begin(), d.end(), distLens.begin());
+        } else {
+            std::fill(litLens.begin(), litLens.begin() + 144, 8);
+            std::fill(litLens.begin() + 144, litLens.begin() + 256, 9);
+            std::fill(litLens.begin() + 256, litLens.begin() + 280, 7);
+            std::fill(litLens.begin() + 280, litLens.end(), 8);
+            std::fill(distLens.begin(), distLens.end(), 5);
+        }
+
+        _writer.bits(final, 1);
+        _writer.bits(dynamic ? 2 : 1, 2);
+        if (dynamic) writeTrees(litLens, distLens);
+
+        const auto litCodes = canonicalCodes(litLens);
+        const auto distCodes = canonicalCodes(distLens);
+        for (const Token& t : tokens) {
+            if (t.distance == 0) {
+                _writer.code(litCodes[t.literalOrLength], litLens[t.literalOrLength]);
+                continue;
+            }
+            uint32_t extra, extraBits;
+            const uint32_t ls = lengthSymbol(t.literalOrLength, extra, extraBits);
+            _writer.code(litCodes[ls], litLens[ls]);
+            _writer.bits(extra, extraBits);
+            const uint32_t ds = distanceSymbol(t.distance, extra, extraBits);
+            _writer.code(distCodes[ds], distLens[ds]);
+            _writer.bits(extra, extraBits);
+        }
+        _writer.code(litCodes[deflate::END_OF_BLOCK], litLens[deflate::END_OF_BLOCK]);
+    }
+
+    // 以 zlib 格式封装（CMF=0x78, FLG=0x9C）
+    std::vector<uint8_t> zlib() {
+        std::vector<uint8_t> out = { 0x78, 0x9C };
+        out.insert(out.end(), _writer.data().begin(), _writer.data().end());
+        const uint32_t adler = shine::util::adler32(1, _expected.data(), _expected.size());
+        for (int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<uint8_t>(adler >> shift));
+        return out;
+    }
+
+private:
+    uint8_t randomByte() {
+        // 偏斜分布，让动态树出现长短不一的码字
+        const uint32_t r = _rng();
+        return static_cast<uint8_t>((r & 3) ? (r >> 8) % 16 : (r >> 8));
+    }
+
+    std::vector<Token> randomTokens(size_t count) {
+        std::vector<Token> tokens;
+        for (size_t i = 0; i < count; ++i) {
+            const size_t produced = _expected.size();
+            const uint32_t kind = _rng() % 8;
+            if (produced == 0 || kind < 4) {
+                const uint8_t b = randomByte();
+                tokens.push_back({ b, 0 });
+                _expected.push_back(b);
+                continue;
+            }
+
+            const uint32_t maxDist = static_cast<uint32_t>(std::min<size_t>(produced, deflate::WINDOW_SIZE));
+            uint32_t distance;
+            switch (kind) {
+            case 4: distance = 1; break;
+            case 5: distance = 1 + _rng() % std::min<uint32_t>(maxDist, 16); break;
+            case 6: distance = maxDist; break;
+            default: distance = 1 + _rng() % maxDist; break;
+            }
+            const uint32_t length = (_rng() % 4 == 0) ? deflate::MAX_MATCH_LENGTH : 3 + _rng() % 64;
+
+            tokens.push_back({ static_cast<uint16_t>(length), static_cast<uint16_t>(distance) });
+            for (uint32_t j = 0; j < length; ++j) {
+                _expected.push_back(_expected[_expected.size() - distance]);
+            }
+        }
+        return tokens;
+    }
+
+    void writeTrees(const std::vector<uint8_t>& litLens, const std::vector<uint8_t>& distLens) {
+        uint32_t hlit = 286, hdist = 30;
+        while (hlit > 257 && litLens[hlit - 1] == 0) --hlit;
+        while (hdist > 1 && distLens[hdist - 1] == 0) --hdist;
+
+        std::vector<uint8_t> all(litLens.begin(), litLens.begin() + hlit);
+        all.insert(all.end(), distLens.begin(), distLens.begin() + hdist);
+
+        // 行程编码代码长度序列
+        struct Rle { uint8_t symbol; uint8_t extra; };
+        std::vector<Rle> rle;
+        for (size_t i = 0; i < all.size();) {
+            size_t run = 1;
+            while (i + run < all.size() && all[i + run] == all[i]) ++run;
+            if (all[i] == 0 && run >= 11) {
+                run = std::min<size_t>(run, 138);
+                rle.push_back({ 18, static_cast<uint8_t>(run - 11) });
+            } else if (all[i] == 0 && run >= 3) {
+                rle.push_back({ 17, static_cast<uint8_t>(run - 3) });
+            } else if (i > 0 && all[i] == all[i - 1] && run >= 3) {
+                run = std::min<size_t>(run, 6);
+                rle.push_back({ 16, static_cast<uint8_t>(run - 3) });
+            } else {
+                run = 1;
+                rle.push_back({ all[i], 0 });
+            }
+            i += run;
+        }
+
+        std::vector<uint32_t> preFreq(19, 0);
+        for (const Rle& r : rle) ++preFreq[r.symbol];
+        auto preLens = buildLengths(preFreq, 7);
+        if (std::count_if(preLens.begin(), preLens.end(), [](uint8_t l) { return l != 0; }) == 1) {
+            // 单一码字：补一个未使用的码，构成完整的 1 位码
+            preLens[preLens[0] ? 1 : 0] = 1;
+        }
+        const auto preCodes = canonicalCodes(preLens);
+
+        uint32_t hclen = 19;
+        while (hclen > 4 && preLens[deflate::CLCL_ORDER[hclen - 1]] == 0) --hclen;
+
+        _writer.bits(hlit - 257, 5);
+        _writer.bits(hdist - 1, 5);
+        _writer.bits(hclen - 4, 4);
+        for (uint32_t i = 0; i < hclen; ++i) _writer.bits(preLens[deflate::CLCL_ORDER[i]], 3);
+        for (const Rle& r : rle) {
+            _writer.code(preCodes[r.symbol], preLens[r.symbol]);
+            if (r.symbol == 16) _writer.bits(r.extra, 2);
+            else if (r.symbol == 17) _writer.bits(r.extra, 3);
+            else if (r.symbol == 18) _writer.bits(r.extra, 7);
+        }
+    }
+
+    std::mt19937 _rng;
+    BitWriter _writer;
+    std::vector<uint8_t> _expected;
+};
+
+/**
+ * @brief 生成由随机块序列组成的 zlib 流
+ */
+std::vector<uint8_t> randomStream(uint32_t seed, size_t blocks, size_t tokensPerBlock, std::vector<uint8_t>& expected) {
+    StreamGenerator gen(seed);
+    std::mt19937 rng(seed ^ 0x5bd1e995u);
+    for (size_t b = 0; b < blocks; ++b) {
+        const bool final = b + 1 == blocks;
+        switch (rng() % 4) {
+        case 0: gen.storedBlock(final, rng() % 2000); break;
+        case 1: gen.huffmanBlock(final, false, 1 + rng() % tokensPerBlock); break;
+        default: gen.huffmanBlock(final, true, 1 + rng() % tokensPerBlock); break;
+        }
+    }
+    expected = gen.expected();
+    return gen.zlib();
+}
+
+int test_random_streams() {
+    int failures = 0;
+    for (uint32_t seed = 1; seed <= 300; ++seed) {
+        std::vector<uint8_t> expected;
+        const auto stream = randomStream(seed, 1 + seed % 6, 1 + seed * 7, expected);
+
+        auto fast = shine::util::zlibInflate(stream);
+        auto reference = shine::util::zlibInflateReference(stream);
+        auto hinted = shine::util::zlibInflate(stream, expected.size());
+
+        const bool ok = fast.has_value() && *fast == expected &&
+            hinted.has_value() && *hinted == expected &&
+            reference.has_value() && *reference == expected;
+        if (!ok) {
+            ++failures;
+            fmt::println("  FAIL: seed={} size={} fast={} reference={}", seed, expected.size(),
+                fast.has_value() ? "ok" : fast.error(), reference.has_value() ? "ok" : reference.error());
+        }
+    }
+    fmt::println("随机流（存储/固定/动态块）: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+int test_invalid_streams() {
+    int failures = 0;
+    std::vector<uint8_t> expected;
+    const auto stream = randomStream(4242, 4, 3000, expected);
+
+    // 截断：任何截断都必须报错而不是越界读取
+    for (size_t cut = 0; cut < stream.size(); cut += 1 + stream.size() / 97) {
+        std::span<const uint8_t> truncated(stream.data(), cut);
+        if (shine::util::zlibInflate(truncated).has_value()) {
+            ++failures;
+            fmt::println("  FAIL: 截断到 {} 字节未报错", cut);
+        }
+    }
+
+    // 随机翻转比特：允许报错，但不允许崩溃；成功时输出必须通过 Adler-32
+    std::mt19937 rng(99);
+    for (int i = 0; i < 2000; ++i) {
+        auto corrupted = stream;
+        corrupted[2 + rng() % (corrupted.size() - 2)] ^= static_cast<uint8_t>(1u << (rng() % 8));
+        (void)shine::util::zlibInflate(corrupted);
+    }
+
+    // 输出上限
+    if (shine::util::zlibInflate(stream, 0, expected.size() / 2).has_value()) {
+        ++failures;
+        fmt::println("  FAIL: 超出 maxOutput 未报错");
+    }
+
+    // 不可信的 sizeHint（如伪造的 IHDR 尺寸）：预分配受输入大小约束，而不是按提示分配
+    const size_t hugeHint = size_t(1) << 40;
+    auto hintedHuge = shine::util::zlibInflate(stream, hugeHint, hugeHint);
+    if (!hintedHuge.has_value() || *hintedHuge != expected || hintedHuge->capacity() > stream.size() * 1032 + 4096) {
+        ++failures;
+        fmt::println("  FAIL: 超大 sizeHint 预分配了 {} 字节", hintedHuge.has_value() ? hintedHuge->capacity() : 0);
+    }
+    for (size_t cut = 8; cut < 64 && cut < stream.size(); cut += 8) {
+        std::span<const uint8_t> truncated(stream.data(), cut);
+        if (shine::util::zlibInflate(truncated, hugeHint, hugeHint).has_value()) {
+            ++failures;
+            fmt::println("  FAIL: 截断到 {} 字节（超大 sizeHint）未报错", cut);
+        }
+    }
+
+    // 上限等于真实大小时通过，少一个字节即拒绝
+    if (!shine::util::zlibInflate(stream, expected.size(), expected.size()).has_value() ||
+        shine::util::zlibInflate(stream, expected.size() - 1, expected.size() - 1).has_value()) {
+        ++failures;
+        fmt::println("  FAIL: maxOutput 边界判断错误");
+    }
+
+    // raw deflate 的消耗字节数
+    size_t consumed = 0;
+    std::vector<uint8_t> raw(stream.begin() + 2, stream.end() - 4);
+    raw.push_back(0xAB);
+    auto rawResult = shine::util::inflateRaw(raw, 0, 0, &consumed);
+    if (!rawResult.has_value() || *rawResult != expected || consumed != raw.size() - 1) {
+        ++failures;
+        fmt::println("  FAIL: inflateRaw consumed={} 期望={}", consumed, raw.size() - 1);
+    }
+
+    fmt::println("错误输入/截断/上限: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+void benchmark() {
+    fmt::println("\n=== 性能测试（约 16MB 动态块数据） ===\n");
+
+    StreamGenerator gen(7);
+    for (int b = 0; b < 64; ++b) gen.huffmanBlock(b == 63, true, 20000);
+    const auto stream = gen.zlib();
+    const size_t outputSize = gen.expected().size();
+
+    auto run = [&](const char* name, auto&& fn) {
+        const auto result = shine::benchmark::run_benchmark(name, fn, 10, 2);
+        fmt::println("   吞吐量: {:.1f} MB/s（输出）\n", outputSize * 1000.0 / result.median_time_ns);
+    };
+    run("zlibInflate", [&] { (void)shine::util::zlibInflate(stream, outputSize); });
+    run("zlibInflateReference", [&] { (void)shine::util::zlibInflateReference(stream); });
+}
+
+} // namespace
+
+int main() {
+    fmt::println("=== 正确性测试（与生成器期望输出及对照实现对比） ===\n");
+    int failures = test_random_streams();
+    failures += test_invalid_streams();
+
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
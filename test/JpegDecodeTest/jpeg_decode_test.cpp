@@ -0,0 +1,351 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "../../src/image/jpeg.h"
+#include "fmt/format.h"
+
+namespace {
+
+// 40x24 RGB 测试图（水平/垂直渐变 + 8x8 棋盘格蓝色通道），libjpeg 质量 80、4:2:0 编码。
+// kProgressiveJpeg 使用 jpeg_simple_progression（含 DC/AC 细化扫描）且 DRI = 2，
+// 量化结果与 kBaselineJpeg 完全相同，因此两者解码结果应逐字节一致。
+constexpr uint8_t kBaselineJpeg[] = {
+    0xFF, 0xD8, 0xFF, 0xDB, 0x00, 0x43, 0x00, 0x06, 0x04, 0x05, 0x06, 0x05, 0x04, 0x06, 0x06, 0x05,
+    0x06, 0x07, 0x07, 0x06, 0x08, 0x0A, 0x10, 0x0A, 0x0A, 0x09, 0x09, 0x0A, 0x14, 0x0E, 0x0F, 0x0C,
+    0x10, 0x17, 0x14, 0x18, 0x18, 0x17, 0x14, 0x16, 0x16, 0x1A, 0x1D, 0x25, 0x1F, 0x1A, 0x1B, 0x23,
+    0x1C, 0x16, 0x16, 0x20, 0x2C, 0x20, 0x23, 0x26, 0x27, 0x29, 0x2A, 0x29, 0x19, 0x1F, 0x2D, 0x30,
+    0x2D, 0x28, 0x30, 0x25, 0x28, 0x29, 0x28, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x07, 0x07, 0x07, 0x0A,
+    0x08, 0x0A, 0x13, 0x0A, 0x0A, 0x13, 0x28, 0x1A, 0x16, 0x1A, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0xFF, 0xC0, 0x00, 0x11,
+    0x08, 0x00, 0x18, 0x00, 0x28, 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF,
+    0xC4, 0x00, 0x18, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x03, 0x07, 0x08, 0xFF, 0xC4, 0x00, 0x18, 0x10, 0x00, 0x02,
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04,
+    0x05, 0x22, 0x31, 0xFF, 0xC4, 0x00, 0x16, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x05, 0x08, 0xFF, 0xC4, 0x00, 0x29, 0x11,
+    0x00, 0x00, 0x04, 0x04, 0x03, 0x08, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x03, 0x11, 0x21, 0x02, 0x04, 0x05, 0x13, 0x06, 0x12, 0x16, 0x22, 0x23, 0x31, 0x41, 0x52,
+    0x82, 0x91, 0xC1, 0x33, 0xA2, 0xE1, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03,
+    0x11, 0x00, 0x3F, 0x00, 0xF3, 0xF2, 0xF1, 0x59, 0x52, 0xB1, 0x78, 0xAC, 0xA9, 0x56, 0xBC, 0x56,
+    0x54, 0xC9, 0x78, 0xAC, 0xA8, 0x80, 0xDA, 0x8E, 0x9E, 0xE7, 0x72, 0xE7, 0x6A, 0x65, 0xF2, 0xAA,
+    0xA2, 0x55, 0x3E, 0xAD, 0x75, 0x1D, 0x10, 0x49, 0xAF, 0x15, 0x95, 0x2B, 0x17, 0x8A, 0xCA, 0x95,
+    0x6B, 0xC5, 0x65, 0x4C, 0x97, 0x8A, 0xCA, 0x93, 0x0D, 0xA8, 0xE9, 0xEE, 0x77, 0x2E, 0x76, 0xA6,
+    0x5F, 0x2A, 0xAA, 0x1B, 0xD3, 0xEA, 0xD7, 0x51, 0xD1, 0x04, 0xA2, 0xF1, 0x59, 0x50, 0x75, 0x75,
+    0xE2, 0xB2, 0xA0, 0x9F, 0x15, 0x1D, 0xFE, 0x6F, 0xAF, 0xE8, 0x5E, 0x45, 0x77, 0x60, 0x4C, 0x2F,
+    0x15, 0x95, 0x2B, 0x17, 0x8A, 0xCA, 0x80, 0x4E, 0xC3, 0x67, 0xC7, 0xBE, 0x7E, 0x9F, 0x63, 0x2C,
+    0x4B, 0x4C, 0x98, 0xCE, 0x32, 0x5E, 0x2B, 0x2A, 0x55, 0xAF, 0x15, 0x95, 0x00, 0x9B, 0x86, 0xCF,
+    0x8F, 0x7C, 0xFD, 0x3E, 0xC3, 0x79, 0x69, 0x93, 0x19, 0xC6, 0x4B, 0xC5, 0x65, 0x40, 0x00, 0x18,
+    0x8F, 0x8D, 0x78, 0x86, 0xE4, 0x4C, 0x99, 0x93, 0x88, 0xFF, 0xD9,
+};
+
+constexpr uint8_t kProgressiveJpeg[] = {
+    0xFF, 0xD8, 0xFF, 0xDB, 0x00, 0x43, 0x00, 0x06, 0x04, 0x05, 0x06, 0x05, 0x04, 0x06, 0x06, 0x05,
+    0x06, 0x07, 0x07, 0x06, 0x08, 0x0A, 0x10, 0x0A, 0x0A, 0x09, 0x09, 0x0A, 0x14, 0x0E, 0x0F, 0x0C,
+    0x10, 0x17, 0x14, 0x18, 0x18, 0x17, 0x14, 0x16, 0x16, 0x1A, 0x1D, 0x25, 0x1F, 0x1A, 0x1B, 0x23,
+    0x1C, 0x16, 0x16, 0x20, 0x2C, 0x20, 0x23, 0x26, 0x27, 0x29, 0x2A, 0x29, 0x19, 0x1F, 0x2D, 0x30,
+    0x2D, 0x28, 0x30, 0x25, 0x28, 0x29, 0x28, 0xFF, 0xDB, 0x00, 0x43, 0x01, 0x07, 0x07, 0x07, 0x0A,
+    0x08, 0x0A, 0x13, 0x0A, 0x0A, 0x13, 0x28, 0x1A, 0x16, 0x1A, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28,
+    0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0x28, 0xFF, 0xC2, 0x00, 0x11,
+    0x08, 0x00, 0x18, 0x00, 0x28, 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xFF,
+    0xC4, 0x00, 0x18, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x02, 0x06, 0x07, 0xFF, 0xC4, 0x00, 0x18, 0x01, 0x01, 0x01,
+    0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x04,
+    0x02, 0x06, 0x07, 0xFF, 0xDD, 0x00, 0x04, 0x00, 0x02, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00,
+    0x02, 0x10, 0x03, 0x10, 0x00, 0x00, 0x01, 0xF3, 0xE5, 0x96, 0xC2, 0x12, 0x12, 0xB2, 0xD8, 0x95,
+    0xCF, 0xFF, 0xD0, 0x16, 0xEA, 0xEC, 0x76, 0x83, 0x16, 0xA9, 0xF9, 0x67, 0xFF, 0xD1, 0x45, 0x6A,
+    0x30, 0xFC, 0x54, 0x03, 0x9F, 0xFF, 0xC4, 0x00, 0x16, 0x10, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xFF, 0xDA, 0x00,
+    0x08, 0x01, 0x01, 0x00, 0x01, 0x05, 0x02, 0x59, 0x0B, 0x23, 0xFF, 0xD0, 0x59, 0x0B, 0x23, 0xFF,
+    0xD1, 0x59, 0x0B, 0x23, 0xFF, 0xD2, 0x59, 0x0B, 0x23, 0xFF, 0xD3, 0x59, 0x0B, 0x23, 0xFF, 0xD4,
+    0x59, 0x0B, 0x23, 0xFF, 0xD5, 0x59, 0x0B, 0x23, 0xFF, 0xD6, 0x59, 0x1F, 0xFF, 0xC4, 0x00, 0x1A,
+    0x11, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x02, 0x03, 0x04, 0x12, 0x11, 0x21, 0xFF, 0xDA, 0x00, 0x08, 0x01, 0x03, 0x01, 0x01,
+    0x3F, 0x01, 0xCF, 0xAF, 0xA3, 0x3E, 0xBE, 0x8F, 0xFF, 0xD0, 0x4D, 0xDF, 0x09, 0xD1, 0x8F, 0xFF,
+    0xD1, 0x9D, 0x18, 0x4A, 0x37, 0x87, 0xFF, 0xC4, 0x00, 0x1F, 0x11, 0x00, 0x00, 0x04, 0x07, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x81, 0x04,
+    0x05, 0x12, 0x15, 0x22, 0x31, 0x62, 0xA1, 0xFF, 0xDA, 0x00, 0x08, 0x01, 0x02, 0x01, 0x01, 0x3F,
+    0x01, 0x54, 0x45, 0xBF, 0xAA, 0x9B, 0x41, 0x51, 0x16, 0xFE, 0xAA, 0x6D, 0x0F, 0xFF, 0xD0, 0x38,
+    0x3E, 0xFC, 0x12, 0xD5, 0x9E, 0x6C, 0x3F, 0xFF, 0xD1, 0x96, 0xAC, 0xF3, 0x60, 0x6B, 0x31, 0xFF,
+    0xC4, 0x00, 0x15, 0x10, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0xFF, 0xDA, 0x00, 0x08, 0x01, 0x01, 0x00, 0x06, 0x3F, 0x02,
+    0x3F, 0xFF, 0xD0, 0x3F, 0xFF, 0xD1, 0x3F, 0xFF, 0xD2, 0x3F, 0xFF, 0xD3, 0x3F, 0xFF, 0xD4, 0x3F,
+    0xFF, 0xD5, 0x3F, 0xFF, 0xD6, 0xBF, 0xFF, 0xC4, 0x00, 0x15, 0x10, 0x01, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61, 0xFF, 0xDA, 0x00,
+    0x08, 0x01, 0x01, 0x00, 0x01, 0x3F, 0x21, 0x82, 0x0F, 0xFF, 0xD0, 0x82, 0x0F, 0xFF, 0xD1, 0x82,
+    0x0F, 0xFF, 0xD2, 0x82, 0x0F, 0xFF, 0xD3, 0x82, 0x0F, 0xFF, 0xD4, 0x82, 0x0F, 0xFF, 0xD5, 0x82,
+    0x0F, 0xFF, 0xD6, 0x83, 0xFF, 0xDA, 0x00, 0x0C, 0x03, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00,
+    0x00, 0x10, 0xD7, 0x6F, 0xFF, 0xD0, 0x3C, 0x0F, 0xFF, 0xD1, 0x87, 0xCF, 0xFF, 0xC4, 0x00, 0x17,
+    0x11, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x21, 0x00, 0x11, 0x41, 0xFF, 0xDA, 0x00, 0x08, 0x01, 0x03, 0x01, 0x01, 0x3F, 0x10, 0x0B,
+    0x99, 0x05, 0xCC, 0xBF, 0xFF, 0xD0, 0xB9, 0x9B, 0xFF, 0xD1, 0x33, 0x77, 0x6F, 0xFF, 0xC4, 0x00,
+    0x1C, 0x11, 0x00, 0x02, 0x01, 0x05, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x11, 0xB1, 0x21, 0x41, 0x51, 0xA1, 0xF0, 0x31, 0xFF, 0xDA, 0x00, 0x08, 0x01,
+    0x02, 0x01, 0x01, 0x3F, 0x10, 0xCF, 0x81, 0xB3, 0x6C, 0xCF, 0x81, 0xB3, 0x6C, 0xFF, 0xD0, 0xA9,
+    0xC4, 0x97, 0x6E, 0x33, 0xFF, 0xD1, 0xBB, 0x71, 0x8D, 0xFA, 0x7F, 0xFF, 0xC4, 0x00, 0x15, 0x10,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x31, 0xFF, 0xDA, 0x00, 0x08, 0x01, 0x01, 0x00, 0x01, 0x3F, 0x10, 0x89, 0x13, 0xFF, 0xD0,
+    0x89, 0x13, 0xFF, 0xD1, 0x89, 0x13, 0xFF, 0xD2, 0x89, 0x13, 0xFF, 0xD3, 0x89, 0x13, 0xFF, 0xD4,
+    0x89, 0x13, 0xFF, 0xD5, 0x89, 0x13, 0xFF, 0xD6, 0x89, 0xFF, 0xD9,
+};
+struct ReferencePixel { uint32_t x; uint32_t y; uint8_t r; uint8_t g; uint8_t b; };
+
+// libjpeg（JDCT_ISLOW，关闭平滑上采样）对 kBaselineJpeg 的解码结果
+constexpr ReferencePixel kReferencePixels[] = {
+    { 0, 0, 0, 6, 42 },
+    { 39, 0, 228, 5, 34 },
+    { 20, 12, 113, 124, 188 },
+    { 5, 20, 21, 206, 25 },
+    { 39, 23, 234, 228, 42 },
+};
+
+constexpr uint32_t kWidth = 40;
+constexpr uint32_t kHeight = 24;
+
+double luma(const uint8_t* rgba) {
+    return 0.299 * rgba[0] + 0.587 * rgba[1] + 0.114 * rgba[2];
+}
+
+bool decode_jpeg(shine::image::jpeg& decoder, const uint8_t* data, size_t size) {
+    if (!decoder.loadFromMemory(data, size)) {
+        fmt::println("  FAIL: loadFromMemory");
+        return false;
+    }
+    const auto result = decoder.decode();
+    if (!result.has_value()) {
+        fmt::println("  FAIL: {}", result.error());
+        return false;
+    }
+    return true;
+}
+
+int test_baseline() {
+    int failures = 0;
+    shine::image::jpeg decoder;
+    int previews = 0;
+    decoder.setPreviewCallback([&](const shine::image::JpegPreview&) { ++previews; });
+
+    if (!decode_jpeg(decoder, kBaselineJpeg, sizeof(kBaselineJpeg))) {
+        return 1;
+    }
+    if (decoder.getWidth() != kWidth || decoder.getHeight() != kHeight || decoder.isProgressive() || previews != 0) {
+        ++failures;
+        fmt::println("  FAIL: 基线图像信息错误");
+    }
+
+    const auto& pixels = decoder.getImageData();
+    for (const ReferencePixel& ref : kReferencePixels) {
+        const uint8_t* p = pixels.data() + (static_cast<size_t>(ref.y) * kWidth + ref.x) * 4;
+        if (std::abs(p[0] - ref.r) > 4 || std::abs(p[1] - ref.g) > 4 || std::abs(p[2] - ref.b) > 4 || p[3] != 255) {
+            ++failures;
+            fmt::println("  FAIL: 像素 ({}, {}) = ({}, {}, {})，期望 ({}, {}, {})",
+                ref.x, ref.y, p[0], p[1], p[2], ref.r, ref.g, ref.b);
+        }
+    }
+
+    fmt::println("基线解码: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+int test_progressive() {
+    int failures = 0;
+    shine::image::jpeg baseline;
+    if (!decode_jpeg(baseline, kBaselineJpeg, sizeof(kBaselineJpeg))) {
+        return 1;
+    }
+
+    shine::image::jpeg decoder;
+    std::vector<uint8_t> preview;
+    uint32_t previewWidth = 0;
+    uint32_t previewHeight = 0;
+    uint32_t previewScan = 0;
+    int previews = 0;
+    decoder.setPreviewCallback([&](const shine::image::JpegPreview& p) {
+        ++previews;
+        previewWidth = p.width;
+        previewHeight = p.height;
+        previewScan = p.scanIndex;
+        preview.assign(p.rgba.begin(), p.rgba.end());
+    });
+
+    if (!decode_jpeg(decoder, kProgressiveJpeg, sizeof(kProgressiveJpeg))) {
+        return 1;
+    }
+    if (!decoder.isProgressive() || decoder.getScanCount() < 2) {
+        ++failures;
+        fmt::println("  FAIL: 未识别为渐进式（扫描数 {}）", decoder.getScanCount());
+    }
+    if (decoder.getImageData() != baseline.getImageData()) {
+        ++failures;
+        fmt::println("  FAIL: 渐进式与基线解码结果不一致");
+    }
+
+    // 预览：首个 DC 扫描之后触发一次，1/8 分辨率，每个像素的亮度约等于对应 8x8 块的平均亮度
+    // （色度按 4:2:0 覆盖 16x16，只比较亮度）
+    if (previews != 1 || previewWidth != kWidth / 8 || previewHeight != kHeight / 8 ||
+        previewScan + 1 >= decoder.getScanCount() || preview.size() != previewWidth * previewHeight * 4) {
+        ++failures;
+        fmt::println("  FAIL: 预览回调 次数={} 尺寸={}x{} 扫描={}", previews, previewWidth, previewHeight, previewScan);
+    } else {
+        const auto& full = decoder.getImageData();
+        double totalDiff = 0.0;
+        for (uint32_t by = 0; by < previewHeight; ++by) {
+            for (uint32_t bx = 0; bx < previewWidth; ++bx) {
+                double blockLuma = 0.0;
+                for (uint32_t y = 0; y < 8; ++y) {
+                    for (uint32_t x = 0; x < 8; ++x) {
+                        blockLuma += luma(full.data() + ((by * 8 + y) * kWidth + bx * 8 + x) * 4) / 64.0;
+                    }
+                }
+                totalDiff += std::abs(blockLuma - luma(preview.data() + (by * previewWidth + bx) * 4));
+            }
+        }
+        const double meanDiff = totalDiff / (previewWidth * previewHeight);
+        if (meanDiff > 4.0) {
+            ++failures;
+            fmt::println("  FAIL: 预览与块平均值偏差过大 {:.2f}", meanDiff);
+        }
+    }
+
+    fmt::println("渐进式解码: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+int test_parallel() {
+    int failures = 0;
+
+    // 渐进式样例带 DRI，各扫描都按 RSTn 切分后并行熵解码，结果应与串行逐字节一致
+    shine::image::jpeg serial;
+    if (!decode_jpeg(serial, kProgressiveJpeg, sizeof(kProgressiveJpeg))) {
+        return 1;
+    }
+
+    shine::image::jpeg parallel;
+    parallel.setParallelDecode(true, 0);
+    if (!decode_jpeg(parallel, kProgressiveJpeg, sizeof(kProgressiveJpeg))) {
+        return 1;
+    }
+    if (parallel.getImageData() != serial.getImageData()) {
+        ++failures;
+        fmt::println("  FAIL: 并行与串行解码结果不一致");
+    }
+
+    // 截断的扫描中 RSTn 数量不足，回退到串行路径并报错
+    shine::image::jpeg truncated;
+    truncated.setParallelDecode(true, 0);
+    if (truncated.loadFromMemory(kProgressiveJpeg, sizeof(kProgressiveJpeg) / 2) && truncated.decode().has_value()) {
+        ++failures;
+        fmt::println("  FAIL: 并行解码截断数据未报错");
+    }
+
+    fmt::println("按重启间隔并行解码: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+int test_scaled() {
+    int failures = 0;
+
+    shine::image::jpeg full;
+    if (!decode_jpeg(full, kBaselineJpeg, sizeof(kBaselineJpeg))) {
+        return 1;
+    }
+
+    for (shine::image::JpegScale scale : { shine::image::JpegScale::Half, shine::image::JpegScale::Quarter,
+             shine::image::JpegScale::Eighth }) {
+        const uint32_t denom = static_cast<uint32_t>(scale);
+
+        // 基线与渐进式样例量化结果相同，缩放解码结果也应逐字节一致
+        shine::image::jpeg baseline;
+        shine::image::jpeg progressive;
+        if (!baseline.loadFromMemory(kBaselineJpeg, sizeof(kBaselineJpeg)) || !baseline.decodeScaled(scale).has_value() ||
+            !progressive.loadFromMemory(kProgressiveJpeg, sizeof(kProgressiveJpeg)) ||
+            !progressive.decodeScaled(scale).has_value()) {
+            ++failures;
+            fmt::println("  FAIL: 1/{} 缩放解码失败", denom);
+            continue;
+        }
+
+        const uint32_t width = (kWidth + denom - 1) / denom;
+        const uint32_t height = (kHeight + denom - 1) / denom;
+        if (baseline.getOutputWidth() != width || baseline.getOutputHeight() != height ||
+            baseline.getImageData().size() != static_cast<size_t>(width) * height * 4) {
+            ++failures;
+            fmt::println("  FAIL: 1/{} 输出尺寸 {}x{}，期望 {}x{}", denom,
+                baseline.getOutputWidth(), baseline.getOutputHeight(), width, height);
+            continue;
+        }
+        if (progressive.getImageData() != baseline.getImageData()) {
+            ++failures;
+            fmt::println("  FAIL: 1/{} 基线与渐进式结果不一致", denom);
+        }
+
+        // 每个输出像素约等于全尺寸解码结果中对应 denom×denom 区域的平均值
+        double maxError = 0.0;
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                double sum = 0.0;
+                for (uint32_t dy = 0; dy < denom; ++dy) {
+                    for (uint32_t dx = 0; dx < denom; ++dx) {
+                        sum += luma(full.getImageData().data() + (static_cast<size_t>(y * denom + dy) * kWidth + x * denom + dx) * 4);
+                    }
+                }
+                const double actual = luma(baseline.getImageData().data() + (static_cast<size_t>(y) * width + x) * 4);
+                maxError = std::max(maxError, std::abs(actual - sum / (denom * denom)));
+            }
+        }
+        if (maxError > 3.0) {
+            ++failures;
+            fmt::println("  FAIL: 1/{} 与区域平均的亮度误差 {:.1f}", denom, maxError);
+        }
+    }
+
+    if (shine::image::jpeg::selectScale(4000, 3000, 256) != shine::image::JpegScale::Eighth ||
+        shine::image::jpeg::selectScale(4000, 3000, 600) != shine::image::JpegScale::Quarter ||
+        shine::image::jpeg::selectScale(4000, 3000, 2001) != shine::image::JpegScale::Full ||
+        shine::image::jpeg::selectScale(100, 50, 256) != shine::image::JpegScale::Full) {
+        ++failures;
+        fmt::println("  FAIL: selectScale");
+    }
+
+    fmt::println("缩放解码: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+int test_truncated() {
+    int failures = 0;
+
+    // 截断的渐进式数据应当报错而不是越界读取
+    shine::image::jpeg decoder;
+    const bool loaded = decoder.loadFromMemory(kProgressiveJpeg, sizeof(kProgressiveJpeg) / 2);
+    if (loaded && decoder.decode().has_value()) {
+        ++failures;
+        fmt::println("  FAIL: 截断数据未报错");
+    }
+
+    fmt::println("截断数据: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+} // namespace
+
+int main() {
+    fmt::println("=== 正确性测试 ===\n");
+    int failures = test_baseline();
+    failures += test_progressive();
+    failures += test_parallel();
+    failures += test_scaled();
+    failures += test_truncated();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../../src/image/jpeg_dsp.h"
+#include "../SimplePerfTest/benchmark_framework.h"
+#include "fmt/format.h"
+
+using shine::image::jpeg_dsp::DspBackend;
+namespace jpeg_dsp = shine::image::jpeg_dsp;
+
+namespace {
+
+constexpr DspBackend kSimdBackends[] = {
+    DspBackend::SSE2,
+    DspBackend::AVX2,
+};
+
+/**
+ * @brief 随机 DCT 系数块
+ * @param kind 0 = 典型（低频为主、大量零），1 = 只有 DC，2 = 全范围随机（畸形数据）
+ */
+void fill_coefficients(std::vector<int16_t>& coefficients, int kind, std::mt19937& rng) {
+    for (size_t i = 0; i < coefficients.size(); ++i) {
+        const size_t k = i % 64;
+        switch (kind) {
+        case 0: {
+            const int range = k == 0 ? 2048 : static_cast<int>(256 / (1 + k / 8 + k % 8));
+            coefficients[i] = (rng() % 3 == 0 || k == 0) ? static_cast<int16_t>(static_cast<int>(rng() % range) - range / 2) : 0;
+            break;
+        }
+        case 1: coefficients[i] = k == 0 ? static_cast<int16_t>(static_cast<int>(rng() % 4096) - 2048) : 0; break;
+        default: coefficients[i] = static_cast<int16_t>(rng()); break;
+        }
+    }
+}
+
+/**
+ * @brief 逐字节对比 IDCT 内核与标量实现
+ * @return 不一致的用例数
+ */
+int compare_idct(DspBackend backend, std::mt19937& rng) {
+    constexpr size_t blockCounts[] = { 1, 2, 3, 4, 5, 8, 17 };
+
+    int failures = 0;
+    for (int kind = 0; kind < 3; ++kind) {
+        for (size_t blockCount : blockCounts) {
+            for (int iteration = 0; iteration < 50; ++iteration) {
+                std::vector<int16_t> coefficients(blockCount * 64);
+                fill_coefficients(coefficients, kind, rng);
+
+                uint16_t quant[64];
+                for (auto& q : quant) q = static_cast<uint16_t>(kind == 2 ? rng() : 1 + rng() % 64);
+
+                // 输出跨度大于块行宽度，检查内核不会越过块的右边界
+                const size_t stride = blockCount * 8 + 5;
+                std::vector<uint8_t> expected(stride * 8, 0xCD), actual(stride * 8, 0xCD);
+                jpeg_dsp::idctBlocks(DspBackend::Scalar, coefficients.data(), quant, expected.data(), stride, blockCount);
+                jpeg_dsp::idctBlocks(backend, coefficients.data(), quant, actual.data(), stride, blockCount);
+
+                if (expected != actual) {
+                    ++failures;
+                    fmt::println("  FAIL: {} IDCT kind={} blocks={}", jpeg_dsp::backendName(backend), kind, blockCount);
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+/**
+ * @brief 逐字节对比颜色转换内核与标量实现
+ * @return 不一致的用例数
+ */
+int compare_color(DspBackend backend, std::mt19937& rng) {
+    constexpr size_t widths[] = { 0, 1, 2, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1023 };
+
+    int failures = 0;
+    for (uint32_t chromaShift : { 0u, 1u }) {
+        for (size_t width : widths) {
+            const size_t chromaWidth = (width + chromaShift) >> chromaShift;
+            std::vector<uint8_t> y(width), cb(chromaWidth), cr(chromaWidth);
+            for (auto& v : y) v = static_cast<uint8_t>(rng());
+            for (auto& v : cb) v = static_cast<uint8_t>(rng());
+            for (auto& v : cr) v = static_cast<uint8_t>(rng());
+
+            std::vector<uint8_t> expected(width * 4 + 4, 0xCD), actual(width * 4 + 4, 0xCD);
+            jpeg_dsp::yccToRgbaRow(DspBackend::Scalar, y.data(), cb.data(), cr.data(), expected.data(), width, chromaShift);
+            jpeg_dsp::yccToRgbaRow(backend, y.data(), cb.data(), cr.data(), actual.data(), width, chromaShift);
+
+            if (expected != actual) {
+                ++failures;
+                fmt::println("  FAIL: {} YCbCr width={} shift={}", jpeg_dsp::backendName(backend), width, chromaShift);
+            }
+        }
+    }
+    return failures;
+}
+
+/**
+ * @brief 标量实现与浮点 IDCT / JFIF 公式对比（误差不超过 1）
+ */
+int test_reference() {
+    constexpr double pi = 3.14159265358979323846;
+
+    int failures = 0;
+    std::mt19937 rng(11);
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        std::vector<int16_t> coefficients(64);
+        fill_coefficients(coefficients, 0, rng);
+        uint16_t quant[64];
+        for (auto& q : quant) q = static_cast<uint16_t>(1 + rng() % 8);
+
+        uint8_t actual[64];
+        jpeg_dsp::idctBlocks(DspBackend::Scalar, coefficients.data(), quant, actual, 8, 1);
+
+        for (int y = 0; y < 8; ++y) {
+            for (int x = 0; x < 8; ++x) {
+                double sum = 0.0;
+                for (int v = 0; v < 8; ++v) {
+                    for (int u = 0; u < 8; ++u) {
+                        const double cu = u == 0 ? 1.0 / std::sqrt(2.0) : 1.0;
+                        const double cv = v == 0 ? 1.0 / std::sqrt(2.0) : 1.0;
+                        sum += cu * cv * coefficients[v * 8 + u] * quant[v * 8 + u] *
+                            std::cos((2 * x + 1) * u * pi / 16) * std::cos((2 * y + 1) * v * pi / 16);
+                    }
+                }
+                const double expected = std::clamp(sum / 4.0 + 128.0, 0.0, 255.0);
+                if (std::abs(expected - actual[y * 8 + x]) > 1.0) {
+                    ++failures;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < 4096; ++i) {
+        const uint8_t y = static_cast<uint8_t>(rng()), cb = static_cast<uint8_t>(rng()), cr = static_cast<uint8_t>(rng());
+        uint8_t rgba[4];
+        jpeg_dsp::yccToRgbaRow(DspBackend::Scalar, &y, &cb, &cr, rgba, 1, 0);
+        const double r = y + 1.402 * (cr - 128);
+        const double g = y - 0.344136 * (cb - 128) - 0.714136 * (cr - 128);
+        const double b = y + 1.772 * (cb - 128);
+        if (std::abs(std::clamp(r, 0.0, 255.0) - rgba[0]) > 1.0 || std::abs(std::clamp(g, 0.0, 255.0) - rgba[1]) > 1.0 ||
+            std::abs(std::clamp(b, 0.0, 255.0) - rgba[2]) > 1.0 || rgba[3] != 255) {
+            ++failures;
+        }
+    }
+
+    fmt::println("标量实现与浮点参考: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试（与标量实现逐字节对比） ===\n");
+    fmt::println("当前内核: {}", jpeg_dsp::backendName(jpeg_dsp::activeBackend()));
+
+    int failures = test_reference();
+
+    std::mt19937 rng(20240601);
+    for (DspBackend backend : kSimdBackends) {
+        if (!jpeg_dsp::isBackendSupported(backend)) {
+            fmt::println("{}: SKIP（当前 CPU 不支持）", jpeg_dsp::backendName(backend));
+            continue;
+        }
+        const int backendFailures = compare_idct(backend, rng) + compare_color(backend, rng);
+        fmt::println("{}: {}", jpeg_dsp::backendName(backend), backendFailures == 0 ? "PASS" : "FAIL");
+        failures += backendFailures;
+    }
+
+    fmt::println("");
+    return failures;
+}
+
+void benchmark() {
+    // 1920x1080：亮度 240x135 个块，色度按 4:2:0 水平共享
+    constexpr size_t blocksPerLine = 240;
+    constexpr size_t blockRows = 135;
+    constexpr size_t width = blocksPerLine * 8;
+    constexpr size_t height = blockRows * 8;
+    fmt::println("=== 性能测试（{}x{}，IDCT + 4:2:0 颜色转换） ===\n", width, height);
+
+    std::mt19937 rng(7);
+    std::vector<int16_t> coefficients(blocksPerLine * blockRows * 64);
+    fill_coefficients(coefficients, 0, rng);
+    uint16_t quant[64];
+    for (auto& q : quant) q = static_cast<uint16_t>(1 + rng() % 16);
+
+    std::vector<uint8_t> luma(width * height);
+    std::vector<uint8_t> chroma(width / 2 * (height / 2 + 1));
+    for (auto& v : chroma) v = static_cast<uint8_t>(rng());
+    std::vector<uint8_t> rgba(width * height * 4);
+
+    for (DspBackend backend : { DspBackend::Scalar, DspBackend::SSE2, DspBackend::AVX2 }) {
+        if (!jpeg_dsp::isBackendSupported(backend)) {
+            continue;
+        }
+
+        const auto idct = shine::benchmark::run_benchmark(
+            fmt::format("IDCT / {}", jpeg_dsp::backendName(backend)),
+            [&] {
+                for (size_t row = 0; row < blockRows; ++row) {
+                    jpeg_dsp::idctBlocks(backend, coefficients.data() + row * blocksPerLine * 64, quant,
+                        luma.data() + row * 8 * width, width, blocksPerLine);
+                }
+            },
+            50, 5);
+        fmt::println("   吞吐量: {:.1f} 百万块/秒\n", static_cast<double>(blocksPerLine * blockRows) * 1e3 / idct.median_time_ns);
+
+        const auto color = shine::benchmark::run_benchmark(
+            fmt::format("YCbCr -> RGBA / {}", jpeg_dsp::backendName(backend)),
+            [&] {
+                for (size_t y = 0; y < height; ++y) {
+                    const uint8_t* chromaRow = chroma.data() + (y / 2) * (width / 2);
+                    jpeg_dsp::yccToRgbaRow(backend, luma.data() + y * width, chromaRow, chromaRow,
+                        rgba.data() + y * width * 4, width, 1);
+                }
+            },
+            50, 5);
+        fmt::println("   吞吐量: {:.1f} 百万像素/秒\n", static_cast<double>(width * height) * 1e3 / color.median_time_ns);
+    }
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
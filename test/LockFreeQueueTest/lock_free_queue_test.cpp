@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../src/data/structure/mpmc_queue.h"
+#include "../../src/data/structure/spsc_queue.h"
+#include "../../src/util/shine_define.h"
+#include "fmt/format.h"
+
+using shine::data::mpmc_queue;
+using shine::data::spsc_queue;
+
+namespace {
+
+// ============================================================================
+// 对照组：shine::data::safe_queue（模块接口文件，这里复制一份同样的实现）
+// ============================================================================
+
+template<typename T>
+class safe_queue
+{
+public:
+    void push(const T& event) {
+        std::lock_guard<std::mutex> lock(mtx);
+        queue.push(event);
+        cv.notify_one();
+    }
+
+    bool try_pop(T& item) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (queue.empty()) return false;
+        item = std::move(queue.front());
+        queue.pop();
+        return true;
+    }
+
+private:
+    std::queue<T> queue;
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+};
+
+// ============================================================================
+// 正确性
+// ============================================================================
+
+std::atomic<int> g_live{0};
+
+struct Tracked {
+    std::string payload;
+    Tracked() { ++g_live; }
+    explicit Tracked(std::string text) : payload(std::move(text)) { ++g_live; }
+    Tracked(const Tracked& other) : payload(other.payload) { ++g_live; }
+    Tracked(Tracked&& other) noexcept : payload(std::move(other.payload)) { ++g_live; }
+    Tracked& operator=(Tracked&&) noexcept = default;
+    Tracked& operator=(const Tracked&) = default;
+    ~Tracked() { --g_live; }
+};
+
+template<typename Queue>
+int check_single_thread(const char* label) {
+    int failures = 0;
+    {
+        Queue queue(5);
+        if (queue.capacity() != 8) {
+            ++failures;
+            fmt::println("  FAIL: {} capacity {} (expected 8)", label, queue.capacity());
+        }
+
+        // 多轮填满再清空，覆盖回绕
+        for (int lap = 0; lap < 5; ++lap) {
+            u32 pushed = 0;
+            while (queue.try_emplace(fmt::format("item-{}-{}", lap, pushed))) ++pushed;
+            if (pushed != 8) {
+                ++failures;
+                fmt::println("  FAIL: {} lap {} accepted {} items", label, lap, pushed);
+            }
+            Tracked item;
+            for (u32 i = 0; i < pushed; ++i) {
+                if (!queue.try_pop(item) || item.payload != fmt::format("item-{}-{}", lap, i)) {
+                    ++failures;
+                    fmt::println("  FAIL: {} lap {} item {} out of order", label, lap, i);
+                    break;
+                }
+            }
+            if (queue.try_pop(item) || !queue.empty()) {
+                ++failures;
+                fmt::println("  FAIL: {} lap {} not empty after draining", label, lap);
+            }
+        }
+
+        // 析构时销毁残留元素
+        queue.try_emplace("left-1");
+        queue.try_emplace("left-2");
+    }
+    if (g_live.load() != 0) {
+        ++failures;
+        fmt::println("  FAIL: {} leaked {} elements", label, g_live.load());
+        g_live = 0;
+    }
+    return failures;
+}
+
+int test_single_thread() {
+    return check_single_thread<mpmc_queue<Tracked>>("mpmc") + check_single_thread<spsc_queue<Tracked>>("spsc");
+}
+
+// 生产者 p 依次推送 (p << 32) | seq；每个消费者看到的同一生产者序号必须递增，总和必须完整
+int check_mpmc(u32 producers, u32 consumers, u32 perProducer) {
+    mpmc_queue<u64> queue(256);
+    std::atomic<u64> popped{0};
+    std::atomic<u64> sum{0};
+    std::atomic<u32> disorder{0};
+    const u64 total = static_cast<u64>(producers) * perProducer;
+
+    std::vector<std::thread> threads;
+    for (u32 p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (u32 seq = 0; seq < perProducer; ++seq) {
+                while (!queue.try_push((static_cast<u64>(p) << 32) | seq)) std::this_thread::yield();
+            }
+        });
+    }
+    for (u32 c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            std::vector<s64> last(producers, -1);
+            u64 value;
+            while (popped.load(std::memory_order_relaxed) < total) {
+                if (!queue.try_pop(value)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const u32 p = static_cast<u32>(value >> 32);
+                const s64 seq = static_cast<s64>(value & 0xFFFFFFFFu);
+                if (seq <= last[p]) disorder.fetch_add(1, std::memory_order_relaxed);
+                last[p] = seq;
+                sum.fetch_add(value & 0xFFFFFFFFu, std::memory_order_relaxed);
+                popped.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    const u64 expectedSum = static_cast<u64>(producers) * perProducer * (perProducer - 1) / 2;
+    if (popped.load() != total || sum.load() != expectedSum || disorder.load() != 0 || !queue.empty()) {
+        fmt::println("  FAIL: {}P{}C popped {}/{} sum {}/{} disorder {}", producers, consumers,
+            popped.load(), total, sum.load(), expectedSum, disorder.load());
+        return 1;
+    }
+    return 0;
+}
+
+int test_mpmc_concurrent() {
+    return check_mpmc(1, 1, 100000) + check_mpmc(4, 4, 50000) + check_mpmc(1, 8, 100000) + check_mpmc(8, 1, 20000);
+}
+
+int test_spsc_bulk() {
+    spsc_queue<u32> queue(64);
+    constexpr u32 kItems = 500000;
+    std::thread producer([&] {
+        u32 batch[37];
+        u32 next = 0;
+        while (next < kItems) {
+            const u32 n = std::min<u32>(1 + next % 37, kItems - next);
+            for (u32 i = 0; i < n; ++i) batch[i] = next + i;
+            u32 sent = 0;
+            while (sent < n) {
+                const size_t pushed = (next & 1) ? queue.try_push_bulk(batch + sent, n - sent)
+                                                 : (queue.try_push(batch[sent]) ? 1 : 0);
+                if (pushed == 0) std::this_thread::yield();
+                sent += static_cast<u32>(pushed);
+            }
+            next += n;
+        }
+    });
+
+    u32 expected = 0;
+    u32 errors = 0;
+    u32 out[29];
+    while (expected < kItems) {
+        const size_t n = (expected & 2) ? queue.try_pop_bulk(out, 29) : (queue.try_pop(out[0]) ? 1 : 0);
+        if (n == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (out[i] != expected++) ++errors;
+        }
+    }
+    producer.join();
+
+    if (errors != 0 || !queue.empty()) {
+        fmt::println("  FAIL: spsc bulk saw {} out-of-order items", errors);
+        return 1;
+    }
+    return 0;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试 ===\n");
+    int failures = 0;
+    const std::pair<const char*, int (*)()> cases[] = {
+        { "单线程 FIFO / 满 / 空 / 析构", test_single_thread },
+        { "MPMC 多生产者多消费者", test_mpmc_concurrent },
+        { "SPSC 批量推送与弹出", test_spsc_bulk },
+    };
+    for (const auto& [name, fn] : cases) {
+        const int caseFailures = fn();
+        fmt::println("{}: {}", name, caseFailures == 0 ? "PASS" : "FAIL");
+        failures += caseFailures;
+    }
+
+    fmt::println("");
+    return failures;
+}
+
+// ============================================================================
+// 性能：百万次传递/秒
+// ============================================================================
+
+constexpr u32 kBenchItems = 1u << 20;
+
+template<typename Push, typename Pop>
+double transfers_per_second(u32 producers, u32 consumers, Push&& push, Pop&& pop) {
+    double best = 0.0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        std::atomic<u64> popped{0};
+        const u32 perProducer = kBenchItems / producers;
+        const u64 total = static_cast<u64>(perProducer) * producers;
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (u32 p = 0; p < producers; ++p) {
+            threads.emplace_back([&] {
+                for (u32 i = 0; i < perProducer; ++i) {
+                    while (!push(static_cast<u64>(i))) std::this_thread::yield();
+                }
+            });
+        }
+        for (u32 c = 0; c < consumers; ++c) {
+            threads.emplace_back([&] {
+                u64 value;
+                while (popped.load(std::memory_order_relaxed) < total) {
+                    const u64 n = pop(value);
+                    if (n == 0) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    popped.fetch_add(n, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::max(best, total / seconds);
+    }
+    return best / 1e6;
+}
+
+void benchmark() {
+    fmt::println("=== 性能测试（{} 个 u64，硬件线程 {}，单位：百万次/秒） ===\n", kBenchItems,
+        std::max(1u, std::thread::hardware_concurrency()));
+    fmt::println("{:>6} | {:>10} | {:>10} | {:>10} | {:>12}", "场景", "safe_queue", "mpmc", "spsc", "spsc 批量 64");
+
+    const std::pair<u32, u32> shapes[] = { { 1, 1 }, { 4, 4 }, { 1, 8 } };
+    for (const auto& [producers, consumers] : shapes) {
+        safe_queue<u64> locked;
+        const double lockedRate = transfers_per_second(producers, consumers,
+            [&](u64 v) { locked.push(v); return true; },
+            [&](u64& v) -> u64 { return locked.try_pop(v) ? 1 : 0; });
+
+        mpmc_queue<u64> ring(4096);
+        const double ringRate = transfers_per_second(producers, consumers,
+            [&](u64 v) { return ring.try_push(v); },
+            [&](u64& v) -> u64 { return ring.try_pop(v) ? 1 : 0; });
+
+        if (producers == 1 && consumers == 1) {
+            spsc_queue<u64> spsc(4096);
+            const double spscRate = transfers_per_second(1, 1,
+                [&](u64 v) { return spsc.try_push(v); },
+                [&](u64& v) -> u64 { return spsc.try_pop(v) ? 1 : 0; });
+
+            // 消费端每次最多取 64 个
+            spsc_queue<u64> bulk(4096);
+            u64 drained[64];
+            const double bulkRate = transfers_per_second(1, 1,
+                [&](u64 v) { return bulk.try_push(v); },
+                [&](u64&) -> u64 { return bulk.try_pop_bulk(drained, 64); });
+
+            fmt::println("{:>6} | {:>10.1f} | {:>10.1f} | {:>10.1f} | {:>12.1f}", "1P1C", lockedRate, ringRate,
+                spscRate, bulkRate);
+        } else {
+            fmt::println("{:>6} | {:>10.1f} | {:>10.1f} | {:>10} | {:>12}", fmt::format("{}P{}C", producers, consumers),
+                lockedRate, ringRate, "-", "-");
+        }
+    }
+    fmt::println("");
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
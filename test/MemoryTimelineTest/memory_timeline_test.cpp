@@ -0,0 +1,305 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../../src/memory/memory.ixx"
+#include "../../src/util/shine_define.h"
+#include "fmt/format.h"
+
+using shine::co::FrameMemorySample;
+using shine::co::FrameTagSample;
+using shine::co::Memory;
+using shine::co::MemoryScope;
+using shine::co::MemoryTag;
+using shine::co::MemoryTimeline;
+
+namespace {
+
+// ============================================================================
+// 正确性
+// ============================================================================
+
+FrameMemorySample last_sample() {
+    std::vector<FrameMemorySample> samples;
+    MemoryTimeline::CopyRecent(samples, 1);
+    return samples.empty() ? FrameMemorySample{} : samples.back();
+}
+
+const FrameTagSample& tag_of(const FrameMemorySample& sample, MemoryTag tag) {
+    return sample.tags[(size_t)tag];
+}
+
+// 远低于 100 次 / 16KB 的批量刷新阈值，样本也必须精确
+int test_exact_counts() {
+    MemoryTimeline::SampleFrame();
+    const int64_t start = tag_of(last_sample(), MemoryTag::AI).bytes_current;
+
+    void* blocks[37];
+    {
+        MemoryScope scope(MemoryTag::AI);
+        for (void*& p : blocks) p = Memory::Alloc(100);
+    }
+    for (int i = 0; i < 10; ++i) Memory::Free(blocks[i]);
+    MemoryTimeline::SampleFrame();
+
+    const FrameTagSample ai = tag_of(last_sample(), MemoryTag::AI);
+    int failures = 0;
+    if (ai.allocs != 37 || ai.frees != 10 || ai.bytes_allocated != 3700 || ai.bytes_current != start + 2700) {
+        ++failures;
+        fmt::println("  FAIL: allocs {} frees {} allocated {} current {} (start {})", ai.allocs, ai.frees,
+            ai.bytes_allocated, ai.bytes_current, start);
+    }
+
+    for (int i = 10; i < 37; ++i) Memory::Free(blocks[i]);
+    MemoryTimeline::SampleFrame();
+    const FrameTagSample after = tag_of(last_sample(), MemoryTag::AI);
+    if (after.allocs != 0 || after.frees != 27 || after.bytes_current != start) {
+        ++failures;
+        fmt::println("  FAIL: second frame frees {} current {}", after.frees, after.bytes_current);
+    }
+    return failures;
+}
+
+// 工作线程分配几次后阻塞，不再触发任何刷新；帧边界采样仍应包含这些分配
+int test_idle_thread() {
+    int failures = 0;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool allocated = false;
+    bool release = false;
+    void* blocks[5] = {};
+
+    MemoryTimeline::SampleFrame();
+    const int64_t start = tag_of(last_sample(), MemoryTag::Physics).bytes_current;
+
+    std::thread worker([&] {
+        {
+            MemoryScope scope(MemoryTag::Physics);
+            for (void*& p : blocks) p = Memory::Alloc(64);
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        allocated = true;
+        cv.notify_all();
+        cv.wait(lock, [&] { return release; });
+        for (void* p : blocks) Memory::Free(p);
+    });
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return allocated; });
+    }
+    MemoryTimeline::SampleFrame();
+    const FrameTagSample live = tag_of(last_sample(), MemoryTag::Physics);
+    if (live.allocs != 5 || live.bytes_current != start + 5 * 64) {
+        ++failures;
+        fmt::println("  FAIL: idle worker allocs {} current {} (start {})", live.allocs, live.bytes_current, start);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    cv.notify_all();
+    worker.join();
+
+    // 线程退出后其累计值并入全局，不应出现跳变
+    MemoryTimeline::SampleFrame();
+    const FrameTagSample exited = tag_of(last_sample(), MemoryTag::Physics);
+    if (exited.frees != 5 || exited.bytes_current != start) {
+        ++failures;
+        fmt::println("  FAIL: after exit frees {} current {}", exited.frees, exited.bytes_current);
+    }
+    return failures;
+}
+
+// 帧内分配后又释放：当前值回落，峰值上界保留突增
+int test_peak_bound() {
+    MemoryTimeline::SampleFrame();
+    const int64_t start = tag_of(last_sample(), MemoryTag::Render).bytes_current;
+    {
+        MemoryScope scope(MemoryTag::Render);
+        Memory::Free(Memory::Alloc(1 << 20));
+    }
+    MemoryTimeline::SampleFrame();
+    const FrameTagSample render = tag_of(last_sample(), MemoryTag::Render);
+    if (render.bytes_current != start || render.bytes_peak < start + (1 << 20)) {
+        fmt::println("  FAIL: current {} peak {} (start {})", render.bytes_current, render.bytes_peak, start);
+        return 1;
+    }
+    return 0;
+}
+
+int test_ring_wrap() {
+    int failures = 0;
+    for (size_t i = 0; i < MemoryTimeline::kCapacity + 10; ++i) {
+        shine::co::g_frameContext.frame_index.fetch_add(1, std::memory_order_relaxed);
+        MemoryTimeline::SampleFrame();
+    }
+    const uint64_t lastFrame = shine::co::g_frameContext.frame_index.load(std::memory_order_relaxed);
+
+    std::vector<FrameMemorySample> samples;
+    if (MemoryTimeline::CopyRecent(samples, size_t(-1)) != MemoryTimeline::kCapacity || samples.size() != MemoryTimeline::kCapacity) {
+        ++failures;
+        fmt::println("  FAIL: full copy returned {} samples", samples.size());
+    }
+    for (size_t i = 0; i < samples.size(); ++i) {
+        if (samples[i].frame != lastFrame - (samples.size() - 1 - i)) {
+            ++failures;
+            fmt::println("  FAIL: sample {} is frame {}", i, samples[i].frame);
+            break;
+        }
+    }
+
+    MemoryTimeline::CopyRecent(samples, 5);
+    if (samples.size() != 5 || samples.back().frame != lastFrame || samples.front().frame != lastFrame - 4) {
+        ++failures;
+        fmt::println("  FAIL: recent copy has {} samples", samples.size());
+    }
+    return failures;
+}
+
+// 多线程分配释放的同时主线程持续采样，所有帧的计数之和等于总操作数
+int test_concurrent() {
+    constexpr u32 kThreads = 4;
+    constexpr u32 kPerThread = 50000;
+    MemoryTimeline::SampleFrame();
+
+    std::atomic<u32> running{kThreads};
+    u64 allocs = 0;
+    u64 frees = 0;
+    std::vector<std::thread> threads;
+    for (u32 t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            MemoryScope scope(MemoryTag::Script);
+            void* live[8] = {};
+            for (u32 i = 0; i < kPerThread; ++i) {
+                void*& slot = live[i & 7];
+                if (slot) Memory::Free(slot);
+                slot = Memory::Alloc(24);
+            }
+            for (void* p : live) Memory::Free(p);
+            running.fetch_sub(1);
+        });
+    }
+
+    std::vector<FrameMemorySample> samples;
+    auto collect = [&] {
+        MemoryTimeline::SampleFrame();
+        const FrameTagSample script = tag_of(last_sample(), MemoryTag::Script);
+        allocs += script.allocs;
+        frees += script.frees;
+    };
+    while (running.load() != 0) {
+        collect();
+        std::this_thread::yield();
+    }
+    for (auto& thread : threads) thread.join();
+    collect();
+
+    if (allocs != kThreads * kPerThread || frees != kThreads * kPerThread) {
+        fmt::println("  FAIL: summed allocs {} frees {}", allocs, frees);
+        return 1;
+    }
+    return 0;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试 ===\n");
+    int failures = 0;
+    const std::pair<const char*, int (*)()> cases[] = {
+        { "帧边界精确计数", test_exact_counts },
+        { "空闲线程 / 线程退出", test_idle_thread },
+        { "帧内峰值上界", test_peak_bound },
+        { "环形缓冲回绕", test_ring_wrap },
+        { "并发分配时采样", test_concurrent },
+    };
+    for (const auto& [name, fn] : cases) {
+        const int caseFailures = fn();
+        fmt::println("{}: {}", name, caseFailures == 0 ? "PASS" : "FAIL");
+        failures += caseFailures;
+    }
+
+    fmt::println("");
+    return failures;
+}
+
+// ============================================================================
+// 性能：Alloc + Free 一对的开销，以及存在若干线程时一次采样的耗时
+// ============================================================================
+
+constexpr u32 kBenchOps = 2000000;
+
+double ns_per_pair() {
+    double best = 1e30;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        void* live[64] = {};
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < kBenchOps; ++i) {
+            void*& slot = live[i & 63];
+            Memory::Free(slot);
+            slot = Memory::Alloc(16 + (i & 7) * 24);
+        }
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        for (void* p : live) Memory::Free(p);
+    }
+    return best * 1e9 / kBenchOps;
+}
+
+double us_per_sample(u32 threads) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    std::atomic<u32> ready{0};
+    std::vector<std::thread> workers;
+    for (u32 t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            Memory::Free(Memory::Alloc(32));  // 注册线程
+            ready.fetch_add(1);
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return done; });
+        });
+    }
+    while (ready.load() != threads) std::this_thread::yield();
+
+    constexpr u32 kSamples = 2000;
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < kSamples; ++i) MemoryTimeline::SampleFrame();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    cv.notify_all();
+    for (auto& worker : workers) worker.join();
+    return seconds * 1e6 / kSamples;
+}
+
+void benchmark() {
+    fmt::println("=== 性能测试 ===\n");
+    fmt::println("Alloc + Free: {:.1f} ns/对（{} 次）", ns_per_pair(), kBenchOps);
+    fmt::println("{:>8} | {:>12}", "线程数", "采样 us/帧");
+    for (u32 threads : { 0u, 16u, 64u }) {
+        fmt::println("{:>8} | {:>12.2f}", threads + 1, us_per_sample(threads));
+    }
+    fmt::println("");
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <source_location>
+#include <thread>
+#include <vector>
+
+#include "../../src/memory/memory.ixx"
+#include "../../src/util/shine_define.h"
+#include "fmt/format.h"
+
+using shine::co::CallSiteSnapshot;
+using shine::co::CallSiteStats;
+using shine::co::Memory;
+using shine::co::MemoryTracker;
+
+namespace {
+
+// ============================================================================
+// 正确性
+// ============================================================================
+
+// 固定的两个调用点，按行号在快照里查找
+const std::source_location kSiteA = std::source_location::current();
+const std::source_location kSiteB = std::source_location::current();
+
+void* alloc_at(const std::source_location& site, size_t size, size_t align = 16) {
+    return Memory::Alloc(size, align, site);
+}
+
+CallSiteStats find_site(const std::vector<CallSiteStats>& sites, const std::source_location& loc) {
+    for (const auto& site : sites) {
+        if (site.file && site.line == loc.line() && std::string_view(site.file) == loc.file_name()) return site;
+    }
+    return {};
+}
+
+CallSiteStats find_site(const CallSiteSnapshot& snapshot, const std::source_location& loc) {
+    return find_site(snapshot.sites, loc);
+}
+
+int test_disabled() {
+    MemoryTracker::SetEnabled(false);
+    const auto before = find_site(MemoryTracker::Snapshot(), kSiteA);
+    void* p = alloc_at(kSiteA, 100);
+    Memory::Free(p);
+    const auto after = find_site(MemoryTracker::Snapshot(), kSiteA);
+    if (after.alloc_count != before.alloc_count) {
+        fmt::println("  FAIL: disabled tracker counted {} allocations", after.alloc_count - before.alloc_count);
+        return 1;
+    }
+    return 0;
+}
+
+int test_counts_and_toggle() {
+    int failures = 0;
+    MemoryTracker::SetEnabled(true);
+    const CallSiteSnapshot start = MemoryTracker::Snapshot();
+
+    std::vector<void*> blocks;
+    blocks.reserve(300);
+    for (u32 i = 0; i < 200; ++i) blocks.push_back(alloc_at(kSiteA, 64, 8 << (i % 5)));
+    for (u32 i = 0; i < 100; ++i) blocks.push_back(alloc_at(kSiteB, 1000));
+
+    // 对齐不受额外头部影响
+    for (u32 i = 0; i < 200; ++i) {
+        if ((reinterpret_cast<uintptr_t>(blocks[i]) & ((8u << (i % 5)) - 1)) != 0) {
+            ++failures;
+            fmt::println("  FAIL: tracked block {} misaligned", i);
+            break;
+        }
+    }
+
+    const auto a = find_site(MemoryTracker::Snapshot(), kSiteA);
+    if (a.alloc_count - find_site(start, kSiteA).alloc_count != 200 || a.live_bytes - find_site(start, kSiteA).live_bytes != 200 * 64) {
+        ++failures;
+        fmt::println("  FAIL: site A allocs {} live {}", a.alloc_count, a.live_bytes);
+    }
+
+    // 在关闭后释放，仍然按调用点扣减
+    MemoryTracker::SetEnabled(false);
+    for (void* p : blocks) Memory::Free(p);
+    // 关闭时分配、打开后释放，不能出现负数
+    void* untracked = alloc_at(kSiteB, 50);
+    MemoryTracker::SetEnabled(true);
+    Memory::Free(untracked);
+
+    const auto diff = MemoryTracker::Diff(start, MemoryTracker::Snapshot());
+    const auto da = find_site(diff, kSiteA);
+    const auto db = find_site(diff, kSiteB);
+    if (da.live_count != 0 || db.live_count != 0 || db.alloc_count != 100 || db.alloc_bytes != 100000) {
+        ++failures;
+        fmt::println("  FAIL: diff A live {} / B live {} allocs {} bytes {}", da.live_count, db.live_count,
+            db.alloc_count, db.alloc_bytes);
+    }
+    return failures;
+}
+
+int test_top_this_frame() {
+    MemoryTracker::SetEnabled(true);
+    MemoryTracker::EndFrame();
+
+    std::vector<void*> blocks;
+    blocks.reserve(110);
+    for (u32 i = 0; i < 10; ++i) blocks.push_back(alloc_at(kSiteA, 16));
+    for (u32 i = 0; i < 100; ++i) blocks.push_back(alloc_at(kSiteB, 4096));
+    for (void* p : blocks) Memory::Free(p);
+
+    MemoryTracker::EndFrame();
+    const auto top = MemoryTracker::TopThisFrame(2);
+    if (top.size() < 2 || top[0].line != kSiteB.line() || top[0].alloc_bytes != 100 * 4096 || top[0].live_count != 0) {
+        fmt::println("  FAIL: top site {}:{} with {} bytes", top.empty() ? "-" : top[0].file,
+            top.empty() ? 0u : top[0].line, top.empty() ? 0ull : (unsigned long long)top[0].alloc_bytes);
+        return 1;
+    }
+    return 0;
+}
+
+int test_concurrent() {
+    MemoryTracker::SetEnabled(true);
+    const auto before = find_site(MemoryTracker::Snapshot(), kSiteA);
+    constexpr u32 kThreads = 8;
+    constexpr u32 kPerThread = 20000;
+    std::vector<std::thread> threads;
+    for (u32 t = 0; t < kThreads; ++t) {
+        threads.emplace_back([] {
+            void* live[16] = {};
+            for (u32 i = 0; i < kPerThread; ++i) {
+                void*& slot = live[i % 16];
+                if (slot) Memory::Free(slot);
+                slot = alloc_at(kSiteA, 32);
+            }
+            for (void* p : live) Memory::Free(p);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    const auto after = find_site(MemoryTracker::Snapshot(), kSiteA);
+    if (after.alloc_count - before.alloc_count != kThreads * kPerThread || after.live_count != before.live_count) {
+        fmt::println("  FAIL: concurrent allocs {} live {} -> {}", after.alloc_count - before.alloc_count,
+            before.live_count, after.live_count);
+        return 1;
+    }
+    return 0;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试 ===\n");
+    int failures = 0;
+    const std::pair<const char*, int (*)()> cases[] = {
+        { "关闭时不统计", test_disabled },
+        { "调用点计数 / 中途开关 / 差分", test_counts_and_toggle },
+        { "本帧分配排行", test_top_this_frame },
+        { "多线程分片计数", test_concurrent },
+    };
+    for (const auto& [name, fn] : cases) {
+        const int caseFailures = fn();
+        fmt::println("{}: {}", name, caseFailures == 0 ? "PASS" : "FAIL");
+        failures += caseFailures;
+    }
+
+    // 泄漏报告：故意留下一块
+    alloc_at(kSiteB, 123);
+    MemoryTracker::DumpLeaks();
+
+    fmt::println("");
+    return failures;
+}
+
+// ============================================================================
+// 性能：Memory::Alloc + Free 一对的开销，单位 ns
+// ============================================================================
+
+constexpr u32 kBenchOps = 2000000;
+
+double ns_per_pair(u32 threads) {
+    double best = 1e30;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (u32 t = 0; t < threads; ++t) {
+            workers.emplace_back([threads] {
+                void* live[64] = {};
+                for (u32 i = 0; i < kBenchOps / threads; ++i) {
+                    void*& slot = live[i & 63];
+                    Memory::Free(slot);
+                    slot = Memory::Alloc(16 + (i & 7) * 24);
+                }
+                for (void* p : live) Memory::Free(p);
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best * 1e9 / kBenchOps;
+}
+
+void benchmark() {
+    fmt::println("=== 性能测试（{} 次分配 + 释放，单位：ns/对） ===\n", kBenchOps);
+    fmt::println("{:>6} | {:>8} | {:>8}", "线程", "未跟踪", "跟踪");
+    for (u32 threads : { 1u, 4u }) {
+        MemoryTracker::SetEnabled(false);
+        const double off = ns_per_pair(threads);
+        MemoryTracker::SetEnabled(true);
+        const double on = ns_per_pair(threads);
+        fmt::println("{:>6} | {:>8.1f} | {:>8.1f}", threads, off, on);
+    }
+    MemoryTracker::SetEnabled(false);
+    fmt::println("");
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
@@ -0,0 +1,381 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../../src/image/mipmap.h"
+#include "../../src/image/mipmap_dsp.h"
+#include "../SimplePerfTest/benchmark_framework.h"
+#include "fmt/format.h"
+
+using shine::image::mip::MipFilter;
+using shine::image::mip::MipOptions;
+using shine::image::mip_dsp::DspBackend;
+using shine::image::mip_dsp::DspKernels;
+namespace mip = shine::image::mip;
+namespace mip_dsp = shine::image::mip_dsp;
+
+namespace {
+
+constexpr DspBackend kSimdBackends[] = {
+    DspBackend::SSE2,
+};
+
+constexpr MipFilter kFilters[] = { MipFilter::Box, MipFilter::Kaiser, MipFilter::Lanczos };
+
+std::vector<uint8_t> make_image(uint32_t width, uint32_t height, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* p = rgba.data() + (static_cast<size_t>(y) * width + x) * 4;
+            const int edge = ((x / 7 + y / 5) % 2) ? 80 : 0;
+            p[0] = static_cast<uint8_t>(std::min<uint32_t>(255, x * 170 / width + edge + rng() % 8));
+            p[1] = static_cast<uint8_t>(std::min<uint32_t>(255, y * 200 / height + rng() % 8));
+            p[2] = static_cast<uint8_t>(rng());
+            p[3] = static_cast<uint8_t>(rng() % 4 == 0 ? 0 : 255 - x * 128 / width);
+        }
+    }
+    return rgba;
+}
+
+// ============================================================================
+// 内核：SIMD 与标量对比
+// ============================================================================
+
+bool nearly_equal(float a, float b) {
+    return std::abs(a - b) <= 1e-5f * std::max(1.0f, std::abs(a));
+}
+
+int compare_kernels(DspBackend backend, std::mt19937& rng) {
+    const DspKernels& expected = mip_dsp::kernels(DspBackend::Scalar);
+    const DspKernels& actual = mip_dsp::kernels(backend);
+    std::uniform_real_distribution<float> value(-0.5f, 1.5f);
+
+    int failures = 0;
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        const uint32_t taps = 1 + iteration % 14;
+        const uint32_t srcWidth = 20 + iteration % 37;
+        const uint32_t dstWidth = 1 + iteration % 19;
+
+        std::vector<float> src(srcWidth * 4), weights(dstWidth * taps);
+        std::vector<uint32_t> starts(dstWidth);
+        for (float& v : src) v = value(rng);
+        for (float& v : weights) v = value(rng);
+        for (uint32_t& s : starts) s = rng() % (srcWidth - std::min(taps, srcWidth) + 1);
+
+        std::vector<float> lhs(dstWidth * 4), rhs(dstWidth * 4);
+        expected.resampleRow(src.data(), lhs.data(), dstWidth, starts.data(), weights.data(), std::min(taps, srcWidth));
+        actual.resampleRow(src.data(), rhs.data(), dstWidth, starts.data(), weights.data(), std::min(taps, srcWidth));
+        if (!std::equal(lhs.begin(), lhs.end(), rhs.begin(), nearly_equal)) {
+            ++failures;
+            fmt::println("  FAIL: {} resampleRow taps={} dstWidth={}", mip_dsp::backendName(backend), taps, dstWidth);
+        }
+
+        // 行长度覆盖 8 的倍数与余下的单像素
+        std::vector<std::vector<float>> rows(taps, std::vector<float>(dstWidth * 4));
+        std::vector<const float*> rowPointers;
+        for (auto& row : rows) {
+            for (float& v : row) v = value(rng);
+            rowPointers.push_back(row.data());
+        }
+        expected.blendRows(rowPointers.data(), weights.data(), taps, lhs.data(), lhs.size());
+        actual.blendRows(rowPointers.data(), weights.data(), taps, rhs.data(), rhs.size());
+        if (!std::equal(lhs.begin(), lhs.end(), rhs.begin(), nearly_equal)) {
+            ++failures;
+            fmt::println("  FAIL: {} blendRows taps={} count={}", mip_dsp::backendName(backend), taps, lhs.size());
+        }
+    }
+    return failures;
+}
+
+// ============================================================================
+// Mip 链
+// ============================================================================
+
+int test_level_layout() {
+    int failures = 0;
+    if (mip::mipLevelCount(131, 77) != 8 || mip::mipLevelCount(1, 1) != 1 || mip::mipLevelCount(1024, 4) != 11) {
+        ++failures;
+        fmt::println("  FAIL: mipLevelCount");
+    }
+
+    const std::vector<uint8_t> image = make_image(131, 77, 1);
+    const auto chain = mip::buildMipChain(image.data(), 131, 77);
+    constexpr uint32_t expected[][2] = { { 65, 38 }, { 32, 19 }, { 16, 9 }, { 8, 4 }, { 4, 2 }, { 2, 1 }, { 1, 1 } };
+    if (!chain.has_value() || chain->levels.size() != std::size(expected)) {
+        ++failures;
+        fmt::println("  FAIL: 131x77 级数");
+        return failures;
+    }
+    size_t offset = 0;
+    for (size_t i = 0; i < std::size(expected); ++i) {
+        const auto& level = chain->levels[i];
+        if (level.width != expected[i][0] || level.height != expected[i][1] || level.offset != offset ||
+            level.size != static_cast<size_t>(level.width) * level.height * 4) {
+            ++failures;
+            fmt::println("  FAIL: 第 {} 级布局 {}x{}", i + 1, level.width, level.height);
+        }
+        offset += level.size;
+    }
+    if (chain->data.size() != offset) {
+        ++failures;
+        fmt::println("  FAIL: mip 数据大小");
+    }
+
+    MipOptions limited;
+    limited.maxLevels = 3;
+    const auto shortChain = mip::buildMipChain(image.data(), 131, 77, limited);
+    const uint8_t single[4] = { 1, 2, 3, 4 };
+    if (!shortChain.has_value() || shortChain->levels.size() != 2 ||
+        !mip::buildMipChain(single, 1, 1).value().empty()) {
+        ++failures;
+        fmt::println("  FAIL: maxLevels / 1x1");
+    }
+    return failures;
+}
+
+/**
+ * @brief 纯色图像的每一级都应保持原色（sRGB 往返与预乘还原无漂移）
+ */
+int test_solid_color() {
+    int failures = 0;
+    std::mt19937 rng(3);
+    for (int iteration = 0; iteration < 30; ++iteration) {
+        uint8_t color[4];
+        for (uint8_t& c : color) c = static_cast<uint8_t>(rng());
+        color[3] = static_cast<uint8_t>(std::max<uint8_t>(color[3], 1));
+        std::vector<uint8_t> image(45 * 30 * 4);
+        for (size_t i = 0; i < image.size(); ++i) image[i] = color[i % 4];
+
+        for (MipFilter filter : kFilters) {
+            MipOptions options;
+            options.filter = filter;
+            const auto chain = mip::buildMipChain(image.data(), 45, 30, options);
+            const bool ok = chain.has_value() && std::all_of(chain->data.begin(), chain->data.end(), [&, i = size_t(0)](uint8_t v) mutable {
+                return std::abs(v - color[i++ % 4]) <= 1;
+            });
+            if (!ok) {
+                ++failures;
+                fmt::println("  FAIL: {} 纯色 ({}, {}, {}, {})", mip::filterName(filter), color[0], color[1], color[2], color[3]);
+            }
+        }
+    }
+    return failures;
+}
+
+/**
+ * @brief 黑白棋盘格：线性空间平均为 0.5，sRGB 编码后为 188；直接平均编码值为 128
+ */
+int test_gamma() {
+    int failures = 0;
+    std::vector<uint8_t> image(2 * 2 * 4, 255);
+    for (int i : { 0, 3 }) {
+        image[i * 4 + 0] = image[i * 4 + 1] = image[i * 4 + 2] = 0;
+    }
+
+    MipOptions options;
+    options.filter = MipFilter::Box;
+    const auto srgb = mip::buildMipChain(image.data(), 2, 2, options);
+    options.srgb = false;
+    const auto linear = mip::buildMipChain(image.data(), 2, 2, options);
+    if (srgb->data[0] != 188 || srgb->data[3] != 255 || linear->data[0] != 128) {
+        ++failures;
+        fmt::println("  FAIL: 棋盘格 sRGB={} 线性={}", srgb->data[0], linear->data[0]);
+    }
+    return failures;
+}
+
+/**
+ * @brief 一个不透明红色像素与三个全透明绿色像素：预乘滤波后颜色仍为纯红
+ */
+int test_premultiplied_alpha() {
+    int failures = 0;
+    const std::vector<uint8_t> image = {
+        255, 0, 0, 255,   0, 255, 0, 0,
+        0, 255, 0, 0,     0, 255, 0, 0,
+    };
+
+    MipOptions options;
+    options.filter = MipFilter::Box;
+    const auto premultiplied = mip::buildMipChain(image.data(), 2, 2, options);
+    const std::vector<uint8_t> expected = { 255, 0, 0, 64 };
+    if (premultiplied->data != expected) {
+        ++failures;
+        fmt::println("  FAIL: 预乘 Alpha -> ({}, {}, {}, {})", premultiplied->data[0], premultiplied->data[1],
+            premultiplied->data[2], premultiplied->data[3]);
+    }
+
+    options.premultiplyAlpha = false;
+    const auto straight = mip::buildMipChain(image.data(), 2, 2, options);
+    if (straight->data[1] == 0) {
+        ++failures;
+        fmt::println("  FAIL: 直通 Alpha 滤波应混入透明像素的颜色");
+    }
+    return failures;
+}
+
+/**
+ * @brief 线性空间的盒式滤波在偶数尺寸下等于 2x2 平均
+ */
+int test_box_reference() {
+    int failures = 0;
+    constexpr uint32_t width = 64;
+    constexpr uint32_t height = 48;
+    const std::vector<uint8_t> image = make_image(width, height, 7);
+    MipOptions options;
+    options.filter = MipFilter::Box;
+    options.srgb = false;
+    options.premultiplyAlpha = false;
+    options.maxLevels = 2;
+    const auto chain = mip::buildMipChain(image.data(), width, height, options);
+
+    int maxError = 0;
+    for (uint32_t y = 0; y < height / 2; ++y) {
+        for (uint32_t x = 0; x < width / 2; ++x) {
+            for (int c = 0; c < 4; ++c) {
+                int sum = 0;
+                for (uint32_t dy = 0; dy < 2; ++dy) {
+                    for (uint32_t dx = 0; dx < 2; ++dx) {
+                        sum += image[((y * 2 + dy) * width + x * 2 + dx) * 4 + c];
+                    }
+                }
+                const int actual = chain->data[(y * (width / 2) + x) * 4 + c];
+                maxError = std::max(maxError, std::abs(actual * 4 - sum));
+            }
+        }
+    }
+    // 2x2 平均的四舍五入误差不超过 0.5，即 4 倍后不超过 2
+    if (maxError > 2) {
+        ++failures;
+        fmt::println("  FAIL: 盒式滤波与 2x2 平均相差 {}/4", maxError);
+    }
+    return failures;
+}
+
+int test_parallel() {
+    int failures = 0;
+    constexpr uint32_t width = 700;
+    constexpr uint32_t height = 333;
+    const std::vector<uint8_t> image = make_image(width, height, 9);
+    for (MipFilter filter : kFilters) {
+        MipOptions serial;
+        serial.filter = filter;
+        serial.parallel = false;
+        MipOptions parallel;
+        parallel.filter = filter;
+        parallel.parallelMinPixels = 0;
+        const auto lhs = mip::buildMipChain(image.data(), width, height, serial);
+        const auto rhs = mip::buildMipChain(image.data(), width, height, parallel);
+        if (!lhs.has_value() || !rhs.has_value() || lhs->data != rhs->data) {
+            ++failures;
+            fmt::println("  FAIL: {} 并行结果与串行不同", mip::filterName(filter));
+        }
+    }
+
+    if (mip::buildMipChain(image.data(), 0, height).has_value() ||
+        mip::buildMipChain(image.data(), width, height, width, MipOptions{}).has_value()) {
+        ++failures;
+        fmt::println("  FAIL: 无效参数未报错");
+    }
+    return failures;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试 ===\n");
+    fmt::println("当前内核: {}", mip_dsp::backendName(mip_dsp::activeBackend()));
+
+    int failures = 0;
+    std::mt19937 rng(20240901);
+    for (DspBackend backend : kSimdBackends) {
+        if (!mip_dsp::isBackendSupported(backend)) {
+            fmt::println("{}: SKIP（当前 CPU 不支持）", mip_dsp::backendName(backend));
+            continue;
+        }
+        const int backendFailures = compare_kernels(backend, rng);
+        fmt::println("{}: {}", mip_dsp::backendName(backend), backendFailures == 0 ? "PASS" : "FAIL");
+        failures += backendFailures;
+    }
+
+    const std::pair<const char*, int (*)()> cases[] = {
+        { "级数与布局", test_level_layout },
+        { "纯色保持", test_solid_color },
+        { "sRGB 线性平均", test_gamma },
+        { "预乘 Alpha", test_premultiplied_alpha },
+        { "盒式滤波", test_box_reference },
+        { "并行生成", test_parallel },
+    };
+    for (const auto& [name, fn] : cases) {
+        const int caseFailures = fn();
+        fmt::println("{}: {}", name, caseFailures == 0 ? "PASS" : "FAIL");
+        failures += caseFailures;
+    }
+
+    fmt::println("");
+    return failures;
+}
+
+void benchmark() {
+    constexpr uint32_t width = 2048;
+    constexpr uint32_t height = 2048;
+    fmt::println("=== 性能测试（{}x{}） ===\n", width, height);
+    const std::vector<uint8_t> image = make_image(width, height, 3);
+
+    // 内核：12 抽头（Kaiser / Lanczos 2 倍缩小）
+    constexpr uint32_t taps = 12;
+    std::vector<float> src((width + taps) * 4, 0.5f), dst(width * 4), weights(width * taps, 1.0f / taps);
+    std::vector<uint32_t> starts(width);
+    for (uint32_t x = 0; x < width; ++x) starts[x] = x;
+    std::vector<const float*> rows(taps, src.data());
+    for (DspBackend backend : { DspBackend::Scalar, DspBackend::SSE2 }) {
+        if (!mip_dsp::isBackendSupported(backend)) {
+            continue;
+        }
+        const DspKernels& k = mip_dsp::kernels(backend);
+        const auto horizontal = shine::benchmark::run_benchmark(
+            fmt::format("resampleRow x{} / {}", taps, mip_dsp::backendName(backend)),
+            [&] {
+                for (int i = 0; i < 256; ++i) k.resampleRow(src.data(), dst.data(), width, starts.data(), weights.data(), taps);
+            },
+            10, 2);
+        fmt::println("   吞吐量: {:.1f} 百万像素/秒\n", 256.0 * width * 1e3 / horizontal.median_time_ns);
+        const auto vertical = shine::benchmark::run_benchmark(
+            fmt::format("blendRows x{} / {}", taps, mip_dsp::backendName(backend)),
+            [&] {
+                for (int i = 0; i < 256; ++i) k.blendRows(rows.data(), weights.data(), taps, dst.data(), dst.size());
+            },
+            10, 2);
+        fmt::println("   吞吐量: {:.1f} 百万像素/秒\n", 256.0 * width * 1e3 / vertical.median_time_ns);
+    }
+
+    for (MipFilter filter : kFilters) {
+        for (bool parallel : { false, true }) {
+            MipOptions options;
+            options.filter = filter;
+            options.parallel = parallel;
+            const auto result = shine::benchmark::run_benchmark(
+                fmt::format("{} / {}", mip::filterName(filter), parallel ? "并行" : "串行"),
+                [&] {
+                    (void)mip::buildMipChain(image.data(), width, height, options);
+                },
+                3, 1);
+            fmt::println("   吞吐量: {:.1f} 百万像素/秒\n",
+                static_cast<double>(width) * height * 1e3 / result.median_time_ns);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
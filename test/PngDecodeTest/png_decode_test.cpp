@@ -0,0 +1,483 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <expected>
+#include <new>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "../../src/image/png.h"
+#include "../../src/util/encoding/deflate.h"
+#include "../../src/util/thread/thread_pool.h"
+#include "fmt/format.h"
+
+using shine::image::PngColorType;
+using shine::util::DeflateLevel;
+
+// ============================================================================
+// 堆内存统计：替换全局 operator new/delete，记录当前存活字节数与峰值
+// ============================================================================
+
+namespace {
+
+constexpr size_t kAllocHeader = alignof(std::max_align_t);
+
+std::atomic<size_t> g_liveBytes{ 0 };
+std::atomic<size_t> g_peakBytes{ 0 };
+
+void reset_peak() {
+    g_peakBytes.store(g_liveBytes.load());
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    auto* block = static_cast<unsigned char*>(std::malloc(size + kAllocHeader));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    std::memcpy(block, &size, sizeof(size));
+
+    const size_t live = g_liveBytes.fetch_add(size) + size;
+    size_t peak = g_peakBytes.load();
+    while (live > peak && !g_peakBytes.compare_exchange_weak(peak, live)) {
+    }
+    return block + kAllocHeader;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) {
+        return;
+    }
+    auto* block = static_cast<unsigned char*>(ptr) - kAllocHeader;
+    size_t size = 0;
+    std::memcpy(&size, block, sizeof(size));
+    g_liveBytes.fetch_sub(size);
+    std::free(block);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace {
+
+// ============================================================================
+// 手工构造 PNG：编码器只支持 8 位非调色板，其余格式在这里直接拼块
+// ============================================================================
+
+constexpr uint32_t ADAM7_IX[7] = { 0, 4, 0, 2, 0, 1, 0 };
+constexpr uint32_t ADAM7_IY[7] = { 0, 0, 4, 0, 2, 0, 1 };
+constexpr uint32_t ADAM7_DX[7] = { 8, 8, 4, 4, 2, 2, 1 };
+constexpr uint32_t ADAM7_DY[7] = { 8, 8, 8, 4, 4, 2, 2 };
+
+struct Format {
+    const char* name;
+    uint32_t width;
+    uint32_t height;
+    PngColorType colorType;
+    uint8_t bitDepth;
+    uint8_t interlace;
+};
+
+size_t channel_count(PngColorType type) {
+    switch (type) {
+    case PngColorType::RGB: return 3;
+    case PngColorType::GERY_ALPHA: return 2;
+    case PngColorType::RGBA: return 4;
+    default: return 1;
+    }
+}
+
+size_t row_bytes(const Format& f, uint32_t width) {
+    return (static_cast<size_t>(width) * channel_count(f.colorType) * f.bitDepth + 7) / 8;
+}
+
+/**
+ * @brief 按扫描顺序列出每条扫描线的字节数（不含滤波器字节），Adam7 跳过空通道
+ */
+std::vector<size_t> scanline_layout(const Format& f) {
+    std::vector<size_t> rows;
+    if (f.interlace == 0) {
+        rows.assign(f.height, row_bytes(f, f.width));
+        return rows;
+    }
+    for (int pass = 0; pass < 7; ++pass) {
+        const uint32_t w = (f.width + ADAM7_DX[pass] - ADAM7_IX[pass] - 1) / ADAM7_DX[pass];
+        const uint32_t h = (f.height + ADAM7_DY[pass] - ADAM7_IY[pass] - 1) / ADAM7_DY[pass];
+        if (w != 0 && h != 0) {
+            rows.insert(rows.end(), h, row_bytes(f, w));
+        }
+    }
+    return rows;
+}
+
+/**
+ * @brief 生成滤波后的原始数据：每行随机滤波器类型 + 渐变加噪声的内容
+ */
+std::vector<uint8_t> make_filtered(const Format& f, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> raw;
+    const auto rows = scanline_layout(f);
+    for (size_t y = 0; y < rows.size(); ++y) {
+        raw.push_back(static_cast<uint8_t>(rng() % 5));
+        for (size_t x = 0; x < rows[y]; ++x) {
+            raw.push_back(static_cast<uint8_t>((rng() % 4 == 0) ? rng() : x + y));
+        }
+    }
+    return raw;
+}
+
+uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0xFFFFFFFFu) {
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= data[i];
+        for (int k = 0; k < 8; ++k) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return crc;
+}
+
+void append_be32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void append_chunk(std::vector<uint8_t>& out, const char* type, std::span<const uint8_t> data) {
+    append_be32(out, static_cast<uint32_t>(data.size()));
+    const size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    append_be32(out, crc32(out.data() + start, out.size() - start) ^ 0xFFFFFFFFu);
+}
+
+/**
+ * @brief 由滤波后的原始数据构造完整 PNG 文件（调色板图像附带 PLTE 与 tRNS，IDAT 拆成两块）
+ */
+std::vector<uint8_t> build_png(const Format& f, std::span<const uint8_t> filtered, DeflateLevel level) {
+    std::vector<uint8_t> out = { 137, 80, 78, 71, 13, 10, 26, 10 };
+
+    std::vector<uint8_t> ihdr;
+    append_be32(ihdr, f.width);
+    append_be32(ihdr, f.height);
+    ihdr.insert(ihdr.end(), { f.bitDepth, static_cast<uint8_t>(f.colorType), 0, 0, f.interlace });
+    append_chunk(out, "IHDR", ihdr);
+
+    if (f.colorType == PngColorType::PALETTE) {
+        const size_t entries = size_t{ 1 } << f.bitDepth;
+        std::vector<uint8_t> plte(entries * 3);
+        std::vector<uint8_t> trns(entries / 2);
+        for (size_t i = 0; i < entries; ++i) {
+            plte[i * 3 + 0] = static_cast<uint8_t>(i * 37);
+            plte[i * 3 + 1] = static_cast<uint8_t>(255 - i * 11);
+            plte[i * 3 + 2] = static_cast<uint8_t>(i * i);
+        }
+        for (size_t i = 0; i < trns.size(); ++i) {
+            trns[i] = static_cast<uint8_t>(i * 97);
+        }
+        append_chunk(out, "PLTE", plte);
+        if (!trns.empty()) {
+            append_chunk(out, "tRNS", trns);
+        }
+    }
+
+    const auto zlib = shine::util::zlibCompress(filtered, level);
+    const size_t half = zlib.size() / 2;
+    append_chunk(out, "IDAT", std::span<const uint8_t>(zlib).first(half));
+    append_chunk(out, "IDAT", std::span<const uint8_t>(zlib).subspan(half));
+    append_chunk(out, "IEND", {});
+    return out;
+}
+
+constexpr Format kFormats[] = {
+    { "RGBA8", 77, 41, PngColorType::RGBA, 8, 0 },
+    { "RGB8", 64, 33, PngColorType::RGB, 8, 0 },
+    { "灰度8", 31, 17, PngColorType::GERY, 8, 0 },
+    { "灰度Alpha8", 45, 20, PngColorType::GERY_ALPHA, 8, 0 },
+    { "RGBA16", 65, 33, PngColorType::RGBA, 16, 0 },
+    { "RGB16", 50, 21, PngColorType::RGB, 16, 0 },
+    { "灰度16", 29, 30, PngColorType::GERY, 16, 0 },
+    { "灰度Alpha16", 33, 9, PngColorType::GERY_ALPHA, 16, 0 },
+    { "调色板8", 70, 35, PngColorType::PALETTE, 8, 0 },
+    { "调色板4", 37, 29, PngColorType::PALETTE, 4, 0 },
+    { "调色板2", 39, 13, PngColorType::PALETTE, 2, 0 },
+    { "调色板1", 41, 11, PngColorType::PALETTE, 1, 0 },
+    { "灰度4", 37, 29, PngColorType::GERY, 4, 0 },
+    { "灰度2", 19, 23, PngColorType::GERY, 2, 0 },
+    { "灰度1", 43, 15, PngColorType::GERY, 1, 0 },
+    { "Adam7 RGBA8", 77, 41, PngColorType::RGBA, 8, 1 },
+    { "Adam7 RGB16", 50, 21, PngColorType::RGB, 16, 1 },
+    { "Adam7 调色板4", 37, 29, PngColorType::PALETTE, 4, 1 },
+    { "Adam7 灰度1", 43, 15, PngColorType::GERY, 1, 1 },
+    { "Adam7 1x1", 1, 1, PngColorType::RGBA, 8, 1 },
+    { "Adam7 3x5", 3, 5, PngColorType::GERY_ALPHA, 8, 1 },
+};
+
+/**
+ * @brief 串行完整解码作为参照
+ */
+std::vector<uint8_t> decode_reference(const std::vector<uint8_t>& file) {
+    shine::image::png decoder;
+    if (!decoder.loadFromMemory(file.data(), file.size()) || !decoder.decode().has_value()) {
+        return {};
+    }
+    return decoder.getImageData();
+}
+
+/**
+ * @brief 流式解码并逐行与参照比较（行号必须连续，行宽必须为 width * 4）
+ */
+bool stream_matches(const std::vector<uint8_t>& file, const std::vector<uint8_t>& expected, uint32_t width, uint32_t height) {
+    shine::image::png decoder;
+    if (!decoder.loadFromMemory(file.data(), file.size())) {
+        return false;
+    }
+
+    const size_t stride = static_cast<size_t>(width) * 4;
+    uint32_t nextRow = 0;
+    bool rowsMatch = true;
+    const auto result = decoder.decodeStreaming([&](uint32_t y, std::span<const uint8_t> row) {
+        rowsMatch = rowsMatch && y == nextRow && row.size() == stride &&
+            std::memcmp(row.data(), expected.data() + y * stride, stride) == 0;
+        ++nextRow;
+        return true;
+    });
+    return result.has_value() && rowsMatch && nextRow == height && decoder.getImageData().empty();
+}
+
+int test_streaming_matches_decode() {
+    int failures = 0;
+    for (const Format& f : kFormats) {
+        const auto filtered = make_filtered(f, f.width * 131 + f.height);
+        for (DeflateLevel level : { DeflateLevel::Store, DeflateLevel::Default }) {
+            const auto file = build_png(f, filtered, level);
+            const auto expected = decode_reference(file);
+            if (expected.size() != static_cast<size_t>(f.width) * f.height * 4 ||
+                !stream_matches(file, expected, f.width, f.height)) {
+                ++failures;
+                fmt::println("  FAIL: {} level={}", f.name, static_cast<int>(level));
+            }
+        }
+    }
+
+    fmt::println("流式解码与完整解码一致: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+/**
+ * @brief 流式解码期间的峰值堆内存只与行宽有关：
+ *        一条滤波扫描线 + 两条重建扫描线 + 一行 RGBA + 32KB 解压窗口（外加 Huffman 表）
+ */
+int test_streaming_bounded_memory() {
+    constexpr size_t kInflateOverhead = 32768 + 32768;
+    constexpr uint32_t kWidth = 1024;
+    constexpr uint32_t kHeights[] = { 64, 512 };
+
+    int failures = 0;
+    size_t peaks[2] = {};
+    size_t scanline = 0;
+    for (int i = 0; i < 2; ++i) {
+        const Format f{ "RGBA16", kWidth, kHeights[i], PngColorType::RGBA, 16, 0 };
+        const auto file = build_png(f, make_filtered(f, 7), DeflateLevel::Default);
+        scanline = row_bytes(f, f.width);
+
+        shine::image::png decoder;
+        if (!decoder.loadFromMemory(file.data(), file.size())) {
+            ++failures;
+            continue;
+        }
+
+        const size_t before = g_liveBytes.load();
+        reset_peak();
+        uint32_t rows = 0;
+        const auto result = decoder.decodeStreaming([&](uint32_t, std::span<const uint8_t>) {
+            ++rows;
+            return true;
+        });
+        peaks[i] = g_peakBytes.load() - before;
+
+        const size_t bound = (scanline + 1) + scanline * 2 + static_cast<size_t>(f.width) * 4 + kInflateOverhead;
+        const size_t fullImage = static_cast<size_t>(f.width) * f.height * 4;
+        fmt::println("  {}x{} RGBA16: 峰值 {} 字节（上限 {}，完整 RGBA 图像 {}）", f.width, f.height, peaks[i], bound, fullImage);
+        if (!result.has_value() || rows != f.height || peaks[i] > bound) {
+            ++failures;
+            fmt::println("  FAIL: 峰值超过两条扫描线的上限");
+        }
+    }
+
+    // 行数增加 8 倍，峰值只随各块 Huffman 表大小略有波动，增长不到一条扫描线
+    if (peaks[1] > peaks[0] + scanline) {
+        ++failures;
+        fmt::println("  FAIL: 峰值随图像高度增长 ({} -> {})", peaks[0], peaks[1]);
+    }
+
+    fmt::println("流式解码内存有界: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+int test_streaming_abort() {
+    const Format f{ "RGB8", 40, 30, PngColorType::RGB, 8, 0 };
+    const auto file = build_png(f, make_filtered(f, 3), DeflateLevel::Fast);
+
+    shine::image::png decoder;
+    bool ok = decoder.loadFromMemory(file.data(), file.size());
+    uint32_t rows = 0;
+    const auto result = decoder.decodeStreaming([&](uint32_t y, std::span<const uint8_t>) {
+        ++rows;
+        return y < 9;
+    });
+    ok = ok && !result.has_value() && rows == 10;
+
+    fmt::println("回调中止解码: {}", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief 完整解码；parallel 为 true 时不设像素下限，线程池有多个线程时总是走多线程路径
+ */
+std::expected<std::vector<uint8_t>, std::string> decode_with(const std::vector<uint8_t>& file, bool parallel) {
+    shine::image::png decoder;
+    decoder.setParallelDecode(parallel, 0);
+    if (!decoder.loadFromMemory(file.data(), file.size())) {
+        return std::unexpected("加载失败");
+    }
+    auto result = decoder.decode();
+    if (!result.has_value()) {
+        return std::unexpected(result.error());
+    }
+    return decoder.getImageData();
+}
+
+bool same_outcome(const std::vector<uint8_t>& file) {
+    const auto serial = decode_with(file, false);
+    const auto parallel = decode_with(file, true);
+    if (serial.has_value() != parallel.has_value()) {
+        fmt::println("  串行: {}，并行: {}", serial.has_value() ? "成功" : serial.error(),
+            parallel.has_value() ? "成功" : parallel.error());
+        return false;
+    }
+    if (!serial.has_value() && serial.error() != parallel.error()) {
+        fmt::println("  串行: {}\n  并行: {}", serial.error(), parallel.error());
+        return false;
+    }
+    return !serial.has_value() || *serial == *parallel;
+}
+
+int test_parallel_matches_serial() {
+    // 高度超过 16 行的图像才会被切成多个行带
+    constexpr Format kLarge[] = {
+        { "RGBA16 大图", 300, 200, PngColorType::RGBA, 16, 0 },
+        { "调色板2 大图", 257, 190, PngColorType::PALETTE, 2, 0 },
+        { "灰度Alpha8 大图", 128, 333, PngColorType::GERY_ALPHA, 8, 0 },
+        { "Adam7 灰度4 大图", 201, 150, PngColorType::GERY, 4, 1 },
+        { "Adam7 RGBA16 大图", 190, 97, PngColorType::RGBA, 16, 1 },
+        { "Adam7 调色板8 大图", 160, 161, PngColorType::PALETTE, 8, 1 },
+    };
+
+    int failures = 0;
+    const auto check = [&](const Format& f) {
+        const auto filtered = make_filtered(f, f.width * 17 + f.height);
+        const auto file = build_png(f, filtered, DeflateLevel::Default);
+        const auto serial = decode_with(file, false);
+        if (!serial.has_value() || !same_outcome(file)) {
+            ++failures;
+            fmt::println("  FAIL: {}", f.name);
+        }
+    };
+    for (const Format& f : kFormats) {
+        check(f);
+    }
+    for (const Format& f : kLarge) {
+        check(f);
+    }
+
+    fmt::println("多线程解码与串行解码一致: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+/**
+ * @brief 损坏输入在多线程路径上必须返回与串行路径相同的错误
+ */
+int test_parallel_errors() {
+    constexpr Format kPlain{ "RGB16", 90, 70, PngColorType::RGB, 16, 0 };
+    constexpr Format kLowDepth{ "调色板4", 91, 60, PngColorType::PALETTE, 4, 0 };
+    constexpr Format kInterlaced{ "Adam7 RGBA8", 90, 70, PngColorType::RGBA, 8, 1 };
+
+    struct Case {
+        const char* name;
+        Format format;
+        int kind;  ///< 0 截断 IDAT，1 行边界处缺数据，2 行中间缺数据，3 无效滤波器
+    };
+    constexpr Case cases[] = {
+        { "截断 IDAT", kPlain, 0 },
+        { "缺少整行", kPlain, 1 },
+        { "缺少半行", kPlain, 2 },
+        { "无效滤波器", kPlain, 3 },
+        { "低位深度缺少半行", kLowDepth, 2 },
+        { "低位深度无效滤波器", kLowDepth, 3 },
+        { "Adam7 截断 IDAT", kInterlaced, 0 },
+        { "Adam7 缺少整行", kInterlaced, 1 },
+        { "Adam7 缺少半行", kInterlaced, 2 },
+        { "Adam7 无效滤波器", kInterlaced, 3 },
+    };
+
+    int failures = 0;
+    for (const Case& c : cases) {
+        const Format& f = c.format;
+        auto filtered = make_filtered(f, 11);
+        const size_t lastRow = scanline_layout(f).back() + 1;
+        std::vector<uint8_t> file;
+        switch (c.kind) {
+        case 0:
+            file = build_png(f, filtered, DeflateLevel::Default);
+            file.resize(file.size() - 40);
+            break;
+        case 1:
+            filtered.resize(filtered.size() - lastRow * 3);
+            file = build_png(f, filtered, DeflateLevel::Default);
+            break;
+        case 2:
+            filtered.resize(filtered.size() - lastRow * 3 - lastRow / 2);
+            file = build_png(f, filtered, DeflateLevel::Default);
+            break;
+        default:
+            filtered[filtered.size() - lastRow * 5] = 7;
+            file = build_png(f, filtered, DeflateLevel::Default);
+            break;
+        }
+
+        const bool ok = same_outcome(file);
+        failures += ok ? 0 : 1;
+        fmt::println("  {}: {}", c.name, ok ? "PASS" : "FAIL");
+    }
+
+    fmt::println("多线程解码错误与串行一致: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+} // namespace
+
+int main() {
+    fmt::println("=== 正确性测试 ===\n");
+    int failures = test_streaming_matches_decode();
+    failures += test_streaming_bounded_memory();
+    failures += test_streaming_abort();
+
+    if (shine::util::ThreadPool::Get().GetThreadCount() <= 1) {
+        fmt::println("\n线程池只有 1 个线程，decode() 不会走多线程路径，下面的用例退化为串行对比");
+    }
+    failures += test_parallel_matches_serial();
+    failures += test_parallel_errors();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
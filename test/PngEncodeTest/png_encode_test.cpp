@@ -0,0 +1,190 @@
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "../../src/image/png.h"
+#include "../../src/util/encoding/deflate.h"
+#include "../../src/util/encoding/inflate.h"
+#include "../../src/util/thread/task_group.h"
+#include "../SimplePerfTest/benchmark_framework.h"
+#include "fmt/format.h"
+
+using shine::image::PngColorType;
+using shine::image::PngCompression;
+using shine::util::DeflateLevel;
+
+namespace {
+
+constexpr DeflateLevel kLevels[] = { DeflateLevel::Store, DeflateLevel::Fast, DeflateLevel::Default };
+constexpr const char* kLevelNames[] = { "Store", "Fast", "Default" };
+
+/**
+ * @brief 类似渲染结果的测试图像：平滑渐变 + 少量噪声 + 重复图案
+ */
+std::vector<uint8_t> make_image(uint32_t width, uint32_t height, size_t channels, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * channels);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* p = pixels.data() + (static_cast<size_t>(y) * width + x) * channels;
+            const bool checker = ((x / 32) + (y / 32)) % 2 == 0;
+            for (size_t c = 0; c < channels; ++c) {
+                const uint32_t base = checker ? (x * (c + 1) + y) : (255 - y * (c + 2));
+                p[c] = static_cast<uint8_t>(base + (rng() % 4));
+            }
+        }
+    }
+    return pixels;
+}
+
+std::vector<uint8_t> make_data(size_t size, int kind, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        switch (kind) {
+        case 0: data[i] = static_cast<uint8_t>(rng()); break;                          // 不可压缩
+        case 1: data[i] = static_cast<uint8_t>("shine engine "[i % 13]); break;         // 高度重复
+        case 2: data[i] = static_cast<uint8_t>((rng() % 8) ? i / 97 : rng()); break;   // 混合
+        default: data[i] = 0; break;                                                    // 全 0
+        }
+    }
+    return data;
+}
+
+int test_deflate_roundtrip() {
+    constexpr size_t sizes[] = { 0, 1, 2, 3, 258, 259, 4096, 65535, 65536, 70000, 256 * 1024, 256 * 1024 + 1, 900 * 1024 };
+
+    int failures = 0;
+    for (size_t size : sizes) {
+        for (int kind = 0; kind < 4; ++kind) {
+            const auto data = make_data(size, kind, static_cast<uint32_t>(size * 31 + kind));
+            for (size_t l = 0; l < 3; ++l) {
+                for (bool parallel : { false, true }) {
+                    const auto compressed = shine::util::zlibCompress(data, kLevels[l],
+                        parallel ? &shine::util::TaskGroup::Run : nullptr);
+                    const auto decompressed = shine::util::zlibInflate(compressed);
+                    if (!decompressed.has_value() || *decompressed != data) {
+                        ++failures;
+                        fmt::println("  FAIL: size={} kind={} level={} parallel={} {}", size, kind, kLevelNames[l], parallel,
+                            decompressed.has_value() ? "数据不一致" : decompressed.error());
+                    }
+                }
+            }
+        }
+    }
+
+    // Adler-32 合并
+    const auto data = make_data(100000, 2, 5);
+    const uint32_t whole = shine::util::adler32(1, data.data(), data.size());
+    const uint32_t a = shine::util::adler32(1, data.data(), 12345);
+    const uint32_t b = shine::util::adler32(1, data.data() + 12345, data.size() - 12345);
+    if (shine::util::adler32Combine(a, b, data.size() - 12345) != whole) {
+        ++failures;
+        fmt::println("  FAIL: adler32Combine");
+    }
+
+    fmt::println("Deflate 压缩往返: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+int test_png_roundtrip() {
+    struct Case { uint32_t width; uint32_t height; PngColorType type; size_t channels; };
+    constexpr Case cases[] = {
+        { 1, 1, PngColorType::RGBA, 4 },
+        { 17, 5, PngColorType::GERY, 1 },
+        { 33, 70, PngColorType::GERY_ALPHA, 2 },
+        { 129, 67, PngColorType::RGB, 3 },
+        { 300, 301, PngColorType::RGBA, 4 },
+        { 1024, 600, PngColorType::RGBA, 4 },
+    };
+
+    int failures = 0;
+    for (const Case& c : cases) {
+        const auto pixels = make_image(c.width, c.height, c.channels, c.width * 7 + c.height);
+
+        // 期望的 RGBA 解码结果
+        std::vector<uint8_t> expected(static_cast<size_t>(c.width) * c.height * 4);
+        for (size_t i = 0; i < static_cast<size_t>(c.width) * c.height; ++i) {
+            const uint8_t* src = pixels.data() + i * c.channels;
+            uint8_t* dst = expected.data() + i * 4;
+            switch (c.channels) {
+            case 1: dst[0] = dst[1] = dst[2] = src[0]; dst[3] = 255; break;
+            case 2: dst[0] = dst[1] = dst[2] = src[0]; dst[3] = src[1]; break;
+            case 3: dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = 255; break;
+            default: std::memcpy(dst, src, 4); break;
+            }
+        }
+
+        for (PngCompression compression : { PngCompression::Store, PngCompression::Fast, PngCompression::Default }) {
+            for (bool parallel : { false, true }) {
+                const auto encoded = shine::image::png::encode(pixels, c.width, c.height, c.type, { compression, parallel });
+                bool ok = encoded.has_value();
+
+                shine::image::png decoder;
+                ok = ok && decoder.loadFromMemory(encoded->data(), encoded->size());
+                ok = ok && decoder.decode().has_value();
+                ok = ok && decoder.getWidth() == c.width && decoder.getHeight() == c.height;
+                ok = ok && decoder.getImageData() == expected;
+                if (!ok) {
+                    ++failures;
+                    fmt::println("  FAIL: {}x{} type={} compression={} parallel={}", c.width, c.height,
+                        static_cast<int>(c.type), static_cast<int>(compression), parallel);
+                }
+            }
+        }
+    }
+
+    // 错误输入
+    const std::vector<uint8_t> tiny(10);
+    if (shine::image::png::encode(tiny, 4, 4, PngColorType::RGBA).has_value() ||
+        shine::image::png::encode(tiny, 2, 2, PngColorType::PALETTE).has_value()) {
+        ++failures;
+        fmt::println("  FAIL: 无效输入未报错");
+    }
+
+    fmt::println("PNG 编码往返: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+void benchmark() {
+    constexpr uint32_t width = 2048;
+    constexpr uint32_t height = 2048;
+    fmt::println("\n=== 性能测试（{}x{} RGBA8） ===\n", width, height);
+
+    const auto pixels = make_image(width, height, 4, 1);
+    const double megabytes = static_cast<double>(pixels.size()) / (1024.0 * 1024.0);
+
+    for (PngCompression compression : { PngCompression::Store, PngCompression::Fast, PngCompression::Default }) {
+        for (bool parallel : { false, true }) {
+            size_t encodedSize = 0;
+            const auto result = shine::benchmark::run_benchmark(
+                fmt::format("{} / {}", kLevelNames[static_cast<int>(compression)], parallel ? "并行" : "串行"),
+                [&] {
+                    auto encoded = shine::image::png::encode(pixels, width, height, PngColorType::RGBA, { compression, parallel });
+                    encodedSize = encoded.has_value() ? encoded->size() : 0;
+                },
+                3, 1);
+            fmt::println("   吞吐量: {:.1f} MB/s，压缩比: {:.1f}%\n", megabytes * 1e9 / result.median_time_ns,
+                100.0 * static_cast<double>(encodedSize) / static_cast<double>(pixels.size()));
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    fmt::println("=== 正确性测试 ===\n");
+    int failures = test_deflate_roundtrip();
+    failures += test_png_roundtrip();
+
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
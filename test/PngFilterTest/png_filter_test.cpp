@@ -0,0 +1,154 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../../src/image/png_filter.h"
+#include "../SimplePerfTest/benchmark_framework.h"
+#include "fmt/format.h"
+
+using shine::image::png_filter::UnfilterBackend;
+namespace png_filter = shine::image::png_filter;
+
+namespace {
+
+constexpr UnfilterBackend kSimdBackends[] = {
+    UnfilterBackend::SSE2,
+    UnfilterBackend::AVX2,
+    UnfilterBackend::NEON,
+};
+
+constexpr const char* kFilterNames[] = { "None", "Sub", "Up", "Average", "Paeth" };
+
+/**
+ * @brief 逐字节对比指定内核与标量实现
+ * @return 不一致的用例数
+ */
+int compare_backend(UnfilterBackend backend, std::mt19937& rng) {
+    constexpr size_t lengths[] = { 0, 1, 2, 3, 5, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 255, 1023, 4096 + 5 };
+
+    int failures = 0;
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    for (size_t bpp = 1; bpp <= 8; ++bpp) {
+        for (size_t length : lengths) {
+            std::vector<uint8_t> scanline(length), prevline(length);
+            for (auto& v : scanline) v = static_cast<uint8_t>(byte(rng));
+            for (auto& v : prevline) v = static_cast<uint8_t>(byte(rng));
+
+            for (uint8_t filter = 0; filter <= 4; ++filter) {
+                for (bool hasPrev : { true, false }) {
+                    const uint8_t* prev = hasPrev ? prevline.data() : nullptr;
+                    std::vector<uint8_t> expected(length, 0xCD), actual(length, 0xCD);
+
+                    png_filter::unfilterScanline(UnfilterBackend::Scalar, expected.data(), scanline.data(), prev, length, bpp, filter);
+                    png_filter::unfilterScanline(backend, actual.data(), scanline.data(), prev, length, bpp, filter);
+
+                    if (expected != actual) {
+                        ++failures;
+                        fmt::println("  FAIL: {} bpp={} len={} filter={} prev={}",
+                            png_filter::backendName(backend), bpp, length, kFilterNames[filter], hasPrev);
+                    }
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+/**
+ * @brief Paeth 预测器与规范定义逐值对比
+ */
+int test_paeth_predictor() {
+    auto reference = [](int a, int b, int c) {
+        const int p = a + b - c;
+        const int pa = p > a ? p - a : a - p;
+        const int pb = p > b ? p - b : b - p;
+        const int pc = p > c ? p - c : c - p;
+        if (pa <= pb && pa <= pc) return a;
+        if (pb <= pc) return b;
+        return c;
+    };
+
+    int failures = 0;
+    for (int a = 0; a < 256; a += 3) {
+        for (int b = 0; b < 256; ++b) {
+            for (int c = 0; c < 256; c += 5) {
+                if (png_filter::paethPredictor(a, b, c) != reference(a, b, c)) {
+                    ++failures;
+                }
+            }
+        }
+    }
+    fmt::println("Paeth 预测器: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试（与标量实现逐字节对比） ===\n");
+    fmt::println("当前内核: {}", png_filter::backendName(png_filter::activeBackend()));
+
+    int failures = test_paeth_predictor();
+
+    std::mt19937 rng(20240601);
+    for (UnfilterBackend backend : kSimdBackends) {
+        if (!png_filter::isBackendSupported(backend)) {
+            fmt::println("{}: SKIP（当前 CPU 不支持）", png_filter::backendName(backend));
+            continue;
+        }
+        const int backendFailures = compare_backend(backend, rng);
+        fmt::println("{}: {}", png_filter::backendName(backend), backendFailures == 0 ? "PASS" : "FAIL");
+        failures += backendFailures;
+    }
+
+    fmt::println("");
+    return failures;
+}
+
+void benchmark() {
+    fmt::println("=== 性能测试（4096x1 RGBA8 扫描线，共 64 行） ===\n");
+
+    constexpr size_t bpp = 4;
+    constexpr size_t length = 4096 * bpp;
+    constexpr size_t rows = 64;
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<uint8_t> filtered(length * rows);
+    for (auto& v : filtered) v = static_cast<uint8_t>(byte(rng));
+    std::vector<uint8_t> recon(length * rows);
+
+    for (uint8_t filter = 1; filter <= 4; ++filter) {
+        for (UnfilterBackend backend : { UnfilterBackend::Scalar, UnfilterBackend::SSE2, UnfilterBackend::AVX2, UnfilterBackend::NEON }) {
+            if (!png_filter::isBackendSupported(backend)) {
+                continue;
+            }
+            const auto result = shine::benchmark::run_benchmark(
+                fmt::format("{} / {}", kFilterNames[filter], png_filter::backendName(backend)),
+                [&] {
+                    const uint8_t* prev = nullptr;
+                    for (size_t y = 0; y < rows; ++y) {
+                        uint8_t* row = recon.data() + y * length;
+                        png_filter::unfilterScanline(backend, row, filtered.data() + y * length, prev, length, bpp, filter);
+                        prev = row;
+                    }
+                },
+                200, 20);
+            const double bytesPerNs = static_cast<double>(length * rows) / result.median_time_ns;
+            fmt::println("   吞吐量: {:.2f} GB/s\n", bytesPerNs);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../src/memory/pool_allocator.ixx"
+#include "../../src/util/shine_define.h"
+#include "fmt/format.h"
+
+using shine::co::MakePooled;
+using shine::co::Memory;
+using shine::co::MemoryScope;
+using shine::co::MemoryTag;
+using shine::co::PoolAllocator;
+using shine::co::PoolPtr;
+
+namespace {
+
+// ============================================================================
+// 正确性
+// ============================================================================
+
+int test_size_classes() {
+    int failures = 0;
+    std::vector<std::pair<u8*, size_t>> blocks;
+    for (size_t size = 1; size <= PoolAllocator::kMaxSize; size += 7) {
+        auto* p = static_cast<u8*>(PoolAllocator::Alloc(size));
+        const size_t classSize = PoolAllocator::GetClassSize(size);
+        if (!p || (reinterpret_cast<uintptr_t>(p) & (PoolAllocator::kAlignment - 1)) != 0 || classSize < size ||
+            classSize > size + size / 4 + 16) {
+            ++failures;
+            fmt::println("  FAIL: size {} -> class {} at {}", size, classSize, static_cast<void*>(p));
+            continue;
+        }
+        std::fill(p, p + size, static_cast<u8>(size));
+        blocks.emplace_back(p, size);
+    }
+    for (const auto& [p, size] : blocks) {
+        if (std::any_of(p, p + size, [size](u8 b) { return b != static_cast<u8>(size); })) {
+            ++failures;
+            fmt::println("  FAIL: block of size {} overwritten", size);
+        }
+        PoolAllocator::Free(p);
+    }
+
+    if (PoolAllocator::Alloc(0) != nullptr || PoolAllocator::Alloc(PoolAllocator::kMaxSize + 1) != nullptr) {
+        ++failures;
+        fmt::println("  FAIL: out-of-range sizes must return nullptr");
+    }
+
+    // 同线程释放后立即复用（LIFO）
+    void* a = PoolAllocator::Alloc(40);
+    PoolAllocator::Free(a);
+    if (PoolAllocator::Alloc(48) != a) {
+        ++failures;
+        fmt::println("  FAIL: freed block not reused by the same size class");
+    }
+    return failures;
+}
+
+int test_tag_stats() {
+    // 线程本地统计按 100 次 / 16KB 批量刷新，允许一个批次的误差
+    constexpr u32 kCount = 5000;
+    constexpr u64 kSlack = 100;
+    const auto before = Memory::GetTagStats(MemoryTag::Physics);
+
+    std::vector<void*> blocks;
+    blocks.reserve(kCount);  // 容器本身不计入 Physics
+    {
+        MemoryScope scope(MemoryTag::Physics);
+        for (u32 i = 0; i < kCount; ++i) blocks.push_back(PoolAllocator::Alloc(100));
+    }
+    const auto mid = Memory::GetTagStats(MemoryTag::Physics);
+    for (void* p : blocks) PoolAllocator::Free(p);
+    const auto after = Memory::GetTagStats(MemoryTag::Physics);
+
+    const size_t classSize = PoolAllocator::GetClassSize(100);
+    const u64 allocs = mid.alloc_count - before.alloc_count;
+    const size_t grown = mid.bytes_current - before.bytes_current;
+    if (allocs + kSlack < kCount || grown + kSlack * classSize < kCount * classSize ||
+        after.free_count - before.free_count + kSlack < kCount || after.bytes_current > before.bytes_current + kSlack * classSize) {
+        fmt::println("  FAIL: Physics allocs {} (+{} bytes), frees {}, current {} -> {}", allocs, grown,
+            after.free_count - before.free_count, before.bytes_current, after.bytes_current);
+        return 1;
+    }
+    return 0;
+}
+
+std::atomic<int> g_alive{0};
+
+struct Named {
+    virtual ~Named() = default;
+    std::string name = "named";
+};
+
+struct Ticking {
+    virtual ~Ticking() = default;
+    virtual int tick() { return 1; }
+};
+
+// 多重继承：Ticking* 与分配起点不同
+struct Actorish : Named, Ticking {
+    explicit Actorish(int v) : value(v) { ++g_alive; }
+    ~Actorish() override { --g_alive; }
+    int tick() override { return value; }
+    int value;
+};
+
+int test_pool_ptr() {
+    int failures = 0;
+    {
+        std::vector<PoolPtr<Ticking>> items;
+        for (int i = 0; i < 1000; ++i) {
+            PoolPtr<Actorish> item = MakePooled<Actorish>(i);
+            items.emplace_back(std::move(item));
+        }
+        int sum = 0;
+        for (auto& item : items) sum += item->tick();
+        if (sum != 999 * 1000 / 2 || g_alive.load() != 1000) {
+            ++failures;
+            fmt::println("  FAIL: sum {} alive {}", sum, g_alive.load());
+        }
+    }
+    if (g_alive.load() != 0) {
+        ++failures;
+        fmt::println("  FAIL: {} objects not destroyed", g_alive.load());
+    }
+
+    // 通过基类指针归还后，同尺寸分配应拿回同一块
+    auto* raw = MakePooled<Actorish>(7).release();
+    void* block = raw;
+    PoolPtr<Ticking>(raw).reset();
+    if (PoolAllocator::Alloc(sizeof(Actorish)) != block) {
+        ++failures;
+        fmt::println("  FAIL: base-pointer delete returned the wrong block");
+    }
+    return failures;
+}
+
+// 生产线程分配、消费线程释放，块经由全局仓库回流，slab 数量应保持稳定
+int test_cross_thread() {
+    int failures = 0;
+    constexpr u32 kRounds = 20;
+    constexpr u32 kPerRound = 20000;
+    std::vector<void*> blocks(kPerRound);
+    u32 slabsAfterWarmup = 0;
+
+    for (u32 round = 0; round < kRounds; ++round) {
+        std::thread producer([&] {
+            MemoryScope scope(MemoryTag::AI);
+            for (auto& p : blocks) p = PoolAllocator::Alloc(64);
+        });
+        producer.join();
+        std::thread consumer([&] {
+            for (void* p : blocks) PoolAllocator::Free(p);
+        });
+        consumer.join();
+        if (round == 2) slabsAfterWarmup = PoolAllocator::GetStats().slab_count;
+    }
+    if (PoolAllocator::GetStats().slab_count != slabsAfterWarmup) {
+        ++failures;
+        fmt::println("  FAIL: slabs grew {} -> {} while recycling", slabsAfterWarmup,
+            PoolAllocator::GetStats().slab_count);
+    }
+
+    // 多线程并发分配释放
+    std::vector<std::thread> threads;
+    std::atomic<int> corrupt{0};
+    for (u32 t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t] {
+            std::vector<u32*> live;
+            for (u32 i = 0; i < 50000; ++i) {
+                if (live.size() < 500 || (i * 2654435761u) % 3 != 0) {
+                    auto* p = static_cast<u32*>(PoolAllocator::Alloc(16 + (i % 8) * 16));
+                    *p = t * 1000000 + i;
+                    live.push_back(p);
+                } else {
+                    const size_t victim = (i * 40503u) % live.size();
+                    if (*live[victim] / 1000000 != t) corrupt.fetch_add(1);
+                    PoolAllocator::Free(live[victim]);
+                    live[victim] = live.back();
+                    live.pop_back();
+                }
+            }
+            for (u32* p : live) PoolAllocator::Free(p);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    if (corrupt.load() != 0) {
+        ++failures;
+        fmt::println("  FAIL: {} blocks handed to two owners", corrupt.load());
+    }
+    return failures;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试 ===\n");
+    int failures = 0;
+    const std::pair<const char*, int (*)()> cases[] = {
+        { "尺寸分级 / 对齐 / 复用", test_size_classes },
+        { "MemoryTag 统计", test_tag_stats },
+        { "PoolPtr 多态与多重继承", test_pool_ptr },
+        { "跨线程释放 / 并发", test_cross_thread },
+    };
+    for (const auto& [name, fn] : cases) {
+        const int caseFailures = fn();
+        fmt::println("{}: {}", name, caseFailures == 0 ? "PASS" : "FAIL");
+        failures += caseFailures;
+    }
+
+    fmt::println("");
+    return failures;
+}
+
+// ============================================================================
+// 性能：百万组件创建 + 销毁
+// ============================================================================
+
+// 与 UComponent 相同的布局：虚表、拥有者指针、名字、GUID
+struct BenchComponent {
+    virtual ~BenchComponent() = default;
+    virtual void onBeginPlay() {}
+    void* owner = nullptr;
+    std::string name;
+    u64 guid[2] = {};
+};
+
+struct BenchMesh : BenchComponent {
+    void onBeginPlay() override { ++frames; }
+    u32 frames = 0;
+    f32 bounds[6] = {};
+};
+
+constexpr u32 kComponents = 1000000;
+
+template<typename Make>
+double seconds_for(Make&& make) {
+    double best = 1e30;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        const auto start = std::chrono::steady_clock::now();
+        make();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+template<typename Ptr, typename Make>
+void bulk(Make&& make) {
+    std::vector<Ptr> components;
+    components.reserve(kComponents);
+    for (u32 i = 0; i < kComponents; ++i) components.push_back(make());
+    components.clear();
+}
+
+// 每次销毁一个旧组件再创建一个新组件
+template<typename Ptr, typename Make>
+void churn(Make&& make) {
+    std::vector<Ptr> components(4096);
+    for (u32 i = 0; i < kComponents; ++i) components[(i * 40503u) & 4095] = make();
+}
+
+void benchmark() {
+    fmt::println("=== 性能测试（{} 个组件，sizeof = {}，单位：ms） ===\n", kComponents, sizeof(BenchMesh));
+
+    const double uniqueBulk = seconds_for([] { bulk<std::unique_ptr<BenchComponent>>([] { return std::make_unique<BenchMesh>(); }); });
+    const double poolBulk = seconds_for([] { bulk<PoolPtr<BenchComponent>>([] { return MakePooled<BenchMesh>(); }); });
+    const double uniqueChurn = seconds_for([] { churn<std::unique_ptr<BenchComponent>>([] { return std::make_unique<BenchMesh>(); }); });
+    const double poolChurn = seconds_for([] { churn<PoolPtr<BenchComponent>>([] { return MakePooled<BenchMesh>(); }); });
+
+    fmt::println("{:>22} | {:>10} | {:>10}", "场景", "make_unique", "MakePooled");
+    fmt::println("{:>22} | {:>10.1f} | {:>10.1f}", "全部创建后全部销毁", uniqueBulk * 1e3, poolBulk * 1e3);
+    fmt::println("{:>22} | {:>10.1f} | {:>10.1f}", "4096 个槽位轮换", uniqueChurn * 1e3, poolChurn * 1e3);
+    fmt::println("");
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "../../src/memory/memory.ixx"
+#include "../../src/third/mimalloc/mimalloc.h"
+#include "../../src/util/shine_define.h"
+#include "fmt/format.h"
+
+using shine::co::Memory;
+using shine::co::MemoryScope;
+using shine::co::MemoryTag;
+using shine::co::MemoryTracker;
+
+namespace {
+
+// ============================================================================
+// 性能：大量小对象，先在带头部模式下测，开启无头部模式后再测一遍
+// ============================================================================
+
+constexpr u32 kObjects = 1000000;
+
+struct BenchResult {
+    double bytesPerObject;
+    double nsAlloc;
+    double nsFree;
+};
+
+size_t committed_bytes() {
+    size_t commit = 0;
+    mi_process_info(nullptr, nullptr, nullptr, nullptr, nullptr, &commit, nullptr, nullptr);
+    return commit;
+}
+
+// 16~64 字节混合，对象全部存活时测量提交内存
+BenchResult run_small_objects() {
+    MemoryScope scope(MemoryTag::Core);
+    std::vector<void*> objects(kObjects);
+    BenchResult result{ 0.0, 1e30, 1e30 };
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        const size_t before = committed_bytes();
+        auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < kObjects; ++i) {
+            objects[i] = Memory::Alloc(16 + (i % 4) * 16);
+            static_cast<char*>(objects[i])[0] = static_cast<char>(i);
+        }
+        const double allocSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const size_t after = committed_bytes();
+
+        start = std::chrono::steady_clock::now();
+        for (void* p : objects) Memory::Free(p);
+        const double freeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // 第一轮的增量最能反映真实占用，之后的轮次复用已提交页
+        if (repeat == 0) result.bytesPerObject = static_cast<double>(after - before) / kObjects;
+        result.nsAlloc = std::min(result.nsAlloc, allocSeconds * 1e9 / kObjects);
+        result.nsFree = std::min(result.nsFree, freeSeconds * 1e9 / kObjects);
+    }
+    return result;
+}
+
+// ============================================================================
+// 正确性（开启无头部模式之后）
+// ============================================================================
+
+// 线程本地统计按 100 次 / 16KB 批量刷新，允许一个批次的误差
+constexpr u64 kSlackCount = 100;
+constexpr size_t kSlackBytes = 16 * 1024;
+
+void* g_headerBlock = nullptr;  // 开启前分配，开启后释放
+
+int test_enable() {
+    int failures = 0;
+    if (!Memory::EnableHeaderFree(size_t(256) << 20) || !Memory::IsHeaderFree()) {
+        fmt::println("  FAIL: could not reserve tag arenas");
+        return 1;
+    }
+    // 重复调用无副作用
+    if (!Memory::EnableHeaderFree()) {
+        ++failures;
+        fmt::println("  FAIL: second EnableHeaderFree call failed");
+    }
+
+    // 开启前的带头部块仍可读写、重新分配和释放
+    if (std::memcmp(g_headerBlock, "header-mode", 12) != 0) {
+        ++failures;
+        fmt::println("  FAIL: header block corrupted");
+    }
+    void* moved = Memory::Realloc(g_headerBlock, 4000);
+    if (!moved || std::memcmp(moved, "header-mode", 12) != 0 || Memory::UsableSize(moved) < 4000) {
+        ++failures;
+        fmt::println("  FAIL: realloc from header block lost data");
+    }
+    Memory::Free(moved);
+    return failures;
+}
+
+int test_sizes_and_alignment() {
+    int failures = 0;
+    std::vector<std::pair<void*, size_t>> blocks;
+    for (size_t align = 1; align <= 4096; align <<= 1) {
+        for (size_t size : { size_t(1), size_t(24), size_t(200), size_t(5000), size_t(300000) }) {
+            void* p = Memory::Alloc(size, align);
+            if (!p || (reinterpret_cast<uintptr_t>(p) & (align - 1)) != 0 || Memory::UsableSize(p) < size) {
+                ++failures;
+                fmt::println("  FAIL: size {} align {} -> {} usable {}", size, align, p, Memory::UsableSize(p));
+                continue;
+            }
+            std::memset(p, static_cast<int>(size & 0xFF), size);
+            blocks.emplace_back(p, size);
+        }
+    }
+    for (auto [p, size] : blocks) {
+        const auto* bytes = static_cast<const unsigned char*>(p);
+        if (bytes[0] != (size & 0xFF) || bytes[size - 1] != (size & 0xFF)) {
+            ++failures;
+            fmt::println("  FAIL: block of size {} overwritten", size);
+        }
+        Memory::Free(p);
+    }
+
+    // 无头部块的 Realloc
+    auto* grown = static_cast<char*>(Memory::Alloc(32));
+    std::memcpy(grown, "0123456789abcdef0123456789abcde", 32);
+    grown = static_cast<char*>(Memory::Realloc(grown, 10000));
+    if (std::memcmp(grown, "0123456789abcdef0123456789abcde", 32) != 0) {
+        ++failures;
+        fmt::println("  FAIL: realloc of header-free block lost data");
+    }
+    Memory::Free(grown);
+    return failures;
+}
+
+int test_tag_recovery() {
+    constexpr u32 kCount = 4000;
+    std::vector<void*> blocks(kCount);
+    const auto before = Memory::GetTagStats(MemoryTag::AI);
+
+    // 在一个线程以 AI 标签分配，在另一个线程释放：标签只能从所属 arena 推回
+    std::thread producer([&] {
+        MemoryScope scope(MemoryTag::AI);
+        for (auto& p : blocks) p = Memory::Alloc(48);
+    });
+    producer.join();
+    const auto mid = Memory::GetTagStats(MemoryTag::AI);
+    std::thread consumer([&] {
+        MemoryScope scope(MemoryTag::Render);  // 释放时的作用域标签不应影响记账
+        for (void* p : blocks) Memory::Free(p);
+    });
+    consumer.join();
+    const auto after = Memory::GetTagStats(MemoryTag::AI);
+
+    if (mid.alloc_count - before.alloc_count + kSlackCount < kCount || mid.bytes_current < before.bytes_current + kCount * 48 - kSlackBytes ||
+        after.free_count - before.free_count + kSlackCount < kCount || after.bytes_current > before.bytes_current + kSlackBytes) {
+        fmt::println("  FAIL: AI allocs {} frees {} current {} -> {} -> {}", mid.alloc_count - before.alloc_count,
+            after.free_count - before.free_count, before.bytes_current, mid.bytes_current, after.bytes_current);
+        return 1;
+    }
+    return 0;
+}
+
+int test_tracking_uses_header() {
+    int failures = 0;
+    MemoryTracker::SetEnabled(true);
+    const auto loc = std::source_location::current();
+    void* tracked = Memory::Alloc(100, 16, loc);
+    const auto snapshot = MemoryTracker::Snapshot();
+    MemoryTracker::SetEnabled(false);
+
+    bool found = false;
+    for (const auto& site : snapshot.sites) {
+        if (site.file && site.line == loc.line() && site.live_count == 1) found = true;
+    }
+    if (!found) {
+        ++failures;
+        fmt::println("  FAIL: tracked allocation missing from the call-site table");
+    }
+    Memory::Free(tracked);
+    return failures;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试 ===\n");
+    int failures = 0;
+    const std::pair<const char*, int (*)()> cases[] = {
+        { "开启无头部模式 / 旧块兼容", test_enable },
+        { "尺寸 / 对齐 / Realloc", test_sizes_and_alignment },
+        { "跨线程释放按 arena 找回标签", test_tag_recovery },
+        { "调用点跟踪仍走带头部路径", test_tracking_uses_header },
+    };
+    for (const auto& [name, fn] : cases) {
+        const int caseFailures = fn();
+        fmt::println("{}: {}", name, caseFailures == 0 ? "PASS" : "FAIL");
+        failures += caseFailures;
+    }
+
+    fmt::println("");
+    return failures;
+}
+
+} // namespace
+
+int main() {
+    g_headerBlock = Memory::Alloc(64);
+    std::memcpy(g_headerBlock, "header-mode", 12);
+
+    const BenchResult headered = run_small_objects();
+    const int failures = test_correctness();
+    const BenchResult headerFree = run_small_objects();
+
+    fmt::println("=== 性能测试（{} 个 16~64 字节对象，全部存活后再全部释放） ===\n", kObjects);
+    fmt::println("{:>10} | {:>12} | {:>10} | {:>10}", "模式", "字节/对象", "分配 ns", "释放 ns");
+    fmt::println("{:>10} | {:>12.1f} | {:>10.1f} | {:>10.1f}", "带头部", headered.bytesPerObject, headered.nsAlloc, headered.nsFree);
+    fmt::println("{:>10} | {:>12.1f} | {:>10.1f} | {:>10.1f}", "无头部", headerFree.bytesPerObject, headerFree.nsAlloc, headerFree.nsFree);
+    fmt::println("");
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
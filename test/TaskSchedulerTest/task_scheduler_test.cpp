@@ -0,0 +1,420 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../../src/util/thread/job_executor.h"
+#include "../../src/util/thread/task_scheduler.h"
+#include "../../src/util/thread/thread_pool.h"
+#include "fmt/format.h"
+
+using shine::util::JobCounter;
+using shine::util::TaskHandle;
+using shine::util::TaskScheduler;
+using shine::util::ThreadPool;
+namespace job = shine::util::job;
+
+// 统计全局堆分配次数（所有线程）
+std::atomic<u64> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// ============================================================================
+// 对照组：每个任务一个 unique_ptr、全程持有互斥量的旧调度器
+// ============================================================================
+
+class LegacyScheduler {
+public:
+    explicit LegacyScheduler(ThreadPool& pool) : _pool(pool) {}
+
+    TaskHandle CreateTask(job::Job job) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto node = std::make_unique<TaskNode>();
+        node->job = std::move(job);
+        const u32 id = static_cast<u32>(_tasks.size());
+        _tasks.push_back(std::move(node));
+        return TaskHandle{id, true};
+    }
+
+    void AddDependency(TaskHandle task, TaskHandle dependsOn) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks[task.id]->dependencies.push_back(dependsOn.id);
+        _tasks[dependsOn.id]->dependents.push_back(task.id);
+        ++_tasks[task.id]->remainingDeps;
+    }
+
+    void RunAll() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (u32 id = 0; id < _tasks.size(); ++id) {
+            if (_tasks[id]->remainingDeps == 0 && !_tasks[id]->completed) {
+                _pool.Submit([this, id] { ExecuteTask(id); }, &_counter);
+            }
+        }
+    }
+
+    void WaitAll() { _pool.WaitForCounter(_counter); }
+
+    // 旧实现从不回收节点；这里按帧清空，相当于每帧换一个新调度器
+    void Reset() {
+        WaitAll();
+        _tasks.clear();
+    }
+
+    void ExecuteTask(u32 id) {
+        job::Job* current = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            current = &_tasks[id]->job;
+        }
+        job::JobExecutor executor;
+        std::visit(executor, *current);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks[id]->completed = true;
+        for (u32 depId : _tasks[id]->dependents) {
+            if (--_tasks[depId]->remainingDeps == 0 && !_tasks[depId]->completed) {
+                _pool.Submit([this, depId] { ExecuteTask(depId); }, &_counter);
+            }
+        }
+    }
+
+private:
+    struct TaskNode {
+        job::Job job;
+        std::vector<u32> dependencies;
+        std::vector<u32> dependents;
+        std::atomic<u32> remainingDeps{0};
+        std::atomic<bool> completed{false};
+    };
+
+    ThreadPool& _pool;
+    std::vector<std::unique_ptr<TaskNode>> _tasks;
+    std::mutex _mutex;
+    JobCounter _counter;
+};
+
+// ============================================================================
+// 随机 DAG：每个任务执行时检查依赖都已完成，且自身只执行一次
+// ============================================================================
+
+struct Graph {
+    std::vector<std::vector<u32>> deps;  // 只指向更小的编号，保证无环
+    std::vector<std::atomic<u8>> runs;
+    std::atomic<u32> violations{0};
+
+    struct Slot {
+        Graph* graph;
+        u32 id;
+    };
+    std::vector<Slot> slots;
+
+    Graph(u32 count, u32 maxDeps, u32 seed) : deps(count), runs(count) {
+        std::mt19937 rng(seed);
+        for (u32 i = 1; i < count; ++i) {
+            const u32 n = rng() % (maxDeps + 1);
+            for (u32 d = 0; d < n; ++d) deps[i].push_back(rng() % i);
+        }
+        for (u32 i = 0; i < count; ++i) slots.push_back(Slot{this, i});
+    }
+
+    static void Visit(void* userdata, float) {
+        auto* slot = static_cast<Slot*>(userdata);
+        Graph& graph = *slot->graph;
+        for (u32 dep : graph.deps[slot->id]) {
+            if (graph.runs[dep].load(std::memory_order_acquire) == 0) {
+                graph.violations.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        if (graph.runs[slot->id].fetch_add(1, std::memory_order_acq_rel) != 0) {
+            graph.violations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename Scheduler>
+    void Build(Scheduler& scheduler, std::vector<TaskHandle>& handles) {
+        handles.clear();
+        for (u32 i = 0; i < deps.size(); ++i) {
+            handles.push_back(scheduler.CreateTask(job::JobExecuteTick{&Graph::Visit, &slots[i], 0.0f}));
+        }
+        for (u32 i = 0; i < deps.size(); ++i) {
+            for (u32 dep : deps[i]) scheduler.AddDependency(handles[i], handles[dep]);
+        }
+    }
+
+    int Check(const char* label) {
+        int failures = 0;
+        for (u32 i = 0; i < runs.size(); ++i) {
+            if (runs[i].load() != 1) {
+                ++failures;
+                fmt::println("  FAIL: {} task {} ran {} times", label, i, runs[i].load());
+                break;
+            }
+        }
+        if (violations.load() != 0) {
+            ++failures;
+            fmt::println("  FAIL: {} {} ordering violations", label, violations.load());
+        }
+        for (auto& run : runs) run.store(0, std::memory_order_relaxed);
+        violations = 0;
+        return failures;
+    }
+};
+
+int test_random_graphs() {
+    int failures = 0;
+    std::vector<TaskHandle> handles;
+    for (u32 threads : { 1u, 2u, 4u }) {
+        ThreadPool pool(threads);
+        TaskScheduler scheduler(pool);
+        for (u32 seed = 0; seed < 5; ++seed) {
+            Graph graph(3000 + seed * 997, 4, seed);
+            graph.Build(scheduler, handles);
+            scheduler.RunAll();
+            scheduler.WaitAll();
+            failures += graph.Check("random graph");
+            scheduler.Reset();
+        }
+    }
+    return failures;
+}
+
+int test_run_and_wait() {
+    int failures = 0;
+    ThreadPool pool(2);
+    TaskScheduler scheduler(pool);
+    std::vector<TaskHandle> handles;
+
+    // 只 Run 根任务：其余任务由依赖释放自动派发
+    Graph chain(500, 0, 1);
+    for (u32 i = 1; i < 500; ++i) chain.deps[i] = { i - 1 };
+    chain.Build(scheduler, handles);
+    scheduler.Run(handles[0]);
+    scheduler.Run(handles[0]);   // 重复派发被忽略
+    scheduler.Run(handles[10]);  // 仍有依赖，忽略
+    scheduler.Wait(handles.back());
+    failures += chain.Check("chain");
+
+    // 帧重置后旧句柄失效，编号被回收
+    scheduler.Reset();
+    if (scheduler.GetTaskCount() != 0) {
+        ++failures;
+        fmt::println("  FAIL: Reset left {} tasks", scheduler.GetTaskCount());
+    }
+    const TaskHandle stale = handles[3];
+    Graph single(1, 0, 2);
+    single.Build(scheduler, handles);
+    if (handles[0].id != 0) {
+        ++failures;
+        fmt::println("  FAIL: ids not recycled (got {})", handles[0].id);
+    }
+    scheduler.Run(stale);
+    scheduler.Wait(stale);
+    scheduler.RunAll();
+    scheduler.WaitAll();
+    failures += single.Check("after reset");
+
+    // 已完成的依赖不再阻塞新任务
+    const TaskHandle late = scheduler.CreateTask(job::JobExecuteTick{&Graph::Visit, &single.slots[0], 0.0f});
+    scheduler.AddDependency(late, handles[0]);
+    scheduler.Run(late);
+    scheduler.Wait(late);
+    failures += single.Check("late dependency");
+    scheduler.Reset();
+    return failures;
+}
+
+// 等待方没有可执行的任务时改为阻塞，任务完成后必须被唤醒；
+// 包括工作线程在任务内部等待一个稍后才派发的任务
+struct BlockingWait {
+    TaskScheduler* scheduler;
+    TaskHandle target{};
+    std::atomic<u32> stage{0};
+
+    static void Sleep(void* userdata, float) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        static_cast<BlockingWait*>(userdata)->stage.store(1, std::memory_order_release);
+    }
+
+    static void WaitTarget(void* userdata, float) {
+        auto* self = static_cast<BlockingWait*>(userdata);
+        self->scheduler->Wait(self->target);
+        self->stage.fetch_add(10, std::memory_order_acq_rel);
+    }
+};
+
+int test_blocking_wait() {
+    int failures = 0;
+    ThreadPool pool(1);
+    TaskScheduler scheduler(pool);
+
+    // 主线程等待正在工作线程上执行的任务
+    BlockingWait sleeper{ &scheduler };
+    const TaskHandle slow = scheduler.CreateTask(job::JobExecuteTick{&BlockingWait::Sleep, &sleeper, 0.0f});
+    scheduler.Run(slow);
+    scheduler.Wait(slow);
+    if (sleeper.stage.load() != 1) {
+        ++failures;
+        fmt::println("  FAIL: Wait returned before the task finished");
+    }
+
+    // 唯一的工作线程等待一个尚未派发的任务，随后由主线程派发
+    BlockingWait waiter{ &scheduler };
+    waiter.target = scheduler.CreateTask(job::JobExecuteTick{&BlockingWait::Sleep, &waiter, 0.0f});
+    const TaskHandle outer = scheduler.CreateTask(job::JobExecuteTick{&BlockingWait::WaitTarget, &waiter, 0.0f});
+    scheduler.Run(outer);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    scheduler.Run(waiter.target);
+    scheduler.Wait(outer);
+    if (waiter.stage.load() != 11) {
+        ++failures;
+        fmt::println("  FAIL: nested wait finished in the wrong order (stage {})", waiter.stage.load());
+    }
+
+    scheduler.Reset();
+    return failures;
+}
+
+int test_steady_state_allocations() {
+    ThreadPool pool(3);
+    TaskScheduler scheduler(pool);
+    Graph graph(4000, 3, 7);
+    std::vector<TaskHandle> handles;
+    handles.reserve(4000);
+
+    int failures = 0;
+    for (int warm = 0; warm < 3; ++warm) {
+        graph.Build(scheduler, handles);
+        scheduler.RunAll();
+        scheduler.Reset();
+        failures += graph.Check("warm-up");
+    }
+
+    const u64 before = g_allocations.load();
+    for (int frame = 0; frame < 20; ++frame) {
+        graph.Build(scheduler, handles);
+        scheduler.RunAll();
+        scheduler.Reset();
+        for (auto& run : graph.runs) run.store(0, std::memory_order_relaxed);
+    }
+    const u64 allocations = g_allocations.load() - before;
+    if (allocations != 0) {
+        ++failures;
+        fmt::println("  FAIL: 20 frames made {} heap allocations", allocations);
+    }
+    return failures;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试 ===\n");
+    int failures = 0;
+    const std::pair<const char*, int (*)()> cases[] = {
+        { "随机 DAG 依赖顺序", test_random_graphs },
+        { "Run / Wait / Reset", test_run_and_wait },
+        { "无任务可帮时阻塞等待", test_blocking_wait },
+        { "稳态帧零分配", test_steady_state_allocations },
+    };
+    for (const auto& [name, fn] : cases) {
+        const int caseFailures = fn();
+        fmt::println("{}: {}", name, caseFailures == 0 ? "PASS" : "FAIL");
+        failures += caseFailures;
+    }
+
+    fmt::println("");
+    return failures;
+}
+
+// ============================================================================
+// 性能：分层帧图（每层 256 个任务，每个任务依赖上一层的 2 个）
+// ============================================================================
+
+constexpr u32 kLayerWidth = 256;
+std::atomic<u64> g_ticks{0};
+
+void tiny_tick(void*, float) {
+    g_ticks.fetch_add(1, std::memory_order_relaxed);
+}
+
+struct FrameCost {
+    double buildUs;
+    double runUs;
+};
+
+template <typename Scheduler>
+FrameCost measure_frames(Scheduler& scheduler, u32 layers) {
+    constexpr int kFrames = 30;
+    std::vector<TaskHandle> handles(layers * kLayerWidth);
+    FrameCost best{1e30, 1e30};
+
+    for (int frame = 0; frame < kFrames; ++frame) {
+        g_ticks = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < handles.size(); ++i) {
+            handles[i] = scheduler.CreateTask(job::JobExecuteTick{tiny_tick, nullptr, 0.0f});
+        }
+        for (u32 layer = 1; layer < layers; ++layer) {
+            for (u32 x = 0; x < kLayerWidth; ++x) {
+                const u32 id = layer * kLayerWidth + x;
+                const u32 above = (layer - 1) * kLayerWidth;
+                scheduler.AddDependency(handles[id], handles[above + x]);
+                scheduler.AddDependency(handles[id], handles[above + (x * 7 + 1) % kLayerWidth]);
+            }
+        }
+        const auto built = std::chrono::steady_clock::now();
+        scheduler.RunAll();
+        scheduler.WaitAll();
+        const auto finished = std::chrono::steady_clock::now();
+        if (g_ticks.load() != handles.size()) fmt::println("  WARN: ran {} of {} tasks", g_ticks.load(), handles.size());
+        scheduler.Reset();
+
+        best.buildUs = std::min(best.buildUs, std::chrono::duration<double, std::micro>(built - start).count());
+        best.runUs = std::min(best.runUs, std::chrono::duration<double, std::micro>(finished - built).count());
+    }
+    return best;
+}
+
+void benchmark() {
+    const u32 threads = std::max(1u, std::thread::hardware_concurrency());
+    fmt::println("=== 性能测试（分层帧图，{} 线程，取 30 帧最优） ===\n", threads);
+    fmt::println("{:>6} | {:>12} {:>12} | {:>12} {:>12}", "任务数", "旧/构建", "新/构建", "旧/执行", "新/执行");
+
+    ThreadPool pool(threads);
+    for (u32 layers : { 4u, 16u, 64u }) {
+        LegacyScheduler legacyScheduler(pool);
+        const FrameCost legacy = measure_frames(legacyScheduler, layers);
+        TaskScheduler scheduler(pool);
+        const FrameCost arena = measure_frames(scheduler, layers);
+
+        fmt::println("{:>6} | {:>10.1f}us {:>10.1f}us | {:>10.1f}us {:>10.1f}us", layers * kLayerWidth,
+            legacy.buildUs, arena.buildUs, legacy.runUs, arena.runUs);
+    }
+    fmt::println("\n（构建 = CreateTask + AddDependency；执行 = RunAll + WaitAll）\n");
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../../src/image/bc_compress.h"
+#include "../../src/image/bc_dsp.h"
+#include "../SimplePerfTest/benchmark_framework.h"
+#include "fmt/format.h"
+
+using shine::image::bc::BcFormat;
+using shine::image::bc_dsp::DspBackend;
+using shine::image::bc_dsp::DspKernels;
+namespace bc = shine::image::bc;
+namespace bc_dsp = shine::image::bc_dsp;
+
+namespace {
+
+constexpr DspBackend kSimdBackends[] = {
+    DspBackend::SSE2,
+};
+
+constexpr BcFormat kFormats[] = { BcFormat::BC1, BcFormat::BC3, BcFormat::BC4, BcFormat::BC5, BcFormat::BC7 };
+
+/**
+ * @brief 合成测试图：平滑渐变叠加硬边、细噪声和与颜色无关的 Alpha 渐变
+ */
+std::vector<uint8_t> make_image(uint32_t width, uint32_t height, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* p = rgba.data() + (static_cast<size_t>(y) * width + x) * 4;
+            const int edge = ((x / 13 + y / 9) % 2) ? 60 : 0;
+            p[0] = static_cast<uint8_t>(std::min<uint32_t>(255, x * 200 / width + edge + rng() % 6));
+            p[1] = static_cast<uint8_t>(std::min<uint32_t>(255, y * 220 / height + rng() % 6));
+            p[2] = static_cast<uint8_t>(std::min<uint32_t>(255, (x + y) * 120 / (width + height) + edge + 40));
+            p[3] = static_cast<uint8_t>(255 - y * 255 / height);
+        }
+    }
+    return rgba;
+}
+
+double psnr(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, int channels) {
+    double se = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < a.size(); i += 4) {
+        for (int c = 0; c < channels; ++c) {
+            const double d = static_cast<double>(a[i + c]) - b[i + c];
+            se += d * d;
+            ++count;
+        }
+    }
+    return se == 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 * count / se);
+}
+
+int channel_count(BcFormat format) {
+    switch (format) {
+    case BcFormat::BC1: return 3;
+    case BcFormat::BC4: return 1;
+    case BcFormat::BC5: return 2;
+    default: return 4;
+    }
+}
+
+// ============================================================================
+// 内核：SIMD 与标量逐字节对比
+// ============================================================================
+
+int compare_kernels(DspBackend backend, std::mt19937& rng) {
+    const DspKernels& expected = bc_dsp::kernels(DspBackend::Scalar);
+    const DspKernels& actual = bc_dsp::kernels(backend);
+
+    int failures = 0;
+    for (int iteration = 0; iteration < 2000; ++iteration) {
+        uint8_t pixels[64], palette[64];
+        // 一半用相近的值（大量平局），一半全范围随机
+        const uint32_t range = iteration % 2 ? 256 : 4;
+        for (uint8_t& v : pixels) v = static_cast<uint8_t>(rng() % range);
+        for (uint8_t& v : palette) v = static_cast<uint8_t>(rng() % range);
+
+        for (uint32_t paletteSize : { 4u, 8u, 16u }) {
+            for (uint32_t mask : { 0x00FFFFFFu, 0xFFFFFFFFu }) {
+                uint8_t lhs[16], rhs[16];
+                const uint32_t errorLhs = expected.fitColorIndices(pixels, palette, paletteSize, mask, lhs);
+                const uint32_t errorRhs = actual.fitColorIndices(pixels, palette, paletteSize, mask, rhs);
+                if (errorLhs != errorRhs || !std::equal(lhs, lhs + 16, rhs)) {
+                    ++failures;
+                    fmt::println("  FAIL: {} fitColorIndices paletteSize={} mask={:08X}",
+                        bc_dsp::backendName(backend), paletteSize, mask);
+                }
+            }
+        }
+
+        uint8_t lhs[16], rhs[16];
+        const uint32_t errorLhs = expected.fitAlphaIndices(pixels, palette, lhs);
+        const uint32_t errorRhs = actual.fitAlphaIndices(pixels, palette, rhs);
+        if (errorLhs != errorRhs || !std::equal(lhs, lhs + 16, rhs)) {
+            ++failures;
+            fmt::println("  FAIL: {} fitAlphaIndices", bc_dsp::backendName(backend));
+        }
+    }
+    return failures;
+}
+
+// ============================================================================
+// 压缩 / 解压
+// ============================================================================
+
+/**
+ * @brief 手工构造的块按规范解码
+ */
+int test_known_blocks() {
+    int failures = 0;
+    uint8_t pixels[64];
+
+    // BC1 四色模式：c0 = 纯红 (0xF800)，c1 = 纯蓝 (0x001F)，索引依次为 0 1 2 3
+    const uint8_t bc1[8] = { 0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4 };
+    bc::decompressBlock(BcFormat::BC1, bc1, pixels);
+    const uint8_t bc1Expected[16] = { 255, 0, 0, 255, 0, 0, 255, 255, 170, 0, 85, 255, 85, 0, 170, 255 };
+    if (!std::equal(bc1Expected, bc1Expected + 16, pixels)) {
+        ++failures;
+        fmt::println("  FAIL: BC1 四色模式解码");
+    }
+
+    // BC1 三色模式（c0 <= c1）：索引 3 为透明黑
+    const uint8_t bc1Alpha[8] = { 0x1F, 0x00, 0x00, 0xF8, 0xFF, 0xFF, 0xFF, 0xFF };
+    bc::decompressBlock(BcFormat::BC1, bc1Alpha, pixels);
+    if (pixels[0] != 0 || pixels[3] != 0) {
+        ++failures;
+        fmt::println("  FAIL: BC1 三色模式透明像素");
+    }
+
+    // BC4 八值模式：a0 = 255，a1 = 0，所有索引为 2 -> (6 * 255 + 0) / 7
+    const uint8_t bc4[8] = { 255, 0, 0x92, 0x24, 0x49, 0x92, 0x24, 0x49 };
+    bc::decompressBlock(BcFormat::BC4, bc4, pixels);
+    for (int i = 0; i < 16; ++i) {
+        if (pixels[i * 4] != 219 || pixels[i * 4 + 3] != 255) {
+            ++failures;
+            fmt::println("  FAIL: BC4 八值模式解码");
+            break;
+        }
+    }
+
+    // BC7 只支持单子集模式，模式 0 应报告不支持
+    const uint8_t bc7Mode0[16] = { 0x01 };
+    if (bc::decompressBlock(BcFormat::BC7, bc7Mode0, pixels)) {
+        ++failures;
+        fmt::println("  FAIL: BC7 模式 0 未报告不支持");
+    }
+    return failures;
+}
+
+/**
+ * @brief 纯色块压缩后应几乎无损
+ */
+int test_solid_blocks() {
+    int failures = 0;
+    std::mt19937 rng(11);
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        uint8_t color[4];
+        for (uint8_t& c : color) c = static_cast<uint8_t>(rng());
+        uint8_t pixels[64];
+        for (int i = 0; i < 16; ++i) std::copy(color, color + 4, pixels + i * 4);
+
+        for (BcFormat format : kFormats) {
+            uint8_t block[16], decoded[64];
+            bc::compressBlock(format, pixels, block);
+            bc::decompressBlock(format, block, decoded);
+            // BC1 的 565 量化误差最大约 4，BC7 的 P 位约束最大约 1，BC4 / BC5 精确
+            const int tolerance = format == BcFormat::BC1 || format == BcFormat::BC3 ? 4 : format == BcFormat::BC7 ? 1 : 0;
+            for (int c = 0; c < channel_count(format); ++c) {
+                if (std::abs(decoded[c] - color[c]) > tolerance) {
+                    ++failures;
+                    fmt::println("  FAIL: {} 纯色块通道 {}: {} -> {}", bc::formatName(format), c, color[c], decoded[c]);
+                    break;
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+int test_round_trip() {
+    int failures = 0;
+    // 非 4 的倍数的尺寸覆盖边缘块；阈值比实测值低约 2 dB
+    constexpr uint32_t width = 131;
+    constexpr uint32_t height = 77;
+    const std::vector<uint8_t> image = make_image(width, height, 5);
+    constexpr double minPsnr[] = { 37.0, 38.0, 40.0, 43.0, 41.0 };
+
+    for (size_t f = 0; f < std::size(kFormats); ++f) {
+        const BcFormat format = kFormats[f];
+        const auto blocks = bc::compress(image.data(), width, height, format);
+        if (!blocks.has_value() || blocks->size() != bc::compressedSize(format, width, height)) {
+            ++failures;
+            fmt::println("  FAIL: {} 压缩失败", bc::formatName(format));
+            continue;
+        }
+        const auto decoded = bc::decompress(blocks->data(), blocks->size(), width, height, format);
+        if (!decoded.has_value()) {
+            ++failures;
+            fmt::println("  FAIL: {} 解压失败: {}", bc::formatName(format), decoded.error());
+            continue;
+        }
+        const double quality = psnr(image, *decoded, channel_count(format));
+        fmt::println("  {}: {:.2f} dB", bc::formatName(format), quality);
+        if (quality < minPsnr[f]) {
+            ++failures;
+            fmt::println("  FAIL: {} PSNR 低于 {:.1f} dB", bc::formatName(format), minPsnr[f]);
+        }
+
+        // 不精化时质量下降但仍可用
+        bc::CompressOptions fast;
+        fast.refine = false;
+        const auto fastBlocks = bc::compress(image.data(), width, height, format, fast);
+        const auto fastDecoded = bc::decompress(fastBlocks->data(), fastBlocks->size(), width, height, format);
+        if (psnr(image, *fastDecoded, channel_count(format)) < minPsnr[f] - 6.0) {
+            ++failures;
+            fmt::println("  FAIL: {} 未精化的 PSNR 过低", bc::formatName(format));
+        }
+    }
+
+    if (bc::compress(image.data(), 0, height, BcFormat::BC1).has_value() ||
+        bc::decompress(image.data(), 8, width, height, BcFormat::BC1).has_value()) {
+        ++failures;
+        fmt::println("  FAIL: 无效参数未报错");
+    }
+    return failures;
+}
+
+int test_parallel() {
+    int failures = 0;
+    constexpr uint32_t width = 512;
+    constexpr uint32_t height = 300;
+    const std::vector<uint8_t> image = make_image(width, height, 9);
+    for (BcFormat format : kFormats) {
+        bc::CompressOptions serial;
+        serial.parallel = false;
+        bc::CompressOptions parallel;
+        parallel.parallelMinPixels = 0;
+        if (bc::compress(image.data(), width, height, format, serial) !=
+            bc::compress(image.data(), width, height, format, parallel)) {
+            ++failures;
+            fmt::println("  FAIL: {} 并行压缩结果与串行不同", bc::formatName(format));
+        }
+    }
+    return failures;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试 ===\n");
+    fmt::println("当前内核: {}", bc_dsp::backendName(bc_dsp::activeBackend()));
+
+    int failures = 0;
+    std::mt19937 rng(20240801);
+    for (DspBackend backend : kSimdBackends) {
+        if (!bc_dsp::isBackendSupported(backend)) {
+            fmt::println("{}: SKIP（当前 CPU 不支持）", bc_dsp::backendName(backend));
+            continue;
+        }
+        const int backendFailures = compare_kernels(backend, rng);
+        fmt::println("{}: {}", bc_dsp::backendName(backend), backendFailures == 0 ? "PASS" : "FAIL");
+        failures += backendFailures;
+    }
+
+    int known = test_known_blocks() + test_solid_blocks();
+    fmt::println("块解码 / 纯色块: {}", known == 0 ? "PASS" : "FAIL");
+    failures += known;
+
+    fmt::println("往返 PSNR:");
+    int roundTrip = test_round_trip();
+    fmt::println("往返压缩: {}", roundTrip == 0 ? "PASS" : "FAIL");
+    failures += roundTrip;
+
+    int parallel = test_parallel();
+    fmt::println("并行压缩: {}", parallel == 0 ? "PASS" : "FAIL");
+    failures += parallel;
+
+    fmt::println("");
+    return failures;
+}
+
+void benchmark() {
+    constexpr uint32_t width = 2048;
+    constexpr uint32_t height = 2048;
+    fmt::println("=== 性能测试（{}x{}） ===\n", width, height);
+    const std::vector<uint8_t> image = make_image(width, height, 3);
+    std::vector<uint8_t> out(bc::compressedSize(BcFormat::BC7, width, height));
+
+    // 内核：每块 16 项调色板（BC7 模式 6 的热循环）
+    std::mt19937 rng(1);
+    std::vector<uint8_t> palette(64);
+    for (uint8_t& v : palette) v = static_cast<uint8_t>(rng());
+    for (DspBackend backend : { DspBackend::Scalar, DspBackend::SSE2 }) {
+        if (!bc_dsp::isBackendSupported(backend)) {
+            continue;
+        }
+        const DspKernels& k = bc_dsp::kernels(backend);
+        uint8_t indices[16];
+        const auto result = shine::benchmark::run_benchmark(
+            fmt::format("fitColorIndices(16) / {}", bc_dsp::backendName(backend)),
+            [&] {
+                uint32_t sum = 0;
+                for (size_t block = 0; block < 65536; ++block) {
+                    sum += k.fitColorIndices(image.data() + block * 64, palette.data(), 16, 0xFFFFFFFFu, indices);
+                }
+                indices[0] ^= static_cast<uint8_t>(sum);
+            },
+            10, 2);
+        fmt::println("   吞吐量: {:.1f} 百万块/秒\n", 65536.0 * 1e3 / result.median_time_ns);
+    }
+
+    for (BcFormat format : kFormats) {
+        for (bool parallel : { false, true }) {
+            bc::CompressOptions options;
+            options.parallel = parallel;
+            const auto result = shine::benchmark::run_benchmark(
+                fmt::format("{} / {}", bc::formatName(format), parallel ? "并行" : "串行"),
+                [&] {
+                    (void)bc::compress(image.data(), width, height, width * 4, format, out.data(), options);
+                },
+                3, 1);
+            fmt::println("   吞吐量: {:.1f} 百万像素/秒\n",
+                static_cast<double>(width) * height * 1e3 / result.median_time_ns);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
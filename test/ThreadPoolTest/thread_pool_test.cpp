@@ -0,0 +1,592 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "../../src/util/thread/job_executor.h"
+#include "../../src/util/thread/parallel_for.h"
+#include "../../src/util/thread/thread_pool.h"
+#include "../../src/util/thread/work_stealing_deque.h"
+#include "fmt/format.h"
+
+using shine::util::JobCounter;
+using shine::util::job::JobRecord;
+using shine::util::ThreadPool;
+using shine::util::WorkStealingDeque;
+namespace job = shine::util::job;
+
+// 统计全局堆分配次数（所有线程）
+std::atomic<u64> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// ============================================================================
+// 对照组：单互斥量队列的线程池（工作窃取之前的实现）
+// ============================================================================
+
+class MutexQueuePool {
+public:
+    explicit MutexQueuePool(u32 numThreads) {
+        for (u32 i = 0; i < numThreads; ++i) {
+            _workers.emplace_back([this] {
+                job::JobExecutor executor;
+                for (;;) {
+                    job::Job task;
+                    {
+                        std::unique_lock<std::mutex> lock(_queueMutex);
+                        _condition.wait(lock, [this] { return _stop || !_tasks.empty(); });
+                        if (_stop && _tasks.empty()) return;
+                        task = std::move(_tasks.front());
+                        _tasks.pop();
+                    }
+                    std::visit(executor, task);
+                    {
+                        std::unique_lock<std::mutex> lock(_queueMutex);
+                        if (--_activeTasks == 0) _finished.notify_all();
+                    }
+                }
+            });
+        }
+    }
+
+    ~MutexQueuePool() {
+        {
+            std::unique_lock<std::mutex> lock(_queueMutex);
+            _stop = true;
+        }
+        _condition.notify_all();
+        for (auto& worker : _workers) worker.join();
+    }
+
+    void Submit(job::Job job) {
+        {
+            std::unique_lock<std::mutex> lock(_queueMutex);
+            _tasks.push(std::move(job));
+            ++_activeTasks;
+        }
+        _condition.notify_one();
+    }
+
+    void WaitAll() {
+        std::unique_lock<std::mutex> lock(_queueMutex);
+        _finished.wait(lock, [this] { return _tasks.empty() && _activeTasks == 0; });
+    }
+
+private:
+    std::vector<std::thread> _workers;
+    std::queue<job::Job> _tasks;
+    std::mutex _queueMutex;
+    std::condition_variable _condition;
+    std::condition_variable _finished;
+    bool _stop = false;
+    u32 _activeTasks = 0;
+};
+
+std::atomic<u64> g_counter{0};
+
+void count_tick(void*, float) {
+    g_counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+// 约 100 ns 的小任务，模拟 TickManager 扇出的单个 tick
+void small_tick(void* userdata, float dt) {
+    float x = dt;
+    for (int i = 0; i < 64; ++i) x = x * 1.0001f + 0.5f;
+    if (x == 0.0f) *static_cast<float*>(userdata) = x;
+    g_counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// Chase-Lev 队列
+// ============================================================================
+
+int test_deque_single_thread() {
+    int failures = 0;
+    WorkStealingDeque<u32> deque(16);
+    for (u32 i = 0; i < 100; ++i) deque.Push(i);  // 触发扩容
+    if (deque.Size() != 100) {
+        ++failures;
+        fmt::println("  FAIL: size {} after 100 pushes", deque.Size());
+    }
+    for (u32 i = 0; i < 10; ++i) {
+        auto stolen = deque.Steal();
+        if (!stolen || *stolen != i) {
+            ++failures;
+            fmt::println("  FAIL: steal {} expected FIFO order", i);
+        }
+    }
+    for (u32 i = 99; i >= 10; --i) {
+        auto popped = deque.Pop();
+        if (!popped || *popped != i) {
+            ++failures;
+            fmt::println("  FAIL: pop expected {} (LIFO)", i);
+            break;
+        }
+    }
+    if (deque.Pop() || deque.Steal() || !deque.Empty()) {
+        ++failures;
+        fmt::println("  FAIL: deque not empty");
+    }
+    return failures;
+}
+
+int test_deque_concurrent() {
+    constexpr u32 kItems = 200000;
+    constexpr u32 kThieves = 3;
+    WorkStealingDeque<u32> deque(64);
+    std::vector<std::atomic<u8>> seen(kItems);
+    std::atomic<bool> done{false};
+    std::atomic<u32> taken{0};
+
+    auto take = [&](u32 value) {
+        seen[value].fetch_add(1, std::memory_order_relaxed);
+        taken.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> thieves;
+    for (u32 t = 0; t < kThieves; ++t) {
+        thieves.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire) || !deque.Empty()) {
+                if (auto value = deque.Steal()) take(*value);
+            }
+        });
+    }
+
+    // 所有者交替压入与弹出，让最后一个元素上的竞争频繁发生
+    for (u32 i = 0; i < kItems; ++i) {
+        deque.Push(i);
+        if (i % 3 == 0) {
+            if (auto value = deque.Pop()) take(*value);
+        }
+    }
+    while (auto value = deque.Pop()) take(*value);
+    done.store(true, std::memory_order_release);
+    for (auto& thief : thieves) thief.join();
+
+    int failures = 0;
+    if (taken.load() != kItems) {
+        ++failures;
+        fmt::println("  FAIL: {} items taken, expected {}", taken.load(), kItems);
+    }
+    for (u32 i = 0; i < kItems; ++i) {
+        if (seen[i].load() != 1) {
+            ++failures;
+            fmt::println("  FAIL: item {} taken {} times", i, seen[i].load());
+            break;
+        }
+    }
+    return failures;
+}
+
+// ============================================================================
+// 线程池
+// ============================================================================
+
+struct FanOut {
+    ThreadPool* pool;
+    u32 children;
+};
+
+void fan_out(void* userdata, float) {
+    auto* fanOut = static_cast<FanOut*>(userdata);
+    for (u32 i = 0; i < fanOut->children; ++i) {
+        fanOut->pool->Submit(job::JobExecuteTick{count_tick, nullptr, 0.0f});
+    }
+}
+
+int test_pool() {
+    int failures = 0;
+    for (u32 threads : { 1u, 2u, 4u }) {
+        ThreadPool pool(threads);
+
+        g_counter = 0;
+        for (u32 i = 0; i < 10000; ++i) pool.Submit(job::JobExecuteTick{count_tick, nullptr, 0.0f});
+        pool.WaitAll();
+        if (g_counter.load() != 10000) {
+            ++failures;
+            fmt::println("  FAIL: {} threads external submit ran {} jobs", threads, g_counter.load());
+        }
+
+        // 工作线程内提交的任务进入本地队列，由其他线程窃取
+        g_counter = 0;
+        FanOut fanOut{&pool, 5000};
+        for (u32 i = 0; i < 4; ++i) pool.Submit(job::JobExecuteTick{fan_out, &fanOut, 0.0f});
+        pool.WaitAll();
+        if (g_counter.load() != 20000) {
+            ++failures;
+            fmt::println("  FAIL: {} threads nested submit ran {} jobs", threads, g_counter.load());
+        }
+    }
+
+    // 析构时排空队列
+    g_counter = 0;
+    for (int round = 0; round < 50; ++round) {
+        ThreadPool pool(3);
+        for (u32 i = 0; i < 100; ++i) pool.Submit(job::JobExecuteTick{count_tick, nullptr, 0.0f});
+    }
+    if (g_counter.load() != 5000) {
+        ++failures;
+        fmt::println("  FAIL: destructor drained {} of 5000 jobs", g_counter.load());
+    }
+    return failures;
+}
+
+// 二叉递归：每个节点派发两个子任务并等待计数器，叶子计数
+struct SplitNode {
+    ThreadPool* pool;
+    u32 depth;
+};
+
+void split_tick(void* userdata, float) {
+    const auto* node = static_cast<const SplitNode*>(userdata);
+    if (node->depth == 0) {
+        g_counter.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    SplitNode children[2] = { { node->pool, node->depth - 1 }, { node->pool, node->depth - 1 } };
+    const job::Job jobs[2] = {
+        job::JobExecuteTick{split_tick, &children[0], 0.0f},
+        job::JobExecuteTick{split_tick, &children[1], 0.0f},
+    };
+    JobCounter counter;
+    node->pool->RunJobs(jobs, &counter);
+    node->pool->WaitForCounter(counter);
+}
+
+int test_counters() {
+    int failures = 0;
+
+    // 单线程池上嵌套等待：阻塞式等待会在这里死锁
+    for (u32 threads : { 1u, 2u, 4u }) {
+        ThreadPool pool(threads);
+        for (u32 depth : { 0u, 1u, 10u }) {
+            g_counter = 0;
+            SplitNode root{&pool, depth};
+            JobCounter counter;
+            pool.Submit(job::JobExecuteTick{split_tick, &root, 0.0f}, &counter);
+            pool.WaitForCounter(counter);
+            if (g_counter.load() != (1ull << depth) || !counter.IsDone()) {
+                ++failures;
+                fmt::println("  FAIL: {} threads depth {} counted {} leaves", threads, depth, g_counter.load());
+            }
+        }
+    }
+
+    // 计数器在栈上反复创建销毁，等待返回后不能再被访问
+    ThreadPool pool(3);
+    g_counter = 0;
+    for (u32 round = 0; round < 2000; ++round) {
+        JobCounter counter;
+        const job::Job jobs[3] = {
+            job::JobExecuteTick{count_tick, nullptr, 0.0f},
+            job::JobExecuteTick{count_tick, nullptr, 0.0f},
+            job::JobExecuteTick{count_tick, nullptr, 0.0f},
+        };
+        pool.RunJobs(jobs, &counter);
+        pool.WaitForCounter(counter);
+        if (g_counter.load() != (round + 1) * 3ull) {
+            ++failures;
+            fmt::println("  FAIL: round {} returned before its jobs finished", round);
+            break;
+        }
+    }
+
+    // 空批次与空队列
+    JobCounter empty;
+    pool.RunJobs({}, &empty);
+    pool.WaitForCounter(empty);
+    pool.WaitAll();
+    if (pool.TryRunOne()) {
+        ++failures;
+        fmt::println("  FAIL: TryRunOne ran a job on an idle pool");
+    }
+    return failures;
+}
+
+// ============================================================================
+// 任务记录
+// ============================================================================
+
+std::atomic<s32> g_live{0};
+
+struct Tracked {
+    Tracked() { g_live.fetch_add(1, std::memory_order_relaxed); }
+    Tracked(const Tracked&) { g_live.fetch_add(1, std::memory_order_relaxed); }
+    Tracked(Tracked&&) noexcept { g_live.fetch_add(1, std::memory_order_relaxed); }
+    ~Tracked() { g_live.fetch_sub(1, std::memory_order_relaxed); }
+};
+
+int test_job_records() {
+    static_assert(sizeof(JobRecord) == 64 && alignof(JobRecord) == 64);
+    static_assert(JobRecord::StoresInline<job::Job>);
+
+    int failures = 0;
+    ThreadPool pool(3);
+
+    // 内联与溢出到堆的捕获都只执行一次、析构一次
+    g_counter = 0;
+    {
+        JobCounter counter;
+        for (u32 i = 0; i < 1000; ++i) {
+            Tracked tracked;
+            pool.Submit([tracked, i] { g_counter.fetch_add(i, std::memory_order_relaxed); }, &counter);
+            std::array<u64, 16> big{};
+            big[15] = i;
+            pool.Submit([tracked, big] { g_counter.fetch_add(big[15], std::memory_order_relaxed); }, &counter);
+        }
+        pool.WaitForCounter(counter);
+    }
+    if (g_counter.load() != 999 * 1000 || g_live.load() != 0) {
+        ++failures;
+        fmt::println("  FAIL: sum {} (expected 999000), {} payloads alive", g_counter.load(), g_live.load());
+    }
+
+    // 稳态下提交小 lambda 与旧的 Job 变体都不分配堆内存
+    auto submitRound = [&](bool fromWorker) {
+        JobCounter counter;
+        if (fromWorker) {
+            pool.Submit([&pool] {
+                JobCounter children;
+                for (u32 i = 0; i < 2000; ++i) pool.Submit([] { count_tick(nullptr, 0.0f); }, &children);
+                pool.WaitForCounter(children);
+            }, &counter);
+        } else {
+            for (u32 i = 0; i < 1000; ++i) {
+                pool.Submit([] { count_tick(nullptr, 0.0f); }, &counter);
+                pool.Submit(job::JobExecuteTick{count_tick, nullptr, 0.0f}, &counter);
+            }
+        }
+        pool.WaitForCounter(counter);
+    };
+    for (bool fromWorker : { false, true }) {
+        for (int warm = 0; warm < 5; ++warm) submitRound(fromWorker);
+        const u64 before = g_allocations.load();
+        for (int round = 0; round < 20; ++round) submitRound(fromWorker);
+        const u64 allocations = g_allocations.load() - before;
+        if (allocations != 0) {
+            ++failures;
+            fmt::println("  FAIL: {} submit made {} heap allocations for 40000 jobs",
+                fromWorker ? "worker" : "external", allocations);
+        }
+    }
+    return failures;
+}
+
+int test_parallel_for() {
+    int failures = 0;
+    ThreadPool pool(4);
+    for (u32 count : { 0u, 1u, 7u, 1000u, 100003u }) {
+        for (u32 grain : { 1u, 16u, 4096u }) {
+            std::vector<std::atomic<u8>> hits(count + 10);
+            shine::util::ParallelFor(5, 5 + count, grain, [&](u32 i) {
+                hits[i].fetch_add(1, std::memory_order_relaxed);
+            }, pool);
+            for (u32 i = 0; i < hits.size(); ++i) {
+                const u8 expected = (i >= 5 && i < 5 + count) ? 1 : 0;
+                if (hits[i].load() != expected) {
+                    ++failures;
+                    fmt::println("  FAIL: count={} grain={} index {} hit {} times", count, grain, i, hits[i].load());
+                    break;
+                }
+            }
+        }
+    }
+
+    // 嵌套：外层块在工作线程上再调用 ParallelFor
+    std::atomic<u32> total{0};
+    shine::util::ParallelFor(0, 64, 1, [&](u32) {
+        shine::util::ParallelForRange(0, 1000, 100, [&](u32 b, u32 e) {
+            total.fetch_add(e - b, std::memory_order_relaxed);
+        }, pool);
+    }, pool);
+    if (total.load() != 64000) {
+        ++failures;
+        fmt::println("  FAIL: nested ParallelFor covered {} of 64000", total.load());
+    }
+    return failures;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试 ===\n");
+    int failures = 0;
+    const std::pair<const char*, int (*)()> cases[] = {
+        { "Chase-Lev 单线程", test_deque_single_thread },
+        { "Chase-Lev 并发窃取", test_deque_concurrent },
+        { "线程池提交与等待", test_pool },
+        { "任务计数器嵌套等待", test_counters },
+        { "任务记录与零分配提交", test_job_records },
+        { "ParallelFor", test_parallel_for },
+    };
+    for (const auto& [name, fn] : cases) {
+        const int caseFailures = fn();
+        fmt::println("{}: {}", name, caseFailures == 0 ? "PASS" : "FAIL");
+        failures += caseFailures;
+    }
+
+    fmt::println("");
+    return failures;
+}
+
+// ============================================================================
+// 性能：每秒完成的任务数随线程数的变化
+// ============================================================================
+
+template <typename Fn>
+double jobs_per_second(u64 jobs, Fn&& run) {
+    double best = 0.0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        g_counter = 0;
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (g_counter.load() != jobs) fmt::println("  WARN: ran {} of {} jobs", g_counter.load(), jobs);
+        best = std::max(best, jobs / seconds);
+    }
+    return best;
+}
+
+constexpr u32 kBenchJobs = 200000;
+constexpr u32 kFanOut = 1000;
+constexpr u32 kSplitDepth = 14;  // 16384 个叶子，约 3 万个任务
+float g_sink = 0.0f;
+
+template <typename Pool>
+void spawn_children(void* userdata, float) {
+    auto* pool = static_cast<Pool*>(userdata);
+    for (u32 c = 0; c < kFanOut; ++c) pool->Submit(job::JobExecuteTick{small_tick, &g_sink, 1.0f});
+}
+
+struct PoolThroughput {
+    double external;  // 主线程逐个提交
+    double fanOut;    // 根任务在工作线程上扇出子任务
+};
+
+template <typename Pool>
+PoolThroughput measure_pool(u32 threads) {
+    Pool pool(threads);
+    PoolThroughput result;
+    result.external = jobs_per_second(kBenchJobs, [&] {
+        for (u32 i = 0; i < kBenchJobs; ++i) pool.Submit(job::JobExecuteTick{small_tick, &g_sink, 1.0f});
+        pool.WaitAll();
+    });
+    result.fanOut = jobs_per_second(kBenchJobs, [&] {
+        for (u32 i = 0; i < kBenchJobs / kFanOut; ++i) {
+            pool.Submit(job::JobExecuteTick{spawn_children<Pool>, &pool, 1.0f});
+        }
+        pool.WaitAll();
+    });
+    return result;
+}
+
+void benchmark() {
+    const u32 maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    fmt::println("=== 性能测试（{} 个小任务，硬件线程 {}） ===\n", kBenchJobs, maxThreads);
+
+    std::vector<u32> threadCounts;
+    for (u32 n = 1; n < maxThreads; n *= 2) threadCounts.push_back(n);
+    threadCounts.push_back(maxThreads);
+
+    fmt::println("{:>4} | {:>10} {:>10} | {:>10} {:>10} | {:>11} | {:>11}", "线程", "互斥/外部", "窃取/外部",
+        "互斥/扇出", "窃取/扇出", "ParallelFor", "递归等待");
+    for (u32 threads : threadCounts) {
+        const PoolThroughput legacy = measure_pool<MutexQueuePool>(threads);
+        const PoolThroughput stealing = measure_pool<ThreadPool>(threads);
+
+        ThreadPool pool(threads);
+        const double parallelFor = jobs_per_second(kBenchJobs, [&] {
+            shine::util::ParallelFor(0, kBenchJobs, 256, [](u32) { small_tick(&g_sink, 1.0f); }, pool);
+        });
+
+        // 每个内部节点都在工作线程上等待两个子任务
+        const double split = jobs_per_second(1ull << kSplitDepth, [&] {
+            SplitNode root{&pool, kSplitDepth};
+            JobCounter counter;
+            pool.Submit(job::JobExecuteTick{split_tick, &root, 0.0f}, &counter);
+            pool.WaitForCounter(counter);
+        });
+
+        fmt::println("{:>4} | {:>9.2f}M {:>9.2f}M | {:>9.2f}M {:>9.2f}M | {:>10.2f}M | {:>10.2f}M", threads,
+            legacy.external / 1e6, stealing.external / 1e6, legacy.fanOut / 1e6, stealing.fanOut / 1e6,
+            parallelFor / 1e6, split / 1e6);
+    }
+    fmt::println("\n（单位：百万任务/秒；扇出为每个根任务 {} 个子任务；ParallelFor 每块 256 个索引；"
+        "递归等待为深度 {} 的二叉任务树，按叶子计）\n", kFanOut, kSplitDepth);
+}
+
+// 同一线程池上不同提交方式的吞吐与每任务堆分配次数
+template <typename Submit>
+void measure_submit(const char* name, Submit&& submit) {
+    u64 allocations = 0;
+    const double rate = jobs_per_second(kBenchJobs, [&] {
+        const u64 before = g_allocations.load();
+        submit();
+        allocations = g_allocations.load() - before;
+    });
+    fmt::println("{:<22} | {:>9.2f}M | {:>8.3f}", name, rate / 1e6, static_cast<double>(allocations) / kBenchJobs);
+}
+
+void benchmark_records() {
+    const u32 threads = std::max(1u, std::thread::hardware_concurrency());
+    fmt::println("=== 任务记录（{} 个外部提交的小任务，{} 线程） ===\n", kBenchJobs, threads);
+    fmt::println("{:<22} | {:>10} | {:>8}", "提交方式", "任务/秒", "分配/任务");
+
+    {
+        MutexQueuePool legacy(threads);
+        measure_submit("互斥队列 + Job 变体", [&] {
+            for (u32 i = 0; i < kBenchJobs; ++i) legacy.Submit(job::JobExecuteTick{small_tick, &g_sink, 1.0f});
+            legacy.WaitAll();
+        });
+    }
+
+    ThreadPool pool(threads);
+    measure_submit("窃取 + Job 变体", [&] {
+        JobCounter counter;
+        for (u32 i = 0; i < kBenchJobs; ++i) pool.Submit(job::JobExecuteTick{small_tick, &g_sink, 1.0f}, &counter);
+        pool.WaitForCounter(counter);
+    });
+    measure_submit("窃取 + 内联 lambda", [&] {
+        JobCounter counter;
+        float* sink = &g_sink;
+        for (u32 i = 0; i < kBenchJobs; ++i) pool.Submit([sink] { small_tick(sink, 1.0f); }, &counter);
+        pool.WaitForCounter(counter);
+    });
+    measure_submit("窃取 + 128 字节捕获", [&] {
+        JobCounter counter;
+        std::array<float, 32> payload{};
+        for (u32 i = 0; i < kBenchJobs; ++i) pool.Submit([payload] { small_tick(nullptr, payload[0] + 1.0f); }, &counter);
+        pool.WaitForCounter(counter);
+    });
+    fmt::println("\n（超过 {} 字节的捕获溢出到堆上）\n", JobRecord::kInlineSize);
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+    benchmark_records();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
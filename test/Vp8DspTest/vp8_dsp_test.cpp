@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../../src/image/vp8_dsp.h"
+#include "../SimplePerfTest/benchmark_framework.h"
+#include "fmt/format.h"
+
+using shine::image::vp8_dsp::DspBackend;
+using shine::image::vp8_dsp::DspKernels;
+namespace vp8_dsp = shine::image::vp8_dsp;
+
+namespace {
+
+constexpr DspBackend kSimdBackends[] = {
+    DspBackend::SSE2,
+};
+
+/**
+ * @brief 随机 4x4 块系数
+ * @param kind 0 = 典型（低频为主），1 = 只有 DC，2 = 全范围随机（畸形数据）
+ */
+void fill_coefficients(std::vector<int16_t>& coefficients, int kind, std::mt19937& rng) {
+    for (size_t i = 0; i < coefficients.size(); ++i) {
+        const size_t k = i % 16;
+        switch (kind) {
+        case 0: {
+            const int range = k == 0 ? 2048 : static_cast<int>(512 / (1 + k));
+            coefficients[i] = (rng() % 2 == 0 || k == 0) ? static_cast<int16_t>(static_cast<int>(rng() % range) - range / 2) : 0;
+            break;
+        }
+        case 1: coefficients[i] = k == 0 ? static_cast<int16_t>(static_cast<int>(rng() % 4096) - 2048) : 0; break;
+        default: coefficients[i] = static_cast<int16_t>(rng()); break;
+        }
+    }
+}
+
+/**
+ * @brief 带边缘的随机像素：大部分区域平滑，使滤波器的各个分支都能被触发
+ */
+void fill_pixels(std::vector<uint8_t>& pixels, std::mt19937& rng) {
+    int value = static_cast<int>(rng() % 256);
+    for (auto& p : pixels) {
+        const uint32_t r = rng() % 16;
+        if (r == 0) {
+            value = static_cast<int>(rng() % 256);
+        } else if (r < 8) {
+            value = std::clamp(value + static_cast<int>(rng() % 9) - 4, 0, 255);
+        }
+        p = static_cast<uint8_t>(value);
+    }
+}
+
+int compare_transform(DspBackend backend, std::mt19937& rng) {
+    const DspKernels& expected = vp8_dsp::kernels(DspBackend::Scalar);
+    const DspKernels& actual = vp8_dsp::kernels(backend);
+
+    int failures = 0;
+    for (int kind = 0; kind < 3; ++kind) {
+        for (size_t blockCount : { 1, 2 }) {
+            for (int iteration = 0; iteration < 200; ++iteration) {
+                std::vector<int16_t> coefficients(blockCount * 16);
+                fill_coefficients(coefficients, kind, rng);
+
+                // 变换叠加到预测值上，跨度大于块宽度以检查右边界
+                constexpr ptrdiff_t stride = 13;
+                std::vector<uint8_t> prediction(stride * 4);
+                for (auto& v : prediction) v = static_cast<uint8_t>(rng());
+                std::vector<uint8_t> lhs = prediction, rhs = prediction;
+                expected.inverseTransform(coefficients.data(), lhs.data(), stride, blockCount);
+                actual.inverseTransform(coefficients.data(), rhs.data(), stride, blockCount);
+
+                if (lhs != rhs) {
+                    ++failures;
+                    fmt::println("  FAIL: {} transform kind={} blocks={}", vp8_dsp::backendName(backend), kind, blockCount);
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+int compare_filters(DspBackend backend, std::mt19937& rng) {
+    const DspKernels& expected = vp8_dsp::kernels(DspBackend::Scalar);
+    const DspKernels& actual = vp8_dsp::kernels(backend);
+
+    // 一个宏块加四周的 8 像素边，p 指向宏块左上角
+    constexpr ptrdiff_t stride = 40;
+    constexpr ptrdiff_t origin = 8 * stride + 8;
+    const auto simpleFilters = {
+        &DspKernels::simpleV16, &DspKernels::simpleH16, &DspKernels::simpleV16Inner, &DspKernels::simpleH16Inner,
+    };
+    const auto complexFilters = {
+        &DspKernels::v16, &DspKernels::h16, &DspKernels::v16Inner, &DspKernels::h16Inner,
+    };
+    const auto chromaFilters = {
+        &DspKernels::v8, &DspKernels::h8, &DspKernels::v8Inner, &DspKernels::h8Inner,
+    };
+
+    int failures = 0;
+    for (int iteration = 0; iteration < 300; ++iteration) {
+        std::vector<uint8_t> source(stride * 32);
+        fill_pixels(source, rng);
+        const int level = static_cast<int>(rng() % 64);
+        const int ilevel = 1 + static_cast<int>(rng() % 63);
+        const int thresh = 2 * level + ilevel + static_cast<int>(rng() % 5);
+        const int hevThresh = static_cast<int>(rng() % 3);
+
+        int index = 0;
+        for (auto filter : simpleFilters) {
+            std::vector<uint8_t> lhs = source, rhs = source;
+            (expected.*filter)(lhs.data() + origin, stride, thresh);
+            (actual.*filter)(rhs.data() + origin, stride, thresh);
+            if (lhs != rhs) {
+                ++failures;
+                fmt::println("  FAIL: {} simple filter #{} thresh={}", vp8_dsp::backendName(backend), index, thresh);
+            }
+            ++index;
+        }
+
+        index = 0;
+        for (auto filter : complexFilters) {
+            std::vector<uint8_t> lhs = source, rhs = source;
+            (expected.*filter)(lhs.data() + origin, stride, thresh, ilevel, hevThresh);
+            (actual.*filter)(rhs.data() + origin, stride, thresh, ilevel, hevThresh);
+            if (lhs != rhs) {
+                ++failures;
+                fmt::println("  FAIL: {} luma filter #{} thresh={} ilevel={} hev={}",
+                    vp8_dsp::backendName(backend), index, thresh, ilevel, hevThresh);
+            }
+            ++index;
+        }
+
+        // U、V 放在同一缓冲的左右两半
+        index = 0;
+        for (auto filter : chromaFilters) {
+            std::vector<uint8_t> lhs = source, rhs = source;
+            (expected.*filter)(lhs.data() + origin, lhs.data() + origin + 16, stride, thresh, ilevel, hevThresh);
+            (actual.*filter)(rhs.data() + origin, rhs.data() + origin + 16, stride, thresh, ilevel, hevThresh);
+            if (lhs != rhs) {
+                ++failures;
+                fmt::println("  FAIL: {} chroma filter #{} thresh={} ilevel={} hev={}",
+                    vp8_dsp::backendName(backend), index, thresh, ilevel, hevThresh);
+            }
+            ++index;
+        }
+    }
+    return failures;
+}
+
+int compare_conversion(DspBackend backend, std::mt19937& rng) {
+    constexpr size_t widths[] = { 1, 2, 3, 7, 8, 15, 16, 17, 18, 31, 32, 33, 34, 63, 64, 65, 1023 };
+    const DspKernels& expected = vp8_dsp::kernels(DspBackend::Scalar);
+    const DspKernels& actual = vp8_dsp::kernels(backend);
+
+    int failures = 0;
+    for (size_t width : widths) {
+        const size_t chromaWidth = (width + 1) / 2;
+        std::vector<uint8_t> nearRow(chromaWidth), farRow(chromaWidth), y(width);
+        for (auto& v : nearRow) v = static_cast<uint8_t>(rng());
+        for (auto& v : farRow) v = static_cast<uint8_t>(rng());
+        for (auto& v : y) v = static_cast<uint8_t>(rng());
+
+        // 输出多留一个像素，检查内核不会越界写入
+        std::vector<uint8_t> lhs(width + 1, 0xCD), rhs(width + 1, 0xCD);
+        expected.upsampleRow(nearRow.data(), farRow.data(), lhs.data(), width);
+        actual.upsampleRow(nearRow.data(), farRow.data(), rhs.data(), width);
+        if (lhs != rhs) {
+            ++failures;
+            fmt::println("  FAIL: {} upsample width={}", vp8_dsp::backendName(backend), width);
+        }
+
+        std::vector<uint8_t> u(width), v(width);
+        for (auto& c : u) c = static_cast<uint8_t>(rng());
+        for (auto& c : v) c = static_cast<uint8_t>(rng());
+        std::vector<uint8_t> rgbaLhs(width * 4 + 4, 0xCD), rgbaRhs(width * 4 + 4, 0xCD);
+        expected.yuvToRgbaRow(y.data(), u.data(), v.data(), rgbaLhs.data(), width);
+        actual.yuvToRgbaRow(y.data(), u.data(), v.data(), rgbaRhs.data(), width);
+        if (rgbaLhs != rgbaRhs) {
+            ++failures;
+            fmt::println("  FAIL: {} YUV -> RGBA width={}", vp8_dsp::backendName(backend), width);
+        }
+    }
+    return failures;
+}
+
+/**
+ * @brief 标量实现的自洽性：只有 DC 的块用完整变换与 DC 快速路径结果相同，WHT 的直流分量均分到 16 个块
+ */
+int test_reference() {
+    const DspKernels& scalar = vp8_dsp::kernels(DspBackend::Scalar);
+
+    int failures = 0;
+    std::mt19937 rng(11);
+    for (int iteration = 0; iteration < 1000; ++iteration) {
+        int16_t coefficients[16] = {};
+        coefficients[0] = static_cast<int16_t>(static_cast<int>(rng() % 4096) - 2048);
+        uint8_t full[4 * 4], dc[4 * 4];
+        for (int i = 0; i < 16; ++i) full[i] = dc[i] = static_cast<uint8_t>(rng());
+        scalar.inverseTransform(coefficients, full, 4, 1);
+        vp8_dsp::inverseTransformDC(coefficients, dc, 4);
+        if (!std::equal(full, full + 16, dc)) {
+            ++failures;
+        }
+
+        int16_t y2[16] = {};
+        y2[0] = static_cast<int16_t>(static_cast<int>(rng() % 4096) - 2048);
+        int16_t out[16 * 16] = {};
+        vp8_dsp::inverseWalshHadamard(y2, out);
+        for (int i = 0; i < 16; ++i) {
+            if (out[i * 16] != ((y2[0] + 3) >> 3)) {
+                ++failures;
+                break;
+            }
+        }
+    }
+
+    fmt::println("标量实现自洽性: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试（与标量实现逐字节对比） ===\n");
+    fmt::println("当前内核: {}", vp8_dsp::backendName(vp8_dsp::activeBackend()));
+
+    int failures = test_reference();
+
+    std::mt19937 rng(20240601);
+    for (DspBackend backend : kSimdBackends) {
+        if (!vp8_dsp::isBackendSupported(backend)) {
+            fmt::println("{}: SKIP（当前 CPU 不支持）", vp8_dsp::backendName(backend));
+            continue;
+        }
+        const int backendFailures = compare_transform(backend, rng) + compare_filters(backend, rng) +
+            compare_conversion(backend, rng);
+        fmt::println("{}: {}", vp8_dsp::backendName(backend), backendFailures == 0 ? "PASS" : "FAIL");
+        failures += backendFailures;
+    }
+
+    fmt::println("");
+    return failures;
+}
+
+void benchmark() {
+    // 1920x1088：120x68 个宏块
+    constexpr size_t mbW = 120;
+    constexpr size_t mbH = 68;
+    constexpr size_t width = mbW * 16;
+    constexpr size_t height = mbH * 16;
+    fmt::println("=== 性能测试（{}x{}，逆变换 + 复杂环路滤波 + 颜色转换） ===\n", width, height);
+
+    std::mt19937 rng(7);
+    std::vector<int16_t> coefficients(mbW * 16 * 16);
+    fill_coefficients(coefficients, 0, rng);
+    std::vector<uint8_t> luma(width * height), chroma(width / 2 * height / 2);
+    fill_pixels(luma, rng);
+    fill_pixels(chroma, rng);
+    std::vector<uint8_t> u(width), v(width);
+    std::vector<uint8_t> rgba(width * height * 4);
+
+    for (DspBackend backend : { DspBackend::Scalar, DspBackend::SSE2 }) {
+        if (!vp8_dsp::isBackendSupported(backend)) {
+            continue;
+        }
+        const DspKernels& k = vp8_dsp::kernels(backend);
+
+        const auto transform = shine::benchmark::run_benchmark(
+            fmt::format("逆变换 / {}", vp8_dsp::backendName(backend)),
+            [&] {
+                for (size_t y = 0; y < height; y += 4) {
+                    for (size_t x = 0; x < width; x += 8) {
+                        k.inverseTransform(coefficients.data() + (x / 4 % 256) * 16, luma.data() + y * width + x, width, 2);
+                    }
+                }
+            },
+            20, 3);
+        fmt::println("   吞吐量: {:.1f} 百万块/秒\n", static_cast<double>(width * height / 16) * 1e3 / transform.median_time_ns);
+
+        const auto filter = shine::benchmark::run_benchmark(
+            fmt::format("环路滤波 / {}", vp8_dsp::backendName(backend)),
+            [&] {
+                for (size_t mbY = 1; mbY < mbH; ++mbY) {
+                    for (size_t mbX = 1; mbX < mbW; ++mbX) {
+                        uint8_t* p = luma.data() + mbY * 16 * width + mbX * 16;
+                        k.h16(p, width, 40, 10, 1);
+                        k.h16Inner(p, width, 36, 10, 1);
+                        k.v16(p, width, 40, 10, 1);
+                        k.v16Inner(p, width, 36, 10, 1);
+                    }
+                }
+            },
+            20, 3);
+        fmt::println("   吞吐量: {:.1f} 百万宏块/秒\n", static_cast<double>(mbW * mbH) * 1e3 / filter.median_time_ns);
+
+        const auto color = shine::benchmark::run_benchmark(
+            fmt::format("上采样 + YUV -> RGBA / {}", vp8_dsp::backendName(backend)),
+            [&] {
+                for (size_t y = 0; y < height; ++y) {
+                    const uint8_t* nearRow = chroma.data() + (y / 2) * (width / 2);
+                    const uint8_t* farRow = chroma.data() + (y > 0 ? (y - 1) / 2 : 0) * (width / 2);
+                    k.upsampleRow(nearRow, farRow, u.data(), width);
+                    k.upsampleRow(farRow, nearRow, v.data(), width);
+                    k.yuvToRgbaRow(luma.data() + y * width, u.data(), v.data(), rgba.data() + y * width * 4, width);
+                }
+            },
+            20, 3);
+        fmt::println("   吞吐量: {:.1f} 百万像素/秒\n", static_cast<double>(width * height) * 1e3 / color.median_time_ns);
+    }
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
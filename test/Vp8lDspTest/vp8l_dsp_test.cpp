@@ -0,0 +1,315 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "../../src/image/vp8l_dsp.h"
+#include "../SimplePerfTest/benchmark_framework.h"
+#include "fmt/format.h"
+
+using shine::image::vp8l_dsp::ColorMultipliers;
+using shine::image::vp8l_dsp::DspBackend;
+using shine::image::vp8l_dsp::DspKernels;
+namespace vp8l_dsp = shine::image::vp8l_dsp;
+
+namespace {
+
+constexpr DspBackend kSimdBackends[] = {
+    DspBackend::SSE2,
+};
+
+/**
+ * @brief 随机 ARGB 像素
+ * @param smooth 为 true 时相邻像素相近（典型的预测残差与输出），否则全范围随机
+ */
+void fill_argb(std::vector<uint32_t>& pixels, bool smooth, std::mt19937& rng) {
+    uint32_t value = rng();
+    for (auto& p : pixels) {
+        if (!smooth || rng() % 8 == 0) {
+            value = rng();
+        } else {
+            value ^= rng() & 0x03030303u;
+        }
+        p = value;
+    }
+}
+
+// ============================================================================
+// 按规范逐通道书写的参考预测器（与内核实现相互独立）
+// ============================================================================
+
+int channel(uint32_t pixel, int index) {
+    return static_cast<int>((pixel >> (index * 8)) & 0xff);
+}
+
+uint32_t from_channels(const int* c) {
+    return static_cast<uint32_t>(c[0]) | (static_cast<uint32_t>(c[1]) << 8) |
+        (static_cast<uint32_t>(c[2]) << 16) | (static_cast<uint32_t>(c[3]) << 24);
+}
+
+uint32_t average(uint32_t a, uint32_t b) {
+    int c[4];
+    for (int i = 0; i < 4; ++i) c[i] = (channel(a, i) + channel(b, i)) / 2;
+    return from_channels(c);
+}
+
+uint32_t reference_predict(int mode, uint32_t l, uint32_t tl, uint32_t t, uint32_t tr) {
+    int c[4];
+    switch (mode) {
+    case 0: return 0xff000000u;
+    case 1: return l;
+    case 2: return t;
+    case 3: return tr;
+    case 4: return tl;
+    case 5: return average(average(l, tr), t);
+    case 6: return average(l, tl);
+    case 7: return average(l, t);
+    case 8: return average(tl, t);
+    case 9: return average(t, tr);
+    case 10: return average(average(l, tl), average(t, tr));
+    case 11: {
+        int pl = 0, pt = 0;
+        for (int i = 0; i < 4; ++i) {
+            pl += std::abs(channel(t, i) - channel(tl, i));   // 与左侧的预测误差
+            pt += std::abs(channel(l, i) - channel(tl, i));   // 与上方的预测误差
+        }
+        return pl < pt ? l : t;
+    }
+    case 12:
+        for (int i = 0; i < 4; ++i) c[i] = std::clamp(channel(l, i) + channel(t, i) - channel(tl, i), 0, 255);
+        return from_channels(c);
+    default: {
+        const uint32_t a = average(l, t);
+        for (int i = 0; i < 4; ++i) c[i] = std::clamp(channel(a, i) + (channel(a, i) - channel(tl, i)) / 2, 0, 255);
+        return from_channels(c);
+    }
+    }
+}
+
+uint32_t add_channels(uint32_t a, uint32_t b) {
+    int c[4];
+    for (int i = 0; i < 4; ++i) c[i] = (channel(a, i) + channel(b, i)) & 0xff;
+    return from_channels(c);
+}
+
+/**
+ * @brief 标量内核与规范参考实现一致：覆盖 14 种预测模式、颜色逆变换、减绿与 RGBA 转换
+ */
+int test_reference() {
+    const DspKernels& scalar = vp8l_dsp::kernels(DspBackend::Scalar);
+
+    int failures = 0;
+    std::mt19937 rng(11);
+    constexpr size_t width = 37;
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        // upper 与输出行连续：最后一列的右上像素是当前行的首像素
+        std::vector<uint32_t> rows(width * 2), in(width);
+        fill_argb(rows, iteration % 2 == 0, rng);
+        fill_argb(in, iteration % 2 == 0, rng);
+        const uint32_t* upper = rows.data();
+        uint32_t* out = rows.data() + width;
+
+        for (int mode = 0; mode < vp8l_dsp::kNumPredictorModes; ++mode) {
+            scalar.predictorAdd[mode](in.data() + 1, upper + 1, width - 1, out + 1);
+            for (size_t x = 1; x < width; ++x) {
+                const uint32_t tr = x + 1 < width ? upper[x + 1] : out[0];
+                const uint32_t pred = reference_predict(mode, out[x - 1], upper[x - 1], upper[x], tr);
+                if (out[x] != add_channels(in[x], pred)) {
+                    ++failures;
+                    fmt::println("  FAIL: 预测模式 {} x={}", mode, x);
+                    break;
+                }
+            }
+        }
+
+        ColorMultipliers m;
+        m.greenToRed = static_cast<uint8_t>(rng());
+        m.greenToBlue = static_cast<uint8_t>(rng());
+        m.redToBlue = static_cast<uint8_t>(rng());
+        std::vector<uint32_t> color = in;
+        scalar.transformColorInverse(m, color.data(), color.size());
+        std::vector<uint32_t> green = in;
+        scalar.addGreenToBlueAndRed(green.data(), green.size());
+        std::vector<uint8_t> rgba(width * 4);
+        scalar.argbToRgba(in.data(), width, rgba.data());
+        for (size_t x = 0; x < width; ++x) {
+            const int8_t g = static_cast<int8_t>(channel(in[x], 1));
+            const int r = (channel(in[x], 2) + ((static_cast<int8_t>(m.greenToRed) * g) >> 5)) & 0xff;
+            const int b = (channel(in[x], 0) + ((static_cast<int8_t>(m.greenToBlue) * g) >> 5) +
+                ((static_cast<int8_t>(m.redToBlue) * static_cast<int8_t>(r)) >> 5)) & 0xff;
+            if (channel(color[x], 2) != r || channel(color[x], 0) != b || (color[x] & 0xff00ff00u) != (in[x] & 0xff00ff00u)) {
+                ++failures;
+                fmt::println("  FAIL: 颜色逆变换 x={}", x);
+            }
+            if (channel(green[x], 2) != ((channel(in[x], 2) + channel(in[x], 1)) & 0xff) ||
+                channel(green[x], 0) != ((channel(in[x], 0) + channel(in[x], 1)) & 0xff)) {
+                ++failures;
+                fmt::println("  FAIL: 减绿逆变换 x={}", x);
+            }
+            if (rgba[x * 4] != channel(in[x], 2) || rgba[x * 4 + 1] != channel(in[x], 1) ||
+                rgba[x * 4 + 2] != channel(in[x], 0) || rgba[x * 4 + 3] != channel(in[x], 3)) {
+                ++failures;
+                fmt::println("  FAIL: ARGB -> RGBA x={}", x);
+            }
+        }
+    }
+
+    fmt::println("标量实现与规范一致: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+int compare_predictors(DspBackend backend, std::mt19937& rng) {
+    constexpr size_t widths[] = { 1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 31, 64, 255 };
+    const DspKernels& expected = vp8l_dsp::kernels(DspBackend::Scalar);
+    const DspKernels& actual = vp8l_dsp::kernels(backend);
+
+    int failures = 0;
+    for (size_t width : widths) {
+        for (int iteration = 0; iteration < 40; ++iteration) {
+            // 从第 start 列开始预测，与解码器按预测块分段调用一致
+            const size_t start = width > 1 ? 1 + rng() % (width - 1) : 0;
+            std::vector<uint32_t> rows(width * 2 + 1), in(width);
+            fill_argb(rows, iteration % 2 == 0, rng);
+            fill_argb(in, iteration % 2 == 0, rng);
+
+            for (int mode = 0; mode < vp8l_dsp::kNumPredictorModes; ++mode) {
+                std::vector<uint32_t> lhs = rows, rhs = rows;
+                const size_t count = width - start;
+                expected.predictorAdd[mode](in.data() + start, lhs.data() + 1 + start, count, lhs.data() + 1 + width + start);
+                actual.predictorAdd[mode](in.data() + start, rhs.data() + 1 + start, count, rhs.data() + 1 + width + start);
+                if (lhs != rhs) {
+                    ++failures;
+                    fmt::println("  FAIL: {} 预测模式 {} width={} start={}", vp8l_dsp::backendName(backend), mode, width, start);
+                }
+            }
+        }
+    }
+    return failures;
+}
+
+int compare_transforms(DspBackend backend, std::mt19937& rng) {
+    constexpr size_t widths[] = { 1, 3, 4, 5, 8, 15, 16, 17, 63, 1023 };
+    const DspKernels& expected = vp8l_dsp::kernels(DspBackend::Scalar);
+    const DspKernels& actual = vp8l_dsp::kernels(backend);
+
+    int failures = 0;
+    for (size_t width : widths) {
+        for (int iteration = 0; iteration < 20; ++iteration) {
+            std::vector<uint32_t> source(width);
+            fill_argb(source, false, rng);
+
+            ColorMultipliers m;
+            m.greenToRed = static_cast<uint8_t>(rng());
+            m.greenToBlue = static_cast<uint8_t>(rng());
+            m.redToBlue = static_cast<uint8_t>(rng());
+            std::vector<uint32_t> lhs = source, rhs = source;
+            expected.transformColorInverse(m, lhs.data(), width);
+            actual.transformColorInverse(m, rhs.data(), width);
+            if (lhs != rhs) {
+                ++failures;
+                fmt::println("  FAIL: {} 颜色逆变换 width={}", vp8l_dsp::backendName(backend), width);
+            }
+
+            lhs = source;
+            rhs = source;
+            expected.addGreenToBlueAndRed(lhs.data(), width);
+            actual.addGreenToBlueAndRed(rhs.data(), width);
+            if (lhs != rhs) {
+                ++failures;
+                fmt::println("  FAIL: {} 减绿逆变换 width={}", vp8l_dsp::backendName(backend), width);
+            }
+
+            // 输出多留一个像素，检查内核不会越界写入
+            std::vector<uint8_t> rgbaLhs(width * 4 + 4, 0xCD), rgbaRhs(width * 4 + 4, 0xCD);
+            expected.argbToRgba(source.data(), width, rgbaLhs.data());
+            actual.argbToRgba(source.data(), width, rgbaRhs.data());
+            if (rgbaLhs != rgbaRhs) {
+                ++failures;
+                fmt::println("  FAIL: {} ARGB -> RGBA width={}", vp8l_dsp::backendName(backend), width);
+            }
+        }
+    }
+    return failures;
+}
+
+int test_correctness() {
+    fmt::println("=== 正确性测试（与标量实现逐字节对比） ===\n");
+    fmt::println("当前内核: {}", vp8l_dsp::backendName(vp8l_dsp::activeBackend()));
+
+    int failures = test_reference();
+
+    std::mt19937 rng(20240601);
+    for (DspBackend backend : kSimdBackends) {
+        if (!vp8l_dsp::isBackendSupported(backend)) {
+            fmt::println("{}: SKIP（当前 CPU 不支持）", vp8l_dsp::backendName(backend));
+            continue;
+        }
+        const int backendFailures = compare_predictors(backend, rng) + compare_transforms(backend, rng);
+        fmt::println("{}: {}", vp8l_dsp::backendName(backend), backendFailures == 0 ? "PASS" : "FAIL");
+        failures += backendFailures;
+    }
+
+    fmt::println("");
+    return failures;
+}
+
+void benchmark() {
+    constexpr size_t width = 1920;
+    constexpr size_t height = 1080;
+    fmt::println("=== 性能测试（{}x{}，预测 + 颜色逆变换 + 减绿 + RGBA 转换，逐行） ===\n", width, height);
+
+    std::mt19937 rng(7);
+    std::vector<uint32_t> residuals(width * height);
+    fill_argb(residuals, true, rng);
+    std::vector<uint32_t> rows(width * 2);
+    std::vector<uint8_t> rgba(width * 4);
+    ColorMultipliers m;
+    m.greenToRed = 0x12;
+    m.greenToBlue = 0xe3;
+    m.redToBlue = 0x07;
+
+    for (DspBackend backend : { DspBackend::Scalar, DspBackend::SSE2 }) {
+        if (!vp8l_dsp::isBackendSupported(backend)) {
+            continue;
+        }
+        const DspKernels& k = vp8l_dsp::kernels(backend);
+
+        const auto result = shine::benchmark::run_benchmark(
+            fmt::format("逐行逆变换 / {}", vp8l_dsp::backendName(backend)),
+            [&] {
+                for (size_t y = 1; y < height; ++y) {
+                    uint32_t* upper = rows.data();
+                    uint32_t* out = upper + width;
+                    const uint32_t* in = residuals.data() + y * width;
+                    k.predictorAdd[2](in, upper, 1, out);
+                    // 按 16 像素的预测块轮换模式
+                    for (size_t x = 1; x < width;) {
+                        const size_t end = std::min<size_t>((x / 16 + 1) * 16, width);
+                        k.predictorAdd[(x / 16) % vp8l_dsp::kNumPredictorModes](in + x, upper + x, end - x, out + x);
+                        x = end;
+                    }
+                    k.transformColorInverse(m, out, width);
+                    k.addGreenToBlueAndRed(out, width);
+                    k.argbToRgba(out, width, rgba.data());
+                    std::copy(out, out + width, upper);
+                }
+            },
+            20, 3);
+        fmt::println("   吞吐量: {:.1f} 百万像素/秒\n", static_cast<double>(width * height) * 1e3 / result.median_time_ns);
+    }
+}
+
+} // namespace
+
+int main() {
+    const int failures = test_correctness();
+    benchmark();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}
@@ -0,0 +1,326 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../../src/image/webp.h"
+#include "fmt/format.h"
+
+namespace {
+
+// 24x16 有损 WebP（libwebp 质量 60），期望值为 libwebp WebPDecodeRGBA 输出的 FNV-1a 哈希。
+constexpr uint8_t kLossyWebp[] = {
+    0x52, 0x49, 0x46, 0x46, 0x84, 0x00, 0x00, 0x00, 0x57, 0x45, 0x42, 0x50, 0x56, 0x50, 0x38, 0x20,
+    0x78, 0x00, 0x00, 0x00, 0xD0, 0x03, 0x00, 0x9D, 0x01, 0x2A, 0x18, 0x00, 0x10, 0x00, 0x3E, 0xB5,
+    0x4C, 0x9E, 0x49, 0xA7, 0x24, 0xA2, 0xA1, 0x30, 0x08, 0x00, 0xE0, 0x16, 0x89, 0x6C, 0x00, 0x9D,
+    0x32, 0x84, 0x70, 0x37, 0x80, 0x01, 0x2E, 0x05, 0xC1, 0xB1, 0x80, 0x00, 0xFE, 0xFE, 0xBF, 0x75,
+    0x18, 0xD8, 0x99, 0xC7, 0x1B, 0x0B, 0x19, 0x16, 0x84, 0xC0, 0xF2, 0xDE, 0x3A, 0x62, 0xF6, 0x7E,
+    0x3B, 0x58, 0xB1, 0x4C, 0x21, 0x67, 0x62, 0x37, 0x47, 0xD0, 0x6F, 0xDF, 0x9F, 0x73, 0xAE, 0xFC,
+    0xA5, 0xFF, 0xDA, 0x5F, 0xCE, 0x2B, 0xBD, 0x15, 0x11, 0xDF, 0xEE, 0xED, 0x22, 0xBC, 0xF5, 0x09,
+    0xC8, 0xB6, 0xC7, 0x17, 0xBD, 0xAF, 0x07, 0xB7, 0xEB, 0x5B, 0x24, 0x1C, 0x8E, 0x9B, 0x5F, 0xD7,
+    0x86, 0xBF, 0xD4, 0x3A, 0x5E, 0xA9, 0xAD, 0x2F, 0x1E, 0x12, 0x40, 0x00,
+};
+
+// 24x16、6 帧的有损动画（libwebp WebPAnimEncoder），包含子区域帧、混合 / 覆盖两种方式和半透明帧。
+// ALPH 块改写为未压缩的 alpha。期望值为 libwebp WebPAnimDecoder 合成的每帧画布的 FNV-1a 哈希。
+constexpr uint8_t kAnimatedWebp[] = {
+    0x52, 0x49, 0x46, 0x46, 0x5A, 0x06, 0x00, 0x00, 0x57, 0x45, 0x42, 0x50, 0x56, 0x50, 0x38, 0x58,
+    0x0A, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x41, 0x4E,
+    0x49, 0x4D, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x4E, 0x4D, 0x46,
+    0xEE, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x0F, 0x00, 0x00,
+    0x32, 0x00, 0x00, 0x02, 0x41, 0x4C, 0x50, 0x48, 0x81, 0x01, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x56, 0x50,
+    0x38, 0x20, 0x4C, 0x00, 0x00, 0x00, 0x30, 0x03, 0x00, 0x9D, 0x01, 0x2A, 0x18, 0x00, 0x10, 0x00,
+    0x3E, 0xED, 0x62, 0xA9, 0x4D, 0xA9, 0xA5, 0xA3, 0xA2, 0x30, 0x08, 0x01, 0x30, 0x1D, 0x89, 0x62,
+    0x00, 0xBB, 0x2E, 0x80, 0x00, 0x3C, 0xCF, 0xF0, 0x00, 0xFE, 0xEB, 0xFF, 0x4D, 0x18, 0x7E, 0x2F,
+    0x08, 0x0E, 0x30, 0x6D, 0xED, 0xEF, 0x0C, 0x3F, 0xDE, 0x03, 0x4F, 0x3F, 0xCE, 0x02, 0xE9, 0xEA,
+    0xB0, 0x21, 0x8B, 0x4C, 0x4F, 0x6A, 0xD5, 0x96, 0xBF, 0xB5, 0x19, 0xA1, 0xAD, 0x56, 0xB5, 0x2B,
+    0xD8, 0x00, 0x41, 0x4E, 0x4D, 0x46, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x09, 0x00, 0x00, 0x07, 0x00, 0x00, 0x32, 0x00, 0x00, 0x00, 0x56, 0x50, 0x38, 0x20, 0x4C, 0x00,
+    0x00, 0x00, 0x54, 0x02, 0x00, 0x9D, 0x01, 0x2A, 0x0A, 0x00, 0x08, 0x00, 0x00, 0x00, 0x5A, 0x25,
+    0xB0, 0x02, 0x74, 0x4C, 0x80, 0x7E, 0xA0, 0x01, 0xD9, 0xA4, 0x94, 0x48, 0x00, 0x00, 0xFE, 0x31,
+    0x40, 0xB2, 0xE8, 0x1D, 0x07, 0x0B, 0xC6, 0xAF, 0xE0, 0x97, 0xBE, 0x3F, 0xE7, 0xD8, 0x3C, 0xE7,
+    0x9F, 0xBC, 0x3F, 0xC9, 0xA7, 0xCA, 0x67, 0xF4, 0x3F, 0xFC, 0x7A, 0xDE, 0x3D, 0x9F, 0x6A, 0xE1,
+    0x3C, 0x4B, 0x12, 0x26, 0xB3, 0xF3, 0x33, 0xE2, 0x57, 0xF6, 0x51, 0x7E, 0x40, 0x00, 0x41, 0x4E,
+    0x4D, 0x46, 0xCA, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x07,
+    0x00, 0x00, 0x32, 0x00, 0x00, 0x02, 0x41, 0x4C, 0x50, 0x48, 0x59, 0x00, 0x00, 0x00, 0x00, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x56, 0x50, 0x38, 0x20, 0x50, 0x00, 0x00, 0x00,
+    0x70, 0x02, 0x00, 0x9D, 0x01, 0x2A, 0x0B, 0x00, 0x08, 0x00, 0x03, 0x80, 0x5A, 0x25, 0xB0, 0x02,
+    0x74, 0x4C, 0x80, 0x7A, 0xFF, 0xEE, 0x00, 0x02, 0x30, 0x3B, 0x93, 0x00, 0x00, 0xFD, 0x21, 0xBB,
+    0xD5, 0x9E, 0x81, 0xBF, 0xF3, 0x37, 0x78, 0x94, 0x71, 0xFF, 0x3A, 0x06, 0xA6, 0x75, 0x61, 0xEB,
+    0xF9, 0x49, 0x6C, 0xBF, 0xBE, 0x98, 0x85, 0xFB, 0x14, 0xE4, 0xB3, 0x83, 0x39, 0x94, 0x73, 0xDC,
+    0x61, 0x98, 0xE8, 0x8F, 0x19, 0xC2, 0x4A, 0xA7, 0xFD, 0xE5, 0xC1, 0x9E, 0x4A, 0x00, 0x00, 0x00,
+    0x41, 0x4E, 0x4D, 0x46, 0x5A, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x02, 0x00, 0x00, 0x09, 0x00,
+    0x00, 0x07, 0x00, 0x00, 0x32, 0x00, 0x00, 0x00, 0x56, 0x50, 0x38, 0x20, 0x42, 0x00, 0x00, 0x00,
+    0x34, 0x02, 0x00, 0x9D, 0x01, 0x2A, 0x0A, 0x00, 0x08, 0x00, 0x00, 0x00, 0x5A, 0x25, 0xB0, 0x02,
+    0x74, 0x7F, 0x06, 0x70, 0x00, 0x1A, 0x81, 0xAD, 0xCC, 0x00, 0x00, 0xFD, 0x20, 0xFC, 0x3F, 0x87,
+    0xE4, 0xF4, 0xF6, 0x5E, 0xD4, 0x73, 0xDB, 0x95, 0xB0, 0x0B, 0xDE, 0x27, 0x7C, 0x1C, 0x15, 0x87,
+    0x9C, 0x97, 0xC4, 0xEB, 0x51, 0x5F, 0x3E, 0xE8, 0xE4, 0xC5, 0x44, 0x5F, 0x2E, 0x96, 0x2D, 0xB0,
+    0x00, 0x00, 0x41, 0x4E, 0x4D, 0x46, 0xE6, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x17, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x32, 0x00, 0x00, 0x02, 0x41, 0x4C, 0x50, 0x48, 0x81, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x56, 0x50, 0x38, 0x20, 0x44, 0x00, 0x00, 0x00, 0xD0, 0x02, 0x00, 0x9D,
+    0x01, 0x2A, 0x18, 0x00, 0x10, 0x00, 0x3E, 0xED, 0x64, 0xAD, 0x4E, 0xA9, 0xA5, 0xA4, 0xA2, 0x30,
+    0x08, 0x01, 0x30, 0x1D, 0x89, 0x68, 0x00, 0x01, 0x38, 0x9A, 0x00, 0x00, 0xFE, 0xF8, 0xBF, 0x3F,
+    0xFE, 0xE9, 0x9F, 0xFE, 0xF3, 0xE1, 0xFF, 0xFB, 0xC1, 0x9C, 0x00, 0x4B, 0xFF, 0xAA, 0x65, 0x7F,
+    0x3D, 0x89, 0x47, 0xFF, 0x30, 0x03, 0x81, 0xB6, 0x4D, 0x34, 0x67, 0x9C, 0x63, 0xF0, 0x00, 0x00,
+    0x41, 0x4E, 0x4D, 0x46, 0xAA, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x04, 0x00, 0x00, 0x09, 0x00,
+    0x00, 0x07, 0x00, 0x00, 0x32, 0x00, 0x00, 0x02, 0x41, 0x4C, 0x50, 0x48, 0x51, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+    0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x56, 0x50, 0x38, 0x20, 0x38, 0x00, 0x00, 0x00, 0x70, 0x01, 0x00, 0x9D, 0x01, 0x2A,
+    0x0A, 0x00, 0x08, 0x00, 0x03, 0x80, 0x5A, 0x25, 0xB0, 0x02, 0x74, 0x02, 0x22, 0x80, 0x00, 0xFB,
+    0x8E, 0x49, 0x93, 0x16, 0xBE, 0xAC, 0x30, 0x57, 0xF8, 0x56, 0xCD, 0xAF, 0xCB, 0x53, 0xD2, 0x3B,
+    0x97, 0xEF, 0xA8, 0x92, 0xFE, 0x87, 0x1B, 0xAF, 0xE6, 0xB1, 0x12, 0xF8, 0xFB, 0x4B, 0x0C, 0x80,
+    0x00, 0x00,
+};
+
+// 24x16 无损 WebP（libwebp method 6），包含预测、颜色、减绿变换、颜色缓存与后向引用。
+constexpr uint8_t kLosslessWebp[] = {
+    0x52, 0x49, 0x46, 0x46, 0x9A, 0x00, 0x00, 0x00, 0x57, 0x45, 0x42, 0x50, 0x56, 0x50, 0x38, 0x4C,
+    0x8D, 0x00, 0x00, 0x00, 0x2F, 0x17, 0xC0, 0x03, 0x10, 0xCD, 0x65, 0x44, 0xFF, 0x63, 0x17, 0x11,
+    0xFD, 0x0F, 0x09, 0x9A, 0xB6, 0x8D, 0x24, 0x23, 0x38, 0xFE, 0x84, 0x83, 0xE1, 0xB7, 0xFE, 0xF8,
+    0x04, 0x7A, 0x05, 0x01, 0x00, 0x14, 0xD9, 0x36, 0xFF, 0xEF, 0x6B, 0x41, 0x48, 0x25, 0xDB, 0xC6,
+    0xFE, 0xBA, 0x28, 0x8A, 0xA2, 0x28, 0x8A, 0xA2, 0x28, 0x8A, 0xA2, 0x28, 0x8A, 0xDA, 0x3A, 0x3C,
+    0xBE, 0xC2, 0x0F, 0x79, 0xB8, 0x0F, 0x50, 0x01, 0xC6, 0x3C, 0x0C, 0xAC, 0x80, 0x53, 0x1E, 0xEE,
+    0x03, 0x55, 0xA0, 0x39, 0x0F, 0x83, 0x2B, 0xF0, 0x92, 0x87, 0x21, 0x15, 0x64, 0xCD, 0xC3, 0xD0,
+    0x0A, 0xBA, 0xE5, 0x61, 0x58, 0x05, 0xDB, 0xF3, 0x30, 0xBC, 0x82, 0x1F, 0x79, 0x18, 0x51, 0x21,
+    0xCE, 0x3C, 0x8C, 0xAC, 0x90, 0x57, 0x1E, 0x46, 0x55, 0xA8, 0x3B, 0x0F, 0xA3, 0x2B, 0xF4, 0x93,
+    0x87, 0x31, 0x15, 0xE6, 0xCD, 0xC3, 0xD8, 0x0A, 0xFB, 0xE5, 0x61, 0x5C, 0x85, 0xFB, 0xEB, 0xF0,
+    0x01, 0x00,
+};
+
+// 24x16 调色板无损 WebP（颜色索引变换，多个像素打包在一个字节中）。
+constexpr uint8_t kPaletteWebp[] = {
+    0x52, 0x49, 0x46, 0x46, 0x5C, 0x00, 0x00, 0x00, 0x57, 0x45, 0x42, 0x50, 0x56, 0x50, 0x38, 0x4C,
+    0x50, 0x00, 0x00, 0x00, 0x2F, 0x17, 0xC0, 0x03, 0x10, 0x1F, 0x20, 0x10, 0x48, 0xF2, 0x27, 0x1A,
+    0x61, 0x44, 0x81, 0x00, 0x61, 0xC2, 0xFF, 0xA0, 0x07, 0x02, 0x81, 0x24, 0x88, 0xFD, 0x05, 0x97,
+    0x10, 0x90, 0x10, 0x9E, 0xCB, 0x72, 0x01, 0xD8, 0x5B, 0xB5, 0x50, 0x13, 0xC9, 0x56, 0x33, 0xF3,
+    0xCB, 0x2F, 0xE5, 0xAB, 0xF8, 0x12, 0xA2, 0x4B, 0x92, 0x04, 0x54, 0x20, 0x85, 0x92, 0x36, 0x2A,
+    0x88, 0xE8, 0xFF, 0x0F, 0x1C, 0x46, 0x83, 0x8D, 0x3A, 0xC6, 0x46, 0x24, 0x6B, 0x23, 0x9E, 0x69,
+    0xA3, 0xEF, 0xCF, 0x04,
+};
+
+// 24x16 有损 + 无损压缩 ALPH（梯度滤波）的 VP8X 文件。
+constexpr uint8_t kAlphaWebp[] = {
+    0x52, 0x49, 0x46, 0x46, 0x98, 0x00, 0x00, 0x00, 0x57, 0x45, 0x42, 0x50, 0x56, 0x50, 0x38, 0x58,
+    0x0A, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x41, 0x4C,
+    0x50, 0x48, 0x15, 0x00, 0x00, 0x00, 0x0D, 0x0F, 0x30, 0x09, 0x11, 0x11, 0x82, 0x4C, 0xDA, 0xA6,
+    0xF5, 0xEF, 0x79, 0xFD, 0xA7, 0x20, 0xA2, 0xFF, 0xB1, 0x12, 0x9E, 0x00, 0x56, 0x50, 0x38, 0x20,
+    0x5C, 0x00, 0x00, 0x00, 0x30, 0x04, 0x00, 0x9D, 0x01, 0x2A, 0x18, 0x00, 0x10, 0x00, 0x3E, 0xB5,
+    0x4A, 0xA1, 0x49, 0xA7, 0x24, 0x23, 0xA1, 0x30, 0x08, 0x00, 0xE0, 0x16, 0x89, 0x6C, 0x00, 0x9D,
+    0x32, 0x84, 0x70, 0x37, 0xA4, 0x80, 0x67, 0x7E, 0x6B, 0x56, 0xE2, 0xAC, 0x80, 0xB0, 0x00, 0xFE,
+    0xF4, 0x56, 0x84, 0x15, 0x98, 0xCA, 0xFC, 0x48, 0xDE, 0xC2, 0x6F, 0xE2, 0xB4, 0xAF, 0x6D, 0x8B,
+    0xCC, 0xB8, 0x3F, 0xDD, 0xF0, 0xBD, 0xD6, 0xB1, 0x99, 0x83, 0x50, 0xD0, 0x40, 0x36, 0x69, 0x16,
+    0xA1, 0x30, 0xB5, 0xFF, 0x5E, 0xA8, 0x40, 0x76, 0xEE, 0x5B, 0x18, 0xCB, 0xE8, 0x70, 0x00, 0x00,
+};
+
+constexpr uint32_t kLossyHash = 0x4AFC0F5F;
+constexpr uint32_t kLosslessHash = 0x9C254E85;
+constexpr uint32_t kPaletteHash = 0xF19974C5;
+constexpr uint32_t kAlphaHash = 0x1A3AC7C7;
+constexpr uint32_t kAnimatedHashes[] = { 0x1F2CD440, 0xE703004E, 0x84952843, 0x7F228BCE, 0x7919618A, 0x454FF7FA };
+
+uint32_t fnv1a(const std::vector<uint8_t>& data) {
+    uint32_t hash = 0x811C9DC5;
+    for (uint8_t byte : data) {
+        hash = (hash ^ byte) * 0x01000193;
+    }
+    return hash;
+}
+
+int test_lossy() {
+    int failures = 0;
+    for (bool parallel : { false, true }) {
+        shine::image::webp decoder;
+        decoder.setParallelDecode(parallel, 0);
+        if (!decoder.loadFromMemory(kLossyWebp, sizeof(kLossyWebp))) {
+            fmt::println("  FAIL: loadFromMemory");
+            return failures + 1;
+        }
+        const auto result = decoder.decode();
+        if (!result.has_value()) {
+            ++failures;
+            fmt::println("  FAIL: {}", result.error());
+            continue;
+        }
+        if (decoder.getWidth() != 24 || decoder.getHeight() != 16 || fnv1a(decoder.getImageData()) != kLossyHash) {
+            ++failures;
+            fmt::println("  FAIL: 解码结果与 libwebp 不一致（parallel={}）", parallel);
+        }
+    }
+
+    // 截断的分区应报错而不是越界读取
+    shine::image::webp truncated;
+    if (truncated.loadFromMemory(kLossyWebp, sizeof(kLossyWebp) - 40) && truncated.decode().has_value()) {
+        ++failures;
+        fmt::println("  FAIL: 截断数据未报错");
+    }
+
+    fmt::println("有损解码: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+int test_lossless() {
+    int failures = 0;
+    struct Case {
+        const char* name;
+        const uint8_t* data;
+        size_t size;
+        uint32_t hash;
+    };
+    const Case cases[] = {
+        { "变换 + 颜色缓存", kLosslessWebp, sizeof(kLosslessWebp), kLosslessHash },
+        { "调色板", kPaletteWebp, sizeof(kPaletteWebp), kPaletteHash },
+        { "有损 + ALPH", kAlphaWebp, sizeof(kAlphaWebp), kAlphaHash },
+    };
+    for (const Case& c : cases) {
+        shine::image::webp decoder;
+        if (!decoder.loadFromMemory(c.data, c.size)) {
+            ++failures;
+            fmt::println("  FAIL: {}: loadFromMemory", c.name);
+            continue;
+        }
+        const auto result = decoder.decode();
+        if (!result.has_value()) {
+            ++failures;
+            fmt::println("  FAIL: {}: {}", c.name, result.error());
+            continue;
+        }
+        if (decoder.getWidth() != 24 || decoder.getHeight() != 16 || fnv1a(decoder.getImageData()) != c.hash) {
+            ++failures;
+            fmt::println("  FAIL: {}: 解码结果与 libwebp 不一致", c.name);
+        }
+
+        // 截断的位流应报错而不是越界读取
+        shine::image::webp truncated;
+        if (truncated.loadFromMemory(c.data, c.size - 24) && truncated.decode().has_value()) {
+            ++failures;
+            fmt::println("  FAIL: {}: 截断数据未报错", c.name);
+        }
+    }
+
+    fmt::println("无损 / Alpha 解码: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+int test_animation() {
+    int failures = 0;
+    shine::image::webp decoder;
+    if (!decoder.loadFromMemory(kAnimatedWebp, sizeof(kAnimatedWebp))) {
+        fmt::println("  FAIL: loadFromMemory");
+        return 1;
+    }
+
+    constexpr uint32_t frameCount = static_cast<uint32_t>(std::size(kAnimatedHashes));
+    if (!decoder.hasAnimation() || decoder.getFrames().size() != frameCount ||
+        decoder.getAnimationInfo().canvasWidth != 24 || decoder.getAnimationInfo().canvasHeight != 16) {
+        fmt::println("  FAIL: 动画信息错误");
+        return 1;
+    }
+
+    auto check = [&](uint32_t index) {
+        const auto frame = decoder.decodeFrame(index);
+        if (!frame.has_value()) {
+            ++failures;
+            fmt::println("  FAIL: 帧 {}: {}", index, frame.error());
+        } else if (fnv1a(**frame) != kAnimatedHashes[index]) {
+            ++failures;
+            fmt::println("  FAIL: 帧 {} 与 libwebp 合成结果不一致", index);
+        }
+    };
+
+    // 顺序播放，然后在很小的缓存下随机跳转，合成结果都应相同
+    for (uint32_t i = 0; i < frameCount; ++i) {
+        check(i);
+    }
+    std::mt19937 rng(3);
+    for (auto [capacity, interval] : { std::pair<size_t, uint32_t>{ 1, 0 }, { 2, 2 } }) {
+        decoder.setFrameCache(capacity, interval);
+        for (int i = 0; i < 40; ++i) {
+            check(rng() % frameCount);
+        }
+    }
+
+    // decode() 输出第一帧
+    if (!decoder.decode().has_value() || fnv1a(decoder.getImageData()) != kAnimatedHashes[0]) {
+        ++failures;
+        fmt::println("  FAIL: decode() 未输出第一帧");
+    }
+    if (decoder.decodeFrame(frameCount).has_value()) {
+        ++failures;
+        fmt::println("  FAIL: 越界帧序号未报错");
+    }
+
+    fmt::println("动画合成: {}", failures == 0 ? "PASS" : "FAIL");
+    return failures;
+}
+
+} // namespace
+
+int main() {
+    fmt::println("=== 正确性测试 ===\n");
+    int failures = test_lossy();
+    failures += test_lossless();
+    failures += test_animation();
+
+    if (failures != 0) {
+        fmt::println("共 {} 个用例失败", failures);
+        return 1;
+    }
+    fmt::println("全部通过");
+    return 0;
+}